@@ -39,9 +39,13 @@
 #include "app/runtime/bootstrap/WhatSonQmlLaunchSupport.hpp"
 #include "app/permissions/WhatSonPermissionBootstrapper.hpp"
 #include "app/runtime/scheduler/WhatSonAsyncScheduler.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
 #include "app/models/file/hub/WhatSonHubCreator.hpp"
 #include "app/models/file/hub/WhatSonHubMountValidator.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournalController.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+#include "app/models/file/viewer/WhatSonThumbnailImageProvider.hpp"
 #include "app/platform/Apple/AppleSecurityScopedResourceAccess.hpp"
 #include "app/permissions/ApplePermissionBridge.hpp"
 #include "app/store/hub/SelectedHubStore.hpp"
@@ -66,6 +70,7 @@
 #include <QVector>
 #include <QtCore/qglobal.h>
 
+#include <chrono>
 #include <cstdlib>
 #include <functional>
 
@@ -73,6 +78,9 @@ void qml_register_types_LVRS();
 
 namespace
 {
+// Hubs switched away from stay mounted for quick return; older ones collapse to a stat summary.
+constexpr int kMaxMountedHubCount = 3;
+
 lvrs::QmlAppLifecycleContext workspaceLifecycleContext(
     QGuiApplication& app,
     QQmlApplicationEngine& engine,
@@ -93,6 +101,7 @@ bool scheduleStartupRuntimeLoadAfterFirstIdle(
     QQmlApplicationEngine& engine,
     const lvrs::QmlRootLoadResult& workspaceRootLoadResult,
     const WhatSon::Runtime::Startup::StartupHubSelection& startupHubSelection,
+    const QStringList& residentHubPaths,
     WhatSonStartupRuntimeCoordinator& startupRuntimeCoordinator,
     OnboardingHubController& onboardingHubController,
     const std::function<void(const QString&, const QByteArray&)>& publishLoadedHubConnection)
@@ -111,11 +120,13 @@ bool scheduleStartupRuntimeLoadAfterFirstIdle(
         [&startupRuntimeCoordinator,
          &onboardingHubController,
          startupHubSelection,
+         residentHubPaths,
          publishLoadedHubConnection](const lvrs::QmlAppLifecycleContext&, QString* errorMessage)
     {
+        // The hubs left resident by the previous session are mounted alongside the startup hub, which stays first.
         QString loadError;
-        const bool loaded = startupRuntimeCoordinator.loadHubIntoRuntime(
-            startupHubSelection.hubPath,
+        const bool loaded = startupRuntimeCoordinator.loadHubsIntoRuntime(
+            QStringList{startupHubSelection.hubPath} + residentHubPaths,
             &loadError);
         if (loaded)
         {
@@ -249,6 +260,35 @@ int main(int argc, char* argv[])
             destroyQmlRootObjectsBeforeApplicationShutdown(engine);
         },
         Qt::DirectConnection);
+    QObject::connect(
+        &app,
+        &QCoreApplication::aboutToQuit,
+        &app,
+        []()
+        {
+            // Compaction is left to the next session's write-back so quitting only appends the outstanding edits.
+            WhatSonHubArchiveConverter::waitForBackgroundMaintenance();
+            QString writeBackError;
+            if (!WhatSonHubArchiveConverter::writeBackMountedArchives(&writeBackError, false))
+            {
+                qWarning().noquote() << QStringLiteral("Failed to write back packed WhatSon Hub edits: %1")
+                                            .arg(writeBackError);
+            }
+        },
+        Qt::DirectConnection);
+    // Packed hubs are edited through a staging copy; its edits reach the archive periodically, not only at quit.
+    QTimer packedHubWriteBackTimer;
+    packedHubWriteBackTimer.setInterval(std::chrono::seconds(30));
+    QObject::connect(
+        &packedHubWriteBackTimer,
+        &QTimer::timeout,
+        &app,
+        []()
+        {
+            WhatSonHubArchiveConverter::writeBackMountedArchivesInBackground();
+        });
+    packedHubWriteBackTimer.start();
+    engine.addImageProvider(WhatSonThumbnailImageProvider::providerId(), new WhatSonThumbnailImageProvider);
 
     CalendarBoardStore calendarBoardStore;
     SystemCalendarStore systemCalendarStore;
@@ -278,6 +318,16 @@ int main(int argc, char* argv[])
     WeekCalendarController weekCalendarController;
     YearCalendarController yearCalendarController;
     WhatSonHubRuntimeStore hubRuntimeStore;
+    hubRuntimeStore.setMaxMountedHubCount(kMaxMountedHubCount);
+    QObject::connect(
+        &app,
+        &QCoreApplication::aboutToQuit,
+        &app,
+        [&selectedHubStore, &hubRuntimeStore]()
+        {
+            selectedHubStore.setResidentHubPaths(hubRuntimeStore.hubPaths());
+        },
+        Qt::DirectConnection);
     OnboardingHubController onboardingHubController;
     WhatSonHubCreator hubCreator(QDir::currentPath(), QStringLiteral("hubs"));
     WhatSonPermissionBootstrapper permissionBootstrapper(app);
@@ -464,6 +514,42 @@ int main(int argc, char* argv[])
         {
             calendarBoardStore.removeProjectedNoteBySourceId(noteId);
         });
+    presetHierarchyController.setIndexedNotesProvider(
+        [&libraryHierarchyController]()
+        {
+            return libraryHierarchyController.indexedNotesSnapshot();
+        });
+    QObject::connect(
+        &libraryHierarchyController,
+        &LibraryHierarchyController::indexedNotesSnapshotChanged,
+        &presetHierarchyController,
+        [&presetHierarchyController, &libraryHierarchyController]()
+        {
+            presetHierarchyController.applyIndexedNotes(libraryHierarchyController.indexedNotesSnapshot());
+        });
+    QObject::connect(
+        &libraryHierarchyController,
+        &LibraryHierarchyController::indexedNoteUpserted,
+        &presetHierarchyController,
+        [&presetHierarchyController, &libraryHierarchyController](const QString& noteId)
+        {
+            LibraryNoteRecord note;
+            if (!libraryHierarchyController.indexedNoteRecordById(noteId, &note))
+            {
+                presetHierarchyController.removeIndexedNote(noteId);
+                return;
+            }
+
+            presetHierarchyController.upsertIndexedNote(note);
+        });
+    QObject::connect(
+        &libraryHierarchyController,
+        &LibraryHierarchyController::noteDeleted,
+        &presetHierarchyController,
+        [&presetHierarchyController](const QString& noteId)
+        {
+            presetHierarchyController.removeIndexedNote(noteId);
+        });
     QObject::connect(
         &bookmarksHierarchyController,
         &BookmarksHierarchyController::hubFilesystemMutated,
@@ -475,6 +561,23 @@ int main(int argc, char* argv[])
         &app,
         requestCalendarProjectedNotesReload);
     Q_UNUSED(hubSyncWiring);
+    WhatSonHubMutationJournalController hubMutationJournalController;
+    for (QObject* journalSource : QList<QObject*>{
+             &libraryHierarchyController,
+             &projectsHierarchyController,
+             &libraryNoteMutationController})
+    {
+        QObject::connect(
+            journalSource,
+            SIGNAL(hubFilesystemMutated()),
+            &hubMutationJournalController,
+            SLOT(refresh()));
+    }
+    QObject::connect(
+        &hubMutationJournalController,
+        &WhatSonHubMutationJournalController::hubFilesystemRestored,
+        &hubSyncController,
+        &WhatSonHubSyncController::requestSyncHint);
     inAppClipboard.setReloadResourcesCallback(
         [&startupRuntimeCoordinator, &hubSyncController](const QString& hubPath, QString* errorMessage) -> bool
         {
@@ -501,12 +604,14 @@ int main(int argc, char* argv[])
     const auto publishLoadedHubConnection =
         [&selectedHubStore,
          &hubSyncController,
+         &hubMutationJournalController,
          &inAppClipboard,
          &calendarBoardStore,
          &libraryHierarchyController](const QString& hubPath, const QByteArray& accessBookmark)
     {
         selectedHubStore.setSelectedHubSelection(hubPath, accessBookmark);
         hubSyncController.setCurrentHubPath(hubPath);
+        hubMutationJournalController.setCurrentHubPath(hubPath);
         inAppClipboard.setCurrentHubPath(hubPath);
         calendarBoardStore.setProjectedNotesHubPath(hubPath);
         calendarBoardStore.reloadProjectedNotesFromSnapshot(
@@ -566,6 +671,7 @@ int main(int argc, char* argv[])
     WhatSon::Runtime::Bootstrap::WorkspaceContextObjects workspaceContextObjects;
     workspaceContextObjects.libraryHierarchyController = &libraryHierarchyController;
     workspaceContextObjects.libraryNoteMutationController = &libraryNoteMutationController;
+    workspaceContextObjects.hubMutationJournalController = &hubMutationJournalController;
     workspaceContextObjects.projectsHierarchyController = &projectsHierarchyController;
     workspaceContextObjects.bookmarksHierarchyController = &bookmarksHierarchyController;
     workspaceContextObjects.tagsHierarchyController = &tagsHierarchyController;
@@ -588,6 +694,7 @@ int main(int argc, char* argv[])
     workspaceContextObjects.weekCalendarController = &weekCalendarController;
     workspaceContextObjects.yearCalendarController = &yearCalendarController;
     workspaceContextObjects.panelControllerRegistry = &panelControllerRegistry;
+    workspaceContextObjects.memoryAccounting = &WhatSonMemoryAccounting::shared();
     const lvrs::QmlContextBindResult workspaceContextBindResult =
         WhatSon::Runtime::Bootstrap::bindWorkspaceContextObjects(engine, workspaceContextObjects);
     if (!workspaceContextBindResult.ok)
@@ -818,6 +925,7 @@ int main(int argc, char* argv[])
             engine,
             mainWindowLoadResult,
             startupHubSelection,
+            selectedHubStore.residentHubPaths(),
             startupRuntimeCoordinator,
             onboardingHubController,
             publishLoadedHubConnection))
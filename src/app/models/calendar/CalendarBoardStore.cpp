@@ -1,6 +1,7 @@
 #include "app/models/calendar/CalendarBoardStore.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
 #include "app/models/hierarchy/library/LibraryNotePreviewText.hpp"
 #include "app/models/hierarchy/library/WhatSonLibraryIndexedState.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
@@ -233,11 +234,60 @@ namespace
 
         return true;
     }
+
+    void accountCalendarEntry(WhatSonMemoryEstimate& estimate, const CalendarBoardStore::CalendarEntry& entry)
+    {
+        estimate.addStringPayload(entry.id);
+        estimate.addStringPayload(entry.title);
+        estimate.addStringPayload(entry.detail);
+        estimate.addStringPayload(entry.sourceKind);
+        estimate.addStringPayload(entry.sourceId);
+        estimate.addStringPayload(entry.dateRole);
+    }
+
+    void accountEntriesByDate(
+        WhatSonMemoryEstimate& estimate,
+        const QHash<QString, QVector<CalendarBoardStore::CalendarEntry>>& entriesByDate)
+    {
+        estimate.addPlainHash(entriesByDate);
+        for (auto it = entriesByDate.constBegin(); it != entriesByDate.constEnd(); ++it)
+        {
+            estimate.addStringPayload(it.key());
+            estimate.addVectorPayload(it.value(), accountCalendarEntry);
+        }
+    }
 }
 
 CalendarBoardStore::CalendarBoardStore(QObject* parent)
     : ICalendarBoardStore(parent)
 {
+    WhatSonMemoryAccounting& memoryAccounting = WhatSonMemoryAccounting::shared();
+    memoryAccounting.track(
+        this,
+        QStringLiteral("calendar"),
+        QStringLiteral("entries"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addVector(m_entries, accountCalendarEntry);
+            accountEntriesByDate(estimate, m_entriesByDate);
+            estimate.addPlainHash(m_entryCountsByDate);
+        });
+    memoryAccounting.track(
+        this,
+        QStringLiteral("calendar"),
+        QStringLiteral("projection"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addItems(m_projectedEntriesBySourceId.size());
+            estimate.addPlainHash(m_projectedEntriesBySourceId);
+            for (auto it = m_projectedEntriesBySourceId.constBegin(); it != m_projectedEntriesBySourceId.constEnd(); ++it)
+            {
+                estimate.addStringPayload(it.key());
+                accountCalendarEntry(estimate, it.value());
+            }
+            accountEntriesByDate(estimate, m_projectedEntriesByDate);
+            estimate.addPlainHash(m_projectedEntryCountsByDate);
+        });
     m_projectedNotesReloadTimer.setSingleShot(true);
     m_projectedNotesReloadTimer.setInterval(250);
     connect(&m_projectedNotesReloadTimer, &QTimer::timeout, this, [this]()
@@ -1,6 +1,7 @@
 #include "app/models/clipboard/InAppClipboardManager.h"
 
 #include "app/models/clipboard/FiletypeCapture.h"
+#include "app/models/clipboard/ResourceImportStream.h"
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 #include "app/models/hierarchy/resources/WhatSonResourcePackageSupport.hpp"
@@ -16,6 +17,7 @@
 #include <QHash>
 #include <QImage>
 #include <QIODevice>
+#include <QMetaObject>
 #include <QMetaType>
 #include <QMimeData>
 #include <QPixmap>
@@ -30,6 +32,9 @@
 #include <QVariant>
 #include <QVariantMap>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <utility>
 
 namespace
@@ -202,9 +207,13 @@ InAppClipboardManager::InAppClipboardManager(QObject* parent)
     : QObject(parent)
 {
     connect(&m_store, &InAppClipboardStore::resourceChanged, this, &InAppClipboardManager::resourceChanged);
+    m_importPool.setMaxThreadCount(1);
 }
 
-InAppClipboardManager::~InAppClipboardManager() = default;
+InAppClipboardManager::~InAppClipboardManager()
+{
+    m_importPool.waitForDone();
+}
 
 bool InAppClipboardManager::hasResource() const noexcept
 {
@@ -1099,13 +1108,43 @@ namespace
         return true;
     }
 
+    // Packages are assembled in a hidden directory beside their final location and committed with one rename on
+    // the same volume, so a failed or interrupted import never leaves a partial .wsresource in the hub.
+    QString createPackageStagingDirectory(const QString& resourcesDirectoryPath, QString* errorMessage = nullptr)
+    {
+        const QString stagingDirectoryPath = QDir(resourcesDirectoryPath).filePath(
+            QStringLiteral(".import-staging-%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces)));
+        if (!QDir().mkpath(stagingDirectoryPath))
+        {
+            if (errorMessage != nullptr)
+            {
+                *errorMessage = QStringLiteral("Failed to create resource package staging directory: %1").arg(
+                    stagingDirectoryPath);
+            }
+            return {};
+        }
+        return stagingDirectoryPath;
+    }
+
+    bool discardStagedPackage(const QString& stagingDirectoryPath, const QString& failureText, QString* errorMessage)
+    {
+        QDir(stagingDirectoryPath).removeRecursively();
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = failureText;
+        }
+        return false;
+    }
+
     bool importSingleFile(
         const QString& sourceFilePath,
         const QString& resourcesDirectoryPath,
         const bool randomizeDefaultClipboardResourceNames,
+        const WhatSon::Clipboard::StreamProgress& progress,
         QString* outResourcePath,
         QString* outCreatedPackagePath,
         WhatSon::Resources::ResourcePackageMetadata* outMetadata,
+        WhatSon::Clipboard::StreamedFile* outAsset,
         QString* errorMessage = nullptr)
     {
         if (outResourcePath == nullptr || outCreatedPackagePath == nullptr || outMetadata == nullptr)
@@ -1142,30 +1181,26 @@ namespace
         const QString destinationAssetFileName = defaultClipboardResourceFile
             ? clipboardAssetFileNameForResourceId(sourceFileInfo, resourceId)
             : sourceFileInfo.fileName();
-        const QString destinationAssetPath = QDir(packageDirectoryPath).filePath(destinationAssetFileName);
         const QString resourcePath = WhatSon::Resources::normalizePath(
             QStringLiteral("%1/%2")
                 .arg(QFileInfo(resourcesDirectoryPath).fileName(), QFileInfo(packageDirectoryPath).fileName()));
 
-        if (!QDir().mkpath(packageDirectoryPath))
+        const QString stagingDirectoryPath = createPackageStagingDirectory(resourcesDirectoryPath, errorMessage);
+        if (stagingDirectoryPath.isEmpty())
         {
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = QStringLiteral("Failed to create resource package directory: %1").arg(
-                    packageDirectoryPath);
-            }
             return false;
         }
 
-        if (!QFile::copy(sourceFilePath, destinationAssetPath))
+        WhatSon::Clipboard::StreamedFile asset;
+        QString writeError;
+        if (!WhatSon::Clipboard::streamFileToFile(
+            sourceFilePath,
+            QDir(stagingDirectoryPath).filePath(destinationAssetFileName),
+            progress,
+            &asset,
+            &writeError))
         {
-            QDir(packageDirectoryPath).removeRecursively();
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = QStringLiteral("Failed to copy dropped file into resource package: %1").arg(
-                    sourceFilePath);
-            }
-            return false;
+            return discardStagedPackage(stagingDirectoryPath, writeError, errorMessage);
         }
 
         const WhatSon::Resources::ResourcePackageMetadata metadata =
@@ -1174,36 +1209,37 @@ namespace
                 resourceId,
                 resourcePath);
 
-        QString writeError;
         if (!WhatSon::Resources::writeResourcePackageAnnotationBitmap(
-            packageDirectoryPath,
+            stagingDirectoryPath,
             sourceFilePath,
             &writeError))
         {
-            QDir(packageDirectoryPath).removeRecursively();
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = writeError;
-            }
-            return false;
+            return discardStagedPackage(stagingDirectoryPath, writeError, errorMessage);
         }
 
         if (!writeUtf8FileAtomically(
-            QDir(packageDirectoryPath).filePath(WhatSon::Resources::metadataFileName()),
+            QDir(stagingDirectoryPath).filePath(WhatSon::Resources::metadataFileName()),
             WhatSon::Resources::createResourcePackageMetadataXml(metadata),
             &writeError))
         {
-            QDir(packageDirectoryPath).removeRecursively();
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = writeError;
-            }
-            return false;
+            return discardStagedPackage(stagingDirectoryPath, writeError, errorMessage);
+        }
+
+        if (!QDir().rename(stagingDirectoryPath, packageDirectoryPath))
+        {
+            return discardStagedPackage(
+                stagingDirectoryPath,
+                QStringLiteral("Failed to commit resource package: %1").arg(packageDirectoryPath),
+                errorMessage);
         }
 
         *outResourcePath = resourcePath;
         *outCreatedPackagePath = packageDirectoryPath;
         *outMetadata = metadata;
+        if (outAsset != nullptr)
+        {
+            *outAsset = asset;
+        }
         return true;
     }
 
@@ -1211,9 +1247,11 @@ namespace
         const QString& sourceFilePath,
         const ImportConflictDescriptor& conflictDescriptor,
         const QString& resourcesDirectoryPath,
+        const WhatSon::Clipboard::StreamProgress& progress,
         QString* outResourcePath,
         QString* outCreatedPackagePath,
         WhatSon::Resources::ResourcePackageMetadata* outMetadata,
+        WhatSon::Clipboard::StreamedFile* outAsset,
         QString* outBackupDirectoryPath,
         QString* errorMessage = nullptr)
     {
@@ -1255,47 +1293,6 @@ namespace
             return false;
         }
 
-        const QString backupDirectoryPath = QDir(resourcesDirectoryPath).filePath(
-            QStringLiteral(".import-backup-%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces)));
-        if (!QDir().rename(packageDirectoryPath, backupDirectoryPath))
-        {
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = QStringLiteral("Failed to stage the existing resource package for overwrite: %1").arg(
-                    packageDirectoryPath);
-            }
-            return false;
-        }
-
-        const auto restoreBackupAndFail = [&](const QString& failureText)
-        {
-            if (QFileInfo(packageDirectoryPath).exists())
-            {
-                QDir(packageDirectoryPath).removeRecursively();
-            }
-            QDir().rename(backupDirectoryPath, packageDirectoryPath);
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = failureText;
-            }
-            return false;
-        };
-
-        if (!QDir().mkpath(packageDirectoryPath))
-        {
-            return restoreBackupAndFail(
-                QStringLiteral("Failed to recreate overwritten resource package directory: %1").arg(
-                    packageDirectoryPath));
-        }
-
-        const QString destinationAssetPath = QDir(packageDirectoryPath).filePath(sourceFileInfo.fileName());
-        if (!QFile::copy(sourceFilePath, destinationAssetPath))
-        {
-            return restoreBackupAndFail(
-                QStringLiteral("Failed to copy dropped file into overwritten resource package: %1").arg(
-                    sourceFilePath));
-        }
-
         WhatSon::Resources::ResourcePackageMetadata metadata =
             WhatSon::Resources::buildMetadataForAssetFile(
                 sourceFileInfo.fileName(),
@@ -1306,21 +1303,59 @@ namespace
             metadata.resourcePath = conflictDescriptor.resourcePath.trimmed();
         }
 
+        // The replacement is fully staged before the existing package is touched; the swap is two renames.
+        const QString stagingDirectoryPath = createPackageStagingDirectory(resourcesDirectoryPath, errorMessage);
+        if (stagingDirectoryPath.isEmpty())
+        {
+            return false;
+        }
+
+        WhatSon::Clipboard::StreamedFile asset;
         QString writeError;
+        if (!WhatSon::Clipboard::streamFileToFile(
+            sourceFilePath,
+            QDir(stagingDirectoryPath).filePath(sourceFileInfo.fileName()),
+            progress,
+            &asset,
+            &writeError))
+        {
+            return discardStagedPackage(stagingDirectoryPath, writeError, errorMessage);
+        }
+
         if (!WhatSon::Resources::writeResourcePackageAnnotationBitmap(
-            packageDirectoryPath,
+            stagingDirectoryPath,
             sourceFilePath,
             &writeError))
         {
-            return restoreBackupAndFail(writeError);
+            return discardStagedPackage(stagingDirectoryPath, writeError, errorMessage);
         }
 
         if (!writeUtf8FileAtomically(
-            QDir(packageDirectoryPath).filePath(WhatSon::Resources::metadataFileName()),
+            QDir(stagingDirectoryPath).filePath(WhatSon::Resources::metadataFileName()),
             WhatSon::Resources::createResourcePackageMetadataXml(metadata),
             &writeError))
         {
-            return restoreBackupAndFail(writeError);
+            return discardStagedPackage(stagingDirectoryPath, writeError, errorMessage);
+        }
+
+        const QString backupDirectoryPath = QDir(resourcesDirectoryPath).filePath(
+            QStringLiteral(".import-backup-%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces)));
+        if (!QDir().rename(packageDirectoryPath, backupDirectoryPath))
+        {
+            return discardStagedPackage(
+                stagingDirectoryPath,
+                QStringLiteral("Failed to stage the existing resource package for overwrite: %1").arg(
+                    packageDirectoryPath),
+                errorMessage);
+        }
+
+        if (!QDir().rename(stagingDirectoryPath, packageDirectoryPath))
+        {
+            QDir().rename(backupDirectoryPath, packageDirectoryPath);
+            return discardStagedPackage(
+                stagingDirectoryPath,
+                QStringLiteral("Failed to commit overwritten resource package: %1").arg(packageDirectoryPath),
+                errorMessage);
         }
 
         *outResourcePath = metadata.resourcePath.trimmed().isEmpty()
@@ -1328,11 +1363,17 @@ namespace
             : metadata.resourcePath.trimmed();
         *outCreatedPackagePath = packageDirectoryPath;
         *outMetadata = metadata;
+        if (outAsset != nullptr)
+        {
+            *outAsset = asset;
+        }
         *outBackupDirectoryPath = WhatSon::Resources::normalizePath(backupDirectoryPath);
         return true;
     }
 
-    QVariantMap importedEntryFromMetadata(const WhatSon::Resources::ResourcePackageMetadata& metadata)
+    QVariantMap importedEntryFromMetadata(
+        const WhatSon::Resources::ResourcePackageMetadata& metadata,
+        const WhatSon::Clipboard::StreamedFile& asset)
     {
         QVariantMap entry;
         entry.insert(QStringLiteral("resourceId"), metadata.resourceId.trimmed());
@@ -1342,6 +1383,8 @@ namespace
         entry.insert(QStringLiteral("bucket"), metadata.bucket.trimmed());
         entry.insert(QStringLiteral("type"), metadata.type.trimmed().toCaseFolded());
         entry.insert(QStringLiteral("format"), WhatSon::Resources::normalizeFormat(metadata.format).toCaseFolded());
+        entry.insert(QStringLiteral("byteCount"), asset.byteCount);
+        entry.insert(QStringLiteral("sha256"), QString::fromLatin1(asset.sha256Hex));
         return entry;
     }
 
@@ -1422,13 +1465,19 @@ namespace
         const QString localFilePath = QDir(temporaryDirectory->path()).filePath(fileName);
         if (!resourceImport.payloadBytes.isEmpty())
         {
-            QFile file(localFilePath);
-            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
-                || file.write(resourceImport.payloadBytes) != resourceImport.payloadBytes.size())
+            WhatSon::Clipboard::StreamedFile payloadFile;
+            QString streamError;
+            if (!WhatSon::Clipboard::streamBytesToFile(
+                resourceImport.payloadBytes,
+                localFilePath,
+                &payloadFile,
+                &streamError))
             {
                 if (errorMessage != nullptr)
                 {
-                    *errorMessage = QStringLiteral("Failed to write clipboard resource payload: %1").arg(localFilePath);
+                    *errorMessage = QStringLiteral("Failed to write clipboard resource payload: %1 (%2)").arg(
+                        localFilePath,
+                        streamError);
                 }
                 return false;
             }
@@ -1449,7 +1498,341 @@ namespace
         return true;
     }
 
-}
+} // namespace
+
+namespace WhatSon::Clipboard
+{
+    // Inputs are copied in before the job is queued. Outcome fields are written only by the import worker and read
+    // on the GUI thread once completion is delivered, so nothing is shared while files are being copied.
+    struct ResourceImportJob final
+    {
+        QString hubPath;
+        QStringList sourceFiles;
+        int conflictPolicy = InAppClipboardManager::ConflictPolicyAbort;
+        bool randomizeDefaultClipboardResourceNames = false;
+        std::shared_ptr<QTemporaryDir> clipboardPayloadDirectory;
+
+        QString resourcesFilePath;
+        bool hadResourcesFile = false;
+        QString previousResourcesFileText;
+        bool succeeded = false;
+        QString errorMessage;
+        QStringList importedResourcePaths;
+        QStringList createdPackagePaths;
+        QList<OverwrittenPackageBackup> overwrittenPackageBackups;
+        QVariantList importedEntries;
+    };
+} // namespace WhatSon::Clipboard
+
+namespace
+{
+    using WhatSon::Clipboard::ResourceImportJob;
+    using ImportProgressSink = std::function<void(
+        int fileIndex,
+        int fileCount,
+        const QString& fileName,
+        qint64 bytesDone,
+        qint64 bytesTotal,
+        double overallProgress)>;
+
+    bool rollBackResourceImport(
+        const ResourceImportJob& job,
+        const bool restoreResourcesFile,
+        QString* rollbackError = nullptr)
+    {
+        QStringList rollbackErrors;
+
+        for (const QString& createdPackagePath : std::as_const(job.createdPackagePaths))
+        {
+            if (!QFileInfo(createdPackagePath).exists())
+            {
+                continue;
+            }
+
+            if (!QDir(createdPackagePath).removeRecursively())
+            {
+                rollbackErrors.push_back(
+                    QStringLiteral("Failed to remove imported resource package: %1").arg(createdPackagePath));
+            }
+        }
+
+        for (const OverwrittenPackageBackup& backup : std::as_const(job.overwrittenPackageBackups))
+        {
+            if (!backup.packageDirectoryPath.trimmed().isEmpty()
+                && QFileInfo(backup.packageDirectoryPath).exists()
+                && !QDir(backup.packageDirectoryPath).removeRecursively())
+            {
+                rollbackErrors.push_back(
+                    QStringLiteral("Failed to clear overwritten resource package: %1").arg(
+                        backup.packageDirectoryPath));
+            }
+
+            if (!backup.backupDirectoryPath.trimmed().isEmpty()
+                && QFileInfo(backup.backupDirectoryPath).exists()
+                && !QDir().rename(backup.backupDirectoryPath, backup.packageDirectoryPath))
+            {
+                rollbackErrors.push_back(
+                    QStringLiteral("Failed to restore overwritten resource package: %1").arg(
+                        backup.packageDirectoryPath));
+            }
+        }
+
+        if (restoreResourcesFile)
+        {
+            if (job.hadResourcesFile)
+            {
+                QString restoreError;
+                if (!writeUtf8FileAtomically(job.resourcesFilePath, job.previousResourcesFileText, &restoreError))
+                {
+                    rollbackErrors.push_back(restoreError);
+                }
+            }
+            else if (QFileInfo(job.resourcesFilePath).exists() && !QFile::remove(job.resourcesFilePath))
+            {
+                rollbackErrors.push_back(
+                    QStringLiteral("Failed to remove restored Resources.wsresources file: %1").arg(
+                        job.resourcesFilePath));
+            }
+        }
+
+        if (rollbackError != nullptr)
+        {
+            *rollbackError = rollbackErrors.join(QStringLiteral("; "));
+        }
+        return rollbackErrors.isEmpty();
+    }
+
+    bool failResourceImportJob(ResourceImportJob* job, const QString& errorMessage, const bool rollBack)
+    {
+        if (rollBack)
+        {
+            rollBackResourceImport(*job, false);
+        }
+        job->errorMessage = errorMessage;
+        job->succeeded = false;
+        return false;
+    }
+
+    // Runs on the import worker: resolves the hub layout, preflights conflicts, stages every package and rewrites
+    // Resources.wsresources. The runtime reload stays on the GUI thread in finishResourceImport().
+    bool runResourceImportJob(ResourceImportJob* job, const ImportProgressSink& reportProgress)
+    {
+        QString resolveError;
+        const QString contentsDirectoryPath = resolveContentsDirectory(job->hubPath, &resolveError);
+        if (contentsDirectoryPath.isEmpty())
+        {
+            return failResourceImportJob(job, resolveError, false);
+        }
+
+        job->resourcesFilePath = QDir(contentsDirectoryPath).filePath(QStringLiteral("Resources.wsresources"));
+        job->hadResourcesFile = QFileInfo(job->resourcesFilePath).isFile();
+        if (job->hadResourcesFile
+            && !readUtf8FileText(job->resourcesFilePath, &job->previousResourcesFileText, &resolveError))
+        {
+            return failResourceImportJob(job, resolveError, false);
+        }
+
+        QStringList existingResourcePaths;
+        if (!loadExistingResourcePaths(job->resourcesFilePath, &existingResourcePaths, &resolveError))
+        {
+            return failResourceImportJob(job, resolveError, false);
+        }
+
+        const QString resourcesDirectoryPath =
+            resolveResourcesDirectory(job->hubPath, existingResourcePaths, &resolveError);
+        if (resourcesDirectoryPath.isEmpty())
+        {
+            return failResourceImportJob(job, resolveError, false);
+        }
+
+        const QStringList& sourceFiles = job->sourceFiles;
+        const QStringList preflightConflictSourceFiles = conflictCheckedSourceFiles(
+            sourceFiles,
+            job->randomizeDefaultClipboardResourceNames);
+        ImportConflictDescriptor conflictDescriptor;
+        if (!preflightConflictSourceFiles.isEmpty()
+            && !findFirstImportConflict(
+                preflightConflictSourceFiles,
+                resourcesDirectoryPath,
+                &conflictDescriptor,
+                &resolveError))
+        {
+            return failResourceImportJob(job, resolveError, false);
+        }
+
+        const ImportConflictPolicyValue conflictPolicy = normalizedImportConflictPolicy(job->conflictPolicy);
+        if (conflictDescriptor.valid() && conflictPolicy == ImportConflictPolicyValue::Abort)
+        {
+            return failResourceImportJob(job, duplicateImportResolutionRequiredMessage(conflictDescriptor), false);
+        }
+
+        // Overall progress is measured in source bytes across the whole batch; per-file progress is reported per
+        // chunk.
+        qint64 importBytesTotal = 0;
+        for (const QString& sourceFilePath : sourceFiles)
+        {
+            importBytesTotal += QFileInfo(sourceFilePath).size();
+        }
+        qint64 importBytesCompleted = 0;
+        const int fileCount = static_cast<int>(sourceFiles.size());
+        job->importedResourcePaths.reserve(fileCount);
+        job->createdPackagePaths.reserve(fileCount);
+        job->importedEntries.reserve(fileCount);
+
+        for (int sourceFileIndex = 0; sourceFileIndex < fileCount; ++sourceFileIndex)
+        {
+            const QString& sourceFilePath = sourceFiles.at(sourceFileIndex);
+            ImportConflictDescriptor sourceFileConflictDescriptor;
+            if (!shouldRandomizeDefaultClipboardResourceFile(
+                    sourceFilePath,
+                    job->randomizeDefaultClipboardResourceNames)
+                && !findFirstImportConflict(
+                    QStringList{sourceFilePath},
+                    resourcesDirectoryPath,
+                    &sourceFileConflictDescriptor,
+                    &resolveError))
+            {
+                return failResourceImportJob(job, resolveError, true);
+            }
+
+            QString resourcePath;
+            QString packagePath;
+            WhatSon::Resources::ResourcePackageMetadata importedMetadata;
+            WhatSon::Clipboard::StreamedFile importedAsset;
+            QString backupDirectoryPath;
+            QString importError;
+            const QString sourceFileName = QFileInfo(sourceFilePath).fileName();
+            const WhatSon::Clipboard::StreamProgress progress =
+                [&reportProgress, sourceFileIndex, fileCount, &sourceFileName, importBytesCompleted, importBytesTotal](
+                const qint64 bytesDone,
+                const qint64 bytesTotal)
+            {
+                const double overallProgress = importBytesTotal > 0
+                    ? static_cast<double>(importBytesCompleted + bytesDone) / static_cast<double>(importBytesTotal)
+                    : 0.0;
+                reportProgress(sourceFileIndex, fileCount, sourceFileName, bytesDone, bytesTotal, overallProgress);
+            };
+            const bool shouldOverwrite =
+                sourceFileConflictDescriptor.valid()
+                && conflictPolicy == ImportConflictPolicyValue::Overwrite;
+            const bool imported =
+                shouldOverwrite
+                    ? overwriteSingleFile(
+                        sourceFilePath,
+                        sourceFileConflictDescriptor,
+                        resourcesDirectoryPath,
+                        progress,
+                        &resourcePath,
+                        &packagePath,
+                        &importedMetadata,
+                        &importedAsset,
+                        &backupDirectoryPath,
+                        &importError)
+                    : importSingleFile(
+                        sourceFilePath,
+                        resourcesDirectoryPath,
+                        job->randomizeDefaultClipboardResourceNames,
+                        progress,
+                        &resourcePath,
+                        &packagePath,
+                        &importedMetadata,
+                        &importedAsset,
+                        &importError);
+            if (!imported)
+            {
+                return failResourceImportJob(job, importError, true);
+            }
+
+            importBytesCompleted += importedAsset.byteCount;
+            job->importedResourcePaths.push_back(resourcePath);
+            if (shouldOverwrite)
+            {
+                bool existingBackupTracked = false;
+                for (const OverwrittenPackageBackup& backup : std::as_const(job->overwrittenPackageBackups))
+                {
+                    if (backup.packageDirectoryPath == packagePath)
+                    {
+                        existingBackupTracked = true;
+                        break;
+                    }
+                }
+
+                if (existingBackupTracked)
+                {
+                    if (!backupDirectoryPath.trimmed().isEmpty() && QFileInfo(backupDirectoryPath).exists())
+                    {
+                        QDir(backupDirectoryPath).removeRecursively();
+                    }
+                }
+                else
+                {
+                    job->overwrittenPackageBackups.push_back(OverwrittenPackageBackup{
+                        backupDirectoryPath,
+                        packagePath
+                    });
+                }
+            }
+            else
+            {
+                job->createdPackagePaths.push_back(packagePath);
+            }
+            job->importedEntries.push_back(importedEntryFromMetadata(importedMetadata, importedAsset));
+        }
+
+        QStringList mergedResourcePaths = existingResourcePaths;
+        for (const QString& resourcePath : std::as_const(job->importedResourcePaths))
+        {
+            if (!mergedResourcePaths.contains(resourcePath))
+            {
+                mergedResourcePaths.push_back(resourcePath);
+            }
+        }
+
+        WhatSonResourcesHierarchyStore store;
+        store.setHubPath(job->hubPath);
+        store.setResourcePaths(mergedResourcePaths);
+
+        QString writeError;
+        if (!store.writeToFile(job->resourcesFilePath, &writeError))
+        {
+            return failResourceImportJob(job, writeError, true);
+        }
+
+        job->succeeded = true;
+        return true;
+    }
+
+    void discardOverwrittenPackageBackups(const ResourceImportJob& job)
+    {
+        for (const OverwrittenPackageBackup& backup : std::as_const(job.overwrittenPackageBackups))
+        {
+            if (!backup.backupDirectoryPath.trimmed().isEmpty() && QFileInfo(backup.backupDirectoryPath).exists())
+            {
+                QDir(backup.backupDirectoryPath).removeRecursively();
+            }
+        }
+    }
+
+    // A crash or forced quit mid-import leaves its hidden staging directory behind; nothing else ever owns one.
+    int removeImportStagingDirectories(const QString& hubPath)
+    {
+        int removedCount = 0;
+        for (const QString& resourcesDirectoryPath : WhatSon::Resources::resolveResourceRootDirectories(hubPath))
+        {
+            const QFileInfoList stagingDirectories = QDir(resourcesDirectoryPath).entryInfoList(
+                QStringList{QStringLiteral(".import-staging-*")},
+                QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot);
+            for (const QFileInfo& stagingDirectory : stagingDirectories)
+            {
+                if (QDir(stagingDirectory.absoluteFilePath()).removeRecursively())
+                {
+                    ++removedCount;
+                }
+            }
+        }
+        return removedCount;
+    }
+} // namespace
 
 QString InAppClipboardManager::currentHubPath() const
 {
@@ -1472,6 +1855,7 @@ void InAppClipboardManager::setCurrentHubPath(QString hubPath)
         QString::fromLatin1(kScope),
         QStringLiteral("setCurrentHubPath"),
         QStringLiteral("value=%1").arg(m_currentHubPath));
+    removeStaleImportStagingDirectories();
     emit currentHubPathChanged();
 }
 
@@ -1480,6 +1864,11 @@ bool InAppClipboardManager::busy() const noexcept
     return m_busy;
 }
 
+double InAppClipboardManager::importProgress() const noexcept
+{
+    return m_importProgress;
+}
+
 QString InAppClipboardManager::lastError() const
 {
     return m_lastError;
@@ -1490,6 +1879,11 @@ void InAppClipboardManager::setReloadResourcesCallback(std::function<bool(const
     m_reloadResourcesCallback = std::move(callback);
 }
 
+QVariantList InAppClipboardManager::lastImportedEntries() const
+{
+    return m_lastImportedEntries;
+}
+
 bool InAppClipboardManager::canImportUrls(const QVariantList& urls) const
 {
     if (m_busy || m_currentHubPath.trimmed().isEmpty())
@@ -1549,30 +1943,15 @@ QVariantMap InAppClipboardManager::inspectImportConflictForUrls(const QVariantLi
 
 bool InAppClipboardManager::importUrls(const QVariantList& urls)
 {
-    return importUrlsInternal(urls, nullptr, true, ConflictPolicyAbort, false);
+    return importUrlsInternal(urls, ConflictPolicyAbort, false);
 }
 
 bool InAppClipboardManager::importUrlsWithConflictPolicy(const QVariantList& urls, const int conflictPolicy)
 {
-    return importUrlsInternal(urls, nullptr, true, conflictPolicy, false);
+    return importUrlsInternal(urls, conflictPolicy, false);
 }
 
 bool InAppClipboardManager::importClipboardResource(const int conflictPolicy)
-{
-    return importClipboardResourceInternal(nullptr, true, conflictPolicy);
-}
-
-bool InAppClipboardManager::refreshClipboardResourceAvailabilitySnapshot()
-{
-    const bool captured = captureSystemClipboardResource();
-    emit resourceChanged();
-    return captured;
-}
-
-bool InAppClipboardManager::importClipboardResourceInternal(
-    QVariantList* importedEntries,
-    const bool reloadRuntime,
-    const int conflictPolicy)
 {
     if (!hasResource() && !captureSystemClipboardResource())
     {
@@ -1583,12 +1962,13 @@ bool InAppClipboardManager::importClipboardResourceInternal(
         return false;
     }
 
-    QTemporaryDir temporaryDirectory;
+    // The materialized payload has to outlive the queued import, so the job owns its temporary directory.
+    auto payloadDirectory = std::make_shared<QTemporaryDir>();
     QString localFilePath;
     QString materializeError;
     if (!materializeClipboardResourceImport(
         resourceImport(),
-        &temporaryDirectory,
+        payloadDirectory.get(),
         &localFilePath,
         &materializeError))
     {
@@ -1598,25 +1978,25 @@ bool InAppClipboardManager::importClipboardResourceInternal(
         return false;
     }
 
-    const bool imported = importUrlsInternal(
+    return importUrlsInternal(
         QVariantList{QUrl::fromLocalFile(localFilePath)},
-        importedEntries,
-        reloadRuntime,
         conflictPolicy,
-        true);
-    if (imported)
-    {
-        clear();
-    }
-    return imported;
+        true,
+        std::move(payloadDirectory));
+}
+
+bool InAppClipboardManager::refreshClipboardResourceAvailabilitySnapshot()
+{
+    const bool captured = captureSystemClipboardResource();
+    emit resourceChanged();
+    return captured;
 }
 
 bool InAppClipboardManager::importUrlsInternal(
     const QVariantList& urls,
-    QVariantList* importedEntries,
-    const bool reloadRuntime,
     const int conflictPolicy,
-    const bool randomizeDefaultClipboardResourceNames)
+    const bool randomizeDefaultClipboardResourceNames,
+    std::shared_ptr<QTemporaryDir> clipboardPayloadDirectory)
 {
     WhatSon::Debug::traceSelf(
         this,
@@ -1649,281 +2029,74 @@ bool InAppClipboardManager::importUrlsInternal(
         return false;
     }
 
-    QString resolveError;
-    QString contentsDirectoryPath = resolveContentsDirectory(m_currentHubPath, &resolveError);
-    if (contentsDirectoryPath.isEmpty())
-    {
-        setLastError(resolveError);
-        emit operationFailed(resolveError);
-        return false;
-    }
-
-    const QString resourcesFilePath = QDir(contentsDirectoryPath).filePath(QStringLiteral("Resources.wsresources"));
-    const bool hadResourcesFile = QFileInfo(resourcesFilePath).isFile();
-    QString previousResourcesFileText;
-    if (hadResourcesFile && !readUtf8FileText(resourcesFilePath, &previousResourcesFileText, &resolveError))
-    {
-        setLastError(resolveError);
-        emit operationFailed(resolveError);
-        return false;
-    }
-
-    QStringList existingResourcePaths;
-    if (!loadExistingResourcePaths(resourcesFilePath, &existingResourcePaths, &resolveError))
-    {
-        setLastError(resolveError);
-        emit operationFailed(resolveError);
-        return false;
-    }
-
-    const QString resourcesDirectoryPath = resolveResourcesDirectory(m_currentHubPath, existingResourcePaths, &resolveError);
-    if (resourcesDirectoryPath.isEmpty())
-    {
-        setLastError(resolveError);
-        emit operationFailed(resolveError);
-        return false;
-    }
-
-    const QStringList preflightConflictSourceFiles = conflictCheckedSourceFiles(
-        sourceFiles,
-        randomizeDefaultClipboardResourceNames);
-    ImportConflictDescriptor conflictDescriptor;
-    if (!preflightConflictSourceFiles.isEmpty()
-        && !findFirstImportConflict(
-            preflightConflictSourceFiles,
-            resourcesDirectoryPath,
-            &conflictDescriptor,
-            &resolveError))
-    {
-        setLastError(resolveError);
-        emit operationFailed(resolveError);
-        return false;
-    }
-
-    const ImportConflictPolicyValue normalizedConflictPolicy = normalizedImportConflictPolicy(conflictPolicy);
-    if (conflictDescriptor.valid() && normalizedConflictPolicy == ImportConflictPolicyValue::Abort)
-    {
-        const QString errorMessage = duplicateImportResolutionRequiredMessage(conflictDescriptor);
-        setLastError(errorMessage);
-        emit operationFailed(errorMessage);
-        return false;
-    }
+    auto job = std::make_shared<ResourceImportJob>();
+    job->hubPath = m_currentHubPath;
+    job->sourceFiles = sourceFiles;
+    job->conflictPolicy = conflictPolicy;
+    job->randomizeDefaultClipboardResourceNames = randomizeDefaultClipboardResourceNames;
+    job->clipboardPayloadDirectory = std::move(clipboardPayloadDirectory);
 
     setBusy(true);
     setLastError(QString());
-
-    QStringList importedResourcePaths;
-    QStringList createdPackagePaths;
-    QList<OverwrittenPackageBackup> overwrittenPackageBackups;
-    importedResourcePaths.reserve(sourceFiles.size());
-    createdPackagePaths.reserve(sourceFiles.size());
-    QVariantList localImportedEntries;
-    if (importedEntries != nullptr)
-    {
-        localImportedEntries.reserve(sourceFiles.size());
-    }
-    bool wroteResourcesFile = false;
-
-    auto rollbackImportedResources = [&](const bool restoreResourcesFile, QString* rollbackError = nullptr)
-    {
-        QStringList rollbackErrors;
-
-        for (const QString& createdPackagePath : std::as_const(createdPackagePaths))
-        {
-            if (!QFileInfo(createdPackagePath).exists())
-            {
-                continue;
-            }
-
-            if (!QDir(createdPackagePath).removeRecursively())
-            {
-                rollbackErrors.push_back(
-                    QStringLiteral("Failed to remove imported resource package: %1").arg(createdPackagePath));
-            }
-        }
-
-        for (const OverwrittenPackageBackup& backup : std::as_const(overwrittenPackageBackups))
-        {
-            if (!backup.packageDirectoryPath.trimmed().isEmpty()
-                && QFileInfo(backup.packageDirectoryPath).exists()
-                && !QDir(backup.packageDirectoryPath).removeRecursively())
-            {
-                rollbackErrors.push_back(
-                    QStringLiteral("Failed to clear overwritten resource package: %1").arg(
-                        backup.packageDirectoryPath));
-            }
-
-            if (!backup.backupDirectoryPath.trimmed().isEmpty()
-                && QFileInfo(backup.backupDirectoryPath).exists()
-                && !QDir().rename(backup.backupDirectoryPath, backup.packageDirectoryPath))
-            {
-                rollbackErrors.push_back(
-                    QStringLiteral("Failed to restore overwritten resource package: %1").arg(
-                        backup.packageDirectoryPath));
-            }
-        }
-
-        if (restoreResourcesFile)
-        {
-            if (hadResourcesFile)
-            {
-                QString restoreError;
-                if (!writeUtf8FileAtomically(resourcesFilePath, previousResourcesFileText, &restoreError))
+    setImportProgress(0.0);
+
+    // The worker never touches this object directly: progress and completion are posted back as queued calls, and
+    // the destructor drains the pool before any of them could outlive the manager.
+    m_importPool.start(
+        [this, job]()
+        {
+            runResourceImportJob(
+                job.get(),
+                [this](
+                const int fileIndex,
+                const int fileCount,
+                const QString& fileName,
+                const qint64 bytesDone,
+                const qint64 bytesTotal,
+                const double overallProgress)
                 {
-                    rollbackErrors.push_back(restoreError);
-                }
-            }
-            else if (QFileInfo(resourcesFilePath).exists() && !QFile::remove(resourcesFilePath))
-            {
-                rollbackErrors.push_back(
-                    QStringLiteral("Failed to remove restored Resources.wsresources file: %1").arg(resourcesFilePath));
-            }
-        }
-
-        if (rollbackError != nullptr)
-        {
-            *rollbackError = rollbackErrors.join(QStringLiteral("; "));
-        }
-        return rollbackErrors.isEmpty();
-    };
-
-    for (const QString& sourceFilePath : sourceFiles)
-    {
-        ImportConflictDescriptor sourceFileConflictDescriptor;
-        if (!shouldRandomizeDefaultClipboardResourceFile(
-                sourceFilePath,
-                randomizeDefaultClipboardResourceNames)
-            && !findFirstImportConflict(
-                QStringList{sourceFilePath},
-                resourcesDirectoryPath,
-                &sourceFileConflictDescriptor,
-                &resolveError))
-        {
-            rollbackImportedResources(false, nullptr);
-
-            setBusy(false);
-            setLastError(resolveError);
-            emit operationFailed(resolveError);
-            return false;
-        }
-
-        QString resourcePath;
-        QString packagePath;
-        WhatSon::Resources::ResourcePackageMetadata importedMetadata;
-        QString backupDirectoryPath;
-        QString importError;
-        const bool shouldOverwrite =
-            sourceFileConflictDescriptor.valid()
-            && normalizedConflictPolicy == ImportConflictPolicyValue::Overwrite;
-        const bool imported =
-            shouldOverwrite
-                ? overwriteSingleFile(
-                    sourceFilePath,
-                    sourceFileConflictDescriptor,
-                    resourcesDirectoryPath,
-                    &resourcePath,
-                    &packagePath,
-                    &importedMetadata,
-                    &backupDirectoryPath,
-                    &importError)
-                : importSingleFile(
-                    sourceFilePath,
-                    resourcesDirectoryPath,
-                    randomizeDefaultClipboardResourceNames,
-                    &resourcePath,
-                    &packagePath,
-                    &importedMetadata,
-                    &importError);
-        if (!imported)
-        {
-            rollbackImportedResources(false, nullptr);
-
-            setBusy(false);
-            setLastError(importError);
-            emit operationFailed(importError);
-            WhatSon::Debug::traceSelf(
+                    QMetaObject::invokeMethod(
+                        this,
+                        [this, fileIndex, fileCount, fileName, bytesDone, bytesTotal, overallProgress]()
+                        {
+                            emit importFileProgress(fileIndex, fileCount, fileName, bytesDone, bytesTotal);
+                            setImportProgress(overallProgress);
+                        },
+                        Qt::QueuedConnection);
+                });
+            QMetaObject::invokeMethod(
                 this,
-                QString::fromLatin1(kScope),
-                QStringLiteral("importUrls.failed"),
-                QStringLiteral("reason=%1").arg(importError));
-            return false;
-        }
-
-        importedResourcePaths.push_back(resourcePath);
-        if (shouldOverwrite)
-        {
-            bool existingBackupTracked = false;
-            for (const OverwrittenPackageBackup& backup : std::as_const(overwrittenPackageBackups))
-            {
-                if (backup.packageDirectoryPath == packagePath)
+                [this, job]()
                 {
-                    existingBackupTracked = true;
-                    break;
-                }
-            }
-
-            if (existingBackupTracked)
-            {
-                if (!backupDirectoryPath.trimmed().isEmpty() && QFileInfo(backupDirectoryPath).exists())
-                {
-                    QDir(backupDirectoryPath).removeRecursively();
-                }
-            }
-            else
-            {
-                overwrittenPackageBackups.push_back(OverwrittenPackageBackup{
-                    backupDirectoryPath,
-                    packagePath
-                });
-            }
-        }
-        else
-        {
-            createdPackagePaths.push_back(packagePath);
-        }
-        if (importedEntries != nullptr)
-        {
-            localImportedEntries.push_back(importedEntryFromMetadata(importedMetadata));
-        }
-    }
-
-    QStringList mergedResourcePaths = existingResourcePaths;
-    for (const QString& resourcePath : std::as_const(importedResourcePaths))
-    {
-        if (!mergedResourcePaths.contains(resourcePath))
-        {
-            mergedResourcePaths.push_back(resourcePath);
-        }
-    }
-
-    WhatSonResourcesHierarchyStore store;
-    store.setHubPath(m_currentHubPath);
-    store.setResourcePaths(mergedResourcePaths);
+                    finishResourceImport(job);
+                },
+                Qt::QueuedConnection);
+        });
+    return true;
+}
 
-    QString writeError;
-    if (!store.writeToFile(resourcesFilePath, &writeError))
+void InAppClipboardManager::finishResourceImport(const std::shared_ptr<ResourceImportJob>& job)
+{
+    if (!job->succeeded)
     {
-        rollbackImportedResources(false, nullptr);
-
         setBusy(false);
-        setLastError(writeError);
-        emit operationFailed(writeError);
+        setLastError(job->errorMessage);
+        emit operationFailed(job->errorMessage);
         WhatSon::Debug::traceSelf(
             this,
             QString::fromLatin1(kScope),
             QStringLiteral("importUrls.failed"),
-            QStringLiteral("reason=%1").arg(writeError));
-        return false;
+            QStringLiteral("reason=%1").arg(job->errorMessage));
+        return;
     }
-    wroteResourcesFile = true;
 
-    if (reloadRuntime && m_reloadResourcesCallback)
+    if (m_reloadResourcesCallback)
     {
         QString reloadError;
-        if (!m_reloadResourcesCallback(m_currentHubPath, &reloadError))
+        if (!m_reloadResourcesCallback(job->hubPath, &reloadError))
         {
             QString rollbackError;
-            rollbackImportedResources(wroteResourcesFile, &rollbackError);
+            rollBackResourceImport(*job, true, &rollbackError);
             const QString errorMessage = reloadError.trimmed().isEmpty()
                                              ? QStringLiteral("Imported resources but failed to refresh the workspace.")
                                              : QStringLiteral(
@@ -1942,30 +2115,49 @@ bool InAppClipboardManager::importUrlsInternal(
                 QString::fromLatin1(kScope),
                 QStringLiteral("importUrls.reloadFailed"),
                 QStringLiteral("reason=%1").arg(finalErrorMessage));
-            return false;
+            return;
         }
     }
 
-    setBusy(false);
-    setLastError(QString());
-    for (const OverwrittenPackageBackup& backup : std::as_const(overwrittenPackageBackups))
+    discardOverwrittenPackageBackups(*job);
+    m_lastImportedEntries = job->importedEntries;
+    if (job->randomizeDefaultClipboardResourceNames)
     {
-        if (!backup.backupDirectoryPath.trimmed().isEmpty() && QFileInfo(backup.backupDirectoryPath).exists())
-        {
-            QDir(backup.backupDirectoryPath).removeRecursively();
-        }
+        // Only clipboard imports randomize default names; once committed they consume the clipboard snapshot.
+        clear();
     }
-    emit importCompleted(importedResourcePaths.size());
+    setImportProgress(1.0);
+    setBusy(false);
+    setLastError(QString());
+    emit importCompleted(static_cast<int>(job->importedResourcePaths.size()));
     WhatSon::Debug::traceSelf(
         this,
         QString::fromLatin1(kScope),
         QStringLiteral("importUrls.success"),
-        QStringLiteral("importedCount=%1").arg(importedResourcePaths.size()));
-    if (importedEntries != nullptr)
+        QStringLiteral("importedCount=%1").arg(job->importedResourcePaths.size()));
+}
+
+void InAppClipboardManager::removeStaleImportStagingDirectories()
+{
+    if (m_currentHubPath.isEmpty())
     {
-        *importedEntries = localImportedEntries;
+        return;
     }
-    return true;
+
+    // Queued on the import pool, so the sweep runs before any import started against this hub.
+    const QString hubPath = m_currentHubPath;
+    m_importPool.start(
+        [hubPath]()
+        {
+            const int removedCount = removeImportStagingDirectories(hubPath);
+            if (removedCount > 0)
+            {
+                WhatSon::Debug::trace(
+                    QString::fromLatin1(kScope),
+                    QStringLiteral("removeStaleImportStaging"),
+                    QStringLiteral("hub=%1 removed=%2").arg(hubPath).arg(removedCount));
+            }
+        });
 }
 
 bool InAppClipboardManager::importDroppedUrls(const QVariantList& urls)
@@ -2032,6 +2224,18 @@ void InAppClipboardManager::setBusy(const bool busy)
     emit busyChanged();
 }
 
+void InAppClipboardManager::setImportProgress(const double progress)
+{
+    const double boundedProgress = std::clamp(progress, 0.0, 1.0);
+    if (qFuzzyCompare(1.0 + m_importProgress, 1.0 + boundedProgress))
+    {
+        return;
+    }
+
+    m_importProgress = boundedProgress;
+    emit importProgressChanged();
+}
+
 void InAppClipboardManager::setLastError(QString errorMessage)
 {
     errorMessage = errorMessage.trimmed();
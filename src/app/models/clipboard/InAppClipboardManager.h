@@ -5,13 +5,21 @@
 
 #include <QObject>
 #include <QString>
+#include <QThreadPool>
 #include <QVariantList>
 #include <QVariantMap>
 
 #include <functional>
+#include <memory>
 
 class QClipboard;
 class QMimeData;
+class QTemporaryDir;
+
+namespace WhatSon::Clipboard
+{
+    struct ResourceImportJob;
+}
 
 class InAppClipboardManager final : public QObject
 {
@@ -20,6 +28,7 @@ class InAppClipboardManager final : public QObject
     Q_PROPERTY(QString currentHubPath READ currentHubPath WRITE setCurrentHubPath NOTIFY currentHubPathChanged)
     Q_PROPERTY(bool hasResource READ hasResource NOTIFY resourceChanged)
     Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
+    Q_PROPERTY(double importProgress READ importProgress NOTIFY importProgressChanged)
     Q_PROPERTY(QString resourceFileName READ resourceFileName NOTIFY resourceChanged)
     Q_PROPERTY(QString resourceFormat READ resourceFormat NOTIFY resourceChanged)
     Q_PROPERTY(QString resourceType READ resourceType NOTIFY resourceChanged)
@@ -44,6 +53,7 @@ public:
 
     bool hasResource() const noexcept;
     bool busy() const noexcept;
+    double importProgress() const noexcept;
     QString resourceFileName() const;
     QString resourceFormat() const;
     QString resourceType() const;
@@ -53,6 +63,7 @@ public:
     QVariantMap resourceEntry() const;
 
     void setReloadResourcesCallback(std::function<bool(const QString&, QString*)> callback);
+    QVariantList lastImportedEntries() const;
 
     const WhatSon::Clipboard::ClipboardResourceImport& resourceImport() const noexcept;
     WhatSon::Clipboard::ClipboardResourceImport takeResourceImport();
@@ -92,6 +103,8 @@ public slots:
 signals:
     void currentHubPathChanged();
     void busyChanged();
+    void importProgressChanged();
+    void importFileProgress(int fileIndex, int fileCount, const QString& fileName, qint64 bytesDone, qint64 bytesTotal);
     void lastErrorChanged();
     void importCompleted(int importedCount);
     void operationFailed(const QString& message);
@@ -101,20 +114,21 @@ signals:
 private:
     bool importUrlsInternal(
         const QVariantList& urls,
-        QVariantList* importedEntries,
-        bool reloadRuntime,
         int conflictPolicy,
-        bool randomizeDefaultClipboardResourceNames);
-    bool importClipboardResourceInternal(
-        QVariantList* importedEntries,
-        bool reloadRuntime,
-        int conflictPolicy);
+        bool randomizeDefaultClipboardResourceNames,
+        std::shared_ptr<QTemporaryDir> clipboardPayloadDirectory = {});
+    void finishResourceImport(const std::shared_ptr<WhatSon::Clipboard::ResourceImportJob>& job);
+    void removeStaleImportStagingDirectories();
     void setBusy(bool busy);
+    void setImportProgress(double progress);
     void setLastError(QString errorMessage);
 
     QString m_currentHubPath;
     InAppClipboardStore m_store;
     bool m_busy = false;
+    double m_importProgress = 0.0;
     QString m_lastError;
+    QVariantList m_lastImportedEntries;
     std::function<bool(const QString&, QString*)> m_reloadResourcesCallback;
+    QThreadPool m_importPool;
 };
@@ -0,0 +1,179 @@
+#include "app/models/clipboard/ResourceImportStream.h"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+
+#include <algorithm>
+
+namespace
+{
+    void setError(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+    }
+} // namespace
+
+namespace WhatSon::Clipboard
+{
+    bool streamDeviceToFile(
+        QIODevice* source,
+        const qint64 sourceByteCount,
+        const QString& destinationFilePath,
+        const StreamProgress& progress,
+        StreamedFile* outFile,
+        QString* errorMessage)
+    {
+        if (source == nullptr || !source->isOpen() || outFile == nullptr)
+        {
+            setError(errorMessage, QStringLiteral("Stream source and output must not be null."));
+            return false;
+        }
+        *outFile = {};
+
+        QFile destination(destinationFilePath);
+        if (!destination.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            setError(errorMessage, QStringLiteral("Failed to open resource asset for write: %1").arg(destinationFilePath));
+            return false;
+        }
+
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        QByteArray chunk(static_cast<qsizetype>(kStreamChunkBytes), Qt::Uninitialized);
+        qint64 bytesDone = 0;
+        while (true)
+        {
+            const qint64 bytesRead = source->read(chunk.data(), kStreamChunkBytes);
+            if (bytesRead < 0)
+            {
+                destination.close();
+                QFile::remove(destinationFilePath);
+                setError(errorMessage, QStringLiteral("Failed to read resource source: %1").arg(source->errorString()));
+                return false;
+            }
+            if (bytesRead == 0)
+            {
+                break;
+            }
+
+            const char* data = chunk.constData();
+            qint64 bytesWritten = 0;
+            while (bytesWritten < bytesRead)
+            {
+                const qint64 written = destination.write(data + bytesWritten, bytesRead - bytesWritten);
+                if (written <= 0)
+                {
+                    destination.close();
+                    QFile::remove(destinationFilePath);
+                    setError(errorMessage, QStringLiteral("Failed to write resource asset: %1").arg(destinationFilePath));
+                    return false;
+                }
+                bytesWritten += written;
+            }
+            hash.addData(QByteArrayView(data, static_cast<qsizetype>(bytesRead)));
+            bytesDone += bytesRead;
+            if (progress)
+            {
+                progress(bytesDone, std::max(sourceByteCount, bytesDone));
+            }
+        }
+
+        if (!destination.flush())
+        {
+            destination.close();
+            QFile::remove(destinationFilePath);
+            setError(errorMessage, QStringLiteral("Failed to flush resource asset: %1").arg(destinationFilePath));
+            return false;
+        }
+        destination.close();
+
+        const QByteArray sha256Hex = hash.result().toHex();
+        QString verifyError;
+        const QByteArray writtenSha256Hex = fileSha256Hex(destinationFilePath, &verifyError);
+        const qint64 writtenByteCount = QFileInfo(destinationFilePath).size();
+        if ((sourceByteCount >= 0 && bytesDone != sourceByteCount)
+            || writtenByteCount != bytesDone
+            || writtenSha256Hex != sha256Hex)
+        {
+            QFile::remove(destinationFilePath);
+            setError(
+                errorMessage,
+                verifyError.isEmpty()
+                    ? QStringLiteral("Resource asset failed verification: %1 (expected %2 bytes, read %3, wrote %4)")
+                      .arg(destinationFilePath)
+                      .arg(sourceByteCount)
+                      .arg(bytesDone)
+                      .arg(writtenByteCount)
+                    : verifyError);
+            return false;
+        }
+
+        outFile->byteCount = bytesDone;
+        outFile->sha256Hex = sha256Hex;
+        WhatSon::Debug::trace(
+            QStringLiteral("clipboard.import.stream"),
+            QStringLiteral("verified"),
+            QStringLiteral("path=%1 bytes=%2 sha256=%3")
+            .arg(destinationFilePath)
+            .arg(bytesDone)
+            .arg(QString::fromLatin1(sha256Hex)));
+        return true;
+    }
+
+    bool streamFileToFile(
+        const QString& sourceFilePath,
+        const QString& destinationFilePath,
+        const StreamProgress& progress,
+        StreamedFile* outFile,
+        QString* errorMessage)
+    {
+        QFile source(sourceFilePath);
+        if (!source.open(QIODevice::ReadOnly))
+        {
+            setError(errorMessage, QStringLiteral("Failed to open resource source: %1").arg(sourceFilePath));
+            return false;
+        }
+        return streamDeviceToFile(&source, source.size(), destinationFilePath, progress, outFile, errorMessage);
+    }
+
+    bool streamBytesToFile(
+        const QByteArray& bytes,
+        const QString& destinationFilePath,
+        StreamedFile* outFile,
+        QString* errorMessage)
+    {
+        QBuffer source;
+        source.setData(bytes);
+        if (!source.open(QIODevice::ReadOnly))
+        {
+            setError(errorMessage, QStringLiteral("Failed to open in-memory resource payload."));
+            return false;
+        }
+        return streamDeviceToFile(&source, bytes.size(), destinationFilePath, {}, outFile, errorMessage);
+    }
+
+    QByteArray fileSha256Hex(const QString& filePath, QString* errorMessage)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            setError(errorMessage, QStringLiteral("Failed to reopen resource asset for verification: %1").arg(filePath));
+            return {};
+        }
+
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        if (!hash.addData(&file))
+        {
+            setError(errorMessage, QStringLiteral("Failed to read resource asset for verification: %1").arg(filePath));
+            return {};
+        }
+        return hash.result().toHex();
+    }
+} // namespace WhatSon::Clipboard
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <functional>
+
+class QIODevice;
+
+namespace WhatSon::Clipboard
+{
+    // Streaming copy engine behind resource package imports. Bytes move in fixed-size chunks and are hashed in the
+    // same pass; the written file is then re-read and compared by size and hash, so a short write or a source that
+    // changed during the copy fails the import instead of landing in the hub.
+    struct StreamedFile final
+    {
+        qint64 byteCount = 0;
+        QByteArray sha256Hex;
+    };
+
+    // Called after every chunk with the bytes written so far for the current file.
+    using StreamProgress = std::function<void(qint64 bytesDone, qint64 bytesTotal)>;
+
+    constexpr qint64 kStreamChunkBytes = 1024 * 1024;
+
+    bool streamDeviceToFile(
+        QIODevice* source,
+        qint64 sourceByteCount,
+        const QString& destinationFilePath,
+        const StreamProgress& progress,
+        StreamedFile* outFile,
+        QString* errorMessage = nullptr);
+    bool streamFileToFile(
+        const QString& sourceFilePath,
+        const QString& destinationFilePath,
+        const StreamProgress& progress,
+        StreamedFile* outFile,
+        QString* errorMessage = nullptr);
+    bool streamBytesToFile(
+        const QByteArray& bytes,
+        const QString& destinationFilePath,
+        StreamedFile* outFile,
+        QString* errorMessage = nullptr);
+
+    QByteArray fileSha256Hex(const QString& filePath, QString* errorMessage = nullptr);
+} // namespace WhatSon::Clipboard
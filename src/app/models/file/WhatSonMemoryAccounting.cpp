@@ -0,0 +1,447 @@
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+
+#include <QByteArray>
+#include <QMetaType>
+#include <QMutexLocker>
+
+namespace
+{
+    // Qt 6 array header (ref count, flags, capacity) ahead of every QString/QList/QByteArray payload.
+    constexpr qint64 kArrayHeaderBytes = 16;
+    // QMap wraps a shared std::map: one header plus a red-black node per entry.
+    constexpr qint64 kMapHeaderBytes = 64;
+    constexpr qint64 kMapNodeOverheadBytes = 32;
+    // QHash spans keep one offset byte per bucket plus the entry storage; rounded up per node.
+    constexpr qint64 kHashNodeOverheadBytes = 8;
+    // Values larger than this do not fit QVariant's inline storage and are heap-allocated.
+    constexpr qsizetype kVariantInlineBytes = 3 * sizeof(void*);
+} // namespace
+
+void WhatSonMemoryEstimate::addInline(const qint64 bytes) noexcept
+{
+    m_bytes += bytes;
+}
+
+void WhatSonMemoryEstimate::addItems(const qint64 count) noexcept
+{
+    m_itemCount += count;
+}
+
+void WhatSonMemoryEstimate::addSharedBlock(const void* block, const qint64 bytes)
+{
+    addPayload(block, bytes);
+}
+
+void WhatSonMemoryEstimate::addString(const QString& text)
+{
+    addInline(sizeof(QString));
+    addStringPayload(text);
+}
+
+void WhatSonMemoryEstimate::addStringList(const QStringList& list)
+{
+    addInline(sizeof(QStringList));
+    addStringListPayload(list);
+}
+
+void WhatSonMemoryEstimate::addVariant(const QVariant& value)
+{
+    addInline(sizeof(QVariant));
+    addVariantPayload(value);
+}
+
+void WhatSonMemoryEstimate::addNoteRecord(const LibraryNoteRecord& note)
+{
+    addInline(sizeof(LibraryNoteRecord));
+    addItems(1);
+    addNoteRecordPayload(note);
+}
+
+void WhatSonMemoryEstimate::addNoteRecords(const QVector<LibraryNoteRecord>& notes)
+{
+    addVector(notes, [](WhatSonMemoryEstimate& estimate, const LibraryNoteRecord& note)
+    {
+        estimate.addNoteRecordPayload(note);
+    });
+}
+
+void WhatSonMemoryEstimate::addStringPayload(const QString& text)
+{
+    addPayload(text.constData(), stringPayloadBytes(text));
+}
+
+void WhatSonMemoryEstimate::addStringListPayload(const QStringList& list)
+{
+    if (list.capacity() <= 0 || !enterSharedPayload(list.constData()))
+    {
+        return;
+    }
+
+    const qint64 bytesBefore = m_bytes;
+    m_bytes += arrayPayloadBytes(list.capacity(), sizeof(QString));
+    for (const QString& text : list)
+    {
+        addStringPayload(text);
+    }
+    leaveSharedPayload(list.constData(), bytesBefore);
+}
+
+void WhatSonMemoryEstimate::addVariantPayload(const QVariant& value)
+{
+    switch (value.metaType().id())
+    {
+    case QMetaType::UnknownType:
+        return;
+    case QMetaType::QString:
+        addStringPayload(*static_cast<const QString*>(value.constData()));
+        return;
+    case QMetaType::QStringList:
+        addStringListPayload(*static_cast<const QStringList*>(value.constData()));
+        return;
+    case QMetaType::QVariantMap:
+        addVariantMapPayload(*static_cast<const QVariantMap*>(value.constData()));
+        return;
+    case QMetaType::QVariantList:
+        addVariantListPayload(*static_cast<const QVariantList*>(value.constData()));
+        return;
+    case QMetaType::QByteArray:
+        {
+            const auto* bytes = static_cast<const QByteArray*>(value.constData());
+            addPayload(bytes->constData(), bytes->capacity() <= 0 ? 0 : bytes->capacity() + 1 + kArrayHeaderBytes);
+            return;
+        }
+    default:
+        break;
+    }
+
+    if (value.metaType().sizeOf() > kVariantInlineBytes)
+    {
+        addPayload(value.constData(), value.metaType().sizeOf() + kArrayHeaderBytes);
+    }
+}
+
+void WhatSonMemoryEstimate::addVariantMapPayload(const QVariantMap& map)
+{
+    // QMap exposes no data pointer; the first node's address identifies the shared std::map.
+    const void* payload = map.isEmpty() ? nullptr : &map.constBegin().value();
+    if (payload == nullptr || !enterSharedPayload(payload))
+    {
+        return;
+    }
+
+    const qint64 bytesBefore = m_bytes;
+    m_bytes += kMapHeaderBytes
+        + static_cast<qint64>(map.size()) * (sizeof(QString) + sizeof(QVariant) + kMapNodeOverheadBytes);
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it)
+    {
+        addStringPayload(it.key());
+        addVariantPayload(it.value());
+    }
+    leaveSharedPayload(payload, bytesBefore);
+}
+
+void WhatSonMemoryEstimate::addVariantListPayload(const QVariantList& list)
+{
+    addVectorPayload(list, [](WhatSonMemoryEstimate& estimate, const QVariant& value)
+    {
+        estimate.addVariantPayload(value);
+    });
+}
+
+void WhatSonMemoryEstimate::addNoteRecordPayload(const LibraryNoteRecord& note)
+{
+    addStringPayload(note.noteId);
+    addStringPayload(note.storageKind);
+    addStringPayload(note.createdAt);
+    addStringPayload(note.lastModifiedAt);
+    addStringPayload(note.author);
+    addStringPayload(note.modifiedBy);
+    addStringPayload(note.project);
+    addStringListPayload(note.folders);
+    addStringListPayload(note.folderUuids);
+    addStringListPayload(note.bookmarkColors);
+    addStringListPayload(note.tags);
+    addStringPayload(note.noteDirectoryPath);
+    addStringPayload(note.noteHeaderPath);
+}
+
+qint64 WhatSonMemoryEstimate::bytes() const noexcept
+{
+    return m_bytes;
+}
+
+qint64 WhatSonMemoryEstimate::sharedBytes() const noexcept
+{
+    return m_sharedBytes;
+}
+
+qint64 WhatSonMemoryEstimate::itemCount() const noexcept
+{
+    return m_itemCount;
+}
+
+void WhatSonMemoryEstimate::beginStructure() noexcept
+{
+    m_bytes = 0;
+    m_sharedBytes = 0;
+    m_itemCount = 0;
+}
+
+qint64 WhatSonMemoryEstimate::stringPayloadBytes(const QString& text) noexcept
+{
+    // Literal and null strings report no capacity: they own no heap block.
+    return arrayPayloadBytes(text.capacity() <= 0 ? 0 : text.capacity() + 1, sizeof(QChar));
+}
+
+qint64 WhatSonMemoryEstimate::arrayPayloadBytes(const qsizetype capacity, const std::size_t elementSize) noexcept
+{
+    return capacity <= 0 ? 0 : static_cast<qint64>(capacity) * static_cast<qint64>(elementSize) + kArrayHeaderBytes;
+}
+
+void WhatSonMemoryEstimate::addPayload(const void* payload, const qint64 bytes)
+{
+    if (payload == nullptr || bytes <= 0)
+    {
+        return;
+    }
+
+    const auto existing = m_payloadBytes.constFind(payload);
+    if (existing != m_payloadBytes.constEnd())
+    {
+        m_sharedBytes += existing.value();
+        return;
+    }
+    m_payloadBytes.insert(payload, bytes);
+    m_bytes += bytes;
+}
+
+void WhatSonMemoryEstimate::addHashNodes(const qsizetype capacity, const std::size_t nodeSize) noexcept
+{
+    if (capacity > 0)
+    {
+        m_bytes += static_cast<qint64>(capacity) * (static_cast<qint64>(nodeSize) + kHashNodeOverheadBytes);
+    }
+}
+
+bool WhatSonMemoryEstimate::enterSharedPayload(const void* payload)
+{
+    const auto existing = m_payloadBytes.constFind(payload);
+    if (existing != m_payloadBytes.constEnd())
+    {
+        m_sharedBytes += existing.value();
+        return false;
+    }
+    m_payloadBytes.insert(payload, 0);
+    return true;
+}
+
+void WhatSonMemoryEstimate::leaveSharedPayload(const void* payload, const qint64 bytesBefore)
+{
+    m_payloadBytes.insert(payload, m_bytes - bytesBefore);
+}
+
+WhatSonMemoryAccounting::WhatSonMemoryAccounting(QObject* parent)
+    : QObject(parent)
+{
+}
+
+WhatSonMemoryAccounting::~WhatSonMemoryAccounting() = default;
+
+WhatSonMemoryAccounting& WhatSonMemoryAccounting::shared()
+{
+    // Intentionally leaked: owners destroyed during shutdown still untrack against a live registry.
+    static WhatSonMemoryAccounting* const accounting = new WhatSonMemoryAccounting;
+    return *accounting;
+}
+
+void WhatSonMemoryAccounting::track(
+    const QObject* owner,
+    QString domain,
+    QString structure,
+    Estimator estimator)
+{
+    if (owner == nullptr || !estimator)
+    {
+        return;
+    }
+
+    bool firstEntryForOwner = true;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const Entry& entry : std::as_const(m_entries))
+        {
+            firstEntryForOwner = firstEntryForOwner && entry.ownerKey != owner;
+        }
+        m_entries.push_back(Entry{owner, owner, std::move(domain), std::move(structure), std::move(estimator)});
+    }
+
+    if (firstEntryForOwner)
+    {
+        // Direct: the owner's members are gone once destroyed() returns, whichever thread the registry lives on.
+        connect(owner, &QObject::destroyed, this, [this, owner]()
+        {
+            untrack(owner);
+        }, Qt::DirectConnection);
+    }
+}
+
+void WhatSonMemoryAccounting::untrack(const QObject* owner)
+{
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        if (it->ownerKey == owner)
+        {
+            it = m_entries.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+int WhatSonMemoryAccounting::trackedCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_entries.size());
+}
+
+QVector<WhatSonMemoryAccounting::Sample> WhatSonMemoryAccounting::sample() const
+{
+    QVector<Entry> entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        entries = m_entries;
+    }
+
+    QVector<Sample> samples;
+    samples.reserve(entries.size());
+    WhatSonMemoryEstimate estimate;
+    for (const Entry& entry : std::as_const(entries))
+    {
+        if (entry.owner.isNull())
+        {
+            continue;
+        }
+
+        estimate.beginStructure();
+        entry.estimator(estimate);
+        samples.push_back(Sample{
+            entry.domain,
+            entry.structure,
+            estimate.itemCount(),
+            estimate.bytes(),
+            estimate.sharedBytes()});
+    }
+    return samples;
+}
+
+qint64 WhatSonMemoryAccounting::domainBytes(const QVector<Sample>& samples, const QString& domain)
+{
+    qint64 bytes = 0;
+    for (const Sample& sample : samples)
+    {
+        if (sample.domain == domain)
+        {
+            bytes += sample.bytes;
+        }
+    }
+    return bytes;
+}
+
+void WhatSonMemoryAccounting::setDomainBudget(const QString& domain, const qint64 maxBytes)
+{
+    QMutexLocker locker(&m_mutex);
+    if (maxBytes <= 0)
+    {
+        m_domainBudgets.remove(domain);
+        return;
+    }
+    m_domainBudgets.insert(domain, maxBytes);
+}
+
+QStringList WhatSonMemoryAccounting::budgetViolations(const QVector<Sample>& samples) const
+{
+    QHash<QString, qint64> budgets;
+    {
+        QMutexLocker locker(&m_mutex);
+        budgets = m_domainBudgets;
+    }
+
+    QStringList violations;
+    for (auto it = budgets.cbegin(); it != budgets.cend(); ++it)
+    {
+        const qint64 bytes = domainBytes(samples, it.key());
+        if (bytes > it.value())
+        {
+            violations.push_back(QStringLiteral("domain=%1 bytes=%2 budget=%3")
+                                 .arg(it.key())
+                                 .arg(bytes)
+                                 .arg(it.value()));
+        }
+    }
+    violations.sort();
+    return violations;
+}
+
+QVariantList WhatSonMemoryAccounting::report() const
+{
+    QHash<QString, qint64> budgets;
+    {
+        QMutexLocker locker(&m_mutex);
+        budgets = m_domainBudgets;
+    }
+
+    QVariantList rows;
+    const QVector<Sample> samples = sample();
+    rows.reserve(samples.size());
+    for (const Sample& sample : samples)
+    {
+        rows.push_back(QVariantMap{
+            {QStringLiteral("domain"), sample.domain},
+            {QStringLiteral("structure"), sample.structure},
+            {QStringLiteral("itemCount"), sample.itemCount},
+            {QStringLiteral("bytes"), sample.bytes},
+            {QStringLiteral("sharedBytes"), sample.sharedBytes},
+            {QStringLiteral("domainBudgetBytes"), budgets.value(sample.domain)}
+        });
+    }
+    return rows;
+}
+
+qint64 WhatSonMemoryAccounting::totalBytes() const
+{
+    qint64 bytes = 0;
+    for (const Sample& sample : sample())
+    {
+        bytes += sample.bytes;
+    }
+    return bytes;
+}
+
+void WhatSonMemoryAccounting::traceReport() const
+{
+    qint64 totalBytes = 0;
+    const QVector<Sample> samples = sample();
+    for (const Sample& sample : samples)
+    {
+        totalBytes += sample.bytes;
+        WhatSon::Debug::traceSelf(this,
+                                  QStringLiteral("memory.accounting"),
+                                  QStringLiteral("sample"),
+                                  QStringLiteral("domain=%1 structure=%2 items=%3 bytes=%4 shared=%5")
+                                  .arg(sample.domain, sample.structure)
+                                  .arg(sample.itemCount)
+                                  .arg(sample.bytes)
+                                  .arg(sample.sharedBytes));
+    }
+
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("memory.accounting"),
+                              QStringLiteral("total"),
+                              QStringLiteral("structures=%1 bytes=%2 violations=%3")
+                              .arg(samples.size())
+                              .arg(totalBytes)
+                              .arg(budgetViolations(samples).join(QStringLiteral("; "))));
+}
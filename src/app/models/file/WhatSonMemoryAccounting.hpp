@@ -0,0 +1,167 @@
+#pragma once
+
+#include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+#include <functional>
+#include <utility>
+
+// Heap estimate for one or more in-memory structures. Qt containers and strings are implicitly shared, so the same
+// payload usually sits behind LibraryAll, the derived buckets, controller copies and model rows at once: a payload is
+// counted the first time it is reached and reported as shared every time after that. Figures follow Qt 6's 64-bit
+// allocation layout and are estimates, not allocator measurements.
+class WhatSonMemoryEstimate final
+{
+public:
+    // Bytes a structure owns directly: its own members and fixed-size slots.
+    void addInline(qint64 bytes) noexcept;
+    void addItems(qint64 count) noexcept;
+    // Bytes of a block several structures reach through one pointer, such as a hub's shared symbol table.
+    void addSharedBlock(const void* block, qint64 bytes);
+
+    void addString(const QString& text);
+    void addStringList(const QStringList& list);
+    void addVariant(const QVariant& value);
+    void addNoteRecord(const LibraryNoteRecord& note);
+    void addNoteRecords(const QVector<LibraryNoteRecord>& notes);
+
+    // Payload-only variants, for values whose handle already sits in a counted slot (a struct member, a vector
+    // element or a hash node).
+    void addStringPayload(const QString& text);
+    void addStringListPayload(const QStringList& list);
+    void addVariantPayload(const QVariant& value);
+    void addVariantMapPayload(const QVariantMap& map);
+    void addVariantListPayload(const QVariantList& list);
+    void addNoteRecordPayload(const LibraryNoteRecord& note);
+
+    // Counts the vector's element slots once per shared payload and calls walkElement(estimate, element) for the
+    // payloads each element points to. A vector whose payload was already counted is not walked again. Only
+    // addVector() counts the elements as items of the structure.
+    template <typename T, typename Walk>
+    void addVector(const QVector<T>& vector, Walk&& walkElement)
+    {
+        addInline(sizeof(QVector<T>));
+        addItems(vector.size());
+        addVectorPayload(vector, std::forward<Walk>(walkElement));
+    }
+
+    template <typename T, typename Walk>
+    void addVectorPayload(const QVector<T>& vector, Walk&& walkElement)
+    {
+        if (vector.capacity() <= 0 || !enterSharedPayload(vector.constData()))
+        {
+            return;
+        }
+
+        const qint64 bytesBefore = m_bytes;
+        m_bytes += arrayPayloadBytes(vector.capacity(), sizeof(T));
+        for (const T& element : vector)
+        {
+            walkElement(*this, element);
+        }
+        leaveSharedPayload(vector.constData(), bytesBefore);
+    }
+
+    // Element slots of a vector of plain values.
+    template <typename T>
+    void addPlainVector(const QVector<T>& vector)
+    {
+        addVector(vector, [](WhatSonMemoryEstimate&, const T&)
+        {
+        });
+    }
+
+    // Node storage of a QHash. Key and value payloads are left to the caller.
+    template <typename K, typename V>
+    void addPlainHash(const QHash<K, V>& hash)
+    {
+        addInline(sizeof(QHash<K, V>));
+        addHashNodes(hash.capacity(), sizeof(K) + sizeof(V));
+    }
+
+    qint64 bytes() const noexcept;
+    qint64 sharedBytes() const noexcept;
+    qint64 itemCount() const noexcept;
+
+    // Starts a new structure while keeping the set of payloads already counted.
+    void beginStructure() noexcept;
+
+    static qint64 stringPayloadBytes(const QString& text) noexcept;
+    static qint64 arrayPayloadBytes(qsizetype capacity, std::size_t elementSize) noexcept;
+
+private:
+    void addPayload(const void* payload, qint64 bytes);
+    void addHashNodes(qsizetype capacity, std::size_t nodeSize) noexcept;
+    bool enterSharedPayload(const void* payload);
+    void leaveSharedPayload(const void* payload, qint64 bytesBefore);
+
+    QHash<const void*, qint64> m_payloadBytes;
+    qint64 m_bytes = 0;
+    qint64 m_sharedBytes = 0;
+    qint64 m_itemCount = 0;
+};
+
+// Process-wide registry of memory estimators. Stores, models and caches track themselves per domain and structure;
+// sample() walks every tracked structure with one shared estimate, so each payload is attributed to the first
+// structure that reaches it and the sum of all samples is the process-wide estimate. Entries are dropped when their
+// owner is destroyed. Estimators read owner state without locking: sample from the thread that owns the models.
+class WhatSonMemoryAccounting final : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Sample final
+    {
+        QString domain;
+        QString structure;
+        qint64 itemCount = 0;
+        qint64 bytes = 0;
+        qint64 sharedBytes = 0;
+    };
+
+    using Estimator = std::function<void(WhatSonMemoryEstimate& estimate)>;
+
+    explicit WhatSonMemoryAccounting(QObject* parent = nullptr);
+    ~WhatSonMemoryAccounting() override;
+
+    static WhatSonMemoryAccounting& shared();
+
+    void track(const QObject* owner, QString domain, QString structure, Estimator estimator);
+    void untrack(const QObject* owner);
+    int trackedCount() const;
+
+    QVector<Sample> sample() const;
+    static qint64 domainBytes(const QVector<Sample>& samples, const QString& domain);
+
+    // Budgets are per domain, over the bytes attributed to that domain. Zero or less clears the budget.
+    void setDomainBudget(const QString& domain, qint64 maxBytes);
+    QStringList budgetViolations(const QVector<Sample>& samples) const;
+
+    Q_INVOKABLE QVariantList report() const;
+    Q_INVOKABLE qint64 totalBytes() const;
+    Q_INVOKABLE void traceReport() const;
+
+private:
+    struct Entry final
+    {
+        const QObject* ownerKey = nullptr;
+        QPointer<const QObject> owner;
+        QString domain;
+        QString structure;
+        Estimator estimator;
+    };
+
+    mutable QMutex m_mutex;
+    QVector<Entry> m_entries;
+    QHash<QString, qint64> m_domainBudgets;
+};
@@ -0,0 +1,123 @@
+#include "app/models/file/conflict/WhatSonMergeAncestorStore.hpp"
+
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <utility>
+
+namespace
+{
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    QString normalizedRelativePath(const QString& relativePath)
+    {
+        QString normalized = QDir::cleanPath(QString(relativePath).replace(QLatin1Char('\\'), QLatin1Char('/')).trimmed());
+        while (normalized.startsWith(QLatin1Char('/')))
+        {
+            normalized.remove(0, 1);
+        }
+        if (normalized.isEmpty()
+            || normalized == QStringLiteral(".")
+            || normalized == QStringLiteral("..")
+            || normalized.startsWith(QStringLiteral("../")))
+        {
+            return {};
+        }
+        return normalized;
+    }
+} // namespace
+
+WhatSonMergeAncestorStore::WhatSonMergeAncestorStore(QString hubPath)
+    : m_hubPath(WhatSon::HubPath::normalizeAbsolutePath(std::move(hubPath)))
+{
+}
+
+QString WhatSonMergeAncestorStore::hubPath() const
+{
+    return m_hubPath;
+}
+
+QString WhatSonMergeAncestorStore::ancestorPath(const QString& relativePath) const
+{
+    const QString normalized = normalizedRelativePath(relativePath);
+    if (m_hubPath.isEmpty() || normalized.isEmpty())
+    {
+        return {};
+    }
+    return QDir::cleanPath(QDir(m_hubPath).filePath(storageRelativePath() + QLatin1Char('/') + normalized));
+}
+
+bool WhatSonMergeAncestorStore::hasAncestor(const QString& relativePath) const
+{
+    const QString path = ancestorPath(relativePath);
+    return !path.isEmpty() && QFileInfo(path).isFile();
+}
+
+bool WhatSonMergeAncestorStore::readAncestor(
+    const QString& relativePath,
+    QString* outText,
+    QString* errorMessage) const
+{
+    if (outText == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("outText must not be null."));
+    }
+    outText->clear();
+
+    const QString path = ancestorPath(relativePath);
+    QFile file(path);
+    if (path.isEmpty() || !file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return failWith(errorMessage, QStringLiteral("No merge ancestor is stored for: %1").arg(relativePath));
+    }
+    *outText = QString::fromUtf8(file.readAll());
+    return true;
+}
+
+bool WhatSonMergeAncestorStore::writeAncestor(
+    const QString& relativePath,
+    const QString& text,
+    QString* errorMessage) const
+{
+    const QString path = ancestorPath(relativePath);
+    if (path.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Invalid merge ancestor path: %1").arg(relativePath));
+    }
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to create directory: %1").arg(QFileInfo(path).absolutePath()));
+    }
+
+    QSaveFile file(path);
+    const QByteArray bytes = text.toUtf8();
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)
+        || file.write(bytes) != bytes.size()
+        || !file.commit())
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to write merge ancestor: %1").arg(path));
+    }
+    return true;
+}
+
+bool WhatSonMergeAncestorStore::removeAncestor(const QString& relativePath) const
+{
+    const QString path = ancestorPath(relativePath);
+    return path.isEmpty() || !QFileInfo::exists(path) || QFile::remove(path);
+}
+
+QString WhatSonMergeAncestorStore::storageRelativePath()
+{
+    return QStringLiteral(".whatson/merge-base");
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QString>
+
+class WhatSonMergeAncestorStore final
+{
+public:
+    explicit WhatSonMergeAncestorStore(QString hubPath);
+
+    QString hubPath() const;
+    QString ancestorPath(const QString& relativePath) const;
+
+    bool hasAncestor(const QString& relativePath) const;
+    bool readAncestor(const QString& relativePath, QString* outText, QString* errorMessage = nullptr) const;
+    bool writeAncestor(const QString& relativePath, const QString& text, QString* errorMessage = nullptr) const;
+    bool removeAncestor(const QString& relativePath) const;
+
+    static QString storageRelativePath();
+
+private:
+    QString m_hubPath;
+};
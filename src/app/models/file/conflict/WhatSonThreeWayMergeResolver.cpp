@@ -0,0 +1,589 @@
+#include "app/models/file/conflict/WhatSonThreeWayMergeResolver.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/conflict/WhatSonMergeAncestorStore.hpp"
+#include "app/models/file/conflict/WhatSonTimestampConflictResolver.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderCreator.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderParser.hpp"
+#include "app/models/hierarchy/folders/WhatSonFoldersHierarchyCreator.hpp"
+#include "app/models/hierarchy/folders/WhatSonFoldersHierarchyParser.hpp"
+#include "app/models/hierarchy/folders/WhatSonFoldersHierarchyStore.hpp"
+
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+namespace
+{
+    enum class ConflictPreference
+    {
+        Local,
+        Remote,
+        GreaterValue
+    };
+
+    struct MergeContext final
+    {
+        QString key;
+        ConflictPreference preference = ConflictPreference::GreaterValue;
+        QVector<WhatSonMergeConflict>* conflicts = nullptr;
+    };
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    QString displayValue(const QString& value)
+    {
+        return value;
+    }
+
+    QString displayValue(const int value)
+    {
+        return QString::number(value);
+    }
+
+    QString displayValue(const bool value)
+    {
+        return value ? QStringLiteral("true") : QStringLiteral("false");
+    }
+
+    QString displayValue(const QStringList& value)
+    {
+        return value.join(QStringLiteral(", "));
+    }
+
+    template <typename T>
+    T mergeScalar(
+        const MergeContext& context,
+        const QString& field,
+        const T& base,
+        const T& local,
+        const T& remote)
+    {
+        if (local == remote || remote == base)
+        {
+            return local;
+        }
+        if (local == base)
+        {
+            return remote;
+        }
+
+        bool localWins = false;
+        switch (context.preference)
+        {
+        case ConflictPreference::Local:
+            localWins = true;
+            break;
+        case ConflictPreference::Remote:
+            localWins = false;
+            break;
+        case ConflictPreference::GreaterValue:
+            localWins = remote < local;
+            break;
+        }
+
+        const T& resolved = localWins ? local : remote;
+        if (context.conflicts != nullptr)
+        {
+            context.conflicts->push_back(WhatSonMergeConflict{
+                context.key,
+                field,
+                displayValue(local),
+                displayValue(remote),
+                displayValue(resolved)});
+        }
+        return resolved;
+    }
+
+    int mergeCounter(const int base, const int local, const int remote)
+    {
+        return std::max({local, remote, local + remote - base});
+    }
+
+    QString newerTimestamp(const QString& local, const QString& remote)
+    {
+        return WhatSonTimestampConflictResolver().isTimestampNewer(remote, local) ? remote : local;
+    }
+
+    QString folderBindingKey(const QString& label, const QString& uuid)
+    {
+        return uuid.trimmed().isEmpty()
+                   ? QStringLiteral("label:") + label.trimmed()
+                   : QStringLiteral("uuid:") + uuid.trimmed();
+    }
+
+    struct FolderBindings final
+    {
+        QStringList keys;
+        QHash<QString, QString> labelByKey;
+        QHash<QString, QString> uuidByKey;
+    };
+
+    FolderBindings folderBindingsForHeader(const WhatSonNoteHeaderStore& store)
+    {
+        FolderBindings bindings;
+        const QStringList folders = store.folders();
+        const QStringList folderUuids = store.folderUuids();
+        for (int index = 0; index < folders.size(); ++index)
+        {
+            const QString uuid = index < folderUuids.size() ? folderUuids.at(index).trimmed() : QString();
+            const QString key = folderBindingKey(folders.at(index), uuid);
+            if (bindings.labelByKey.contains(key))
+            {
+                continue;
+            }
+            bindings.keys.push_back(key);
+            bindings.labelByKey.insert(key, folders.at(index));
+            bindings.uuidByKey.insert(key, uuid);
+        }
+        return bindings;
+    }
+
+    QString folderEntryKey(const WhatSonFolderDepthEntry& entry)
+    {
+        return entry.uuid.trimmed().isEmpty()
+                   ? QStringLiteral("id:") + entry.id.trimmed()
+                   : QStringLiteral("uuid:") + entry.uuid.trimmed();
+    }
+
+    bool sameFolderEntry(const WhatSonFolderDepthEntry& lhs, const WhatSonFolderDepthEntry& rhs)
+    {
+        return lhs.id == rhs.id && lhs.label == rhs.label && lhs.depth == rhs.depth && lhs.uuid == rhs.uuid;
+    }
+
+    QHash<QString, int> folderEntryIndex(const QVector<WhatSonFolderDepthEntry>& entries)
+    {
+        QHash<QString, int> index;
+        index.reserve(entries.size());
+        for (int row = 0; row < entries.size(); ++row)
+        {
+            index.insert(folderEntryKey(entries.at(row)), row);
+        }
+        return index;
+    }
+
+    bool hasSuffix(const QString& fileName, const QString& suffix)
+    {
+        return fileName.trimmed().endsWith(suffix, Qt::CaseInsensitive);
+    }
+
+    bool parseHeaderText(const QString& text, WhatSonNoteHeaderStore* outStore, QString* errorMessage)
+    {
+        if (text.trimmed().isEmpty())
+        {
+            outStore->clear();
+            return true;
+        }
+        return WhatSonNoteHeaderParser().parse(text, outStore, errorMessage);
+    }
+} // namespace
+
+WhatSonNoteHeaderStore WhatSonThreeWayMergeResolver::mergeNoteHeaders(
+    const WhatSonNoteHeaderStore& base,
+    const WhatSonNoteHeaderStore& local,
+    const WhatSonNoteHeaderStore& remote,
+    QVector<WhatSonMergeConflict>* outConflicts) const
+{
+    const WhatSonTimestampConflictResolver timestampResolver;
+    MergeContext context;
+    context.key = local.noteId().isEmpty() ? remote.noteId() : local.noteId();
+    context.conflicts = outConflicts;
+    if (timestampResolver.isTimestampNewer(local.lastModifiedAt(), remote.lastModifiedAt()))
+    {
+        context.preference = ConflictPreference::Local;
+    }
+    else if (timestampResolver.isTimestampNewer(remote.lastModifiedAt(), local.lastModifiedAt()))
+    {
+        context.preference = ConflictPreference::Remote;
+    }
+
+    MergeContext derivedContext = context;
+    derivedContext.conflicts = nullptr;
+
+    WhatSonNoteHeaderStore merged;
+    merged.setNoteId(mergeScalar(context, QStringLiteral("id"), base.noteId(), local.noteId(), remote.noteId()));
+    merged.setCreatedAt(mergeScalar(
+        context, QStringLiteral("created"), base.createdAt(), local.createdAt(), remote.createdAt()));
+    merged.setAuthor(mergeScalar(context, QStringLiteral("author"), base.author(), local.author(), remote.author()));
+    merged.setLastModifiedAt(newerTimestamp(local.lastModifiedAt(), remote.lastModifiedAt()));
+    merged.setLastOpenedAt(newerTimestamp(local.lastOpenedAt(), remote.lastOpenedAt()));
+    merged.setModifiedBy(mergeScalar(
+        derivedContext, QStringLiteral("modifiedBy"), base.modifiedBy(), local.modifiedBy(), remote.modifiedBy()));
+    merged.setProject(mergeScalar(
+        context, QStringLiteral("project"), base.project(), local.project(), remote.project()));
+    merged.setBookmarked(mergeScalar(
+        context, QStringLiteral("bookmarked"), base.isBookmarked(), local.isBookmarked(), remote.isBookmarked()));
+    merged.setBookmarkColors(mergeOrderedSet(base.bookmarkColors(), local.bookmarkColors(), remote.bookmarkColors()));
+    merged.setTags(mergeOrderedSet(base.tags(), local.tags(), remote.tags()));
+    merged.setProgressEnums(mergeOrderedSet(base.progressEnums(), local.progressEnums(), remote.progressEnums()));
+    merged.setProgress(mergeScalar(
+        context, QStringLiteral("progress"), base.progress(), local.progress(), remote.progress()));
+    merged.setPreset(mergeScalar(context, QStringLiteral("preset"), base.isPreset(), local.isPreset(), remote.isPreset()));
+
+    const FolderBindings baseFolders = folderBindingsForHeader(base);
+    const FolderBindings localFolders = folderBindingsForHeader(local);
+    const FolderBindings remoteFolders = folderBindingsForHeader(remote);
+    QStringList mergedFolderLabels;
+    QStringList mergedFolderUuids;
+    for (const QString& key : mergeOrderedSet(baseFolders.keys, localFolders.keys, remoteFolders.keys))
+    {
+        const bool inLocal = localFolders.labelByKey.contains(key);
+        const bool inRemote = remoteFolders.labelByKey.contains(key);
+        QString label = inLocal ? localFolders.labelByKey.value(key) : remoteFolders.labelByKey.value(key);
+        if (inLocal && inRemote)
+        {
+            label = mergeScalar(
+                context,
+                QStringLiteral("folders[%1]").arg(key),
+                baseFolders.labelByKey.value(key, label),
+                localFolders.labelByKey.value(key),
+                remoteFolders.labelByKey.value(key));
+        }
+        mergedFolderLabels.push_back(label);
+        mergedFolderUuids.push_back(inLocal ? localFolders.uuidByKey.value(key) : remoteFolders.uuidByKey.value(key));
+    }
+    merged.setFolderBindings(mergedFolderLabels, mergedFolderUuids);
+    merged.setTotalFolders(static_cast<int>(merged.folders().size()));
+    merged.setTotalTags(static_cast<int>(merged.tags().size()));
+
+    merged.setOpenCount(mergeCounter(base.openCount(), local.openCount(), remote.openCount()));
+    merged.setModifiedCount(mergeCounter(base.modifiedCount(), local.modifiedCount(), remote.modifiedCount()));
+
+    merged.setLetterCount(mergeScalar(
+        derivedContext, QString(), base.letterCount(), local.letterCount(), remote.letterCount()));
+    merged.setWordCount(mergeScalar(
+        derivedContext, QString(), base.wordCount(), local.wordCount(), remote.wordCount()));
+    merged.setSentenceCount(mergeScalar(
+        derivedContext, QString(), base.sentenceCount(), local.sentenceCount(), remote.sentenceCount()));
+    merged.setParagraphCount(mergeScalar(
+        derivedContext, QString(), base.paragraphCount(), local.paragraphCount(), remote.paragraphCount()));
+    merged.setSpaceCount(mergeScalar(
+        derivedContext, QString(), base.spaceCount(), local.spaceCount(), remote.spaceCount()));
+    merged.setIndentCount(mergeScalar(
+        derivedContext, QString(), base.indentCount(), local.indentCount(), remote.indentCount()));
+    merged.setLineCount(mergeScalar(
+        derivedContext, QString(), base.lineCount(), local.lineCount(), remote.lineCount()));
+    merged.setBacklinkToCount(mergeScalar(
+        derivedContext, QString(), base.backlinkToCount(), local.backlinkToCount(), remote.backlinkToCount()));
+    merged.setBacklinkByCount(mergeScalar(
+        derivedContext, QString(), base.backlinkByCount(), local.backlinkByCount(), remote.backlinkByCount()));
+    merged.setIncludedResourceCount(mergeScalar(
+        derivedContext,
+        QString(),
+        base.includedResourceCount(),
+        local.includedResourceCount(),
+        remote.includedResourceCount()));
+    return merged;
+}
+
+QVector<WhatSonFolderDepthEntry> WhatSonThreeWayMergeResolver::mergeFolderEntries(
+    const QVector<WhatSonFolderDepthEntry>& base,
+    const QVector<WhatSonFolderDepthEntry>& local,
+    const QVector<WhatSonFolderDepthEntry>& remote,
+    QVector<WhatSonMergeConflict>* outConflicts) const
+{
+    const QHash<QString, int> baseIndex = folderEntryIndex(base);
+    const QHash<QString, int> localIndex = folderEntryIndex(local);
+    const QHash<QString, int> remoteIndex = folderEntryIndex(remote);
+
+    QHash<QString, WhatSonFolderDepthEntry> mergedByKey;
+    const auto mergeKey = [&](const QString& key)
+    {
+        if (mergedByKey.contains(key))
+        {
+            return;
+        }
+
+        const int localRow = localIndex.value(key, -1);
+        const int remoteRow = remoteIndex.value(key, -1);
+        const int baseRow = baseIndex.value(key, -1);
+        MergeContext context;
+        context.key = key;
+        context.conflicts = outConflicts;
+
+        if (localRow >= 0 && remoteRow >= 0)
+        {
+            const WhatSonFolderDepthEntry& localEntry = local.at(localRow);
+            const WhatSonFolderDepthEntry& remoteEntry = remote.at(remoteRow);
+            WhatSonFolderDepthEntry baseEntry;
+            baseEntry.depth = -1;
+            if (baseRow >= 0)
+            {
+                baseEntry = base.at(baseRow);
+            }
+
+            WhatSonFolderDepthEntry mergedEntry = localEntry;
+            mergedEntry.id = mergeScalar(context, QStringLiteral("id"), baseEntry.id, localEntry.id, remoteEntry.id);
+            mergedEntry.label = mergeScalar(
+                context, QStringLiteral("label"), baseEntry.label, localEntry.label, remoteEntry.label);
+            mergedEntry.depth = mergeScalar(
+                context, QStringLiteral("depth"), baseEntry.depth, localEntry.depth, remoteEntry.depth);
+            mergedByKey.insert(key, mergedEntry);
+            return;
+        }
+
+        const bool keptSideIsLocal = localRow >= 0;
+        const WhatSonFolderDepthEntry& keptEntry = keptSideIsLocal ? local.at(localRow) : remote.at(remoteRow);
+        if (baseRow < 0)
+        {
+            mergedByKey.insert(key, keptEntry);
+            return;
+        }
+        if (sameFolderEntry(keptEntry, base.at(baseRow)))
+        {
+            return;
+        }
+
+        if (outConflicts != nullptr)
+        {
+            outConflicts->push_back(WhatSonMergeConflict{
+                key,
+                QStringLiteral("node"),
+                keptSideIsLocal ? keptEntry.label : QString(),
+                keptSideIsLocal ? QString() : keptEntry.label,
+                keptEntry.label});
+        }
+        mergedByKey.insert(key, keptEntry);
+    };
+
+    // Local order is kept as is. Each remote-only entry is queued behind the remote entry that precedes it and is
+    // emitted before the next local entry that is not deeper than itself, so it never splits the predecessor's
+    // local-only descendants away from their parent. Every key is visited a constant number of times.
+    QStringList localKeys;
+    QSet<QString> localKeySet;
+    localKeys.reserve(local.size());
+    localKeySet.reserve(local.size());
+    for (const WhatSonFolderDepthEntry& entry : local)
+    {
+        const QString key = folderEntryKey(entry);
+        mergeKey(key);
+        if (mergedByKey.contains(key) && !localKeySet.contains(key))
+        {
+            localKeySet.insert(key);
+            localKeys.push_back(key);
+        }
+    }
+
+    QStringList leadingRemoteKeys;
+    QHash<QString, QStringList> remoteKeysByAnchor;
+    QSet<QString> remoteAddedKeySet;
+    QString anchorKey;
+    for (const WhatSonFolderDepthEntry& entry : remote)
+    {
+        const QString key = folderEntryKey(entry);
+        if (localKeySet.contains(key))
+        {
+            anchorKey = key;
+            continue;
+        }
+        if (remoteAddedKeySet.contains(key))
+        {
+            continue;
+        }
+
+        mergeKey(key);
+        if (!mergedByKey.contains(key))
+        {
+            continue;
+        }
+        remoteAddedKeySet.insert(key);
+        if (anchorKey.isEmpty())
+        {
+            leadingRemoteKeys.push_back(key);
+        }
+        else
+        {
+            remoteKeysByAnchor[anchorKey].push_back(key);
+        }
+    }
+
+    QVector<WhatSonFolderDepthEntry> mergedEntries;
+    mergedEntries.reserve(localKeys.size() + remoteAddedKeySet.size());
+    for (const QString& key : std::as_const(leadingRemoteKeys))
+    {
+        mergedEntries.push_back(mergedByKey.value(key));
+    }
+
+    QVector<WhatSonFolderDepthEntry> pendingEntries;
+    qsizetype pendingHead = 0;
+    for (const QString& key : std::as_const(localKeys))
+    {
+        const WhatSonFolderDepthEntry localEntry = mergedByKey.value(key);
+        while (pendingHead < pendingEntries.size() && pendingEntries.at(pendingHead).depth >= localEntry.depth)
+        {
+            mergedEntries.push_back(pendingEntries.at(pendingHead++));
+        }
+        mergedEntries.push_back(localEntry);
+
+        const auto anchored = remoteKeysByAnchor.constFind(key);
+        if (anchored != remoteKeysByAnchor.constEnd())
+        {
+            for (const QString& remoteKey : anchored.value())
+            {
+                pendingEntries.push_back(mergedByKey.value(remoteKey));
+            }
+        }
+    }
+    while (pendingHead < pendingEntries.size())
+    {
+        mergedEntries.push_back(pendingEntries.at(pendingHead++));
+    }
+    return mergedEntries;
+}
+
+bool WhatSonThreeWayMergeResolver::mergeFileText(
+    const QString& fileName,
+    const QString& baseText,
+    const QString& localText,
+    const QString& remoteText,
+    QString* outMergedText,
+    QVector<WhatSonMergeConflict>* outConflicts,
+    QString* errorMessage) const
+{
+    if (outMergedText == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("outMergedText must not be null."));
+    }
+
+    if (localText == remoteText || remoteText == baseText)
+    {
+        *outMergedText = localText;
+        return true;
+    }
+    if (localText == baseText)
+    {
+        *outMergedText = remoteText;
+        return true;
+    }
+
+    if (hasSuffix(fileName, QStringLiteral(".wsnhead")))
+    {
+        WhatSonNoteHeaderStore baseStore;
+        WhatSonNoteHeaderStore localStore;
+        WhatSonNoteHeaderStore remoteStore;
+        QString parseError;
+        if (!parseHeaderText(baseText, &baseStore, &parseError))
+        {
+            baseStore.clear();
+        }
+        if (!parseHeaderText(localText, &localStore, &parseError)
+            || !parseHeaderText(remoteText, &remoteStore, &parseError))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to parse note header for merge: %1").arg(parseError));
+        }
+
+        const WhatSonNoteHeaderStore merged = mergeNoteHeaders(baseStore, localStore, remoteStore, outConflicts);
+        *outMergedText = WhatSonNoteHeaderCreator(QString(), QString()).createHeaderText(merged);
+        return true;
+    }
+
+    if (hasSuffix(fileName, QStringLiteral(".wsfolders")))
+    {
+        const WhatSonFoldersHierarchyParser parser;
+        WhatSonFoldersHierarchyStore baseStore;
+        WhatSonFoldersHierarchyStore localStore;
+        WhatSonFoldersHierarchyStore remoteStore;
+        QString parseError;
+        if (!parser.parse(baseText, &baseStore, &parseError))
+        {
+            baseStore.clear();
+        }
+        if (!parser.parse(localText, &localStore, &parseError)
+            || !parser.parse(remoteText, &remoteStore, &parseError))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to parse folders for merge: %1").arg(parseError));
+        }
+
+        WhatSonFoldersHierarchyStore mergedStore;
+        mergedStore.setFolderEntries(mergeFolderEntries(
+            baseStore.folderEntries(),
+            localStore.folderEntries(),
+            remoteStore.folderEntries(),
+            outConflicts));
+        *outMergedText = WhatSonFoldersHierarchyCreator().createText(mergedStore);
+        return true;
+    }
+
+    return failWith(errorMessage, QStringLiteral("No structured merge is available for: %1").arg(fileName));
+}
+
+bool WhatSonThreeWayMergeResolver::mergeHubFile(
+    const QString& hubPath,
+    const QString& relativePath,
+    const QString& localText,
+    const QString& remoteText,
+    QString* outMergedText,
+    QVector<WhatSonMergeConflict>* outConflicts,
+    QString* errorMessage) const
+{
+    const WhatSonMergeAncestorStore ancestorStore(hubPath);
+    QString baseText;
+    if (ancestorStore.hasAncestor(relativePath)
+        && !ancestorStore.readAncestor(relativePath, &baseText, errorMessage))
+    {
+        return false;
+    }
+
+    QVector<WhatSonMergeConflict> conflicts;
+    if (!mergeFileText(relativePath, baseText, localText, remoteText, outMergedText, &conflicts, errorMessage)
+        || !ancestorStore.writeAncestor(relativePath, *outMergedText, errorMessage))
+    {
+        return false;
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("sync.merge"),
+        QStringLiteral("mergeHubFile"),
+        QStringLiteral("path=%1 conflicts=%2").arg(relativePath).arg(conflicts.size()));
+    if (outConflicts != nullptr)
+    {
+        *outConflicts += conflicts;
+    }
+    return true;
+}
+
+bool WhatSonThreeWayMergeResolver::supportsStructuredMerge(const QString& fileName)
+{
+    return hasSuffix(fileName, QStringLiteral(".wsnhead")) || hasSuffix(fileName, QStringLiteral(".wsfolders"));
+}
+
+QStringList WhatSonThreeWayMergeResolver::mergeOrderedSet(
+    const QStringList& base,
+    const QStringList& local,
+    const QStringList& remote)
+{
+    const QSet<QString> baseSet(base.cbegin(), base.cend());
+    const QSet<QString> localSet(local.cbegin(), local.cend());
+    const QSet<QString> remoteSet(remote.cbegin(), remote.cend());
+
+    QStringList merged;
+    merged.reserve(std::max(local.size(), remote.size()));
+    QSet<QString> emitted;
+    for (const QString& value : local)
+    {
+        if ((remoteSet.contains(value) || !baseSet.contains(value)) && !emitted.contains(value))
+        {
+            merged.push_back(value);
+            emitted.insert(value);
+        }
+    }
+    for (const QString& value : remote)
+    {
+        if (!localSet.contains(value) && !baseSet.contains(value) && !emitted.contains(value))
+        {
+            merged.push_back(value);
+            emitted.insert(value);
+        }
+    }
+    return merged;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "app/models/file/note/header/WhatSonNoteHeaderStore.hpp"
+#include "app/models/hierarchy/WhatSonFolderDepthEntry.hpp"
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct WhatSonMergeConflict final
+{
+    QString key;
+    QString field;
+    QString localValue;
+    QString remoteValue;
+    QString resolvedValue;
+};
+
+class WhatSonThreeWayMergeResolver final
+{
+public:
+    WhatSonNoteHeaderStore mergeNoteHeaders(
+        const WhatSonNoteHeaderStore& base,
+        const WhatSonNoteHeaderStore& local,
+        const WhatSonNoteHeaderStore& remote,
+        QVector<WhatSonMergeConflict>* outConflicts = nullptr) const;
+    QVector<WhatSonFolderDepthEntry> mergeFolderEntries(
+        const QVector<WhatSonFolderDepthEntry>& base,
+        const QVector<WhatSonFolderDepthEntry>& local,
+        const QVector<WhatSonFolderDepthEntry>& remote,
+        QVector<WhatSonMergeConflict>* outConflicts = nullptr) const;
+
+    bool mergeFileText(
+        const QString& fileName,
+        const QString& baseText,
+        const QString& localText,
+        const QString& remoteText,
+        QString* outMergedText,
+        QVector<WhatSonMergeConflict>* outConflicts = nullptr,
+        QString* errorMessage = nullptr) const;
+    bool mergeHubFile(
+        const QString& hubPath,
+        const QString& relativePath,
+        const QString& localText,
+        const QString& remoteText,
+        QString* outMergedText,
+        QVector<WhatSonMergeConflict>* outConflicts = nullptr,
+        QString* errorMessage = nullptr) const;
+
+    static bool supportsStructuredMerge(const QString& fileName);
+    static QStringList mergeOrderedSet(
+        const QStringList& base,
+        const QStringList& local,
+        const QStringList& remote);
+};
@@ -0,0 +1,995 @@
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr char kFileMagic[8] = {'W', 'S', 'H', 'U', 'B', 'P', 'K', '1'};
+    constexpr char kTrailerMagic[8] = {'W', 'S', 'H', 'U', 'B', 'E', 'N', 'D'};
+    constexpr quint32 kSegmentMagic = 0x47455357u;
+    // Streamed segments are written under this magic until their size and sha1 are known, so a crash mid-write leaves
+    // a header that recovery stops at instead of an empty file that shadows the previous version.
+    constexpr quint32 kPendingSegmentMagic = 0x444e5057u;
+    constexpr quint32 kIndexMagic = 0x58495357u;
+    constexpr qint64 kFileHeaderSize = 16;
+    constexpr qint64 kSegmentHeaderSize = 48;
+    constexpr qint64 kIndexEntryFixedSize = 52;
+    constexpr qint64 kTrailerSize = 40;
+    constexpr qint64 kSha1Size = 20;
+    constexpr qint64 kMaximumEntryPathBytes = 64 * 1024;
+    constexpr qint64 kStreamChunkSize = 1024 * 1024;
+    constexpr qint64 kCompactionMinimumDeadBytes = 1024 * 1024;
+
+    constexpr quint8 kFileSegment = 1;
+    constexpr quint8 kDirectorySegment = 2;
+    constexpr quint8 kTombstoneSegment = 3;
+
+    template <typename T>
+    void appendLittleEndian(QByteArray* bytes, const T value)
+    {
+        char buffer[sizeof(T)];
+        qToLittleEndian<T>(value, buffer);
+        bytes->append(buffer, sizeof(T));
+    }
+
+    template <typename T>
+    T readLittleEndian(const char* bytes)
+    {
+        return qFromLittleEndian<T>(bytes);
+    }
+
+    QByteArray paddedSha1(const QByteArray& sha1)
+    {
+        QByteArray padded = sha1.left(kSha1Size);
+        padded.resize(kSha1Size, '\0');
+        return padded;
+    }
+
+    QByteArray fileHeaderBytes()
+    {
+        QByteArray bytes(kFileMagic, sizeof(kFileMagic));
+        appendLittleEndian<quint32>(&bytes, WhatSonHubArchive::kFormatVersion);
+        appendLittleEndian<quint32>(&bytes, 0);
+        return bytes;
+    }
+
+    QByteArray segmentHeaderBytes(
+        const quint8 kind,
+        const QByteArray& pathBytes,
+        const qint64 dataSize,
+        const qint64 modifiedMsecsSinceEpoch,
+        const QByteArray& sha1,
+        const quint32 magic = kSegmentMagic)
+    {
+        QByteArray bytes;
+        bytes.reserve(kSegmentHeaderSize);
+        appendLittleEndian<quint32>(&bytes, magic);
+        bytes.append(static_cast<char>(kind));
+        bytes.append(3, '\0');
+        appendLittleEndian<quint32>(&bytes, static_cast<quint32>(pathBytes.size()));
+        appendLittleEndian<qint64>(&bytes, dataSize);
+        appendLittleEndian<qint64>(&bytes, modifiedMsecsSinceEpoch);
+        bytes.append(paddedSha1(sha1));
+        return bytes;
+    }
+
+    QVector<const WhatSonHubArchiveEntry*> sortedEntries(const QHash<QString, WhatSonHubArchiveEntry>& entries)
+    {
+        QVector<const WhatSonHubArchiveEntry*> sorted;
+        sorted.reserve(entries.size());
+        for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+        {
+            sorted.push_back(&it.value());
+        }
+        std::sort(
+            sorted.begin(),
+            sorted.end(),
+            [](const WhatSonHubArchiveEntry* lhs, const WhatSonHubArchiveEntry* rhs)
+            {
+                return lhs->path < rhs->path;
+            });
+        return sorted;
+    }
+
+    QByteArray indexBytes(const QVector<const WhatSonHubArchiveEntry*>& entries)
+    {
+        QByteArray bytes;
+        appendLittleEndian<quint32>(&bytes, kIndexMagic);
+        appendLittleEndian<quint32>(&bytes, static_cast<quint32>(entries.size()));
+        for (const WhatSonHubArchiveEntry* entry : entries)
+        {
+            const QByteArray pathBytes = entry->path.toUtf8();
+            bytes.append(static_cast<char>(entry->directory ? kDirectorySegment : kFileSegment));
+            bytes.append(3, '\0');
+            appendLittleEndian<quint32>(&bytes, static_cast<quint32>(pathBytes.size()));
+            appendLittleEndian<qint64>(&bytes, entry->segmentOffset);
+            appendLittleEndian<qint64>(&bytes, entry->size);
+            appendLittleEndian<qint64>(&bytes, entry->modifiedMsecsSinceEpoch);
+            bytes.append(paddedSha1(entry->sha1));
+            bytes.append(pathBytes);
+        }
+        return bytes;
+    }
+
+    quint64 indexChecksum(const QByteArray& index)
+    {
+        const QByteArray digest = QCryptographicHash::hash(index, QCryptographicHash::Sha1);
+        return readLittleEndian<quint64>(digest.constData());
+    }
+
+    QByteArray trailerBytes(
+        const qint64 indexOffset,
+        const QByteArray& index,
+        const qint64 segmentBytes)
+    {
+        QByteArray bytes;
+        bytes.reserve(kTrailerSize);
+        appendLittleEndian<qint64>(&bytes, indexOffset);
+        appendLittleEndian<qint64>(&bytes, index.size());
+        appendLittleEndian<qint64>(&bytes, segmentBytes);
+        appendLittleEndian<quint64>(&bytes, indexChecksum(index));
+        bytes.append(kTrailerMagic, sizeof(kTrailerMagic));
+        return bytes;
+    }
+
+    void removeEntryAndDescendants(QHash<QString, WhatSonHubArchiveEntry>* entries, const QString& entryPath)
+    {
+        entries->remove(entryPath);
+        const QString descendantPrefix = entryPath + QLatin1Char('/');
+        for (auto it = entries->begin(); it != entries->end();)
+        {
+            if (it.key().startsWith(descendantPrefix))
+            {
+                it = entries->erase(it);
+                continue;
+            }
+            ++it;
+        }
+    }
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+} // namespace
+
+WhatSonHubArchive::~WhatSonHubArchive()
+{
+    close();
+}
+
+bool WhatSonHubArchive::isPackedArchive(const QString& archivePath)
+{
+    const QString normalizedPath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    if (normalizedPath.isEmpty() || !QFileInfo(normalizedPath).isFile())
+    {
+        return false;
+    }
+
+    QFile file(normalizedPath);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    const QByteArray magic = file.read(sizeof(kFileMagic));
+    return magic == QByteArray(kFileMagic, sizeof(kFileMagic));
+}
+
+bool WhatSonHubArchive::create(const QString& archivePath, QString* errorMessage)
+{
+    const QString normalizedPath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    if (normalizedPath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive path must not be empty."));
+    }
+    if (QFileInfo::exists(normalizedPath))
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive already exists: %1").arg(normalizedPath));
+    }
+
+    QSaveFile file(normalizedPath);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to create hub archive: %1").arg(normalizedPath));
+    }
+
+    const QByteArray emptyIndex = indexBytes({});
+    QByteArray bytes = fileHeaderBytes();
+    bytes.append(emptyIndex);
+    bytes.append(trailerBytes(kFileHeaderSize, emptyIndex, 0));
+    if (file.write(bytes) != bytes.size() || !file.commit())
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to write hub archive: %1").arg(normalizedPath));
+    }
+    return true;
+}
+
+bool WhatSonHubArchive::compact(const QString& archivePath, QString* errorMessage)
+{
+    WhatSonHubArchive source;
+    if (!source.open(archivePath, errorMessage))
+    {
+        return false;
+    }
+
+    const QVector<const WhatSonHubArchiveEntry*> liveEntries = sortedEntries(source.m_entries);
+    QSaveFile target(source.m_archivePath);
+    if (!target.open(QIODevice::WriteOnly))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to open hub archive for compaction: %1").arg(
+                                          source.m_archivePath));
+    }
+
+    QHash<QString, WhatSonHubArchiveEntry> compactedEntries;
+    compactedEntries.reserve(liveEntries.size());
+    qint64 offset = kFileHeaderSize;
+    bool writeSucceeded = target.write(fileHeaderBytes()) == kFileHeaderSize;
+    for (const WhatSonHubArchiveEntry* entry : liveEntries)
+    {
+        if (!writeSucceeded)
+        {
+            break;
+        }
+
+        const QByteArray pathBytes = entry->path.toUtf8();
+        QByteArray segmentHead = segmentHeaderBytes(
+            entry->directory ? kDirectorySegment : kFileSegment,
+            pathBytes,
+            entry->directory ? 0 : entry->size,
+            entry->modifiedMsecsSinceEpoch,
+            entry->sha1);
+        segmentHead.append(pathBytes);
+        writeSucceeded = target.write(segmentHead) == segmentHead.size();
+        if (writeSucceeded && !entry->directory)
+        {
+            QByteArray copiedSha1;
+            if (!source.copyFileTo(entry->path, &target, &copiedSha1, errorMessage))
+            {
+                target.cancelWriting();
+                return false;
+            }
+            if (paddedSha1(copiedSha1) != paddedSha1(entry->sha1))
+            {
+                target.cancelWriting();
+                return failWith(errorMessage, QStringLiteral("Hub archive entry failed its checksum during compaction: %1")
+                                                  .arg(entry->path));
+            }
+        }
+        const qint64 segmentSize = segmentHead.size() + (entry->directory ? 0 : entry->size);
+
+        WhatSonHubArchiveEntry compacted = *entry;
+        compacted.segmentOffset = offset;
+        compacted.segmentSize = segmentSize;
+        compacted.dataOffset = offset + kSegmentHeaderSize + pathBytes.size();
+        compactedEntries.insert(compacted.path, compacted);
+        offset += segmentSize;
+    }
+
+    const QByteArray index = indexBytes(sortedEntries(compactedEntries));
+    if (writeSucceeded)
+    {
+        writeSucceeded = target.write(index) == index.size();
+    }
+    if (writeSucceeded)
+    {
+        const QByteArray trailer = trailerBytes(offset, index, offset - kFileHeaderSize);
+        writeSucceeded = target.write(trailer) == trailer.size();
+    }
+
+    source.m_indexDirty = false;
+    source.close();
+    if (!writeSucceeded || !target.commit())
+    {
+        target.cancelWriting();
+        return failWith(errorMessage, QStringLiteral("Failed to write compacted hub archive: %1").arg(archivePath));
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.archive"),
+        QStringLiteral("compact.success"),
+        QStringLiteral("path=%1 entries=%2 bytes=%3")
+            .arg(archivePath)
+            .arg(compactedEntries.size())
+            .arg(offset + index.size() + kTrailerSize));
+    return true;
+}
+
+QString WhatSonHubArchive::normalizeEntryPath(const QString& entryPath)
+{
+    QString normalized = entryPath.trimmed();
+    normalized.replace(QLatin1Char('\\'), QLatin1Char('/'));
+    normalized = QDir::cleanPath(normalized);
+    while (normalized.startsWith(QLatin1Char('/')))
+    {
+        normalized.remove(0, 1);
+    }
+    if (normalized == QStringLiteral(".")
+        || normalized == QStringLiteral("..")
+        || normalized.startsWith(QStringLiteral("../")))
+    {
+        return {};
+    }
+    return normalized;
+}
+
+bool WhatSonHubArchive::open(const QString& archivePath, QString* errorMessage)
+{
+    close();
+
+    const QString normalizedPath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    if (normalizedPath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive path must not be empty."));
+    }
+
+    m_file.setFileName(normalizedPath);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to open hub archive: %1").arg(normalizedPath));
+    }
+
+    const qint64 fileSize = m_file.size();
+    const QByteArray header = m_file.read(kFileHeaderSize);
+    if (header.size() != kFileHeaderSize
+        || std::memcmp(header.constData(), kFileMagic, sizeof(kFileMagic)) != 0)
+    {
+        m_file.close();
+        return failWith(errorMessage, QStringLiteral("Not a packed WhatSon Hub archive: %1").arg(normalizedPath));
+    }
+
+    const quint32 version = readLittleEndian<quint32>(header.constData() + sizeof(kFileMagic));
+    if (version != kFormatVersion)
+    {
+        m_file.close();
+        return failWith(errorMessage, QStringLiteral("Unsupported hub archive version %1: %2")
+                                          .arg(version)
+                                          .arg(normalizedPath));
+    }
+
+    m_archivePath = normalizedPath;
+    if (!readIndex(fileSize, nullptr))
+    {
+        recoverIndexFromSegments(fileSize);
+        m_recoveredFromSegments = true;
+        m_indexDirty = true;
+        WhatSon::Debug::trace(
+            QStringLiteral("hub.archive"),
+            QStringLiteral("open.recoveredFromSegments"),
+            QStringLiteral("path=%1 entries=%2").arg(m_archivePath).arg(m_entries.size()));
+    }
+    return true;
+}
+
+bool WhatSonHubArchive::flush(QString* errorMessage)
+{
+    if (!m_indexDirty)
+    {
+        return true;
+    }
+    if (!ensureWritable(errorMessage))
+    {
+        return false;
+    }
+
+    unmap();
+    const QByteArray index = indexBytes(sortedEntries(m_entries));
+    QByteArray tail = index;
+    tail.append(trailerBytes(m_appendOffset, index, m_segmentBytes));
+    if (!m_file.seek(m_appendOffset)
+        || m_file.write(tail) != tail.size()
+        || !m_file.resize(m_appendOffset + tail.size())
+        || !m_file.flush())
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to write hub archive index: %1").arg(m_archivePath));
+    }
+
+    m_indexDirty = false;
+    m_recoveredFromSegments = false;
+    return true;
+}
+
+void WhatSonHubArchive::close()
+{
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+
+    if (m_writable)
+    {
+        QString flushError;
+        if (!flush(&flushError))
+        {
+            WhatSon::Debug::trace(QStringLiteral("hub.archive"), QStringLiteral("close.flushFailed"), flushError);
+        }
+    }
+
+    unmap();
+    m_file.close();
+    m_archivePath.clear();
+    m_entries.clear();
+    m_appendOffset = 0;
+    m_segmentBytes = 0;
+    m_writable = false;
+    m_indexDirty = false;
+    m_recoveredFromSegments = false;
+}
+
+bool WhatSonHubArchive::isOpen() const noexcept
+{
+    return m_file.isOpen();
+}
+
+bool WhatSonHubArchive::recoveredFromSegments() const noexcept
+{
+    return m_recoveredFromSegments;
+}
+
+QString WhatSonHubArchive::archivePath() const
+{
+    return m_archivePath;
+}
+
+QStringList WhatSonHubArchive::entryPaths() const
+{
+    QStringList paths = m_entries.keys();
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+int WhatSonHubArchive::entryCount() const noexcept
+{
+    return static_cast<int>(m_entries.size());
+}
+
+bool WhatSonHubArchive::contains(const QString& entryPath) const
+{
+    return m_entries.contains(normalizeEntryPath(entryPath));
+}
+
+const WhatSonHubArchiveEntry* WhatSonHubArchive::entry(const QString& entryPath) const
+{
+    const auto it = m_entries.constFind(normalizeEntryPath(entryPath));
+    return it == m_entries.cend() ? nullptr : &it.value();
+}
+
+QByteArrayView WhatSonHubArchive::fileView(const QString& entryPath) const
+{
+    const WhatSonHubArchiveEntry* archiveEntry = entry(entryPath);
+    if (archiveEntry == nullptr || archiveEntry->directory || !ensureMapped())
+    {
+        return {};
+    }
+    if (archiveEntry->dataOffset < 0 || archiveEntry->dataOffset + archiveEntry->size > m_mappedSize)
+    {
+        return {};
+    }
+    return QByteArrayView(
+        reinterpret_cast<const char*>(m_mappedBytes + archiveEntry->dataOffset),
+        archiveEntry->size);
+}
+
+QByteArray WhatSonHubArchive::readFile(const QString& entryPath, QString* errorMessage) const
+{
+    const WhatSonHubArchiveEntry* archiveEntry = entry(entryPath);
+    if (archiveEntry == nullptr || archiveEntry->directory)
+    {
+        failWith(errorMessage, QStringLiteral("Hub archive file entry is missing: %1").arg(entryPath));
+        return {};
+    }
+
+    if (ensureMapped())
+    {
+        const QByteArrayView view = fileView(entryPath);
+        if (view.size() == archiveEntry->size)
+        {
+            return view.toByteArray();
+        }
+    }
+
+    if (!m_file.seek(archiveEntry->dataOffset))
+    {
+        failWith(errorMessage, QStringLiteral("Failed to seek hub archive entry: %1").arg(entryPath));
+        return {};
+    }
+    QByteArray data = m_file.read(archiveEntry->size);
+    if (data.size() != archiveEntry->size)
+    {
+        failWith(errorMessage, QStringLiteral("Hub archive entry is truncated: %1").arg(entryPath));
+        return {};
+    }
+    return data;
+}
+
+bool WhatSonHubArchive::copyFileTo(
+    const QString& entryPath,
+    QIODevice* target,
+    QByteArray* outSha1,
+    QString* errorMessage) const
+{
+    const WhatSonHubArchiveEntry* archiveEntry = entry(entryPath);
+    if (archiveEntry == nullptr || archiveEntry->directory)
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive file entry is missing: %1").arg(entryPath));
+    }
+    if (target == nullptr || !target->isWritable())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive copy target is not writable: %1").arg(entryPath));
+    }
+
+    const QByteArrayView mappedView = fileView(entryPath);
+    const bool mapped = mappedView.size() == archiveEntry->size;
+    if (!mapped && !m_file.seek(archiveEntry->dataOffset))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to seek hub archive entry: %1").arg(entryPath));
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    qint64 copied = 0;
+    while (copied < archiveEntry->size)
+    {
+        const qint64 chunkSize = std::min(archiveEntry->size - copied, kStreamChunkSize);
+        QByteArray readChunk;
+        QByteArrayView chunk;
+        if (mapped)
+        {
+            chunk = mappedView.sliced(copied, chunkSize);
+        }
+        else
+        {
+            readChunk = m_file.read(chunkSize);
+            if (readChunk.size() != chunkSize)
+            {
+                return failWith(errorMessage, QStringLiteral("Hub archive entry is truncated: %1").arg(entryPath));
+            }
+            chunk = readChunk;
+        }
+
+        hash.addData(chunk);
+        if (target->write(chunk.data(), chunk.size()) != chunk.size())
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to copy hub archive entry: %1").arg(entryPath));
+        }
+        copied += chunkSize;
+    }
+
+    if (outSha1 != nullptr)
+    {
+        *outSha1 = hash.result();
+    }
+    return true;
+}
+
+bool WhatSonHubArchive::writeFile(
+    const QString& entryPath,
+    const QByteArray& data,
+    const qint64 modifiedMsecsSinceEpoch,
+    QString* errorMessage)
+{
+    const QString normalizedPath = normalizeEntryPath(entryPath);
+    if (normalizedPath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Invalid hub archive entry path: %1").arg(entryPath));
+    }
+
+    WhatSonHubArchiveEntry archiveEntry;
+    if (!appendSegment(kFileSegment, normalizedPath, nullptr, data, modifiedMsecsSinceEpoch, &archiveEntry, errorMessage))
+    {
+        return false;
+    }
+    m_entries.insert(normalizedPath, archiveEntry);
+    return true;
+}
+
+bool WhatSonHubArchive::writeFileFromDevice(
+    const QString& entryPath,
+    QIODevice* device,
+    const qint64 modifiedMsecsSinceEpoch,
+    QString* errorMessage)
+{
+    const QString normalizedPath = normalizeEntryPath(entryPath);
+    if (normalizedPath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Invalid hub archive entry path: %1").arg(entryPath));
+    }
+    if (device == nullptr || !device->isReadable())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive source device is not readable: %1").arg(entryPath));
+    }
+
+    WhatSonHubArchiveEntry archiveEntry;
+    if (!appendSegment(kFileSegment, normalizedPath, device, {}, modifiedMsecsSinceEpoch, &archiveEntry, errorMessage))
+    {
+        return false;
+    }
+    m_entries.insert(normalizedPath, archiveEntry);
+    return true;
+}
+
+bool WhatSonHubArchive::writeDirectory(
+    const QString& entryPath,
+    const qint64 modifiedMsecsSinceEpoch,
+    QString* errorMessage)
+{
+    const QString normalizedPath = normalizeEntryPath(entryPath);
+    if (normalizedPath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Invalid hub archive entry path: %1").arg(entryPath));
+    }
+
+    WhatSonHubArchiveEntry archiveEntry;
+    if (!appendSegment(
+        kDirectorySegment,
+        normalizedPath,
+        nullptr,
+        {},
+        modifiedMsecsSinceEpoch,
+        &archiveEntry,
+        errorMessage))
+    {
+        return false;
+    }
+    m_entries.insert(normalizedPath, archiveEntry);
+    return true;
+}
+
+bool WhatSonHubArchive::removeEntry(const QString& entryPath, QString* errorMessage)
+{
+    const QString normalizedPath = normalizeEntryPath(entryPath);
+    if (normalizedPath.isEmpty() || !m_entries.contains(normalizedPath))
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive entry is missing: %1").arg(entryPath));
+    }
+
+    if (!appendSegment(kTombstoneSegment, normalizedPath, nullptr, {}, 0, nullptr, errorMessage))
+    {
+        return false;
+    }
+    removeEntryAndDescendants(&m_entries, normalizedPath);
+    return true;
+}
+
+qint64 WhatSonHubArchive::segmentBytes() const noexcept
+{
+    return m_segmentBytes;
+}
+
+qint64 WhatSonHubArchive::deadSegmentBytes() const noexcept
+{
+    qint64 liveBytes = 0;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+    {
+        liveBytes += it.value().segmentSize;
+    }
+    return std::max<qint64>(0, m_segmentBytes - liveBytes);
+}
+
+bool WhatSonHubArchive::needsCompaction() const noexcept
+{
+    const qint64 deadBytes = deadSegmentBytes();
+    return deadBytes >= kCompactionMinimumDeadBytes && deadBytes * 2 >= m_segmentBytes;
+}
+
+bool WhatSonHubArchive::readIndex(const qint64 fileSize, QString* errorMessage)
+{
+    if (fileSize < kFileHeaderSize + kTrailerSize || !m_file.seek(fileSize - kTrailerSize))
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive trailer is missing."));
+    }
+
+    const QByteArray trailer = m_file.read(kTrailerSize);
+    if (trailer.size() != kTrailerSize
+        || std::memcmp(trailer.constData() + 32, kTrailerMagic, sizeof(kTrailerMagic)) != 0)
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive trailer is invalid."));
+    }
+
+    const qint64 indexOffset = readLittleEndian<qint64>(trailer.constData());
+    const qint64 indexSize = readLittleEndian<qint64>(trailer.constData() + 8);
+    const qint64 segmentBytes = readLittleEndian<qint64>(trailer.constData() + 16);
+    const quint64 checksum = readLittleEndian<quint64>(trailer.constData() + 24);
+    if (indexOffset < kFileHeaderSize
+        || indexSize < 8
+        || indexOffset + indexSize != fileSize - kTrailerSize
+        || segmentBytes != indexOffset - kFileHeaderSize
+        || !m_file.seek(indexOffset))
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive index bounds are invalid."));
+    }
+
+    const QByteArray index = m_file.read(indexSize);
+    if (index.size() != indexSize
+        || indexChecksum(index) != checksum
+        || readLittleEndian<quint32>(index.constData()) != kIndexMagic)
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive index checksum does not match."));
+    }
+
+    const quint32 entryCount = readLittleEndian<quint32>(index.constData() + 4);
+    QHash<QString, WhatSonHubArchiveEntry> entries;
+    entries.reserve(entryCount);
+    qint64 cursor = 8;
+    for (quint32 entryIndex = 0; entryIndex < entryCount; ++entryIndex)
+    {
+        if (cursor + kIndexEntryFixedSize > index.size())
+        {
+            return failWith(errorMessage, QStringLiteral("Hub archive index is truncated."));
+        }
+
+        const char* record = index.constData() + cursor;
+        const quint8 kind = static_cast<quint8>(record[0]);
+        const qint64 pathSize = readLittleEndian<quint32>(record + 4);
+        if (pathSize <= 0 || pathSize > kMaximumEntryPathBytes
+            || cursor + kIndexEntryFixedSize + pathSize > index.size()
+            || (kind != kFileSegment && kind != kDirectorySegment))
+        {
+            return failWith(errorMessage, QStringLiteral("Hub archive index entry is invalid."));
+        }
+
+        WhatSonHubArchiveEntry archiveEntry;
+        archiveEntry.directory = kind == kDirectorySegment;
+        archiveEntry.segmentOffset = readLittleEndian<qint64>(record + 8);
+        archiveEntry.size = readLittleEndian<qint64>(record + 16);
+        archiveEntry.modifiedMsecsSinceEpoch = readLittleEndian<qint64>(record + 24);
+        archiveEntry.sha1 = QByteArray(record + 32, kSha1Size);
+        archiveEntry.path = QString::fromUtf8(record + kIndexEntryFixedSize, pathSize);
+        archiveEntry.segmentSize = kSegmentHeaderSize + pathSize + archiveEntry.size;
+        archiveEntry.dataOffset = archiveEntry.segmentOffset + kSegmentHeaderSize + pathSize;
+        if (archiveEntry.segmentOffset < kFileHeaderSize
+            || archiveEntry.size < 0
+            || archiveEntry.segmentOffset + archiveEntry.segmentSize > indexOffset)
+        {
+            return failWith(errorMessage, QStringLiteral("Hub archive index entry points outside the segment area."));
+        }
+
+        entries.insert(archiveEntry.path, archiveEntry);
+        cursor += kIndexEntryFixedSize + pathSize;
+    }
+
+    m_entries = std::move(entries);
+    m_appendOffset = indexOffset;
+    m_segmentBytes = segmentBytes;
+    return true;
+}
+
+void WhatSonHubArchive::recoverIndexFromSegments(const qint64 fileSize)
+{
+    m_entries.clear();
+    qint64 offset = kFileHeaderSize;
+    while (offset + kSegmentHeaderSize <= fileSize && m_file.seek(offset))
+    {
+        const QByteArray header = m_file.read(kSegmentHeaderSize);
+        if (header.size() != kSegmentHeaderSize || readLittleEndian<quint32>(header.constData()) != kSegmentMagic)
+        {
+            break;
+        }
+
+        const quint8 kind = static_cast<quint8>(header.at(4));
+        const qint64 pathSize = readLittleEndian<quint32>(header.constData() + 8);
+        const qint64 dataSize = readLittleEndian<qint64>(header.constData() + 12);
+        const qint64 segmentSize = kSegmentHeaderSize + pathSize + dataSize;
+        if (kind < kFileSegment || kind > kTombstoneSegment
+            || pathSize <= 0 || pathSize > kMaximumEntryPathBytes
+            || dataSize < 0
+            || offset + segmentSize > fileSize)
+        {
+            break;
+        }
+
+        const QByteArray pathBytes = m_file.read(pathSize);
+        if (pathBytes.size() != pathSize)
+        {
+            break;
+        }
+
+        // A torn or half-streamed file segment ends recovery; everything before it is the last consistent state.
+        const QByteArray recordedSha1 = header.mid(28, kSha1Size);
+        if (kind == kFileSegment && !segmentDataMatchesSha1(dataSize, recordedSha1))
+        {
+            break;
+        }
+
+        const QString entryPath = QString::fromUtf8(pathBytes);
+        if (kind == kTombstoneSegment)
+        {
+            removeEntryAndDescendants(&m_entries, entryPath);
+        }
+        else
+        {
+            WhatSonHubArchiveEntry archiveEntry;
+            archiveEntry.path = entryPath;
+            archiveEntry.directory = kind == kDirectorySegment;
+            archiveEntry.segmentOffset = offset;
+            archiveEntry.segmentSize = segmentSize;
+            archiveEntry.dataOffset = offset + kSegmentHeaderSize + pathSize;
+            archiveEntry.size = dataSize;
+            archiveEntry.modifiedMsecsSinceEpoch = readLittleEndian<qint64>(header.constData() + 20);
+            archiveEntry.sha1 = recordedSha1;
+            m_entries.insert(entryPath, archiveEntry);
+        }
+        offset += segmentSize;
+    }
+
+    m_appendOffset = offset;
+    m_segmentBytes = offset - kFileHeaderSize;
+}
+
+bool WhatSonHubArchive::segmentDataMatchesSha1(const qint64 dataSize, const QByteArray& recordedSha1)
+{
+    // Reads from the current file position, which recovery leaves at the start of the segment data.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    qint64 remaining = dataSize;
+    while (remaining > 0)
+    {
+        const QByteArray chunk = m_file.read(std::min(remaining, kStreamChunkSize));
+        if (chunk.isEmpty())
+        {
+            return false;
+        }
+        hash.addData(chunk);
+        remaining -= chunk.size();
+    }
+    return paddedSha1(hash.result()) == recordedSha1;
+}
+
+bool WhatSonHubArchive::ensureWritable(QString* errorMessage)
+{
+    if (m_writable)
+    {
+        return true;
+    }
+    if (!m_file.isOpen())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive is not open."));
+    }
+
+    unmap();
+    m_file.close();
+    if (!m_file.open(QIODevice::ReadWrite))
+    {
+        static_cast<void>(m_file.open(QIODevice::ReadOnly));
+        return failWith(errorMessage, QStringLiteral("Hub archive is read-only: %1").arg(m_archivePath));
+    }
+    m_writable = true;
+    return true;
+}
+
+bool WhatSonHubArchive::appendSegment(
+    const quint8 kind,
+    const QString& entryPath,
+    QIODevice* device,
+    const QByteArray& data,
+    const qint64 modifiedMsecsSinceEpoch,
+    WhatSonHubArchiveEntry* outEntry,
+    QString* errorMessage)
+{
+    const QByteArray pathBytes = entryPath.toUtf8();
+    if (pathBytes.size() > kMaximumEntryPathBytes)
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive entry path is too long: %1").arg(entryPath));
+    }
+    if (!ensureWritable(errorMessage))
+    {
+        return false;
+    }
+
+    unmap();
+    if (!m_indexDirty)
+    {
+        // Drop the previous index and trailer first so an interrupted append is detected on the next open.
+        if (!m_file.resize(m_appendOffset))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to truncate hub archive index: %1").arg(m_archivePath));
+        }
+        m_indexDirty = true;
+    }
+
+    const qint64 segmentOffset = m_appendOffset;
+    qint64 dataSize = 0;
+    QByteArray sha1;
+    bool writeSucceeded = m_file.seek(segmentOffset);
+    if (device == nullptr)
+    {
+        dataSize = data.size();
+        sha1 = kind == kFileSegment ? QCryptographicHash::hash(data, QCryptographicHash::Sha1) : QByteArray();
+        QByteArray segment = segmentHeaderBytes(kind, pathBytes, dataSize, modifiedMsecsSinceEpoch, sha1);
+        segment.append(pathBytes);
+        segment.append(data);
+        writeSucceeded = writeSucceeded && m_file.write(segment) == segment.size();
+    }
+    else
+    {
+        QByteArray placeholder =
+            segmentHeaderBytes(kind, pathBytes, 0, modifiedMsecsSinceEpoch, {}, kPendingSegmentMagic);
+        placeholder.append(pathBytes);
+        writeSucceeded = writeSucceeded && m_file.write(placeholder) == placeholder.size();
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        while (writeSucceeded && !device->atEnd())
+        {
+            const QByteArray chunk = device->read(kStreamChunkSize);
+            if (chunk.isEmpty())
+            {
+                writeSucceeded = device->atEnd();
+                break;
+            }
+            hash.addData(chunk);
+            dataSize += chunk.size();
+            writeSucceeded = m_file.write(chunk) == chunk.size();
+        }
+        sha1 = hash.result();
+
+        const QByteArray header = segmentHeaderBytes(kind, pathBytes, dataSize, modifiedMsecsSinceEpoch, sha1);
+        writeSucceeded = writeSucceeded
+            && m_file.seek(segmentOffset)
+            && m_file.write(header) == header.size();
+    }
+
+    const qint64 segmentSize = kSegmentHeaderSize + pathBytes.size() + dataSize;
+    if (!writeSucceeded)
+    {
+        m_file.resize(segmentOffset);
+        return failWith(errorMessage, QStringLiteral("Failed to append hub archive entry: %1").arg(entryPath));
+    }
+
+    m_appendOffset = segmentOffset + segmentSize;
+    m_segmentBytes += segmentSize;
+    if (outEntry != nullptr)
+    {
+        outEntry->path = entryPath;
+        outEntry->directory = kind == kDirectorySegment;
+        outEntry->segmentOffset = segmentOffset;
+        outEntry->segmentSize = segmentSize;
+        outEntry->dataOffset = segmentOffset + kSegmentHeaderSize + pathBytes.size();
+        outEntry->size = dataSize;
+        outEntry->modifiedMsecsSinceEpoch = modifiedMsecsSinceEpoch;
+        outEntry->sha1 = paddedSha1(sha1);
+    }
+    return true;
+}
+
+bool WhatSonHubArchive::ensureMapped() const
+{
+    if (m_mappedBytes != nullptr)
+    {
+        return true;
+    }
+    if (!m_file.isOpen())
+    {
+        return false;
+    }
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize <= 0)
+    {
+        return false;
+    }
+    m_mappedBytes = m_file.map(0, fileSize);
+    m_mappedSize = m_mappedBytes != nullptr ? fileSize : 0;
+    return m_mappedBytes != nullptr;
+}
+
+void WhatSonHubArchive::unmap() const
+{
+    if (m_mappedBytes != nullptr)
+    {
+        m_file.unmap(m_mappedBytes);
+    }
+    m_mappedBytes = nullptr;
+    m_mappedSize = 0;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QIODevice;
+
+struct WhatSonHubArchiveEntry final
+{
+    QString path;
+    bool directory = false;
+    qint64 segmentOffset = 0;
+    qint64 segmentSize = 0;
+    qint64 dataOffset = 0;
+    qint64 size = 0;
+    qint64 modifiedMsecsSinceEpoch = 0;
+    QByteArray sha1;
+};
+
+class WhatSonHubArchive final
+{
+public:
+    static constexpr quint32 kFormatVersion = 1;
+
+    WhatSonHubArchive() = default;
+    ~WhatSonHubArchive();
+
+    WhatSonHubArchive(const WhatSonHubArchive&) = delete;
+    WhatSonHubArchive& operator=(const WhatSonHubArchive&) = delete;
+
+    static bool isPackedArchive(const QString& archivePath);
+    static bool create(const QString& archivePath, QString* errorMessage = nullptr);
+    static bool compact(const QString& archivePath, QString* errorMessage = nullptr);
+    static QString normalizeEntryPath(const QString& entryPath);
+
+    bool open(const QString& archivePath, QString* errorMessage = nullptr);
+    bool flush(QString* errorMessage = nullptr);
+    void close();
+
+    bool isOpen() const noexcept;
+    bool recoveredFromSegments() const noexcept;
+    QString archivePath() const;
+    QStringList entryPaths() const;
+    int entryCount() const noexcept;
+    bool contains(const QString& entryPath) const;
+    const WhatSonHubArchiveEntry* entry(const QString& entryPath) const;
+
+    QByteArrayView fileView(const QString& entryPath) const;
+    QByteArray readFile(const QString& entryPath, QString* errorMessage = nullptr) const;
+    // Streams a file entry into target in bounded chunks and reports the sha1 of what was copied.
+    bool copyFileTo(
+        const QString& entryPath,
+        QIODevice* target,
+        QByteArray* outSha1 = nullptr,
+        QString* errorMessage = nullptr) const;
+
+    bool writeFile(
+        const QString& entryPath,
+        const QByteArray& data,
+        qint64 modifiedMsecsSinceEpoch,
+        QString* errorMessage = nullptr);
+    bool writeFileFromDevice(
+        const QString& entryPath,
+        QIODevice* device,
+        qint64 modifiedMsecsSinceEpoch,
+        QString* errorMessage = nullptr);
+    bool writeDirectory(
+        const QString& entryPath,
+        qint64 modifiedMsecsSinceEpoch,
+        QString* errorMessage = nullptr);
+    bool removeEntry(const QString& entryPath, QString* errorMessage = nullptr);
+
+    qint64 segmentBytes() const noexcept;
+    qint64 deadSegmentBytes() const noexcept;
+    bool needsCompaction() const noexcept;
+
+private:
+    bool readIndex(qint64 fileSize, QString* errorMessage);
+    void recoverIndexFromSegments(qint64 fileSize);
+    bool segmentDataMatchesSha1(qint64 dataSize, const QByteArray& recordedSha1);
+    bool ensureWritable(QString* errorMessage);
+    bool appendSegment(
+        quint8 kind,
+        const QString& entryPath,
+        QIODevice* device,
+        const QByteArray& data,
+        qint64 modifiedMsecsSinceEpoch,
+        WhatSonHubArchiveEntry* outEntry,
+        QString* errorMessage);
+    bool ensureMapped() const;
+    void unmap() const;
+
+    QString m_archivePath;
+    mutable QFile m_file;
+    mutable uchar* m_mappedBytes = nullptr;
+    mutable qint64 m_mappedSize = 0;
+    QHash<QString, WhatSonHubArchiveEntry> m_entries;
+    qint64 m_appendOffset = 0;
+    qint64 m_segmentBytes = 0;
+    bool m_writable = false;
+    bool m_indexDirty = false;
+    bool m_recoveredFromSegments = false;
+};
@@ -0,0 +1,667 @@
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    const QString kMountStampRelativePath = QStringLiteral(".whatson/packed-archive.stamp");
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    QString archiveStamp(const QString& archivePath)
+    {
+        const QFileInfo archiveInfo(archivePath);
+        return QStringLiteral("%1\n%2\n%3\n").arg(
+            archiveInfo.absoluteFilePath(),
+            QString::number(archiveInfo.size()),
+            QString::number(archiveInfo.lastModified().toMSecsSinceEpoch()));
+    }
+
+    struct MountStamp final
+    {
+        QString archiveStamp;
+        QByteArray stagingSignature;
+    };
+
+    QMutex& mountedArchivesMutex()
+    {
+        static QMutex mutex;
+        return mutex;
+    }
+
+    QSet<QString>& mountedArchives()
+    {
+        static QSet<QString> archives;
+        return archives;
+    }
+
+    // Mounting, write-back and compaction all rewrite the archive or its stamp; they never overlap.
+    QMutex& archiveMaintenanceMutex()
+    {
+        static QMutex mutex;
+        return mutex;
+    }
+
+    // Background write-backs and compactions run one at a time on this thread instead of the GUI thread.
+    QThreadPool& archiveMaintenancePool()
+    {
+        static QThreadPool pool;
+        static const bool configured = []()
+        {
+            pool.setMaxThreadCount(1);
+            return true;
+        }();
+        Q_UNUSED(configured);
+        return pool;
+    }
+
+    QStringList stagedRelativePaths(const QString& stagingPath)
+    {
+        QStringList relativePaths;
+        const QDir stagingDirectory(stagingPath);
+        QDirIterator iterator(
+            stagingPath,
+            QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+            QDirIterator::Subdirectories);
+        while (iterator.hasNext())
+        {
+            iterator.next();
+            const QString relativePath = stagingDirectory.relativeFilePath(iterator.filePath());
+            if (relativePath != kMountStampRelativePath)
+            {
+                relativePaths.push_back(relativePath);
+            }
+        }
+        std::sort(relativePaths.begin(), relativePaths.end());
+        return relativePaths;
+    }
+
+    // Paths, sizes and mtimes of the staged files. A mismatch against the stamp means the mounted hub was edited.
+    QByteArray stagingSignature(const QString& stagingPath)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        const QDir stagingDirectory(stagingPath);
+        for (const QString& relativePath : stagedRelativePaths(stagingPath))
+        {
+            const QFileInfo info(stagingDirectory.filePath(relativePath));
+            hash.addData(relativePath.toUtf8());
+            hash.addData(QByteArrayView(info.isDir() ? "/d\n" : "/f\n"));
+            if (!info.isDir())
+            {
+                hash.addData(QByteArray::number(info.size()) + '\n');
+                hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + '\n');
+            }
+        }
+        return hash.result().toHex();
+    }
+
+    MountStamp readMountStamp(const QString& stampPath)
+    {
+        QFile file(stampPath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return {};
+        }
+        const QString text = QString::fromUtf8(file.readAll());
+        const qsizetype signatureStart = text.lastIndexOf(QStringLiteral("signature="));
+        if (signatureStart < 0)
+        {
+            return {};
+        }
+        MountStamp stamp;
+        stamp.archiveStamp = text.left(signatureStart);
+        stamp.stagingSignature = text.mid(signatureStart + 10).trimmed().toLatin1();
+        return stamp;
+    }
+
+    bool writeMountStamp(
+        const QString& stagingPath,
+        const QString& archivePath,
+        const QByteArray& signature,
+        QString* errorMessage)
+    {
+        const QString stampPath = QDir(stagingPath).filePath(kMountStampRelativePath);
+        const QByteArray text = archiveStamp(archivePath).toUtf8()
+            + QByteArrayLiteral("signature=") + signature + '\n';
+        QSaveFile stampFile(stampPath);
+        if (!stampFile.open(QIODevice::WriteOnly)
+            || stampFile.write(text) < 0
+            || !stampFile.commit())
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to record packed hub mount stamp: %1").arg(stampPath));
+        }
+        return true;
+    }
+
+    bool writeMountStamp(const QString& stagingPath, const QString& archivePath, QString* errorMessage)
+    {
+        const QString stampPath = QDir(stagingPath).filePath(kMountStampRelativePath);
+        // The stamp directory is part of the signature, so it has to exist before the signature is taken.
+        if (!QDir().mkpath(QFileInfo(stampPath).absolutePath()))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to create directory: %1").arg(stampPath));
+        }
+        return writeMountStamp(stagingPath, archivePath, stagingSignature(stagingPath), errorMessage);
+    }
+
+    // Compaction changes the archive's size and mtime but not its content, so a mount that matched the archive
+    // before keeps matching it afterwards. The recorded signature is kept: edits made meanwhile stay unsaved.
+    bool compactAndRestamp(const QString& archivePath, QString* errorMessage)
+    {
+        QMutexLocker locker(&archiveMaintenanceMutex());
+        const QString stagingPath = WhatSonHubArchiveConverter::mountStagingPath(archivePath);
+        const MountStamp stamp = readMountStamp(QDir(stagingPath).filePath(kMountStampRelativePath));
+        const bool restamp = !stamp.archiveStamp.isEmpty() && stamp.archiveStamp == archiveStamp(archivePath);
+        if (!WhatSonHubArchive::compact(archivePath, errorMessage))
+        {
+            return false;
+        }
+        return !restamp || writeMountStamp(stagingPath, archivePath, stamp.stagingSignature, errorMessage);
+    }
+
+    bool isEmptyOrMissingDirectory(const QString& directoryPath)
+    {
+        const QFileInfo info(directoryPath);
+        if (!info.exists())
+        {
+            return true;
+        }
+        return info.isDir()
+            && QDir(directoryPath).isEmpty(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    }
+} // namespace
+
+bool WhatSonHubArchiveConverter::packDirectory(
+    const QString& hubDirectoryPath,
+    const QString& archivePath,
+    const bool replaceExisting,
+    QString* errorMessage) const
+{
+    const QString sourcePath = WhatSon::HubPath::normalizeAbsolutePath(hubDirectoryPath);
+    const QString targetPath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.archive.converter"),
+        QStringLiteral("packDirectory.begin"),
+        QStringLiteral("source=%1 target=%2").arg(sourcePath, targetPath));
+
+    if (sourcePath.isEmpty() || !QFileInfo(sourcePath).isDir())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub directory does not exist: %1").arg(sourcePath));
+    }
+    if (targetPath.isEmpty() || targetPath == sourcePath)
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive path must differ from the hub directory."));
+    }
+
+    const QFileInfo targetInfo(targetPath);
+    if (targetInfo.exists() && (!replaceExisting || !targetInfo.isFile()))
+    {
+        return failWith(errorMessage, QStringLiteral("Hub archive target already exists: %1").arg(targetPath));
+    }
+    if (!QDir().mkpath(targetInfo.absolutePath()))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to create directory: %1").arg(targetInfo.absolutePath()));
+    }
+
+    const QString partialPath = targetPath + QStringLiteral(".partial");
+    QFile::remove(partialPath);
+    if (!WhatSonHubArchive::create(partialPath, errorMessage))
+    {
+        return false;
+    }
+
+    QStringList relativePaths;
+    const QDir sourceDirectory(sourcePath);
+    QDirIterator iterator(
+        sourcePath,
+        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+        QDirIterator::Subdirectories);
+    while (iterator.hasNext())
+    {
+        iterator.next();
+        const QString relativePath = sourceDirectory.relativeFilePath(iterator.filePath());
+        if (relativePath != kMountStampRelativePath)
+        {
+            relativePaths.push_back(relativePath);
+        }
+    }
+    std::sort(relativePaths.begin(), relativePaths.end());
+
+    bool packSucceeded = true;
+    {
+        WhatSonHubArchive archive;
+        packSucceeded = archive.open(partialPath, errorMessage);
+        for (const QString& relativePath : std::as_const(relativePaths))
+        {
+            if (!packSucceeded)
+            {
+                break;
+            }
+
+            const QFileInfo entryInfo(sourceDirectory.filePath(relativePath));
+            const qint64 modifiedMsecs = entryInfo.lastModified().toMSecsSinceEpoch();
+            if (entryInfo.isDir())
+            {
+                packSucceeded = archive.writeDirectory(relativePath, modifiedMsecs, errorMessage);
+                continue;
+            }
+
+            QFile sourceFile(entryInfo.absoluteFilePath());
+            if (!sourceFile.open(QIODevice::ReadOnly))
+            {
+                packSucceeded = failWith(
+                    errorMessage,
+                    QStringLiteral("Failed to read hub file: %1").arg(entryInfo.absoluteFilePath()));
+                break;
+            }
+            packSucceeded = archive.writeFileFromDevice(relativePath, &sourceFile, modifiedMsecs, errorMessage);
+        }
+        packSucceeded = packSucceeded && archive.flush(errorMessage);
+    }
+
+    if (!packSucceeded)
+    {
+        QFile::remove(partialPath);
+        return false;
+    }
+    if (targetInfo.exists() && !QFile::remove(targetPath))
+    {
+        QFile::remove(partialPath);
+        return failWith(errorMessage, QStringLiteral("Failed to replace hub archive: %1").arg(targetPath));
+    }
+    if (!QFile::rename(partialPath, targetPath))
+    {
+        QFile::remove(partialPath);
+        return failWith(errorMessage, QStringLiteral("Failed to finalize hub archive: %1").arg(targetPath));
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.archive.converter"),
+        QStringLiteral("packDirectory.success"),
+        QStringLiteral("target=%1 entries=%2").arg(targetPath).arg(relativePaths.size()));
+    return true;
+}
+
+bool WhatSonHubArchiveConverter::unpackArchive(
+    const QString& archivePath,
+    const QString& hubDirectoryPath,
+    QString* errorMessage) const
+{
+    const QString sourcePath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    const QString targetPath = WhatSon::HubPath::normalizeAbsolutePath(hubDirectoryPath);
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.archive.converter"),
+        QStringLiteral("unpackArchive.begin"),
+        QStringLiteral("source=%1 target=%2").arg(sourcePath, targetPath));
+
+    if (targetPath.isEmpty() || !isEmptyOrMissingDirectory(targetPath))
+    {
+        return failWith(errorMessage, QStringLiteral("Hub directory target is not empty: %1").arg(targetPath));
+    }
+
+    WhatSonHubArchive archive;
+    if (!archive.open(sourcePath, errorMessage))
+    {
+        return false;
+    }
+
+    const QString partialPath = targetPath + QStringLiteral(".partial");
+    QDir(partialPath).removeRecursively();
+    if (!QDir().mkpath(partialPath))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to create directory: %1").arg(partialPath));
+    }
+
+    const QDir partialDirectory(partialPath);
+    bool unpackSucceeded = true;
+    for (const QString& entryPath : archive.entryPaths())
+    {
+        const WhatSonHubArchiveEntry* entry = archive.entry(entryPath);
+        const QString outputPath = partialDirectory.filePath(entryPath);
+        if (entry->directory)
+        {
+            unpackSucceeded = QDir().mkpath(outputPath)
+                || failWith(errorMessage, QStringLiteral("Failed to create directory: %1").arg(outputPath));
+            if (!unpackSucceeded)
+            {
+                break;
+            }
+            continue;
+        }
+
+        QFile outputFile(outputPath);
+        if (!QDir().mkpath(QFileInfo(outputPath).absolutePath())
+            || !outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            unpackSucceeded = failWith(errorMessage, QStringLiteral("Failed to write hub file: %1").arg(outputPath));
+            break;
+        }
+        QByteArray copiedSha1;
+        if (!archive.copyFileTo(entryPath, &outputFile, &copiedSha1, errorMessage))
+        {
+            unpackSucceeded = false;
+            break;
+        }
+        if (copiedSha1 != entry->sha1)
+        {
+            unpackSucceeded = failWith(
+                errorMessage,
+                QStringLiteral("Hub archive entry failed its checksum: %1").arg(entryPath));
+            break;
+        }
+        if (!outputFile.flush())
+        {
+            unpackSucceeded = failWith(errorMessage, QStringLiteral("Failed to write hub file: %1").arg(outputPath));
+            break;
+        }
+        outputFile.setFileTime(
+            QDateTime::fromMSecsSinceEpoch(entry->modifiedMsecsSinceEpoch),
+            QFileDevice::FileModificationTime);
+        outputFile.close();
+    }
+    archive.close();
+
+    if (!unpackSucceeded)
+    {
+        QDir(partialPath).removeRecursively();
+        return false;
+    }
+
+    QDir(targetPath).removeRecursively();
+    if (!QDir().rename(partialPath, targetPath))
+    {
+        QDir(partialPath).removeRecursively();
+        return failWith(errorMessage, QStringLiteral("Failed to finalize hub directory: %1").arg(targetPath));
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.archive.converter"),
+        QStringLiteral("unpackArchive.success"),
+        QStringLiteral("target=%1").arg(targetPath));
+    return true;
+}
+
+bool WhatSonHubArchiveConverter::materializeForMount(
+    const QString& archivePath,
+    QString* outHubDirectoryPath,
+    QString* errorMessage) const
+{
+    const QString normalizedArchivePath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    if (!WhatSonHubArchive::isPackedArchive(normalizedArchivePath))
+    {
+        return failWith(
+            errorMessage,
+            QStringLiteral("Not a packed WhatSon Hub archive: %1").arg(normalizedArchivePath));
+    }
+
+    QMutexLocker maintenanceLocker(&archiveMaintenanceMutex());
+    const QString stagingPath = mountStagingPath(normalizedArchivePath);
+    const MountStamp stamp = readMountStamp(QDir(stagingPath).filePath(kMountStampRelativePath));
+    const bool staged = QFileInfo(stagingPath).isDir() && !stamp.archiveStamp.isEmpty();
+    // A staging copy the archive no longer matches is only dropped when it holds nothing the archive lacks. Edits
+    // left by a session that did not write back are kept and mounted; writeBackStaging() carries them over later.
+    if (!staged || stamp.archiveStamp != archiveStamp(normalizedArchivePath))
+    {
+        if (staged && stamp.stagingSignature != stagingSignature(stagingPath))
+        {
+            return failWith(
+                errorMessage,
+                QStringLiteral("Packed hub changed on disk while its mounted copy holds unsaved edits: %1")
+                    .arg(stagingPath));
+        }
+
+        QDir(stagingPath).removeRecursively();
+        if (!unpackArchive(normalizedArchivePath, stagingPath, errorMessage)
+            || !writeMountStamp(stagingPath, normalizedArchivePath, errorMessage))
+        {
+            return false;
+        }
+    }
+
+    {
+        QMutexLocker locker(&mountedArchivesMutex());
+        mountedArchives().insert(normalizedArchivePath);
+    }
+    if (outHubDirectoryPath != nullptr)
+    {
+        *outHubDirectoryPath = stagingPath;
+    }
+    return true;
+}
+
+bool WhatSonHubArchiveConverter::writeBackStaging(
+    const QString& archivePath,
+    QString* errorMessage,
+    const bool queueCompaction) const
+{
+    const QString normalizedArchivePath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    QMutexLocker maintenanceLocker(&archiveMaintenanceMutex());
+    const QString stagingPath = mountStagingPath(normalizedArchivePath);
+    const MountStamp stamp = readMountStamp(QDir(stagingPath).filePath(kMountStampRelativePath));
+    if (!QFileInfo(stagingPath).isDir() || stamp.archiveStamp.isEmpty())
+    {
+        return true;
+    }
+    // Taken before anything is copied: a file edited while the write-back runs no longer matches it and is carried
+    // over by the next write-back instead of being recorded as saved.
+    const QByteArray writeBackSignature = stagingSignature(stagingPath);
+    if (stamp.stagingSignature == writeBackSignature)
+    {
+        return true;
+    }
+    if (stamp.archiveStamp != archiveStamp(normalizedArchivePath))
+    {
+        return failWith(
+            errorMessage,
+            QStringLiteral("Packed hub changed on disk since it was mounted; staged edits are kept at %1")
+                .arg(stagingPath));
+    }
+
+    const QDir stagingDirectory(stagingPath);
+    const QStringList relativePaths = stagedRelativePaths(stagingPath);
+    int writtenCount = 0;
+    int removedCount = 0;
+    bool needsCompaction = false;
+    {
+        WhatSonHubArchive archive;
+        if (!archive.open(normalizedArchivePath, errorMessage))
+        {
+            return false;
+        }
+
+        const QSet<QString> stagedPaths(relativePaths.cbegin(), relativePaths.cend());
+        const QStringList archivedPaths = archive.entryPaths();
+        for (const QString& entryPath : archivedPaths)
+        {
+            if (!stagedPaths.contains(entryPath) && archive.contains(entryPath))
+            {
+                if (!archive.removeEntry(entryPath, errorMessage))
+                {
+                    return false;
+                }
+                ++removedCount;
+            }
+        }
+
+        for (const QString& relativePath : relativePaths)
+        {
+            const QFileInfo info(stagingDirectory.filePath(relativePath));
+            const qint64 modifiedMsecs = info.lastModified().toMSecsSinceEpoch();
+            const WhatSonHubArchiveEntry* entry = archive.entry(relativePath);
+            if (info.isDir())
+            {
+                if (entry == nullptr || !entry->directory)
+                {
+                    if (!archive.writeDirectory(relativePath, modifiedMsecs, errorMessage))
+                    {
+                        return false;
+                    }
+                    ++writtenCount;
+                }
+                continue;
+            }
+            if (entry != nullptr && !entry->directory && entry->size == info.size()
+                && entry->modifiedMsecsSinceEpoch == modifiedMsecs)
+            {
+                continue;
+            }
+
+            QFile stagedFile(info.absoluteFilePath());
+            if (!stagedFile.open(QIODevice::ReadOnly))
+            {
+                return failWith(errorMessage, QStringLiteral("Failed to read staged hub file: %1").arg(info.absoluteFilePath()));
+            }
+            if (!archive.writeFileFromDevice(relativePath, &stagedFile, modifiedMsecs, errorMessage))
+            {
+                return false;
+            }
+            ++writtenCount;
+        }
+
+        if (!archive.flush(errorMessage))
+        {
+            return false;
+        }
+        needsCompaction = archive.needsCompaction();
+    }
+
+    if (!writeMountStamp(stagingPath, normalizedArchivePath, writeBackSignature, errorMessage))
+    {
+        return false;
+    }
+    maintenanceLocker.unlock();
+    if (needsCompaction && queueCompaction)
+    {
+        compactInBackground(normalizedArchivePath);
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.archive.converter"),
+        QStringLiteral("writeBackStaging.success"),
+        QStringLiteral("archive=%1 written=%2 removed=%3 compactionQueued=%4")
+            .arg(normalizedArchivePath)
+            .arg(writtenCount)
+            .arg(removedCount)
+            .arg(needsCompaction && queueCompaction ? QStringLiteral("1") : QStringLiteral("0")));
+    return true;
+}
+
+bool WhatSonHubArchiveConverter::stagingHasUnsavedChanges(const QString& archivePath)
+{
+    const QString stagingPath = mountStagingPath(archivePath);
+    const MountStamp stamp = readMountStamp(QDir(stagingPath).filePath(kMountStampRelativePath));
+    return QFileInfo(stagingPath).isDir() && !stamp.archiveStamp.isEmpty()
+        && stamp.stagingSignature != stagingSignature(stagingPath);
+}
+
+bool WhatSonHubArchiveConverter::writeBackMountedArchives(QString* errorMessage, const bool queueCompaction)
+{
+    QStringList archivePaths;
+    {
+        QMutexLocker locker(&mountedArchivesMutex());
+        archivePaths = QStringList(mountedArchives().cbegin(), mountedArchives().cend());
+    }
+    std::sort(archivePaths.begin(), archivePaths.end());
+
+    const WhatSonHubArchiveConverter converter;
+    bool succeeded = true;
+    for (const QString& archivePath : std::as_const(archivePaths))
+    {
+        QString writeBackError;
+        if (!converter.writeBackStaging(archivePath, &writeBackError, queueCompaction))
+        {
+            succeeded = false;
+            if (errorMessage != nullptr && errorMessage->isEmpty())
+            {
+                *errorMessage = writeBackError;
+            }
+        }
+    }
+    return succeeded;
+}
+
+void WhatSonHubArchiveConverter::writeBackMountedArchivesInBackground()
+{
+    static std::atomic_bool writeBackQueued = false;
+    if (writeBackQueued.exchange(true))
+    {
+        return;
+    }
+    archiveMaintenancePool().start(
+        []()
+        {
+            writeBackQueued = false;
+            QString errorMessage;
+            if (!writeBackMountedArchives(&errorMessage))
+            {
+                WhatSon::Debug::trace(
+                    QStringLiteral("hub.archive.converter"),
+                    QStringLiteral("writeBackInBackground.failed"),
+                    QStringLiteral("reason=%1").arg(errorMessage));
+            }
+        });
+}
+
+void WhatSonHubArchiveConverter::compactInBackground(const QString& archivePath)
+{
+    const QString normalizedArchivePath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    archiveMaintenancePool().start(
+        [normalizedArchivePath]()
+        {
+            QString errorMessage;
+            if (!compactAndRestamp(normalizedArchivePath, &errorMessage))
+            {
+                WhatSon::Debug::trace(
+                    QStringLiteral("hub.archive.converter"),
+                    QStringLiteral("compactInBackground.failed"),
+                    QStringLiteral("archive=%1 reason=%2").arg(normalizedArchivePath, errorMessage));
+            }
+        });
+}
+
+void WhatSonHubArchiveConverter::waitForBackgroundMaintenance()
+{
+    archiveMaintenancePool().waitForDone();
+}
+
+QString WhatSonHubArchiveConverter::mountStagingPath(const QString& archivePath)
+{
+    const QString normalizedArchivePath = WhatSon::HubPath::normalizeAbsolutePath(archivePath);
+    const QByteArray pathHash = QCryptographicHash::hash(
+        normalizedArchivePath.toUtf8(),
+        QCryptographicHash::Sha1).toHex().left(16);
+    // App data, not temp: staged edits must survive a reboot until they are written back.
+    QString stagingRoot = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    if (stagingRoot.isEmpty())
+    {
+        stagingRoot = QDir::homePath() + QStringLiteral("/.whatson");
+    }
+    return QDir::cleanPath(QDir(stagingRoot).filePath(
+        QStringLiteral("packed-hubs/%1/%2").arg(
+            QString::fromLatin1(pathHash),
+            QFileInfo(normalizedArchivePath).fileName())));
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QString>
+
+class WhatSonHubArchiveConverter final
+{
+public:
+    bool packDirectory(
+        const QString& hubDirectoryPath,
+        const QString& archivePath,
+        bool replaceExisting = false,
+        QString* errorMessage = nullptr) const;
+    bool unpackArchive(
+        const QString& archivePath,
+        const QString& hubDirectoryPath,
+        QString* errorMessage = nullptr) const;
+    // Packed hubs are mounted from a staging copy under the app data location. The staging copy is only replaced when
+    // the archive changed on disk and the copy holds no unsaved edits; edits are carried back by writeBackStaging().
+    bool materializeForMount(
+        const QString& archivePath,
+        QString* outHubDirectoryPath,
+        QString* errorMessage = nullptr) const;
+    // Appends the staged files that differ from the archive index, removes deleted entries and, when superseded
+    // segments dominate and queueCompaction is set, queues compactInBackground(). A clean staging copy is a no-op.
+    bool writeBackStaging(
+        const QString& archivePath,
+        QString* errorMessage = nullptr,
+        bool queueCompaction = true) const;
+
+    static bool stagingHasUnsavedChanges(const QString& archivePath);
+    // Writes back every archive materialised by this process. The app calls it synchronously only at quit, without
+    // compaction; while running it uses writeBackMountedArchivesInBackground().
+    static bool writeBackMountedArchives(QString* errorMessage = nullptr, bool queueCompaction = true);
+    static void writeBackMountedArchivesInBackground();
+    // Rewrites the archive without superseded segments on the maintenance thread, entry by entry.
+    static void compactInBackground(const QString& archivePath);
+    static void waitForBackgroundMaintenance();
+    static QString mountStagingPath(const QString& archivePath);
+};
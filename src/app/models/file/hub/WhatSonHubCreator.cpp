@@ -2,6 +2,7 @@
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/hub/WhatSonHubStat.hpp"
 
 #include <QDateTime>
 #include <QDir>
@@ -289,6 +290,57 @@ QString WhatSonHubCreator::hubDirectoryPath(const QString& hubName) const
     return joinPath(basePath, sanitizeHubName(hubName) + packageExtension());
 }
 
+QString WhatSonHubCreator::defaultEntryText(const QString& entryFileName) const
+{
+    if (entryFileName == QStringLiteral("index.wsnindex"))
+    {
+        return QStringLiteral(
+            "{\n  \"version\": 1,\n  \"schema\": \"whatson.library.index\",\n  \"notes\": []\n}\n");
+    }
+    if (entryFileName == QStringLiteral("Tags.wstags"))
+    {
+        return QStringLiteral(
+            "{\n  \"version\": 1,\n  \"schema\": \"whatson.tags.depth\",\n  \"tags\": []\n}\n");
+    }
+    if (entryFileName == QStringLiteral("Folders.wsfolders"))
+    {
+        return QStringLiteral(
+            "{\n  \"version\": 1,\n  \"schema\": \"whatson.folders.tree\",\n  \"folders\": []\n}\n");
+    }
+    if (entryFileName == QStringLiteral("Bookmarks.wsbookmarks"))
+    {
+        return QStringLiteral(
+            "{\n  \"version\": 1,\n  \"schema\": \"whatson.bookmarks.list\",\n  \"bookmarks\": []\n}\n");
+    }
+    if (entryFileName == QStringLiteral("Progress.wsprogress"))
+    {
+        return QStringLiteral(
+            "{\n  \"version\": 1,\n  \"schema\": \"whatson.progress.state\",\n  \"value\": 0,\n  \"states\": [\"Ready\", \"Pending\", \"InProgress\", \"Done\"]\n}\n");
+    }
+    if (entryFileName == QStringLiteral("ProjectLists.wsproj"))
+    {
+        return QStringLiteral(
+            "{\n  \"version\": 1,\n  \"schema\": \"whatson.projects.list\",\n  \"projects\": []\n}\n");
+    }
+    return {};
+}
+
+QJsonObject WhatSonHubCreator::defaultStatObject(const QString& hubName, const QString& timestampUtc) const
+{
+    QJsonObject statRoot;
+    statRoot.insert(QStringLiteral("version"), 1);
+    statRoot.insert(QStringLiteral("schema"), QStringLiteral("whatson.hub.stat"));
+    statRoot.insert(QStringLiteral("hub"), sanitizeHubName(hubName));
+    statRoot.insert(WhatSonHubStat::noteCountKeys().first(), 0);
+    statRoot.insert(WhatSonHubStat::resourceCountKeys().first(), 0);
+    statRoot.insert(WhatSonHubStat::characterCountKeys().first(), 0);
+    statRoot.insert(QStringLiteral("createdAtUtc"), timestampUtc);
+    statRoot.insert(QStringLiteral("lastModifiedAtUtc"), timestampUtc);
+    statRoot.insert(QStringLiteral("participants"), QJsonArray{});
+    statRoot.insert(QStringLiteral("profileLastModifiedAtUtc"), QJsonObject{});
+    return statRoot;
+}
+
 bool WhatSonHubCreator::createHubScaffold(
     const QString& hubRootPath,
     const QString& hubName,
@@ -347,21 +399,8 @@ bool WhatSonHubCreator::createHubScaffold(
     }
 
     const QString statPath = joinPath(hubRootPath, statFileName);
-
-    QJsonObject statRoot;
-    statRoot.insert(QStringLiteral("version"), 1);
-    statRoot.insert(QStringLiteral("schema"), QStringLiteral("whatson.hub.stat"));
-    statRoot.insert(QStringLiteral("hub"), sanitizedHubName);
-    statRoot.insert(QStringLiteral("noteCount"), 0);
-    statRoot.insert(QStringLiteral("resourceCount"), 0);
-    statRoot.insert(QStringLiteral("characterCount"), 0);
-    statRoot.insert(QStringLiteral("createdAtUtc"), now);
-    statRoot.insert(QStringLiteral("lastModifiedAtUtc"), now);
-    statRoot.insert(QStringLiteral("participants"), QJsonArray{});
-    statRoot.insert(QStringLiteral("profileLastModifiedAtUtc"), QJsonObject{});
-
     const QString statText = QString::fromUtf8(
-        QJsonDocument(statRoot).toJson(QJsonDocument::Indented));
+        QJsonDocument(defaultStatObject(sanitizedHubName, now)).toJson(QJsonDocument::Indented));
     if (!writeTextFile(statPath, statText, errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
@@ -372,9 +411,7 @@ bool WhatSonHubCreator::createHubScaffold(
     }
 
     const QString indexPath = joinPath(hubRootPath, joinPath(libraryRoot, QStringLiteral("index.wsnindex")));
-    const QString indexText = QStringLiteral(
-        "{\n  \"version\": 1,\n  \"schema\": \"whatson.library.index\",\n  \"notes\": []\n}\n");
-    if (!writeTextFile(indexPath, indexText, errorMessage))
+    if (!writeTextFile(indexPath, defaultEntryText(QStringLiteral("index.wsnindex")), errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("hub.creator"),
@@ -384,9 +421,7 @@ bool WhatSonHubCreator::createHubScaffold(
     }
 
     const QString tagsPath = joinPath(hubRootPath, joinPath(contentsDirectory, QStringLiteral("Tags.wstags")));
-    const QString tagsText = QStringLiteral(
-        "{\n  \"version\": 1,\n  \"schema\": \"whatson.tags.depth\",\n  \"tags\": []\n}\n");
-    if (!writeTextFile(tagsPath, tagsText, errorMessage))
+    if (!writeTextFile(tagsPath, defaultEntryText(QStringLiteral("Tags.wstags")), errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("hub.creator"),
@@ -398,9 +433,7 @@ bool WhatSonHubCreator::createHubScaffold(
     const QString foldersPath = joinPath(
         hubRootPath,
         joinPath(contentsDirectory, QStringLiteral("Folders.wsfolders")));
-    const QString foldersText =
-        QStringLiteral("{\n  \"version\": 1,\n  \"schema\": \"whatson.folders.tree\",\n  \"folders\": []\n}\n");
-    if (!writeTextFile(foldersPath, foldersText, errorMessage))
+    if (!writeTextFile(foldersPath, defaultEntryText(QStringLiteral("Folders.wsfolders")), errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("hub.creator"),
@@ -412,9 +445,7 @@ bool WhatSonHubCreator::createHubScaffold(
     const QString bookmarksPath = joinPath(
         hubRootPath,
         joinPath(contentsDirectory, QStringLiteral("Bookmarks.wsbookmarks")));
-    const QString bookmarksText =
-        QStringLiteral("{\n  \"version\": 1,\n  \"schema\": \"whatson.bookmarks.list\",\n  \"bookmarks\": []\n}\n");
-    if (!writeTextFile(bookmarksPath, bookmarksText, errorMessage))
+    if (!writeTextFile(bookmarksPath, defaultEntryText(QStringLiteral("Bookmarks.wsbookmarks")), errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("hub.creator"),
@@ -426,10 +457,7 @@ bool WhatSonHubCreator::createHubScaffold(
     const QString progressPath = joinPath(
         hubRootPath,
         joinPath(contentsDirectory, QStringLiteral("Progress.wsprogress")));
-    const QString progressText =
-        QStringLiteral(
-            "{\n  \"version\": 1,\n  \"schema\": \"whatson.progress.state\",\n  \"value\": 0,\n  \"states\": [\"Ready\", \"Pending\", \"InProgress\", \"Done\"]\n}\n");
-    if (!writeTextFile(progressPath, progressText, errorMessage))
+    if (!writeTextFile(progressPath, defaultEntryText(QStringLiteral("Progress.wsprogress")), errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("hub.creator"),
@@ -441,10 +469,7 @@ bool WhatSonHubCreator::createHubScaffold(
     const QString projectListsPath = joinPath(
         hubRootPath,
         joinPath(contentsDirectory, QStringLiteral("ProjectLists.wsproj")));
-    if (!writeTextFile(
-        projectListsPath,
-        QStringLiteral("{\n  \"version\": 1,\n  \"schema\": \"whatson.projects.list\",\n  \"projects\": []\n}\n"),
-        errorMessage))
+    if (!writeTextFile(projectListsPath, defaultEntryText(QStringLiteral("ProjectLists.wsproj")), errorMessage))
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("hub.creator"),
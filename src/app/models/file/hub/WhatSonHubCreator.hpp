@@ -2,6 +2,7 @@
 
 #include "app/models/file/hub/WhatSonHubPackager.hpp"
 
+#include <QJsonObject>
 #include <QString>
 #include <QStringList>
 
@@ -41,6 +42,10 @@ public:
     QString hubResourcesDirectoryName(const QString& hubName) const;
     QString hubStatFileName(const QString& hubName) const;
 
+    // Default contents of a fresh hub's domain files (Folders.wsfolders, index.wsnindex, ...); empty for unknown names.
+    QString defaultEntryText(const QString& entryFileName) const;
+    QJsonObject defaultStatObject(const QString& hubName, const QString& timestampUtc) const;
+
 protected:
     QString sanitizeHubName(const QString& hubName) const;
     QString joinPath(const QString& left, const QString& right) const;
@@ -0,0 +1,327 @@
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <utility>
+
+namespace
+{
+    struct LayoutCache final
+    {
+        QMutex mutex;
+        QHash<QString, std::shared_ptr<const WhatSonHubLayout>> layoutsByHubPath;
+    };
+
+    LayoutCache& layoutCache()
+    {
+        static LayoutCache cache;
+        return cache;
+    }
+
+    QString layoutKey(const QString& path)
+    {
+        const QString normalizedPath = WhatSon::HubPath::normalizeAbsolutePath(path);
+        return WhatSon::HubPath::isNonLocalUrl(normalizedPath) ? QString() : normalizedPath;
+    }
+
+    // Mirrors the QDir "*.suffix" name filter the probing code used: case-insensitive and hidden entries excluded.
+    bool matchesDynamicName(const QString& fileName, const QString& suffix)
+    {
+        return !fileName.startsWith(QLatin1Char('.')) && fileName.endsWith(suffix, Qt::CaseInsensitive);
+    }
+
+    bool isInsideOrEqual(const QString& path, const QString& rootPath)
+    {
+        return path == rootPath
+            || (path.startsWith(rootPath) && path.at(rootPath.size()) == QLatin1Char('/'));
+    }
+
+    qint64 directoryStamp(const QFileInfo& info)
+    {
+        return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+    }
+
+    WhatSonHubLayout::EntryKind entryKindOf(const QFileInfo& info)
+    {
+        if (info.isDir())
+        {
+            return WhatSonHubLayout::EntryKind::Directory;
+        }
+        return info.isFile() ? WhatSonHubLayout::EntryKind::File : WhatSonHubLayout::EntryKind::Missing;
+    }
+} // namespace
+
+WhatSonHubLayout WhatSonHubLayout::resolve(const QString& hubPath)
+{
+    WhatSonHubLayout layout;
+    layout.hubPath = layoutKey(hubPath);
+    if (layout.hubPath.isEmpty())
+    {
+        return layout;
+    }
+
+    const QFileInfo hubInfo(layout.hubPath);
+    ++layout.filesystemProbeCount;
+    layout.hubExists = hubInfo.exists();
+    layout.hubIsDirectory = hubInfo.isDir();
+    layout.directoryStamps.push_back(directoryStamp(hubInfo));
+    if (!layout.hubIsDirectory)
+    {
+        return layout;
+    }
+
+    const QDir hubDirectory(layout.hubPath);
+    const QFileInfoList hubEntries = hubDirectory.entryInfoList(
+        QDir::Dirs | QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+        QDir::Name);
+    ++layout.filesystemProbeCount;
+
+    QString fixedContentsPath;
+    QString fixedResourcesPath;
+    QStringList dynamicContentsPaths;
+    QStringList dynamicResourcesPaths;
+    for (const QFileInfo& entryInfo : hubEntries)
+    {
+        const QString childName = entryInfo.fileName();
+        const QString childPath = WhatSon::HubPath::joinPath(layout.hubPath, childName);
+        if (entryInfo.isDir())
+        {
+            if (childName == QStringLiteral(".wscontents"))
+            {
+                fixedContentsPath = childPath;
+            }
+            else if (matchesDynamicName(childName, QStringLiteral(".wscontents")))
+            {
+                dynamicContentsPaths.push_back(childPath);
+            }
+            else if (childName == QStringLiteral(".wsresources"))
+            {
+                fixedResourcesPath = childPath;
+            }
+            else if (matchesDynamicName(childName, QStringLiteral(".wsresources")))
+            {
+                dynamicResourcesPaths.push_back(childPath);
+            }
+        }
+        else if (entryInfo.isFile() && matchesDynamicName(childName, QStringLiteral(".wsstat")))
+        {
+            layout.statPaths.push_back(childPath);
+        }
+    }
+
+    if (!fixedContentsPath.isEmpty())
+    {
+        layout.contentsDirectories.push_back(fixedContentsPath);
+    }
+    layout.contentsDirectories += dynamicContentsPaths;
+    layout.contentsDirectories.removeDuplicates();
+    layout.contentsPath = layout.contentsDirectories.value(0);
+    layout.resourcesPath = !fixedResourcesPath.isEmpty() ? fixedResourcesPath : dynamicResourcesPaths.value(0);
+
+    for (const QString& contentsDirectoryPath : std::as_const(layout.contentsDirectories))
+    {
+        const bool primaryContents = contentsDirectoryPath == layout.contentsPath;
+        layout.directoryStamps.push_back(directoryStamp(QFileInfo(contentsDirectoryPath)));
+        const QFileInfoList contentsEntries = QDir(contentsDirectoryPath).entryInfoList(
+            QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot,
+            QDir::Name);
+        ++layout.filesystemProbeCount;
+
+        QString fixedLibraryPath;
+        QStringList dynamicLibraryPaths;
+        for (const QFileInfo& entryInfo : contentsEntries)
+        {
+            const QString childName = entryInfo.fileName();
+            if (entryInfo.isDir() && childName == QStringLiteral("Library.wslibrary"))
+            {
+                fixedLibraryPath = WhatSon::HubPath::joinPath(contentsDirectoryPath, childName);
+            }
+            else if (entryInfo.isDir() && matchesDynamicName(childName, QStringLiteral(".wslibrary")))
+            {
+                dynamicLibraryPaths.push_back(WhatSon::HubPath::joinPath(contentsDirectoryPath, childName));
+            }
+
+            if (!primaryContents)
+            {
+                continue;
+            }
+            for (int index = 0; index < static_cast<int>(Entry::LibraryIndex); ++index)
+            {
+                if (childName == entryName(static_cast<Entry>(index)))
+                {
+                    layout.entryKinds[static_cast<std::size_t>(index)] = entryKindOf(entryInfo);
+                }
+            }
+        }
+
+        if (!fixedLibraryPath.isEmpty())
+        {
+            layout.libraryRoots.push_back(fixedLibraryPath);
+        }
+        layout.libraryRoots += dynamicLibraryPaths;
+        if (primaryContents)
+        {
+            layout.libraryPath = !fixedLibraryPath.isEmpty() ? fixedLibraryPath : dynamicLibraryPaths.value(0);
+        }
+    }
+    layout.libraryRoots.removeDuplicates();
+
+    if (!layout.libraryPath.isEmpty())
+    {
+        // The library directory holds every note package, so its index is probed instead of listing it.
+        const QFileInfo indexInfo(layout.entryPath(Entry::LibraryIndex));
+        ++layout.filesystemProbeCount;
+        layout.entryKinds[static_cast<std::size_t>(Entry::LibraryIndex)] = entryKindOf(indexInfo);
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.layout"),
+        QStringLiteral("resolve"),
+        QStringLiteral("hub=%1 contents=%2 library=%3 resources=%4 probes=%5")
+        .arg(layout.hubPath, layout.contentsPath, layout.libraryPath, layout.resourcesPath)
+        .arg(layout.filesystemProbeCount));
+    return layout;
+}
+
+std::shared_ptr<const WhatSonHubLayout> WhatSonHubLayout::cached(const QString& hubPath)
+{
+    const QString key = layoutKey(hubPath);
+    LayoutCache& cache = layoutCache();
+    {
+        QMutexLocker locker(&cache.mutex);
+        const auto existing = cache.layoutsByHubPath.constFind(key);
+        if (existing != cache.layoutsByHubPath.constEnd() && existing.value()->isCurrent())
+        {
+            return existing.value();
+        }
+    }
+
+    auto layout = std::make_shared<const WhatSonHubLayout>(resolve(key));
+    if (!layout->hubIsDirectory)
+    {
+        // A hub that does not exist yet is never cached; creating it must not require an invalidation.
+        return layout;
+    }
+
+    QMutexLocker locker(&cache.mutex);
+    cache.layoutsByHubPath.insert(key, layout);
+    return layout;
+}
+
+std::shared_ptr<const WhatSonHubLayout> WhatSonHubLayout::refresh(const QString& hubPath)
+{
+    const QString key = layoutKey(hubPath);
+    {
+        LayoutCache& cache = layoutCache();
+        QMutexLocker locker(&cache.mutex);
+        cache.layoutsByHubPath.remove(key);
+    }
+    return cached(key);
+}
+
+void WhatSonHubLayout::invalidate(const QString& changedPath)
+{
+    const QString changedKey = layoutKey(changedPath);
+    if (changedKey.isEmpty())
+    {
+        return;
+    }
+
+    LayoutCache& cache = layoutCache();
+    QMutexLocker locker(&cache.mutex);
+    for (auto it = cache.layoutsByHubPath.begin(); it != cache.layoutsByHubPath.end();)
+    {
+        if (isInsideOrEqual(changedKey, it.key()) || isInsideOrEqual(it.key(), changedKey))
+        {
+            it = cache.layoutsByHubPath.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+void WhatSonHubLayout::clearCache()
+{
+    LayoutCache& cache = layoutCache();
+    QMutexLocker locker(&cache.mutex);
+    cache.layoutsByHubPath.clear();
+}
+
+bool WhatSonHubLayout::isCurrent() const
+{
+    if (directoryStamps.isEmpty() || directoryStamps.constFirst() != directoryStamp(QFileInfo(hubPath)))
+    {
+        return false;
+    }
+    for (int index = 0; index < contentsDirectories.size() && index + 1 < directoryStamps.size(); ++index)
+    {
+        if (directoryStamps.at(index + 1) != directoryStamp(QFileInfo(contentsDirectories.at(index))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString WhatSonHubLayout::entryName(const Entry entry)
+{
+    switch (entry)
+    {
+    case Entry::Folders:
+        return QStringLiteral("Folders.wsfolders");
+    case Entry::ProjectLists:
+        return QStringLiteral("ProjectLists.wsproj");
+    case Entry::Bookmarks:
+        return QStringLiteral("Bookmarks.wsbookmarks");
+    case Entry::Tags:
+        return QStringLiteral("Tags.wstags");
+    case Entry::Progress:
+        return QStringLiteral("Progress.wsprogress");
+    case Entry::Preset:
+        return QStringLiteral("Preset.wspreset");
+    case Entry::LibraryIndex:
+        return QStringLiteral("index.wsnindex");
+    }
+    return {};
+}
+
+QString WhatSonHubLayout::entryPath(const Entry entry) const
+{
+    const QString& basePath = entry == Entry::LibraryIndex ? libraryPath : contentsPath;
+    return basePath.isEmpty() ? QString() : WhatSon::HubPath::joinPath(basePath, entryName(entry));
+}
+
+WhatSonHubLayout::EntryKind WhatSonHubLayout::entryKind(const Entry entry) const noexcept
+{
+    return entryKinds[static_cast<std::size_t>(entry)];
+}
+
+bool WhatSonHubLayout::entryMatches(const Entry entry) const noexcept
+{
+    const EntryKind kind = entryKind(entry);
+    return kind == EntryKind::File || (entry == Entry::Preset && kind == EntryKind::Directory);
+}
+
+QString WhatSonHubLayout::preferredStatPath(const QString& hubName) const
+{
+    if (!hubName.isEmpty())
+    {
+        const QString preferredFileName = hubName + QStringLiteral("Stat.wsstat");
+        for (const QString& statPath : statPaths)
+        {
+            if (QFileInfo(statPath).fileName() == preferredFileName)
+            {
+                return statPath;
+            }
+        }
+    }
+    return statPaths.value(0);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <array>
+#include <memory>
+
+// On-disk layout of one unpacked .wshub: its contents, library and resources directories, stat files and the
+// required entries of the mount contract. resolve() lists the hub root and each contents directory once and probes
+// only the library index, so mount, parse and domain loads share one discovery pass instead of re-probing it.
+// cached() keeps one immutable layout per hub path. A hit costs one modification-time probe of the hub and each
+// contents directory instead of a rescan; the sync watcher invalidates on directory changes and mount validation
+// always refreshes, so the required-entry states are never older than the last mount.
+struct WhatSonHubLayout final
+{
+    enum class Entry
+    {
+        Folders,
+        ProjectLists,
+        Bookmarks,
+        Tags,
+        Progress,
+        Preset,
+        LibraryIndex
+    };
+
+    enum class EntryKind
+    {
+        Missing,
+        File,
+        Directory
+    };
+
+    static constexpr int kEntryCount = 7;
+
+    QString hubPath;
+    bool hubExists = false;
+    bool hubIsDirectory = false;
+    QStringList contentsDirectories;
+    QString contentsPath;
+    QStringList libraryRoots;
+    QString libraryPath;
+    QString resourcesPath;
+    QStringList statPaths;
+    std::array<EntryKind, kEntryCount> entryKinds{};
+    QVector<qint64> directoryStamps;
+    int filesystemProbeCount = 0;
+
+    static WhatSonHubLayout resolve(const QString& hubPath);
+    static std::shared_ptr<const WhatSonHubLayout> cached(const QString& hubPath);
+    static std::shared_ptr<const WhatSonHubLayout> refresh(const QString& hubPath);
+    static void invalidate(const QString& changedPath);
+    static void clearCache();
+
+    // True while the hub and its contents directories keep the modification times seen by resolve().
+    bool isCurrent() const;
+
+    static QString entryName(Entry entry);
+    QString entryPath(Entry entry) const;
+    EntryKind entryKind(Entry entry) const noexcept;
+    bool entryMatches(Entry entry) const noexcept;
+
+    // Prefers <hubName>Stat.wsstat, then the first *.wsstat by name.
+    QString preferredStatPath(const QString& hubName = {}) const;
+};
@@ -1,9 +1,11 @@
 #include "app/models/file/hub/WhatSonHubMountValidator.hpp"
 
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 #include "app/platform/Apple/AppleSecurityScopedResourceAccess.hpp"
 
-#include <QDir>
 #include <QFileInfo>
 
 namespace
@@ -13,76 +15,6 @@ namespace
         return WhatSon::HubPath::normalizeAbsolutePath(path);
     }
 
-    QString resolvePrimaryDirectoryEntry(
-        const QDir& baseDirectory,
-        const QString& fixedName,
-        const QString& dynamicPattern)
-    {
-        const QString fixedPath = normalizeAbsolutePath(baseDirectory.filePath(fixedName));
-        if (!fixedPath.isEmpty() && QFileInfo(fixedPath).isDir())
-        {
-            return fixedPath;
-        }
-
-        const QStringList dynamicEntries = baseDirectory.entryList(
-            QStringList{dynamicPattern},
-            QDir::Dirs | QDir::NoDotAndDotDot,
-            QDir::Name);
-        if (dynamicEntries.isEmpty())
-        {
-            return {};
-        }
-
-        return normalizeAbsolutePath(baseDirectory.filePath(dynamicEntries.constFirst()));
-    }
-
-    QString resolvePrimaryFileEntry(const QDir& baseDirectory, const QStringList& nameFilters)
-    {
-        const QStringList entries = baseDirectory.entryList(
-            nameFilters,
-            QDir::Files | QDir::NoDotAndDotDot,
-            QDir::Name);
-        if (entries.isEmpty())
-        {
-            return {};
-        }
-
-        return normalizeAbsolutePath(baseDirectory.filePath(entries.constFirst()));
-    }
-
-    bool requireEntryPath(
-        const QString& basePath,
-        const QString& entryName,
-        const bool allowDirectory,
-        const bool allowFile,
-        QString* errorMessage)
-    {
-        const QString absoluteEntryPath = normalizeAbsolutePath(QDir(basePath).filePath(entryName));
-        const QFileInfo entryInfo(absoluteEntryPath);
-        if (!entryInfo.exists())
-        {
-            if (errorMessage != nullptr)
-            {
-                *errorMessage = QStringLiteral("Required hub entry is missing: %1").arg(absoluteEntryPath);
-            }
-            return false;
-        }
-        if (entryInfo.isDir() && allowDirectory)
-        {
-            return true;
-        }
-        if (entryInfo.isFile() && allowFile)
-        {
-            return true;
-        }
-
-        if (errorMessage != nullptr)
-        {
-            *errorMessage = QStringLiteral("Hub entry has an unexpected type: %1").arg(absoluteEntryPath);
-        }
-        return false;
-    }
-
     WhatSonHubMountValidation failedMountValidation(const QString& failureMessage)
     {
         WhatSonHubMountValidation validation;
@@ -145,71 +77,81 @@ WhatSonHubMountValidation WhatSonHubMountValidator::resolveMountedHub(
 #endif
 
     mountedHubPath = normalizeAbsolutePath(mountedHubPath);
-    const QFileInfo hubInfo(mountedHubPath);
-    if (!hubInfo.exists() || !hubInfo.isDir())
+    QString packedArchivePath;
+    if (WhatSonHubArchive::isPackedArchive(mountedHubPath))
+    {
+        if (!QFileInfo(mountedHubPath).fileName().endsWith(QStringLiteral(".wshub"), Qt::CaseInsensitive))
+        {
+            return failedMountValidation(
+                QStringLiteral("Resolved path is not a packed .wshub archive: %1").arg(mountedHubPath));
+        }
+
+        QString materializeError;
+        QString stagingHubPath;
+        if (!WhatSonHubArchiveConverter().materializeForMount(mountedHubPath, &stagingHubPath, &materializeError))
+        {
+            return failedMountValidation(materializeError);
+        }
+        packedArchivePath = mountedHubPath;
+        mountedHubPath = normalizeAbsolutePath(stagingHubPath);
+    }
+
+    const std::shared_ptr<const WhatSonHubLayout> layout = WhatSonHubLayout::refresh(mountedHubPath);
+    if (!layout->hubIsDirectory)
     {
         return failedMountValidation(
             QStringLiteral("Resolved WhatSon Hub directory does not exist: %1").arg(mountedHubPath));
     }
 
-    if (!hubInfo.fileName().endsWith(QStringLiteral(".wshub"), Qt::CaseInsensitive))
+    if (!QFileInfo(mountedHubPath).fileName().endsWith(QStringLiteral(".wshub"), Qt::CaseInsensitive))
     {
         return failedMountValidation(
             QStringLiteral("Resolved path is not a .wshub directory: %1").arg(mountedHubPath));
     }
 
-    const QDir hubDirectory(mountedHubPath);
-    const QString contentsPath = resolvePrimaryDirectoryEntry(
-        hubDirectory,
-        QStringLiteral(".wscontents"),
-        QStringLiteral("*.wscontents"));
-    if (contentsPath.isEmpty())
+    if (layout->contentsPath.isEmpty())
     {
         return failedMountValidation(
             QStringLiteral("No *.wscontents directory found inside hub: %1").arg(mountedHubPath));
     }
 
-    const QDir contentsDirectory(contentsPath);
-    const QString libraryPath = resolvePrimaryDirectoryEntry(
-        contentsDirectory,
-        QStringLiteral("Library.wslibrary"),
-        QStringLiteral("*.wslibrary"));
-    if (libraryPath.isEmpty())
+    if (layout->libraryPath.isEmpty())
     {
         return failedMountValidation(
-            QStringLiteral("Library.wslibrary directory is missing: %1").arg(contentsPath));
+            QStringLiteral("Library.wslibrary directory is missing: %1").arg(layout->contentsPath));
     }
 
-    const QString resourcesPath = resolvePrimaryDirectoryEntry(
-        hubDirectory,
-        QStringLiteral(".wsresources"),
-        QStringLiteral("*.wsresources"));
-    if (resourcesPath.isEmpty())
+    if (layout->resourcesPath.isEmpty())
     {
         return failedMountValidation(
             QStringLiteral("No *.wsresources directory found inside hub: %1").arg(mountedHubPath));
     }
 
-    if (resolvePrimaryFileEntry(hubDirectory, QStringList{QStringLiteral("*.wsstat")}).isEmpty())
+    if (layout->statPaths.isEmpty())
     {
         return failedMountValidation(
             QStringLiteral("No *.wsstat file found inside hub: %1").arg(mountedHubPath));
     }
 
-    QString entryError;
-    if (!requireEntryPath(contentsPath, QStringLiteral("Folders.wsfolders"), false, true, &entryError)
-        || !requireEntryPath(contentsPath, QStringLiteral("ProjectLists.wsproj"), false, true, &entryError)
-        || !requireEntryPath(contentsPath, QStringLiteral("Bookmarks.wsbookmarks"), false, true, &entryError)
-        || !requireEntryPath(contentsPath, QStringLiteral("Tags.wstags"), false, true, &entryError)
-        || !requireEntryPath(contentsPath, QStringLiteral("Progress.wsprogress"), false, true, &entryError)
-        || !requireEntryPath(contentsPath, QStringLiteral("Preset.wspreset"), true, true, &entryError)
-        || !requireEntryPath(libraryPath, QStringLiteral("index.wsnindex"), false, true, &entryError))
+    for (int index = 0; index < WhatSonHubLayout::kEntryCount; ++index)
     {
-        return failedMountValidation(entryError);
+        const auto entry = static_cast<WhatSonHubLayout::Entry>(index);
+        if (layout->entryKind(entry) == WhatSonHubLayout::EntryKind::Missing)
+        {
+            return failedMountValidation(
+                QStringLiteral("Required hub entry is missing: %1").arg(layout->entryPath(entry)));
+        }
+        if (!layout->entryMatches(entry))
+        {
+            return failedMountValidation(
+                QStringLiteral("Hub entry has an unexpected type: %1").arg(layout->entryPath(entry)));
+        }
     }
 
     WhatSonHubMountValidation validation;
     validation.mounted = true;
     validation.hubPath = mountedHubPath;
+    validation.packedArchivePath = packedArchivePath;
+    validation.layout = layout;
     return validation;
 }
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
+
 #include <QByteArray>
 #include <QString>
 
+#include <memory>
+
 struct WhatSonHubMountValidation final
 {
     bool mounted = false;
     QString hubPath;
+    QString packedArchivePath;
     QString failureMessage;
+    std::shared_ptr<const WhatSonHubLayout> layout;
 };
 
 class WhatSonHubMountValidator final
@@ -1,6 +1,9 @@
 #include "app/models/file/hub/WhatSonHubParser.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 #include "app/models/hierarchy/bookmarks/WhatSonBookmarksHierarchyParser.hpp"
 #include "app/models/hierarchy/bookmarks/WhatSonBookmarksHierarchyStore.hpp"
@@ -33,19 +36,6 @@
 
 namespace
 {
-    QString cleanIfExists(const QString& path)
-    {
-        if (path.trimmed().isEmpty())
-        {
-            return {};
-        }
-        if (!QFileInfo(path).exists())
-        {
-            return {};
-        }
-        return WhatSon::HubPath::normalizePath(path);
-    }
-
     QStringList sanitizeStringList(QStringList values)
     {
         QStringList sanitized;
@@ -114,7 +104,7 @@ bool WhatSonHubParser::parseFromWshub(
     }
     outStore->clear();
 
-    const QString normalized = normalizeHubPath(wshubPath);
+    QString normalized = normalizeHubPath(wshubPath);
     if (normalized.isEmpty())
     {
         if (errorMessage != nullptr)
@@ -123,9 +113,14 @@ bool WhatSonHubParser::parseFromWshub(
         }
         return false;
     }
+    if (WhatSonHubArchive::isPackedArchive(normalized)
+        && !WhatSonHubArchiveConverter().materializeForMount(normalized, &normalized, errorMessage))
+    {
+        return false;
+    }
 
-    const QFileInfo hubInfo(normalized);
-    if (!hubInfo.exists() || !hubInfo.isDir())
+    const std::shared_ptr<const WhatSonHubLayout> layout = WhatSonHubLayout::cached(normalized);
+    if (!layout->hubIsDirectory)
     {
         if (errorMessage != nullptr)
         {
@@ -133,6 +128,7 @@ bool WhatSonHubParser::parseFromWshub(
         }
         return false;
     }
+    const QFileInfo hubInfo(normalized);
     if (!hubInfo.fileName().endsWith(QStringLiteral(".wshub")))
     {
         if (errorMessage != nullptr)
@@ -143,12 +139,8 @@ bool WhatSonHubParser::parseFromWshub(
     }
 
     const QString hubName = hubInfo.completeBaseName().trimmed();
-    const QDir hubDir(normalized);
 
-    const QString contentsPath = resolvePrimaryDirectory(
-        hubDir,
-        QStringLiteral(".wscontents"),
-        QStringLiteral("*.wscontents"));
+    const QString contentsPath = layout->contentsPath;
     if (contentsPath.isEmpty())
     {
         if (errorMessage != nullptr)
@@ -158,20 +150,8 @@ bool WhatSonHubParser::parseFromWshub(
         return false;
     }
 
-    QString libraryPath = cleanIfExists(QDir(contentsPath).filePath(QStringLiteral("Library.wslibrary")));
+    const QString libraryPath = layout->libraryPath;
     if (libraryPath.isEmpty())
-    {
-        const QDir contentsDir(contentsPath);
-        const QStringList libraryCandidates = contentsDir.entryList(
-            QStringList{QStringLiteral("*.wslibrary")},
-            QDir::Dirs | QDir::NoDotAndDotDot,
-            QDir::Name);
-        if (!libraryCandidates.isEmpty())
-        {
-            libraryPath = WhatSon::HubPath::joinPath(contentsDir.path(), libraryCandidates.first());
-        }
-    }
-    if (libraryPath.isEmpty() || !QFileInfo(libraryPath).isDir())
     {
         if (errorMessage != nullptr)
         {
@@ -180,11 +160,8 @@ bool WhatSonHubParser::parseFromWshub(
         return false;
     }
 
-    const QString resourcesPath = resolvePrimaryDirectory(
-        hubDir,
-        QStringLiteral(".wsresources"),
-        QStringLiteral("*.wsresources"));
-    if (resourcesPath.isEmpty() || !QFileInfo(resourcesPath).isDir())
+    const QString resourcesPath = layout->resourcesPath;
+    if (resourcesPath.isEmpty())
     {
         if (errorMessage != nullptr)
         {
@@ -193,7 +170,7 @@ bool WhatSonHubParser::parseFromWshub(
         return false;
     }
 
-    const QString statPath = resolveStatPath(hubDir, hubName);
+    const QString statPath = layout->preferredStatPath(hubName);
     if (statPath.isEmpty())
     {
         if (errorMessage != nullptr)
@@ -204,13 +181,14 @@ bool WhatSonHubParser::parseFromWshub(
     }
 
     QString fileCheckError;
-    requireEntryPath(contentsPath, QStringLiteral("Folders.wsfolders"), false, true, &fileCheckError);
-    requireEntryPath(contentsPath, QStringLiteral("ProjectLists.wsproj"), false, true, &fileCheckError);
-    requireEntryPath(contentsPath, QStringLiteral("Bookmarks.wsbookmarks"), false, true, &fileCheckError);
-    requireEntryPath(contentsPath, QStringLiteral("Tags.wstags"), false, true, &fileCheckError);
-    requireEntryPath(contentsPath, QStringLiteral("Progress.wsprogress"), false, true, &fileCheckError);
-    requireEntryPath(contentsPath, QStringLiteral("Preset.wspreset"), true, true, &fileCheckError);
-    requireEntryPath(libraryPath, QStringLiteral("index.wsnindex"), false, true, &fileCheckError);
+    for (int index = 0; index < WhatSonHubLayout::kEntryCount; ++index)
+    {
+        const auto entry = static_cast<WhatSonHubLayout::Entry>(index);
+        if (!layout->entryMatches(entry))
+        {
+            fileCheckError = QStringLiteral("Missing required hub entry: %1").arg(layout->entryPath(entry));
+        }
+    }
     if (!fileCheckError.isEmpty())
     {
         if (errorMessage != nullptr)
@@ -233,7 +211,7 @@ bool WhatSonHubParser::parseFromWshub(
     }
 
     QString domainError;
-    const QVariantMap domainPayload = buildDomainPayload(contentsPath, libraryPath, resourcesPath, &domainError);
+    const QVariantMap domainPayload = buildDomainPayload(*layout, &domainError);
     if (!domainError.isEmpty())
     {
         if (errorMessage != nullptr)
@@ -281,47 +259,6 @@ void WhatSonHubParser::requestParseFromWshub(const QString& wshubPath)
     emit hubDomainsParsed(store.hubPath(), store.domainValues());
 }
 
-QString WhatSonHubParser::resolvePrimaryDirectory(
-    const QDir& hubDir,
-    const QString& fixedDirectoryName,
-    const QString& dynamicPattern)
-{
-    const QString fixedPath = cleanIfExists(hubDir.filePath(fixedDirectoryName));
-    if (!fixedPath.isEmpty() && QFileInfo(fixedPath).isDir())
-    {
-        return fixedPath;
-    }
-
-    const QStringList candidates = hubDir.entryList(
-        QStringList{dynamicPattern},
-        QDir::Dirs | QDir::NoDotAndDotDot,
-        QDir::Name);
-    if (!candidates.isEmpty())
-    {
-        return WhatSon::HubPath::joinPath(hubDir.path(), candidates.first());
-    }
-    return {};
-}
-
-QString WhatSonHubParser::resolveStatPath(const QDir& hubDir, const QString& hubName)
-{
-    const QString preferred = cleanIfExists(hubDir.filePath(hubName + QStringLiteral("Stat.wsstat")));
-    if (!preferred.isEmpty() && QFileInfo(preferred).isFile())
-    {
-        return preferred;
-    }
-
-    const QStringList candidates = hubDir.entryList(
-        QStringList{QStringLiteral("*.wsstat")},
-        QDir::Files,
-        QDir::Name);
-    if (!candidates.isEmpty())
-    {
-        return WhatSon::HubPath::joinPath(hubDir.path(), candidates.first());
-    }
-    return {};
-}
-
 QString WhatSonHubParser::firstString(const QJsonObject& object, const QStringList& keys)
 {
     for (const QString& key : keys)
@@ -481,9 +418,9 @@ QVariantMap WhatSonHubParser::buildHubPayload(const WhatSonHubStore& store)
 QVariantMap WhatSonHubParser::buildStatPayload(const WhatSonHubStat& stat)
 {
     QVariantMap payload;
-    payload.insert(QStringLiteral("noteCount"), stat.noteCount());
-    payload.insert(QStringLiteral("resourceCount"), stat.resourceCount());
-    payload.insert(QStringLiteral("characterCount"), stat.characterCount());
+    payload.insert(WhatSonHubStat::noteCountKeys().first(), stat.noteCount());
+    payload.insert(WhatSonHubStat::resourceCountKeys().first(), stat.resourceCount());
+    payload.insert(WhatSonHubStat::characterCountKeys().first(), stat.characterCount());
     payload.insert(QStringLiteral("createdAtUtc"), stat.createdAtUtc());
     payload.insert(QStringLiteral("lastModifiedAtUtc"), stat.lastModifiedAtUtc());
     payload.insert(QStringLiteral("participants"), stat.participants());
@@ -491,56 +428,20 @@ QVariantMap WhatSonHubParser::buildStatPayload(const WhatSonHubStat& stat)
     return payload;
 }
 
-QVariantMap WhatSonHubParser::buildDomainPayload(
-    const QString& contentsPath,
-    const QString& libraryPath,
-    const QString& resourcesPath,
-    QString* errorMessage)
+QVariantMap WhatSonHubParser::buildDomainPayload(const WhatSonHubLayout& layout, QString* errorMessage)
 {
     QVariantMap payload;
 
-    const QString foldersPath =
-        requireEntryPath(contentsPath, QStringLiteral("Folders.wsfolders"), false, true, errorMessage);
-    if (foldersPath.isEmpty())
-    {
-        return {};
-    }
-    const QString projectListsPath =
-        requireEntryPath(contentsPath, QStringLiteral("ProjectLists.wsproj"), false, true, errorMessage);
-    if (projectListsPath.isEmpty())
-    {
-        return {};
-    }
-    const QString bookmarksPath =
-        requireEntryPath(contentsPath, QStringLiteral("Bookmarks.wsbookmarks"), false, true, errorMessage);
-    if (bookmarksPath.isEmpty())
-    {
-        return {};
-    }
-    const QString tagsPath =
-        requireEntryPath(contentsPath, QStringLiteral("Tags.wstags"), false, true, errorMessage);
-    if (tagsPath.isEmpty())
-    {
-        return {};
-    }
-    const QString progressPath =
-        requireEntryPath(contentsPath, QStringLiteral("Progress.wsprogress"), false, true, errorMessage);
-    if (progressPath.isEmpty())
-    {
-        return {};
-    }
-    const QString presetPath =
-        requireEntryPath(contentsPath, QStringLiteral("Preset.wspreset"), true, true, errorMessage);
-    if (presetPath.isEmpty())
-    {
-        return {};
-    }
-    const QString libraryIndexPath =
-        requireEntryPath(libraryPath, QStringLiteral("index.wsnindex"), false, true, errorMessage);
-    if (libraryIndexPath.isEmpty())
-    {
-        return {};
-    }
+    // parseFromWshub() has already checked every required entry against the same layout.
+    const QString& contentsPath = layout.contentsPath;
+    const QString& resourcesPath = layout.resourcesPath;
+    const QString foldersPath = layout.entryPath(WhatSonHubLayout::Entry::Folders);
+    const QString projectListsPath = layout.entryPath(WhatSonHubLayout::Entry::ProjectLists);
+    const QString bookmarksPath = layout.entryPath(WhatSonHubLayout::Entry::Bookmarks);
+    const QString tagsPath = layout.entryPath(WhatSonHubLayout::Entry::Tags);
+    const QString progressPath = layout.entryPath(WhatSonHubLayout::Entry::Progress);
+    const QString presetPath = layout.entryPath(WhatSonHubLayout::Entry::Preset);
+    const QString libraryIndexPath = layout.entryPath(WhatSonHubLayout::Entry::LibraryIndex);
 
     QString rawText;
     QString parseError;
@@ -728,28 +629,6 @@ bool WhatSonHubParser::readUtf8File(
     return true;
 }
 
-QString WhatSonHubParser::requireEntryPath(
-    const QString& basePath,
-    const QString& entryName,
-    bool allowDirectory,
-    bool allowFile,
-    QString* errorMessage)
-{
-    const QString candidatePath = WhatSon::HubPath::joinPath(basePath, entryName);
-    const QFileInfo info(candidatePath);
-    const bool isValid = (allowDirectory && info.isDir()) || (allowFile && info.isFile());
-    if (!isValid)
-    {
-        if (errorMessage != nullptr)
-        {
-            *errorMessage = QStringLiteral("Missing required hub entry: %1").arg(
-                WhatSon::HubPath::normalizePath(candidatePath));
-        }
-        return {};
-    }
-    return WhatSon::HubPath::normalizePath(candidatePath);
-}
-
 QVariantList WhatSonHubParser::toFolderEntryList(const QVector<WhatSonFolderDepthEntry>& entries)
 {
     QVariantList values;
@@ -821,31 +700,19 @@ bool WhatSonHubParser::parseStatText(
 
     const QJsonObject root = document.object();
 
-    int noteCount = firstInt(root, {
-                                 QStringLiteral("noteCount"),
-                                 QStringLiteral("notes"),
-                                 QStringLiteral("totalNotes")
-                             }, -1);
+    int noteCount = firstInt(root, WhatSonHubStat::noteCountKeys(), -1);
     if (noteCount < 0)
     {
         noteCount = countNoteDirectories(libraryPath);
     }
 
-    int resourceCount = firstInt(root, {
-                                     QStringLiteral("resourceCount"),
-                                     QStringLiteral("resources"),
-                                     QStringLiteral("totalResources")
-                                 }, -1);
+    int resourceCount = firstInt(root, WhatSonHubStat::resourceCountKeys(), -1);
     if (resourceCount < 0)
     {
         resourceCount = WhatSon::Resources::countResourcePackages(resourcesPath);
     }
 
-    int characterCount = firstInt(root, {
-                                      QStringLiteral("characterCount"),
-                                      QStringLiteral("characters"),
-                                      QStringLiteral("textLength")
-                                  }, -1);
+    int characterCount = firstInt(root, WhatSonHubStat::characterCountKeys(), -1);
     if (characterCount < 0)
     {
         characterCount = 0;
@@ -11,6 +11,7 @@
 #include <QVector>
 
 struct WhatSonFolderDepthEntry;
+struct WhatSonHubLayout;
 struct WhatSonTagDepthEntry;
 
 class WhatSonHubParser final : public QObject
@@ -45,11 +46,6 @@ public
     void parseFailed(const QString& wshubPath, const QString& errorMessage);
 
 private:
-    static QString resolvePrimaryDirectory(
-        const QDir& hubDir,
-        const QString& fixedDirectoryName,
-        const QString& dynamicPattern);
-    static QString resolveStatPath(const QDir& hubDir, const QString& hubName);
     static QString firstString(const QJsonObject& object, const QStringList& keys);
     static int firstInt(const QJsonObject& object, const QStringList& keys, int fallbackValue = -1);
     static QStringList firstStringList(const QJsonObject& object, const QStringList& keys);
@@ -59,18 +55,8 @@ private:
     static QStringList listRelativeFilesRecursive(const QString& rootPath);
     static QVariantMap buildHubPayload(const WhatSonHubStore& store);
     static QVariantMap buildStatPayload(const WhatSonHubStat& stat);
-    static QVariantMap buildDomainPayload(
-        const QString& contentsPath,
-        const QString& libraryPath,
-        const QString& resourcesPath,
-        QString* errorMessage);
+    static QVariantMap buildDomainPayload(const WhatSonHubLayout& layout, QString* errorMessage);
     static bool readUtf8File(const QString& filePath, QString* outText, QString* errorMessage);
-    static QString requireEntryPath(
-        const QString& basePath,
-        const QString& entryName,
-        bool allowDirectory,
-        bool allowFile,
-        QString* errorMessage);
     static QVariantList toFolderEntryList(const QVector<WhatSonFolderDepthEntry>& entries);
     static QVariantList toTagEntryList(const QVector<WhatSonTagDepthEntry>& entries);
 
@@ -3,9 +3,12 @@
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 #include "app/models/file/hub/WhatSonHubParser.hpp"
+#include "app/models/file/hub/WhatSonHubPlacementStore.hpp"
+#include "app/models/hierarchy/tags/WhatSonHubTagsStateStore.hpp"
+
+#include <QThread>
+#include <QThreadPool>
 
-#include <QDir>
-#include <QSet>
 #include <utility>
 
 namespace
@@ -14,12 +17,65 @@ namespace
     {
         return WhatSon::HubPath::normalizePath(path);
     }
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
 } // namespace
 
 WhatSonHubRuntimeStore::WhatSonHubRuntimeStore() = default;
 
 WhatSonHubRuntimeStore::~WhatSonHubRuntimeStore() = default;
 
+std::shared_ptr<const WhatSonHubRuntimeStore::HubSlot> WhatSonHubRuntimeStore::buildSlot(
+    const QString& wshubPath,
+    QString* errorMessage)
+{
+    // Every domain is parsed into stores that only ever see this hub, so the cost of a load is bounded by the hub
+    // itself and no other mounted hub is touched until the finished slot is committed.
+    auto slot = std::make_shared<HubSlot>();
+
+    WhatSonHubParser parser;
+    if (!parser.parseFromWshub(wshubPath, &slot->hub, errorMessage))
+    {
+        WhatSon::Debug::trace(QStringLiteral("hub.runtime"),
+                              QStringLiteral("load.failed.parser"),
+                              errorMessage != nullptr ? *errorMessage : QString());
+        return {};
+    }
+
+    const QString normalizedPath = normalizePath(wshubPath);
+    WhatSonHubPlacementStore placementStore;
+    if (!placementStore.loadFromWshub(normalizedPath, errorMessage))
+    {
+        WhatSon::Debug::trace(QStringLiteral("hub.runtime"),
+                              QStringLiteral("load.failed.placement"),
+                              errorMessage != nullptr ? *errorMessage : QString());
+        return {};
+    }
+    slot->placement = placementStore.placement(normalizedPath);
+    slot->hasPlacement = true;
+
+    WhatSonHubTagsStateStore tagsStateStore;
+    if (!tagsStateStore.loadFromWshub(normalizedPath, errorMessage))
+    {
+        WhatSon::Debug::trace(QStringLiteral("hub.runtime"),
+                              QStringLiteral("load.failed.tags"),
+                              errorMessage != nullptr ? *errorMessage : QString());
+        return {};
+    }
+    slot->tagDepthEntries = tagsStateStore.entries(normalizedPath);
+    slot->hasTagDepthEntries = true;
+
+    slot->hub.setHubPath(normalizedPath);
+    return slot;
+}
+
 bool WhatSonHubRuntimeStore::loadFromWshub(
     const QString& wshubPath,
     QString* errorMessage)
@@ -29,119 +85,247 @@ bool WhatSonHubRuntimeStore::loadFromWshub(
                               QStringLiteral("load.begin"),
                               QStringLiteral("path=%1").arg(wshubPath));
 
-    WhatSonHubParser parser;
-    WhatSonHubStore hubStore;
-    if (!parser.parseFromWshub(wshubPath, &hubStore, errorMessage))
+    // All-or-nothing policy: the slot is committed only after every domain parsed successfully.
+    std::shared_ptr<const HubSlot> slot = buildSlot(wshubPath, errorMessage);
+    if (slot == nullptr)
     {
-        WhatSon::Debug::traceSelf(this,
-                                  QStringLiteral("hub.runtime"),
-                                  QStringLiteral("load.failed.parser"),
-                                  errorMessage != nullptr ? *errorMessage : QString());
         return false;
     }
 
-    // All-or-nothing policy: stage updates in local copies and commit only on full success.
-    QHash<QString, WhatSonHubStore> stagedHubStore = m_hubStore;
-    WhatSonHubPlacementStore stagedPlacementStore = m_placementStore;
-    WhatSonHubTagsStateStore stagedTagsStateStore = m_tagsStateStore;
+    const QString normalizedPath = normalizePath(wshubPath);
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hub.runtime"),
+                              QStringLiteral("load.success"),
+                              QStringLiteral("tagCount=%1 noteCount=%2 resourceCount=%3")
+                              .arg(slot->tagDepthEntries.size())
+                              .arg(slot->hub.stat().noteCount())
+                              .arg(slot->hub.stat().resourceCount()));
+    mountSlot(normalizedPath, std::move(slot));
+    return true;
+}
 
-    stagedHubStore.insert(hubStore.hubPath(), hubStore);
+bool WhatSonHubRuntimeStore::loadManyFromWshubs(
+    const QStringList& wshubPaths,
+    QStringList* failedPaths,
+    QString* errorMessage)
+{
+    struct PendingMount final
+    {
+        QString normalizedPath;
+        std::shared_ptr<const HubSlot> slot;
+        QString error;
+    };
 
-    if (!stagedPlacementStore.loadFromWshub(wshubPath, errorMessage))
+    QVector<PendingMount> pendingMounts;
+    pendingMounts.reserve(wshubPaths.size());
+    for (const QString& wshubPath : wshubPaths)
     {
-        WhatSon::Debug::traceSelf(this,
-                                  QStringLiteral("hub.runtime"),
-                                  QStringLiteral("load.failed.placement"),
-                                  errorMessage != nullptr ? *errorMessage : QString());
-        return false;
+        const QString normalizedPath = normalizePath(wshubPath);
+        bool duplicate = normalizedPath.isEmpty();
+        for (const PendingMount& pendingMount : std::as_const(pendingMounts))
+        {
+            duplicate = duplicate || pendingMount.normalizedPath == normalizedPath;
+        }
+        if (!duplicate)
+        {
+            pendingMounts.push_back(PendingMount{normalizedPath, {}, {}});
+        }
     }
-    if (!stagedTagsStateStore.loadFromWshub(wshubPath, errorMessage))
+
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hub.runtime"),
+                              QStringLiteral("loadMany.begin"),
+                              QStringLiteral("count=%1").arg(pendingMounts.size()));
+
+    // Slots are built concurrently; each worker writes only its own pending entry. Commits happen afterwards on the
+    // calling thread in request order, so readers of this store never observe a partially mounted hub.
+    PendingMount* mountSlots = pendingMounts.data();
+    QThreadPool workerPool;
+    workerPool.setMaxThreadCount(m_maxWorkerCount > 0 ? m_maxWorkerCount : QThread::idealThreadCount());
+    for (qsizetype index = 0; index < pendingMounts.size(); ++index)
     {
-        WhatSon::Debug::traceSelf(this,
-                                  QStringLiteral("hub.runtime"),
-                                  QStringLiteral("load.failed.tags"),
-                                  errorMessage != nullptr ? *errorMessage : QString());
-        return false;
+        workerPool.start([mountSlots, index]()
+        {
+            PendingMount& pendingMount = mountSlots[index];
+            pendingMount.slot = buildSlot(pendingMount.normalizedPath, &pendingMount.error);
+        });
     }
+    workerPool.waitForDone();
 
-    m_hubStore = std::move(stagedHubStore);
-    m_placementStore = std::move(stagedPlacementStore);
-    m_tagsStateStore = std::move(stagedTagsStateStore);
+    QStringList failures;
+    QStringList errors;
+    for (PendingMount& pendingMount : pendingMounts)
+    {
+        if (pendingMount.slot == nullptr)
+        {
+            failures.push_back(pendingMount.normalizedPath);
+            errors.push_back(QStringLiteral("%1: %2").arg(pendingMount.normalizedPath, pendingMount.error));
+            continue;
+        }
+        mountSlot(pendingMount.normalizedPath, std::move(pendingMount.slot));
+    }
 
-    const QString normalizedPath = normalizePath(wshubPath);
-    const int tagCount = m_tagsStateStore.entries(normalizedPath).size();
-    const WhatSonHubStore loadedHub = m_hubStore.value(normalizedPath);
+    if (failedPaths != nullptr)
+    {
+        *failedPaths = failures;
+    }
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hub.runtime"),
-                              QStringLiteral("load.success"),
-                              QStringLiteral("tagCount=%1 noteCount=%2 resourceCount=%3")
-                              .arg(tagCount)
-                              .arg(loadedHub.stat().noteCount())
-                              .arg(loadedHub.stat().resourceCount()));
+                              QStringLiteral("loadMany.finished"),
+                              QStringLiteral("mounted=%1 failed=%2")
+                              .arg(pendingMounts.size() - failures.size())
+                              .arg(failures.size()));
+    if (!failures.isEmpty())
+    {
+        return failWith(errorMessage, errors.join(QLatin1Char('\n')));
+    }
     return true;
 }
 
-bool WhatSonHubRuntimeStore::contains(const QString& wshubPath) const
+int WhatSonHubRuntimeStore::maxWorkerCount() const noexcept
+{
+    return m_maxWorkerCount;
+}
+
+void WhatSonHubRuntimeStore::setMaxWorkerCount(const int maxWorkerCount) noexcept
+{
+    m_maxWorkerCount = maxWorkerCount > 0 ? maxWorkerCount : 0;
+}
+
+int WhatSonHubRuntimeStore::maxMountedHubCount() const noexcept
+{
+    return m_maxMountedHubCount;
+}
+
+void WhatSonHubRuntimeStore::setMaxMountedHubCount(const int maxMountedHubCount)
+{
+    m_maxMountedHubCount = maxMountedHubCount > 0 ? maxMountedHubCount : 0;
+    evictOverflow();
+}
+
+void WhatSonHubRuntimeStore::markUsed(const QString& wshubPath)
 {
     const QString normalized = normalizePath(wshubPath);
-    return m_hubStore.contains(normalized)
-        || m_placementStore.contains(normalized)
-        || m_tagsStateStore.contains(normalized);
+    if (!m_slots.contains(normalized))
+    {
+        return;
+    }
+
+    m_mountOrder.removeAll(normalized);
+    m_mountOrder.push_back(normalized);
+}
+
+bool WhatSonHubRuntimeStore::contains(const QString& wshubPath) const
+{
+    return m_slots.contains(normalizePath(wshubPath));
 }
 
 QStringList WhatSonHubRuntimeStore::hubPaths() const
 {
-    const QStringList hubStorePaths = m_hubStore.keys();
-    const QStringList placementPaths = m_placementStore.hubPaths();
-    const QStringList tagStatePaths = m_tagsStateStore.hubPaths();
+    QStringList paths = m_slots.keys();
+    paths.sort();
+    return paths;
+}
 
-    QSet<QString> merged(hubStorePaths.begin(), hubStorePaths.end());
-    merged.unite(QSet<QString>(placementPaths.begin(), placementPaths.end()));
-    merged.unite(QSet<QString>(tagStatePaths.begin(), tagStatePaths.end()));
+int WhatSonHubRuntimeStore::mountedHubCount() const noexcept
+{
+    return static_cast<int>(m_slots.size());
+}
+
+std::shared_ptr<const WhatSonHubRuntimeStore::HubSlot> WhatSonHubRuntimeStore::slot(const QString& wshubPath) const
+{
+    return m_slots.value(normalizePath(wshubPath));
+}
 
-    QStringList paths = merged.values();
+QStringList WhatSonHubRuntimeStore::evictedHubPaths() const
+{
+    QStringList paths = m_evictedSummaries.keys();
     paths.sort();
     return paths;
 }
 
+WhatSonHubRuntimeStore::HubSummary WhatSonHubRuntimeStore::summary(const QString& wshubPath) const
+{
+    const QString normalized = normalizePath(wshubPath);
+    const std::shared_ptr<const HubSlot> hubSlot = m_slots.value(normalized);
+    if (hubSlot != nullptr)
+    {
+        return HubSummary{normalized, hubSlot->hub.stat()};
+    }
+    return m_evictedSummaries.value(normalized);
+}
+
 WhatSonHubPlacement WhatSonHubRuntimeStore::placement(const QString& wshubPath) const
 {
-    return m_placementStore.placement(wshubPath);
+    const std::shared_ptr<const HubSlot> hubSlot = slot(wshubPath);
+    if (hubSlot == nullptr || !hubSlot->hasPlacement)
+    {
+        return {};
+    }
+    return hubSlot->placement;
 }
 
 QVector<WhatSonTagDepthEntry> WhatSonHubRuntimeStore::tagDepthEntries(const QString& wshubPath) const
 {
-    return m_tagsStateStore.entries(wshubPath);
+    const std::shared_ptr<const HubSlot> hubSlot = slot(wshubPath);
+    if (hubSlot == nullptr)
+    {
+        return {};
+    }
+    return hubSlot->tagDepthEntries;
 }
 
 WhatSonHubStore WhatSonHubRuntimeStore::hub(const QString& wshubPath) const
 {
-    return m_hubStore.value(normalizePath(wshubPath));
+    const std::shared_ptr<const HubSlot> hubSlot = slot(wshubPath);
+    if (hubSlot == nullptr)
+    {
+        return {};
+    }
+    return hubSlot->hub;
 }
 
 WhatSonHubStat WhatSonHubRuntimeStore::hubStat(const QString& wshubPath) const
 {
-    return hub(wshubPath).stat();
+    return summary(wshubPath).stat;
 }
 
 void WhatSonHubRuntimeStore::setPlacement(WhatSonHubPlacement placement)
 {
+    const QString normalized = normalizePath(placement.hubPath());
+    if (normalized.isEmpty())
+    {
+        return;
+    }
+
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hub.runtime"),
                               QStringLiteral("setPlacement"),
                               QStringLiteral("path=%1").arg(placement.hubPath()));
-    m_placementStore.setPlacement(std::move(placement));
+    HubSlot hubSlot = detachedSlot(normalized);
+    hubSlot.placement = std::move(placement);
+    hubSlot.hasPlacement = true;
+    commitSlot(normalized, std::move(hubSlot));
 }
 
 void WhatSonHubRuntimeStore::setTagDepthEntries(
     const QString& wshubPath,
     QVector<WhatSonTagDepthEntry> entries)
 {
+    const QString normalized = normalizePath(wshubPath);
+    if (normalized.isEmpty())
+    {
+        return;
+    }
+
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hub.runtime"),
                               QStringLiteral("setTagDepthEntries"),
                               QStringLiteral("path=%1 count=%2").arg(wshubPath).arg(entries.size()));
-    m_tagsStateStore.setEntries(wshubPath, std::move(entries));
+    HubSlot hubSlot = detachedSlot(normalized);
+    hubSlot.tagDepthEntries = std::move(entries);
+    hubSlot.hasTagDepthEntries = true;
+    commitSlot(normalized, std::move(hubSlot));
 }
 
 void WhatSonHubRuntimeStore::setHub(WhatSonHubStore store)
@@ -157,7 +341,9 @@ void WhatSonHubRuntimeStore::setHub(WhatSonHubStore store)
                               QStringLiteral("hub.runtime"),
                               QStringLiteral("setHub"),
                               QStringLiteral("path=%1").arg(normalized));
-    m_hubStore.insert(normalized, std::move(store));
+    HubSlot hubSlot = detachedSlot(normalized);
+    hubSlot.hub = std::move(store);
+    commitSlot(normalized, std::move(hubSlot));
 }
 
 void WhatSonHubRuntimeStore::setHubStat(const QString& wshubPath, WhatSonHubStat stat)
@@ -168,25 +354,55 @@ void WhatSonHubRuntimeStore::setHubStat(const QString& wshubPath, WhatSonHubStat
         return;
     }
 
-    WhatSonHubStore store = m_hubStore.value(normalized);
-    store.setHubPath(normalized);
-    store.setStat(std::move(stat));
-    m_hubStore.insert(normalized, std::move(store));
+    HubSlot hubSlot = detachedSlot(normalized);
+    hubSlot.hub.setHubPath(normalized);
+    hubSlot.hub.setStat(std::move(stat));
+    commitSlot(normalized, std::move(hubSlot));
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hub.runtime"),
                               QStringLiteral("setHubStat"),
                               QStringLiteral("path=%1").arg(normalized));
 }
 
+void WhatSonHubRuntimeStore::mountSlot(const QString& wshubPath, std::shared_ptr<const HubSlot> slot)
+{
+    const QString normalized = normalizePath(wshubPath);
+    if (normalized.isEmpty() || slot == nullptr)
+    {
+        return;
+    }
+
+    m_slots.insert(normalized, std::move(slot));
+    m_evictedSummaries.remove(normalized);
+    m_mountOrder.removeAll(normalized);
+    m_mountOrder.push_back(normalized);
+    evictOverflow();
+}
+
+void WhatSonHubRuntimeStore::mountFrom(const WhatSonHubRuntimeStore& other)
+{
+    if (&other == this)
+    {
+        return;
+    }
+
+    // Slots are immutable and shared, so adopting another store's hubs only copies pointers.
+    for (const QString& hubPath : other.m_mountOrder)
+    {
+        mountSlot(hubPath, other.m_slots.value(hubPath));
+    }
+}
+
 void WhatSonHubRuntimeStore::remove(const QString& wshubPath)
 {
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hub.runtime"),
                               QStringLiteral("remove"),
                               QStringLiteral("path=%1").arg(wshubPath));
-    m_hubStore.remove(normalizePath(wshubPath));
-    m_placementStore.remove(wshubPath);
-    m_tagsStateStore.remove(wshubPath);
+    const QString normalized = normalizePath(wshubPath);
+    m_slots.remove(normalized);
+    m_mountOrder.removeAll(normalized);
+    m_evictedSummaries.remove(normalized);
 }
 
 void WhatSonHubRuntimeStore::clear()
@@ -194,7 +410,44 @@ void WhatSonHubRuntimeStore::clear()
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hub.runtime"),
                               QStringLiteral("clear"));
-    m_hubStore.clear();
-    m_placementStore.clear();
-    m_tagsStateStore.clear();
+    m_slots.clear();
+    m_mountOrder.clear();
+    m_evictedSummaries.clear();
+}
+
+WhatSonHubRuntimeStore::HubSlot WhatSonHubRuntimeStore::detachedSlot(const QString& normalizedPath) const
+{
+    const std::shared_ptr<const HubSlot> current = m_slots.value(normalizedPath);
+    if (current == nullptr)
+    {
+        return {};
+    }
+    return *current;
+}
+
+void WhatSonHubRuntimeStore::commitSlot(const QString& normalizedPath, HubSlot slot)
+{
+    mountSlot(normalizedPath, std::make_shared<const HubSlot>(std::move(slot)));
+}
+
+void WhatSonHubRuntimeStore::evictOverflow()
+{
+    if (m_maxMountedHubCount <= 0)
+    {
+        return;
+    }
+
+    while (m_mountOrder.size() > m_maxMountedHubCount)
+    {
+        const QString evictedPath = m_mountOrder.takeFirst();
+        const std::shared_ptr<const HubSlot> evictedSlot = m_slots.take(evictedPath);
+        if (evictedSlot != nullptr)
+        {
+            m_evictedSummaries.insert(evictedPath, HubSummary{evictedPath, evictedSlot->hub.stat()});
+        }
+        WhatSon::Debug::traceSelf(this,
+                                  QStringLiteral("hub.runtime"),
+                                  QStringLiteral("evict"),
+                                  QStringLiteral("path=%1").arg(evictedPath));
+    }
 }
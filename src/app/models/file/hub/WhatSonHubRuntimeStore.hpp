@@ -1,24 +1,59 @@
 #pragma once
 
 #include "app/models/file/hub/WhatSonHubStore.hpp"
-#include "app/models/file/hub/WhatSonHubPlacementStore.hpp"
-#include "app/models/hierarchy/tags/WhatSonHubTagsStateStore.hpp"
+#include "app/models/file/hub/WhatSonHubPlacement.hpp"
+#include "app/models/hierarchy/tags/WhatSonTagDepthEntry.hpp"
 
 #include <QHash>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
+#include <memory>
+
 class WhatSonHubRuntimeStore
 {
 public:
+    // One immutable runtime slot per mounted hub. Slots are shared between store copies and replaced as a whole,
+    // so committing a hub never copies the state of any other hub.
+    struct HubSlot final
+    {
+        WhatSonHubStore hub;
+        WhatSonHubPlacement placement;
+        bool hasPlacement = false;
+        QVector<WhatSonTagDepthEntry> tagDepthEntries;
+        bool hasTagDepthEntries = false;
+    };
+
+    // What stays resident for a hub evicted by the mounted-hub cap: enough to list it without keeping its stores.
+    struct HubSummary final
+    {
+        QString hubPath;
+        WhatSonHubStat stat;
+    };
+
     WhatSonHubRuntimeStore();
     ~WhatSonHubRuntimeStore();
 
     bool loadFromWshub(const QString& wshubPath, QString* errorMessage = nullptr);
+    bool loadManyFromWshubs(
+        const QStringList& wshubPaths,
+        QStringList* failedPaths = nullptr,
+        QString* errorMessage = nullptr);
+    static std::shared_ptr<const HubSlot> buildSlot(const QString& wshubPath, QString* errorMessage = nullptr);
+
+    int maxWorkerCount() const noexcept;
+    void setMaxWorkerCount(int maxWorkerCount) noexcept;
+    int maxMountedHubCount() const noexcept;
+    void setMaxMountedHubCount(int maxMountedHubCount);
+    void markUsed(const QString& wshubPath);
 
     bool contains(const QString& wshubPath) const;
     QStringList hubPaths() const;
+    int mountedHubCount() const noexcept;
+    std::shared_ptr<const HubSlot> slot(const QString& wshubPath) const;
+    QStringList evictedHubPaths() const;
+    HubSummary summary(const QString& wshubPath) const;
 
     WhatSonHubPlacement placement(const QString& wshubPath) const;
     QVector<WhatSonTagDepthEntry> tagDepthEntries(const QString& wshubPath) const;
@@ -30,11 +65,19 @@ public:
     void setHub(WhatSonHubStore store);
     void setHubStat(const QString& wshubPath, WhatSonHubStat stat);
 
+    void mountSlot(const QString& wshubPath, std::shared_ptr<const HubSlot> slot);
+    void mountFrom(const WhatSonHubRuntimeStore& other);
     void remove(const QString& wshubPath);
     void clear();
 
 private:
-    QHash<QString, WhatSonHubStore> m_hubStore;
-    WhatSonHubPlacementStore m_placementStore;
-    WhatSonHubTagsStateStore m_tagsStateStore;
+    HubSlot detachedSlot(const QString& normalizedPath) const;
+    void commitSlot(const QString& normalizedPath, HubSlot slot);
+    void evictOverflow();
+
+    QHash<QString, std::shared_ptr<const HubSlot>> m_slots;
+    QStringList m_mountOrder;
+    QHash<QString, HubSummary> m_evictedSummaries;
+    int m_maxWorkerCount = 0;
+    int m_maxMountedHubCount = 0;
 };
@@ -0,0 +1,872 @@
+#include "app/models/file/hub/WhatSonHubSnapshotStore.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QSet>
+#include <QThreadPool>
+#include <QUuid>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    constexpr int kManifestVersion = 1;
+    constexpr int kLockTimeoutMs = 30000;
+    constexpr int kCollisionSuffixWidth = 3;
+
+    struct FileRecord final
+    {
+        QString sha256;
+        qint64 size = 0;
+        qint64 modifiedMs = 0;
+    };
+
+    struct Manifest final
+    {
+        WhatSonHubSnapshotInfo info;
+        QStringList directories;
+        QHash<QString, FileRecord> files;
+    };
+
+    struct HubScan final
+    {
+        QStringList directories;
+        QHash<QString, FileRecord> files;
+    };
+
+    struct StoragePaths final
+    {
+        QString hubPath;
+        QString rootPath;
+        QString manifestsPath;
+        QString objectsPath;
+        QString lockPath;
+
+        explicit StoragePaths(const QString& normalizedHubPath)
+            : hubPath(normalizedHubPath)
+            , rootPath(QDir(normalizedHubPath).filePath(WhatSonHubSnapshotStore::storageRelativePath()))
+            , manifestsPath(QDir(rootPath).filePath(QStringLiteral("manifests")))
+            , objectsPath(QDir(rootPath).filePath(QStringLiteral("objects")))
+            , lockPath(QDir(rootPath).filePath(QStringLiteral("snapshots.lock")))
+        {
+        }
+
+        QString manifestPath(const QString& snapshotId) const
+        {
+            return QDir(manifestsPath).filePath(snapshotId + QStringLiteral(".json"));
+        }
+
+        QString objectPath(const QString& sha256) const
+        {
+            return QDir(objectsPath).filePath(sha256.left(2) + QLatin1Char('/') + sha256);
+        }
+
+        QString restoreStagingPath() const
+        {
+            return QDir(rootPath).filePath(
+                QStringLiteral("restore-") + QUuid::createUuid().toString(QUuid::WithoutBraces));
+        }
+    };
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    bool isPrivateBookkeepingPath(const QString& relativePath)
+    {
+        return relativePath == QStringLiteral(".whatson") || relativePath.startsWith(QStringLiteral(".whatson/"));
+    }
+
+    bool isValidSnapshotId(const QString& snapshotId)
+    {
+        if (snapshotId.isEmpty())
+        {
+            return false;
+        }
+        for (const QChar character : snapshotId)
+        {
+            if (!character.isLetterOrNumber() && character != QLatin1Char('-'))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    HubScan scanHub(const QString& hubPath)
+    {
+        HubScan scan;
+        const QDir hubDirectory(hubPath);
+        QStringList pendingDirectories{hubPath};
+        while (!pendingDirectories.isEmpty())
+        {
+            const QString directoryPath = pendingDirectories.takeLast();
+            QDirIterator iterator(
+                directoryPath,
+                QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot);
+            while (iterator.hasNext())
+            {
+                iterator.next();
+                const QFileInfo entryInfo = iterator.fileInfo();
+                const QString relativePath = hubDirectory.relativeFilePath(entryInfo.filePath());
+                if (entryInfo.isSymLink() || isPrivateBookkeepingPath(relativePath))
+                {
+                    continue;
+                }
+                if (entryInfo.isDir())
+                {
+                    scan.directories.push_back(relativePath);
+                    pendingDirectories.push_back(entryInfo.filePath());
+                    continue;
+                }
+                if (entryInfo.isFile())
+                {
+                    FileRecord record;
+                    record.size = entryInfo.size();
+                    record.modifiedMs = entryInfo.lastModified().toMSecsSinceEpoch();
+                    scan.files.insert(relativePath, record);
+                }
+            }
+        }
+        std::sort(scan.directories.begin(), scan.directories.end());
+        return scan;
+    }
+
+    QString hashFile(const QString& filePath)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return {};
+        }
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        if (!hash.addData(&file))
+        {
+            return {};
+        }
+        return QString::fromLatin1(hash.result().toHex());
+    }
+
+    bool sameStat(const FileRecord& lhs, const FileRecord& rhs)
+    {
+        return lhs.size == rhs.size && lhs.modifiedMs == rhs.modifiedMs;
+    }
+
+    // QFile::copy clones the file on filesystems with reflink support, so new objects only cost
+    // extra space once the hub file diverges from the snapshot.
+    bool ingestObject(
+        const StoragePaths& paths,
+        const QString& sourcePath,
+        QString* outSha256,
+        qint64* storedBytes,
+        QString* errorMessage)
+    {
+        const QString incomingPath = QDir(paths.objectsPath).filePath(
+            QStringLiteral("incoming-") + QUuid::createUuid().toString(QUuid::WithoutBraces));
+        if (!QFile::copy(sourcePath, incomingPath))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to copy into snapshot store: %1").arg(sourcePath));
+        }
+
+        const QString sha256 = hashFile(incomingPath);
+        if (sha256.isEmpty())
+        {
+            QFile::remove(incomingPath);
+            return failWith(errorMessage, QStringLiteral("Failed to hash snapshot object: %1").arg(sourcePath));
+        }
+
+        const QString objectPath = paths.objectPath(sha256);
+        if (QFileInfo::exists(objectPath))
+        {
+            QFile::remove(incomingPath);
+        }
+        else if (!QDir().mkpath(QFileInfo(objectPath).absolutePath()) || !QFile::rename(incomingPath, objectPath))
+        {
+            QFile::remove(incomingPath);
+            return failWith(errorMessage, QStringLiteral("Failed to store snapshot object: %1").arg(objectPath));
+        }
+        else
+        {
+            *storedBytes += QFileInfo(objectPath).size();
+        }
+
+        *outSha256 = sha256;
+        return true;
+    }
+
+    QJsonObject manifestToJson(const Manifest& manifest)
+    {
+        QJsonArray directories;
+        for (const QString& directory : manifest.directories)
+        {
+            directories.append(directory);
+        }
+
+        QStringList filePaths = manifest.files.keys();
+        std::sort(filePaths.begin(), filePaths.end());
+        QJsonArray files;
+        for (const QString& filePath : std::as_const(filePaths))
+        {
+            const FileRecord record = manifest.files.value(filePath);
+            files.append(QJsonObject{
+                {QStringLiteral("path"), filePath},
+                {QStringLiteral("sha256"), record.sha256},
+                {QStringLiteral("size"), record.size},
+                {QStringLiteral("modifiedMs"), record.modifiedMs}});
+        }
+
+        return QJsonObject{
+            {QStringLiteral("version"), kManifestVersion},
+            {QStringLiteral("id"), manifest.info.id},
+            {QStringLiteral("label"), manifest.info.label},
+            {QStringLiteral("createdAtUtc"), manifest.info.createdAtUtc},
+            {QStringLiteral("totalBytes"), manifest.info.totalBytes},
+            {QStringLiteral("storedBytes"), manifest.info.storedBytes},
+            {QStringLiteral("directories"), directories},
+            {QStringLiteral("files"), files}};
+    }
+
+    bool readManifest(const StoragePaths& paths, const QString& snapshotId, Manifest* outManifest, QString* errorMessage)
+    {
+        if (!isValidSnapshotId(snapshotId))
+        {
+            return failWith(errorMessage, QStringLiteral("Invalid snapshot id: %1").arg(snapshotId));
+        }
+
+        QFile file(paths.manifestPath(snapshotId));
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return failWith(errorMessage, QStringLiteral("Snapshot not found: %1").arg(snapshotId));
+        }
+
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+        const QJsonObject root = document.object();
+        if (parseError.error != QJsonParseError::NoError
+            || root.value(QStringLiteral("version")).toInt() != kManifestVersion)
+        {
+            return failWith(errorMessage, QStringLiteral("Unreadable snapshot manifest: %1").arg(snapshotId));
+        }
+
+        Manifest manifest;
+        manifest.info.id = snapshotId;
+        manifest.info.label = root.value(QStringLiteral("label")).toString();
+        manifest.info.createdAtUtc = root.value(QStringLiteral("createdAtUtc")).toString();
+        manifest.info.totalBytes = root.value(QStringLiteral("totalBytes")).toInteger();
+        manifest.info.storedBytes = root.value(QStringLiteral("storedBytes")).toInteger();
+        for (const QJsonValue& directory : root.value(QStringLiteral("directories")).toArray())
+        {
+            manifest.directories.push_back(directory.toString());
+        }
+        const QJsonArray files = root.value(QStringLiteral("files")).toArray();
+        manifest.files.reserve(files.size());
+        for (const QJsonValue& value : files)
+        {
+            const QJsonObject entry = value.toObject();
+            FileRecord record;
+            record.sha256 = entry.value(QStringLiteral("sha256")).toString();
+            record.size = entry.value(QStringLiteral("size")).toInteger();
+            record.modifiedMs = entry.value(QStringLiteral("modifiedMs")).toInteger();
+            manifest.files.insert(entry.value(QStringLiteral("path")).toString(), record);
+        }
+        manifest.info.fileCount = static_cast<int>(manifest.files.size());
+        *outManifest = std::move(manifest);
+        return true;
+    }
+
+    // Ids sort chronologically as plain strings: the timestamp prefix is fixed-width and collision suffixes are
+    // zero-padded. Sorting the ids themselves (not the manifest file names) keeps "id" ahead of "id-001".
+    QStringList snapshotIds(const StoragePaths& paths)
+    {
+        QStringList ids;
+        const QStringList manifestNames = QDir(paths.manifestsPath).entryList(
+            QStringList{QStringLiteral("*.json")},
+            QDir::Files);
+        for (const QString& manifestName : manifestNames)
+        {
+            const QString snapshotId = QFileInfo(manifestName).completeBaseName();
+            if (isValidSnapshotId(snapshotId))
+            {
+                ids.push_back(snapshotId);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    QString nextSnapshotId(const StoragePaths& paths, const QDateTime& createdAtUtc)
+    {
+        const QString baseId = createdAtUtc.toString(QStringLiteral("yyyyMMdd-hhmmsszzz"));
+        QString snapshotId = baseId;
+        for (int suffix = 1; QFileInfo::exists(paths.manifestPath(snapshotId)); ++suffix)
+        {
+            snapshotId = QStringLiteral("%1-%2").arg(baseId).arg(suffix, kCollisionSuffixWidth, 10, QLatin1Char('0'));
+        }
+        return snapshotId;
+    }
+
+    bool createSnapshotLocked(
+        const StoragePaths& paths,
+        const QString& label,
+        WhatSonHubSnapshotInfo* outInfo,
+        QString* errorMessage)
+    {
+        Manifest previous;
+        const QStringList existingIds = snapshotIds(paths);
+        if (!existingIds.isEmpty() && !readManifest(paths, existingIds.constLast(), &previous, nullptr))
+        {
+            previous = Manifest();
+        }
+
+        if (!QDir().mkpath(paths.manifestsPath) || !QDir().mkpath(paths.objectsPath))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to create snapshot store: %1").arg(paths.rootPath));
+        }
+
+        const QDateTime createdAtUtc = QDateTime::currentDateTimeUtc();
+        HubScan scan = scanHub(paths.hubPath);
+        Manifest manifest;
+        manifest.info.id = nextSnapshotId(paths, createdAtUtc);
+        manifest.info.label = label.trimmed();
+        manifest.info.createdAtUtc = createdAtUtc.toString(Qt::ISODateWithMs);
+        manifest.directories = std::move(scan.directories);
+        manifest.files.reserve(scan.files.size());
+
+        int reusedCount = 0;
+        for (auto it = scan.files.cbegin(); it != scan.files.cend(); ++it)
+        {
+            FileRecord record = it.value();
+            const auto previousIt = previous.files.constFind(it.key());
+            if (previousIt != previous.files.cend()
+                && sameStat(previousIt.value(), record)
+                && QFileInfo::exists(paths.objectPath(previousIt.value().sha256)))
+            {
+                record.sha256 = previousIt.value().sha256;
+                ++reusedCount;
+            }
+            else if (!ingestObject(
+                         paths,
+                         QDir(paths.hubPath).filePath(it.key()),
+                         &record.sha256,
+                         &manifest.info.storedBytes,
+                         errorMessage))
+            {
+                return false;
+            }
+            manifest.info.totalBytes += record.size;
+            manifest.files.insert(it.key(), record);
+        }
+        manifest.info.fileCount = static_cast<int>(manifest.files.size());
+
+        QSaveFile manifestFile(paths.manifestPath(manifest.info.id));
+        const QByteArray manifestBytes = QJsonDocument(manifestToJson(manifest)).toJson(QJsonDocument::Compact);
+        if (!manifestFile.open(QIODevice::WriteOnly)
+            || manifestFile.write(manifestBytes) != manifestBytes.size()
+            || !manifestFile.commit())
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to write snapshot manifest: %1").arg(manifest.info.id));
+        }
+
+        WhatSon::Debug::trace(
+            QStringLiteral("hub.snapshot"),
+            QStringLiteral("create.success"),
+            QStringLiteral("hub=%1 id=%2 files=%3 reused=%4 storedBytes=%5")
+                .arg(paths.hubPath, manifest.info.id)
+                .arg(manifest.info.fileCount)
+                .arg(reusedCount)
+                .arg(manifest.info.storedBytes));
+        if (outInfo != nullptr)
+        {
+            *outInfo = manifest.info;
+        }
+        return true;
+    }
+
+    void collectGarbageLocked(const StoragePaths& paths)
+    {
+        QSet<QString> referencedHashes;
+        for (const QString& snapshotId : snapshotIds(paths))
+        {
+            Manifest manifest;
+            if (!readManifest(paths, snapshotId, &manifest, nullptr))
+            {
+                // Keep every object while a manifest cannot be read; it may still reference them.
+                return;
+            }
+            for (const FileRecord& record : std::as_const(manifest.files))
+            {
+                referencedHashes.insert(record.sha256);
+            }
+        }
+
+        int removedCount = 0;
+        QDirIterator iterator(paths.objectsPath, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+        while (iterator.hasNext())
+        {
+            const QString objectPath = iterator.next();
+            if (!referencedHashes.contains(iterator.fileName()) && QFile::remove(objectPath))
+            {
+                ++removedCount;
+            }
+        }
+        WhatSon::Debug::trace(
+            QStringLiteral("hub.snapshot"),
+            QStringLiteral("collectGarbage"),
+            QStringLiteral("hub=%1 removedObjects=%2").arg(paths.hubPath).arg(removedCount));
+    }
+
+    int pruneSnapshotsLocked(const StoragePaths& paths, const int retentionCount)
+    {
+        const QStringList ids = snapshotIds(paths);
+        const int removableCount = retentionCount > 0 ? std::max(0, static_cast<int>(ids.size()) - retentionCount) : 0;
+        int removedCount = 0;
+        for (int index = 0; index < removableCount; ++index)
+        {
+            if (QFile::remove(paths.manifestPath(ids.at(index))))
+            {
+                ++removedCount;
+            }
+        }
+        if (removedCount > 0)
+        {
+            collectGarbageLocked(paths);
+        }
+        return removedCount;
+    }
+
+    void diffRecords(
+        const QHash<QString, FileRecord>& from,
+        const QHash<QString, FileRecord>& to,
+        WhatSonHubSnapshotDiff* outDiff)
+    {
+        for (auto it = to.cbegin(); it != to.cend(); ++it)
+        {
+            const auto fromIt = from.constFind(it.key());
+            if (fromIt == from.cend())
+            {
+                outDiff->added.push_back(it.key());
+            }
+            else if (fromIt.value().sha256 != it.value().sha256)
+            {
+                outDiff->modified.push_back(it.key());
+            }
+        }
+        for (auto it = from.cbegin(); it != from.cend(); ++it)
+        {
+            if (!to.contains(it.key()))
+            {
+                outDiff->removed.push_back(it.key());
+            }
+        }
+        std::sort(outDiff->added.begin(), outDiff->added.end());
+        std::sort(outDiff->removed.begin(), outDiff->removed.end());
+        std::sort(outDiff->modified.begin(), outDiff->modified.end());
+    }
+
+    bool stageRestoredFile(const StoragePaths& paths, const QString& stagedPath, const FileRecord& record)
+    {
+        if (!QDir().mkpath(QFileInfo(stagedPath).absolutePath())
+            || !QFile::copy(paths.objectPath(record.sha256), stagedPath))
+        {
+            return false;
+        }
+
+        QFile stagedFile(stagedPath);
+        stagedFile.setPermissions(stagedFile.permissions() | QFileDevice::WriteOwner | QFileDevice::WriteUser);
+        if (stagedFile.open(QIODevice::ReadWrite))
+        {
+            stagedFile.setFileTime(
+                QDateTime::fromMSecsSinceEpoch(record.modifiedMs),
+                QFileDevice::FileModificationTime);
+            stagedFile.close();
+        }
+        return true;
+    }
+
+    bool moveFile(const QString& sourcePath, const QString& targetPath)
+    {
+        return QDir().mkpath(QFileInfo(targetPath).absolutePath()) && QFile::rename(sourcePath, targetPath);
+    }
+
+    // One rename performed while swapping a restore into the hub, kept so a failed swap can be rolled back.
+    struct SwapMove final
+    {
+        QString fromPath;
+        QString toPath;
+    };
+
+    void rollBackSwap(const QVector<SwapMove>& moves)
+    {
+        for (auto it = moves.crbegin(); it != moves.crend(); ++it)
+        {
+            if (!moveFile(it->toPath, it->fromPath))
+            {
+                WhatSon::Debug::trace(
+                    QStringLiteral("hub.snapshot"),
+                    QStringLiteral("restore.rollbackFailed"),
+                    QStringLiteral("from=%1 to=%2").arg(it->toPath, it->fromPath));
+            }
+        }
+    }
+} // namespace
+
+bool WhatSonHubSnapshotDiff::isEmpty() const noexcept
+{
+    return added.isEmpty() && removed.isEmpty() && modified.isEmpty();
+}
+
+WhatSonHubSnapshotStore::WhatSonHubSnapshotStore(QString hubPath)
+    : m_hubPath(WhatSon::HubPath::normalizeAbsolutePath(std::move(hubPath)))
+{
+}
+
+QString WhatSonHubSnapshotStore::hubPath() const
+{
+    return m_hubPath;
+}
+
+int WhatSonHubSnapshotStore::retentionCount() const noexcept
+{
+    return m_retentionCount;
+}
+
+void WhatSonHubSnapshotStore::setRetentionCount(const int retentionCount) noexcept
+{
+    m_retentionCount = std::max(0, retentionCount);
+}
+
+bool WhatSonHubSnapshotStore::createSnapshot(
+    const QString& label,
+    WhatSonHubSnapshotInfo* outInfo,
+    QString* errorMessage) const
+{
+    if (m_hubPath.isEmpty() || !QFileInfo(m_hubPath).isDir())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub directory does not exist: %1").arg(m_hubPath));
+    }
+
+    const StoragePaths paths(m_hubPath);
+    QDir().mkpath(paths.rootPath);
+    QLockFile lock(paths.lockPath);
+    if (!lock.tryLock(kLockTimeoutMs))
+    {
+        return failWith(errorMessage, QStringLiteral("Snapshot store is busy: %1").arg(paths.rootPath));
+    }
+
+    if (!createSnapshotLocked(paths, label, outInfo, errorMessage))
+    {
+        return false;
+    }
+    pruneSnapshotsLocked(paths, m_retentionCount);
+    return true;
+}
+
+void WhatSonHubSnapshotStore::createSnapshotInBackground(const QString& label) const
+{
+    const QString hubPath = m_hubPath;
+    const int retentionCount = m_retentionCount;
+    QThreadPool::globalInstance()->start(
+        [hubPath, retentionCount, label]()
+        {
+            WhatSonHubSnapshotStore store(hubPath);
+            store.setRetentionCount(retentionCount);
+            QString errorMessage;
+            if (!store.createSnapshot(label, nullptr, &errorMessage))
+            {
+                WhatSon::Debug::trace(
+                    QStringLiteral("hub.snapshot"),
+                    QStringLiteral("createInBackground.failed"),
+                    QStringLiteral("hub=%1 reason=%2").arg(hubPath, errorMessage));
+            }
+        });
+}
+
+QVector<WhatSonHubSnapshotInfo> WhatSonHubSnapshotStore::listSnapshots() const
+{
+    QVector<WhatSonHubSnapshotInfo> snapshots;
+    if (m_hubPath.isEmpty())
+    {
+        return snapshots;
+    }
+
+    const StoragePaths paths(m_hubPath);
+    for (const QString& snapshotId : snapshotIds(paths))
+    {
+        Manifest manifest;
+        if (readManifest(paths, snapshotId, &manifest, nullptr))
+        {
+            snapshots.push_back(manifest.info);
+        }
+    }
+    return snapshots;
+}
+
+bool WhatSonHubSnapshotStore::diffSnapshots(
+    const QString& fromSnapshotId,
+    const QString& toSnapshotId,
+    WhatSonHubSnapshotDiff* outDiff,
+    QString* errorMessage) const
+{
+    if (outDiff == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("outDiff must not be null."));
+    }
+    *outDiff = WhatSonHubSnapshotDiff();
+
+    const StoragePaths paths(m_hubPath);
+    Manifest from;
+    Manifest to;
+    if (!readManifest(paths, fromSnapshotId, &from, errorMessage)
+        || !readManifest(paths, toSnapshotId, &to, errorMessage))
+    {
+        return false;
+    }
+    diffRecords(from.files, to.files, outDiff);
+    return true;
+}
+
+bool WhatSonHubSnapshotStore::diffSnapshotAgainstHub(
+    const QString& snapshotId,
+    WhatSonHubSnapshotDiff* outDiff,
+    QString* errorMessage) const
+{
+    if (outDiff == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("outDiff must not be null."));
+    }
+    *outDiff = WhatSonHubSnapshotDiff();
+
+    const StoragePaths paths(m_hubPath);
+    Manifest snapshot;
+    if (!readManifest(paths, snapshotId, &snapshot, errorMessage))
+    {
+        return false;
+    }
+
+    QHash<QString, FileRecord> liveFiles = scanHub(m_hubPath).files;
+    for (auto it = liveFiles.begin(); it != liveFiles.end(); ++it)
+    {
+        const auto snapshotIt = snapshot.files.constFind(it.key());
+        if (snapshotIt == snapshot.files.cend())
+        {
+            continue;
+        }
+        // Only hash live files whose size matches but whose timestamp moved.
+        if (sameStat(snapshotIt.value(), it.value()))
+        {
+            it.value().sha256 = snapshotIt.value().sha256;
+        }
+        else if (it.value().size == snapshotIt.value().size)
+        {
+            it.value().sha256 = hashFile(QDir(m_hubPath).filePath(it.key()));
+        }
+    }
+    diffRecords(snapshot.files, liveFiles, outDiff);
+    return true;
+}
+
+bool WhatSonHubSnapshotStore::restoreSnapshot(const QString& snapshotId, QString* errorMessage) const
+{
+    if (m_hubPath.isEmpty() || !QFileInfo(m_hubPath).isDir())
+    {
+        return failWith(errorMessage, QStringLiteral("Hub directory does not exist: %1").arg(m_hubPath));
+    }
+
+    const StoragePaths paths(m_hubPath);
+    QLockFile lock(paths.lockPath);
+    if (!lock.tryLock(kLockTimeoutMs))
+    {
+        return failWith(errorMessage, QStringLiteral("Snapshot store is busy: %1").arg(paths.rootPath));
+    }
+
+    Manifest snapshot;
+    if (!readManifest(paths, snapshotId, &snapshot, errorMessage))
+    {
+        return false;
+    }
+    for (auto it = snapshot.files.cbegin(); it != snapshot.files.cend(); ++it)
+    {
+        if (!QFileInfo::exists(paths.objectPath(it.value().sha256)))
+        {
+            return failWith(errorMessage, QStringLiteral("Snapshot object is missing for: %1").arg(it.key()));
+        }
+    }
+
+    // An interrupted restore leaves its staging directory behind. Everything it displaced is also in the
+    // "Before restoring" snapshot that run took, so the leftovers can go.
+    const QStringList leftoverStagingNames = QDir(paths.rootPath).entryList(
+        QStringList{QStringLiteral("restore-*")},
+        QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& leftoverStagingName : leftoverStagingNames)
+    {
+        QDir(QDir(paths.rootPath).filePath(leftoverStagingName)).removeRecursively();
+    }
+
+    // Keep the pre-restore state reachable so a restore can itself be undone.
+    if (!createSnapshotLocked(
+            paths,
+            QStringLiteral("Before restoring %1").arg(snapshotId),
+            nullptr,
+            errorMessage))
+    {
+        return false;
+    }
+
+    const HubScan live = scanHub(m_hubPath);
+    const QDir hubDirectory(m_hubPath);
+    QStringList restoredPaths;
+    for (auto it = snapshot.files.cbegin(); it != snapshot.files.cend(); ++it)
+    {
+        const auto liveIt = live.files.constFind(it.key());
+        if (liveIt == live.files.cend() || !sameStat(liveIt.value(), it.value()))
+        {
+            restoredPaths.push_back(it.key());
+        }
+    }
+    QStringList removedPaths;
+    for (auto it = live.files.cbegin(); it != live.files.cend(); ++it)
+    {
+        if (!snapshot.files.contains(it.key()))
+        {
+            removedPaths.push_back(it.key());
+        }
+    }
+
+    // Stage every restored file next to the hub first. A copy failure here leaves the hub untouched.
+    const QDir stagingDirectory(paths.restoreStagingPath());
+    const QDir incomingDirectory(stagingDirectory.filePath(QStringLiteral("incoming")));
+    const QDir displacedDirectory(stagingDirectory.filePath(QStringLiteral("displaced")));
+    for (const QString& relativePath : std::as_const(restoredPaths))
+    {
+        if (!stageRestoredFile(paths, incomingDirectory.filePath(relativePath), snapshot.files.value(relativePath)))
+        {
+            QDir(stagingDirectory).removeRecursively();
+            return failWith(errorMessage, QStringLiteral("Failed to stage restored file: %1").arg(relativePath));
+        }
+    }
+
+    // Swap with renames only: displaced live files move aside, staged files move in. Any failure renames
+    // everything back, so the hub ends up either fully restored or exactly as it was.
+    QVector<SwapMove> moves;
+    const auto swapFailed = [&](const QString& relativePath)
+    {
+        rollBackSwap(moves);
+        QDir(stagingDirectory).removeRecursively();
+        return failWith(errorMessage, QStringLiteral("Failed to restore file: %1").arg(relativePath));
+    };
+    for (const QString& directory : std::as_const(snapshot.directories))
+    {
+        QDir().mkpath(hubDirectory.filePath(directory));
+    }
+    for (const QStringList* displacedPaths : {&restoredPaths, &removedPaths})
+    {
+        for (const QString& relativePath : *displacedPaths)
+        {
+            const QString livePath = hubDirectory.filePath(relativePath);
+            if (!live.files.contains(relativePath))
+            {
+                continue;
+            }
+            const SwapMove move{livePath, displacedDirectory.filePath(relativePath)};
+            if (!moveFile(move.fromPath, move.toPath))
+            {
+                return swapFailed(relativePath);
+            }
+            moves.push_back(move);
+        }
+    }
+    for (const QString& relativePath : std::as_const(restoredPaths))
+    {
+        const SwapMove move{incomingDirectory.filePath(relativePath), hubDirectory.filePath(relativePath)};
+        if (!moveFile(move.fromPath, move.toPath))
+        {
+            return swapFailed(relativePath);
+        }
+        moves.push_back(move);
+    }
+    const int restoredCount = static_cast<int>(restoredPaths.size());
+    const int removedCount = static_cast<int>(removedPaths.size());
+    QDir(stagingDirectory).removeRecursively();
+
+    const QSet<QString> snapshotDirectories(snapshot.directories.cbegin(), snapshot.directories.cend());
+    for (auto it = live.directories.crbegin(); it != live.directories.crend(); ++it)
+    {
+        if (!snapshotDirectories.contains(*it))
+        {
+            hubDirectory.rmdir(*it);
+        }
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.snapshot"),
+        QStringLiteral("restore.success"),
+        QStringLiteral("hub=%1 id=%2 restored=%3 removed=%4")
+            .arg(m_hubPath, snapshotId)
+            .arg(restoredCount)
+            .arg(removedCount));
+    pruneSnapshotsLocked(paths, m_retentionCount);
+    return true;
+}
+
+bool WhatSonHubSnapshotStore::removeSnapshot(const QString& snapshotId, QString* errorMessage) const
+{
+    const StoragePaths paths(m_hubPath);
+    if (!isValidSnapshotId(snapshotId) || !QFileInfo::exists(paths.manifestPath(snapshotId)))
+    {
+        return failWith(errorMessage, QStringLiteral("Snapshot not found: %1").arg(snapshotId));
+    }
+
+    QLockFile lock(paths.lockPath);
+    if (!lock.tryLock(kLockTimeoutMs))
+    {
+        return failWith(errorMessage, QStringLiteral("Snapshot store is busy: %1").arg(paths.rootPath));
+    }
+    if (!QFile::remove(paths.manifestPath(snapshotId)))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to remove snapshot: %1").arg(snapshotId));
+    }
+    collectGarbageLocked(paths);
+    return true;
+}
+
+int WhatSonHubSnapshotStore::pruneSnapshots(QString* errorMessage) const
+{
+    const StoragePaths paths(m_hubPath);
+    if (!QFileInfo(paths.rootPath).isDir())
+    {
+        return 0;
+    }
+
+    QLockFile lock(paths.lockPath);
+    if (!lock.tryLock(kLockTimeoutMs))
+    {
+        failWith(errorMessage, QStringLiteral("Snapshot store is busy: %1").arg(paths.rootPath));
+        return -1;
+    }
+    return pruneSnapshotsLocked(paths, m_retentionCount);
+}
+
+QString WhatSonHubSnapshotStore::storageRelativePath()
+{
+    return QStringLiteral(".whatson/snapshots");
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct WhatSonHubSnapshotInfo final
+{
+    QString id;
+    QString label;
+    QString createdAtUtc;
+    int fileCount = 0;
+    qint64 totalBytes = 0;
+    qint64 storedBytes = 0;
+};
+
+struct WhatSonHubSnapshotDiff final
+{
+    QStringList added;
+    QStringList removed;
+    QStringList modified;
+
+    bool isEmpty() const noexcept;
+};
+
+class WhatSonHubSnapshotStore final
+{
+public:
+    explicit WhatSonHubSnapshotStore(QString hubPath);
+
+    QString hubPath() const;
+
+    int retentionCount() const noexcept;
+    void setRetentionCount(int retentionCount) noexcept;
+
+    bool createSnapshot(
+        const QString& label,
+        WhatSonHubSnapshotInfo* outInfo = nullptr,
+        QString* errorMessage = nullptr) const;
+    void createSnapshotInBackground(const QString& label) const;
+
+    QVector<WhatSonHubSnapshotInfo> listSnapshots() const;
+    bool diffSnapshots(
+        const QString& fromSnapshotId,
+        const QString& toSnapshotId,
+        WhatSonHubSnapshotDiff* outDiff,
+        QString* errorMessage = nullptr) const;
+    bool diffSnapshotAgainstHub(
+        const QString& snapshotId,
+        WhatSonHubSnapshotDiff* outDiff,
+        QString* errorMessage = nullptr) const;
+    bool restoreSnapshot(const QString& snapshotId, QString* errorMessage = nullptr) const;
+    bool removeSnapshot(const QString& snapshotId, QString* errorMessage = nullptr) const;
+    int pruneSnapshots(QString* errorMessage = nullptr) const;
+
+    static QString storageRelativePath();
+
+private:
+    QString m_hubPath;
+    int m_retentionCount = 10;
+};
@@ -48,6 +48,33 @@ WhatSonHubStat::WhatSonHubStat() = default;
 
 WhatSonHubStat::~WhatSonHubStat() = default;
 
+QStringList WhatSonHubStat::noteCountKeys()
+{
+    return {
+        QStringLiteral("noteCount"),
+        QStringLiteral("notes"),
+        QStringLiteral("totalNotes")
+    };
+}
+
+QStringList WhatSonHubStat::resourceCountKeys()
+{
+    return {
+        QStringLiteral("resourceCount"),
+        QStringLiteral("resources"),
+        QStringLiteral("totalResources")
+    };
+}
+
+QStringList WhatSonHubStat::characterCountKeys()
+{
+    return {
+        QStringLiteral("characterCount"),
+        QStringLiteral("characters"),
+        QStringLiteral("textLength")
+    };
+}
+
 void WhatSonHubStat::clear()
 {
     m_noteCount = 0;
@@ -10,6 +10,11 @@ public:
     WhatSonHubStat();
     ~WhatSonHubStat();
 
+    // .wsstat count keys; the first entry is the key writers emit, the rest are legacy aliases readers accept.
+    static QStringList noteCountKeys();
+    static QStringList resourceCountKeys();
+    static QStringList characterCountKeys();
+
     void clear();
 
     int noteCount() const noexcept;
@@ -0,0 +1,188 @@
+#include "app/models/file/hub/WhatSonHubSymbolTable.hpp"
+
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/note/folder/WhatSonNoteFolderSemantics.hpp"
+#include "app/models/hierarchy/WhatSonFolderIdentity.hpp"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace
+{
+    struct SymbolTableRegistry final
+    {
+        QMutex mutex;
+        QHash<QString, std::weak_ptr<WhatSonHubSymbolTable>> tables;
+    };
+
+    SymbolTableRegistry& registry()
+    {
+        static SymbolTableRegistry instance;
+        return instance;
+    }
+
+    qint64 stringFootprintBytes(const QString& text)
+    {
+        // QString payload: UTF-16 characters plus the shared data header and terminator.
+        return static_cast<qint64>(sizeof(QString)) + (text.isEmpty() ? 0 : (text.size() + 1) * 2 + 16);
+    }
+} // namespace
+
+std::shared_ptr<WhatSonHubSymbolTable> WhatSonHubSymbolTable::forHub(const QString& hubPath)
+{
+    const QString normalizedHubPath = WhatSon::HubPath::normalizePath(hubPath);
+    if (normalizedHubPath.isEmpty())
+    {
+        return std::make_shared<WhatSonHubSymbolTable>();
+    }
+
+    SymbolTableRegistry& tableRegistry = registry();
+    QMutexLocker locker(&tableRegistry.mutex);
+    std::shared_ptr<WhatSonHubSymbolTable> table = tableRegistry.tables.value(normalizedHubPath).lock();
+    if (table == nullptr)
+    {
+        for (auto it = tableRegistry.tables.begin(); it != tableRegistry.tables.end();)
+        {
+            if (it.value().expired())
+            {
+                it = tableRegistry.tables.erase(it);
+                continue;
+            }
+            ++it;
+        }
+        table = std::make_shared<WhatSonHubSymbolTable>();
+        tableRegistry.tables.insert(normalizedHubPath, table);
+    }
+    return table;
+}
+
+QString WhatSonHubSymbolTable::normalize(Kind kind, const QString& text)
+{
+    switch (kind)
+    {
+    case Kind::NoteId:
+    case Kind::Tag:
+        return text.trimmed();
+    case Kind::FolderUuid:
+        return WhatSon::FolderIdentity::normalizeFolderUuid(text);
+    case Kind::FolderPath:
+        // Folder paths and project names are matched case-insensitively everywhere they are compared.
+        return WhatSon::NoteFolders::normalizeFolderPath(text).toCaseFolded();
+    case Kind::Project:
+        return text.trimmed().toCaseFolded();
+    }
+    return {};
+}
+
+int WhatSonHubSymbolTable::intern(Kind kind, const QString& text)
+{
+    return internNormalized(kind, normalize(kind, text));
+}
+
+int WhatSonHubSymbolTable::internNormalized(Kind kind, const QString& normalizedText)
+{
+    if (normalizedText.isEmpty())
+    {
+        return kNoSymbol;
+    }
+
+    {
+        QReadLocker locker(&m_lock);
+        const Pool& symbols = pool(kind);
+        const auto existing = symbols.symbolByText.constFind(normalizedText);
+        if (existing != symbols.symbolByText.constEnd())
+        {
+            return existing.value();
+        }
+    }
+
+    QWriteLocker locker(&m_lock);
+    Pool& symbols = pool(kind);
+    const auto existing = symbols.symbolByText.constFind(normalizedText);
+    if (existing != symbols.symbolByText.constEnd())
+    {
+        return existing.value();
+    }
+
+    const int symbol = static_cast<int>(symbols.textBySymbol.size());
+    symbols.textBySymbol.push_back(normalizedText);
+    symbols.symbolByText.insert(normalizedText, symbol);
+    return symbol;
+}
+
+int WhatSonHubSymbolTable::find(Kind kind, const QString& text) const
+{
+    return findNormalized(kind, normalize(kind, text));
+}
+
+int WhatSonHubSymbolTable::findNormalized(Kind kind, const QString& normalizedText) const
+{
+    if (normalizedText.isEmpty())
+    {
+        return kNoSymbol;
+    }
+    QReadLocker locker(&m_lock);
+    return pool(kind).symbolByText.value(normalizedText, kNoSymbol);
+}
+
+QString WhatSonHubSymbolTable::text(Kind kind, int symbol) const
+{
+    QReadLocker locker(&m_lock);
+    const Pool& symbols = pool(kind);
+    if (symbol < 0 || symbol >= symbols.textBySymbol.size())
+    {
+        return {};
+    }
+    return symbols.textBySymbol.at(symbol);
+}
+
+int WhatSonHubSymbolTable::count(Kind kind) const
+{
+    QReadLocker locker(&m_lock);
+    return static_cast<int>(pool(kind).textBySymbol.size());
+}
+
+void WhatSonHubSymbolTable::reserve(Kind kind, int expectedCount)
+{
+    QWriteLocker locker(&m_lock);
+    Pool& symbols = pool(kind);
+    symbols.symbolByText.reserve(expectedCount);
+    symbols.textBySymbol.reserve(expectedCount);
+}
+
+void WhatSonHubSymbolTable::clear()
+{
+    QWriteLocker locker(&m_lock);
+    for (Pool& symbols : m_pools)
+    {
+        symbols.symbolByText.clear();
+        symbols.textBySymbol.clear();
+    }
+}
+
+qint64 WhatSonHubSymbolTable::memoryFootprintBytes() const
+{
+    QReadLocker locker(&m_lock);
+    qint64 bytes = sizeof(WhatSonHubSymbolTable);
+    for (const Pool& symbols : m_pools)
+    {
+        // The hash key shares its payload with textBySymbol, so only the node overhead is counted for it.
+        bytes += static_cast<qint64>(symbols.symbolByText.capacity()) * (sizeof(QString) + sizeof(int) + 8);
+        bytes += static_cast<qint64>(symbols.textBySymbol.capacity() - symbols.textBySymbol.size()) * sizeof(QString);
+        for (const QString& text : symbols.textBySymbol)
+        {
+            bytes += stringFootprintBytes(text);
+        }
+    }
+    return bytes;
+}
+
+WhatSonHubSymbolTable::Pool& WhatSonHubSymbolTable::pool(Kind kind) noexcept
+{
+    return m_pools[static_cast<std::size_t>(kind)];
+}
+
+const WhatSonHubSymbolTable::Pool& WhatSonHubSymbolTable::pool(Kind kind) const noexcept
+{
+    return m_pools[static_cast<std::size_t>(kind)];
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+
+#include <array>
+#include <memory>
+
+// Interns the identifiers a hub index compares over and over (note ids, folder uuids and paths, tags, projects) into
+// dense per-kind integers. Each kind applies its own normalization once, at intern time, so callers can hash, compare
+// and store symbols instead of re-trimming and case-folding strings. forHub() hands every index of one hub the same
+// table, so a symbol means the same thing in LibraryAll, its facets and the folder note-count index. Domain loads
+// intern from worker threads, so every call takes the table's own lock.
+class WhatSonHubSymbolTable final
+{
+public:
+    enum class Kind
+    {
+        NoteId,
+        FolderUuid,
+        FolderPath,
+        Tag,
+        Project
+    };
+
+    static constexpr int kNoSymbol = -1;
+
+    WhatSonHubSymbolTable() = default;
+    WhatSonHubSymbolTable(const WhatSonHubSymbolTable&) = delete;
+    WhatSonHubSymbolTable& operator=(const WhatSonHubSymbolTable&) = delete;
+
+    // The live table for `hubPath`, created on first use and dropped with its last owner. An empty path returns a
+    // private table that nothing else shares.
+    static std::shared_ptr<WhatSonHubSymbolTable> forHub(const QString& hubPath);
+    static QString normalize(Kind kind, const QString& text);
+
+    int intern(Kind kind, const QString& text);
+    int internNormalized(Kind kind, const QString& normalizedText);
+    int find(Kind kind, const QString& text) const;
+    int findNormalized(Kind kind, const QString& normalizedText) const;
+    QString text(Kind kind, int symbol) const;
+    int count(Kind kind) const;
+    void reserve(Kind kind, int expectedCount);
+    void clear();
+
+    qint64 memoryFootprintBytes() const;
+
+private:
+    struct Pool final
+    {
+        QHash<QString, int> symbolByText;
+        QVector<QString> textBySymbol;
+    };
+
+    static constexpr int kKindCount = 5;
+
+    Pool& pool(Kind kind) noexcept;
+    const Pool& pool(Kind kind) const noexcept;
+
+    mutable QReadWriteLock m_lock;
+    std::array<Pool, kKindCount> m_pools;
+};
@@ -0,0 +1,837 @@
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/hub/WhatSonHubSnapshotStore.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSet>
+#include <QUuid>
+
+#include <utility>
+
+namespace
+{
+    constexpr int kJournalVersion = 1;
+
+    struct JournalRegistry final
+    {
+        QMutex mutex;
+        QHash<QString, std::shared_ptr<WhatSonHubMutationJournal>> journals;
+        QString batchLabel;
+        int batchDepth = 0;
+    };
+
+    JournalRegistry& registry()
+    {
+        static JournalRegistry instance;
+        return instance;
+    }
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    bool isPrivateBookkeepingPath(const QString& relativePath)
+    {
+        return relativePath == QStringLiteral(".whatson") || relativePath.startsWith(QStringLiteral(".whatson/"));
+    }
+
+    // Top-level hub directories and library roots survive even when undo leaves them empty.
+    bool isStructuralDirectory(const QString& relativeDirectoryPath)
+    {
+        return relativeDirectoryPath == QStringLiteral(".")
+            || !relativeDirectoryPath.contains(QLatin1Char('/'))
+            || relativeDirectoryPath.endsWith(QStringLiteral(".wslibrary"));
+    }
+
+    bool readFileBytes(const QString& filePath, QByteArray* outBytes)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return false;
+        }
+        *outBytes = file.readAll();
+        return true;
+    }
+
+    bool writeFileBytes(const QString& filePath, const QByteArray& bytes)
+    {
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath()))
+        {
+            return false;
+        }
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            return false;
+        }
+        return file.write(bytes) == bytes.size() && file.commit();
+    }
+
+    QString objectIdForBytes(const QByteArray& bytes)
+    {
+        return QString::fromLatin1(QCryptographicHash::hash(bytes, QCryptographicHash::Sha256).toHex());
+    }
+
+    QJsonObject stepToJson(const WhatSonHubMutationJournal::Step& step)
+    {
+        QJsonArray entries;
+        for (const WhatSonHubMutationJournal::Entry& entry : step.entries)
+        {
+            entries.append(QJsonObject{
+                {QStringLiteral("path"), entry.relativePath},
+                {QStringLiteral("before"), entry.beforeObjectId},
+                {QStringLiteral("after"), entry.afterObjectId}
+            });
+        }
+        return QJsonObject{
+            {QStringLiteral("id"), step.stepId},
+            {QStringLiteral("label"), step.label},
+            {QStringLiteral("createdAtUtc"), step.createdAtUtc},
+            {QStringLiteral("entries"), entries}
+        };
+    }
+
+    WhatSonHubMutationJournal::Step stepFromJson(const QJsonObject& object)
+    {
+        WhatSonHubMutationJournal::Step step;
+        step.stepId = object.value(QStringLiteral("id")).toString();
+        step.label = object.value(QStringLiteral("label")).toString();
+        step.createdAtUtc = object.value(QStringLiteral("createdAtUtc")).toString();
+        const QJsonArray entries = object.value(QStringLiteral("entries")).toArray();
+        step.entries.reserve(entries.size());
+        for (const QJsonValue& value : entries)
+        {
+            const QJsonObject entryObject = value.toObject();
+            WhatSonHubMutationJournal::Entry entry;
+            entry.relativePath = entryObject.value(QStringLiteral("path")).toString();
+            entry.beforeObjectId = entryObject.value(QStringLiteral("before")).toString();
+            entry.afterObjectId = entryObject.value(QStringLiteral("after")).toString();
+            if (!entry.relativePath.isEmpty() && !isPrivateBookkeepingPath(entry.relativePath))
+            {
+                step.entries.push_back(std::move(entry));
+            }
+        }
+        return step;
+    }
+} // namespace
+
+WhatSonHubMutationJournal::Scope::Scope(const QString& mutatedPath, QString label)
+    : m_journal(WhatSonHubMutationJournal::forPath(mutatedPath))
+{
+    if (m_journal == nullptr)
+    {
+        return;
+    }
+
+    QString errorMessage;
+    if (!m_journal->beginStep(label, &errorMessage) || !m_journal->recordPath(mutatedPath, &errorMessage))
+    {
+        WhatSon::Debug::trace(QStringLiteral("hub.journal"),
+                              QStringLiteral("scope.disabled"),
+                              QStringLiteral("path=%1 reason=%2").arg(mutatedPath, errorMessage));
+        if (m_journal->hasOpenStep())
+        {
+            m_journal->abortStep();
+        }
+        m_journal.reset();
+    }
+}
+
+WhatSonHubMutationJournal::Scope::~Scope()
+{
+    if (m_journal != nullptr && !m_finished)
+    {
+        m_journal->abortStep();
+    }
+}
+
+bool WhatSonHubMutationJournal::Scope::isActive() const noexcept
+{
+    return m_journal != nullptr && !m_finished;
+}
+
+void WhatSonHubMutationJournal::Scope::record(const QString& path)
+{
+    if (!isActive())
+    {
+        return;
+    }
+
+    QString errorMessage;
+    if (!m_journal->recordPath(path, &errorMessage))
+    {
+        WhatSon::Debug::trace(QStringLiteral("hub.journal"),
+                              QStringLiteral("scope.recordFailed"),
+                              QStringLiteral("path=%1 reason=%2").arg(path, errorMessage));
+    }
+}
+
+bool WhatSonHubMutationJournal::Scope::commit(QString* errorMessage)
+{
+    if (!isActive())
+    {
+        return true;
+    }
+
+    m_finished = true;
+    return m_journal->commitStep(errorMessage);
+}
+
+WhatSonHubMutationJournal::BatchScope::BatchScope(QString label)
+{
+    WhatSonHubMutationJournal::beginBatch(label.trimmed());
+}
+
+WhatSonHubMutationJournal::BatchScope::~BatchScope()
+{
+    WhatSonHubMutationJournal::endBatch();
+}
+
+WhatSonHubMutationJournal::WhatSonHubMutationJournal(QString hubPath)
+    : m_hubPath(WhatSon::HubPath::normalizePath(hubPath))
+{
+    load();
+}
+
+WhatSonHubMutationJournal::~WhatSonHubMutationJournal() = default;
+
+std::shared_ptr<WhatSonHubMutationJournal> WhatSonHubMutationJournal::forHub(const QString& hubPath)
+{
+    const QString normalizedHubPath = WhatSon::HubPath::normalizePath(hubPath);
+    if (normalizedHubPath.isEmpty() || !QFileInfo(normalizedHubPath).isDir())
+    {
+        return {};
+    }
+
+    JournalRegistry& journalRegistry = registry();
+    QMutexLocker locker(&journalRegistry.mutex);
+    std::shared_ptr<WhatSonHubMutationJournal>& journal = journalRegistry.journals[normalizedHubPath];
+    if (journal == nullptr)
+    {
+        journal = std::make_shared<WhatSonHubMutationJournal>(normalizedHubPath);
+    }
+    return journal;
+}
+
+std::shared_ptr<WhatSonHubMutationJournal> WhatSonHubMutationJournal::forPath(const QString& path)
+{
+    return forHub(hubPathForPath(path));
+}
+
+QString WhatSonHubMutationJournal::hubPathForPath(const QString& path)
+{
+    QString candidate = WhatSon::HubPath::normalizePath(path);
+    while (!candidate.isEmpty())
+    {
+        if (candidate.endsWith(QStringLiteral(".wshub")))
+        {
+            return candidate;
+        }
+        const QString parentPath = QFileInfo(candidate).absolutePath();
+        if (parentPath == candidate)
+        {
+            break;
+        }
+        candidate = parentPath;
+    }
+    return {};
+}
+
+QString WhatSonHubMutationJournal::storageRelativePath()
+{
+    return QStringLiteral(".whatson/journal");
+}
+
+QString WhatSonHubMutationJournal::hubPath() const
+{
+    return m_hubPath;
+}
+
+QString WhatSonHubMutationJournal::journalDirectoryPath() const
+{
+    return QDir(m_hubPath).filePath(storageRelativePath());
+}
+
+int WhatSonHubMutationJournal::maximumStepCount() const noexcept
+{
+    return m_maximumStepCount;
+}
+
+void WhatSonHubMutationJournal::setMaximumStepCount(const int maximumStepCount)
+{
+    m_maximumStepCount = maximumStepCount > 0 ? maximumStepCount : 1;
+}
+
+bool WhatSonHubMutationJournal::beginStep(const QString& label, QString* errorMessage)
+{
+    if (m_hubPath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Mutation journal has no hub path."));
+    }
+
+    if (m_pendingStep == nullptr)
+    {
+        m_pendingStep = std::make_unique<PendingStep>();
+        m_pendingStep->label = label.trimmed();
+
+        JournalRegistry& journalRegistry = registry();
+        QMutexLocker locker(&journalRegistry.mutex);
+        m_batchOwned = journalRegistry.batchDepth > 0;
+        if (m_batchOwned && !journalRegistry.batchLabel.isEmpty())
+        {
+            m_pendingStep->label = journalRegistry.batchLabel;
+        }
+        locker.unlock();
+
+        // Bulk operations also get a whole-hub snapshot, taken before the batch touches its first file here.
+        QString snapshotError;
+        if (m_batchOwned
+            && !WhatSonHubSnapshotStore(m_hubPath).createSnapshot(
+                QStringLiteral("Before %1").arg(m_pendingStep->label),
+                nullptr,
+                &snapshotError))
+        {
+            WhatSon::Debug::trace(QStringLiteral("hub.journal"),
+                                  QStringLiteral("batch.snapshotFailed"),
+                                  QStringLiteral("hub=%1 reason=%2").arg(m_hubPath, snapshotError));
+        }
+    }
+    ++m_pendingStep->depth;
+    return true;
+}
+
+bool WhatSonHubMutationJournal::recordPath(const QString& path, QString* errorMessage)
+{
+    if (m_pendingStep == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("No open journal step."));
+    }
+
+    const QString relativePath = relativePathFor(path);
+    if (relativePath.isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("Path is not journaled for this hub: %1").arg(path));
+    }
+
+    const QString absolutePath = QDir(m_hubPath).filePath(relativePath);
+    if (!QFileInfo(absolutePath).isDir())
+    {
+        return captureFile(relativePath, errorMessage);
+    }
+
+    if (!m_pendingStep->relativeDirectoryPaths.contains(relativePath))
+    {
+        m_pendingStep->relativeDirectoryPaths.push_back(relativePath);
+    }
+    const QDir hubDirectory(m_hubPath);
+    QDirIterator iterator(
+        absolutePath,
+        QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+        QDirIterator::Subdirectories);
+    while (iterator.hasNext())
+    {
+        if (!captureFile(hubDirectory.relativeFilePath(iterator.next()), errorMessage))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WhatSonHubMutationJournal::commitStep(QString* errorMessage)
+{
+    if (m_pendingStep == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("No open journal step."));
+    }
+
+    --m_pendingStep->depth;
+    if (m_pendingStep->depth > 0 || m_batchOwned)
+    {
+        return true;
+    }
+    return flushPendingStep(errorMessage);
+}
+
+void WhatSonHubMutationJournal::abortStep()
+{
+    if (m_pendingStep == nullptr)
+    {
+        return;
+    }
+
+    // An aborted scope inside a batch keeps its before-images; files it never changed are dropped on flush.
+    --m_pendingStep->depth;
+    if (m_pendingStep->depth <= 0 && !m_batchOwned)
+    {
+        m_pendingStep.reset();
+    }
+}
+
+bool WhatSonHubMutationJournal::hasOpenStep() const noexcept
+{
+    return m_pendingStep != nullptr;
+}
+
+bool WhatSonHubMutationJournal::canUndo() const noexcept
+{
+    return m_cursor > 0;
+}
+
+bool WhatSonHubMutationJournal::canRedo() const noexcept
+{
+    return m_cursor < m_steps.size();
+}
+
+QString WhatSonHubMutationJournal::undoLabel() const
+{
+    return canUndo() ? m_steps.at(m_cursor - 1).label : QString();
+}
+
+QString WhatSonHubMutationJournal::redoLabel() const
+{
+    return canRedo() ? m_steps.at(m_cursor).label : QString();
+}
+
+QVector<WhatSonHubMutationJournal::Step> WhatSonHubMutationJournal::steps() const
+{
+    return m_steps;
+}
+
+int WhatSonHubMutationJournal::cursor() const noexcept
+{
+    return m_cursor;
+}
+
+bool WhatSonHubMutationJournal::undo(QStringList* outTouchedPaths, QString* errorMessage)
+{
+    if (m_pendingStep != nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("Cannot undo while a mutation is in progress."));
+    }
+    if (!canUndo())
+    {
+        return failWith(errorMessage, QStringLiteral("Nothing to undo."));
+    }
+
+    if (!applyStep(m_steps.at(m_cursor - 1), false, outTouchedPaths, errorMessage))
+    {
+        return false;
+    }
+    --m_cursor;
+    return save(errorMessage);
+}
+
+bool WhatSonHubMutationJournal::redo(QStringList* outTouchedPaths, QString* errorMessage)
+{
+    if (m_pendingStep != nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("Cannot redo while a mutation is in progress."));
+    }
+    if (!canRedo())
+    {
+        return failWith(errorMessage, QStringLiteral("Nothing to redo."));
+    }
+
+    if (!applyStep(m_steps.at(m_cursor), true, outTouchedPaths, errorMessage))
+    {
+        return false;
+    }
+    ++m_cursor;
+    return save(errorMessage);
+}
+
+bool WhatSonHubMutationJournal::clear(QString* errorMessage)
+{
+    m_pendingStep.reset();
+    m_batchOwned = false;
+    m_steps.clear();
+    m_cursor = 0;
+    const bool saved = save(errorMessage);
+    collectUnreferencedObjects();
+    return saved;
+}
+
+void WhatSonHubMutationJournal::beginBatch(const QString& label)
+{
+    JournalRegistry& journalRegistry = registry();
+    QMutexLocker locker(&journalRegistry.mutex);
+    if (journalRegistry.batchDepth == 0)
+    {
+        journalRegistry.batchLabel = label;
+    }
+    ++journalRegistry.batchDepth;
+}
+
+void WhatSonHubMutationJournal::endBatch()
+{
+    QVector<std::shared_ptr<WhatSonHubMutationJournal>> journals;
+    {
+        JournalRegistry& journalRegistry = registry();
+        QMutexLocker locker(&journalRegistry.mutex);
+        if (journalRegistry.batchDepth <= 0 || --journalRegistry.batchDepth > 0)
+        {
+            return;
+        }
+        journalRegistry.batchLabel.clear();
+        for (const std::shared_ptr<WhatSonHubMutationJournal>& journal : std::as_const(journalRegistry.journals))
+        {
+            journals.push_back(journal);
+        }
+    }
+
+    for (const std::shared_ptr<WhatSonHubMutationJournal>& journal : std::as_const(journals))
+    {
+        if (!journal->m_batchOwned || journal->m_pendingStep == nullptr)
+        {
+            continue;
+        }
+        journal->m_batchOwned = false;
+        if (journal->m_pendingStep->depth > 0)
+        {
+            continue;
+        }
+
+        QString errorMessage;
+        if (!journal->flushPendingStep(&errorMessage))
+        {
+            WhatSon::Debug::trace(QStringLiteral("hub.journal"),
+                                  QStringLiteral("batch.flushFailed"),
+                                  QStringLiteral("hub=%1 reason=%2").arg(journal->hubPath(), errorMessage));
+        }
+    }
+}
+
+QString WhatSonHubMutationJournal::objectsDirectoryPath() const
+{
+    return QDir(journalDirectoryPath()).filePath(QStringLiteral("objects"));
+}
+
+QString WhatSonHubMutationJournal::journalFilePath() const
+{
+    return QDir(journalDirectoryPath()).filePath(QStringLiteral("journal.json"));
+}
+
+QString WhatSonHubMutationJournal::relativePathFor(const QString& path) const
+{
+    const QString normalizedPath = WhatSon::HubPath::normalizePath(path);
+    if (normalizedPath.isEmpty() || m_hubPath.isEmpty())
+    {
+        return {};
+    }
+
+    const QString relativePath = QDir::cleanPath(QDir(m_hubPath).relativeFilePath(normalizedPath));
+    if (relativePath.isEmpty()
+        || relativePath == QStringLiteral(".")
+        || relativePath.startsWith(QStringLiteral("../"))
+        || relativePath == QStringLiteral("..")
+        || QDir::isAbsolutePath(relativePath)
+        || isPrivateBookkeepingPath(relativePath))
+    {
+        return {};
+    }
+    return relativePath;
+}
+
+bool WhatSonHubMutationJournal::captureFile(const QString& relativePath, QString* errorMessage)
+{
+    if (m_pendingStep->beforeObjectIds.contains(relativePath))
+    {
+        return true;
+    }
+
+    QString objectId;
+    if (!storeObject(relativePath, &objectId, errorMessage))
+    {
+        return false;
+    }
+    m_pendingStep->relativePaths.push_back(relativePath);
+    m_pendingStep->beforeObjectIds.insert(relativePath, objectId);
+    return true;
+}
+
+bool WhatSonHubMutationJournal::storeObject(
+    const QString& relativePath,
+    QString* outObjectId,
+    QString* errorMessage) const
+{
+    outObjectId->clear();
+    const QString absolutePath = QDir(m_hubPath).filePath(relativePath);
+    if (!QFileInfo(absolutePath).isFile())
+    {
+        return true;
+    }
+
+    QByteArray bytes;
+    if (!readFileBytes(absolutePath, &bytes))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to read journaled file: %1").arg(absolutePath));
+    }
+
+    const QString objectId = objectIdForBytes(bytes);
+    const QString objectPath = QDir(objectsDirectoryPath()).filePath(objectId.left(2) + QLatin1Char('/') + objectId);
+    if (!QFileInfo::exists(objectPath) && !writeFileBytes(objectPath, bytes))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to write journal object: %1").arg(objectPath));
+    }
+    *outObjectId = objectId;
+    return true;
+}
+
+QString WhatSonHubMutationJournal::currentObjectId(const QString& relativePath) const
+{
+    QByteArray bytes;
+    if (!readFileBytes(QDir(m_hubPath).filePath(relativePath), &bytes))
+    {
+        return {};
+    }
+    return objectIdForBytes(bytes);
+}
+
+bool WhatSonHubMutationJournal::applyStep(
+    const Step& step,
+    const bool forward,
+    QStringList* outTouchedPaths,
+    QString* errorMessage)
+{
+    const QDir hubDirectory(m_hubPath);
+    const QDir objectsDirectory(objectsDirectoryPath());
+
+    // Validate the whole step before touching the hub, so a conflicting external edit leaves every file untouched.
+    QHash<QString, QByteArray> targetBytes;
+    for (const Entry& entry : step.entries)
+    {
+        const QString expectedObjectId = forward ? entry.beforeObjectId : entry.afterObjectId;
+        const QString targetObjectId = forward ? entry.afterObjectId : entry.beforeObjectId;
+        if (currentObjectId(entry.relativePath) != expectedObjectId)
+        {
+            return failWith(
+                errorMessage,
+                QStringLiteral("%1 changed outside the journal since \"%2\".").arg(entry.relativePath, step.label));
+        }
+        if (targetObjectId.isEmpty() || targetBytes.contains(targetObjectId))
+        {
+            continue;
+        }
+
+        QByteArray bytes;
+        if (!readFileBytes(objectsDirectory.filePath(targetObjectId.left(2) + QLatin1Char('/') + targetObjectId), &bytes)
+            || objectIdForBytes(bytes) != targetObjectId)
+        {
+            return failWith(errorMessage, QStringLiteral("Journal object is missing or corrupt: %1").arg(targetObjectId));
+        }
+        targetBytes.insert(targetObjectId, bytes);
+    }
+
+    QStringList touchedPaths;
+    touchedPaths.reserve(step.entries.size());
+    for (const Entry& entry : step.entries)
+    {
+        const QString targetObjectId = forward ? entry.afterObjectId : entry.beforeObjectId;
+        const QString absolutePath = hubDirectory.filePath(entry.relativePath);
+        if (targetObjectId.isEmpty())
+        {
+            if (QFileInfo::exists(absolutePath) && !QFile::remove(absolutePath))
+            {
+                return failWith(errorMessage, QStringLiteral("Failed to remove %1").arg(absolutePath));
+            }
+
+            QString parentRelativePath = QFileInfo(entry.relativePath).path();
+            while (!isStructuralDirectory(parentRelativePath) && hubDirectory.rmdir(parentRelativePath))
+            {
+                parentRelativePath = QFileInfo(parentRelativePath).path();
+            }
+        }
+        else if (!writeFileBytes(absolutePath, targetBytes.value(targetObjectId)))
+        {
+            return failWith(errorMessage, QStringLiteral("Failed to restore %1").arg(absolutePath));
+        }
+        touchedPaths.push_back(absolutePath);
+    }
+
+    if (outTouchedPaths != nullptr)
+    {
+        *outTouchedPaths = std::move(touchedPaths);
+    }
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hub.journal"),
+                              forward ? QStringLiteral("redo") : QStringLiteral("undo"),
+                              QStringLiteral("hub=%1 step=%2 label=%3 files=%4")
+                              .arg(m_hubPath, step.stepId, step.label)
+                              .arg(step.entries.size()));
+    return true;
+}
+
+bool WhatSonHubMutationJournal::flushPendingStep(QString* errorMessage)
+{
+    const std::unique_ptr<PendingStep> pendingStep = std::move(m_pendingStep);
+    m_batchOwned = false;
+
+    QStringList relativePaths = pendingStep->relativePaths;
+    QSet<QString> knownPaths(relativePaths.cbegin(), relativePaths.cend());
+    const QDir hubDirectory(m_hubPath);
+    for (const QString& relativeDirectoryPath : std::as_const(pendingStep->relativeDirectoryPaths))
+    {
+        QDirIterator iterator(
+            hubDirectory.filePath(relativeDirectoryPath),
+            QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+            QDirIterator::Subdirectories);
+        while (iterator.hasNext())
+        {
+            const QString relativePath = hubDirectory.relativeFilePath(iterator.next());
+            if (!knownPaths.contains(relativePath))
+            {
+                knownPaths.insert(relativePath);
+                relativePaths.push_back(relativePath);
+            }
+        }
+    }
+
+    Step step;
+    step.label = pendingStep->label;
+    for (const QString& relativePath : std::as_const(relativePaths))
+    {
+        Entry entry;
+        entry.relativePath = relativePath;
+        entry.beforeObjectId = pendingStep->beforeObjectIds.value(relativePath);
+        if (!storeObject(relativePath, &entry.afterObjectId, errorMessage))
+        {
+            return false;
+        }
+        if (entry.beforeObjectId != entry.afterObjectId)
+        {
+            step.entries.push_back(std::move(entry));
+        }
+    }
+    if (step.entries.isEmpty())
+    {
+        return true;
+    }
+
+    step.stepId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    step.createdAtUtc = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+
+    const bool droppedRedoSteps = m_cursor < m_steps.size();
+    m_steps.resize(m_cursor);
+    m_steps.push_back(std::move(step));
+    const qsizetype overflow = m_steps.size() - m_maximumStepCount;
+    if (overflow > 0)
+    {
+        m_steps.remove(0, overflow);
+    }
+    m_cursor = static_cast<int>(m_steps.size());
+
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hub.journal"),
+                              QStringLiteral("commit"),
+                              QStringLiteral("hub=%1 label=%2 files=%3 steps=%4")
+                              .arg(m_hubPath, m_steps.constLast().label)
+                              .arg(m_steps.constLast().entries.size())
+                              .arg(m_steps.size()));
+    if (!save(errorMessage))
+    {
+        return false;
+    }
+    if (droppedRedoSteps || overflow > 0)
+    {
+        collectUnreferencedObjects();
+    }
+    return true;
+}
+
+void WhatSonHubMutationJournal::load()
+{
+    m_steps.clear();
+    m_cursor = 0;
+
+    QByteArray bytes;
+    if (!readFileBytes(journalFilePath(), &bytes))
+    {
+        return;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(bytes, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()
+        || document.object().value(QStringLiteral("version")).toInt() != kJournalVersion)
+    {
+        WhatSon::Debug::traceSelf(this,
+                                  QStringLiteral("hub.journal"),
+                                  QStringLiteral("load.ignored"),
+                                  QStringLiteral("path=%1 reason=%2").arg(journalFilePath(), parseError.errorString()));
+        return;
+    }
+
+    const QJsonObject root = document.object();
+    for (const QJsonValue& value : root.value(QStringLiteral("steps")).toArray())
+    {
+        Step step = stepFromJson(value.toObject());
+        if (!step.entries.isEmpty())
+        {
+            m_steps.push_back(std::move(step));
+        }
+    }
+    m_cursor = qBound(0, root.value(QStringLiteral("cursor")).toInt(), static_cast<int>(m_steps.size()));
+}
+
+bool WhatSonHubMutationJournal::save(QString* errorMessage) const
+{
+    QJsonArray steps;
+    for (const Step& step : m_steps)
+    {
+        steps.append(stepToJson(step));
+    }
+    const QJsonObject root{
+        {QStringLiteral("version"), kJournalVersion},
+        {QStringLiteral("cursor"), m_cursor},
+        {QStringLiteral("steps"), steps}
+    };
+    if (!writeFileBytes(journalFilePath(), QJsonDocument(root).toJson(QJsonDocument::Compact)))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to write mutation journal: %1").arg(journalFilePath()));
+    }
+    return true;
+}
+
+void WhatSonHubMutationJournal::collectUnreferencedObjects() const
+{
+    QSet<QString> referencedObjectIds;
+    for (const Step& step : m_steps)
+    {
+        for (const Entry& entry : step.entries)
+        {
+            referencedObjectIds.insert(entry.beforeObjectId);
+            referencedObjectIds.insert(entry.afterObjectId);
+        }
+    }
+
+    QDirIterator iterator(objectsDirectoryPath(), QDir::Files, QDirIterator::Subdirectories);
+    while (iterator.hasNext())
+    {
+        const QString objectPath = iterator.next();
+        if (!referencedObjectIds.contains(iterator.fileName()))
+        {
+            QFile::remove(objectPath);
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+
+class WhatSonHubMutationJournal final
+{
+public:
+    struct Entry final
+    {
+        QString relativePath;
+        QString beforeObjectId;
+        QString afterObjectId;
+    };
+
+    struct Step final
+    {
+        QString stepId;
+        QString label;
+        QString createdAtUtc;
+        QVector<Entry> entries;
+    };
+
+    // Records one undoable step for the hub that contains mutatedPath. Paths outside a .wshub make the scope a no-op.
+    class Scope final
+    {
+    public:
+        Scope(const QString& mutatedPath, QString label);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        bool isActive() const noexcept;
+        void record(const QString& path);
+        bool commit(QString* errorMessage = nullptr);
+
+    private:
+        std::shared_ptr<WhatSonHubMutationJournal> m_journal;
+        bool m_finished = false;
+    };
+
+    // Folds every step committed while it is alive into a single step per hub.
+    class BatchScope final
+    {
+    public:
+        explicit BatchScope(QString label);
+        ~BatchScope();
+
+        BatchScope(const BatchScope&) = delete;
+        BatchScope& operator=(const BatchScope&) = delete;
+    };
+
+    explicit WhatSonHubMutationJournal(QString hubPath);
+    ~WhatSonHubMutationJournal();
+
+    static std::shared_ptr<WhatSonHubMutationJournal> forHub(const QString& hubPath);
+    static std::shared_ptr<WhatSonHubMutationJournal> forPath(const QString& path);
+    static QString hubPathForPath(const QString& path);
+    static QString storageRelativePath();
+
+    QString hubPath() const;
+    QString journalDirectoryPath() const;
+
+    int maximumStepCount() const noexcept;
+    void setMaximumStepCount(int maximumStepCount);
+
+    bool beginStep(const QString& label, QString* errorMessage = nullptr);
+    bool recordPath(const QString& path, QString* errorMessage = nullptr);
+    bool commitStep(QString* errorMessage = nullptr);
+    void abortStep();
+    bool hasOpenStep() const noexcept;
+
+    bool canUndo() const noexcept;
+    bool canRedo() const noexcept;
+    QString undoLabel() const;
+    QString redoLabel() const;
+    QVector<Step> steps() const;
+    int cursor() const noexcept;
+
+    bool undo(QStringList* outTouchedPaths = nullptr, QString* errorMessage = nullptr);
+    bool redo(QStringList* outTouchedPaths = nullptr, QString* errorMessage = nullptr);
+    bool clear(QString* errorMessage = nullptr);
+
+private:
+    struct PendingStep final
+    {
+        QString label;
+        QStringList relativePaths;
+        QHash<QString, QString> beforeObjectIds;
+        QStringList relativeDirectoryPaths;
+        int depth = 0;
+    };
+
+    static void beginBatch(const QString& label);
+    static void endBatch();
+
+    QString objectsDirectoryPath() const;
+    QString journalFilePath() const;
+    QString relativePathFor(const QString& path) const;
+    bool captureFile(const QString& relativePath, QString* errorMessage);
+    bool storeObject(const QString& relativePath, QString* outObjectId, QString* errorMessage) const;
+    QString currentObjectId(const QString& relativePath) const;
+    bool applyStep(const Step& step, bool forward, QStringList* outTouchedPaths, QString* errorMessage);
+    bool flushPendingStep(QString* errorMessage);
+    void load();
+    bool save(QString* errorMessage) const;
+    void collectUnreferencedObjects() const;
+
+    QString m_hubPath;
+    int m_maximumStepCount = 100;
+    QVector<Step> m_steps;
+    int m_cursor = 0;
+    std::unique_ptr<PendingStep> m_pendingStep;
+    bool m_batchOwned = false;
+};
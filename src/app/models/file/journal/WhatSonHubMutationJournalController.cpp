@@ -0,0 +1,104 @@
+#include "app/models/file/journal/WhatSonHubMutationJournalController.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
+
+#include <QStringList>
+
+WhatSonHubMutationJournalController::WhatSonHubMutationJournalController(QObject* parent)
+    : QObject(parent)
+{
+}
+
+WhatSonHubMutationJournalController::~WhatSonHubMutationJournalController() = default;
+
+void WhatSonHubMutationJournalController::setCurrentHubPath(const QString& hubPath)
+{
+    const QString normalizedHubPath = WhatSon::HubPath::normalizePath(hubPath);
+    if (m_currentHubPath == normalizedHubPath)
+    {
+        return;
+    }
+
+    m_currentHubPath = normalizedHubPath;
+    emit journalStateChanged();
+}
+
+QString WhatSonHubMutationJournalController::currentHubPath() const
+{
+    return m_currentHubPath;
+}
+
+bool WhatSonHubMutationJournalController::canUndo() const
+{
+    const auto journal = WhatSonHubMutationJournal::forHub(m_currentHubPath);
+    return journal != nullptr && journal->canUndo();
+}
+
+bool WhatSonHubMutationJournalController::canRedo() const
+{
+    const auto journal = WhatSonHubMutationJournal::forHub(m_currentHubPath);
+    return journal != nullptr && journal->canRedo();
+}
+
+QString WhatSonHubMutationJournalController::undoLabel() const
+{
+    const auto journal = WhatSonHubMutationJournal::forHub(m_currentHubPath);
+    return journal != nullptr ? journal->undoLabel() : QString();
+}
+
+QString WhatSonHubMutationJournalController::redoLabel() const
+{
+    const auto journal = WhatSonHubMutationJournal::forHub(m_currentHubPath);
+    return journal != nullptr ? journal->redoLabel() : QString();
+}
+
+bool WhatSonHubMutationJournalController::undo()
+{
+    return applyJournal(false);
+}
+
+bool WhatSonHubMutationJournalController::redo()
+{
+    return applyJournal(true);
+}
+
+void WhatSonHubMutationJournalController::refresh()
+{
+    emit journalStateChanged();
+}
+
+bool WhatSonHubMutationJournalController::applyJournal(const bool forward)
+{
+    const auto journal = WhatSonHubMutationJournal::forHub(m_currentHubPath);
+    if (journal == nullptr)
+    {
+        emit journalFailed(QStringLiteral("No hub is loaded."));
+        return false;
+    }
+
+    QStringList touchedPaths;
+    QString errorMessage;
+    const bool applied = forward
+                             ? journal->redo(&touchedPaths, &errorMessage)
+                             : journal->undo(&touchedPaths, &errorMessage);
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hub.journal"),
+                              forward ? QStringLiteral("controller.redo") : QStringLiteral("controller.undo"),
+                              QStringLiteral("hub=%1 applied=%2 files=%3 error=%4")
+                              .arg(m_currentHubPath)
+                              .arg(applied)
+                              .arg(touchedPaths.size())
+                              .arg(errorMessage));
+    if (!applied)
+    {
+        emit journalFailed(errorMessage);
+        emit journalStateChanged();
+        return false;
+    }
+
+    emit journalStateChanged();
+    emit hubFilesystemRestored(m_currentHubPath);
+    return true;
+}
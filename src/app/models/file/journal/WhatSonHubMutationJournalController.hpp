@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+class WhatSonHubMutationJournalController final : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool canUndo READ canUndo NOTIFY journalStateChanged)
+    Q_PROPERTY(bool canRedo READ canRedo NOTIFY journalStateChanged)
+    Q_PROPERTY(QString undoLabel READ undoLabel NOTIFY journalStateChanged)
+    Q_PROPERTY(QString redoLabel READ redoLabel NOTIFY journalStateChanged)
+
+public:
+    explicit WhatSonHubMutationJournalController(QObject* parent = nullptr);
+    ~WhatSonHubMutationJournalController() override;
+
+    void setCurrentHubPath(const QString& hubPath);
+    QString currentHubPath() const;
+
+    bool canUndo() const;
+    bool canRedo() const;
+    QString undoLabel() const;
+    QString redoLabel() const;
+
+    Q_INVOKABLE bool undo();
+    Q_INVOKABLE bool redo();
+
+public slots:
+    void refresh();
+
+signals:
+    void journalStateChanged();
+    void hubFilesystemRestored(const QString& hubPath);
+    void journalFailed(const QString& errorMessage);
+
+private:
+    bool applyJournal(bool forward);
+
+    QString m_currentHubPath;
+};
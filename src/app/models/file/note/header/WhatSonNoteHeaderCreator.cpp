@@ -1,6 +1,7 @@
 #include "app/models/file/note/header/WhatSonNoteHeaderCreator.hpp"
 
 #include "app/models/file/note/header/WhatSonBookmarkColorPalette.hpp"
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
 
 #include <QFileInfo>
@@ -9,14 +10,9 @@
 
 namespace
 {
-    QString escapeXmlText(QString value)
+    QString escapeXmlText(const QString& value)
     {
-        value.replace(QStringLiteral("&"), QStringLiteral("&amp;"));
-        value.replace(QStringLiteral("<"), QStringLiteral("&lt;"));
-        value.replace(QStringLiteral(">"), QStringLiteral("&gt;"));
-        value.replace(QStringLiteral("\""), QStringLiteral("&quot;"));
-        value.replace(QStringLiteral("'"), QStringLiteral("&apos;"));
-        return value;
+        return WhatSon::XmlEntities::encode(value);
     }
 
     QString boolToText(bool value)
@@ -91,102 +87,11 @@ QString WhatSonNoteHeaderCreator::headerFileName() const
 
 QString WhatSonNoteHeaderCreator::createHeaderText(const WhatSonNoteHeaderStore& store) const
 {
-    const QString noteId = store.noteId().trimmed().isEmpty()
-                               ? QStringLiteral("note")
-                               : escapeXmlText(store.noteId().trimmed());
-
     QString text;
-    text += QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-    text += QStringLiteral("<!DOCTYPE WHATSONNOTE>\n");
-    text += QStringLiteral("<contents id=\"") + noteId + QStringLiteral("\">\n");
-    text += QStringLiteral("  <head>\n");
-    text += QStringLiteral("    <meta charset=\"UTF-8\" />\n");
-    text += QStringLiteral("    <meta name=\"wsn-type\" content=\"wsnhead\" />\n");
-    text += QStringLiteral("    <created>") + escapeXmlText(store.createdAt()) + QStringLiteral("</created>\n");
-    text += QStringLiteral("    <author>") + escapeXmlText(store.author()) + QStringLiteral("</author>\n");
-    text += QStringLiteral("    <lastModified>") + escapeXmlText(store.lastModifiedAt())
-        + QStringLiteral("</lastModified>\n");
-    text += QStringLiteral("    <lastOpened>") + escapeXmlText(store.lastOpenedAt())
-        + QStringLiteral("</lastOpened>\n");
-    text += QStringLiteral("    <modifiedBy>") + escapeXmlText(store.modifiedBy())
-        + QStringLiteral("</modifiedBy>\n");
-
-    text += QStringLiteral("    <folders>\n");
-    const QStringList folders = store.folders();
-    const QStringList folderUuids = store.folderUuids();
-    for (int index = 0; index < folders.size(); ++index)
-    {
-        const QString folder = folders.at(index);
-        QString folderTag = QStringLiteral("      <folder");
-        if (index < folderUuids.size() && !folderUuids.at(index).trimmed().isEmpty())
-        {
-            folderTag += QStringLiteral(" uuid=\"") + escapeXmlText(folderUuids.at(index).trimmed())
-                + QStringLiteral("\"");
-        }
-        folderTag += QStringLiteral(">")
-            + escapeXmlText(folder)
-            + QStringLiteral("</folder>\n");
-        text += folderTag;
-    }
-    text += QStringLiteral("    </folders>\n");
-
-    text += QStringLiteral("    <project>") + escapeXmlText(store.project()) + QStringLiteral("</project>\n");
-    QString bookmarkTag = QStringLiteral("    <bookmarks state=\"") + boolToText(store.isBookmarked()) +
-        QStringLiteral("\"");
-    const QString colorsAttribute = WhatSon::Bookmarks::serializeBookmarkColorsAttribute(store.bookmarkColors());
-    if (!colorsAttribute.isEmpty())
+    for (int section = 0; section < kSectionCount; ++section)
     {
-        bookmarkTag += QStringLiteral(" colors=\"") + escapeXmlText(colorsAttribute) + QStringLiteral("\"");
+        text += createSectionText(store, static_cast<Section>(section));
     }
-    bookmarkTag += QStringLiteral(" />\n");
-    text += bookmarkTag;
-
-    text += QStringLiteral("    <tags>\n");
-    for (const QString& tag : store.tags())
-    {
-        text += QStringLiteral("      <tag>") + escapeXmlText(tag) + QStringLiteral("</tag>\n");
-    }
-    text += QStringLiteral("    </tags>\n");
-
-    text += QStringLiteral("    <fileStat>\n");
-    text += QStringLiteral("      <totalFolders>") + QString::number(store.totalFolders())
-        + QStringLiteral("</totalFolders>\n");
-    text += QStringLiteral("      <totalTags>") + QString::number(store.totalTags())
-        + QStringLiteral("</totalTags>\n");
-    text += QStringLiteral("      <letterCount>") + QString::number(store.letterCount())
-        + QStringLiteral("</letterCount>\n");
-    text += QStringLiteral("      <wordCount>") + QString::number(store.wordCount())
-        + QStringLiteral("</wordCount>\n");
-    text += QStringLiteral("      <sentenceCount>") + QString::number(store.sentenceCount())
-        + QStringLiteral("</sentenceCount>\n");
-    text += QStringLiteral("      <paragraphCount>") + QString::number(store.paragraphCount())
-        + QStringLiteral("</paragraphCount>\n");
-    text += QStringLiteral("      <spaceCount>") + QString::number(store.spaceCount())
-        + QStringLiteral("</spaceCount>\n");
-    text += QStringLiteral("      <indentCount>") + QString::number(store.indentCount())
-        + QStringLiteral("</indentCount>\n");
-    text += QStringLiteral("      <lineCount>") + QString::number(store.lineCount())
-        + QStringLiteral("</lineCount>\n");
-    text += QStringLiteral("      <openCount>") + QString::number(store.openCount())
-        + QStringLiteral("</openCount>\n");
-    text += QStringLiteral("      <modifiedCount>") + QString::number(store.modifiedCount())
-        + QStringLiteral("</modifiedCount>\n");
-    text += QStringLiteral("      <backlinkToCount>") + QString::number(store.backlinkToCount())
-        + QStringLiteral("</backlinkToCount>\n");
-    text += QStringLiteral("      <backlinkByCount>") + QString::number(store.backlinkByCount())
-        + QStringLiteral("</backlinkByCount>\n");
-    text += QStringLiteral("      <includedResourceCount>") + QString::number(store.includedResourceCount())
-        + QStringLiteral("</includedResourceCount>\n");
-    text += QStringLiteral("    </fileStat>\n");
-
-    const QString progressText = store.progress() < 0 ? QString() : QString::number(store.progress());
-    text += QStringLiteral("    <progress enums=\"")
-        + escapeXmlText(serializeProgressEnumsAttribute(store.progressEnums()))
-        + QStringLiteral("\">")
-        + progressText + QStringLiteral("</progress>\n");
-    text += QStringLiteral("    <isPreset>") + boolToText(store.isPreset()) + QStringLiteral("</isPreset>\n");
-    text += QStringLiteral("  </head>\n");
-    text += QStringLiteral("</contents>\n");
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("note.creator.header"),
@@ -202,3 +107,266 @@ QString WhatSonNoteHeaderCreator::createHeaderText(const WhatSonNoteHeaderStore&
                               .arg(text.toUtf8().size()));
     return text;
 }
+
+QString WhatSonNoteHeaderCreator::createSectionText(const WhatSonNoteHeaderStore& store, const Section section) const
+{
+    const auto textElement = [](const QString& indent, const QString& tagName, const QString& value)
+    {
+        return indent + QLatin1Char('<') + tagName + QLatin1Char('>') + value
+            + QStringLiteral("</") + tagName + QStringLiteral(">\n");
+    };
+    const auto counterElement = [&textElement](const QString& tagName, const int value)
+    {
+        return textElement(QStringLiteral("      "), tagName, QString::number(value));
+    };
+    const QString headIndent = QStringLiteral("    ");
+
+    switch (section)
+    {
+    case Section::Preamble:
+    {
+        const QString noteId = store.noteId().trimmed().isEmpty()
+                                   ? QStringLiteral("note")
+                                   : escapeXmlText(store.noteId().trimmed());
+        QString text;
+        text += QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+        text += QStringLiteral("<!DOCTYPE WHATSONNOTE>\n");
+        text += QStringLiteral("<contents id=\"") + noteId + QStringLiteral("\">\n");
+        text += QStringLiteral("  <head>\n");
+        text += QStringLiteral("    <meta charset=\"UTF-8\" />\n");
+        text += QStringLiteral("    <meta name=\"wsn-type\" content=\"wsnhead\" />\n");
+        return text;
+    }
+    case Section::Created:
+        return textElement(headIndent, QStringLiteral("created"), escapeXmlText(store.createdAt()));
+    case Section::Author:
+        return textElement(headIndent, QStringLiteral("author"), escapeXmlText(store.author()));
+    case Section::LastModified:
+        return textElement(headIndent, QStringLiteral("lastModified"), escapeXmlText(store.lastModifiedAt()));
+    case Section::LastOpened:
+        return textElement(headIndent, QStringLiteral("lastOpened"), escapeXmlText(store.lastOpenedAt()));
+    case Section::ModifiedBy:
+        return textElement(headIndent, QStringLiteral("modifiedBy"), escapeXmlText(store.modifiedBy()));
+    case Section::Folders:
+    {
+        QString text = QStringLiteral("    <folders>\n");
+        const QStringList folders = store.folders();
+        const QStringList folderUuids = store.folderUuids();
+        for (int index = 0; index < folders.size(); ++index)
+        {
+            text += QStringLiteral("      <folder");
+            if (index < folderUuids.size() && !folderUuids.at(index).trimmed().isEmpty())
+            {
+                text += QStringLiteral(" uuid=\"") + escapeXmlText(folderUuids.at(index).trimmed())
+                    + QStringLiteral("\"");
+            }
+            text += QStringLiteral(">") + escapeXmlText(folders.at(index)) + QStringLiteral("</folder>\n");
+        }
+        text += QStringLiteral("    </folders>\n");
+        return text;
+    }
+    case Section::Project:
+        return textElement(headIndent, QStringLiteral("project"), escapeXmlText(store.project()));
+    case Section::Bookmarks:
+    {
+        QString text = QStringLiteral("    <bookmarks state=\"") + boolToText(store.isBookmarked())
+            + QStringLiteral("\"");
+        const QString colorsAttribute = WhatSon::Bookmarks::serializeBookmarkColorsAttribute(store.bookmarkColors());
+        if (!colorsAttribute.isEmpty())
+        {
+            text += QStringLiteral(" colors=\"") + escapeXmlText(colorsAttribute) + QStringLiteral("\"");
+        }
+        text += QStringLiteral(" />\n");
+        return text;
+    }
+    case Section::Tags:
+    {
+        QString text = QStringLiteral("    <tags>\n");
+        for (const QString& tag : store.tags())
+        {
+            text += textElement(QStringLiteral("      "), QStringLiteral("tag"), escapeXmlText(tag));
+        }
+        text += QStringLiteral("    </tags>\n");
+        return text;
+    }
+    case Section::FileStatBegin:
+        return QStringLiteral("    <fileStat>\n");
+    case Section::TotalFolders:
+        return counterElement(QStringLiteral("totalFolders"), store.totalFolders());
+    case Section::TotalTags:
+        return counterElement(QStringLiteral("totalTags"), store.totalTags());
+    case Section::LetterCount:
+        return counterElement(QStringLiteral("letterCount"), store.letterCount());
+    case Section::WordCount:
+        return counterElement(QStringLiteral("wordCount"), store.wordCount());
+    case Section::SentenceCount:
+        return counterElement(QStringLiteral("sentenceCount"), store.sentenceCount());
+    case Section::ParagraphCount:
+        return counterElement(QStringLiteral("paragraphCount"), store.paragraphCount());
+    case Section::SpaceCount:
+        return counterElement(QStringLiteral("spaceCount"), store.spaceCount());
+    case Section::IndentCount:
+        return counterElement(QStringLiteral("indentCount"), store.indentCount());
+    case Section::LineCount:
+        return counterElement(QStringLiteral("lineCount"), store.lineCount());
+    case Section::OpenCount:
+        return counterElement(QStringLiteral("openCount"), store.openCount());
+    case Section::ModifiedCount:
+        return counterElement(QStringLiteral("modifiedCount"), store.modifiedCount());
+    case Section::BacklinkToCount:
+        return counterElement(QStringLiteral("backlinkToCount"), store.backlinkToCount());
+    case Section::BacklinkByCount:
+        return counterElement(QStringLiteral("backlinkByCount"), store.backlinkByCount());
+    case Section::IncludedResourceCount:
+        return counterElement(QStringLiteral("includedResourceCount"), store.includedResourceCount());
+    case Section::FileStatEnd:
+        return QStringLiteral("    </fileStat>\n");
+    case Section::Progress:
+    {
+        const QString progressText = store.progress() < 0 ? QString() : QString::number(store.progress());
+        return QStringLiteral("    <progress enums=\"")
+            + escapeXmlText(serializeProgressEnumsAttribute(store.progressEnums()))
+            + QStringLiteral("\">")
+            + progressText + QStringLiteral("</progress>\n");
+    }
+    case Section::IsPreset:
+        return textElement(headIndent, QStringLiteral("isPreset"), boolToText(store.isPreset()));
+    case Section::Epilogue:
+        return QStringLiteral("  </head>\n</contents>\n");
+    }
+    return {};
+}
+
+QString WhatSonNoteHeaderCreator::sectionMarker(const Section section)
+{
+    // Every section starts a line with this prefix. Escaped values never contain '<', so the prefix is unambiguous.
+    switch (section)
+    {
+    case Section::Preamble:
+        return QStringLiteral("<?xml");
+    case Section::Created:
+        return QStringLiteral("    <created>");
+    case Section::Author:
+        return QStringLiteral("    <author>");
+    case Section::LastModified:
+        return QStringLiteral("    <lastModified>");
+    case Section::LastOpened:
+        return QStringLiteral("    <lastOpened>");
+    case Section::ModifiedBy:
+        return QStringLiteral("    <modifiedBy>");
+    case Section::Folders:
+        return QStringLiteral("    <folders>");
+    case Section::Project:
+        return QStringLiteral("    <project>");
+    case Section::Bookmarks:
+        return QStringLiteral("    <bookmarks ");
+    case Section::Tags:
+        return QStringLiteral("    <tags>");
+    case Section::FileStatBegin:
+        return QStringLiteral("    <fileStat>");
+    case Section::TotalFolders:
+        return QStringLiteral("      <totalFolders>");
+    case Section::TotalTags:
+        return QStringLiteral("      <totalTags>");
+    case Section::LetterCount:
+        return QStringLiteral("      <letterCount>");
+    case Section::WordCount:
+        return QStringLiteral("      <wordCount>");
+    case Section::SentenceCount:
+        return QStringLiteral("      <sentenceCount>");
+    case Section::ParagraphCount:
+        return QStringLiteral("      <paragraphCount>");
+    case Section::SpaceCount:
+        return QStringLiteral("      <spaceCount>");
+    case Section::IndentCount:
+        return QStringLiteral("      <indentCount>");
+    case Section::LineCount:
+        return QStringLiteral("      <lineCount>");
+    case Section::OpenCount:
+        return QStringLiteral("      <openCount>");
+    case Section::ModifiedCount:
+        return QStringLiteral("      <modifiedCount>");
+    case Section::BacklinkToCount:
+        return QStringLiteral("      <backlinkToCount>");
+    case Section::BacklinkByCount:
+        return QStringLiteral("      <backlinkByCount>");
+    case Section::IncludedResourceCount:
+        return QStringLiteral("      <includedResourceCount>");
+    case Section::FileStatEnd:
+        return QStringLiteral("    </fileStat>");
+    case Section::Progress:
+        return QStringLiteral("    <progress ");
+    case Section::IsPreset:
+        return QStringLiteral("    <isPreset>");
+    case Section::Epilogue:
+        return QStringLiteral("  </head>");
+    }
+    return {};
+}
+
+bool WhatSonNoteHeaderCreator::sectionChanged(
+    const Section section,
+    const WhatSonNoteHeaderStore& before,
+    const WhatSonNoteHeaderStore& after)
+{
+    switch (section)
+    {
+    case Section::Preamble:
+        return before.noteId().trimmed() != after.noteId().trimmed();
+    case Section::Created:
+        return before.createdAt() != after.createdAt();
+    case Section::Author:
+        return before.author() != after.author();
+    case Section::LastModified:
+        return before.lastModifiedAt() != after.lastModifiedAt();
+    case Section::LastOpened:
+        return before.lastOpenedAt() != after.lastOpenedAt();
+    case Section::ModifiedBy:
+        return before.modifiedBy() != after.modifiedBy();
+    case Section::Folders:
+        return before.folders() != after.folders() || before.folderUuids() != after.folderUuids();
+    case Section::Project:
+        return before.project() != after.project();
+    case Section::Bookmarks:
+        return before.isBookmarked() != after.isBookmarked() || before.bookmarkColors() != after.bookmarkColors();
+    case Section::Tags:
+        return before.tags() != after.tags();
+    case Section::TotalFolders:
+        return before.totalFolders() != after.totalFolders();
+    case Section::TotalTags:
+        return before.totalTags() != after.totalTags();
+    case Section::LetterCount:
+        return before.letterCount() != after.letterCount();
+    case Section::WordCount:
+        return before.wordCount() != after.wordCount();
+    case Section::SentenceCount:
+        return before.sentenceCount() != after.sentenceCount();
+    case Section::ParagraphCount:
+        return before.paragraphCount() != after.paragraphCount();
+    case Section::SpaceCount:
+        return before.spaceCount() != after.spaceCount();
+    case Section::IndentCount:
+        return before.indentCount() != after.indentCount();
+    case Section::LineCount:
+        return before.lineCount() != after.lineCount();
+    case Section::OpenCount:
+        return before.openCount() != after.openCount();
+    case Section::ModifiedCount:
+        return before.modifiedCount() != after.modifiedCount();
+    case Section::BacklinkToCount:
+        return before.backlinkToCount() != after.backlinkToCount();
+    case Section::BacklinkByCount:
+        return before.backlinkByCount() != after.backlinkByCount();
+    case Section::IncludedResourceCount:
+        return before.includedResourceCount() != after.includedResourceCount();
+    case Section::Progress:
+        return before.progress() != after.progress() || before.progressEnums() != after.progressEnums();
+    case Section::IsPreset:
+        return before.isPreset() != after.isPreset();
+    case Section::FileStatBegin:
+    case Section::FileStatEnd:
+    case Section::Epilogue:
+        return false;
+    }
+    return true;
+}
@@ -3,9 +3,48 @@
 #include "app/models/file/note/package/WhatSonNoteCreator.hpp"
 #include "app/models/file/note/header/WhatSonNoteHeaderStore.hpp"
 
+#include <QVector>
+
 class WhatSonNoteHeaderCreator : public WhatSonNoteCreator
 {
 public:
+    // Line-aligned slices of the canonical .wsnhead layout, in document order. createHeaderText() is the
+    // concatenation of every section, which lets WhatSonNoteHeaderPatcher re-render only the slices that changed.
+    enum class Section
+    {
+        Preamble,
+        Created,
+        Author,
+        LastModified,
+        LastOpened,
+        ModifiedBy,
+        Folders,
+        Project,
+        Bookmarks,
+        Tags,
+        FileStatBegin,
+        TotalFolders,
+        TotalTags,
+        LetterCount,
+        WordCount,
+        SentenceCount,
+        ParagraphCount,
+        SpaceCount,
+        IndentCount,
+        LineCount,
+        OpenCount,
+        ModifiedCount,
+        BacklinkToCount,
+        BacklinkByCount,
+        IncludedResourceCount,
+        FileStatEnd,
+        Progress,
+        IsPreset,
+        Epilogue
+    };
+
+    static constexpr int kSectionCount = static_cast<int>(Section::Epilogue) + 1;
+
     explicit WhatSonNoteHeaderCreator(QString workspaceRootPath, QString notesRootPath = QStringLiteral("notes"));
     ~WhatSonNoteHeaderCreator() override;
 
@@ -15,4 +54,11 @@ public:
 
     QString headerFileName() const;
     QString createHeaderText(const WhatSonNoteHeaderStore& store) const;
+    QString createSectionText(const WhatSonNoteHeaderStore& store, Section section) const;
+
+    static QString sectionMarker(Section section);
+    static bool sectionChanged(
+        Section section,
+        const WhatSonNoteHeaderStore& before,
+        const WhatSonNoteHeaderStore& after);
 };
@@ -0,0 +1,280 @@
+#include "app/models/file/note/header/WhatSonNoteHeaderPatcher.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderParser.hpp"
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QSaveFile>
+
+#include <utility>
+
+namespace
+{
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    WhatSonNoteHeaderCreator::Section sectionAt(const int index)
+    {
+        return static_cast<WhatSonNoteHeaderCreator::Section>(index);
+    }
+
+    constexpr quint32 kAllSectionsMask = (1u << WhatSonNoteHeaderCreator::kSectionCount) - 1u;
+    static_assert(WhatSonNoteHeaderCreator::kSectionCount < 32);
+} // namespace
+
+WhatSonNoteHeaderPatcher::WhatSonNoteHeaderPatcher() = default;
+
+WhatSonNoteHeaderPatcher::~WhatSonNoteHeaderPatcher() = default;
+
+bool WhatSonNoteHeaderPatcher::load(const QString& headerPath, QString* errorMessage)
+{
+    QFile headerFile(headerPath);
+    if (!headerFile.open(QIODevice::ReadOnly))
+    {
+        return failWith(
+            errorMessage,
+            QStringLiteral("Failed to read note header: %1").arg(headerFile.errorString()));
+    }
+
+    QByteArray headerBytes = headerFile.readAll();
+    headerFile.close();
+    if (!loadBytes(std::move(headerBytes), errorMessage))
+    {
+        return false;
+    }
+    m_headerPath = headerPath;
+    return true;
+}
+
+bool WhatSonNoteHeaderPatcher::loadBytes(QByteArray headerBytes, QString* errorMessage)
+{
+    m_headerPath.clear();
+    m_bytes = std::move(headerBytes);
+    m_loadedStore.clear();
+    m_hasSectionRanges = false;
+    m_canonicalSections = 0;
+    m_foundNonCanonicalSection = false;
+
+    WhatSonNoteHeaderParser parser;
+    QString parseError;
+    if (!parser.parse(QString::fromUtf8(m_bytes), &m_loadedStore, &parseError))
+    {
+        m_store = m_loadedStore;
+        return failWith(errorMessage, parseError);
+    }
+
+    m_store = m_loadedStore;
+    m_hasSectionRanges = recordSectionRanges();
+    WhatSon::Debug::trace(
+        QStringLiteral("note.header.patcher"),
+        QStringLiteral("load"),
+        QStringLiteral("id=%1 bytes=%2 sectionMarkers=%3")
+            .arg(m_loadedStore.noteId())
+            .arg(m_bytes.size())
+            .arg(m_hasSectionRanges ? QStringLiteral("true") : QStringLiteral("false")));
+    return true;
+}
+
+QString WhatSonNoteHeaderPatcher::headerPath() const
+{
+    return m_headerPath;
+}
+
+bool WhatSonNoteHeaderPatcher::hasSectionRanges() const
+{
+    if (!m_hasSectionRanges)
+    {
+        return false;
+    }
+    for (int index = 0; index < WhatSonNoteHeaderCreator::kSectionCount; ++index)
+    {
+        if (!sectionIsCanonical(index))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const WhatSonNoteHeaderStore& WhatSonNoteHeaderPatcher::loadedStore() const noexcept
+{
+    return m_loadedStore;
+}
+
+WhatSonNoteHeaderStore& WhatSonNoteHeaderPatcher::store() noexcept
+{
+    return m_store;
+}
+
+bool WhatSonNoteHeaderPatcher::isModified() const
+{
+    for (int section = 0; section < WhatSonNoteHeaderCreator::kSectionCount; ++section)
+    {
+        if (WhatSonNoteHeaderCreator::sectionChanged(sectionAt(section), m_loadedStore, m_store))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+QByteArray WhatSonNoteHeaderPatcher::patchedBytes(QVector<Section>* outPatchedSections) const
+{
+    bool fullRewrite = false;
+    return renderPatchedBytes(outPatchedSections, &fullRewrite);
+}
+
+bool WhatSonNoteHeaderPatcher::save(QString* errorMessage)
+{
+    if (m_headerPath.trimmed().isEmpty())
+    {
+        return failWith(errorMessage, QStringLiteral("A note header path is required."));
+    }
+    if (!isModified())
+    {
+        return true;
+    }
+
+    QVector<Section> patchedSections;
+    bool fullRewrite = false;
+    QByteArray payload = renderPatchedBytes(&patchedSections, &fullRewrite);
+    QSaveFile headerFile(m_headerPath);
+    if (!headerFile.open(QIODevice::WriteOnly)
+        || headerFile.write(payload) != payload.size()
+        || !headerFile.commit())
+    {
+        return failWith(
+            errorMessage,
+            QStringLiteral("Failed to write note header: %1").arg(headerFile.errorString()));
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("note.header.patcher"),
+        QStringLiteral("save"),
+        QStringLiteral("path=%1 bytes=%2 patchedSections=%3 fullRewrite=%4")
+            .arg(m_headerPath)
+            .arg(payload.size())
+            .arg(patchedSections.size())
+            .arg(fullRewrite ? QStringLiteral("true") : QStringLiteral("false")));
+
+    // The written bytes are canonical, so the next edit can splice against them without re-checking any section.
+    m_bytes = std::move(payload);
+    m_loadedStore = m_store;
+    m_hasSectionRanges = recordSectionRanges();
+    m_canonicalSections = m_hasSectionRanges ? kAllSectionsMask : 0;
+    m_foundNonCanonicalSection = !m_hasSectionRanges;
+    return true;
+}
+
+QByteArray WhatSonNoteHeaderPatcher::renderPatchedBytes(
+    QVector<Section>* outPatchedSections,
+    bool* outFullRewrite) const
+{
+    if (outPatchedSections != nullptr)
+    {
+        outPatchedSections->clear();
+    }
+    *outFullRewrite = false;
+
+    QByteArray patched;
+    bool spliced = m_hasSectionRanges;
+    if (spliced)
+    {
+        patched.reserve(m_bytes.size() + 64);
+        for (int index = 0; index < WhatSonNoteHeaderCreator::kSectionCount; ++index)
+        {
+            const Section section = sectionAt(index);
+            if (WhatSonNoteHeaderCreator::sectionChanged(section, m_loadedStore, m_store))
+            {
+                patched += m_creator.createSectionText(m_store, section).toUtf8();
+                if (outPatchedSections != nullptr)
+                {
+                    outPatchedSections->push_back(section);
+                }
+                continue;
+            }
+            if (!sectionIsCanonical(index))
+            {
+                spliced = false;
+                break;
+            }
+
+            const ByteRange& range = m_sectionRanges.at(index);
+            patched.append(m_bytes.constData() + range.begin, range.end - range.begin);
+        }
+        if (spliced)
+        {
+            return patched;
+        }
+    }
+
+    if (outPatchedSections != nullptr)
+    {
+        outPatchedSections->clear();
+    }
+    *outFullRewrite = true;
+    return m_creator.createHeaderText(m_store).toUtf8();
+}
+
+bool WhatSonNoteHeaderPatcher::recordSectionRanges()
+{
+    qsizetype cursor = 0;
+    for (int index = 0; index < WhatSonNoteHeaderCreator::kSectionCount; ++index)
+    {
+        const QByteArray marker = WhatSonNoteHeaderCreator::sectionMarker(sectionAt(index)).toUtf8();
+        if (index == 0)
+        {
+            if (!m_bytes.startsWith(marker))
+            {
+                return false;
+            }
+            m_sectionRanges[index].begin = 0;
+            continue;
+        }
+
+        const qsizetype markerIndex = m_bytes.indexOf(QByteArray(1, '\n') + marker, cursor);
+        if (markerIndex < 0)
+        {
+            return false;
+        }
+        cursor = markerIndex + 1;
+        m_sectionRanges[index - 1].end = cursor;
+        m_sectionRanges[index].begin = cursor;
+    }
+
+    m_sectionRanges[WhatSonNoteHeaderCreator::kSectionCount - 1].end = m_bytes.size();
+    return true;
+}
+
+bool WhatSonNoteHeaderPatcher::sectionIsCanonical(const int index) const
+{
+    const quint32 sectionBit = 1u << index;
+    if ((m_canonicalSections & sectionBit) != 0)
+    {
+        return true;
+    }
+    if (m_foundNonCanonicalSection)
+    {
+        return false;
+    }
+
+    // A verbatim range must be exactly what a full rewrite would produce for the parsed store. Anything the parser
+    // accepts but the creator would not emit (extra whitespace, reordered attributes, a list split differently)
+    // disables splicing for this file.
+    const ByteRange& range = m_sectionRanges.at(index);
+    const QByteArrayView bytes(m_bytes.constData() + range.begin, range.end - range.begin);
+    if (bytes != QByteArrayView(m_creator.createSectionText(m_loadedStore, sectionAt(index)).toUtf8()))
+    {
+        m_foundNonCanonicalSection = true;
+        return false;
+    }
+    m_canonicalSections |= sectionBit;
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "app/models/file/note/header/WhatSonNoteHeaderCreator.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderStore.hpp"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <array>
+
+// Rewrites a .wsnhead by splicing only the sections whose fields changed. load() parses the file and records the
+// UTF-8 byte range of every section marker; patchedBytes() keeps untouched ranges verbatim and re-renders the rest
+// with WhatSonNoteHeaderCreator, so the result is byte-identical to a full rewrite of a canonical file. A kept range is
+// compared with its canonical rendering only when a patch first needs it, and bytes written by save() are known to be
+// canonical. Files that do not follow the canonical layout (hand edits, CRLF) fall back to a full rewrite.
+class WhatSonNoteHeaderPatcher final
+{
+public:
+    using Section = WhatSonNoteHeaderCreator::Section;
+
+    WhatSonNoteHeaderPatcher();
+    ~WhatSonNoteHeaderPatcher();
+
+    bool load(const QString& headerPath, QString* errorMessage = nullptr);
+    bool loadBytes(QByteArray headerBytes, QString* errorMessage = nullptr);
+
+    QString headerPath() const;
+    bool hasSectionRanges() const;
+    const WhatSonNoteHeaderStore& loadedStore() const noexcept;
+    WhatSonNoteHeaderStore& store() noexcept;
+    bool isModified() const;
+
+    QByteArray patchedBytes(QVector<Section>* outPatchedSections = nullptr) const;
+    bool save(QString* errorMessage = nullptr);
+
+private:
+    struct ByteRange final
+    {
+        qsizetype begin = 0;
+        qsizetype end = 0;
+    };
+
+    bool recordSectionRanges();
+    bool sectionIsCanonical(int index) const;
+    QByteArray renderPatchedBytes(QVector<Section>* outPatchedSections, bool* outFullRewrite) const;
+
+    WhatSonNoteHeaderCreator m_creator{QString(), QString()};
+    QString m_headerPath;
+    QByteArray m_bytes;
+    WhatSonNoteHeaderStore m_loadedStore;
+    WhatSonNoteHeaderStore m_store;
+    std::array<ByteRange, WhatSonNoteHeaderCreator::kSectionCount> m_sectionRanges{};
+    bool m_hasSectionRanges = false;
+    mutable quint32 m_canonicalSections = 0;
+    mutable bool m_foundNonCanonicalSection = false;
+};
@@ -1,5 +1,7 @@
 #include "app/models/file/note/support/WhatSonIiXmlDocumentSupport.hpp"
 
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
+
 namespace WhatSon::IiXmlDocumentSupport
 {
     QString stringFromUtf8View(std::string_view view)
@@ -9,14 +11,7 @@ namespace WhatSon::IiXmlDocumentSupport
 
     QString decodeXmlEntities(QString text)
     {
-        text.replace(QStringLiteral("&lt;"), QStringLiteral("<"));
-        text.replace(QStringLiteral("&gt;"), QStringLiteral(">"));
-        text.replace(QStringLiteral("&quot;"), QStringLiteral("\""));
-        text.replace(QStringLiteral("&apos;"), QStringLiteral("'"));
-        text.replace(QStringLiteral("&#39;"), QStringLiteral("'"));
-        text.replace(QStringLiteral("&nbsp;"), QStringLiteral(" "));
-        text.replace(QStringLiteral("&amp;"), QStringLiteral("&"));
-        return text;
+        return WhatSon::XmlEntities::decode(text);
     }
 
     QString normalizeTextValue(QString text)
@@ -0,0 +1,300 @@
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+    // "&#x10FFFF;" is the longest reference the decoder accepts.
+    constexpr qsizetype kMaximumReferenceLength = 10;
+
+    char16_t unitValue(const char unit) noexcept
+    {
+        return static_cast<unsigned char>(unit);
+    }
+
+    char16_t unitValue(const QChar unit) noexcept
+    {
+        return unit.unicode();
+    }
+
+    void appendCodePoint(QByteArray* out, const char32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            out->append(static_cast<char>(codePoint));
+        }
+        else if (codePoint < 0x800)
+        {
+            out->append(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out->append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out->append(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out->append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out->append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            out->append(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out->append(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out->append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out->append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+
+    void appendCodePoint(QString* out, const char32_t codePoint)
+    {
+        if (QChar::requiresSurrogates(codePoint))
+        {
+            out->append(QChar(QChar::highSurrogate(codePoint)));
+            out->append(QChar(QChar::lowSurrogate(codePoint)));
+            return;
+        }
+        out->append(QChar(static_cast<char16_t>(codePoint)));
+    }
+
+    void appendAscii(QByteArray* out, const char* ascii, const qsizetype length)
+    {
+        out->append(ascii, length);
+    }
+
+    void appendAscii(QString* out, const char* ascii, const qsizetype length)
+    {
+        out->append(QLatin1String(ascii, length));
+    }
+
+    bool isXmlCharacter(const char32_t codePoint) noexcept
+    {
+        return codePoint == 0x9 || codePoint == 0xA || codePoint == 0xD
+            || (codePoint >= 0x20 && codePoint <= 0xD7FF)
+            || (codePoint >= 0xE000 && codePoint <= 0xFFFD)
+            || (codePoint >= 0x10000 && codePoint <= 0x10FFFF);
+    }
+
+    template <typename Unit>
+    bool nameEquals(const Unit* name, const qsizetype length, const char* ascii) noexcept
+    {
+        qsizetype index = 0;
+        for (; index < length && ascii[index] != '\0'; ++index)
+        {
+            if (unitValue(name[index]) != static_cast<unsigned char>(ascii[index]))
+            {
+                return false;
+            }
+        }
+        return index == length && ascii[index] == '\0';
+    }
+
+    // Resolves the reference name between '&' and ';'. Returns false for anything that is not a known entity or a
+    // valid character reference.
+    template <typename Unit>
+    bool resolveReference(const Unit* name, const qsizetype length, char32_t* outCodePoint) noexcept
+    {
+        if (length >= 2 && unitValue(name[0]) == u'#')
+        {
+            const bool hex = unitValue(name[1]) == u'x' || unitValue(name[1]) == u'X';
+            const qsizetype firstDigit = hex ? 2 : 1;
+            if (firstDigit >= length)
+            {
+                return false;
+            }
+
+            char32_t codePoint = 0;
+            for (qsizetype index = firstDigit; index < length; ++index)
+            {
+                const char16_t unit = unitValue(name[index]);
+                int digit = -1;
+                if (unit >= u'0' && unit <= u'9')
+                {
+                    digit = unit - u'0';
+                }
+                else if (hex && unit >= u'a' && unit <= u'f')
+                {
+                    digit = unit - u'a' + 10;
+                }
+                else if (hex && unit >= u'A' && unit <= u'F')
+                {
+                    digit = unit - u'A' + 10;
+                }
+                if (digit < 0)
+                {
+                    return false;
+                }
+                codePoint = codePoint * (hex ? 16 : 10) + static_cast<char32_t>(digit);
+                if (codePoint > 0x10FFFF)
+                {
+                    return false;
+                }
+            }
+            if (!isXmlCharacter(codePoint))
+            {
+                return false;
+            }
+            *outCodePoint = codePoint;
+            return true;
+        }
+
+        struct NamedEntity final
+        {
+            const char* name;
+            char32_t codePoint;
+        };
+        static constexpr NamedEntity kNamedEntities[] = {
+            {"lt", U'<'},
+            {"gt", U'>'},
+            {"amp", U'&'},
+            {"quot", U'"'},
+            {"apos", U'\''},
+            {"nbsp", U' '}
+        };
+        for (const NamedEntity& entity : kNamedEntities)
+        {
+            if (nameEquals(name, length, entity.name))
+            {
+                *outCodePoint = entity.codePoint;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename String>
+    String decodeEntities(const String& text)
+    {
+        using Unit = std::remove_cv_t<std::remove_reference_t<decltype(*text.constData())>>;
+
+        const Unit* units = text.constData();
+        const qsizetype size = text.size();
+        qsizetype cursor = 0;
+        while (cursor < size && unitValue(units[cursor]) != u'&')
+        {
+            ++cursor;
+        }
+        if (cursor == size)
+        {
+            return text;
+        }
+
+        String decoded;
+        decoded.reserve(size);
+        qsizetype copiedUpTo = 0;
+        while (cursor < size)
+        {
+            if (unitValue(units[cursor]) != u'&')
+            {
+                ++cursor;
+                continue;
+            }
+
+            qsizetype terminator = cursor + 1;
+            const qsizetype searchEnd = std::min(size, cursor + 1 + kMaximumReferenceLength);
+            while (terminator < searchEnd && unitValue(units[terminator]) != u';')
+            {
+                ++terminator;
+            }
+
+            char32_t codePoint = 0;
+            if (terminator < searchEnd
+                && resolveReference(units + cursor + 1, terminator - cursor - 1, &codePoint))
+            {
+                decoded.append(units + copiedUpTo, cursor - copiedUpTo);
+                appendCodePoint(&decoded, codePoint);
+                cursor = terminator + 1;
+                copiedUpTo = cursor;
+                continue;
+            }
+            ++cursor;
+        }
+        decoded.append(units + copiedUpTo, size - copiedUpTo);
+        return decoded;
+    }
+
+    const char* escapedSpelling(const char16_t unit, qsizetype* outLength) noexcept
+    {
+        switch (unit)
+        {
+        case u'&':
+            *outLength = 5;
+            return "&amp;";
+        case u'<':
+            *outLength = 4;
+            return "&lt;";
+        case u'>':
+            *outLength = 4;
+            return "&gt;";
+        case u'"':
+            *outLength = 6;
+            return "&quot;";
+        case u'\'':
+            *outLength = 6;
+            return "&apos;";
+        default:
+            *outLength = 0;
+            return nullptr;
+        }
+    }
+
+    template <typename String>
+    String encodeEntities(const String& text)
+    {
+        const auto* units = text.constData();
+        const qsizetype size = text.size();
+
+        // Size the output in the same pass that looks for the first escape, so the common no-op case never allocates.
+        qsizetype encodedSize = size;
+        qsizetype spellingLength = 0;
+        for (qsizetype index = 0; index < size; ++index)
+        {
+            if (escapedSpelling(unitValue(units[index]), &spellingLength) != nullptr)
+            {
+                encodedSize += spellingLength - 1;
+            }
+        }
+        if (encodedSize == size)
+        {
+            return text;
+        }
+
+        String encoded;
+        encoded.reserve(encodedSize);
+        qsizetype copiedUpTo = 0;
+        for (qsizetype index = 0; index < size; ++index)
+        {
+            const char* spelling = escapedSpelling(unitValue(units[index]), &spellingLength);
+            if (spelling == nullptr)
+            {
+                continue;
+            }
+            encoded.append(units + copiedUpTo, index - copiedUpTo);
+            appendAscii(&encoded, spelling, spellingLength);
+            copiedUpTo = index + 1;
+        }
+        encoded.append(units + copiedUpTo, size - copiedUpTo);
+        return encoded;
+    }
+} // namespace
+
+namespace WhatSon::XmlEntities
+{
+    QByteArray decode(const QByteArray& utf8)
+    {
+        return decodeEntities(utf8);
+    }
+
+    QString decode(const QString& text)
+    {
+        return decodeEntities(text);
+    }
+
+    QByteArray encode(const QByteArray& utf8)
+    {
+        return encodeEntities(utf8);
+    }
+
+    QString encode(const QString& text)
+    {
+        return encodeEntities(text);
+    }
+} // namespace WhatSon::XmlEntities
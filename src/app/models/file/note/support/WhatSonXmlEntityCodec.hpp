@@ -0,0 +1,18 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+// Single-pass XML entity codec shared by every hand-written XML reader and writer in the app.
+// decode() resolves the five predefined entities, decimal (&#39;) and hex (&#x1F642;) character references, and the
+// legacy &nbsp; spelling (decoded to an ASCII space, as before). Malformed or unknown references are kept verbatim.
+// encode() escapes & < > " and '. Both return the input unchanged, without allocating, when there is nothing to do.
+// The QByteArray overloads work on UTF-8 bytes directly; the QString overloads work on UTF-16 code units.
+namespace WhatSon::XmlEntities
+{
+    QByteArray decode(const QByteArray& utf8);
+    QString decode(const QString& text);
+
+    QByteArray encode(const QByteArray& utf8);
+    QString encode(const QString& text);
+} // namespace WhatSon::XmlEntities
@@ -0,0 +1,425 @@
+#include "app/models/file/query/WhatSonHubQueryFilter.hpp"
+
+#include "app/models/file/query/WhatSonHubQueryIndex.hpp"
+
+#include <utility>
+
+namespace
+{
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    QString boolText(const bool value)
+    {
+        return value ? QStringLiteral("true") : QStringLiteral("false");
+    }
+
+    bool isBooleanField(const QString& field)
+    {
+        return field == QStringLiteral("bookmarked")
+            || field == QStringLiteral("preset")
+            || field == QStringLiteral("referenced")
+            || field == QStringLiteral("unused");
+    }
+
+    QString normalizedFilterValue(QString value, const bool booleanField)
+    {
+        value = value.trimmed();
+        if (value.size() >= 2 && value.startsWith(QLatin1Char('"')) && value.endsWith(QLatin1Char('"')))
+        {
+            value = value.mid(1, value.size() - 2);
+        }
+        if (!booleanField)
+        {
+            return value;
+        }
+        const QString folded = value.toCaseFolded();
+        if (folded == QStringLiteral("yes") || folded == QStringLiteral("1"))
+        {
+            return QStringLiteral("true");
+        }
+        if (folded == QStringLiteral("no") || folded == QStringLiteral("0"))
+        {
+            return QStringLiteral("false");
+        }
+        return value;
+    }
+
+    QStringList tokenize(const QString& expression, QString* errorMessage)
+    {
+        QStringList tokens;
+        QString current;
+        bool quoted = false;
+        for (const QChar character : expression)
+        {
+            if (character == QLatin1Char('"'))
+            {
+                quoted = !quoted;
+                current.push_back(character);
+            }
+            else if (character.isSpace() && !quoted)
+            {
+                if (!current.isEmpty())
+                {
+                    tokens.push_back(std::exchange(current, QString()));
+                }
+            }
+            else
+            {
+                current.push_back(character);
+            }
+        }
+        if (quoted)
+        {
+            failWith(errorMessage, QStringLiteral("Unterminated quote in filter expression."));
+            return {};
+        }
+        if (!current.isEmpty())
+        {
+            tokens.push_back(current);
+        }
+        return tokens;
+    }
+
+    int compareValues(const QString& candidate, const QString& value)
+    {
+        bool candidateIsNumber = false;
+        bool valueIsNumber = false;
+        const double candidateNumber = candidate.toDouble(&candidateIsNumber);
+        const double valueNumber = value.toDouble(&valueIsNumber);
+        if (candidateIsNumber && valueIsNumber)
+        {
+            return candidateNumber < valueNumber ? -1 : (candidateNumber > valueNumber ? 1 : 0);
+        }
+        return QString::compare(candidate, value, Qt::CaseInsensitive);
+    }
+
+    bool valueEquals(const QString& candidate, const QString& value)
+    {
+        if (value.endsWith(QLatin1Char('*')))
+        {
+            return candidate.startsWith(value.chopped(1), Qt::CaseInsensitive);
+        }
+        return compareValues(candidate, value) == 0;
+    }
+
+    QStringList noteCandidates(const WhatSonHubQueryNote& note, const QString& field)
+    {
+        const LibraryNoteRecord& record = note.record;
+        if (field == QStringLiteral("id"))
+        {
+            return {record.noteId};
+        }
+        if (field == QStringLiteral("path"))
+        {
+            return {note.relativeDirectoryPath};
+        }
+        if (field == QStringLiteral("folder"))
+        {
+            return record.folders;
+        }
+        if (field == QStringLiteral("folderuuid"))
+        {
+            return record.folderUuids;
+        }
+        if (field == QStringLiteral("tag"))
+        {
+            return record.tags;
+        }
+        if (field == QStringLiteral("project"))
+        {
+            return {record.project};
+        }
+        if (field == QStringLiteral("progress"))
+        {
+            return {QString::number(record.progress)};
+        }
+        if (field == QStringLiteral("opencount"))
+        {
+            return {QString::number(record.openCount)};
+        }
+        if (field == QStringLiteral("bookmarked"))
+        {
+            return {boolText(record.bookmarked)};
+        }
+        if (field == QStringLiteral("bookmark"))
+        {
+            return record.bookmarkColors;
+        }
+        if (field == QStringLiteral("preset"))
+        {
+            return {boolText(record.preset)};
+        }
+        if (field == QStringLiteral("author"))
+        {
+            return {record.author};
+        }
+        if (field == QStringLiteral("modifiedby"))
+        {
+            return {record.modifiedBy};
+        }
+        if (field == QStringLiteral("created"))
+        {
+            return {record.createdAt};
+        }
+        if (field == QStringLiteral("modified"))
+        {
+            return {record.lastModifiedAt};
+        }
+        if (field == QStringLiteral("resource"))
+        {
+            return note.resourcePaths;
+        }
+        return {};
+    }
+
+    QStringList resourceCandidates(const WhatSonHubQueryResource& resource, const QString& field)
+    {
+        if (field == QStringLiteral("path"))
+        {
+            return {resource.resourcePath};
+        }
+        if (field == QStringLiteral("id"))
+        {
+            return {resource.resourceId};
+        }
+        if (field == QStringLiteral("type"))
+        {
+            return {resource.type};
+        }
+        if (field == QStringLiteral("format"))
+        {
+            return {resource.format};
+        }
+        if (field == QStringLiteral("bucket"))
+        {
+            return {resource.bucket};
+        }
+        if (field == QStringLiteral("referenced"))
+        {
+            return {boolText(resource.referenced)};
+        }
+        if (field == QStringLiteral("unused"))
+        {
+            return {boolText(!resource.referenced)};
+        }
+        return {};
+    }
+} // namespace
+
+WhatSonHubQueryFilter::WhatSonHubQueryFilter(const Target target)
+    : m_target(target)
+{
+}
+
+WhatSonHubQueryFilter::Target WhatSonHubQueryFilter::target() const noexcept
+{
+    return m_target;
+}
+
+bool WhatSonHubQueryFilter::isEmpty() const noexcept
+{
+    return m_terms.isEmpty();
+}
+
+bool WhatSonHubQueryFilter::parse(const QString& expression, QString* errorMessage)
+{
+    m_terms.clear();
+
+    QString tokenizeError;
+    const QStringList tokens = tokenize(expression, &tokenizeError);
+    if (!tokenizeError.isEmpty())
+    {
+        return failWith(errorMessage, tokenizeError);
+    }
+
+    const QStringList fields = supportedFields(m_target);
+    QVector<Term> terms;
+    terms.reserve(tokens.size());
+    for (QString token : tokens)
+    {
+        Term term;
+        if (token.startsWith(QLatin1Char('-')))
+        {
+            term.negated = true;
+            token.remove(0, 1);
+        }
+
+        int operatorPosition = -1;
+        int operatorLength = 1;
+        for (int position = 0; position < token.size() && operatorPosition < 0; ++position)
+        {
+            const QChar character = token.at(position);
+            const bool followedByEqual = position + 1 < token.size() && token.at(position + 1) == QLatin1Char('=');
+            if (character == QLatin1Char(':') || character == QLatin1Char('='))
+            {
+                term.op = Operator::Equal;
+            }
+            else if (character == QLatin1Char('!') && followedByEqual)
+            {
+                term.op = Operator::NotEqual;
+                operatorLength = 2;
+            }
+            else if (character == QLatin1Char('<'))
+            {
+                term.op = followedByEqual ? Operator::LessOrEqual : Operator::Less;
+                operatorLength = followedByEqual ? 2 : 1;
+            }
+            else if (character == QLatin1Char('>'))
+            {
+                term.op = followedByEqual ? Operator::GreaterOrEqual : Operator::Greater;
+                operatorLength = followedByEqual ? 2 : 1;
+            }
+            else
+            {
+                continue;
+            }
+            operatorPosition = position;
+        }
+        if (operatorPosition <= 0)
+        {
+            return failWith(errorMessage, QStringLiteral("Expected field:value in filter term: %1").arg(token));
+        }
+
+        term.field = token.left(operatorPosition).trimmed().toCaseFolded();
+        if (!fields.contains(term.field))
+        {
+            return failWith(
+                errorMessage,
+                QStringLiteral("Unknown filter field '%1'. Supported: %2")
+                    .arg(term.field, fields.join(QStringLiteral(", "))));
+        }
+
+        const QString rawValue = token.mid(operatorPosition + operatorLength);
+        const bool listOperator = term.op == Operator::Equal || term.op == Operator::NotEqual;
+        for (const QString& value : listOperator ? rawValue.split(QLatin1Char(',')) : QStringList{rawValue})
+        {
+            const QString normalizedValue = normalizedFilterValue(value, isBooleanField(term.field));
+            if (!normalizedValue.isEmpty())
+            {
+                term.values.push_back(normalizedValue);
+            }
+        }
+        if (term.values.isEmpty())
+        {
+            return failWith(errorMessage, QStringLiteral("Missing value in filter term: %1").arg(token));
+        }
+        terms.push_back(std::move(term));
+    }
+
+    m_terms = std::move(terms);
+    return true;
+}
+
+bool WhatSonHubQueryFilter::matches(const WhatSonHubQueryNote& note) const
+{
+    for (const Term& term : m_terms)
+    {
+        if (!matchesTerm(term, noteCandidates(note, term.field)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WhatSonHubQueryFilter::matches(const WhatSonHubQueryResource& resource) const
+{
+    for (const Term& term : m_terms)
+    {
+        if (!matchesTerm(term, resourceCandidates(resource, term.field)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+QStringList WhatSonHubQueryFilter::supportedFields(const Target target)
+{
+    if (target == Target::Resources)
+    {
+        return {
+            QStringLiteral("path"),
+            QStringLiteral("id"),
+            QStringLiteral("type"),
+            QStringLiteral("format"),
+            QStringLiteral("bucket"),
+            QStringLiteral("referenced"),
+            QStringLiteral("unused")
+        };
+    }
+    return {
+        QStringLiteral("id"),
+        QStringLiteral("path"),
+        QStringLiteral("folder"),
+        QStringLiteral("folderuuid"),
+        QStringLiteral("tag"),
+        QStringLiteral("project"),
+        QStringLiteral("progress"),
+        QStringLiteral("opencount"),
+        QStringLiteral("bookmarked"),
+        QStringLiteral("bookmark"),
+        QStringLiteral("preset"),
+        QStringLiteral("author"),
+        QStringLiteral("modifiedby"),
+        QStringLiteral("created"),
+        QStringLiteral("modified"),
+        QStringLiteral("resource")
+    };
+}
+
+bool WhatSonHubQueryFilter::matchesTerm(const Term& term, const QStringList& candidates) const
+{
+    bool matched = false;
+    if (term.op == Operator::NotEqual)
+    {
+        matched = true;
+        for (const QString& candidate : candidates)
+        {
+            for (const QString& value : term.values)
+            {
+                matched = matched && !valueEquals(candidate, value);
+            }
+        }
+        return matched != term.negated;
+    }
+
+    for (const QString& candidate : candidates)
+    {
+        for (const QString& value : term.values)
+        {
+            switch (term.op)
+            {
+            case Operator::Equal:
+                matched = valueEquals(candidate, value);
+                break;
+            case Operator::Less:
+                matched = compareValues(candidate, value) < 0;
+                break;
+            case Operator::LessOrEqual:
+                matched = compareValues(candidate, value) <= 0;
+                break;
+            case Operator::Greater:
+                matched = compareValues(candidate, value) > 0;
+                break;
+            case Operator::GreaterOrEqual:
+                matched = compareValues(candidate, value) >= 0;
+                break;
+            case Operator::NotEqual:
+                break;
+            }
+            if (matched)
+            {
+                return !term.negated;
+            }
+        }
+    }
+    return term.negated;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct WhatSonHubQueryNote;
+struct WhatSonHubQueryResource;
+
+class WhatSonHubQueryFilter final
+{
+public:
+    enum class Target
+    {
+        Notes,
+        Resources
+    };
+
+    explicit WhatSonHubQueryFilter(Target target = Target::Notes);
+
+    Target target() const noexcept;
+    bool isEmpty() const noexcept;
+
+    bool parse(const QString& expression, QString* errorMessage = nullptr);
+    bool matches(const WhatSonHubQueryNote& note) const;
+    bool matches(const WhatSonHubQueryResource& resource) const;
+
+    static QStringList supportedFields(Target target);
+
+private:
+    enum class Operator
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual
+    };
+
+    struct Term final
+    {
+        QString field;
+        Operator op = Operator::Equal;
+        QStringList values;
+        bool negated = false;
+    };
+
+    bool matchesTerm(const Term& term, const QStringList& candidates) const;
+
+    Target m_target = Target::Notes;
+    QVector<Term> m_terms;
+};
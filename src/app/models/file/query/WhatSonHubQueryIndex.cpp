@@ -0,0 +1,875 @@
+#include "app/models/file/query/WhatSonHubQueryIndex.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderParser.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderStore.hpp"
+#include "app/models/file/validator/WhatSonHubStructureValidator.hpp"
+#include "app/models/hierarchy/resources/WhatSonResourcePackageSupport.hpp"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    constexpr quint32 kCacheMagic = 0x57535149; // "WSQI"
+    constexpr quint32 kCacheVersion = 2;
+
+    struct NoteFileStat final
+    {
+        QString fileName;
+        qint64 size = 0;
+        qint64 modifiedMs = 0;
+    };
+
+    struct NoteDirectoryScan final
+    {
+        QString absolutePath;
+        QString relativePath;
+        QVector<NoteFileStat> files;
+        QByteArray signature;
+    };
+
+    struct ResourcePackageRef final
+    {
+        QString packageDirectoryPath;
+        QString resourcePath;
+    };
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    bool readUtf8File(const QString& filePath, QString* outText)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            return false;
+        }
+        *outText = QString::fromUtf8(file.readAll());
+        return true;
+    }
+
+    QByteArray signatureForStats(const QVector<NoteFileStat>& files)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        for (const NoteFileStat& file : files)
+        {
+            hash.addData(file.fileName.toUtf8());
+            hash.addData(QByteArray::number(file.size));
+            hash.addData(QByteArray::number(file.modifiedMs));
+        }
+        return hash.result();
+    }
+
+    // Keeps the directories that hold a header, sorts their files and signs them.
+    QVector<NoteDirectoryScan> finishNoteDirectoryScans(QHash<QString, NoteDirectoryScan> scansByPath, const QString& hubPath)
+    {
+        QVector<NoteDirectoryScan> scans;
+        scans.reserve(scansByPath.size());
+        const QDir hubDirectory(hubPath);
+        for (auto it = scansByPath.begin(); it != scansByPath.end(); ++it)
+        {
+            NoteDirectoryScan& scan = it.value();
+            const bool hasHeader = std::any_of(
+                scan.files.cbegin(),
+                scan.files.cend(),
+                [](const NoteFileStat& file)
+                {
+                    return file.fileName.endsWith(QStringLiteral(".wsnhead"), Qt::CaseInsensitive);
+                });
+            if (!hasHeader)
+            {
+                continue;
+            }
+            std::sort(
+                scan.files.begin(),
+                scan.files.end(),
+                [](const NoteFileStat& lhs, const NoteFileStat& rhs)
+                {
+                    return lhs.fileName < rhs.fileName;
+                });
+            scan.relativePath = hubDirectory.relativeFilePath(scan.absolutePath);
+            scan.signature = signatureForStats(scan.files);
+            scans.push_back(std::move(scan));
+        }
+        std::sort(
+            scans.begin(),
+            scans.end(),
+            [](const NoteDirectoryScan& lhs, const NoteDirectoryScan& rhs)
+            {
+                return lhs.relativePath < rhs.relativePath;
+            });
+        return scans;
+    }
+
+    // One directory walk per library root collects every header/body stat, so a warm load never
+    // opens a file whose signature still matches the cache.
+    QVector<NoteDirectoryScan> scanNoteDirectories(const QString& hubPath, const QStringList& libraryRoots)
+    {
+        QHash<QString, NoteDirectoryScan> scansByPath;
+        for (const QString& libraryRoot : libraryRoots)
+        {
+            QDirIterator iterator(
+                libraryRoot,
+                QStringList{QStringLiteral("*.wsnhead"), QStringLiteral("*.wsnbody")},
+                QDir::Files | QDir::Hidden,
+                QDirIterator::Subdirectories);
+            while (iterator.hasNext())
+            {
+                iterator.next();
+                const QFileInfo fileInfo = iterator.fileInfo();
+                const QString directoryPath = QDir::cleanPath(fileInfo.absolutePath());
+                NoteDirectoryScan& scan = scansByPath[directoryPath];
+                scan.absolutePath = directoryPath;
+                scan.files.push_back(NoteFileStat{
+                    fileInfo.fileName(),
+                    fileInfo.size(),
+                    fileInfo.lastModified().toMSecsSinceEpoch()});
+            }
+        }
+        return finishNoteDirectoryScans(std::move(scansByPath), hubPath);
+    }
+
+    QVector<ResourcePackageRef> listResourcePackages(const QString& hubPath)
+    {
+        QVector<ResourcePackageRef> packages;
+        for (const QString& resourceRoot : WhatSon::Resources::resolveResourceRootDirectories(hubPath))
+        {
+            for (const QString& resourcePath : WhatSon::Resources::listRelativeResourcePackagePaths(resourceRoot))
+            {
+                packages.push_back(ResourcePackageRef{
+                    QDir(QFileInfo(resourceRoot).absolutePath()).filePath(resourcePath),
+                    resourcePath});
+            }
+        }
+        return packages;
+    }
+
+    bool isDynamicDirectoryName(const QString& name, const QString& suffix)
+    {
+        return !name.startsWith(QLatin1Char('.')) && name.endsWith(suffix, Qt::CaseInsensitive);
+    }
+
+    bool isNoteFileName(const QString& fileName)
+    {
+        return fileName.endsWith(QStringLiteral(".wsnhead"), Qt::CaseInsensitive)
+            || fileName.endsWith(QStringLiteral(".wsnbody"), Qt::CaseInsensitive);
+    }
+
+    // The packed counterpart of scanNoteDirectories() and listResourcePackages(): one pass over the archive index
+    // finds the note files under every library root and every resource package, without unpacking anything.
+    bool scanPackedHub(
+        const WhatSonHubArchive& archive,
+        const QString& archivePath,
+        QVector<NoteDirectoryScan>* outScans,
+        QVector<ResourcePackageRef>* outPackages,
+        QString* errorMessage)
+    {
+        QHash<QString, NoteDirectoryScan> scansByPath;
+        QHash<QString, ResourcePackageRef> packagesByPath;
+        bool hasContentsDirectory = false;
+        for (const QString& entryPath : archive.entryPaths())
+        {
+            const QStringList segments = entryPath.split(QLatin1Char('/'), Qt::SkipEmptyParts);
+            if (segments.isEmpty())
+            {
+                continue;
+            }
+
+            const QString& rootName = segments.constFirst();
+            if (rootName == QStringLiteral(".wscontents") || isDynamicDirectoryName(rootName, QStringLiteral(".wscontents")))
+            {
+                hasContentsDirectory = true;
+                const WhatSonHubArchiveEntry* entry = archive.entry(entryPath);
+                if (segments.size() < 3
+                    || entry->directory
+                    || !isDynamicDirectoryName(segments.at(1), QStringLiteral(".wslibrary"))
+                    || !isNoteFileName(segments.constLast()))
+                {
+                    continue;
+                }
+
+                const QString directoryPath = QDir::cleanPath(
+                    archivePath + QLatin1Char('/') + segments.mid(0, segments.size() - 1).join(QLatin1Char('/')));
+                NoteDirectoryScan& scan = scansByPath[directoryPath];
+                scan.absolutePath = directoryPath;
+                scan.files.push_back(NoteFileStat{segments.constLast(), entry->size, entry->modifiedMsecsSinceEpoch});
+                continue;
+            }
+
+            if ((rootName == QStringLiteral(".wsresources") || isDynamicDirectoryName(rootName, QStringLiteral(".wsresources")))
+                && segments.size() >= 2
+                && WhatSon::Resources::isResourcePackageDirectoryName(segments.at(1))
+                && (segments.size() > 2 || archive.entry(entryPath)->directory))
+            {
+                const QString resourcePath = rootName + QLatin1Char('/') + segments.at(1);
+                packagesByPath.insert(
+                    resourcePath,
+                    ResourcePackageRef{QDir::cleanPath(archivePath + QLatin1Char('/') + resourcePath), resourcePath});
+            }
+        }
+
+        if (!hasContentsDirectory)
+        {
+            return failWith(
+                errorMessage,
+                QStringLiteral("No *.wscontents directory was found inside .wshub: %1").arg(archivePath));
+        }
+
+        QVector<ResourcePackageRef> packages = packagesByPath.values();
+        std::sort(
+            packages.begin(),
+            packages.end(),
+            [](const ResourcePackageRef& lhs, const ResourcePackageRef& rhs)
+            {
+                // The fixed .wsresources root lists first, like resolveResourceRootDirectories().
+                const bool lhsFixed = lhs.resourcePath.startsWith(QStringLiteral(".wsresources/"));
+                const bool rhsFixed = rhs.resourcePath.startsWith(QStringLiteral(".wsresources/"));
+                return lhsFixed != rhsFixed ? lhsFixed : lhs.resourcePath < rhs.resourcePath;
+            });
+        *outScans = finishNoteDirectoryScans(std::move(scansByPath), archivePath);
+        *outPackages = std::move(packages);
+        return true;
+    }
+
+    // Maps the archive on the calling thread, so workers only read the mapping. Returns false when it cannot be
+    // mapped and reads have to go through the shared file handle instead.
+    bool primeArchiveMapping(const WhatSonHubArchive& archive)
+    {
+        for (const QString& entryPath : archive.entryPaths())
+        {
+            const WhatSonHubArchiveEntry* entry = archive.entry(entryPath);
+            if (!entry->directory && entry->size > 0)
+            {
+                return archive.fileView(entryPath).size() == entry->size;
+            }
+        }
+        return true;
+    }
+
+    // Where note and resource files are read from. Packed hubs are read in place: each entry is addressed by the
+    // archive path joined with its entry path, so relative paths, cache keys and reference resolution match the
+    // unpacked layout.
+    struct HubFileSource final
+    {
+        QString rootPath;
+        const WhatSonHubArchive* archive = nullptr;
+        bool archiveMapped = false;
+        QSet<QString> packageDirectoryPaths;
+
+        bool readText(const QString& path, QString* outText) const
+        {
+            if (archive == nullptr)
+            {
+                return readUtf8File(path, outText);
+            }
+
+            const QString entryPath = QDir(rootPath).relativeFilePath(path);
+            const WhatSonHubArchiveEntry* entry = archive->entry(entryPath);
+            if (entry == nullptr || entry->directory)
+            {
+                return false;
+            }
+            if (archiveMapped)
+            {
+                const QByteArrayView view = archive->fileView(entryPath);
+                if (view.size() != entry->size)
+                {
+                    return false;
+                }
+                *outText = QString::fromUtf8(view);
+                return true;
+            }
+            const QByteArray data = archive->readFile(entryPath);
+            if (data.size() != entry->size)
+            {
+                return false;
+            }
+            *outText = QString::fromUtf8(data);
+            return true;
+        }
+
+        QString resolvePackageDirectory(const QString& reference, const QStringList& basePaths) const
+        {
+            if (archive == nullptr)
+            {
+                return WhatSon::Resources::resolvePackageDirectoryFromReference(reference, basePaths);
+            }
+
+            const QString referencePath = WhatSon::Resources::decodeXmlEntities(reference).trimmed();
+            if (referencePath.isEmpty())
+            {
+                return {};
+            }
+            if (QFileInfo(referencePath).isAbsolute())
+            {
+                const QString candidatePath = QDir::cleanPath(referencePath);
+                return packageDirectoryPaths.contains(candidatePath) ? candidatePath : QString();
+            }
+            for (const QString& basePath : basePaths)
+            {
+                const QString candidatePath = QDir::cleanPath(QDir(basePath).absoluteFilePath(referencePath));
+                if (packageDirectoryPaths.contains(candidatePath))
+                {
+                    return candidatePath;
+                }
+            }
+            return {};
+        }
+
+        QString resourcePathForPackage(const QString& packageDirectoryPath) const
+        {
+            if (archive == nullptr)
+            {
+                return WhatSon::Resources::resourcePathForPackageDirectory(packageDirectoryPath);
+            }
+            const QFileInfo packageInfo(packageDirectoryPath);
+            return WhatSon::Resources::normalizePath(
+                QStringLiteral("%1/%2").arg(packageInfo.dir().dirName(), packageInfo.fileName()));
+        }
+
+        QByteArray resourceSignature(const QString& packageDirectoryPath) const
+        {
+            const QString metadataPath = WhatSon::Resources::metadataFilePathForPackage(packageDirectoryPath);
+            if (archive != nullptr)
+            {
+                const WhatSonHubArchiveEntry* entry = archive->entry(QDir(rootPath).relativeFilePath(metadataPath));
+                return signatureForStats({NoteFileStat{
+                    WhatSon::Resources::metadataFileName(),
+                    entry != nullptr ? entry->size : -1,
+                    entry != nullptr ? entry->modifiedMsecsSinceEpoch : 0}});
+            }
+
+            const QFileInfo metadataInfo(metadataPath);
+            return signatureForStats({NoteFileStat{
+                metadataInfo.fileName(),
+                metadataInfo.exists() ? metadataInfo.size() : -1,
+                metadataInfo.exists() ? metadataInfo.lastModified().toMSecsSinceEpoch() : 0}});
+        }
+
+        bool loadResourceMetadata(
+            const QString& packageDirectoryPath,
+            const QString& resourcePath,
+            WhatSon::Resources::ResourcePackageMetadata* outMetadata) const
+        {
+            if (archive == nullptr)
+            {
+                return WhatSon::Resources::loadResourcePackageMetadata(packageDirectoryPath, outMetadata);
+            }
+
+            QString metadataText;
+            if (!readText(WhatSon::Resources::metadataFilePathForPackage(packageDirectoryPath), &metadataText)
+                || !WhatSon::Resources::parseResourcePackageMetadataXml(metadataText, outMetadata))
+            {
+                return false;
+            }
+            WhatSon::Resources::finalizeMetadata(outMetadata, packageDirectoryPath, resourcePath);
+            return true;
+        }
+    };
+
+    QString headerFileNameForScan(const NoteDirectoryScan& scan)
+    {
+        QStringList headerNames;
+        for (const NoteFileStat& file : scan.files)
+        {
+            if (file.fileName.endsWith(QStringLiteral(".wsnhead"), Qt::CaseInsensitive))
+            {
+                headerNames.push_back(file.fileName);
+            }
+        }
+
+        const QString stemHeaderName = QFileInfo(scan.absolutePath).completeBaseName().trimmed()
+            + QStringLiteral(".wsnhead");
+        if (headerNames.contains(stemHeaderName))
+        {
+            return stemHeaderName;
+        }
+        if (headerNames.contains(QStringLiteral("note.wsnhead")))
+        {
+            return QStringLiteral("note.wsnhead");
+        }
+        for (const QString& headerName : std::as_const(headerNames))
+        {
+            if (!headerName.toCaseFolded().contains(QStringLiteral(".draft.")))
+            {
+                return headerName;
+            }
+        }
+        return headerNames.constFirst();
+    }
+
+    QStringList resourceReferencesInBody(const QString& bodyText)
+    {
+        static const QRegularExpression resourceTag(
+            QStringLiteral(R"(<\s*resource\b[^>]*>)"),
+            QRegularExpression::CaseInsensitiveOption);
+        static const QRegularExpression pathAttribute(
+            QStringLiteral(R"((?:resourcePath|path)\s*=\s*(?:"([^"]+)"|'([^']+)'))"),
+            QRegularExpression::CaseInsensitiveOption);
+
+        QStringList references;
+        QRegularExpressionMatchIterator iterator = resourceTag.globalMatch(bodyText);
+        while (iterator.hasNext())
+        {
+            const QRegularExpressionMatch attributeMatch = pathAttribute.match(iterator.next().captured(0));
+            if (!attributeMatch.hasMatch())
+            {
+                continue;
+            }
+            const QString reference = attributeMatch.captured(1).isEmpty()
+                                          ? attributeMatch.captured(2).trimmed()
+                                          : attributeMatch.captured(1).trimmed();
+            if (!reference.isEmpty())
+            {
+                references.push_back(reference);
+            }
+        }
+        return references;
+    }
+
+    WhatSonHubQueryNote buildNote(const NoteDirectoryScan& scan, const HubFileSource& source)
+    {
+        WhatSonHubQueryNote note;
+        note.relativeDirectoryPath = scan.relativePath;
+        note.signature = scan.signature;
+        note.record.noteDirectoryPath = scan.absolutePath;
+        note.record.noteHeaderPath = QDir(scan.absolutePath).filePath(headerFileNameForScan(scan));
+
+        QString headerText;
+        WhatSonNoteHeaderStore header;
+        if (source.readText(note.record.noteHeaderPath, &headerText)
+            && WhatSonNoteHeaderParser().parse(headerText, &header, nullptr))
+        {
+            note.record.noteId = header.noteId();
+            note.record.createdAt = header.createdAt();
+            note.record.lastModifiedAt = header.lastModifiedAt();
+            note.record.author = header.author();
+            note.record.modifiedBy = header.modifiedBy();
+            note.record.project = header.project();
+            note.record.folders = header.folders();
+            note.record.folderUuids = header.folderUuids();
+            note.record.bookmarkColors = header.bookmarkColors();
+            note.record.tags = header.tags();
+            note.record.progress = header.progress();
+            note.record.openCount = header.openCount();
+            note.record.bookmarked = header.isBookmarked();
+            note.record.preset = header.isPreset();
+        }
+        if (note.record.noteId.trimmed().isEmpty())
+        {
+            note.record.noteId = QFileInfo(scan.absolutePath).completeBaseName();
+        }
+
+        const QStringList basePaths = WhatSon::Resources::resourceReferenceBasePathsForContext(
+            scan.absolutePath,
+            note.record.noteHeaderPath,
+            source.rootPath);
+        for (const NoteFileStat& file : scan.files)
+        {
+            QString bodyText;
+            if (!file.fileName.endsWith(QStringLiteral(".wsnbody"), Qt::CaseInsensitive)
+                || !source.readText(QDir(scan.absolutePath).filePath(file.fileName), &bodyText))
+            {
+                continue;
+            }
+            for (const QString& reference : resourceReferencesInBody(bodyText))
+            {
+                const QString packageDirectoryPath = source.resolvePackageDirectory(reference, basePaths);
+                if (!packageDirectoryPath.isEmpty())
+                {
+                    note.resourcePaths.push_back(source.resourcePathForPackage(packageDirectoryPath));
+                }
+            }
+        }
+        note.resourcePaths.removeDuplicates();
+        return note;
+    }
+
+    WhatSonHubQueryResource buildResource(
+        const HubFileSource& source,
+        const QString& packageDirectoryPath,
+        const QString& resourcePath,
+        QByteArray signature)
+    {
+        WhatSonHubQueryResource resource;
+        resource.resourcePath = resourcePath;
+        resource.signature = std::move(signature);
+
+        WhatSon::Resources::ResourcePackageMetadata metadata;
+        if (!source.loadResourceMetadata(packageDirectoryPath, resourcePath, &metadata))
+        {
+            metadata = WhatSon::Resources::buildFallbackMetadataFromResourcePath(resourcePath, QString());
+        }
+        resource.resourceId = metadata.resourceId.trimmed();
+        resource.type = metadata.type.trimmed();
+        resource.format = metadata.format.trimmed();
+        resource.bucket = metadata.bucket.trimmed();
+        return resource;
+    }
+
+    void writeNote(QDataStream& stream, const WhatSonHubQueryNote& note)
+    {
+        const LibraryNoteRecord& record = note.record;
+        stream << note.relativeDirectoryPath << note.signature << note.resourcePaths
+               << record.noteId << record.createdAt << record.lastModifiedAt << record.author
+               << record.modifiedBy << record.project << record.folders << record.folderUuids
+               << record.bookmarkColors << record.tags << qint32(record.progress) << qint32(record.openCount)
+               << record.bookmarked << record.preset << record.noteHeaderPath;
+    }
+
+    void readNote(QDataStream& stream, WhatSonHubQueryNote* note)
+    {
+        LibraryNoteRecord& record = note->record;
+        qint32 progress = -1;
+        qint32 openCount = 0;
+        stream >> note->relativeDirectoryPath >> note->signature >> note->resourcePaths
+            >> record.noteId >> record.createdAt >> record.lastModifiedAt >> record.author
+            >> record.modifiedBy >> record.project >> record.folders >> record.folderUuids
+            >> record.bookmarkColors >> record.tags >> progress >> openCount >> record.bookmarked
+            >> record.preset >> record.noteHeaderPath;
+        record.progress = progress;
+        record.openCount = openCount;
+    }
+
+    void writeResource(QDataStream& stream, const WhatSonHubQueryResource& resource)
+    {
+        stream << resource.resourcePath << resource.signature << resource.resourceId << resource.type
+               << resource.format << resource.bucket;
+    }
+
+    void readResource(QDataStream& stream, WhatSonHubQueryResource* resource)
+    {
+        stream >> resource->resourcePath >> resource->signature >> resource->resourceId >> resource->type
+            >> resource->format >> resource->bucket;
+    }
+} // namespace
+
+QVariantMap WhatSonHubQueryNote::toVariantMap() const
+{
+    return {
+        {QStringLiteral("id"), record.noteId},
+        {QStringLiteral("path"), relativeDirectoryPath},
+        {QStringLiteral("created"), record.createdAt},
+        {QStringLiteral("modified"), record.lastModifiedAt},
+        {QStringLiteral("author"), record.author},
+        {QStringLiteral("modifiedBy"), record.modifiedBy},
+        {QStringLiteral("project"), record.project},
+        {QStringLiteral("folders"), record.folders},
+        {QStringLiteral("folderUuids"), record.folderUuids},
+        {QStringLiteral("tags"), record.tags},
+        {QStringLiteral("progress"), record.progress},
+        {QStringLiteral("openCount"), record.openCount},
+        {QStringLiteral("bookmarked"), record.bookmarked},
+        {QStringLiteral("bookmarkColors"), record.bookmarkColors},
+        {QStringLiteral("preset"), record.preset},
+        {QStringLiteral("resources"), resourcePaths}
+    };
+}
+
+QVariantMap WhatSonHubQueryResource::toVariantMap() const
+{
+    return {
+        {QStringLiteral("path"), resourcePath},
+        {QStringLiteral("id"), resourceId},
+        {QStringLiteral("type"), type},
+        {QStringLiteral("format"), format},
+        {QStringLiteral("bucket"), bucket},
+        {QStringLiteral("referenced"), referenced}
+    };
+}
+
+WhatSonHubQueryIndex::WhatSonHubQueryIndex() = default;
+
+WhatSonHubQueryIndex::~WhatSonHubQueryIndex() = default;
+
+int WhatSonHubQueryIndex::maxWorkerCount() const noexcept
+{
+    return m_maxWorkerCount;
+}
+
+void WhatSonHubQueryIndex::setMaxWorkerCount(const int maxWorkerCount) noexcept
+{
+    m_maxWorkerCount = std::max(0, maxWorkerCount);
+}
+
+QString WhatSonHubQueryIndex::cacheDirectoryPath() const
+{
+    return m_cacheDirectoryPath;
+}
+
+void WhatSonHubQueryIndex::setCacheDirectoryPath(QString cacheDirectoryPath)
+{
+    m_cacheDirectoryPath = cacheDirectoryPath.trimmed().isEmpty()
+                               ? QString()
+                               : WhatSon::HubPath::normalizeAbsolutePath(cacheDirectoryPath);
+}
+
+bool WhatSonHubQueryIndex::load(const QString& hubPath, QString* errorMessage)
+{
+    m_hubPath = WhatSon::HubPath::normalizeAbsolutePath(hubPath);
+    m_notes.clear();
+    m_resources.clear();
+    m_reusedEntryCount = 0;
+    m_parsedEntryCount = 0;
+
+    HubFileSource source;
+    source.rootPath = m_hubPath;
+    WhatSonHubArchive archive;
+    QVector<NoteDirectoryScan> scans;
+    QVector<ResourcePackageRef> resourcePackages;
+    if (WhatSonHubArchive::isPackedArchive(m_hubPath))
+    {
+        // Packed hubs are indexed straight from the archive; nothing is unpacked or staged.
+        if (!archive.open(m_hubPath, errorMessage)
+            || !scanPackedHub(archive, m_hubPath, &scans, &resourcePackages, errorMessage))
+        {
+            return false;
+        }
+        source.archive = &archive;
+        source.archiveMapped = primeArchiveMapping(archive);
+        for (const ResourcePackageRef& package : std::as_const(resourcePackages))
+        {
+            source.packageDirectoryPaths.insert(package.packageDirectoryPath);
+        }
+    }
+    else
+    {
+        const WhatSonHubStructureValidator structureValidator;
+        QStringList contentsDirectories;
+        if (!structureValidator.resolveContentsDirectories(m_hubPath, &contentsDirectories, errorMessage))
+        {
+            return false;
+        }
+        scans = scanNoteDirectories(m_hubPath, structureValidator.resolveLibraryRoots(m_hubPath));
+        resourcePackages = listResourcePackages(m_hubPath);
+    }
+
+    QHash<QString, WhatSonHubQueryNote> cachedNotes;
+    QHash<QString, WhatSonHubQueryResource> cachedResources;
+    readCache(&cachedNotes, &cachedResources);
+
+    m_notes.resize(scans.size());
+    QVector<int> pendingRows;
+    for (int row = 0; row < scans.size(); ++row)
+    {
+        const NoteDirectoryScan& scan = scans.at(row);
+        const auto cachedIt = cachedNotes.constFind(scan.relativePath);
+        if (cachedIt != cachedNotes.cend() && cachedIt.value().signature == scan.signature)
+        {
+            m_notes[row] = cachedIt.value();
+            m_notes[row].record.noteDirectoryPath = scan.absolutePath;
+            ++m_reusedEntryCount;
+            continue;
+        }
+        pendingRows.push_back(row);
+    }
+
+    if (!pendingRows.isEmpty())
+    {
+        WhatSonHubQueryNote* noteSlots = m_notes.data();
+        QThreadPool workerPool;
+        workerPool.setMaxThreadCount(
+            source.archive != nullptr && !source.archiveMapped
+                ? 1
+                : (m_maxWorkerCount > 0 ? m_maxWorkerCount : QThread::idealThreadCount()));
+        for (const int row : std::as_const(pendingRows))
+        {
+            workerPool.start([&scans, &source, noteSlots, row]()
+            {
+                noteSlots[row] = buildNote(scans.at(row), source);
+            });
+        }
+        workerPool.waitForDone();
+        m_parsedEntryCount += static_cast<int>(pendingRows.size());
+    }
+
+    QSet<QString> referencedResources;
+    for (const WhatSonHubQueryNote& note : std::as_const(m_notes))
+    {
+        for (const QString& resourcePath : note.resourcePaths)
+        {
+            referencedResources.insert(resourcePath);
+        }
+    }
+
+    for (const ResourcePackageRef& package : std::as_const(resourcePackages))
+    {
+        QByteArray signature = source.resourceSignature(package.packageDirectoryPath);
+        const auto cachedIt = cachedResources.constFind(package.resourcePath);
+        WhatSonHubQueryResource resource;
+        if (cachedIt != cachedResources.cend() && cachedIt.value().signature == signature)
+        {
+            resource = cachedIt.value();
+            ++m_reusedEntryCount;
+        }
+        else
+        {
+            resource = buildResource(source, package.packageDirectoryPath, package.resourcePath, std::move(signature));
+            ++m_parsedEntryCount;
+        }
+        resource.referenced = referencedResources.contains(resource.resourcePath);
+        m_resources.push_back(std::move(resource));
+    }
+
+    if (m_parsedEntryCount > 0 || cachedNotes.size() != m_notes.size() || cachedResources.size() != m_resources.size())
+    {
+        writeCache();
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.query"),
+        QStringLiteral("index.load"),
+        QStringLiteral("path=%1 notes=%2 resources=%3 reused=%4 parsed=%5")
+            .arg(m_hubPath)
+            .arg(m_notes.size())
+            .arg(m_resources.size())
+            .arg(m_reusedEntryCount)
+            .arg(m_parsedEntryCount));
+    return true;
+}
+
+QString WhatSonHubQueryIndex::hubPath() const
+{
+    return m_hubPath;
+}
+
+const QVector<WhatSonHubQueryNote>& WhatSonHubQueryIndex::notes() const noexcept
+{
+    return m_notes;
+}
+
+const QVector<WhatSonHubQueryResource>& WhatSonHubQueryIndex::resources() const noexcept
+{
+    return m_resources;
+}
+
+int WhatSonHubQueryIndex::reusedEntryCount() const noexcept
+{
+    return m_reusedEntryCount;
+}
+
+int WhatSonHubQueryIndex::parsedEntryCount() const noexcept
+{
+    return m_parsedEntryCount;
+}
+
+QString WhatSonHubQueryIndex::defaultCacheDirectoryPath()
+{
+    const QString cacheRoot = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return cacheRoot.isEmpty() ? QString() : QDir(cacheRoot).filePath(QStringLiteral("hub-query"));
+}
+
+QString WhatSonHubQueryIndex::cacheFilePath() const
+{
+    if (m_cacheDirectoryPath.isEmpty() || m_hubPath.isEmpty())
+    {
+        return {};
+    }
+    const QByteArray pathHash = QCryptographicHash::hash(m_hubPath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QDir(m_cacheDirectoryPath).filePath(QString::fromLatin1(pathHash) + QStringLiteral(".wsqindex"));
+}
+
+void WhatSonHubQueryIndex::readCache(
+    QHash<QString, WhatSonHubQueryNote>* outNotes,
+    QHash<QString, WhatSonHubQueryResource>* outResources) const
+{
+    const QString path = cacheFilePath();
+    QFile cacheFile(path);
+    if (path.isEmpty() || !cacheFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&cacheFile);
+    stream.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString cachedHubPath;
+    stream >> magic >> version >> cachedHubPath;
+    if (magic != kCacheMagic || version != kCacheVersion || cachedHubPath != m_hubPath)
+    {
+        return;
+    }
+
+    quint32 noteCount = 0;
+    stream >> noteCount;
+    QHash<QString, WhatSonHubQueryNote> notes;
+    notes.reserve(static_cast<qsizetype>(noteCount));
+    for (quint32 index = 0; index < noteCount && stream.status() == QDataStream::Ok; ++index)
+    {
+        WhatSonHubQueryNote note;
+        readNote(stream, &note);
+        QString key = note.relativeDirectoryPath;
+        notes.insert(std::move(key), std::move(note));
+    }
+
+    quint32 resourceCount = 0;
+    stream >> resourceCount;
+    QHash<QString, WhatSonHubQueryResource> resources;
+    resources.reserve(static_cast<qsizetype>(resourceCount));
+    for (quint32 index = 0; index < resourceCount && stream.status() == QDataStream::Ok; ++index)
+    {
+        WhatSonHubQueryResource resource;
+        readResource(stream, &resource);
+        QString key = resource.resourcePath;
+        resources.insert(std::move(key), std::move(resource));
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        return;
+    }
+    *outNotes = std::move(notes);
+    *outResources = std::move(resources);
+}
+
+bool WhatSonHubQueryIndex::writeCache() const
+{
+    const QString path = cacheFilePath();
+    if (path.isEmpty() || !QDir().mkpath(m_cacheDirectoryPath))
+    {
+        return false;
+    }
+
+    QSaveFile cacheFile(path);
+    if (!cacheFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    QDataStream stream(&cacheFile);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << kCacheMagic << kCacheVersion << m_hubPath << quint32(m_notes.size());
+    for (const WhatSonHubQueryNote& note : m_notes)
+    {
+        writeNote(stream, note);
+    }
+    stream << quint32(m_resources.size());
+    for (const WhatSonHubQueryResource& resource : m_resources)
+    {
+        writeResource(stream, resource);
+    }
+    return stream.status() == QDataStream::Ok && cacheFile.commit();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+struct WhatSonHubQueryNote final
+{
+    LibraryNoteRecord record;
+    QString relativeDirectoryPath;
+    QStringList resourcePaths;
+    QByteArray signature;
+
+    QVariantMap toVariantMap() const;
+};
+
+struct WhatSonHubQueryResource final
+{
+    QString resourcePath;
+    QString resourceId;
+    QString type;
+    QString format;
+    QString bucket;
+    bool referenced = false;
+    QByteArray signature;
+
+    QVariantMap toVariantMap() const;
+};
+
+class WhatSonHubQueryIndex final
+{
+public:
+    WhatSonHubQueryIndex();
+    ~WhatSonHubQueryIndex();
+
+    int maxWorkerCount() const noexcept;
+    void setMaxWorkerCount(int maxWorkerCount) noexcept;
+
+    QString cacheDirectoryPath() const;
+    void setCacheDirectoryPath(QString cacheDirectoryPath);
+
+    bool load(const QString& hubPath, QString* errorMessage = nullptr);
+
+    QString hubPath() const;
+    const QVector<WhatSonHubQueryNote>& notes() const noexcept;
+    const QVector<WhatSonHubQueryResource>& resources() const noexcept;
+    int reusedEntryCount() const noexcept;
+    int parsedEntryCount() const noexcept;
+
+    static QString defaultCacheDirectoryPath();
+
+private:
+    QString cacheFilePath() const;
+    void readCache(
+        QHash<QString, WhatSonHubQueryNote>* outNotes,
+        QHash<QString, WhatSonHubQueryResource>* outResources) const;
+    bool writeCache() const;
+
+    int m_maxWorkerCount = 0;
+    QString m_cacheDirectoryPath;
+    QString m_hubPath;
+    QVector<WhatSonHubQueryNote> m_notes;
+    QVector<WhatSonHubQueryResource> m_resources;
+    int m_reusedEntryCount = 0;
+    int m_parsedEntryCount = 0;
+};
@@ -0,0 +1,185 @@
+#include "app/models/file/query/WhatSonMultiHubQuery.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/query/WhatSonHubQueryFilter.hpp"
+
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+} // namespace
+
+WhatSonMultiHubQuery::WhatSonMultiHubQuery() = default;
+
+WhatSonMultiHubQuery::~WhatSonMultiHubQuery() = default;
+
+int WhatSonMultiHubQuery::maxWorkerCount() const noexcept
+{
+    return m_maxWorkerCount;
+}
+
+void WhatSonMultiHubQuery::setMaxWorkerCount(const int maxWorkerCount) noexcept
+{
+    m_maxWorkerCount = maxWorkerCount > 0 ? maxWorkerCount : 0;
+}
+
+QString WhatSonMultiHubQuery::cacheDirectoryPath() const
+{
+    return m_cacheDirectoryPath;
+}
+
+void WhatSonMultiHubQuery::setCacheDirectoryPath(QString cacheDirectoryPath)
+{
+    m_cacheDirectoryPath = std::move(cacheDirectoryPath);
+}
+
+bool WhatSonMultiHubQuery::mountHubs(const QStringList& hubPaths, QStringList* failedPaths, QString* errorMessage)
+{
+    struct PendingIndex final
+    {
+        QString hubPath;
+        std::shared_ptr<WhatSonHubQueryIndex> index;
+        bool loaded = false;
+        QString error;
+    };
+
+    QVector<PendingIndex> pendingIndexes;
+    for (const QString& hubPath : hubPaths)
+    {
+        const QString normalizedPath = WhatSon::HubPath::normalizePath(hubPath);
+        const bool duplicate = std::any_of(
+            pendingIndexes.cbegin(),
+            pendingIndexes.cend(),
+            [&normalizedPath](const PendingIndex& pendingIndex)
+            {
+                return pendingIndex.hubPath == normalizedPath;
+            });
+        if (!normalizedPath.isEmpty() && !duplicate)
+        {
+            pendingIndexes.push_back(PendingIndex{normalizedPath, std::make_shared<WhatSonHubQueryIndex>(), false, {}});
+        }
+    }
+
+    // Hubs load side by side; the worker budget is split between them so nested note parsing does not oversubscribe.
+    const int workerBudget = m_maxWorkerCount > 0 ? m_maxWorkerCount : QThread::idealThreadCount();
+    const int hubWorkerCount = std::max(1, std::min(workerBudget, static_cast<int>(pendingIndexes.size())));
+    const int indexWorkerCount = std::max(1, workerBudget / hubWorkerCount);
+
+    PendingIndex* indexSlots = pendingIndexes.data();
+    QThreadPool workerPool;
+    workerPool.setMaxThreadCount(hubWorkerCount);
+    for (qsizetype row = 0; row < pendingIndexes.size(); ++row)
+    {
+        PendingIndex& pendingIndex = indexSlots[row];
+        pendingIndex.index->setMaxWorkerCount(indexWorkerCount);
+        if (!m_cacheDirectoryPath.isEmpty())
+        {
+            pendingIndex.index->setCacheDirectoryPath(m_cacheDirectoryPath);
+        }
+        workerPool.start([indexSlots, row]()
+        {
+            PendingIndex& slot = indexSlots[row];
+            slot.loaded = slot.index->load(slot.hubPath, &slot.error);
+        });
+    }
+    workerPool.waitForDone();
+
+    QStringList failures;
+    QStringList errors;
+    for (PendingIndex& pendingIndex : pendingIndexes)
+    {
+        if (!pendingIndex.loaded)
+        {
+            failures.push_back(pendingIndex.hubPath);
+            errors.push_back(QStringLiteral("%1: %2").arg(pendingIndex.hubPath, pendingIndex.error));
+            continue;
+        }
+        m_indexes.insert(pendingIndex.hubPath, std::move(pendingIndex.index));
+    }
+
+    if (failedPaths != nullptr)
+    {
+        *failedPaths = failures;
+    }
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hub.query"),
+                              QStringLiteral("mountHubs"),
+                              QStringLiteral("mounted=%1 failed=%2 total=%3")
+                              .arg(pendingIndexes.size() - failures.size())
+                              .arg(failures.size())
+                              .arg(m_indexes.size()));
+    if (!failures.isEmpty())
+    {
+        return failWith(errorMessage, errors.join(QLatin1Char('\n')));
+    }
+    return true;
+}
+
+void WhatSonMultiHubQuery::unmountHub(const QString& hubPath)
+{
+    m_indexes.remove(WhatSon::HubPath::normalizePath(hubPath));
+}
+
+void WhatSonMultiHubQuery::clear()
+{
+    m_indexes.clear();
+}
+
+QStringList WhatSonMultiHubQuery::hubPaths() const
+{
+    QStringList paths = m_indexes.keys();
+    paths.sort();
+    return paths;
+}
+
+const WhatSonHubQueryIndex* WhatSonMultiHubQuery::index(const QString& hubPath) const
+{
+    return m_indexes.value(WhatSon::HubPath::normalizePath(hubPath)).get();
+}
+
+QVector<WhatSonMultiHubQuery::NoteMatch> WhatSonMultiHubQuery::notes(const WhatSonHubQueryFilter& filter) const
+{
+    QVector<NoteMatch> matches;
+    for (const QString& hubPath : hubPaths())
+    {
+        const std::shared_ptr<const WhatSonHubQueryIndex> hubIndex = m_indexes.value(hubPath);
+        for (const WhatSonHubQueryNote& note : hubIndex->notes())
+        {
+            if (filter.matches(note))
+            {
+                matches.push_back(NoteMatch{hubPath, &note});
+            }
+        }
+    }
+    return matches;
+}
+
+QVector<WhatSonMultiHubQuery::ResourceMatch> WhatSonMultiHubQuery::resources(const WhatSonHubQueryFilter& filter) const
+{
+    QVector<ResourceMatch> matches;
+    for (const QString& hubPath : hubPaths())
+    {
+        const std::shared_ptr<const WhatSonHubQueryIndex> hubIndex = m_indexes.value(hubPath);
+        for (const WhatSonHubQueryResource& resource : hubIndex->resources())
+        {
+            if (filter.matches(resource))
+            {
+                matches.push_back(ResourceMatch{hubPath, &resource});
+            }
+        }
+    }
+    return matches;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "app/models/file/query/WhatSonHubQueryIndex.hpp"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+
+class WhatSonHubQueryFilter;
+
+class WhatSonMultiHubQuery final
+{
+public:
+    struct NoteMatch final
+    {
+        QString hubPath;
+        const WhatSonHubQueryNote* note = nullptr;
+    };
+
+    struct ResourceMatch final
+    {
+        QString hubPath;
+        const WhatSonHubQueryResource* resource = nullptr;
+    };
+
+    WhatSonMultiHubQuery();
+    ~WhatSonMultiHubQuery();
+
+    int maxWorkerCount() const noexcept;
+    void setMaxWorkerCount(int maxWorkerCount) noexcept;
+
+    QString cacheDirectoryPath() const;
+    void setCacheDirectoryPath(QString cacheDirectoryPath);
+
+    bool mountHubs(const QStringList& hubPaths, QStringList* failedPaths = nullptr, QString* errorMessage = nullptr);
+    void unmountHub(const QString& hubPath);
+    void clear();
+
+    QStringList hubPaths() const;
+    const WhatSonHubQueryIndex* index(const QString& hubPath) const;
+
+    QVector<NoteMatch> notes(const WhatSonHubQueryFilter& filter) const;
+    QVector<ResourceMatch> resources(const WhatSonHubQueryFilter& filter) const;
+
+private:
+    int m_maxWorkerCount = 0;
+    QString m_cacheDirectoryPath;
+    QHash<QString, std::shared_ptr<const WhatSonHubQueryIndex>> m_indexes;
+};
@@ -1,7 +1,7 @@
 #include "app/models/file/statistic/WhatSonNoteFileStatSupport.hpp"
 
-#include "app/models/file/note/header/WhatSonNoteHeaderCreator.hpp"
 #include "app/models/file/note/header/WhatSonNoteHeaderParser.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderPatcher.hpp"
 
 #include <QDateTime>
 #include <QDir>
@@ -118,40 +118,6 @@ namespace
         }
         return true;
     }
-
-    bool writeHeaderStore(
-        const QString& headerPath,
-        const WhatSonNoteHeaderStore& headerStore,
-        QString* errorMessage)
-    {
-        if (headerPath.trimmed().isEmpty())
-        {
-            setError(errorMessage, QStringLiteral("A note header path is required."));
-            return false;
-        }
-
-        WhatSonNoteHeaderCreator creator{QString(), QString()};
-        QFile headerFile(headerPath);
-        if (!headerFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
-        {
-            setError(
-                errorMessage,
-                QStringLiteral("Failed to write note header: %1").arg(headerFile.errorString()));
-            return false;
-        }
-
-        const QByteArray payload = creator.createHeaderText(headerStore).toUtf8();
-        if (headerFile.write(payload) != payload.size())
-        {
-            setError(
-                errorMessage,
-                QStringLiteral("Failed to write complete note header: %1").arg(headerFile.errorString()));
-            return false;
-        }
-
-        headerFile.close();
-        return true;
-    }
 } // namespace
 
 bool WhatSon::NoteFileStatSupport::incrementOpenCountForNoteHeader(
@@ -159,13 +125,22 @@ bool WhatSon::NoteFileStatSupport::incrementOpenCountForNoteHeader(
     const QString& noteDirectoryPath,
     QString* errorMessage)
 {
-    WhatSonNoteHeaderStore headerStore;
-    QString headerPath;
-    if (!readHeaderStore(noteId, noteDirectoryPath, &headerStore, &headerPath, errorMessage))
+    const QString headerPath = resolveHeaderPath(noteId, noteDirectoryPath);
+    if (headerPath.isEmpty())
+    {
+        setError(errorMessage, QStringLiteral("No .wsnhead file exists for the note."));
+        return false;
+    }
+
+    // Only the openCount and lastOpened lines change, so the patcher splices those two ranges instead of
+    // re-serializing the header.
+    WhatSonNoteHeaderPatcher patcher;
+    if (!patcher.load(headerPath, errorMessage))
     {
         return false;
     }
 
+    WhatSonNoteHeaderStore& headerStore = patcher.store();
     if (headerStore.noteId().trimmed().isEmpty())
     {
         headerStore.setNoteId(noteId.trimmed());
@@ -173,7 +148,7 @@ bool WhatSon::NoteFileStatSupport::incrementOpenCountForNoteHeader(
     headerStore.incrementOpenCount();
     headerStore.setLastOpenedAt(QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
 
-    return writeHeaderStore(headerPath, headerStore, errorMessage);
+    return patcher.save(errorMessage);
 }
 
 bool WhatSon::NoteFileStatSupport::refreshTrackedStatisticsForNote(
@@ -1,9 +1,49 @@
 #include "app/models/file/sync/WhatSonHubSyncController.hpp"
 
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/conflict/WhatSonMergeAncestorStore.hpp"
+#include "app/models/file/conflict/WhatSonThreeWayMergeResolver.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/hub/WhatSonHubSnapshotStore.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 
 #include <utility>
 
+namespace
+{
+    bool readHubText(const QString& hubPath, const QString& relativePath, QString* outText)
+    {
+        QFile file(QDir(hubPath).filePath(relativePath));
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            return false;
+        }
+        *outText = QString::fromUtf8(file.readAll());
+        return true;
+    }
+
+    bool writeHubText(const QString& hubPath, const QString& relativePath, const QString& text)
+    {
+        const QString path = QDir(hubPath).filePath(relativePath);
+        WhatSonHubMutationJournal::Scope journalScope(path, QStringLiteral("Merge sync"));
+        QSaveFile file(path);
+        const QByteArray bytes = text.toUtf8();
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)
+            || file.write(bytes) != bytes.size()
+            || !file.commit())
+        {
+            return false;
+        }
+        journalScope.commit();
+        return true;
+    }
+} // namespace
+
 WhatSonHubSyncController::WhatSonHubSyncController(QObject* parent)
     : QObject(parent)
 {
@@ -37,6 +77,7 @@ void WhatSonHubSyncController::setCurrentHubPath(const QString& hubPath)
 
     m_currentHubPath = normalizedHubPath;
     m_localMutationPending = false;
+    m_localMergeTexts.clear();
     if (m_currentHubPath.isEmpty())
     {
         m_scheduler.stopPeriodic();
@@ -46,6 +87,7 @@ void WhatSonHubSyncController::setCurrentHubPath(const QString& hubPath)
     }
 
     refreshBaseline(true);
+    takePreSyncSnapshot();
     m_scheduler.startPeriodic();
 }
 
@@ -110,6 +152,7 @@ void WhatSonHubSyncController::onScheduledSyncCheck()
     if (m_localMutationPending)
     {
         m_localMutationPending = false;
+        captureLocalMergeTexts(currentObservation);
         m_lastKnownObservation = currentObservation;
         m_watcher.applyDirectoryWatchPaths(m_lastKnownObservation.directoryWatchPaths);
         return;
@@ -122,6 +165,13 @@ void WhatSonHubSyncController::onScheduledSyncCheck()
         return;
     }
 
+    WhatSonHubSyncObservation reloadedObservation = currentObservation;
+    if (mergeRemoteChanges(currentObservation))
+    {
+        // The merged files were written back; observe them so that write is not mistaken for the next remote change.
+        reloadedObservation = m_observationBuilder.inspectHub(m_currentHubPath);
+    }
+
     QString reloadError;
     m_reloadInProgress = true;
     const bool reloadSucceeded = m_reloadCallback(m_currentHubPath, &reloadError);
@@ -135,11 +185,135 @@ void WhatSonHubSyncController::onScheduledSyncCheck()
         return;
     }
 
-    m_lastKnownObservation = currentObservation;
+    m_lastKnownObservation = std::move(reloadedObservation);
     m_watcher.applyDirectoryWatchPaths(m_lastKnownObservation.directoryWatchPaths);
+    recordMergeAncestors(m_lastKnownObservation);
+    takePreSyncSnapshot();
     emit syncReloaded(m_currentHubPath);
 }
 
+// A local write only updates the local side of the merge. The ancestor stays at the text both machines last agreed
+// on until a remote change has been merged against it.
+void WhatSonHubSyncController::captureLocalMergeTexts(const WhatSonHubSyncObservation& currentObservation)
+{
+    for (auto it = currentObservation.mergeableFileStamps.cbegin(); it != currentObservation.mergeableFileStamps.cend(); ++it)
+    {
+        if (m_lastKnownObservation.mergeableFileStamps.value(it.key()) == it.value())
+        {
+            continue;
+        }
+
+        QString localText;
+        if (readHubText(m_currentHubPath, it.key(), &localText))
+        {
+            m_localMergeTexts.insert(it.key(), localText);
+        }
+    }
+}
+
+// Remote edits to headers and hierarchy files that this process also edited since the last sync are merged
+// three ways against the stored ancestor instead of letting the last writer win. Returns true when a merged text
+// was written back to the hub.
+bool WhatSonHubSyncController::mergeRemoteChanges(const WhatSonHubSyncObservation& currentObservation)
+{
+    if (m_localMergeTexts.isEmpty())
+    {
+        return false;
+    }
+
+    const WhatSonThreeWayMergeResolver resolver;
+    bool wroteMergedText = false;
+    int conflictCount = 0;
+    for (auto it = m_localMergeTexts.cbegin(); it != m_localMergeTexts.cend(); ++it)
+    {
+        const QString currentStamp = currentObservation.mergeableFileStamps.value(it.key());
+        if (currentStamp.isEmpty() || m_lastKnownObservation.mergeableFileStamps.value(it.key()) == currentStamp)
+        {
+            continue;
+        }
+
+        QString remoteText;
+        if (!readHubText(m_currentHubPath, it.key(), &remoteText) || remoteText == it.value())
+        {
+            continue;
+        }
+
+        QString mergedText;
+        QVector<WhatSonMergeConflict> conflicts;
+        QString mergeError;
+        if (!resolver.mergeHubFile(
+                m_currentHubPath,
+                it.key(),
+                it.value(),
+                remoteText,
+                &mergedText,
+                &conflicts,
+                &mergeError))
+        {
+            WhatSon::Debug::trace(
+                QStringLiteral("sync.merge"),
+                QStringLiteral("mergeRemoteChanges.failed"),
+                QStringLiteral("path=%1 reason=%2").arg(it.key(), mergeError));
+            continue;
+        }
+
+        conflictCount += conflicts.size();
+        if (mergedText != remoteText && writeHubText(m_currentHubPath, it.key(), mergedText))
+        {
+            wroteMergedText = true;
+        }
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("sync.merge"),
+        QStringLiteral("mergeRemoteChanges"),
+        QStringLiteral("files=%1 conflicts=%2 wrote=%3")
+            .arg(m_localMergeTexts.size())
+            .arg(conflictCount)
+            .arg(wroteMergedText ? QStringLiteral("true") : QStringLiteral("false")));
+    m_localMergeTexts.clear();
+    return wroteMergedText;
+}
+
+// Once the runtime matches the disk, every mergeable file that has no unsynced local edit is the new common
+// ancestor. Only files newer than their stored ancestor are copied, so a steady-state sync costs one stat per file.
+void WhatSonHubSyncController::recordMergeAncestors(const WhatSonHubSyncObservation& currentObservation) const
+{
+    const WhatSonMergeAncestorStore ancestorStore(m_currentHubPath);
+    const QDir hubDirectory(m_currentHubPath);
+    for (auto it = currentObservation.mergeableFileStamps.cbegin(); it != currentObservation.mergeableFileStamps.cend(); ++it)
+    {
+        if (m_localMergeTexts.contains(it.key()))
+        {
+            continue;
+        }
+
+        const QFileInfo ancestorInfo(ancestorStore.ancestorPath(it.key()));
+        if (ancestorInfo.isFile()
+            && ancestorInfo.lastModified() >= QFileInfo(hubDirectory.filePath(it.key())).lastModified())
+        {
+            continue;
+        }
+
+        QString text;
+        if (readHubText(m_currentHubPath, it.key(), &text))
+        {
+            ancestorStore.writeAncestor(it.key(), text);
+        }
+    }
+}
+
+// Snapshot the state the runtime now holds, so the next external sync that lands can be diffed against it and
+// rolled back. Runs on the global pool; unchanged files are reused from the previous snapshot by stat.
+void WhatSonHubSyncController::takePreSyncSnapshot() const
+{
+    if (m_currentHubPath.isEmpty())
+    {
+        return;
+    }
+    WhatSonHubSnapshotStore(m_currentHubPath).createSnapshotInBackground(QStringLiteral("Before sync"));
+}
+
 void WhatSonHubSyncController::refreshBaseline(const bool rebuildWatcher)
 {
     if (m_currentHubPath.isEmpty())
@@ -149,9 +323,16 @@ void WhatSonHubSyncController::refreshBaseline(const bool rebuildWatcher)
         return;
     }
 
-    m_lastKnownObservation = m_observationBuilder.inspectHub(m_currentHubPath);
+    WhatSonHubSyncObservation currentObservation = m_observationBuilder.inspectHub(m_currentHubPath);
+    if (m_localMutationPending)
+    {
+        m_localMutationPending = false;
+        captureLocalMergeTexts(currentObservation);
+    }
+    m_lastKnownObservation = std::move(currentObservation);
     if (rebuildWatcher)
     {
         m_watcher.applyDirectoryWatchPaths(m_lastKnownObservation.directoryWatchPaths);
     }
+    recordMergeAncestors(m_lastKnownObservation);
 }
@@ -4,6 +4,7 @@
 #include "app/models/file/sync/WhatSonHubSyncScheduler.hpp"
 #include "app/models/file/sync/WhatSonHubSyncWatcher.hpp"
 
+#include <QHash>
 #include <QObject>
 
 #include <functional>
@@ -35,6 +36,10 @@ private slots:
 
 private:
     void refreshBaseline(bool rebuildWatcher);
+    void takePreSyncSnapshot() const;
+    void captureLocalMergeTexts(const WhatSonHubSyncObservation& currentObservation);
+    bool mergeRemoteChanges(const WhatSonHubSyncObservation& currentObservation);
+    void recordMergeAncestors(const WhatSonHubSyncObservation& currentObservation) const;
 
     WhatSonHubSyncObservationBuilder m_observationBuilder;
     WhatSonHubSyncScheduler m_scheduler;
@@ -42,6 +47,7 @@ private:
     std::function<bool(const QString&, QString*)> m_reloadCallback;
     QString m_currentHubPath;
     WhatSonHubSyncObservation m_lastKnownObservation;
+    QHash<QString, QString> m_localMergeTexts;
     bool m_reloadInProgress = false;
     bool m_localMutationPending = false;
 };
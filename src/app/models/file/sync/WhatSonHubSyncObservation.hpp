@@ -1,10 +1,14 @@
 #pragma once
 
 #include <QByteArray>
+#include <QHash>
+#include <QString>
 #include <QStringList>
 
 struct WhatSonHubSyncObservation final
 {
     QByteArray signature;
     QStringList directoryWatchPaths;
+    // Relative path -> "size|mtime" for every file the three-way merge can resolve. Unpacked hubs only.
+    QHash<QString, QString> mergeableFileStamps;
 };
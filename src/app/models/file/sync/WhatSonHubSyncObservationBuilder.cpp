@@ -1,5 +1,8 @@
 #include "app/models/file/sync/WhatSonHubSyncObservationBuilder.hpp"
 
+#include "app/models/file/conflict/WhatSonThreeWayMergeResolver.hpp"
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+
 #include <QCryptographicHash>
 #include <QDir>
 #include <QDirIterator>
@@ -50,12 +53,60 @@ namespace
         std::sort(normalized.begin(), normalized.end());
         return normalized;
     }
+
+    QByteArray signatureForRecords(QStringList signatureRecords)
+    {
+        std::sort(signatureRecords.begin(), signatureRecords.end());
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        for (const QString& record : signatureRecords)
+        {
+            hash.addData(record.toUtf8());
+            hash.addData(QByteArrayView("\n", 1));
+        }
+        return hash.result();
+    }
+
+    WhatSonHubSyncObservation inspectPackedHub(const QFileInfo& archiveInfo)
+    {
+        WhatSonHubSyncObservation observation;
+        WhatSonHubArchive archive;
+        if (!archive.open(archiveInfo.absoluteFilePath()))
+        {
+            return observation;
+        }
+
+        QStringList signatureRecords;
+        signatureRecords.reserve(archive.entryCount());
+        for (const QString& entryPath : archive.entryPaths())
+        {
+            if (shouldIgnoreObservedRelativePath(entryPath))
+            {
+                continue;
+            }
+
+            const WhatSonHubArchiveEntry* entry = archive.entry(entryPath);
+            signatureRecords.push_back(QStringLiteral("%1|%2|%3|%4|%5")
+                                           .arg(entryPath,
+                                                entry->directory ? QStringLiteral("dir") : QStringLiteral("file"),
+                                                QString::number(entry->size),
+                                                QString::number(entry->modifiedMsecsSinceEpoch),
+                                                QString::fromLatin1(entry->sha1.toHex())));
+        }
+
+        observation.signature = signatureForRecords(std::move(signatureRecords));
+        observation.directoryWatchPaths = normalizeDirectoryWatchPaths({archiveInfo.absolutePath()});
+        return observation;
+    }
 } // namespace
 
 WhatSonHubSyncObservation WhatSonHubSyncObservationBuilder::inspectHub(const QString& hubPath) const
 {
     WhatSonHubSyncObservation observation;
     const QFileInfo rootInfo(hubPath);
+    if (rootInfo.isFile() && WhatSonHubArchive::isPackedArchive(hubPath))
+    {
+        return inspectPackedHub(rootInfo);
+    }
     if (!rootInfo.exists() || !rootInfo.isDir())
     {
         return observation;
@@ -90,16 +141,15 @@ WhatSonHubSyncObservation WhatSonHubSyncObservationBuilder::inspectHub(const QSt
         {
             observation.directoryWatchPaths.push_back(info.absoluteFilePath());
         }
+        else if (WhatSonThreeWayMergeResolver::supportsStructuredMerge(relativePath))
+        {
+            observation.mergeableFileStamps.insert(
+                relativePath,
+                QStringLiteral("%1|%2").arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch()));
+        }
     }
 
-    std::sort(signatureRecords.begin(), signatureRecords.end());
-    QCryptographicHash hash(QCryptographicHash::Sha256);
-    for (const QString& record : signatureRecords)
-    {
-        hash.addData(record.toUtf8());
-        hash.addData(QByteArrayView("\n", 1));
-    }
-    observation.signature = hash.result();
+    observation.signature = signatureForRecords(std::move(signatureRecords));
     observation.directoryWatchPaths = normalizeDirectoryWatchPaths(std::move(observation.directoryWatchPaths));
     return observation;
 }
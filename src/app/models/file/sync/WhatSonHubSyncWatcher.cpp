@@ -1,5 +1,7 @@
 #include "app/models/file/sync/WhatSonHubSyncWatcher.hpp"
 
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
+
 #include <QDir>
 #include <QSet>
 
@@ -35,6 +37,14 @@ WhatSonHubSyncWatcher::WhatSonHubSyncWatcher(QObject* parent)
         &QFileSystemWatcher::directoryChanged,
         this,
         &WhatSonHubSyncWatcher::watchedPathChanged);
+    QObject::connect(
+        &m_fileSystemWatcher,
+        &QFileSystemWatcher::directoryChanged,
+        this,
+        [](const QString& path)
+        {
+            WhatSonHubLayout::invalidate(path);
+        });
 }
 
 void WhatSonHubSyncWatcher::applyDirectoryWatchPaths(QStringList watchPaths)
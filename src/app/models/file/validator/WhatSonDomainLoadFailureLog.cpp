@@ -0,0 +1,201 @@
+#include "app/models/file/validator/WhatSonDomainLoadFailureLog.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QSaveFile>
+
+#include <utility>
+
+namespace
+{
+    constexpr int kLogVersion = 1;
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    QString formatTimestamp(const QDateTime& timestamp)
+    {
+        return timestamp.toUTC().toString(Qt::ISODateWithMs);
+    }
+} // namespace
+
+QString WhatSonDomainLoadFailureLog::relativeFilePath()
+{
+    return QStringLiteral(".whatson/domain-load-failures.json");
+}
+
+QString WhatSonDomainLoadFailureLog::filePath(const QString& hubDirectoryPath)
+{
+    return WhatSon::HubPath::joinPath(hubDirectoryPath, relativeFilePath());
+}
+
+bool WhatSonDomainLoadFailureLog::read(
+    const QString& hubDirectoryPath,
+    QVector<Entry>* outEntries,
+    QString* errorMessage)
+{
+    if (outEntries == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("Domain load failure output must not be null."));
+    }
+    outEntries->clear();
+
+    const QString logFilePath = filePath(hubDirectoryPath);
+    if (!QFileInfo::exists(logFilePath))
+    {
+        return true;
+    }
+
+    QFile logFile(logFilePath);
+    if (!logFile.open(QIODevice::ReadOnly))
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to read domain load failure log: %1").arg(logFilePath));
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(logFile.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject())
+    {
+        return failWith(
+            errorMessage,
+            QStringLiteral("Invalid domain load failure log JSON: %1").arg(parseError.errorString()));
+    }
+
+    const QJsonObject domains = document.object().value(QStringLiteral("domains")).toObject();
+    outEntries->reserve(domains.size());
+    for (auto it = domains.constBegin(); it != domains.constEnd(); ++it)
+    {
+        const QJsonObject object = it.value().toObject();
+        Entry entry;
+        entry.domain = it.key();
+        entry.error = object.value(QStringLiteral("error")).toString();
+        entry.attempts = object.value(QStringLiteral("attempts")).toInt();
+        entry.firstFailedAtUtc = QDateTime::fromString(
+            object.value(QStringLiteral("firstFailedAt")).toString(),
+            Qt::ISODateWithMs);
+        entry.lastFailedAtUtc = QDateTime::fromString(
+            object.value(QStringLiteral("lastFailedAt")).toString(),
+            Qt::ISODateWithMs);
+        outEntries->push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool WhatSonDomainLoadFailureLog::update(
+    const QString& hubDirectoryPath,
+    const QMap<QString, QString>& failedDomainErrors,
+    const QStringList& recoveredDomains,
+    QString* errorMessage)
+{
+    const QString logFilePath = filePath(hubDirectoryPath);
+    if (failedDomainErrors.isEmpty() && !QFileInfo::exists(logFilePath))
+    {
+        return true;
+    }
+
+    QVector<Entry> entries;
+    QString readError;
+    if (!read(hubDirectoryPath, &entries, &readError))
+    {
+        // A damaged log is rewritten from scratch rather than blocking the record of the current failures.
+        WhatSon::Debug::trace(
+            QStringLiteral("hub.domainFailures"),
+            QStringLiteral("read.failed"),
+            QStringLiteral("path=%1 reason=%2").arg(logFilePath, readError));
+        entries.clear();
+    }
+
+    QJsonObject domains;
+    for (const Entry& entry : std::as_const(entries))
+    {
+        if (recoveredDomains.contains(entry.domain) || failedDomainErrors.contains(entry.domain))
+        {
+            continue;
+        }
+        domains.insert(entry.domain, QJsonObject{
+            {QStringLiteral("error"), entry.error},
+            {QStringLiteral("attempts"), entry.attempts},
+            {QStringLiteral("firstFailedAt"), formatTimestamp(entry.firstFailedAtUtc)},
+            {QStringLiteral("lastFailedAt"), formatTimestamp(entry.lastFailedAtUtc)}
+        });
+    }
+
+    const QString now = formatTimestamp(QDateTime::currentDateTimeUtc());
+    for (auto it = failedDomainErrors.constBegin(); it != failedDomainErrors.constEnd(); ++it)
+    {
+        int attempts = 1;
+        QString firstFailedAt = now;
+        for (const Entry& entry : std::as_const(entries))
+        {
+            if (entry.domain == it.key())
+            {
+                attempts = entry.attempts + 1;
+                firstFailedAt = formatTimestamp(entry.firstFailedAtUtc);
+                break;
+            }
+        }
+        domains.insert(it.key(), QJsonObject{
+            {QStringLiteral("error"), it.value()},
+            {QStringLiteral("attempts"), attempts},
+            {QStringLiteral("firstFailedAt"), firstFailedAt},
+            {QStringLiteral("lastFailedAt"), now}
+        });
+    }
+
+    if (domains.isEmpty())
+    {
+        if (QFileInfo::exists(logFilePath) && !QFile::remove(logFilePath))
+        {
+            return failWith(
+                errorMessage,
+                QStringLiteral("Failed to remove domain load failure log: %1").arg(logFilePath));
+        }
+        WhatSon::Debug::trace(
+            QStringLiteral("hub.domainFailures"),
+            QStringLiteral("cleared"),
+            QStringLiteral("path=%1").arg(logFilePath));
+        return true;
+    }
+
+    if (!QDir().mkpath(QFileInfo(logFilePath).absolutePath()))
+    {
+        return failWith(
+            errorMessage,
+            QStringLiteral("Failed to create domain load failure log directory: %1").arg(logFilePath));
+    }
+
+    const QJsonObject root{
+        {QStringLiteral("version"), kLogVersion},
+        {QStringLiteral("domains"), domains}
+    };
+    const QByteArray bytes = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    QSaveFile logFile(logFilePath);
+    if (!logFile.open(QIODevice::WriteOnly)
+        || logFile.write(bytes) != bytes.size()
+        || !logFile.commit())
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to write domain load failure log: %1").arg(logFilePath));
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.domainFailures"),
+        QStringLiteral("recorded"),
+        QStringLiteral("path=%1 failed=%2 open=%3")
+            .arg(logFilePath)
+            .arg(QStringList(failedDomainErrors.keys()).join(QLatin1Char(',')))
+            .arg(domains.size()));
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QDateTime>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Hub-local record of runtime domains that failed to load while the rest of the hub mounted. The startup coordinator
+// writes it after each mount or retry, and the integrity checker reports the entries that are still open. A domain is
+// dropped from the log as soon as it loads again; the file is removed once no entry is left.
+class WhatSonDomainLoadFailureLog final
+{
+public:
+    struct Entry final
+    {
+        QString domain;
+        QString error;
+        int attempts = 0;
+        QDateTime firstFailedAtUtc;
+        QDateTime lastFailedAtUtc;
+    };
+
+    static QString relativeFilePath();
+    static QString filePath(const QString& hubDirectoryPath);
+
+    static bool read(
+        const QString& hubDirectoryPath,
+        QVector<Entry>* outEntries,
+        QString* errorMessage = nullptr);
+
+    // Bumps the attempt count of every failed domain and drops the recovered ones. A healthy mount of a hub without a
+    // log only costs one stat call.
+    static bool update(
+        const QString& hubDirectoryPath,
+        const QMap<QString, QString>& failedDomainErrors,
+        const QStringList& recoveredDomains,
+        QString* errorMessage = nullptr);
+};
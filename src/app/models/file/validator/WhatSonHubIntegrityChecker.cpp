@@ -0,0 +1,838 @@
+#include "app/models/file/validator/WhatSonHubIntegrityChecker.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
+#include "app/models/file/hub/WhatSonHubCreator.hpp"
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/hub/WhatSonHubStat.hpp"
+#include "app/models/file/note/header/WhatSonNoteHeaderParser.hpp"
+#include "app/models/file/validator/WhatSonDomainLoadFailureLog.hpp"
+#include "app/models/file/validator/WhatSonHubStructureValidator.hpp"
+#include "app/models/hierarchy/folders/WhatSonFoldersHierarchyParser.hpp"
+#include "app/models/hierarchy/folders/WhatSonFoldersHierarchyStore.hpp"
+#include "app/models/hierarchy/resources/WhatSonResourcePackageSupport.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QPair>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    using Finding = WhatSonHubIntegrityFinding;
+
+    struct NoteTask final
+    {
+        QString directoryPath;
+        QString headerPath;
+    };
+
+    struct RequiredEntry final
+    {
+        QString path;
+        bool directory = false;
+    };
+
+    bool failWith(QString* errorMessage, const QString& message)
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = message;
+        }
+        return false;
+    }
+
+    Finding makeFinding(
+        const Finding::Kind kind,
+        const Finding::Severity severity,
+        QString path,
+        QString subject,
+        QString message,
+        const bool repairable = false)
+    {
+        Finding finding;
+        finding.kind = kind;
+        finding.severity = severity;
+        finding.path = std::move(path);
+        finding.subject = std::move(subject);
+        finding.message = std::move(message);
+        finding.repairable = repairable;
+        return finding;
+    }
+
+    bool readUtf8File(const QString& filePath, QString* outText)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        {
+            return false;
+        }
+        *outText = QString::fromUtf8(file.readAll());
+        return true;
+    }
+
+    QString resolveNoteHeaderPath(const QString& noteDirectoryPath)
+    {
+        const QDir noteDirectory(noteDirectoryPath);
+        const QString noteStem = QFileInfo(noteDirectoryPath).completeBaseName().trimmed();
+        if (!noteStem.isEmpty())
+        {
+            const QString stemHeaderPath = noteDirectory.filePath(noteStem + QStringLiteral(".wsnhead"));
+            if (QFileInfo(stemHeaderPath).isFile())
+            {
+                return QDir::cleanPath(stemHeaderPath);
+            }
+        }
+
+        const QString canonicalHeaderPath = noteDirectory.filePath(QStringLiteral("note.wsnhead"));
+        if (QFileInfo(canonicalHeaderPath).isFile())
+        {
+            return QDir::cleanPath(canonicalHeaderPath);
+        }
+
+        const QStringList headerNames = noteDirectory.entryList(
+            QStringList{QStringLiteral("*.wsnhead")},
+            QDir::Files,
+            QDir::Name);
+        for (const QString& headerName : headerNames)
+        {
+            if (!headerName.toCaseFolded().contains(QStringLiteral(".draft.")))
+            {
+                return QDir::cleanPath(noteDirectory.filePath(headerName));
+            }
+        }
+        return headerNames.isEmpty() ? QString() : QDir::cleanPath(noteDirectory.filePath(headerNames.first()));
+    }
+
+    QVector<NoteTask> collectNoteTasks(const QStringList& libraryRoots)
+    {
+        QSet<QString> noteDirectories;
+        for (const QString& libraryRoot : libraryRoots)
+        {
+            QDirIterator iterator(
+                libraryRoot,
+                QStringList{QStringLiteral("*.wsnhead")},
+                QDir::Files | QDir::Hidden,
+                QDirIterator::Subdirectories);
+            while (iterator.hasNext())
+            {
+                iterator.next();
+                noteDirectories.insert(QDir::cleanPath(iterator.fileInfo().absolutePath()));
+            }
+        }
+
+        QStringList sortedDirectories(noteDirectories.cbegin(), noteDirectories.cend());
+        std::sort(sortedDirectories.begin(), sortedDirectories.end());
+
+        QVector<NoteTask> tasks;
+        tasks.reserve(sortedDirectories.size());
+        for (const QString& directoryPath : std::as_const(sortedDirectories))
+        {
+            tasks.push_back(NoteTask{directoryPath, resolveNoteHeaderPath(directoryPath)});
+        }
+        return tasks;
+    }
+
+    QStringList resourceReferencesInBody(const QString& bodyText)
+    {
+        const QRegularExpression resourceTag(
+            QStringLiteral(R"(<\s*resource\b[^>]*>)"),
+            QRegularExpression::CaseInsensitiveOption);
+        const QRegularExpression pathAttribute(
+            QStringLiteral(R"((?:resourcePath|path)\s*=\s*(?:"([^"]+)"|'([^']+)'))"),
+            QRegularExpression::CaseInsensitiveOption);
+
+        QStringList references;
+        QRegularExpressionMatchIterator iterator = resourceTag.globalMatch(bodyText);
+        while (iterator.hasNext())
+        {
+            const QRegularExpressionMatch attributeMatch = pathAttribute.match(iterator.next().captured(0));
+            if (!attributeMatch.hasMatch())
+            {
+                continue;
+            }
+            const QString reference = attributeMatch.captured(1).isEmpty()
+                                          ? attributeMatch.captured(2).trimmed()
+                                          : attributeMatch.captured(1).trimmed();
+            if (!reference.isEmpty())
+            {
+                references.push_back(reference);
+            }
+        }
+        references.removeDuplicates();
+        return references;
+    }
+
+    bool resourceReferenceResolves(const QString& reference, const QStringList& basePaths)
+    {
+        if (WhatSon::HubPath::isNonLocalUrl(reference))
+        {
+            return true;
+        }
+        return !WhatSon::Resources::resolvePackageDirectoryFromReference(reference, basePaths).isEmpty()
+            || !WhatSon::Resources::resolveAssetLocationFromReference(reference, basePaths).isEmpty();
+    }
+
+    QVector<Finding> inspectNote(
+        const NoteTask& task,
+        const QString& hubDirectoryPath,
+        const QSet<QString>* knownFolderUuids)
+    {
+        QVector<Finding> findings;
+        const QDir hubDirectory(hubDirectoryPath);
+        const QString relativeDirectoryPath = hubDirectory.relativeFilePath(task.directoryPath);
+
+        QString headerText;
+        if (task.headerPath.isEmpty() || !readUtf8File(task.headerPath, &headerText))
+        {
+            findings.push_back(makeFinding(
+                Finding::Kind::UnreadableFile,
+                Finding::Severity::Error,
+                task.headerPath.isEmpty() ? relativeDirectoryPath : hubDirectory.relativeFilePath(task.headerPath),
+                QStringLiteral("header"),
+                QStringLiteral("Note header could not be read.")));
+            return findings;
+        }
+
+        const QString relativeHeaderPath = hubDirectory.relativeFilePath(task.headerPath);
+        WhatSonNoteHeaderStore headerStore;
+        QString parseError;
+        if (!WhatSonNoteHeaderParser().parse(headerText, &headerStore, &parseError))
+        {
+            findings.push_back(makeFinding(
+                Finding::Kind::HeaderParseFailed,
+                Finding::Severity::Error,
+                relativeHeaderPath,
+                QStringLiteral("header"),
+                parseError.isEmpty() ? QStringLiteral("Note header could not be parsed.") : parseError));
+        }
+        else if (knownFolderUuids != nullptr)
+        {
+            for (const QString& folderUuid : headerStore.folderUuids())
+            {
+                const QString trimmedUuid = folderUuid.trimmed();
+                if (!trimmedUuid.isEmpty() && !knownFolderUuids->contains(trimmedUuid))
+                {
+                    findings.push_back(makeFinding(
+                        Finding::Kind::DanglingFolderUuid,
+                        Finding::Severity::Warning,
+                        relativeHeaderPath,
+                        trimmedUuid,
+                        QStringLiteral("Folder UUID is not declared in Folders.wsfolders: %1").arg(trimmedUuid)));
+                }
+            }
+        }
+
+        const QStringList basePaths = WhatSon::Resources::resourceReferenceBasePathsForContext(
+            task.directoryPath,
+            task.headerPath,
+            hubDirectory.absolutePath());
+        const QStringList bodyNames = QDir(task.directoryPath).entryList(
+            QStringList{QStringLiteral("*.wsnbody")},
+            QDir::Files,
+            QDir::Name);
+        for (const QString& bodyName : bodyNames)
+        {
+            const QString bodyPath = QDir(task.directoryPath).filePath(bodyName);
+            QString bodyText;
+            if (!readUtf8File(bodyPath, &bodyText))
+            {
+                findings.push_back(makeFinding(
+                    Finding::Kind::UnreadableFile,
+                    Finding::Severity::Error,
+                    hubDirectory.relativeFilePath(bodyPath),
+                    QStringLiteral("body"),
+                    QStringLiteral("Note body could not be read.")));
+                continue;
+            }
+
+            for (const QString& reference : resourceReferencesInBody(bodyText))
+            {
+                if (!resourceReferenceResolves(reference, basePaths))
+                {
+                    findings.push_back(makeFinding(
+                        Finding::Kind::UnresolvedResource,
+                        Finding::Severity::Warning,
+                        hubDirectory.relativeFilePath(bodyPath),
+                        reference,
+                        QStringLiteral("Resource reference does not resolve: %1").arg(reference)));
+                }
+            }
+        }
+        return findings;
+    }
+
+    QString firstCountKey(const QJsonObject& root, const QStringList& keys)
+    {
+        for (const QString& key : keys)
+        {
+            if (root.value(key).isDouble())
+            {
+                return key;
+            }
+        }
+        return {};
+    }
+
+    QString resolveStatPath(const QString& hubDirectoryPath)
+    {
+        const QString preferredPath = QDir(hubDirectoryPath).filePath(
+            QFileInfo(hubDirectoryPath).completeBaseName().trimmed() + QStringLiteral("Stat.wsstat"));
+        if (QFileInfo(preferredPath).isFile())
+        {
+            return QDir::cleanPath(preferredPath);
+        }
+        return WhatSonHubStructureValidator().resolveHubStatPath(hubDirectoryPath);
+    }
+
+    bool writeStatCounts(
+        const QString& statPath,
+        const QString& hubName,
+        const QStringList& noteKeys,
+        const QStringList& resourceKeys,
+        const int noteCount,
+        const int resourceCount)
+    {
+        QString statText;
+        QJsonObject root;
+        if (readUtf8File(statPath, &statText) && !statText.trimmed().isEmpty())
+        {
+            const QJsonDocument document = QJsonDocument::fromJson(statText.toUtf8());
+            if (!document.isObject())
+            {
+                return false;
+            }
+            root = document.object();
+        }
+        else
+        {
+            // A missing stat file is recreated from the scaffold template so it carries the full schema.
+            root = WhatSonHubCreator(QString()).defaultStatObject(
+                hubName,
+                QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        }
+        for (const QString& key : noteKeys)
+        {
+            root.insert(key, noteCount);
+        }
+        for (const QString& key : resourceKeys)
+        {
+            root.insert(key, resourceCount);
+        }
+
+        QSaveFile statFile(statPath);
+        const QByteArray bytes = QJsonDocument(root).toJson(QJsonDocument::Indented);
+        return statFile.open(QIODevice::WriteOnly)
+            && statFile.write(bytes) == bytes.size()
+            && statFile.commit();
+    }
+
+    bool writeRepairsToArchive(
+        const QString& archivePath,
+        const QString& scratchHubPath,
+        const WhatSonHubIntegrityReport& report,
+        QString* errorMessage)
+    {
+        WhatSonHubArchive archive;
+        if (!archive.open(archivePath, errorMessage))
+        {
+            return false;
+        }
+
+        const QDir scratchDirectory(scratchHubPath);
+        QSet<QString> writtenPaths;
+        for (const Finding& finding : report.findings)
+        {
+            if (!finding.repaired || writtenPaths.contains(finding.path))
+            {
+                continue;
+            }
+            writtenPaths.insert(finding.path);
+
+            const QFileInfo repairedInfo(scratchDirectory.filePath(finding.path));
+            const qint64 modifiedMsecs = repairedInfo.lastModified().toMSecsSinceEpoch();
+            if (repairedInfo.isDir())
+            {
+                if (!archive.writeDirectory(finding.path, modifiedMsecs, errorMessage))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            QFile repairedFile(repairedInfo.absoluteFilePath());
+            if (!repairedFile.open(QIODevice::ReadOnly))
+            {
+                return failWith(
+                    errorMessage,
+                    QStringLiteral("Failed to read repaired hub file: %1").arg(repairedInfo.absoluteFilePath()));
+            }
+            if (!archive.writeFileFromDevice(finding.path, &repairedFile, modifiedMsecs, errorMessage))
+            {
+                return false;
+            }
+        }
+
+        WhatSon::Debug::trace(
+            QStringLiteral("hub.integrity"),
+            QStringLiteral("writeRepairsToArchive"),
+            QStringLiteral("path=%1 entries=%2").arg(archivePath).arg(writtenPaths.size()));
+        return archive.flush(errorMessage);
+    }
+} // namespace
+
+QString WhatSonHubIntegrityFinding::kindName(const Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::MissingRequiredEntry:
+        return QStringLiteral("missingRequiredEntry");
+    case Kind::UnreadableFile:
+        return QStringLiteral("unreadableFile");
+    case Kind::HeaderParseFailed:
+        return QStringLiteral("headerParseFailed");
+    case Kind::FoldersParseFailed:
+        return QStringLiteral("foldersParseFailed");
+    case Kind::StatParseFailed:
+        return QStringLiteral("statParseFailed");
+    case Kind::DanglingFolderUuid:
+        return QStringLiteral("danglingFolderUuid");
+    case Kind::UnresolvedResource:
+        return QStringLiteral("unresolvedResource");
+    case Kind::StatCountMismatch:
+        return QStringLiteral("statCountMismatch");
+    case Kind::DomainLoadFailed:
+        return QStringLiteral("domainLoadFailed");
+    }
+    return {};
+}
+
+QString WhatSonHubIntegrityFinding::severityName(const Severity severity)
+{
+    return severity == Severity::Error ? QStringLiteral("error") : QStringLiteral("warning");
+}
+
+QVariantMap WhatSonHubIntegrityFinding::toVariantMap() const
+{
+    return {
+        {QStringLiteral("kind"), kindName(kind)},
+        {QStringLiteral("severity"), severityName(severity)},
+        {QStringLiteral("path"), path},
+        {QStringLiteral("subject"), subject},
+        {QStringLiteral("message"), message},
+        {QStringLiteral("repairable"), repairable},
+        {QStringLiteral("repaired"), repaired}
+    };
+}
+
+int WhatSonHubIntegrityReport::repairedCount() const noexcept
+{
+    return static_cast<int>(std::count_if(
+        findings.cbegin(),
+        findings.cend(),
+        [](const WhatSonHubIntegrityFinding& finding)
+        {
+            return finding.repaired;
+        }));
+}
+
+int WhatSonHubIntegrityReport::unresolvedCount() const noexcept
+{
+    return static_cast<int>(findings.size()) - repairedCount();
+}
+
+bool WhatSonHubIntegrityReport::isClean() const noexcept
+{
+    return unresolvedCount() == 0;
+}
+
+QVariantMap WhatSonHubIntegrityReport::summaryVariantMap() const
+{
+    return {
+        {QStringLiteral("hubPath"), hubPath},
+        {QStringLiteral("noteCount"), noteCount},
+        {QStringLiteral("resourceCount"), resourceCount},
+        {QStringLiteral("findingCount"), static_cast<int>(findings.size())},
+        {QStringLiteral("repairedCount"), repairedCount()},
+        {QStringLiteral("unresolvedCount"), unresolvedCount()},
+        {QStringLiteral("clean"), isClean()}
+    };
+}
+
+WhatSonHubIntegrityChecker::WhatSonHubIntegrityChecker() = default;
+
+WhatSonHubIntegrityChecker::~WhatSonHubIntegrityChecker() = default;
+
+int WhatSonHubIntegrityChecker::maxWorkerCount() const noexcept
+{
+    return m_maxWorkerCount;
+}
+
+void WhatSonHubIntegrityChecker::setMaxWorkerCount(const int maxWorkerCount) noexcept
+{
+    m_maxWorkerCount = std::max(0, maxWorkerCount);
+}
+
+bool WhatSonHubIntegrityChecker::repairEnabled() const noexcept
+{
+    return m_repairEnabled;
+}
+
+void WhatSonHubIntegrityChecker::setRepairEnabled(const bool repairEnabled) noexcept
+{
+    m_repairEnabled = repairEnabled;
+}
+
+bool WhatSonHubIntegrityChecker::check(
+    const QString& hubPath,
+    WhatSonHubIntegrityReport* outReport,
+    QString* errorMessage) const
+{
+    if (outReport == nullptr)
+    {
+        return failWith(errorMessage, QStringLiteral("outReport must not be null."));
+    }
+    *outReport = WhatSonHubIntegrityReport{};
+
+    const QString normalizedHubPath = WhatSon::HubPath::normalizeAbsolutePath(hubPath);
+    if (!WhatSonHubArchive::isPackedArchive(normalizedHubPath))
+    {
+        return checkHubDirectory(normalizedHubPath, outReport, errorMessage);
+    }
+
+    // The mount staging copy belongs to whichever process mounted the hub, and the app and the daemon stage under
+    // different app data locations. The check therefore runs on a private unpacked copy, and repairs are appended to
+    // the archive entry by entry, so a mounted session sees them like any other change to the archive.
+    const QTemporaryDir scratchDirectory;
+    if (!scratchDirectory.isValid())
+    {
+        return failWith(errorMessage, QStringLiteral("Failed to create a scratch directory for: %1").arg(normalizedHubPath));
+    }
+    const QString scratchHubPath = QDir(scratchDirectory.path()).filePath(QFileInfo(normalizedHubPath).fileName());
+    if (!WhatSonHubArchiveConverter().unpackArchive(normalizedHubPath, scratchHubPath, errorMessage)
+        || !checkHubDirectory(scratchHubPath, outReport, errorMessage))
+    {
+        return false;
+    }
+    outReport->hubPath = normalizedHubPath;
+    return outReport->repairedCount() == 0 || writeRepairsToArchive(normalizedHubPath, scratchHubPath, *outReport, errorMessage);
+}
+
+bool WhatSonHubIntegrityChecker::checkHubDirectory(
+    const QString& hubDirectoryPath,
+    WhatSonHubIntegrityReport* outReport,
+    QString* errorMessage) const
+{
+    const WhatSonHubStructureValidator structureValidator;
+    QStringList contentsDirectories;
+    if (!structureValidator.resolveContentsDirectories(hubDirectoryPath, &contentsDirectories, errorMessage))
+    {
+        return false;
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.integrity"),
+        QStringLiteral("check.begin"),
+        QStringLiteral("path=%1 repair=%2").arg(hubDirectoryPath, m_repairEnabled ? QStringLiteral("1") : QStringLiteral("0")));
+
+    const QDir hubDirectory(hubDirectoryPath);
+    const QDir contentsDirectory(contentsDirectories.first());
+    const QString primaryLibraryPath = structureValidator.resolvePrimaryLibraryPath(hubDirectoryPath);
+    outReport->hubPath = hubDirectoryPath;
+
+    QVector<RequiredEntry> requiredEntries = {
+        {contentsDirectory.filePath(QStringLiteral("Folders.wsfolders")), false},
+        {contentsDirectory.filePath(QStringLiteral("ProjectLists.wsproj")), false},
+        {contentsDirectory.filePath(QStringLiteral("Bookmarks.wsbookmarks")), false},
+        {contentsDirectory.filePath(QStringLiteral("Tags.wstags")), false},
+        {contentsDirectory.filePath(QStringLiteral("Progress.wsprogress")), false},
+        {contentsDirectory.filePath(QStringLiteral("Preset.wspreset")), true},
+        {primaryLibraryPath.isEmpty()
+             ? contentsDirectory.filePath(QStringLiteral("Library.wslibrary/index.wsnindex"))
+             : QDir(primaryLibraryPath).filePath(QStringLiteral("index.wsnindex")),
+         false}
+    };
+    if (WhatSon::Resources::resolveResourceRootDirectories(hubDirectoryPath).isEmpty())
+    {
+        requiredEntries.push_back({hubDirectory.filePath(QStringLiteral(".wsresources")), true});
+    }
+    for (const RequiredEntry& requiredEntry : std::as_const(requiredEntries))
+    {
+        const QFileInfo entryInfo(requiredEntry.path);
+        if (entryInfo.exists() && entryInfo.isDir() == requiredEntry.directory)
+        {
+            continue;
+        }
+        outReport->findings.push_back(makeFinding(
+            Finding::Kind::MissingRequiredEntry,
+            Finding::Severity::Error,
+            hubDirectory.relativeFilePath(requiredEntry.path),
+            requiredEntry.directory ? QStringLiteral("directory") : QStringLiteral("file"),
+            QStringLiteral("Required hub entry is missing: %1").arg(hubDirectory.relativeFilePath(requiredEntry.path)),
+            !entryInfo.exists()));
+    }
+
+    QSet<QString> knownFolderUuids;
+    bool foldersParsed = false;
+    QString foldersText;
+    const QString foldersPath = contentsDirectory.filePath(QStringLiteral("Folders.wsfolders"));
+    if (readUtf8File(foldersPath, &foldersText))
+    {
+        WhatSonFoldersHierarchyStore foldersStore;
+        QString foldersError;
+        foldersParsed = WhatSonFoldersHierarchyParser().parse(foldersText, &foldersStore, &foldersError);
+        if (foldersParsed)
+        {
+            for (const WhatSonFolderDepthEntry& folderEntry : foldersStore.folderEntries())
+            {
+                if (!folderEntry.uuid.trimmed().isEmpty())
+                {
+                    knownFolderUuids.insert(folderEntry.uuid.trimmed());
+                }
+            }
+        }
+        else
+        {
+            outReport->findings.push_back(makeFinding(
+                Finding::Kind::FoldersParseFailed,
+                Finding::Severity::Error,
+                hubDirectory.relativeFilePath(foldersPath),
+                QStringLiteral("folders"),
+                foldersError.isEmpty() ? QStringLiteral("Folders.wsfolders could not be parsed.") : foldersError));
+        }
+    }
+
+    const QVector<NoteTask> noteTasks = collectNoteTasks(structureValidator.resolveLibraryRoots(hubDirectoryPath));
+    QVector<QVector<Finding>> noteFindings(noteTasks.size());
+    QVector<Finding>* noteFindingSlots = noteFindings.data();
+    const QSet<QString>* folderUuidFilter = foldersParsed ? &knownFolderUuids : nullptr;
+    {
+        QThreadPool workerPool;
+        workerPool.setMaxThreadCount(m_maxWorkerCount > 0 ? m_maxWorkerCount : QThread::idealThreadCount());
+        for (int taskIndex = 0; taskIndex < noteTasks.size(); ++taskIndex)
+        {
+            workerPool.start([&noteTasks, hubDirectoryPath, folderUuidFilter, noteFindingSlots, taskIndex]()
+            {
+                noteFindingSlots[taskIndex] = inspectNote(noteTasks.at(taskIndex), hubDirectoryPath, folderUuidFilter);
+            });
+        }
+        workerPool.waitForDone();
+    }
+    for (const QVector<Finding>& findings : std::as_const(noteFindings))
+    {
+        outReport->findings += findings;
+    }
+
+    outReport->noteCount = static_cast<int>(noteTasks.size());
+    outReport->resourceCount = static_cast<int>(
+        WhatSon::Resources::listRelativeResourcePackagePathsForHub(hubDirectoryPath).size());
+
+    const QString statPath = resolveStatPath(hubDirectoryPath);
+    QString statText;
+    if (statPath.isEmpty())
+    {
+        const QString expectedStatPath = hubDirectory.filePath(
+            QFileInfo(hubDirectoryPath).completeBaseName().trimmed() + QStringLiteral("Stat.wsstat"));
+        outReport->findings.push_back(makeFinding(
+            Finding::Kind::MissingRequiredEntry,
+            Finding::Severity::Error,
+            hubDirectory.relativeFilePath(expectedStatPath),
+            QStringLiteral("stat"),
+            QStringLiteral("No *.wsstat file found inside hub."),
+            true));
+    }
+    else if (!readUtf8File(statPath, &statText))
+    {
+        outReport->findings.push_back(makeFinding(
+            Finding::Kind::UnreadableFile,
+            Finding::Severity::Error,
+            hubDirectory.relativeFilePath(statPath),
+            QStringLiteral("stat"),
+            QStringLiteral("Hub stat file could not be read.")));
+    }
+    else if (!statText.trimmed().isEmpty())
+    {
+        QJsonParseError parseError;
+        const QJsonDocument document = QJsonDocument::fromJson(statText.toUtf8(), &parseError);
+        if (parseError.error != QJsonParseError::NoError || !document.isObject())
+        {
+            outReport->findings.push_back(makeFinding(
+                Finding::Kind::StatParseFailed,
+                Finding::Severity::Error,
+                hubDirectory.relativeFilePath(statPath),
+                QStringLiteral("stat"),
+                QStringLiteral("Invalid .wsstat JSON: %1").arg(parseError.errorString())));
+        }
+        else
+        {
+            const QJsonObject root = document.object();
+            const std::pair<QString, int> countChecks[] = {
+                {firstCountKey(root, WhatSonHubStat::noteCountKeys()), outReport->noteCount},
+                {firstCountKey(root, WhatSonHubStat::resourceCountKeys()), outReport->resourceCount}
+            };
+            for (const auto& [key, actualCount] : countChecks)
+            {
+                if (key.isEmpty() || root.value(key).toInt() == actualCount)
+                {
+                    continue;
+                }
+                outReport->findings.push_back(makeFinding(
+                    Finding::Kind::StatCountMismatch,
+                    Finding::Severity::Warning,
+                    hubDirectory.relativeFilePath(statPath),
+                    key,
+                    QStringLiteral("%1 is %2 but the hub contains %3.")
+                        .arg(key)
+                        .arg(root.value(key).toInt())
+                        .arg(actualCount),
+                    true));
+            }
+        }
+    }
+
+    // Domains the app could not load on its last mount stay degraded until they load again; surface them here so the
+    // integrity tooling sees the same failures as the sidebar.
+    QVector<WhatSonDomainLoadFailureLog::Entry> domainFailures;
+    QString domainFailuresError;
+    const QString domainFailuresPath = WhatSonDomainLoadFailureLog::relativeFilePath();
+    if (!WhatSonDomainLoadFailureLog::read(hubDirectoryPath, &domainFailures, &domainFailuresError))
+    {
+        outReport->findings.push_back(makeFinding(
+            Finding::Kind::UnreadableFile,
+            Finding::Severity::Warning,
+            domainFailuresPath,
+            QStringLiteral("domainLoadFailures"),
+            domainFailuresError));
+    }
+    for (const WhatSonDomainLoadFailureLog::Entry& domainFailure : std::as_const(domainFailures))
+    {
+        outReport->findings.push_back(makeFinding(
+            Finding::Kind::DomainLoadFailed,
+            Finding::Severity::Warning,
+            domainFailuresPath,
+            domainFailure.domain,
+            QStringLiteral("Domain %1 failed to load %2 time(s) since %3: %4")
+                .arg(domainFailure.domain)
+                .arg(domainFailure.attempts)
+                .arg(domainFailure.firstFailedAtUtc.toString(Qt::ISODate))
+                .arg(domainFailure.error)));
+    }
+
+    std::stable_sort(
+        outReport->findings.begin(),
+        outReport->findings.end(),
+        [](const Finding& lhs, const Finding& rhs)
+        {
+            return lhs.path < rhs.path;
+        });
+
+    if (m_repairEnabled)
+    {
+        applyRepairs(hubDirectoryPath, outReport);
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.integrity"),
+        QStringLiteral("check.success"),
+        QStringLiteral("path=%1 notes=%2 findings=%3 repaired=%4")
+            .arg(hubDirectoryPath)
+            .arg(outReport->noteCount)
+            .arg(outReport->findings.size())
+            .arg(outReport->repairedCount()));
+    return true;
+}
+
+void WhatSonHubIntegrityChecker::applyRepairs(
+    const QString& hubDirectoryPath,
+    WhatSonHubIntegrityReport* report) const
+{
+    const QDir hubDirectory(hubDirectoryPath);
+    const QString hubName = QFileInfo(hubDirectoryPath).completeBaseName().trimmed();
+    const WhatSonHubCreator hubCreator{QString()};
+    const QStringList noteCountKeys = WhatSonHubStat::noteCountKeys();
+    QHash<QString, QPair<QStringList, QStringList>> statKeysByPath;
+    for (Finding& finding : report->findings)
+    {
+        if (!finding.repairable)
+        {
+            continue;
+        }
+
+        const QString absolutePath = QDir::cleanPath(hubDirectory.filePath(finding.path));
+        if (finding.kind == Finding::Kind::StatCountMismatch)
+        {
+            QPair<QStringList, QStringList>& statKeys = statKeysByPath[absolutePath];
+            (noteCountKeys.contains(finding.subject) ? statKeys.first : statKeys.second).push_back(finding.subject);
+            continue;
+        }
+        if (finding.kind != Finding::Kind::MissingRequiredEntry)
+        {
+            continue;
+        }
+
+        if (finding.subject == QStringLiteral("directory"))
+        {
+            finding.repaired = QDir().mkpath(absolutePath);
+        }
+        else if (finding.subject == QStringLiteral("stat"))
+        {
+            finding.repaired = writeStatCounts(
+                absolutePath,
+                hubName,
+                {noteCountKeys.first()},
+                {WhatSonHubStat::resourceCountKeys().first()},
+                report->noteCount,
+                report->resourceCount);
+        }
+        else
+        {
+            // Recreate domain files with the same empty-but-valid content a new hub gets, so the next mount parses.
+            const QByteArray entryBytes = hubCreator.defaultEntryText(QFileInfo(absolutePath).fileName()).toUtf8();
+            QFile entryFile(absolutePath);
+            finding.repaired = !entryBytes.isEmpty()
+                && QDir().mkpath(QFileInfo(absolutePath).absolutePath())
+                && entryFile.open(QIODevice::WriteOnly | QIODevice::NewOnly)
+                && entryFile.write(entryBytes) == entryBytes.size();
+        }
+    }
+
+    for (auto it = statKeysByPath.cbegin(); it != statKeysByPath.cend(); ++it)
+    {
+        const bool repaired = writeStatCounts(
+            it.key(),
+            hubName,
+            it.value().first,
+            it.value().second,
+            report->noteCount,
+            report->resourceCount);
+        for (Finding& finding : report->findings)
+        {
+            if (finding.kind == Finding::Kind::StatCountMismatch
+                && QDir::cleanPath(hubDirectory.filePath(finding.path)) == it.key())
+            {
+                finding.repaired = repaired;
+            }
+        }
+    }
+
+    WhatSon::Debug::trace(
+        QStringLiteral("hub.integrity"),
+        QStringLiteral("applyRepairs"),
+        QStringLiteral("path=%1 repaired=%2").arg(hubDirectoryPath).arg(report->repairedCount()));
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+struct WhatSonHubIntegrityFinding final
+{
+    enum class Kind
+    {
+        MissingRequiredEntry,
+        UnreadableFile,
+        HeaderParseFailed,
+        FoldersParseFailed,
+        StatParseFailed,
+        DanglingFolderUuid,
+        UnresolvedResource,
+        StatCountMismatch,
+        DomainLoadFailed
+    };
+
+    enum class Severity
+    {
+        Warning,
+        Error
+    };
+
+    Kind kind = Kind::MissingRequiredEntry;
+    Severity severity = Severity::Error;
+    QString path;
+    QString subject;
+    QString message;
+    bool repairable = false;
+    bool repaired = false;
+
+    static QString kindName(Kind kind);
+    static QString severityName(Severity severity);
+    QVariantMap toVariantMap() const;
+};
+
+struct WhatSonHubIntegrityReport final
+{
+    QString hubPath;
+    int noteCount = 0;
+    int resourceCount = 0;
+    QVector<WhatSonHubIntegrityFinding> findings;
+
+    int repairedCount() const noexcept;
+    int unresolvedCount() const noexcept;
+    bool isClean() const noexcept;
+    QVariantMap summaryVariantMap() const;
+};
+
+class WhatSonHubIntegrityChecker final
+{
+public:
+    WhatSonHubIntegrityChecker();
+    ~WhatSonHubIntegrityChecker();
+
+    int maxWorkerCount() const noexcept;
+    void setMaxWorkerCount(int maxWorkerCount) noexcept;
+
+    bool repairEnabled() const noexcept;
+    void setRepairEnabled(bool repairEnabled) noexcept;
+
+    bool check(
+        const QString& hubPath,
+        WhatSonHubIntegrityReport* outReport,
+        QString* errorMessage = nullptr) const;
+
+private:
+    bool checkHubDirectory(
+        const QString& hubDirectoryPath,
+        WhatSonHubIntegrityReport* outReport,
+        QString* errorMessage) const;
+    void applyRepairs(const QString& hubDirectoryPath, WhatSonHubIntegrityReport* report) const;
+
+    int m_maxWorkerCount = 0;
+    bool m_repairEnabled = false;
+};
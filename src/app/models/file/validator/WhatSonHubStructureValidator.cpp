@@ -1,5 +1,7 @@
 #include "app/models/file/validator/WhatSonHubStructureValidator.hpp"
 
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
+
 #include <QDir>
 #include <QFileInfo>
 
@@ -44,8 +46,8 @@ bool WhatSonHubStructureValidator::resolveContentsDirectories(
         return false;
     }
 
-    const QFileInfo hubInfo(hubRootPath);
-    if (!hubInfo.exists())
+    const std::shared_ptr<const WhatSonHubLayout> layout = WhatSonHubLayout::cached(hubRootPath);
+    if (!layout->hubExists)
     {
         if (errorMessage != nullptr)
         {
@@ -54,7 +56,8 @@ bool WhatSonHubStructureValidator::resolveContentsDirectories(
         return false;
     }
 
-    if (!hubInfo.isDir() || !hubInfo.fileName().endsWith(QStringLiteral(".wshub"), Qt::CaseInsensitive))
+    if (!layout->hubIsDirectory
+        || !QFileInfo(hubRootPath).fileName().endsWith(QStringLiteral(".wshub"), Qt::CaseInsensitive))
     {
         if (errorMessage != nullptr)
         {
@@ -63,23 +66,7 @@ bool WhatSonHubStructureValidator::resolveContentsDirectories(
         return false;
     }
 
-    const QDir hubDir(hubRootPath);
-    const QString fixedInternalPath = hubDir.filePath(QStringLiteral(".wscontents"));
-    if (QFileInfo(fixedInternalPath).isDir())
-    {
-        outContentsDirectories->push_back(QDir::cleanPath(fixedInternalPath));
-    }
-
-    const QStringList dynamicContentsDirectories = hubDir.entryList(
-        QStringList{QStringLiteral("*.wscontents")},
-        QDir::Dirs | QDir::NoDotAndDotDot,
-        QDir::Name);
-    for (const QString& directoryName : dynamicContentsDirectories)
-    {
-        outContentsDirectories->push_back(QDir::cleanPath(hubDir.filePath(directoryName)));
-    }
-
-    outContentsDirectories->removeDuplicates();
+    *outContentsDirectories = layout->contentsDirectories;
     if (!outContentsDirectories->isEmpty())
     {
         return true;
@@ -100,28 +87,7 @@ QStringList WhatSonHubStructureValidator::resolveLibraryRoots(const QString& wsh
         return {};
     }
 
-    QStringList libraryRoots;
-    for (const QString& contentsDirectory : contentsDirectories)
-    {
-        const QDir contentsDir(contentsDirectory);
-        const QString fixedLibraryPath = contentsDir.filePath(QStringLiteral("Library.wslibrary"));
-        if (QFileInfo(fixedLibraryPath).isDir())
-        {
-            libraryRoots.push_back(QDir::cleanPath(fixedLibraryPath));
-        }
-
-        const QStringList dynamicLibraries = contentsDir.entryList(
-            QStringList{QStringLiteral("*.wslibrary")},
-            QDir::Dirs | QDir::NoDotAndDotDot,
-            QDir::Name);
-        for (const QString& directoryName : dynamicLibraries)
-        {
-            libraryRoots.push_back(QDir::cleanPath(contentsDir.filePath(directoryName)));
-        }
-    }
-
-    libraryRoots.removeDuplicates();
-    return libraryRoots;
+    return WhatSonHubLayout::cached(normalizePath(wshubPath))->libraryRoots;
 }
 
 QString WhatSonHubStructureValidator::resolvePrimaryLibraryPath(const QString& wshubPath, QString* errorMessage) const
@@ -147,15 +113,5 @@ QString WhatSonHubStructureValidator::resolveHubStatPath(const QString& wshubPat
         return {};
     }
 
-    const QDir hubDir(normalizedWshubPath);
-    const QStringList statFiles = hubDir.entryList(
-        QStringList{QStringLiteral("*.wsstat")},
-        QDir::Files | QDir::NoDotAndDotDot,
-        QDir::Name);
-    if (statFiles.isEmpty())
-    {
-        return {};
-    }
-
-    return QDir::cleanPath(hubDir.filePath(statFiles.first()));
+    return WhatSonHubLayout::cached(normalizedWshubPath)->statPaths.value(0);
 }
@@ -0,0 +1,517 @@
+#include "app/models/file/viewer/WhatSonThumbnailCache.hpp"
+
+#include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QUrl>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+    constexpr std::array<int, 4> kBucketEdges{64, 128, 256, 512};
+    constexpr int kContentHashChunkBytes = 64 * 1024;
+    constexpr int kFingerprintCacheEntryLimit = 16384;
+    constexpr int kHubRootSearchDepthLimit = 32;
+    // Pruning stops at this fraction of the disk budget so a full cache is not rescanned on every write.
+    constexpr qint64 kDiskPruneTargetPercent = 75;
+
+    QString thumbnailProviderUrlPrefix()
+    {
+        return QStringLiteral("image://whatson-thumbnail/");
+    }
+
+    QString localSourcePath(const QString& imageSource)
+    {
+        const QString trimmed = imageSource.trimmed();
+        if (trimmed.isEmpty())
+        {
+            return {};
+        }
+
+        const QUrl url(trimmed);
+        if (url.isLocalFile())
+        {
+            return QDir::cleanPath(url.toLocalFile());
+        }
+        if (QFileInfo(trimmed).isAbsolute())
+        {
+            return QDir::cleanPath(trimmed);
+        }
+        return {};
+    }
+
+    QString sourceFingerprint(const QFileInfo& sourceInfo)
+    {
+        return QStringLiteral("%1|%2|%3")
+            .arg(sourceInfo.absoluteFilePath())
+            .arg(sourceInfo.size())
+            .arg(sourceInfo.lastModified().toMSecsSinceEpoch());
+    }
+
+    qint64 imageCost(const QImage& image)
+    {
+        return std::max<qint64>(1, image.sizeInBytes());
+    }
+
+    bool fitsBucket(const QImage& image, const int bucketEdge)
+    {
+        return image.width() <= bucketEdge && image.height() <= bucketEdge;
+    }
+
+    QString diskCacheRootPath(const QString& hubRootPath)
+    {
+        return QDir(hubRootPath).filePath(QStringLiteral(".whatson/thumbnails"));
+    }
+
+    QImage decodeThumbnail(const QString& sourcePath, const int bucketEdge, QString* errorMessage)
+    {
+        QImageReader reader(sourcePath);
+        reader.setAutoTransform(true);
+
+        const QSize sourceSize = reader.size();
+        if (sourceSize.isValid()
+            && (sourceSize.width() > bucketEdge || sourceSize.height() > bucketEdge))
+        {
+            reader.setScaledSize(sourceSize.scaled(bucketEdge, bucketEdge, Qt::KeepAspectRatio));
+        }
+
+        QImage image = reader.read();
+        if (image.isNull())
+        {
+            if (errorMessage != nullptr)
+            {
+                *errorMessage = QStringLiteral("Failed to decode thumbnail source %1: %2")
+                                    .arg(sourcePath, reader.errorString());
+            }
+            return {};
+        }
+
+        // Readers that ignore setScaledSize() (or report no size up front) still hand back the full bitmap.
+        if (!fitsBucket(image, bucketEdge))
+        {
+            image = image.scaled(
+                bucketEdge,
+                bucketEdge,
+                Qt::KeepAspectRatio,
+                Qt::SmoothTransformation);
+        }
+        return image;
+    }
+
+    QImage readDiskThumbnail(const QString& thumbnailPath)
+    {
+        if (thumbnailPath.isEmpty() || !QFileInfo::exists(thumbnailPath))
+        {
+            return {};
+        }
+
+        QImageReader reader(thumbnailPath, "png");
+        return reader.read();
+    }
+
+    bool writeDiskThumbnail(const QString& thumbnailPath, const QImage& image)
+    {
+        if (thumbnailPath.isEmpty() || image.isNull())
+        {
+            return false;
+        }
+        if (!QDir().mkpath(QFileInfo(thumbnailPath).absolutePath()))
+        {
+            return false;
+        }
+
+        QSaveFile thumbnailFile(thumbnailPath);
+        if (!thumbnailFile.open(QIODevice::WriteOnly))
+        {
+            return false;
+        }
+        if (!image.save(&thumbnailFile, "png"))
+        {
+            thumbnailFile.cancelWriting();
+            return false;
+        }
+        return thumbnailFile.commit();
+    }
+} // namespace
+
+WhatSonThumbnailCache::WhatSonThumbnailCache(const qint64 memoryBudgetBytes, const qint64 diskBudgetBytes)
+    : m_memoryBudgetBytes(std::max<qint64>(1, memoryBudgetBytes))
+    , m_diskBudgetBytes(std::max<qint64>(1, diskBudgetBytes))
+    , m_imageCache(m_memoryBudgetBytes)
+    , m_contentHashByFingerprint(kFingerprintCacheEntryLimit)
+{
+}
+
+int WhatSonThumbnailCache::bucketEdgeForRequestedEdge(const int requestedEdge) noexcept
+{
+    if (requestedEdge <= 0)
+    {
+        return kDefaultBucketEdge;
+    }
+
+    for (const int bucketEdge : kBucketEdges)
+    {
+        if (requestedEdge <= bucketEdge)
+        {
+            return bucketEdge;
+        }
+    }
+    return kBucketEdges.back();
+}
+
+QString WhatSonThumbnailCache::thumbnailUrlForImageSource(const QString& imageSource)
+{
+    const QString sourcePath = localSourcePath(imageSource);
+    if (sourcePath.isEmpty())
+    {
+        return imageSource.trimmed();
+    }
+
+    const QByteArray encodedPath = sourcePath.toUtf8().toBase64(
+        QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals);
+    return thumbnailProviderUrlPrefix() + QString::fromLatin1(encodedPath);
+}
+
+QString WhatSonThumbnailCache::sourcePathFromThumbnailId(const QString& thumbnailId)
+{
+    QString encodedPath = thumbnailId.trimmed();
+    const int queryIndex = encodedPath.indexOf(QLatin1Char('?'));
+    if (queryIndex >= 0)
+    {
+        encodedPath.truncate(queryIndex);
+    }
+    if (encodedPath.isEmpty())
+    {
+        return {};
+    }
+
+    const QByteArray::FromBase64Result decoded = QByteArray::fromBase64Encoding(
+        encodedPath.toLatin1(),
+        QByteArray::Base64UrlEncoding | QByteArray::AbortOnBase64DecodingErrors);
+    if (!decoded)
+    {
+        return {};
+    }
+    return QDir::cleanPath(QString::fromUtf8(*decoded));
+}
+
+QString WhatSonThumbnailCache::hubRootPathForSource(const QString& sourcePath)
+{
+    const QString normalizedSourcePath = WhatSon::HubPath::normalizeAbsolutePath(sourcePath);
+    if (normalizedSourcePath.isEmpty())
+    {
+        return {};
+    }
+
+    QDir cursor = QFileInfo(normalizedSourcePath).absoluteDir();
+    for (int depth = 0; depth < kHubRootSearchDepthLimit; ++depth)
+    {
+        if (cursor.dirName().endsWith(QStringLiteral(".wshub"), Qt::CaseInsensitive))
+        {
+            return QDir::cleanPath(cursor.absolutePath());
+        }
+        if (!cursor.cdUp())
+        {
+            break;
+        }
+    }
+    return {};
+}
+
+QString WhatSonThumbnailCache::diskCachePath(
+    const QString& hubRootPath,
+    const QString& contentHash,
+    const int bucketEdge)
+{
+    if (hubRootPath.trimmed().isEmpty() || contentHash.size() < 2)
+    {
+        return {};
+    }
+
+    return QDir(hubRootPath).filePath(
+        QStringLiteral(".whatson/thumbnails/%1/%2/%3.png")
+            .arg(bucketEdge)
+            .arg(contentHash.left(2), contentHash));
+}
+
+qint64 WhatSonThumbnailCache::diskCacheUsageBytes(const QString& hubRootPath)
+{
+    if (hubRootPath.trimmed().isEmpty())
+    {
+        return 0;
+    }
+
+    qint64 usageBytes = 0;
+    QDirIterator iterator(
+        diskCacheRootPath(hubRootPath),
+        {QStringLiteral("*.png")},
+        QDir::Files,
+        QDirIterator::Subdirectories);
+    while (iterator.hasNext())
+    {
+        iterator.next();
+        usageBytes += iterator.fileInfo().size();
+    }
+    return usageBytes;
+}
+
+qint64 WhatSonThumbnailCache::pruneDiskCache(
+    const QString& hubRootPath,
+    const qint64 targetBytes,
+    const QHash<QString, qint64>& lastUseMsByPath)
+{
+    if (hubRootPath.trimmed().isEmpty())
+    {
+        return 0;
+    }
+
+    std::vector<QFileInfo> entries;
+    qint64 usageBytes = 0;
+    QDirIterator iterator(
+        diskCacheRootPath(hubRootPath),
+        {QStringLiteral("*.png")},
+        QDir::Files,
+        QDirIterator::Subdirectories);
+    while (iterator.hasNext())
+    {
+        iterator.next();
+        entries.push_back(iterator.fileInfo());
+        usageBytes += entries.back().size();
+    }
+    if (usageBytes <= targetBytes)
+    {
+        return usageBytes;
+    }
+
+    // Least recently used first: an entry's last use is its write (mtime) or the latest disk hit seen this session.
+    const auto lastUseMs = [&lastUseMsByPath](const QFileInfo& entry)
+    {
+        return std::max(
+            entry.lastModified().toMSecsSinceEpoch(),
+            lastUseMsByPath.value(entry.absoluteFilePath(), 0));
+    };
+    std::sort(
+        entries.begin(),
+        entries.end(),
+        [&lastUseMs](const QFileInfo& lhs, const QFileInfo& rhs)
+        {
+            return lastUseMs(lhs) < lastUseMs(rhs);
+        });
+    for (const QFileInfo& entry : entries)
+    {
+        if (usageBytes <= targetBytes)
+        {
+            break;
+        }
+        if (QFile::remove(entry.absoluteFilePath()))
+        {
+            usageBytes -= entry.size();
+        }
+    }
+    return usageBytes;
+}
+
+QImage WhatSonThumbnailCache::thumbnail(
+    const QString& sourcePath,
+    const int requestedEdge,
+    QString* errorMessage)
+{
+    const QFileInfo sourceInfo(sourcePath);
+    if (!sourceInfo.isFile())
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = QStringLiteral("Thumbnail source does not exist: %1").arg(sourcePath);
+        }
+        return {};
+    }
+
+    const QString contentHash = contentHashForSource(sourceInfo, errorMessage);
+    if (contentHash.isEmpty())
+    {
+        return {};
+    }
+
+    const int bucketEdge = bucketEdgeForRequestedEdge(requestedEdge);
+    const QString memoryKey = QStringLiteral("%1@%2").arg(contentHash).arg(bucketEdge);
+    QImage image = cachedImage(memoryKey);
+    if (!image.isNull())
+    {
+        return image;
+    }
+
+    const QString hubRootPath = hubRootPathForSource(sourceInfo.absoluteFilePath());
+    const QString thumbnailPath = diskCachePath(hubRootPath, contentHash, bucketEdge);
+    image = readDiskThumbnail(thumbnailPath);
+    if (!image.isNull())
+    {
+        recordDiskHit(thumbnailPath);
+    }
+    else
+    {
+        image = decodeThumbnail(sourceInfo.absoluteFilePath(), bucketEdge, errorMessage);
+        if (image.isNull())
+        {
+            return {};
+        }
+        if (writeDiskThumbnail(thumbnailPath, image))
+        {
+            recordDiskWrite(hubRootPath, thumbnailPath);
+        }
+    }
+
+    storeImage(memoryKey, image, bucketEdge);
+    return image;
+}
+
+qint64 WhatSonThumbnailCache::memoryBudgetBytes() const noexcept
+{
+    return m_memoryBudgetBytes;
+}
+
+qint64 WhatSonThumbnailCache::diskBudgetBytes() const noexcept
+{
+    return m_diskBudgetBytes;
+}
+
+qint64 WhatSonThumbnailCache::memoryUsageBytes() const
+{
+    const QMutexLocker locker(&m_mutex);
+    return m_imageCache.totalCost();
+}
+
+int WhatSonThumbnailCache::memoryEntryCount() const
+{
+    const QMutexLocker locker(&m_mutex);
+    return static_cast<int>(m_imageCache.count());
+}
+
+void WhatSonThumbnailCache::clearMemory()
+{
+    const QMutexLocker locker(&m_mutex);
+    m_imageCache.clear();
+    m_contentHashByFingerprint.clear();
+}
+
+QString WhatSonThumbnailCache::contentHashForSource(const QFileInfo& sourceInfo, QString* errorMessage)
+{
+    const QString fingerprint = sourceFingerprint(sourceInfo);
+    {
+        const QMutexLocker locker(&m_mutex);
+        if (const QString* cachedHash = m_contentHashByFingerprint.object(fingerprint))
+        {
+            return *cachedHash;
+        }
+    }
+
+    QFile sourceFile(sourceInfo.absoluteFilePath());
+    if (!sourceFile.open(QIODevice::ReadOnly))
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = QStringLiteral("Failed to open thumbnail source %1: %2")
+                                .arg(sourceInfo.absoluteFilePath(), sourceFile.errorString());
+        }
+        return {};
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    while (!sourceFile.atEnd())
+    {
+        const QByteArray chunk = sourceFile.read(kContentHashChunkBytes);
+        if (chunk.isEmpty() && sourceFile.error() != QFileDevice::NoError)
+        {
+            if (errorMessage != nullptr)
+            {
+                *errorMessage = QStringLiteral("Failed to read thumbnail source %1: %2")
+                                    .arg(sourceInfo.absoluteFilePath(), sourceFile.errorString());
+            }
+            return {};
+        }
+        hash.addData(chunk);
+    }
+
+    const QString contentHash = QString::fromLatin1(hash.result().toHex());
+    const QMutexLocker locker(&m_mutex);
+    m_contentHashByFingerprint.insert(fingerprint, new QString(contentHash));
+    return contentHash;
+}
+
+QImage WhatSonThumbnailCache::cachedImage(const QString& memoryKey) const
+{
+    const QMutexLocker locker(&m_mutex);
+    if (const QImage* image = m_imageCache.object(memoryKey))
+    {
+        return *image;
+    }
+    return {};
+}
+
+void WhatSonThumbnailCache::storeImage(const QString& memoryKey, const QImage& image, const int bucketEdge)
+{
+    const qint64 cost = imageCost(image);
+    if (cost > m_memoryBudgetBytes || !fitsBucket(image, bucketEdge))
+    {
+        return;
+    }
+
+    const QMutexLocker locker(&m_mutex);
+    m_imageCache.insert(memoryKey, new QImage(image), cost);
+}
+
+void WhatSonThumbnailCache::recordDiskHit(const QString& thumbnailPath)
+{
+    // Kept in memory so a read never turns into a write on the hub; pruning merges it with the file mtimes.
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const QMutexLocker locker(&m_mutex);
+    m_diskHitMsByPath.insert(QFileInfo(thumbnailPath).absoluteFilePath(), nowMs);
+}
+
+void WhatSonThumbnailCache::recordDiskWrite(const QString& hubRootPath, const QString& thumbnailPath)
+{
+    const qint64 writtenBytes = QFileInfo(thumbnailPath).size();
+    qint64 usageBytes = 0;
+    {
+        const QMutexLocker locker(&m_mutex);
+        const auto usage = m_diskUsageBytesByHubRoot.constFind(hubRootPath);
+        if (usage != m_diskUsageBytesByHubRoot.constEnd())
+        {
+            usageBytes = usage.value() + writtenBytes;
+            m_diskUsageBytesByHubRoot.insert(hubRootPath, usageBytes);
+        }
+        else
+        {
+            usageBytes = -1;
+        }
+    }
+    if (usageBytes < 0)
+    {
+        // First write into this hub since startup: seed the running total from what is already on disk.
+        usageBytes = diskCacheUsageBytes(hubRootPath);
+    }
+    if (usageBytes > m_diskBudgetBytes)
+    {
+        QHash<QString, qint64> lastUseMsByPath;
+        {
+            const QMutexLocker locker(&m_mutex);
+            lastUseMsByPath = m_diskHitMsByPath;
+        }
+        usageBytes = pruneDiskCache(
+            hubRootPath,
+            m_diskBudgetBytes * kDiskPruneTargetPercent / 100,
+            lastUseMsByPath);
+    }
+
+    const QMutexLocker locker(&m_mutex);
+    m_diskUsageBytesByHubRoot.insert(hubRootPath, usageBytes);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QCache>
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+class WhatSonThumbnailCache final
+{
+public:
+    static constexpr qint64 kDefaultMemoryBudgetBytes = 32LL * 1024LL * 1024LL;
+    static constexpr qint64 kDefaultDiskBudgetBytes = 256LL * 1024LL * 1024LL;
+    static constexpr int kDefaultBucketEdge = 128;
+
+    explicit WhatSonThumbnailCache(
+        qint64 memoryBudgetBytes = kDefaultMemoryBudgetBytes,
+        qint64 diskBudgetBytes = kDefaultDiskBudgetBytes);
+
+    static int bucketEdgeForRequestedEdge(int requestedEdge) noexcept;
+    static QString thumbnailUrlForImageSource(const QString& imageSource);
+    static QString sourcePathFromThumbnailId(const QString& thumbnailId);
+    static QString hubRootPathForSource(const QString& sourcePath);
+    static QString diskCachePath(const QString& hubRootPath, const QString& contentHash, int bucketEdge);
+    static qint64 diskCacheUsageBytes(const QString& hubRootPath);
+    // Deletes least recently used PNGs until the hub's disk tier fits `targetBytes`. An entry was last used at its
+    // mtime or at its entry in `lastUseMsByPath` (absolute path -> msecs since epoch), whichever is later.
+    static qint64 pruneDiskCache(
+        const QString& hubRootPath,
+        qint64 targetBytes,
+        const QHash<QString, qint64>& lastUseMsByPath = {});
+
+    QImage thumbnail(const QString& sourcePath, int requestedEdge, QString* errorMessage = nullptr);
+
+    qint64 memoryBudgetBytes() const noexcept;
+    qint64 diskBudgetBytes() const noexcept;
+    qint64 memoryUsageBytes() const;
+    int memoryEntryCount() const;
+    void clearMemory();
+
+private:
+    QString contentHashForSource(const QFileInfo& sourceInfo, QString* errorMessage);
+    QImage cachedImage(const QString& memoryKey) const;
+    void storeImage(const QString& memoryKey, const QImage& image, int bucketEdge);
+    void recordDiskHit(const QString& thumbnailPath);
+    void recordDiskWrite(const QString& hubRootPath, const QString& thumbnailPath);
+
+    const qint64 m_memoryBudgetBytes;
+    const qint64 m_diskBudgetBytes;
+    mutable QMutex m_mutex;
+    QCache<QString, QImage> m_imageCache;
+    QCache<QString, QString> m_contentHashByFingerprint;
+    QHash<QString, qint64> m_diskUsageBytesByHubRoot;
+    QHash<QString, qint64> m_diskHitMsByPath;
+};
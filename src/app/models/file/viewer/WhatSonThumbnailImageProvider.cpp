@@ -0,0 +1,108 @@
+#include "app/models/file/viewer/WhatSonThumbnailImageProvider.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+
+#include <QQuickTextureFactory>
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    constexpr int kMaximumThumbnailWorkerCount = 4;
+
+    int thumbnailWorkerCount()
+    {
+        return std::clamp(QThread::idealThreadCount() / 2, 1, kMaximumThumbnailWorkerCount);
+    }
+} // namespace
+
+WhatSonThumbnailImageResponse::WhatSonThumbnailImageResponse(
+    WhatSonThumbnailCache* cache,
+    QString sourcePath,
+    const QSize requestedSize)
+    : m_cache(cache)
+    , m_sourcePath(std::move(sourcePath))
+    , m_requestedSize(requestedSize)
+{
+    setAutoDelete(false);
+}
+
+QQuickTextureFactory* WhatSonThumbnailImageResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+QString WhatSonThumbnailImageResponse::errorString() const
+{
+    return m_errorString;
+}
+
+void WhatSonThumbnailImageResponse::cancel()
+{
+    m_cancelled.store(true);
+}
+
+void WhatSonThumbnailImageResponse::run()
+{
+    if (!m_cancelled.load())
+    {
+        if (m_cache == nullptr || m_sourcePath.isEmpty())
+        {
+            m_errorString = QStringLiteral("Thumbnail request does not reference a local image.");
+        }
+        else
+        {
+            const int requestedEdge = std::max(m_requestedSize.width(), m_requestedSize.height());
+            m_image = m_cache->thumbnail(m_sourcePath, requestedEdge, &m_errorString);
+            if (!m_image.isNull())
+            {
+                m_errorString.clear();
+            }
+        }
+    }
+
+    emit finished();
+}
+
+WhatSonThumbnailImageProvider::WhatSonThumbnailImageProvider(const qint64 memoryBudgetBytes)
+    : m_cache(memoryBudgetBytes)
+{
+    m_workerPool.setMaxThreadCount(thumbnailWorkerCount());
+    m_workerPool.setObjectName(QStringLiteral("WhatSonThumbnailWorkers"));
+}
+
+WhatSonThumbnailImageProvider::~WhatSonThumbnailImageProvider()
+{
+    m_workerPool.clear();
+    m_workerPool.waitForDone();
+}
+
+QString WhatSonThumbnailImageProvider::providerId()
+{
+    return QStringLiteral("whatson-thumbnail");
+}
+
+QQuickImageResponse* WhatSonThumbnailImageProvider::requestImageResponse(
+    const QString& id,
+    const QSize& requestedSize)
+{
+    const QString sourcePath = WhatSonThumbnailCache::sourcePathFromThumbnailId(id);
+    WhatSon::Debug::trace(
+        QStringLiteral("thumbnail.provider"),
+        QStringLiteral("requestImageResponse"),
+        QStringLiteral("path=%1 requestedSize=%2x%3")
+            .arg(sourcePath)
+            .arg(requestedSize.width())
+            .arg(requestedSize.height()));
+
+    auto* response = new WhatSonThumbnailImageResponse(&m_cache, sourcePath, requestedSize);
+    m_workerPool.start(response);
+    return response;
+}
+
+WhatSonThumbnailCache& WhatSonThumbnailImageProvider::cache() noexcept
+{
+    return m_cache;
+}
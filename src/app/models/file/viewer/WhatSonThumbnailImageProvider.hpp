@@ -0,0 +1,48 @@
+#pragma once
+
+#include "app/models/file/viewer/WhatSonThumbnailCache.hpp"
+
+#include <QQuickAsyncImageProvider>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <atomic>
+
+class WhatSonThumbnailImageResponse final : public QQuickImageResponse, public QRunnable
+{
+    Q_OBJECT
+
+public:
+    WhatSonThumbnailImageResponse(WhatSonThumbnailCache* cache, QString sourcePath, QSize requestedSize);
+
+    QQuickTextureFactory* textureFactory() const override;
+    QString errorString() const override;
+    void cancel() override;
+    void run() override;
+
+private:
+    WhatSonThumbnailCache* m_cache = nullptr;
+    QString m_sourcePath;
+    QSize m_requestedSize;
+    QImage m_image;
+    QString m_errorString;
+    std::atomic_bool m_cancelled{false};
+};
+
+class WhatSonThumbnailImageProvider final : public QQuickAsyncImageProvider
+{
+public:
+    explicit WhatSonThumbnailImageProvider(
+        qint64 memoryBudgetBytes = WhatSonThumbnailCache::kDefaultMemoryBudgetBytes);
+    ~WhatSonThumbnailImageProvider() override;
+
+    static QString providerId();
+
+    QQuickImageResponse* requestImageResponse(const QString& id, const QSize& requestedSize) override;
+
+    WhatSonThumbnailCache& cache() noexcept;
+
+private:
+    WhatSonThumbnailCache m_cache;
+    QThreadPool m_workerPool;
+};
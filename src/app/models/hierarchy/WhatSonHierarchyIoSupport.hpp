@@ -1,6 +1,7 @@
 #pragma once
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 
 #include <QDir>
@@ -43,8 +44,8 @@ namespace WhatSon::Hierarchy::IoSupport
             return false;
         }
 
-        const QFileInfo hubInfo(hubRootPath);
-        if (!hubInfo.exists())
+        const std::shared_ptr<const WhatSonHubLayout> layout = WhatSonHubLayout::cached(hubRootPath);
+        if (!layout->hubExists)
         {
             if (errorMessage != nullptr)
             {
@@ -53,7 +54,7 @@ namespace WhatSon::Hierarchy::IoSupport
             return false;
         }
 
-        if (!hubInfo.fileName().endsWith(QStringLiteral(".wshub")) || !hubInfo.isDir())
+        if (!hubRootPath.endsWith(QStringLiteral(".wshub")) || !layout->hubIsDirectory)
         {
             if (errorMessage != nullptr)
             {
@@ -62,23 +63,7 @@ namespace WhatSon::Hierarchy::IoSupport
             return false;
         }
 
-        const QDir hubDir(hubRootPath);
-        const QString fixedInternalPath = hubDir.filePath(QStringLiteral(".wscontents"));
-        if (QFileInfo(fixedInternalPath).isDir())
-        {
-            outContentsDirectories->push_back(WhatSon::HubPath::normalizePath(fixedInternalPath));
-        }
-
-        const QStringList dynamicContentsDirectories = hubDir.entryList(
-            QStringList{QStringLiteral("*.wscontents")},
-            QDir::Dirs | QDir::NoDotAndDotDot,
-            QDir::Name);
-        for (const QString& directoryName : dynamicContentsDirectories)
-        {
-            outContentsDirectories->push_back(WhatSon::HubPath::joinPath(hubDir.path(), directoryName));
-        }
-
-        outContentsDirectories->removeDuplicates();
+        *outContentsDirectories = layout->contentsDirectories;
         if (!outContentsDirectories->isEmpty())
         {
             return true;
@@ -1,6 +1,7 @@
 #include "app/models/hierarchy/WhatSonHierarchyModel.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
 
 #include <stdexcept>
 #include <utility>
@@ -112,6 +113,17 @@ WhatSonHierarchyModel::WhatSonHierarchyModel(QObject* parent)
     : QAbstractListModel(parent)
 {
     WhatSon::Debug::traceSelf(this, QStringLiteral("hierarchy.model"), QStringLiteral("ctor"));
+    WhatSonMemoryAccounting::shared().track(
+        this,
+        QStringLiteral("hierarchy"),
+        QStringLiteral("rows"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addVector(m_items, [](WhatSonMemoryEstimate& rowEstimate, const QVariantMap& row)
+            {
+                rowEstimate.addVariantMapPayload(row);
+            });
+        });
 }
 
 int WhatSonHierarchyModel::rowCount(const QModelIndex& parent) const
@@ -450,6 +462,26 @@ bool WhatSonHierarchyModel::setItemExpanded(int index, bool expanded)
     return true;
 }
 
+bool WhatSonHierarchyModel::setItemCount(int index, int count)
+{
+    if (index < 0 || index >= m_items.size())
+    {
+        return false;
+    }
+
+    QVariantMap& item = m_items[index];
+    const auto existingCount = item.constFind(QStringLiteral("count"));
+    if (existingCount != item.constEnd() && existingCount.value().toInt() == count)
+    {
+        return true;
+    }
+
+    item.insert(QStringLiteral("count"), count);
+    const QModelIndex changedIndex = this->index(index, 0);
+    emit dataChanged(changedIndex, changedIndex, {CountRole});
+    return true;
+}
+
 QVariantList WhatSonHierarchyModel::items() const
 {
     QVariantList result;
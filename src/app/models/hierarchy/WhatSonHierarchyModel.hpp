@@ -71,6 +71,7 @@ public:
 
     void setItems(const QVariantList& items);
     bool setItemExpanded(int index, bool expanded);
+    bool setItemCount(int index, int count);
     Q_INVOKABLE QVariantList items() const;
 
 public
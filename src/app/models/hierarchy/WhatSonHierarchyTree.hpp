@@ -0,0 +1,414 @@
+#pragma once
+
+#include "app/models/hierarchy/WhatSonHierarchyTreeItemSupport.hpp"
+
+#include <QVector>
+
+#include <algorithm>
+#include <utility>
+
+namespace WhatSon::Hierarchy
+{
+    // Parent/child view over a flat depth-ordered hierarchy. Every node keeps its subtree size and lazily rebuilt
+    // child offsets, so flat-index lookups cost O(depth * log(fanout)) and subtree edits only walk the ancestor chain
+    // plus the nodes being moved or removed. flatten() writes depth and showChevron back for the flat row contract.
+    template <typename Item>
+    class HierarchyTree final
+    {
+    public:
+        static constexpr int kNoNode = -1;
+
+        HierarchyTree() = default;
+
+        explicit HierarchyTree(const QVector<Item>& flatItems)
+        {
+            assign(flatItems);
+        }
+
+        void assign(const QVector<Item>& flatItems)
+        {
+            m_nodes.clear();
+            m_freeNodes.clear();
+            m_roots.clear();
+            m_rootOffsetsDirty = true;
+            m_liveCount = 0;
+            m_maxFolderSequence = 0;
+            m_nodes.reserve(flatItems.size());
+
+            // Parents are matched on the raw row depth, exactly like TreeItemSupport::subtreeEndIndex, so a row that
+            // skips a depth level still lands in the same subtree as in the flat vector.
+            QVector<int> openAncestors;
+            QVector<int> openAncestorDepths;
+            for (const Item& item : flatItems)
+            {
+                const int depth = std::max(0, item.depth);
+                while (!openAncestorDepths.isEmpty() && openAncestorDepths.constLast() >= depth)
+                {
+                    openAncestors.removeLast();
+                    openAncestorDepths.removeLast();
+                }
+
+                const int parent = openAncestors.isEmpty() ? kNoNode : openAncestors.constLast();
+                observeLabel(item.label);
+                const int node = allocateNode(item);
+                m_nodes[node].depth = openAncestors.size();
+                attach(node, parent, childrenOf(parent).size());
+                openAncestors.push_back(node);
+                openAncestorDepths.push_back(depth);
+            }
+
+            recomputeSubtreeSizes();
+        }
+
+        int size() const noexcept
+        {
+            return m_liveCount;
+        }
+
+        bool isValidNode(int node) const noexcept
+        {
+            return node >= 0 && node < m_nodes.size() && m_nodes.at(node).alive;
+        }
+
+        const Item& item(int node) const
+        {
+            return m_nodes.at(node).item;
+        }
+
+        void updateItem(int node, Item item)
+        {
+            if (!isValidNode(node))
+            {
+                return;
+            }
+            observeLabel(item.label);
+            m_nodes[node].item = std::move(item);
+        }
+
+        int parentOf(int node) const
+        {
+            return isValidNode(node) ? m_nodes.at(node).parent : kNoNode;
+        }
+
+        int depthOf(int node) const
+        {
+            return isValidNode(node) ? m_nodes.at(node).depth : -1;
+        }
+
+        int subtreeSize(int node) const
+        {
+            return isValidNode(node) ? m_nodes.at(node).subtreeSize : 0;
+        }
+
+        const QVector<int>& childrenOf(int node) const
+        {
+            return node == kNoNode ? m_roots : m_nodes.at(node).children;
+        }
+
+        int nodeAt(int flatIndex) const
+        {
+            if (flatIndex < 0 || flatIndex >= m_liveCount)
+            {
+                return kNoNode;
+            }
+
+            int parent = kNoNode;
+            int remaining = flatIndex;
+            while (true)
+            {
+                const QVector<int>& offsets = childOffsets(parent);
+                const auto upper = std::upper_bound(offsets.cbegin(), offsets.cend(), remaining);
+                const int childPosition = static_cast<int>(upper - offsets.cbegin()) - 1;
+                const int child = childrenOf(parent).at(childPosition);
+                remaining -= offsets.at(childPosition);
+                if (remaining == 0)
+                {
+                    return child;
+                }
+                remaining -= 1;
+                parent = child;
+            }
+        }
+
+        int flatIndexOf(int node) const
+        {
+            if (!isValidNode(node))
+            {
+                return -1;
+            }
+
+            int flatIndex = 0;
+            int current = node;
+            while (current != kNoNode)
+            {
+                const int parent = m_nodes.at(current).parent;
+                flatIndex += childOffsets(parent).at(m_nodes.at(current).position);
+                if (parent != kNoNode)
+                {
+                    flatIndex += 1;
+                }
+                current = parent;
+            }
+            return flatIndex;
+        }
+
+        int subtreeEndFlatIndex(int flatIndex) const
+        {
+            const int node = nodeAt(flatIndex);
+            return node == kNoNode ? flatIndex : flatIndex + m_nodes.at(node).subtreeSize;
+        }
+
+        bool isAncestorOrSelf(int ancestor, int node) const
+        {
+            for (int current = node; current != kNoNode; current = m_nodes.at(current).parent)
+            {
+                if (current == ancestor)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        int insertChild(int parent, int position, Item item)
+        {
+            if (parent != kNoNode && !isValidNode(parent))
+            {
+                return kNoNode;
+            }
+
+            observeLabel(item.label);
+            const int node = allocateNode(std::move(item));
+            m_nodes[node].depth = parent == kNoNode ? 0 : m_nodes.at(parent).depth + 1;
+            attach(node, parent, std::clamp(position, 0, static_cast<int>(childrenOf(parent).size())));
+            adjustAncestorSizes(parent, 1);
+            return node;
+        }
+
+        bool removeSubtree(int node)
+        {
+            if (!isValidNode(node))
+            {
+                return false;
+            }
+
+            const int parent = m_nodes.at(node).parent;
+            const int removedCount = m_nodes.at(node).subtreeSize;
+            detach(node);
+            adjustAncestorSizes(parent, -removedCount);
+
+            QVector<int> pending{node};
+            while (!pending.isEmpty())
+            {
+                const int current = pending.takeLast();
+                pending += m_nodes.at(current).children;
+                m_nodes[current] = Node{};
+                m_nodes[current].alive = false;
+                m_freeNodes.push_back(current);
+                --m_liveCount;
+            }
+            return true;
+        }
+
+        bool moveSubtree(int node, int newParent, int position)
+        {
+            if (!isValidNode(node) || (newParent != kNoNode && !isValidNode(newParent)) || isAncestorOrSelf(node, newParent))
+            {
+                return false;
+            }
+
+            const int oldParent = m_nodes.at(node).parent;
+            const int movedCount = m_nodes.at(node).subtreeSize;
+            if (oldParent == newParent && position > m_nodes.at(node).position)
+            {
+                --position;
+            }
+
+            detach(node);
+            adjustAncestorSizes(oldParent, -movedCount);
+            attach(node, newParent, std::clamp(position, 0, static_cast<int>(childrenOf(newParent).size())));
+            adjustAncestorSizes(newParent, movedCount);
+
+            const int depthDelta = (newParent == kNoNode ? 0 : m_nodes.at(newParent).depth + 1) - m_nodes.at(node).depth;
+            if (depthDelta != 0)
+            {
+                QVector<int> pending{node};
+                while (!pending.isEmpty())
+                {
+                    const int current = pending.takeLast();
+                    m_nodes[current].depth += depthDelta;
+                    pending += m_nodes.at(current).children;
+                }
+            }
+            return true;
+        }
+
+        bool setExpanded(int node, bool expanded)
+        {
+            if (!isValidNode(node) || m_nodes.at(node).children.isEmpty())
+            {
+                return false;
+            }
+            m_nodes[node].item.expanded = expanded;
+            return true;
+        }
+
+        // Monotonic: removing the highest FolderN row does not hand its sequence out again.
+        int nextFolderSequence() const noexcept
+        {
+            return m_maxFolderSequence + 1;
+        }
+
+        QVector<Item> flatten() const
+        {
+            QVector<Item> flatItems;
+            flatItems.reserve(m_liveCount);
+
+            QVector<int> pending;
+            for (auto rootIt = m_roots.crbegin(); rootIt != m_roots.crend(); ++rootIt)
+            {
+                pending.push_back(*rootIt);
+            }
+            while (!pending.isEmpty())
+            {
+                const Node& node = m_nodes.at(pending.takeLast());
+                Item item = node.item;
+                item.depth = node.depth;
+                item.showChevron = !node.children.isEmpty();
+                flatItems.push_back(std::move(item));
+                for (auto childIt = node.children.crbegin(); childIt != node.children.crend(); ++childIt)
+                {
+                    pending.push_back(*childIt);
+                }
+            }
+            return flatItems;
+        }
+
+    private:
+        struct Node final
+        {
+            Item item;
+            int parent = kNoNode;
+            int position = 0;
+            int depth = 0;
+            int subtreeSize = 1;
+            bool alive = true;
+            QVector<int> children;
+            mutable QVector<int> childOffsets;
+            mutable bool childOffsetsDirty = true;
+        };
+
+        int allocateNode(Item item)
+        {
+            ++m_liveCount;
+            if (!m_freeNodes.isEmpty())
+            {
+                const int node = m_freeNodes.takeLast();
+                m_nodes[node] = Node{};
+                m_nodes[node].item = std::move(item);
+                return node;
+            }
+
+            m_nodes.push_back(Node{});
+            m_nodes.last().item = std::move(item);
+            return static_cast<int>(m_nodes.size() - 1);
+        }
+
+        QVector<int>& mutableChildrenOf(int node)
+        {
+            return node == kNoNode ? m_roots : m_nodes[node].children;
+        }
+
+        void markOffsetsDirty(int node)
+        {
+            if (node == kNoNode)
+            {
+                m_rootOffsetsDirty = true;
+                return;
+            }
+            m_nodes[node].childOffsetsDirty = true;
+        }
+
+        void attach(int node, int parent, int position)
+        {
+            QVector<int>& siblings = mutableChildrenOf(parent);
+            siblings.insert(position, node);
+            for (int index = position; index < siblings.size(); ++index)
+            {
+                m_nodes[siblings.at(index)].position = index;
+            }
+            m_nodes[node].parent = parent;
+            markOffsetsDirty(parent);
+        }
+
+        void detach(int node)
+        {
+            const int parent = m_nodes.at(node).parent;
+            QVector<int>& siblings = mutableChildrenOf(parent);
+            const int position = m_nodes.at(node).position;
+            siblings.remove(position);
+            for (int index = position; index < siblings.size(); ++index)
+            {
+                m_nodes[siblings.at(index)].position = index;
+            }
+            m_nodes[node].parent = kNoNode;
+            markOffsetsDirty(parent);
+        }
+
+        void adjustAncestorSizes(int node, int delta)
+        {
+            for (int current = node; current != kNoNode; current = m_nodes.at(current).parent)
+            {
+                m_nodes[current].subtreeSize += delta;
+                markOffsetsDirty(m_nodes.at(current).parent);
+            }
+        }
+
+        void recomputeSubtreeSizes()
+        {
+            for (int node = static_cast<int>(m_nodes.size()) - 1; node >= 0; --node)
+            {
+                int subtreeSize = 1;
+                for (const int child : std::as_const(m_nodes.at(node).children))
+                {
+                    subtreeSize += m_nodes.at(child).subtreeSize;
+                }
+                m_nodes[node].subtreeSize = subtreeSize;
+                m_nodes[node].childOffsetsDirty = true;
+            }
+            m_rootOffsetsDirty = true;
+        }
+
+        const QVector<int>& childOffsets(int parent) const
+        {
+            const QVector<int>& children = childrenOf(parent);
+            QVector<int>& offsets = parent == kNoNode ? m_rootOffsets : m_nodes.at(parent).childOffsets;
+            bool& dirty = parent == kNoNode ? m_rootOffsetsDirty : m_nodes.at(parent).childOffsetsDirty;
+            if (dirty)
+            {
+                offsets.resize(children.size());
+                int offset = 0;
+                for (int index = 0; index < children.size(); ++index)
+                {
+                    offsets[index] = offset;
+                    offset += m_nodes.at(children.at(index)).subtreeSize;
+                }
+                dirty = false;
+            }
+            return offsets;
+        }
+
+        void observeLabel(const QString& label)
+        {
+            m_maxFolderSequence = std::max(m_maxFolderSequence, TreeItemSupport::generatedFolderSequenceValue(label));
+        }
+
+        QVector<Node> m_nodes;
+        QVector<int> m_freeNodes;
+        QVector<int> m_roots;
+        mutable QVector<int> m_rootOffsets;
+        mutable bool m_rootOffsetsDirty = true;
+        int m_liveCount = 0;
+        int m_maxFolderSequence = 0;
+    };
+} // namespace WhatSon::Hierarchy
@@ -1,9 +1,10 @@
 #pragma once
 
-#include <QRegularExpression>
+#include <QString>
 #include <QVector>
 
 #include <algorithm>
+#include <limits>
 
 namespace WhatSon::Hierarchy::TreeItemSupport
 {
@@ -34,29 +35,118 @@ namespace WhatSon::Hierarchy::TreeItemSupport
         }
     }
 
+    // Refreshes one row's chevron. A row's chevron only depends on the row after it, so edits touching a contiguous
+    // span only need the rows on each edge of that span refreshed.
     template <typename Item>
-    inline int nextGeneratedFolderSequence(const QVector<Item>& items)
+    inline void refreshChevronAt(QVector<Item>* items, int index)
     {
-        static const QRegularExpression folderPattern(QStringLiteral("^Folder(\\d+)$"));
+        if (items == nullptr || index < 0 || index >= items->size())
+        {
+            return;
+        }
 
-        int maxSequence = 0;
-        for (const Item& item : items)
+        const int nextIndex = index + 1;
+        (*items)[index].showChevron = nextIndex < items->size() && items->at(nextIndex).depth > items->at(index).depth;
+    }
+
+    // Returns N for a generated "FolderN" label and 0 for anything else.
+    inline int generatedFolderSequenceValue(const QString& label)
+    {
+        static const QString kPrefix = QStringLiteral("Folder");
+        if (label.size() <= kPrefix.size() || !label.startsWith(kPrefix))
         {
-            const QRegularExpressionMatch match = folderPattern.match(item.label);
-            if (!match.hasMatch())
+            return 0;
+        }
+
+        int value = 0;
+        for (int index = kPrefix.size(); index < label.size(); ++index)
+        {
+            const QChar character = label.at(index);
+            if (character < QLatin1Char('0') || character > QLatin1Char('9'))
             {
-                continue;
+                return 0;
             }
-
-            bool converted = false;
-            const int value = match.captured(1).toInt(&converted);
-            if (converted)
+            const int digit = character.unicode() - '0';
+            if (value > (std::numeric_limits<int>::max() - digit) / 10)
             {
-                maxSequence = std::max(maxSequence, value);
+                return 0;
             }
+            value = value * 10 + digit;
+        }
+        return value;
+    }
+
+    // Raises the next free folder sequence past one observed label. Controllers keep the counter as a member and call
+    // this per inserted or renamed row, so a commit never rescans the whole hierarchy to find the next sequence.
+    inline void observeGeneratedFolderSequence(int* ioNextSequence, const QString& label)
+    {
+        if (ioNextSequence == nullptr)
+        {
+            return;
+        }
+        *ioNextSequence = std::max(*ioNextSequence, generatedFolderSequenceValue(label) + 1);
+    }
+
+    template <typename Item>
+    inline int subtreeEndIndex(const QVector<Item>& items, int startIndex)
+    {
+        if (startIndex < 0 || startIndex >= items.size())
+        {
+            return startIndex;
+        }
+
+        const int baseDepth = items.at(startIndex).depth;
+        int endIndex = startIndex + 1;
+        while (endIndex < items.size() && items.at(endIndex).depth > baseDepth)
+        {
+            ++endIndex;
+        }
+        return endIndex;
+    }
+
+    // Moves rows [sourceIndex, sourceIndex + sourceCount) so they start at insertIndex in the resulting vector and
+    // re-bases their depth. One rotation touches only the rows between the old and new positions.
+    template <typename Item>
+    inline bool moveHierarchySubtree(
+        QVector<Item>* items,
+        int sourceIndex,
+        int sourceCount,
+        int insertIndex,
+        int newBaseDepth)
+    {
+        if (items == nullptr || sourceCount <= 0 || sourceIndex < 0 || sourceIndex + sourceCount > items->size()
+            || insertIndex < 0 || insertIndex + sourceCount > items->size())
+        {
+            return false;
+        }
+
+        const int depthDelta = newBaseDepth - items->at(sourceIndex).depth;
+        for (int index = sourceIndex; index < sourceIndex + sourceCount; ++index)
+        {
+            (*items)[index].depth = std::max(0, items->at(index).depth + depthDelta);
+        }
+
+        const auto begin = items->begin();
+        if (insertIndex < sourceIndex)
+        {
+            std::rotate(begin + insertIndex, begin + sourceIndex, begin + sourceIndex + sourceCount);
+        }
+        else if (insertIndex > sourceIndex)
+        {
+            std::rotate(begin + sourceIndex, begin + sourceIndex + sourceCount, begin + insertIndex + sourceCount);
         }
 
-        return maxSequence + 1;
+        const int edgeRows[] = {
+            sourceIndex - 1,
+            sourceIndex + sourceCount - 1,
+            insertIndex - 1,
+            insertIndex + sourceCount - 1,
+        };
+        for (const int row : edgeRows)
+        {
+            refreshChevronAt(items, row);
+        }
+        return true;
     }
 
     template <typename Item>
@@ -111,7 +201,8 @@ namespace WhatSon::Hierarchy::TreeItemSupport
         newItem.showChevron = false;
 
         items->insert(insertIndex, newItem);
-        applyChevronByDepth(items);
+        refreshChevronAt(items, insertIndex - 1);
+        refreshChevronAt(items, insertIndex);
         return insertIndex;
     }
 
@@ -120,7 +211,8 @@ namespace WhatSon::Hierarchy::TreeItemSupport
         QVector<Item>* items,
         int selectedIndex,
         int* ioFolderSequence,
-        bool expandSelectedParent = false)
+        bool expandSelectedParent = false,
+        int selectedSubtreeEndIndex = -1)
     {
         if (items == nullptr || ioFolderSequence == nullptr)
         {
@@ -140,11 +232,9 @@ namespace WhatSon::Hierarchy::TreeItemSupport
             const int selectedDepth = items->at(selectedIndex).depth;
             folderDepth = selectedDepth + 1;
 
-            insertIndex = selectedIndex + 1;
-            while (insertIndex < items->size() && items->at(insertIndex).depth > selectedDepth)
-            {
-                ++insertIndex;
-            }
+            insertIndex = selectedSubtreeEndIndex > selectedIndex
+                              ? std::min(selectedSubtreeEndIndex, static_cast<int>(items->size()))
+                              : subtreeEndIndex(*items, selectedIndex);
         }
 
         Item newItem;
@@ -156,12 +246,13 @@ namespace WhatSon::Hierarchy::TreeItemSupport
         newItem.showChevron = true;
 
         items->insert(insertIndex, newItem);
-        applyChevronByDepth(items);
+        refreshChevronAt(items, insertIndex - 1);
+        refreshChevronAt(items, insertIndex);
         return insertIndex;
     }
 
     template <typename Item>
-    inline int deleteHierarchySubtree(QVector<Item>* items, int selectedIndex)
+    inline int deleteHierarchySubtree(QVector<Item>* items, int selectedIndex, int selectedSubtreeEndIndex = -1)
     {
         if (items == nullptr || selectedIndex < 0 || selectedIndex >= items->size())
         {
@@ -169,16 +260,11 @@ namespace WhatSon::Hierarchy::TreeItemSupport
         }
 
         const int startIndex = selectedIndex;
-        const int baseDepth = items->at(startIndex).depth;
-
-        int removeCount = 1;
-        while (startIndex + removeCount < items->size() && items->at(startIndex + removeCount).depth > baseDepth)
-        {
-            ++removeCount;
-        }
-
-        items->remove(startIndex, removeCount);
-        applyChevronByDepth(items);
+        const int endIndex = selectedSubtreeEndIndex > startIndex
+                                 ? std::min(selectedSubtreeEndIndex, static_cast<int>(items->size()))
+                                 : subtreeEndIndex(*items, startIndex);
+        items->remove(startIndex, endIndex - startIndex);
+        refreshChevronAt(items, startIndex - 1);
 
         if (items->isEmpty())
         {
@@ -0,0 +1,491 @@
+#pragma once
+
+#include "app/models/calendar/ISystemCalendarStore.hpp"
+#include "app/models/calendar/SystemCalendarStore.hpp"
+#include "app/models/file/WhatSonDebugTrace.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QUrl>
+#include <QVariantMap>
+#include <QVector>
+
+#include <limits>
+#include <utility>
+
+// Shared normalisation for the note list item structs. Producers run normalizeCommonFields() once when an item is
+// built from an indexed note; the list models then trust what they are handed. appendValidationIssues() is the
+// exhaustive check behind strictValidation, and firstShapeViolation() is the cheap structural check debug builds run
+// on refresh. DisplayDateCache formats the display-date column for the rows a view actually reads.
+namespace WhatSon::Hierarchy::NoteListItemSupport
+{
+    constexpr int kMaxPrimaryTextLines = 5;
+
+    struct ValidationIssue final
+    {
+        QString code;
+        QString message;
+        QVariantMap context;
+    };
+
+    inline QString truncateToMaxLines(const QString& value, int maxLines)
+    {
+        if (maxLines <= 0)
+        {
+            return {};
+        }
+
+        const QStringList lines = value.split(QLatin1Char('\n'));
+        if (lines.size() <= maxLines)
+        {
+            return value;
+        }
+
+        QStringList truncated;
+        truncated.reserve(maxLines);
+        for (int i = 0; i < maxLines; ++i)
+        {
+            truncated.push_back(lines.at(i));
+        }
+        return truncated.join(QLatin1Char('\n'));
+    }
+
+    inline bool isValidHexColor(const QString& value)
+    {
+        static const QRegularExpression kHexColorPattern(QStringLiteral("^#(?:[0-9A-Fa-f]{6}|[0-9A-Fa-f]{8})$"));
+        return kHexColorPattern.match(value).hasMatch();
+    }
+
+    inline QString normalizeLineBreaks(QString value)
+    {
+        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
+        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
+        return value;
+    }
+
+    inline QString normalizePrimaryText(QString value)
+    {
+        return truncateToMaxLines(normalizeLineBreaks(std::move(value)), kMaxPrimaryTextLines).trimmed();
+    }
+
+    inline QString normalizeSearchableText(QString value)
+    {
+        static const QRegularExpression kSearchWhitespacePattern(QStringLiteral("\\s+"));
+        value = normalizeLineBreaks(std::move(value)).trimmed().toCaseFolded();
+        value.replace(kSearchWhitespacePattern, QStringLiteral(" "));
+        return value.trimmed();
+    }
+
+    inline QString normalizeNoteDirectoryPath(QString value)
+    {
+        value = value.trimmed();
+        if (value.isEmpty())
+        {
+            return {};
+        }
+        return QDir::cleanPath(value);
+    }
+
+    inline QString normalizeImageSource(QString value)
+    {
+        value = value.trimmed();
+        if (value.isEmpty())
+        {
+            return {};
+        }
+
+        if (QFileInfo(value).isAbsolute())
+        {
+            return QUrl::fromLocalFile(QDir::cleanPath(value)).toString();
+        }
+
+        const QUrl url(value);
+        if (url.isValid() && !url.scheme().isEmpty())
+        {
+            if (url.isLocalFile())
+            {
+                return QUrl::fromLocalFile(QDir::cleanPath(url.toLocalFile())).toString();
+            }
+            return url.toString();
+        }
+
+        return value;
+    }
+
+    inline QStringList sanitizeMetadataList(QStringList values)
+    {
+        QStringList sanitized;
+        sanitized.reserve(values.size());
+        for (QString value : values)
+        {
+            value = value.trimmed();
+            if (value.isEmpty() || sanitized.contains(value))
+            {
+                continue;
+            }
+            sanitized.push_back(std::move(value));
+        }
+        return sanitized;
+    }
+
+    // Decodes the canonical "yyyy-MM-dd-HH-mm-ss" stamp by hand. Every row is keyed on each refresh, and
+    // QDateTime::fromString() re-parses its format string per call.
+    inline QDateTime parseCanonicalNoteTimestamp(QStringView value)
+    {
+        constexpr int kFieldOffsets[] = {0, 5, 8, 11, 14, 17};
+        constexpr int kFieldWidths[] = {4, 2, 2, 2, 2, 2};
+        if (value.size() != 19)
+        {
+            return {};
+        }
+
+        int fields[6] = {};
+        for (int field = 0; field < 6; ++field)
+        {
+            const int offset = kFieldOffsets[field];
+            if (field > 0 && value.at(offset - 1) != QLatin1Char('-'))
+            {
+                return {};
+            }
+            for (int digit = 0; digit < kFieldWidths[field]; ++digit)
+            {
+                const QChar character = value.at(offset + digit);
+                if (!character.isDigit())
+                {
+                    return {};
+                }
+                fields[field] = fields[field] * 10 + character.digitValue();
+            }
+        }
+
+        const QDate date(fields[0], fields[1], fields[2]);
+        const QTime time(fields[3], fields[4], fields[5]);
+        if (!date.isValid() || !time.isValid())
+        {
+            return {};
+        }
+        return QDateTime(date, time);
+    }
+
+    inline QDateTime parseNoteTimestamp(const QString& value)
+    {
+        const QString trimmed = value.trimmed();
+        if (trimmed.isEmpty())
+        {
+            return {};
+        }
+
+        const QDateTime canonical = parseCanonicalNoteTimestamp(trimmed);
+        if (canonical.isValid())
+        {
+            return canonical;
+        }
+
+        static const QStringList kFormats = {
+            QStringLiteral("yyyy-MM-dd-HH-mm-ss"),
+            QStringLiteral("yyyy-MM-dd-hh-mm-ss"),
+            QStringLiteral("yyyy-MM-ddTHH:mm:ss"),
+            QStringLiteral("yyyy-MM-ddTHH:mm:ssZ"),
+            QStringLiteral("yyyy-MM-dd")
+        };
+
+        for (const QString& format : kFormats)
+        {
+            const QDateTime parsed = QDateTime::fromString(trimmed, format);
+            if (parsed.isValid())
+            {
+                return parsed;
+            }
+        }
+
+        const QDateTime isoWithMs = QDateTime::fromString(trimmed, Qt::ISODateWithMs);
+        if (isoWithMs.isValid())
+        {
+            return isoWithMs;
+        }
+
+        return QDateTime::fromString(trimmed, Qt::ISODate);
+    }
+
+    inline qint64 sortTimestampFor(const QString& lastModifiedAt, const QString& createdAt)
+    {
+        const QDateTime lastModified = parseNoteTimestamp(lastModifiedAt);
+        if (lastModified.isValid())
+        {
+            return lastModified.toMSecsSinceEpoch();
+        }
+
+        const QDateTime created = parseNoteTimestamp(createdAt);
+        if (created.isValid())
+        {
+            return created.toMSecsSinceEpoch();
+        }
+
+        return std::numeric_limits<qint64>::min();
+    }
+
+    // Joins the fields a row is searchable by when its producer did not supply searchableText.
+    template <typename Item>
+    inline QString buildFallbackSearchableText(const Item& item, bool includeId)
+    {
+        QStringList parts;
+        const auto append = [&parts](const QString& value)
+        {
+            const QString trimmed = value.trimmed();
+            if (!trimmed.isEmpty())
+            {
+                parts.push_back(trimmed);
+            }
+        };
+
+        if (includeId)
+        {
+            append(item.id);
+        }
+        append(item.primaryText);
+        append(item.bodyText);
+        for (const QString& folder : item.folders)
+        {
+            append(folder);
+        }
+        for (const QString& tag : item.tags)
+        {
+            append(tag);
+        }
+        return parts.join(QLatin1Char('\n'));
+    }
+
+    // The ingest-time corrections shared by every note list item. searchableText stays empty when the producer left
+    // it empty; each model decides how it falls back.
+    template <typename Item>
+    inline void normalizeCommonFields(Item* item)
+    {
+        item->id = item->id.trimmed();
+        item->primaryText = normalizePrimaryText(std::move(item->primaryText));
+        item->searchableText = normalizeSearchableText(std::move(item->searchableText));
+        item->bodyText = normalizeLineBreaks(std::move(item->bodyText));
+        item->createdAt = item->createdAt.trimmed();
+        item->lastModifiedAt = item->lastModifiedAt.trimmed();
+        item->imageSource = item->image ? normalizeImageSource(std::move(item->imageSource)) : QString();
+        item->displayDate = item->displayDate.trimmed();
+        item->bookmarkColor = item->bookmarked ? item->bookmarkColor.trimmed() : QString();
+        if (!isValidHexColor(item->bookmarkColor))
+        {
+            item->bookmarkColor.clear();
+        }
+        item->folders = sanitizeMetadataList(std::move(item->folders));
+        item->tags = sanitizeMetadataList(std::move(item->tags));
+    }
+
+    inline bool isPadded(const QString& value)
+    {
+        return !value.isEmpty() && (value.front().isSpace() || value.back().isSpace());
+    }
+
+    inline bool hasBlankOrPaddedEntry(const QStringList& values)
+    {
+        for (const QString& value : values)
+        {
+            if (value.isEmpty() || isPadded(value))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Constant-time-per-field structural check for debug builds: it looks for the mistakes a producer that skipped
+    // normalisation would make, without re-running it. Returns the issue code, or nullptr for a well-formed item.
+    template <typename Item>
+    inline const char* firstShapeViolation(const Item& item)
+    {
+        if (isPadded(item.id))
+        {
+            return "notelist.id.padded";
+        }
+        if (isPadded(item.primaryText) || item.primaryText.contains(QLatin1Char('\r')))
+        {
+            return "notelist.primaryText.unnormalized";
+        }
+        if (!item.image && !item.imageSource.isEmpty())
+        {
+            return "notelist.imageSource.cleared";
+        }
+        if (!item.bookmarked && !item.bookmarkColor.isEmpty())
+        {
+            return "notelist.bookmarkColor.cleared";
+        }
+        if (!item.bookmarkColor.isEmpty()
+            && (!item.bookmarkColor.startsWith(QLatin1Char('#'))
+                || (item.bookmarkColor.size() != 7 && item.bookmarkColor.size() != 9)))
+        {
+            return "notelist.bookmarkColor.invalid";
+        }
+        if (hasBlankOrPaddedEntry(item.folders))
+        {
+            return "notelist.folders.sanitized";
+        }
+        if (hasBlankOrPaddedEntry(item.tags))
+        {
+            return "notelist.tags.sanitized";
+        }
+        return nullptr;
+    }
+
+    // Debug-build assertion path: names the first malformed row once per refresh and leaves it as it is. A report here
+    // means a producer skipped normalisation at ingest.
+    template <typename TObject, typename Item>
+    inline bool reportShapeViolation(const TObject* owner, const QString& scope, const Item& item, int row)
+    {
+        const char* code = firstShapeViolation(item);
+        if (code == nullptr)
+        {
+            return false;
+        }
+
+        const QString detail = QStringLiteral("code=%1 row=%2 noteId=%3").arg(QLatin1String(code)).arg(row).arg(item.id);
+        WhatSon::Debug::traceSelf(owner, scope, QStringLiteral("shapeViolation"), detail);
+        qWarning().noquote() << QStringLiteral("%1: unnormalized note list item (%2)").arg(scope, detail);
+        return true;
+    }
+
+    // Exhaustive comparison of an item against its normalised form, used by strictValidation. An empty
+    // searchableText is allowed: the models derive it on demand.
+    template <typename Item>
+    inline void appendValidationIssues(
+        const Item& original,
+        const Item& normalized,
+        int index,
+        QVector<ValidationIssue>* issues)
+    {
+        const auto append = [issues, index](QString code, QString message, QVariantMap context)
+        {
+            context.insert(QStringLiteral("index"), index);
+            issues->push_back(ValidationIssue{std::move(code), std::move(message), std::move(context)});
+        };
+
+        if (normalized.folders != original.folders)
+        {
+            append(QStringLiteral("notelist.folders.sanitized"),
+                   QStringLiteral("Folders list was sanitized."),
+                   QVariantMap{
+                       {QStringLiteral("originalCount"), original.folders.size()},
+                       {QStringLiteral("sanitizedCount"), normalized.folders.size()}
+                   });
+        }
+        if (normalized.tags != original.tags)
+        {
+            append(QStringLiteral("notelist.tags.sanitized"),
+                   QStringLiteral("Tags list was sanitized."),
+                   QVariantMap{
+                       {QStringLiteral("originalCount"), original.tags.size()},
+                       {QStringLiteral("sanitizedCount"), normalized.tags.size()}
+                   });
+        }
+        if (normalized.displayDate != original.displayDate)
+        {
+            append(QStringLiteral("notelist.displayDate.trimmed"),
+                   QStringLiteral("Display date was trimmed."),
+                   QVariantMap{
+                       {QStringLiteral("originalDisplayDate"), original.displayDate},
+                       {QStringLiteral("correctedDisplayDate"), normalized.displayDate}
+                   });
+        }
+        if (normalized.imageSource != original.imageSource)
+        {
+            append(original.image
+                       ? QStringLiteral("notelist.imageSource.normalized")
+                       : QStringLiteral("notelist.imageSource.cleared"),
+                   original.image
+                       ? QStringLiteral("Image source was normalized.")
+                       : QStringLiteral("Image source was cleared because image=false."),
+                   QVariantMap{
+                       {QStringLiteral("originalImageSource"), original.imageSource},
+                       {QStringLiteral("normalizedImageSource"), normalized.imageSource}
+                   });
+        }
+        if (normalized.bookmarkColor != original.bookmarkColor)
+        {
+            append(original.bookmarked
+                       ? QStringLiteral("notelist.bookmarkColor.invalid")
+                       : QStringLiteral("notelist.bookmarkColor.cleared"),
+                   original.bookmarked
+                       ? QStringLiteral("Bookmark color was invalid. Cleared.")
+                       : QStringLiteral("Bookmark color was cleared because bookmarked=false."),
+                   QVariantMap{
+                       {QStringLiteral("originalColor"), original.bookmarkColor},
+                       {QStringLiteral("correctedColor"), normalized.bookmarkColor}
+                   });
+        }
+
+        const bool textChanged = normalized.id != original.id
+            || normalized.primaryText != original.primaryText
+            || normalized.bodyText != original.bodyText
+            || normalized.createdAt != original.createdAt
+            || normalized.lastModifiedAt != original.lastModifiedAt
+            || (!original.searchableText.isEmpty() && normalized.searchableText != original.searchableText);
+        if (textChanged)
+        {
+            append(QStringLiteral("notelist.item.unnormalized"),
+                   QStringLiteral("Note list item text fields were not normalized."),
+                   QVariantMap{{QStringLiteral("noteId"), normalized.id}});
+        }
+    }
+
+    // Display dates keyed by their source timestamps. Producers leave displayDate empty and the models format it
+    // here when a view reads the row, so rows that share a timestamp share one string and a locale change only has
+    // to clear the cache and re-announce the display-date role.
+    class DisplayDateCache final
+    {
+    public:
+        static constexpr int kMaxEntries = 4096;
+
+        QString displayDate(
+            const ISystemCalendarStore* store,
+            const QString& lastModifiedAt,
+            const QString& createdAt) const
+        {
+            QString key;
+            key.reserve(lastModifiedAt.size() + createdAt.size() + 1);
+            key += lastModifiedAt;
+            key += QChar(0x1f);
+            key += createdAt;
+
+            const auto cached = m_entries.constFind(key);
+            if (cached != m_entries.constEnd())
+            {
+                return cached.value();
+            }
+
+            if (m_entries.size() >= kMaxEntries)
+            {
+                m_entries.clear();
+            }
+            const QString text = store != nullptr
+                                     ? store->formatNoteDate(lastModifiedAt, createdAt)
+                                     : SystemCalendarStore::formatNoteDateForSystem(lastModifiedAt, createdAt);
+            m_entries.insert(std::move(key), text);
+            return text;
+        }
+
+        void clear() noexcept
+        {
+            m_entries.clear();
+        }
+
+        int size() const noexcept
+        {
+            return static_cast<int>(m_entries.size());
+        }
+
+    private:
+        mutable QHash<QString, QString> m_entries;
+    };
+} // namespace WhatSon::Hierarchy::NoteListItemSupport
@@ -2,8 +2,8 @@
 
 #include "app/models/calendar/ISystemCalendarStore.hpp"
 #include "app/policy/ArchitecturePolicyLock.hpp"
-#include "app/models/calendar/SystemCalendarStore.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyNoteRecordSupport.hpp"
 #include "app/models/hierarchy/library/WhatSonLibraryIndexedState.hpp"
 #include "app/models/file/note/header/WhatSonBookmarkColorPalette.hpp"
@@ -244,6 +244,35 @@ BookmarksHierarchyController::BookmarksHierarchyController(QObject* parent)
 {
     WhatSon::Debug::traceSelf(this, QString::fromLatin1(kScope), QStringLiteral("ctor"));
     initializeHierarchyInterfaceSignalBridge();
+    WhatSonMemoryAccounting::shared().track(
+        this,
+        QStringLiteral("bookmarks"),
+        QStringLiteral("bookmarkedNotes"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addNoteRecords(m_bookmarkedNotes);
+        });
+    WhatSonMemoryAccounting::shared().track(
+        this,
+        QStringLiteral("bookmarks"),
+        QStringLiteral("bookmarkedListItems"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addVector(
+                m_bookmarkedListItems,
+                [](WhatSonMemoryEstimate& itemEstimate, const BookmarksNoteListItem& item)
+                {
+                    itemEstimate.addStringPayload(item.id);
+                    itemEstimate.addStringPayload(item.primaryText);
+                    itemEstimate.addStringPayload(item.searchableText);
+                    itemEstimate.addStringPayload(item.createdAt);
+                    itemEstimate.addStringPayload(item.lastModifiedAt);
+                    itemEstimate.addStringPayload(item.displayDate);
+                    itemEstimate.addStringListPayload(item.folders);
+                    itemEstimate.addStringListPayload(item.tags);
+                    itemEstimate.addStringPayload(item.bookmarkColor);
+                });
+        });
     QObject::connect(
         &m_itemModel,
         &WhatSonHierarchyModel::itemCountChanged,
@@ -315,7 +344,7 @@ void BookmarksHierarchyController::setSystemCalendarStore(ISystemCalendarStore*
             this,
             [this]()
             {
-                refreshNoteListForSelection();
+                m_noteListModel.refreshDisplayDates();
             });
     }
     else
@@ -323,7 +352,7 @@ void BookmarksHierarchyController::setSystemCalendarStore(ISystemCalendarStore*
         m_systemCalendarStoreChangedConnection = {};
     }
 
-    refreshNoteListForSelection();
+    m_noteListModel.setSystemCalendarStore(m_systemCalendarStore);
 }
 
 ISystemCalendarStore* BookmarksHierarchyController::systemCalendarStore() const noexcept
@@ -498,6 +527,11 @@ bool BookmarksHierarchyController::removeNoteById(const QString& noteId)
     const int removedCurrentVisibleIndex = removedCurrentVisibleNote ? m_noteListModel.currentIndex() : -1;
 
     m_bookmarkedNotes.removeAt(noteIndex);
+    m_bookmarkedListItems.removeIf(
+        [&normalizedNoteId](const BookmarksNoteListItem& item)
+        {
+            return item.id == normalizedNoteId;
+        });
     refreshNoteListForSelection();
     emit hierarchyModelChanged();
     if (removedCurrentVisibleNote)
@@ -571,6 +605,7 @@ bool BookmarksHierarchyController::loadFromWshub(const QString& wshubPath, QStri
 
     m_wshubPath = normalizedWshubPath;
     m_bookmarkedNotes = WhatSonLibraryIndexedState::collectBookmarkedNotes(indexedState.allNotes());
+    rebuildBookmarkedListItems();
     rebuildColorFolders();
     setSelectedIndex(-1);
     refreshNoteListForSelection();
@@ -593,6 +628,7 @@ void BookmarksHierarchyController::applyRuntimeSnapshot(
     if (!loadSucceeded)
     {
         m_bookmarkedNotes.clear();
+        m_bookmarkedListItems.clear();
         rebuildColorFolders();
         setSelectedIndex(-1);
         refreshNoteListForSelection();
@@ -601,6 +637,7 @@ void BookmarksHierarchyController::applyRuntimeSnapshot(
     }
 
     m_bookmarkedNotes = std::move(bookmarkedNotes);
+    rebuildBookmarkedListItems();
     rebuildColorFolders();
     setSelectedIndex(-1);
     refreshNoteListForSelection();
@@ -653,6 +690,7 @@ bool BookmarksHierarchyController::reloadFromWshubPath(QString* errorMessage)
     }
 
     m_bookmarkedNotes = WhatSonLibraryIndexedState::collectBookmarkedNotes(indexedState.allNotes());
+    rebuildBookmarkedListItems();
     rebuildColorFolders();
 
     int restoredSelectionIndex = -1;
@@ -734,14 +772,26 @@ BookmarksNoteListItem BookmarksHierarchyController::buildBookmarksListItem(const
     item.lastModifiedAt = note.lastModifiedAt;
     item.image = false;
     item.imageSource.clear();
-    item.displayDate = m_systemCalendarStore
-                           ? m_systemCalendarStore->formatNoteDate(note.lastModifiedAt, note.createdAt)
-                           : SystemCalendarStore::formatNoteDateForSystem(note.lastModifiedAt, note.createdAt);
+    // The list model formats displayDate for the rows a view reads.
+    item.displayDate.clear();
     item.folders = bookmarkListFolders(note);
     item.tags = bookmarkListTags(note);
     item.bookmarked = true;
     item.bookmarkColor = bookmarkColorHexForNote(note);
-    return item;
+    return BookmarksNoteListModel::normalizedItem(std::move(item));
+}
+
+// Items are built, normalised and ordered once per note load; selection changes only pick from this cache and
+// locale changes only touch the model's display dates.
+void BookmarksHierarchyController::rebuildBookmarkedListItems()
+{
+    m_bookmarkedListItems.clear();
+    m_bookmarkedListItems.reserve(m_bookmarkedNotes.size());
+    for (const LibraryNoteRecord& note : std::as_const(m_bookmarkedNotes))
+    {
+        m_bookmarkedListItems.push_back(buildBookmarksListItem(note));
+    }
+    BookmarksNoteListModel::sortItemsForDisplay(&m_bookmarkedListItems);
 }
 
 void BookmarksHierarchyController::refreshNoteListForSelection()
@@ -749,22 +799,15 @@ void BookmarksHierarchyController::refreshNoteListForSelection()
     const QString selectedColorHex = colorHexForLabel(selectedColorLabel());
     if (selectedColorHex.isEmpty())
     {
-        QVector<BookmarksNoteListItem> allItems;
-        allItems.reserve(m_bookmarkedNotes.size());
-        for (const LibraryNoteRecord& note : std::as_const(m_bookmarkedNotes))
-        {
-            allItems.push_back(buildBookmarksListItem(note));
-        }
-        m_noteListModel.setItems(std::move(allItems));
+        m_noteListModel.setItems(m_bookmarkedListItems);
         updateNoteItemCount();
         return;
     }
 
     QVector<BookmarksNoteListItem> filtered;
-    filtered.reserve(m_bookmarkedNotes.size());
-    for (const LibraryNoteRecord& note : std::as_const(m_bookmarkedNotes))
+    filtered.reserve(m_bookmarkedListItems.size());
+    for (const BookmarksNoteListItem& item : std::as_const(m_bookmarkedListItems))
     {
-        const BookmarksNoteListItem item = buildBookmarksListItem(note);
         if (item.bookmarkColor.compare(selectedColorHex, Qt::CaseInsensitive) != 0)
         {
             continue;
@@ -772,7 +815,7 @@ void BookmarksHierarchyController::refreshNoteListForSelection()
         filtered.push_back(item);
     }
 
-    m_noteListModel.setItems(filtered);
+    m_noteListModel.setItems(std::move(filtered));
     updateNoteItemCount();
 }
 
@@ -100,12 +100,14 @@ private:
     void updateLoadState(bool succeeded, QString errorMessage = QString());
     void rebuildColorFolders();
     BookmarksNoteListItem buildBookmarksListItem(const LibraryNoteRecord& note) const;
+    void rebuildBookmarkedListItems();
     void refreshNoteListForSelection();
     QString selectedColorLabel() const;
     void syncModel();
 
     QVector<BookmarksHierarchyItem> m_items;
     QVector<LibraryNoteRecord> m_bookmarkedNotes;
+    QVector<BookmarksNoteListItem> m_bookmarkedListItems;
     WhatSonHierarchyModel m_itemModel;
     BookmarksNoteListModel m_noteListModel;
     int m_selectedIndex = -1;
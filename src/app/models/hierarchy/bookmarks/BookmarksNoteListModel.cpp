@@ -1,142 +1,19 @@
 #include "app/models/hierarchy/bookmarks/BookmarksNoteListModel.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/viewer/WhatSonThumbnailCache.hpp"
+#include "app/models/hierarchy/WhatSonNoteListItemSupport.hpp"
 
-#include <QDir>
-#include <QDateTime>
-#include <QFileInfo>
-#include <QRegularExpression>
-#include <QUrl>
 #include <algorithm>
-#include <limits>
+#include <functional>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
 
 namespace
 {
-    constexpr int kMaxNoteListPrimaryTextLines = 5;
-    const QRegularExpression kSearchWhitespacePattern(QStringLiteral("\\s+"));
-
-    struct ValidationIssue final
-    {
-        QString code;
-        QString message;
-        QVariantMap context;
-    };
-
-    QString truncateToMaxLines(const QString& value, int maxLines)
-    {
-        if (maxLines <= 0)
-        {
-            return {};
-        }
-
-        const QStringList lines = value.split(QLatin1Char('\n'));
-        if (lines.size() <= maxLines)
-        {
-            return value;
-        }
-
-        QStringList truncated;
-        truncated.reserve(maxLines);
-        for (int i = 0; i < maxLines; ++i)
-        {
-            truncated.push_back(lines.at(i));
-        }
-        return truncated.join(QLatin1Char('\n'));
-    }
-
-    bool isValidHexColor(const QString& value)
-    {
-        static const QRegularExpression kHexColorPattern(QStringLiteral("^#(?:[0-9A-Fa-f]{6}|[0-9A-Fa-f]{8})$"));
-        return kHexColorPattern.match(value).hasMatch();
-    }
-
-    QString normalizePrimaryText(QString value)
-    {
-        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-        value = truncateToMaxLines(value, kMaxNoteListPrimaryTextLines);
-        return value.trimmed();
-    }
-
-    QString normalizeSearchableText(QString value)
-    {
-        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-        value = value.trimmed().toCaseFolded();
-        value.replace(kSearchWhitespacePattern, QStringLiteral(" "));
-        return value.trimmed();
-    }
-
-    QString normalizeBodyText(QString value)
-    {
-        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-        return value;
-    }
-
-    QString normalizeTimestamp(QString value)
-    {
-        return value.trimmed();
-    }
-
-    QDateTime parseNoteTimestamp(const QString& value)
-    {
-        const QString trimmed = value.trimmed();
-        if (trimmed.isEmpty())
-        {
-            return {};
-        }
-
-        static const QStringList kFormats = {
-            QStringLiteral("yyyy-MM-dd-HH-mm-ss"),
-            QStringLiteral("yyyy-MM-dd-hh-mm-ss"),
-            QStringLiteral("yyyy-MM-ddTHH:mm:ss"),
-            QStringLiteral("yyyy-MM-ddTHH:mm:ssZ"),
-            QStringLiteral("yyyy-MM-dd")
-        };
-
-        for (const QString& format : kFormats)
-        {
-            const QDateTime parsed = QDateTime::fromString(trimmed, format);
-            if (parsed.isValid())
-            {
-                return parsed;
-            }
-        }
-
-        const QDateTime isoWithMs = QDateTime::fromString(trimmed, Qt::ISODateWithMs);
-        if (isoWithMs.isValid())
-        {
-            return isoWithMs;
-        }
-
-        const QDateTime iso = QDateTime::fromString(trimmed, Qt::ISODate);
-        if (iso.isValid())
-        {
-            return iso;
-        }
-
-        return {};
-    }
-
-    qint64 effectiveSortTimestamp(const BookmarksNoteListItem& item)
-    {
-        const QDateTime lastModified = parseNoteTimestamp(item.lastModifiedAt);
-        if (lastModified.isValid())
-        {
-            return lastModified.toMSecsSinceEpoch();
-        }
-
-        const QDateTime created = parseNoteTimestamp(item.createdAt);
-        if (created.isValid())
-        {
-            return created.toMSecsSinceEpoch();
-        }
-
-        return std::numeric_limits<qint64>::min();
-    }
+    using WhatSon::Hierarchy::NoteListItemSupport::ValidationIssue;
+    namespace NoteListItemSupport = WhatSon::Hierarchy::NoteListItemSupport;
 
     bool sameNoteListItem(const BookmarksNoteListItem& lhs, const BookmarksNoteListItem& rhs)
     {
@@ -175,69 +52,9 @@ namespace
         return true;
     }
 
-    QString normalizeImageSource(QString value)
-    {
-        value = value.trimmed();
-        if (value.isEmpty())
-        {
-            return {};
-        }
-
-        if (QFileInfo(value).isAbsolute())
-        {
-            return QUrl::fromLocalFile(QDir::cleanPath(value)).toString();
-        }
-
-        const QUrl url(value);
-        if (url.isValid() && !url.scheme().isEmpty())
-        {
-            if (url.isLocalFile())
-            {
-                return QUrl::fromLocalFile(QDir::cleanPath(url.toLocalFile())).toString();
-            }
-            return url.toString();
-        }
-
-        return value;
-    }
-
-    QString buildFallbackSearchableText(const BookmarksNoteListItem& item)
-    {
-        QStringList parts;
-        if (!item.id.trimmed().isEmpty())
-        {
-            parts.push_back(item.id.trimmed());
-        }
-        if (!item.primaryText.trimmed().isEmpty())
-        {
-            parts.push_back(item.primaryText.trimmed());
-        }
-        if (!item.bodyText.trimmed().isEmpty())
-        {
-            parts.push_back(item.bodyText.trimmed());
-        }
-        for (const QString& folder : item.folders)
-        {
-            const QString trimmed = folder.trimmed();
-            if (!trimmed.isEmpty())
-            {
-                parts.push_back(trimmed);
-            }
-        }
-        for (const QString& tag : item.tags)
-        {
-            const QString trimmed = tag.trimmed();
-            if (!trimmed.isEmpty())
-            {
-                parts.push_back(trimmed);
-            }
-        }
-        return parts.join(QLatin1Char('\n'));
-    }
-
     QStringList searchTerms(const QString& searchText)
     {
-        const QString normalized = normalizeSearchableText(searchText);
+        const QString normalized = NoteListItemSupport::normalizeSearchableText(searchText);
         if (normalized.isEmpty())
         {
             return {};
@@ -253,7 +70,8 @@ namespace
         }
 
         const QString searchableText = item.searchableText.isEmpty()
-                                           ? normalizeSearchableText(buildFallbackSearchableText(item))
+                                           ? NoteListItemSupport::normalizeSearchableText(
+                                               NoteListItemSupport::buildFallbackSearchableText(item, true))
                                            : item.searchableText;
         for (const QString& term : terms)
         {
@@ -266,22 +84,6 @@ namespace
         return true;
     }
 
-    QStringList sanitizeMetadataList(QStringList values)
-    {
-        QStringList sanitized;
-        sanitized.reserve(values.size());
-        for (QString value : values)
-        {
-            value = value.trimmed();
-            if (value.isEmpty() || sanitized.contains(value))
-            {
-                continue;
-            }
-            sanitized.push_back(std::move(value));
-        }
-        return sanitized;
-    }
-
     QString itemIdAt(const QVector<BookmarksNoteListItem>& items, int index)
     {
         if (index < 0 || index >= items.size())
@@ -357,8 +159,10 @@ QVariant BookmarksNoteListModel::data(const QModelIndex& index, int role) const
         return item.image;
     case ImageSourceRole:
         return item.imageSource;
+    case ThumbnailSourceRole:
+        return WhatSonThumbnailCache::thumbnailUrlForImageSource(item.imageSource);
     case DisplayDateRole:
-        return item.displayDate;
+        return displayDateFor(item);
     case FoldersRole:
         return item.folders;
     case TagsRole:
@@ -381,6 +185,7 @@ QHash<int, QByteArray> BookmarksNoteListModel::roleNames() const
         {BodyTextRole, "bodyText"},
         {ImageRole, "image"},
         {ImageSourceRole, "imageSource"},
+        {ThumbnailSourceRole, "thumbnailSource"},
         {DisplayDateRole, "displayDate"},
         {FoldersRole, "folders"},
         {TagsRole, "tags"},
@@ -474,11 +279,6 @@ void BookmarksNoteListModel::setStrictValidation(bool enabled)
     emit strictValidationChanged();
 }
 
-int BookmarksNoteListModel::correctionCount() const noexcept
-{
-    return m_correctionCount;
-}
-
 QString BookmarksNoteListModel::lastValidationCode() const
 {
     return m_lastValidationCode;
@@ -489,174 +289,129 @@ QString BookmarksNoteListModel::lastValidationMessage() const
     return m_lastValidationMessage;
 }
 
-void BookmarksNoteListModel::setItems(QVector<BookmarksNoteListItem> items)
+void BookmarksNoteListModel::setSystemCalendarStore(ISystemCalendarStore* store)
 {
-    QVector<BookmarksNoteListItem> sanitized;
-    sanitized.reserve(items.size());
+    if (m_systemCalendarStore == store)
+    {
+        return;
+    }
 
-    QVector<ValidationIssue> issues;
-    issues.reserve(items.size() * 7);
+    m_systemCalendarStore = store;
+    refreshDisplayDates();
+}
 
-    for (int index = 0; index < items.size(); ++index)
+ISystemCalendarStore* BookmarksNoteListModel::systemCalendarStore() const noexcept
+{
+    return m_systemCalendarStore;
+}
+
+void BookmarksNoteListModel::refreshDisplayDates()
+{
+    const int cachedCount = m_displayDates.size();
+    m_displayDates.clear();
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("bookmarks.notelist.model"),
+                              QStringLiteral("refreshDisplayDates"),
+                              QStringLiteral("rows=%1 droppedDates=%2").arg(m_items.size()).arg(cachedCount));
+    if (m_items.isEmpty())
     {
-        BookmarksNoteListItem item = std::move(items[index]);
-        const QString originalPrimaryText = item.primaryText;
-        const QString originalDisplayDate = item.displayDate;
-        const QStringList originalFolders = item.folders;
-        const QStringList originalTags = item.tags;
-        const QString originalColor = item.bookmarkColor;
-        const QString originalImageSource = item.imageSource;
-
-        item.id = item.id.trimmed();
-        item.primaryText = normalizePrimaryText(std::move(item.primaryText));
-        item.searchableText = normalizeSearchableText(std::move(item.searchableText));
-        item.bodyText = normalizeBodyText(std::move(item.bodyText));
-        item.createdAt = normalizeTimestamp(std::move(item.createdAt));
-        item.lastModifiedAt = normalizeTimestamp(std::move(item.lastModifiedAt));
-        item.imageSource = normalizeImageSource(std::move(item.imageSource));
-        item.displayDate = item.displayDate.trimmed();
-        item.bookmarkColor = item.bookmarkColor.trimmed();
-        item.folders = sanitizeMetadataList(std::move(item.folders));
-        item.tags = sanitizeMetadataList(std::move(item.tags));
-        if (item.searchableText.isEmpty())
-        {
-            item.searchableText = normalizeSearchableText(buildFallbackSearchableText(item));
-        }
+        return;
+    }
 
-        // Full note bodies are loaded lazily through the editor selection bridge.
-        // The bookmark list keeps only the searchable summary cache.
-        item.bodyText.clear();
+    emit dataChanged(index(0), index(static_cast<int>(m_items.size()) - 1), {DisplayDateRole});
+}
 
-        if (item.primaryText.isEmpty())
-        {
-            WhatSon::Debug::traceSelf(this,
-                                      QStringLiteral("bookmarks.notelist.model"),
-                                      QStringLiteral("setItems.emptyPrimaryTextKept"),
-                                      QStringLiteral("index=%1 originalPrimaryText=%2")
-                                      .arg(index)
-                                      .arg(originalPrimaryText));
-        }
+int BookmarksNoteListModel::cachedDisplayDateCount() const noexcept
+{
+    return m_displayDates.size();
+}
 
-        if (item.folders != originalFolders)
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.folders.sanitized");
-            issue.message = QStringLiteral("Folders list was sanitized.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalCount"), originalFolders.size()},
-                {QStringLiteral("sanitizedCount"), item.folders.size()}
-            };
-            issues.push_back(std::move(issue));
-        }
+BookmarksNoteListItem BookmarksNoteListModel::normalizedItem(BookmarksNoteListItem item)
+{
+    NoteListItemSupport::normalizeCommonFields(&item);
+    if (item.searchableText.isEmpty())
+    {
+        item.searchableText = NoteListItemSupport::normalizeSearchableText(
+            NoteListItemSupport::buildFallbackSearchableText(item, true));
+    }
 
-        if (item.tags != originalTags)
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.tags.sanitized");
-            issue.message = QStringLiteral("Tags list was sanitized.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalCount"), originalTags.size()},
-                {QStringLiteral("sanitizedCount"), item.tags.size()}
-            };
-            issues.push_back(std::move(issue));
-        }
+    // Full note bodies are loaded lazily through the editor selection bridge.
+    // The bookmark list keeps only the searchable summary cache.
+    item.bodyText.clear();
+    return item;
+}
 
-        if (item.displayDate != originalDisplayDate)
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.displayDate.trimmed");
-            issue.message = QStringLiteral("Display date was trimmed.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalDisplayDate"), originalDisplayDate},
-                {QStringLiteral("correctedDisplayDate"), item.displayDate}
-            };
-            issues.push_back(std::move(issue));
-        }
+void BookmarksNoteListModel::sortItemsForDisplay(QVector<BookmarksNoteListItem>* items)
+{
+    if (items == nullptr || items->size() < 2)
+    {
+        return;
+    }
 
-        if (item.image && item.imageSource != originalImageSource.trimmed())
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.imageSource.normalized");
-            issue.message = QStringLiteral("Image source was normalized.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalImageSource"), originalImageSource},
-                {QStringLiteral("normalizedImageSource"), item.imageSource}
-            };
-            issues.push_back(std::move(issue));
-        }
+    // Keys are parsed once per row, and rows that are already in order are left shared with the caller.
+    QVector<qint64> sortTimestamps;
+    sortTimestamps.reserve(items->size());
+    for (const BookmarksNoteListItem& item : std::as_const(*items))
+    {
+        sortTimestamps.push_back(NoteListItemSupport::sortTimestampFor(item.lastModifiedAt, item.createdAt));
+    }
+    if (std::is_sorted(sortTimestamps.cbegin(), sortTimestamps.cend(), std::greater<qint64>()))
+    {
+        return;
+    }
 
-        if (!item.image && !item.imageSource.isEmpty())
+    QVector<int> order(items->size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(
+        order.begin(),
+        order.end(),
+        [&sortTimestamps](const int lhs, const int rhs)
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.imageSource.cleared");
-            issue.message = QStringLiteral("Image source was cleared because image=false.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalImageSource"), originalImageSource},
-                {QStringLiteral("correctedImageSource"), QString()}
-            };
-            item.imageSource.clear();
-            issues.push_back(std::move(issue));
-        }
+            return sortTimestamps.at(lhs) > sortTimestamps.at(rhs);
+        });
 
-        const bool colorValid = isValidHexColor(item.bookmarkColor);
-        if (item.bookmarked && !colorValid)
+    QVector<BookmarksNoteListItem> sorted;
+    sorted.reserve(items->size());
+    for (const int index : std::as_const(order))
+    {
+        sorted.push_back(std::as_const(*items).at(index));
+    }
+    *items = std::move(sorted);
+}
+
+void BookmarksNoteListModel::setItems(QVector<BookmarksNoteListItem> items)
+{
+    if (m_strictValidation)
+    {
+        QVector<ValidationIssue> issues;
+        for (int index = 0; index < items.size() && issues.isEmpty(); ++index)
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.bookmarkColor.invalid");
-            issue.message = QStringLiteral("Bookmark color was invalid. Cleared.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalColor"), originalColor},
-                {QStringLiteral("correctedColor"), QString()}
-            };
-            item.bookmarkColor.clear();
-            issues.push_back(std::move(issue));
+            const BookmarksNoteListItem& item = items.at(index);
+            NoteListItemSupport::appendValidationIssues(item, normalizedItem(item), index, &issues);
         }
-        else if (!item.bookmarked && !item.bookmarkColor.isEmpty())
+        if (!issues.isEmpty())
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.bookmarkColor.cleared");
-            issue.message = QStringLiteral("Bookmark color was cleared because bookmarked=false.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalColor"), originalColor},
-                {QStringLiteral("correctedColor"), QString()}
-            };
-            item.bookmarkColor.clear();
-            issues.push_back(std::move(issue));
+            const ValidationIssue& first = issues.constFirst();
+            setValidationState(first.code, first.message);
+            emit validationIssueRaised(first.code, first.message, first.context);
+            throw std::runtime_error(first.message.toStdString());
         }
-
-        sanitized.push_back(std::move(item));
     }
 
-    std::stable_sort(
-        sanitized.begin(),
-        sanitized.end(),
-        [](const BookmarksNoteListItem& lhs, const BookmarksNoteListItem& rhs)
-        {
-            const qint64 lhsTimestamp = effectiveSortTimestamp(lhs);
-            const qint64 rhsTimestamp = effectiveSortTimestamp(rhs);
-            if (lhsTimestamp == rhsTimestamp)
-            {
-                return false;
-            }
-            return lhsTimestamp > rhsTimestamp;
-        });
-
-    if (m_strictValidation && !issues.isEmpty())
+    // Items arrive normalised from their producer; a refresh only checks their order and shares the payloads.
+#ifndef QT_NO_DEBUG
+    for (int index = 0; index < items.size(); ++index)
     {
-        const ValidationIssue& first = issues.constFirst();
-        setValidationState(first.code, first.message);
-        emit validationIssueRaised(first.code, first.message, first.context);
-        throw std::runtime_error(first.message.toStdString());
+        if (NoteListItemSupport::reportShapeViolation(
+                this, QStringLiteral("bookmarks.notelist.model"), items.at(index), index))
+        {
+            break;
+        }
     }
+#endif
+    sortItemsForDisplay(&items);
 
-    if (sameNoteListItems(m_sourceItems, sanitized))
+    if (sameNoteListItems(m_sourceItems, items))
     {
         return;
     }
@@ -664,21 +419,9 @@ void BookmarksNoteListModel::setItems(QVector<BookmarksNoteListItem> items)
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("bookmarks.notelist.model"),
                               QStringLiteral("setItems"),
-                              QStringLiteral("count=%1").arg(sanitized.size()));
-    m_sourceItems = std::move(sanitized);
+                              QStringLiteral("count=%1").arg(items.size()));
+    m_sourceItems = std::move(items);
     applySearchFilter();
-    if (!issues.isEmpty())
-    {
-        m_correctionCount += issues.size();
-        emit correctionCountChanged();
-        const ValidationIssue& last = issues.constLast();
-        setValidationState(last.code, last.message);
-        for (const ValidationIssue& issue : std::as_const(issues))
-        {
-            emit validationIssueRaised(issue.code, issue.message, issue.context);
-            emit itemCorrected(issue.code, issue.context);
-        }
-    }
 }
 
 const QVector<BookmarksNoteListItem>& BookmarksNoteListModel::items() const noexcept
@@ -742,6 +485,15 @@ void BookmarksNoteListModel::applySearchFilter()
     emit itemsChanged();
 }
 
+QString BookmarksNoteListModel::displayDateFor(const BookmarksNoteListItem& item) const
+{
+    if (!item.displayDate.isEmpty())
+    {
+        return item.displayDate;
+    }
+    return m_displayDates.displayDate(m_systemCalendarStore.data(), item.lastModifiedAt, item.createdAt);
+}
+
 void BookmarksNoteListModel::setValidationState(QString code, QString message)
 {
     code = code.trimmed();
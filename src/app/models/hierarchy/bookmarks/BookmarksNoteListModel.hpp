@@ -1,6 +1,9 @@
 #pragma once
 
+#include "app/models/hierarchy/WhatSonNoteListItemSupport.hpp"
+
 #include <QAbstractListModel>
+#include <QPointer>
 #include <QString>
 #include <QStringList>
 #include <QVariantMap>
@@ -32,7 +35,6 @@ class BookmarksNoteListModel final : public QAbstractListModel
     Q_PROPERTY(QString currentBodyText READ currentBodyText NOTIFY currentBodyTextChanged)
     Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
     Q_PROPERTY(bool strictValidation READ strictValidation WRITE setStrictValidation NOTIFY strictValidationChanged)
-    Q_PROPERTY(int correctionCount READ correctionCount NOTIFY correctionCountChanged)
     Q_PROPERTY(QString lastValidationCode READ lastValidationCode NOTIFY validationStateChanged)
     Q_PROPERTY(QString lastValidationMessage READ lastValidationMessage NOTIFY validationStateChanged)
 
@@ -45,6 +47,7 @@ public:
         BodyTextRole,
         ImageRole,
         ImageSourceRole,
+        ThumbnailSourceRole,
         DisplayDateRole,
         FoldersRole,
         TagsRole,
@@ -68,9 +71,22 @@ public:
     void setSearchText(const QString& text);
     bool strictValidation() const noexcept;
     void setStrictValidation(bool enabled);
-    int correctionCount() const noexcept;
     QString lastValidationCode() const;
     QString lastValidationMessage() const;
+    // Rows whose producer left displayDate empty are formatted through this store when a view reads them.
+    void setSystemCalendarStore(ISystemCalendarStore* store);
+    ISystemCalendarStore* systemCalendarStore() const noexcept;
+    // Drops the formatted display dates and re-announces DisplayDateRole for every row; views only re-read the rows
+    // they show. Call when the calendar store's locale changes instead of rebuilding the items.
+    void refreshDisplayDates();
+    int cachedDisplayDateCount() const noexcept;
+
+    // Ingest-time normalisation. Producers build items through this once; setItems() trusts them, checking
+    // exhaustively only under strictValidation and structurally in debug builds.
+    static BookmarksNoteListItem normalizedItem(BookmarksNoteListItem item);
+    // Newest first by lastModifiedAt, then createdAt; ties keep their order. Producers that cache rows presort them
+    // so refreshes find them in order.
+    static void sortItemsForDisplay(QVector<BookmarksNoteListItem>* items);
 
     void setItems(QVector<BookmarksNoteListItem> items);
     const QVector<BookmarksNoteListItem>& items() const noexcept;
@@ -97,21 +113,21 @@ public
     void currentBodyTextChanged();
     void searchTextChanged();
     void strictValidationChanged();
-    void correctionCountChanged();
     void validationStateChanged();
     void validationIssueRaised(const QString& code, const QString& message, const QVariantMap& context);
-    void itemCorrected(const QString& code, const QVariantMap& context);
     void modelHookRequested();
 
 private:
     void applySearchFilter();
     void setValidationState(QString code, QString message);
+    QString displayDateFor(const BookmarksNoteListItem& item) const;
 
     QVector<BookmarksNoteListItem> m_sourceItems;
     QVector<BookmarksNoteListItem> m_items;
+    QPointer<ISystemCalendarStore> m_systemCalendarStore;
+    WhatSon::Hierarchy::NoteListItemSupport::DisplayDateCache m_displayDates;
     QString m_searchText;
     bool m_strictValidation = false;
-    int m_correctionCount = 0;
     int m_currentIndex = -1;
     QString m_lastValidationCode;
     QString m_lastValidationMessage;
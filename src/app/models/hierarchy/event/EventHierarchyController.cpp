@@ -1,6 +1,7 @@
 #include "app/models/hierarchy/event/EventHierarchyController.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
 #include "app/models/hierarchy/event/WhatSonEventHierarchyParser.hpp"
 #include "app/models/hierarchy/event/WhatSonEventHierarchyStore.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyTreeItemSupport.hpp"
@@ -160,6 +161,7 @@ bool EventHierarchyController::renameItem(int index, const QString& displayName)
 
     if (!m_eventFilePath.trimmed().isEmpty())
     {
+        WhatSonHubMutationJournal::Scope journalScope(m_eventFilePath, QStringLiteral("Rename event"));
         QString writeError;
         if (!stagedStore.writeToFile(m_eventFilePath, &writeError))
         {
@@ -170,6 +172,7 @@ bool EventHierarchyController::renameItem(int index, const QString& displayName)
                                           m_eventFilePath, writeError));
             return false;
         }
+        journalScope.commit();
     }
 
     m_items = std::move(stagedItems);
@@ -271,7 +274,11 @@ void EventHierarchyController::setEventNames(QStringList eventNames)
         QStringLiteral("Event"),
         m_eventNames,
         QStringLiteral("Event"));
-    m_createdFolderSequence = WhatSon::Hierarchy::EventSupport::nextGeneratedFolderSequence(m_items);
+    m_createdFolderSequence = 1;
+    for (const EventHierarchyItem& item : std::as_const(m_items))
+    {
+        WhatSon::Hierarchy::EventSupport::observeGeneratedFolderSequence(&m_createdFolderSequence, item.label);
+    }
     syncModel();
     setSelectedIndex(-1);
     WhatSon::Debug::traceSelf(this,
@@ -428,7 +435,11 @@ void EventHierarchyController::applyRuntimeSnapshot(
         m_eventNames,
         QStringLiteral("Event"));
     WhatSon::Hierarchy::NamedStringSupport::restoreExpandedItemKeys(&m_items, kKeyPrefix, preservedExpandedKeys);
-    m_createdFolderSequence = WhatSon::Hierarchy::EventSupport::nextGeneratedFolderSequence(m_items);
+    m_createdFolderSequence = 1;
+    for (const EventHierarchyItem& item : std::as_const(m_items))
+    {
+        WhatSon::Hierarchy::EventSupport::observeGeneratedFolderSequence(&m_createdFolderSequence, item.label);
+    }
     syncModel();
     setSelectedIndex(WhatSon::Hierarchy::NamedStringSupport::selectedIndexForKey(
         m_items,
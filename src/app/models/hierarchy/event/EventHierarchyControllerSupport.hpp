@@ -11,7 +11,7 @@ namespace WhatSon::Hierarchy::EventSupport
     using WhatSon::Hierarchy::TreeItemSupport::applyChevronByDepth;
     using WhatSon::Hierarchy::TreeItemSupport::deleteHierarchySubtree;
     using WhatSon::Hierarchy::TreeItemSupport::isBucketHeaderItem;
-    using WhatSon::Hierarchy::TreeItemSupport::nextGeneratedFolderSequence;
+    using WhatSon::Hierarchy::TreeItemSupport::observeGeneratedFolderSequence;
     using WhatSon::Hierarchy::TreeItemSupport::renameHierarchyItem;
 
     inline QStringList sanitizeStringList(QStringList values)
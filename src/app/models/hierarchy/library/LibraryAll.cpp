@@ -1,10 +1,13 @@
 #include "app/models/hierarchy/library/LibraryAll.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+#include "app/models/hierarchy/WhatSonNoteListItemSupport.hpp"
 
 #include <QDir>
 #include <QFileInfo>
 
+#include <algorithm>
 #include <utility>
 
 namespace
@@ -18,9 +21,95 @@ namespace
         }
         return QDir::cleanPath(trimmed);
     }
+
+    bool hasDuplicateEntry(const QStringList& values)
+    {
+        for (int index = 1; index < values.size(); ++index)
+        {
+            if (values.lastIndexOf(values.at(index), index - 1) >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isSanitizedList(const QStringList& values)
+    {
+        return !WhatSon::Hierarchy::NoteListItemSupport::hasBlankOrPaddedEntry(values) && !hasDuplicateEntry(values);
+    }
+
+    bool isNormalizedNoteRecord(const LibraryNoteRecord& note)
+    {
+        using WhatSon::Hierarchy::NoteListItemSupport::isPadded;
+        return !isPadded(note.noteId)
+            && !isPadded(note.createdAt)
+            && !isPadded(note.lastModifiedAt)
+            && isSanitizedList(note.tags)
+            && isSanitizedList(note.bookmarkColors);
+    }
+
+    // Every note list and bucket reads these fields, so they are corrected once here rather than on each refresh.
+    // Folder labels stay paired with folderUuids and are left to the folder resolver.
+    void normalizeNoteRecord(LibraryNoteRecord* note)
+    {
+        using WhatSon::Hierarchy::NoteListItemSupport::sanitizeMetadataList;
+        note->noteId = note->noteId.trimmed();
+        note->createdAt = note->createdAt.trimmed();
+        note->lastModifiedAt = note->lastModifiedAt.trimmed();
+        note->tags = sanitizeMetadataList(std::move(note->tags));
+        note->bookmarkColors = sanitizeMetadataList(std::move(note->bookmarkColors));
+    }
+
+    using SymbolKind = WhatSonHubSymbolTable::Kind;
+
+    constexpr std::array<SymbolKind, 3> kFacetKinds{SymbolKind::Tag, SymbolKind::Project, SymbolKind::FolderPath};
+
+    int facetSlot(const SymbolKind kind) noexcept
+    {
+        const auto it = std::find(kFacetKinds.cbegin(), kFacetKinds.cend(), kind);
+        return it == kFacetKinds.cend() ? -1 : static_cast<int>(it - kFacetKinds.cbegin());
+    }
+
+    QVector<int> facetValueSymbols(WhatSonHubSymbolTable& symbols, const SymbolKind kind, const LibraryNoteRecord& note)
+    {
+        const QStringList values = kind == SymbolKind::Tag
+                                       ? note.tags
+                                       : kind == SymbolKind::Project ? QStringList{note.project} : note.folders;
+        QVector<int> valueSymbols;
+        valueSymbols.reserve(values.size());
+        for (const QString& value : values)
+        {
+            const int valueSymbol = symbols.intern(kind, value);
+            if (valueSymbol != WhatSonHubSymbolTable::kNoSymbol && !valueSymbols.contains(valueSymbol))
+            {
+                valueSymbols.push_back(valueSymbol);
+            }
+        }
+        return valueSymbols;
+    }
+
+    void insertSorted(QVector<int>& posting, const int symbol)
+    {
+        const auto it = std::lower_bound(posting.begin(), posting.end(), symbol);
+        if (it == posting.end() || *it != symbol)
+        {
+            posting.insert(it, symbol);
+        }
+    }
+
+    void eraseSorted(QVector<int>& posting, const int symbol)
+    {
+        const auto it = std::lower_bound(posting.begin(), posting.end(), symbol);
+        if (it != posting.end() && *it == symbol)
+        {
+            posting.erase(it);
+        }
+    }
 } // namespace
 
 LibraryAll::LibraryAll()
+    : m_symbols(WhatSonHubSymbolTable::forHub(QString()))
 {
     WhatSon::Debug::traceSelf(this, QStringLiteral("library.all"), QStringLiteral("ctor"));
 }
@@ -94,6 +183,8 @@ bool LibraryAll::indexFromWshub(const QString& wshubPath, QString* errorMessage)
 
     m_sourceWshubPath = normalizedHubPath;
     m_notes.clear();
+    bindSymbols();
+    rebuildNoteRows();
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.all"),
@@ -105,7 +196,17 @@ bool LibraryAll::indexFromWshub(const QString& wshubPath, QString* errorMessage)
 void LibraryAll::setIndexedNotes(QString sourceWshubPath, QVector<LibraryNoteRecord> notes)
 {
     m_sourceWshubPath = normalizePath(sourceWshubPath);
+    // Checked through const access first: clean snapshots keep sharing their payload with the caller.
+    for (int row = 0; row < notes.size(); ++row)
+    {
+        if (!isNormalizedNoteRecord(std::as_const(notes).at(row)))
+        {
+            normalizeNoteRecord(&notes[row]);
+        }
+    }
     m_notes = std::move(notes);
+    bindSymbols();
+    rebuildNoteRows();
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.all"),
                               QStringLiteral("setIndexedNotes"),
@@ -114,33 +215,42 @@ void LibraryAll::setIndexedNotes(QString sourceWshubPath, QVector<LibraryNoteRec
 
 void LibraryAll::setSourceWshubPath(QString sourceWshubPath)
 {
-    m_sourceWshubPath = normalizePath(sourceWshubPath);
+    QString normalizedHubPath = normalizePath(sourceWshubPath);
+    if (normalizedHubPath == m_sourceWshubPath)
+    {
+        return;
+    }
+
+    // Symbols belong to the hub's table, so moving to another hub re-interns the rows into that one.
+    m_sourceWshubPath = std::move(normalizedHubPath);
+    bindSymbols();
+    rebuildNoteRows();
 }
 
 bool LibraryAll::upsertNote(const LibraryNoteRecord& note)
 {
-    const QString normalizedNoteId = note.noteId.trimmed();
+    LibraryNoteRecord normalizedNote = note;
+    if (!isNormalizedNoteRecord(normalizedNote))
+    {
+        normalizeNoteRecord(&normalizedNote);
+    }
+    const QString& normalizedNoteId = normalizedNote.noteId;
     if (normalizedNoteId.isEmpty())
     {
         return false;
     }
 
-    LibraryNoteRecord normalizedNote = note;
-    normalizedNote.noteId = normalizedNoteId;
-
-    for (int index = 0; index < m_notes.size(); ++index)
+    const int noteSymbol = m_symbols->internNormalized(WhatSonHubSymbolTable::Kind::NoteId, normalizedNoteId);
+    const int existingRow = rowForNoteSymbol(noteSymbol);
+    if (existingRow >= 0)
     {
-        if (m_notes.at(index).noteId.trimmed() != normalizedNoteId)
-        {
-            continue;
-        }
-
-        if (m_notes.at(index) == normalizedNote)
+        if (m_notes.at(existingRow) == normalizedNote)
         {
             return false;
         }
 
-        m_notes[index] = normalizedNote;
+        m_notes[existingRow] = normalizedNote;
+        updateNoteFacets(noteSymbol, &normalizedNote);
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("library.all"),
                                   QStringLiteral("upsertNote.update"),
@@ -148,7 +258,14 @@ bool LibraryAll::upsertNote(const LibraryNoteRecord& note)
         return true;
     }
 
+    if (noteSymbol >= m_rowByNoteSymbol.size())
+    {
+        m_rowByNoteSymbol.resize(noteSymbol + 1, -1);
+    }
+    m_rowByNoteSymbol[noteSymbol] = static_cast<int>(m_notes.size());
+    m_noteSymbolByRow.push_back(noteSymbol);
     m_notes.push_back(normalizedNote);
+    updateNoteFacets(noteSymbol, &normalizedNote);
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.all"),
                               QStringLiteral("upsertNote.insert"),
@@ -159,27 +276,35 @@ bool LibraryAll::upsertNote(const LibraryNoteRecord& note)
 bool LibraryAll::removeNoteById(const QString& noteId)
 {
     const QString normalizedNoteId = noteId.trimmed();
-    if (normalizedNoteId.isEmpty())
+    const int noteSymbol = m_symbols->findNormalized(WhatSonHubSymbolTable::Kind::NoteId, normalizedNoteId);
+    const int row = rowForNoteSymbol(noteSymbol);
+    if (row < 0)
     {
         return false;
     }
 
-    for (auto it = m_notes.begin(); it != m_notes.end(); ++it)
+    m_notes.remove(row);
+    m_noteSymbolByRow.remove(row);
+    m_rowByNoteSymbol[noteSymbol] = -1;
+    updateNoteFacets(noteSymbol, nullptr);
+    for (int shiftedRow = row; shiftedRow < m_noteSymbolByRow.size(); ++shiftedRow)
     {
-        if (it->noteId.trimmed() != normalizedNoteId)
+        const int shiftedSymbol = m_noteSymbolByRow.at(shiftedRow);
+        if (shiftedSymbol == WhatSonHubSymbolTable::kNoSymbol)
         {
             continue;
         }
-
-        m_notes.erase(it);
-        WhatSon::Debug::traceSelf(this,
-                                  QStringLiteral("library.all"),
-                                  QStringLiteral("removeNoteById"),
-                                  QStringLiteral("noteId=%1 count=%2").arg(normalizedNoteId).arg(m_notes.size()));
-        return true;
+        const int indexedRow = m_rowByNoteSymbol.at(shiftedSymbol);
+        if (indexedRow == shiftedRow + 1 || indexedRow < 0)
+        {
+            m_rowByNoteSymbol[shiftedSymbol] = shiftedRow;
+        }
     }
-
-    return false;
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("library.all"),
+                              QStringLiteral("removeNoteById"),
+                              QStringLiteral("noteId=%1 count=%2").arg(normalizedNoteId).arg(m_notes.size()));
+    return true;
 }
 
 bool LibraryAll::noteById(const QString& noteId, LibraryNoteRecord* outNote) const
@@ -189,24 +314,14 @@ bool LibraryAll::noteById(const QString& noteId, LibraryNoteRecord* outNote) con
         return false;
     }
 
-    const QString normalizedNoteId = noteId.trimmed();
-    if (normalizedNoteId.isEmpty())
+    const int row = rowForNoteSymbol(m_symbols->find(WhatSonHubSymbolTable::Kind::NoteId, noteId));
+    if (row < 0)
     {
         return false;
     }
 
-    for (const LibraryNoteRecord& note : m_notes)
-    {
-        if (note.noteId.trimmed() != normalizedNoteId)
-        {
-            continue;
-        }
-
-        *outNote = note;
-        return true;
-    }
-
-    return false;
+    *outNote = m_notes.at(row);
+    return true;
 }
 
 void LibraryAll::clear()
@@ -217,6 +332,10 @@ void LibraryAll::clear()
                               QStringLiteral("previousCount=%1").arg(m_notes.size()));
     m_sourceWshubPath.clear();
     m_notes.clear();
+    bindSymbols();
+    m_noteSymbolByRow.clear();
+    m_rowByNoteSymbol.clear();
+    m_facets = {};
 }
 
 QString LibraryAll::sourceWshubPath() const
@@ -228,3 +347,212 @@ const QVector<LibraryNoteRecord>& LibraryAll::notes() const noexcept
 {
     return m_notes;
 }
+
+const WhatSonHubSymbolTable& LibraryAll::symbols() const noexcept
+{
+    return *m_symbols;
+}
+
+std::shared_ptr<WhatSonHubSymbolTable> LibraryAll::sharedSymbols() const noexcept
+{
+    return m_symbols;
+}
+
+QVector<int> LibraryAll::noteRowsForFacet(const WhatSonHubSymbolTable::Kind kind, const QString& value) const
+{
+    const Facet* valueFacet = facet(kind);
+    const int valueSymbol = valueFacet == nullptr ? WhatSonHubSymbolTable::kNoSymbol : m_symbols->find(kind, value);
+    if (valueSymbol < 0 || valueSymbol >= valueFacet->noteSymbolsByValue.size())
+    {
+        return {};
+    }
+
+    const QVector<int>& noteSymbols = valueFacet->noteSymbolsByValue.at(valueSymbol);
+    QVector<int> rows;
+    rows.reserve(noteSymbols.size());
+    for (const int noteSymbol : noteSymbols)
+    {
+        const int row = rowForNoteSymbol(noteSymbol);
+        if (row >= 0)
+        {
+            rows.push_back(row);
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+int LibraryAll::noteCountForFacet(const WhatSonHubSymbolTable::Kind kind, const QString& value) const
+{
+    const Facet* valueFacet = facet(kind);
+    const int valueSymbol = valueFacet == nullptr ? WhatSonHubSymbolTable::kNoSymbol : m_symbols->find(kind, value);
+    if (valueSymbol < 0 || valueSymbol >= valueFacet->noteSymbolsByValue.size())
+    {
+        return 0;
+    }
+    return static_cast<int>(valueFacet->noteSymbolsByValue.at(valueSymbol).size());
+}
+
+const QVector<int>& LibraryAll::facetSymbolsForRow(const WhatSonHubSymbolTable::Kind kind, const int row) const
+{
+    static const QVector<int> noSymbols;
+    const Facet* valueFacet = facet(kind);
+    if (valueFacet == nullptr || row < 0 || row >= m_noteSymbolByRow.size())
+    {
+        return noSymbols;
+    }
+
+    const int noteSymbol = m_noteSymbolByRow.at(row);
+    if (rowForNoteSymbol(noteSymbol) != row || noteSymbol >= valueFacet->valueSymbolsByNote.size())
+    {
+        return noSymbols;
+    }
+    return valueFacet->valueSymbolsByNote.at(noteSymbol);
+}
+
+void LibraryAll::accountMemory(WhatSonMemoryEstimate& estimate) const
+{
+    estimate.addString(m_sourceWshubPath);
+    estimate.addNoteRecords(m_notes);
+
+    // Symbol bookkeeping is overhead of the note rows rather than items of its own. The table is shared by every
+    // index of the hub, so only the first owner sampled is charged for it.
+    estimate.addSharedBlock(m_symbols.get(), m_symbols->memoryFootprintBytes());
+    const auto addSymbolVector = [&estimate](const QVector<int>& symbols)
+    {
+        estimate.addInline(sizeof(symbols));
+        estimate.addVectorPayload(symbols, [](WhatSonMemoryEstimate&, const int&)
+        {
+        });
+    };
+    addSymbolVector(m_noteSymbolByRow);
+    addSymbolVector(m_rowByNoteSymbol);
+    for (const Facet& valueFacet : m_facets)
+    {
+        for (const QVector<QVector<int>>* postings : {&valueFacet.valueSymbolsByNote, &valueFacet.noteSymbolsByValue})
+        {
+            estimate.addInline(sizeof(*postings));
+            estimate.addVectorPayload(*postings, [](WhatSonMemoryEstimate& nested, const QVector<int>& posting)
+            {
+                nested.addVectorPayload(posting, [](WhatSonMemoryEstimate&, const int&)
+                {
+                });
+            });
+        }
+    }
+}
+
+void LibraryAll::bindSymbols()
+{
+    m_symbols = WhatSonHubSymbolTable::forHub(m_sourceWshubPath);
+}
+
+void LibraryAll::rebuildNoteRows()
+{
+    m_noteSymbolByRow.clear();
+    m_rowByNoteSymbol.clear();
+    m_facets = {};
+    m_symbols->reserve(WhatSonHubSymbolTable::Kind::NoteId, static_cast<int>(m_notes.size()));
+    m_noteSymbolByRow.reserve(m_notes.size());
+    m_rowByNoteSymbol.reserve(m_notes.size());
+    for (int row = 0; row < m_notes.size(); ++row)
+    {
+        const int noteSymbol = m_symbols->intern(WhatSonHubSymbolTable::Kind::NoteId, m_notes.at(row).noteId);
+        m_noteSymbolByRow.push_back(noteSymbol);
+        if (noteSymbol == WhatSonHubSymbolTable::kNoSymbol)
+        {
+            continue;
+        }
+        if (noteSymbol >= m_rowByNoteSymbol.size())
+        {
+            m_rowByNoteSymbol.resize(noteSymbol + 1, -1);
+        }
+
+        // Duplicate ids keep resolving to their first row, matching the old front-to-back scan.
+        if (m_rowByNoteSymbol.at(noteSymbol) >= 0)
+        {
+            continue;
+        }
+        m_rowByNoteSymbol[noteSymbol] = row;
+
+        // Postings are appended here and sorted once below rather than kept sorted per insert.
+        for (int slot = 0; slot < kFacetCount; ++slot)
+        {
+            Facet& valueFacet = m_facets[slot];
+            QVector<int> valueSymbols = facetValueSymbols(*m_symbols, kFacetKinds[slot], m_notes.at(row));
+            for (const int valueSymbol : std::as_const(valueSymbols))
+            {
+                if (valueSymbol >= valueFacet.noteSymbolsByValue.size())
+                {
+                    valueFacet.noteSymbolsByValue.resize(valueSymbol + 1);
+                }
+                valueFacet.noteSymbolsByValue[valueSymbol].push_back(noteSymbol);
+            }
+            if (noteSymbol >= valueFacet.valueSymbolsByNote.size())
+            {
+                valueFacet.valueSymbolsByNote.resize(noteSymbol + 1);
+            }
+            valueFacet.valueSymbolsByNote[noteSymbol] = std::move(valueSymbols);
+        }
+    }
+
+    for (Facet& valueFacet : m_facets)
+    {
+        for (QVector<int>& noteSymbols : valueFacet.noteSymbolsByValue)
+        {
+            std::sort(noteSymbols.begin(), noteSymbols.end());
+        }
+    }
+}
+
+void LibraryAll::updateNoteFacets(const int noteSymbol, const LibraryNoteRecord* note)
+{
+    for (int slot = 0; slot < kFacetCount; ++slot)
+    {
+        Facet& valueFacet = m_facets[slot];
+        QVector<int> nextValueSymbols = note == nullptr
+                                            ? QVector<int>()
+                                            : facetValueSymbols(*m_symbols, kFacetKinds[slot], *note);
+        if (noteSymbol >= valueFacet.valueSymbolsByNote.size())
+        {
+            valueFacet.valueSymbolsByNote.resize(noteSymbol + 1);
+        }
+        const QVector<int> previousValueSymbols = std::exchange(
+            valueFacet.valueSymbolsByNote[noteSymbol],
+            nextValueSymbols);
+        for (const int valueSymbol : previousValueSymbols)
+        {
+            if (!nextValueSymbols.contains(valueSymbol))
+            {
+                eraseSorted(valueFacet.noteSymbolsByValue[valueSymbol], noteSymbol);
+            }
+        }
+        for (const int valueSymbol : std::as_const(nextValueSymbols))
+        {
+            if (previousValueSymbols.contains(valueSymbol))
+            {
+                continue;
+            }
+            if (valueSymbol >= valueFacet.noteSymbolsByValue.size())
+            {
+                valueFacet.noteSymbolsByValue.resize(valueSymbol + 1);
+            }
+            insertSorted(valueFacet.noteSymbolsByValue[valueSymbol], noteSymbol);
+        }
+    }
+}
+
+int LibraryAll::rowForNoteSymbol(const int noteSymbol) const noexcept
+{
+    if (noteSymbol < 0 || noteSymbol >= m_rowByNoteSymbol.size())
+    {
+        return -1;
+    }
+    return m_rowByNoteSymbol.at(noteSymbol);
+}
+
+const LibraryAll::Facet* LibraryAll::facet(const WhatSonHubSymbolTable::Kind kind) const noexcept
+{
+    const int slot = facetSlot(kind);
+    return slot < 0 ? nullptr : &m_facets[slot];
+}
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
+#include "app/models/file/hub/WhatSonHubSymbolTable.hpp"
 #include "app/models/file/validator/WhatSonHubStructureValidator.hpp"
 
 #include <QString>
 #include <QVector>
 
+#include <array>
+#include <memory>
+
+class WhatSonMemoryEstimate;
+
 class LibraryAll final
 {
 public:
@@ -22,9 +28,41 @@ public:
 
     QString sourceWshubPath() const;
     const QVector<LibraryNoteRecord>& notes() const noexcept;
+    const WhatSonHubSymbolTable& symbols() const noexcept;
+    std::shared_ptr<WhatSonHubSymbolTable> sharedSymbols() const noexcept;
+
+    // Tag, project and folder-path facets. `kind` must be one of those three; values are normalized like the symbol
+    // table does, so project and folder matches ignore case. Rows come back in row order.
+    QVector<int> noteRowsForFacet(WhatSonHubSymbolTable::Kind kind, const QString& value) const;
+    int noteCountForFacet(WhatSonHubSymbolTable::Kind kind, const QString& value) const;
+    const QVector<int>& facetSymbolsForRow(WhatSonHubSymbolTable::Kind kind, int row) const;
+
+    void accountMemory(WhatSonMemoryEstimate& estimate) const;
 
 private:
+    // Facet values per note and notes per facet value, both indexed by symbol. Note postings stay sorted so a single
+    // upsert or removal only touches the postings of the values that note gained or lost.
+    struct Facet final
+    {
+        QVector<QVector<int>> valueSymbolsByNote;
+        QVector<QVector<int>> noteSymbolsByValue;
+    };
+
+    static constexpr int kFacetCount = 3;
+
+    void bindSymbols();
+    void rebuildNoteRows();
+    void updateNoteFacets(int noteSymbol, const LibraryNoteRecord* note);
+    int rowForNoteSymbol(int noteSymbol) const noexcept;
+    const Facet* facet(WhatSonHubSymbolTable::Kind kind) const noexcept;
+
     QString m_sourceWshubPath;
     QVector<LibraryNoteRecord> m_notes;
+    // Ids and facet values are interned into the hub's shared table; row <-> symbol maps keep id lookups O(1) and
+    // removals integer-only.
+    std::shared_ptr<WhatSonHubSymbolTable> m_symbols;
+    QVector<int> m_noteSymbolByRow;
+    QVector<int> m_rowByNoteSymbol;
+    std::array<Facet, kFacetCount> m_facets;
     WhatSonHubStructureValidator m_hubStructureValidator;
 };
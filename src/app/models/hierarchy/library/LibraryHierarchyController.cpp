@@ -3,6 +3,8 @@
 #include "app/models/calendar/ISystemCalendarStore.hpp"
 #include "app/policy/ArchitecturePolicyLock.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
 #include "app/models/hierarchy/WhatSonFolderIdentity.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyNoteRecordSupport.hpp"
 #include "app/models/hierarchy/folders/WhatSonFoldersHierarchyParser.hpp"
@@ -18,7 +20,6 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QHash>
-#include <QRegularExpression>
 #include <QDateTime>
 #include <QSet>
 #include <QVariantMap>
@@ -69,18 +70,7 @@ namespace
 
     void applyChevronByDepth(QVector<LibraryHierarchyItem>* items)
     {
-        if (items == nullptr)
-        {
-            return;
-        }
-
-        for (int index = 0; index < items->size(); ++index)
-        {
-            const int nextIndex = index + 1;
-            const bool hasChild = nextIndex < items->size()
-                && items->at(nextIndex).depth > items->at(index).depth;
-            (*items)[index].showChevron = hasChild;
-        }
+        WhatSon::Hierarchy::TreeItemSupport::applyChevronByDepth(items);
     }
 
     bool isProtectedRootItem(const LibraryHierarchyItem& item)
@@ -459,20 +449,11 @@ namespace
         return true;
     }
 
-    int subtreeEndIndexExclusive(const QVector<LibraryHierarchyItem>& items, int startIndex)
-    {
-        if (startIndex < 0 || startIndex >= items.size())
-        {
-            return startIndex;
-        }
+    using LibraryHierarchyTree = WhatSon::Hierarchy::HierarchyTree<LibraryHierarchyItem>;
 
-        const int baseDepth = items.at(startIndex).depth;
-        int endIndex = startIndex + 1;
-        while (endIndex < items.size() && items.at(endIndex).depth > baseDepth)
-        {
-            ++endIndex;
-        }
-        return endIndex;
+    int subtreeEndIndexExclusive(const LibraryHierarchyTree& tree, int startIndex)
+    {
+        return tree.subtreeEndFlatIndex(startIndex);
     }
 
     bool indexInsideSubtree(int index, int subtreeStart, int subtreeEndExclusive)
@@ -503,6 +484,7 @@ namespace
 
     bool resolveFolderMoveOperation(
         const QVector<LibraryHierarchyItem>& items,
+        const LibraryHierarchyTree& tree,
         int firstEditableInsertIndex,
         int sourceIndex,
         int targetIndex,
@@ -514,7 +496,7 @@ namespace
             return false;
         }
 
-        const int sourceEndIndex = subtreeEndIndexExclusive(items, sourceIndex);
+        const int sourceEndIndex = subtreeEndIndexExclusive(tree, sourceIndex);
         const int sourceCount = sourceEndIndex - sourceIndex;
         if (sourceCount <= 0)
         {
@@ -551,7 +533,7 @@ namespace
             {
                 return false;
             }
-            rawInsertIndex = subtreeEndIndexExclusive(items, targetIndex);
+            rawInsertIndex = subtreeEndIndexExclusive(tree, targetIndex);
             newBaseDepth = items.at(targetIndex).depth;
             break;
         case FolderDropPlacement::Child:
@@ -563,7 +545,7 @@ namespace
             {
                 return false;
             }
-            rawInsertIndex = subtreeEndIndexExclusive(items, targetIndex);
+            rawInsertIndex = subtreeEndIndexExclusive(tree, targetIndex);
             newBaseDepth = items.at(targetIndex).depth + 1;
             break;
         }
@@ -596,31 +578,20 @@ namespace
         int sourceIndex,
         const FolderMoveOperation& operation)
     {
-        const int depthDelta = operation.newBaseDepth - items.at(sourceIndex).depth;
-
-        QVector<LibraryHierarchyItem> movedItems;
-        movedItems.reserve(operation.sourceCount);
-        for (int index = sourceIndex; index < operation.sourceEndIndex; ++index)
-        {
-            LibraryHierarchyItem item = items.at(index);
-            item.depth = std::max(0, item.depth + depthDelta);
-            movedItems.push_back(std::move(item));
-        }
-
         QVector<LibraryHierarchyItem> stagedItems = items;
-        stagedItems.remove(sourceIndex, operation.sourceCount);
-
-        for (int offset = 0; offset < movedItems.size(); ++offset)
-        {
-            stagedItems.insert(operation.normalizedInsertIndex + offset, std::move(movedItems[offset]));
-        }
-
+        WhatSon::Hierarchy::TreeItemSupport::moveHierarchySubtree(
+            &stagedItems,
+            sourceIndex,
+            operation.sourceCount,
+            operation.normalizedInsertIndex,
+            operation.newBaseDepth);
         finalizeFolderItems(&stagedItems, false);
         return stagedItems;
     }
 
     bool resolveFolderMoveOperationFromLvrsMoveEvent(
         const QVector<LibraryHierarchyItem>& items,
+        const LibraryHierarchyTree& tree,
         int firstEditableInsertIndex,
         int sourceIndex,
         int targetIndex,
@@ -632,28 +603,32 @@ namespace
             return false;
         }
 
-        const int sourceEndIndex = subtreeEndIndexExclusive(items, sourceIndex);
+        const int sourceEndIndex = subtreeEndIndexExclusive(tree, sourceIndex);
         const int sourceCount = sourceEndIndex - sourceIndex;
         if (sourceCount <= 0)
         {
             return false;
         }
 
-        QVector<LibraryHierarchyItem> remainingItems = items;
-        remainingItems.remove(sourceIndex, sourceCount);
+        // Reads the rows as they would be with the moved subtree taken out, without copying the vector.
+        const auto remainingItemAt = [&items, sourceIndex, sourceCount](int index) -> const LibraryHierarchyItem&
+        {
+            return items.at(index < sourceIndex ? index : index + sourceCount);
+        };
+        const int remainingCount = static_cast<int>(items.size()) - sourceCount;
 
-        const int maxInsertIndex = std::max(0, static_cast<int>(remainingItems.size()));
+        const int maxInsertIndex = std::max(0, remainingCount);
         int normalizedInsertIndex = std::clamp(targetIndex, 0, maxInsertIndex);
         normalizedInsertIndex = std::max(normalizedInsertIndex, firstEditableInsertIndex);
 
-        int minDepth = normalizedInsertIndex < remainingItems.size()
-            ? std::max(0, remainingItems.at(normalizedInsertIndex).depth)
+        int minDepth = normalizedInsertIndex < remainingCount
+            ? std::max(0, remainingItemAt(normalizedInsertIndex).depth)
             : 0;
         int maxDepth = normalizedInsertIndex > 0
-            ? std::max(0, remainingItems.at(normalizedInsertIndex - 1).depth + 1)
+            ? std::max(0, remainingItemAt(normalizedInsertIndex - 1).depth + 1)
             : 0;
         if (normalizedInsertIndex <= firstEditableInsertIndex
-            || (normalizedInsertIndex > 0 && isProtectedRootItem(remainingItems.at(normalizedInsertIndex - 1))))
+            || (normalizedInsertIndex > 0 && isProtectedRootItem(remainingItemAt(normalizedInsertIndex - 1))))
         {
             minDepth = 0;
             maxDepth = 0;
@@ -702,6 +677,7 @@ namespace
 
     QHash<QString, QString> movedFolderPathMapForUpdatedSubtree(
         const QVector<LibraryHierarchyItem>& originalItems,
+        const LibraryHierarchyTree& originalTree,
         int subtreeStartIndex,
         const QVector<LibraryHierarchyItem>& stagedItems)
     {
@@ -713,7 +689,7 @@ namespace
             return movedPathMap;
         }
 
-        const int subtreeEndIndex = subtreeEndIndexExclusive(originalItems, subtreeStartIndex);
+        const int subtreeEndIndex = subtreeEndIndexExclusive(originalTree, subtreeStartIndex);
         for (int index = subtreeStartIndex; index < subtreeEndIndex && index < stagedItems.size(); ++index)
         {
             const QString sourcePath = normalizeFolderPath(originalItems.at(index).folderPath);
@@ -819,6 +795,31 @@ LibraryHierarchyController::LibraryHierarchyController(QObject* parent)
 {
     WhatSon::Debug::traceSelf(this, QStringLiteral("library.controller"), QStringLiteral("ctor"));
     initializeHierarchyInterfaceSignalBridge();
+    WhatSonMemoryAccounting& memoryAccounting = WhatSonMemoryAccounting::shared();
+    memoryAccounting.track(
+        this,
+        QStringLiteral("library"),
+        QStringLiteral("all"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            m_indexedState.libraryAll().accountMemory(estimate);
+        });
+    memoryAccounting.track(
+        this,
+        QStringLiteral("library"),
+        QStringLiteral("draft"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addNoteRecords(m_indexedState.draftNotes());
+        });
+    memoryAccounting.track(
+        this,
+        QStringLiteral("library"),
+        QStringLiteral("today"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addNoteRecords(m_indexedState.todayNotes());
+        });
     QObject::connect(
         &m_itemModel,
         &WhatSonHierarchyModel::itemCountChanged,
@@ -880,7 +881,7 @@ void LibraryHierarchyController::setSystemCalendarStore(ISystemCalendarStore* st
         return;
     }
 
-    if (m_noteListProjection.systemCalendarStore() == store)
+    if (m_noteListModel.systemCalendarStore() == store)
     {
         return;
     }
@@ -890,30 +891,27 @@ void LibraryHierarchyController::setSystemCalendarStore(ISystemCalendarStore* st
         QObject::disconnect(m_systemCalendarStoreChangedConnection);
     }
 
-    m_noteListProjection.setSystemCalendarStore(store);
-    if (m_noteListProjection.systemCalendarStore())
+    m_noteListModel.setSystemCalendarStore(store);
+    if (m_noteListModel.systemCalendarStore())
     {
         m_systemCalendarStoreChangedConnection = QObject::connect(
-            m_noteListProjection.systemCalendarStore(),
+            m_noteListModel.systemCalendarStore(),
             &ISystemCalendarStore::systemInfoChanged,
             this,
             [this]()
             {
-                invalidateNoteListItemCache();
-                refreshNoteListForSelection();
+                m_noteListModel.refreshDisplayDates();
             });
     }
     else
     {
         m_systemCalendarStoreChangedConnection = {};
     }
-
-    refreshNoteListForSelection();
 }
 
 ISystemCalendarStore* LibraryHierarchyController::systemCalendarStore() const noexcept
 {
-    return m_noteListProjection.systemCalendarStore();
+    return m_noteListModel.systemCalendarStore();
 }
 
 int LibraryHierarchyController::selectedIndex() const noexcept
@@ -931,6 +929,24 @@ int LibraryHierarchyController::noteItemCount() const noexcept
     return m_noteItemCount;
 }
 
+bool LibraryHierarchyController::recursiveFolderCounts() const noexcept
+{
+    return m_recursiveFolderCounts;
+}
+
+void LibraryHierarchyController::setRecursiveFolderCounts(bool enabled)
+{
+    if (m_recursiveFolderCounts == enabled)
+    {
+        return;
+    }
+
+    m_recursiveFolderCounts = enabled;
+    pushAllItemCounts();
+    emit recursiveFolderCountsChanged();
+    emit hierarchyModelChanged();
+}
+
 bool LibraryHierarchyController::loadSucceeded() const noexcept
 {
     return m_loadSucceeded;
@@ -1052,7 +1068,7 @@ void LibraryHierarchyController::setDepthItems(const QVariantList& depthItems)
     restoreExpandedHierarchyItemKeys(&m_items, preservedExpandedKeys);
     m_foldersHierarchyLoaded = m_runtimeIndexLoaded;
     rebuildBucketRanges();
-    m_createdFolderSequence = nextFolderSequence(m_items);
+    m_createdFolderSequence = 1;
     syncModel();
     setSelectedIndex(-1);
     if (m_runtimeIndexLoaded)
@@ -1188,7 +1204,7 @@ bool LibraryHierarchyController::loadFromWshub(const QString& wshubPath, QString
         dropReservedTodayFolderItems(&m_items);
         m_foldersHierarchyLoaded = true;
         rebuildBucketRanges();
-        m_createdFolderSequence = nextFolderSequence(m_items);
+        m_createdFolderSequence = 1;
         syncModel();
         setSelectedIndex(-1);
         refreshNoteListForSelection();
@@ -1261,6 +1277,7 @@ void LibraryHierarchyController::applyRuntimeSnapshot(
 
     if (!hierarchySourceChanged)
     {
+        pushAllItemCounts();
         refreshNoteListForSelectionAndNotifyHierarchyModel();
         updateLoadState(true);
         return;
@@ -1274,7 +1291,7 @@ void LibraryHierarchyController::applyRuntimeSnapshot(
         restoreExpandedHierarchyItemKeys(&m_items, preservedExpandedKeys);
         m_foldersHierarchyLoaded = true;
         rebuildBucketRanges();
-        m_createdFolderSequence = nextFolderSequence(m_items);
+        m_createdFolderSequence = 1;
         syncModel();
     }
     else
@@ -1297,43 +1314,11 @@ QVariantList LibraryHierarchyController::depthItems() const
     QVariantList serializedItems;
     serializedItems.reserve(m_items.size());
 
-    QHash<QString, int> folderNoteCountByFolderUuid;
-    if (m_runtimeIndexLoaded && m_foldersHierarchyLoaded)
-    {
-        folderNoteCountByFolderUuid = m_noteListProjection.folderNoteCountByFolderUuid(
-            m_items,
-            m_indexedState.allNotes(),
-            m_foldersHierarchyLoaded);
-    }
-
-    const auto noteCountForItem = [this, &folderNoteCountByFolderUuid](const LibraryHierarchyItem& item) -> int
-    {
-        if (!m_runtimeIndexLoaded)
-        {
-            return 0;
-        }
-
-        switch (item.systemBucket)
-        {
-        case LibraryHierarchyItem::SystemBucket::All:
-            return m_indexedState.allNotes().size();
-        case LibraryHierarchyItem::SystemBucket::Draft:
-            return m_indexedState.draftNotes().size();
-        case LibraryHierarchyItem::SystemBucket::Today:
-            return m_indexedState.todayNotes().size();
-        case LibraryHierarchyItem::SystemBucket::None:
-            break;
-        }
-
-        const QString folderUuid = normalizeFolderUuid(item.folderUuid);
-        return folderUuid.isEmpty() ? 0 : folderNoteCountByFolderUuid.value(folderUuid, 0);
-    };
-
     for (int index = 0; index < m_items.size(); ++index)
     {
         const LibraryHierarchyItem& item = m_items.at(index);
         const bool movable = canMoveFolder(index);
-        const int noteCount = std::max(0, noteCountForItem(item));
+        const int noteCount = noteCountForIndex(index);
 
         serializedItems.push_back(QVariantMap{
             {"label", item.label},
@@ -1356,6 +1341,70 @@ QVariantList LibraryHierarchyController::depthItems() const
     return serializedItems;
 }
 
+int LibraryHierarchyController::noteCountForIndex(int index) const
+{
+    if (!m_runtimeIndexLoaded || index < 0 || index >= m_items.size())
+    {
+        return 0;
+    }
+
+    const LibraryHierarchyItem& item = m_items.at(index);
+    switch (item.systemBucket)
+    {
+    case LibraryHierarchyItem::SystemBucket::All:
+        return m_indexedState.allNotes().size();
+    case LibraryHierarchyItem::SystemBucket::Draft:
+        return m_indexedState.draftNotes().size();
+    case LibraryHierarchyItem::SystemBucket::Today:
+        return m_indexedState.todayNotes().size();
+    case LibraryHierarchyItem::SystemBucket::None:
+        break;
+    }
+
+    const QString folderUuid = normalizeFolderUuid(item.folderUuid);
+    if (!m_foldersHierarchyLoaded || folderUuid.isEmpty())
+    {
+        return 0;
+    }
+
+    m_noteListProjection.setSymbolTable(m_indexedState.libraryAll().sharedSymbols());
+    m_noteListProjection.ensureFolderNoteCounts(m_items, m_indexedState.allNotes(), m_foldersHierarchyLoaded);
+    return std::max(0, m_noteListProjection.folderNoteCount(folderUuid, m_recursiveFolderCounts));
+}
+
+void LibraryHierarchyController::pushItemCounts(const QVector<int>& folderRows)
+{
+    if (m_itemModel.rowCount() != m_items.size())
+    {
+        return;
+    }
+
+    for (int index = 0; index < m_items.size(); ++index)
+    {
+        if (m_items.at(index).systemBucket != LibraryHierarchyItem::SystemBucket::None)
+        {
+            m_itemModel.setItemCount(index, noteCountForIndex(index));
+        }
+    }
+    for (const int index : folderRows)
+    {
+        m_itemModel.setItemCount(index, noteCountForIndex(index));
+    }
+}
+
+void LibraryHierarchyController::pushAllItemCounts()
+{
+    if (m_itemModel.rowCount() != m_items.size())
+    {
+        return;
+    }
+
+    for (int index = 0; index < m_items.size(); ++index)
+    {
+        m_itemModel.setItemCount(index, noteCountForIndex(index));
+    }
+}
+
 QVariantList LibraryHierarchyController::hierarchyModel() const
 {
     return depthItems();
@@ -1440,7 +1489,9 @@ bool LibraryHierarchyController::renameItem(int index, const QString& displayNam
     QVector<LibraryHierarchyItem> stagedItems = m_items;
     stagedItems[index].label = trimmedName;
     finalizeFolderItems(&stagedItems, false);
-    const QHash<QString, QString> movedPathMap = movedFolderPathMapForUpdatedSubtree(m_items, index, stagedItems);
+    const QHash<QString, QString> movedPathMap =
+        movedFolderPathMapForUpdatedSubtree(m_items, m_hierarchyTree, index, stagedItems);
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Rename folder"));
     if (!commitFolderHierarchyUpdate(std::move(stagedItems), m_selectedIndex, movedPathMap))
     {
         WhatSon::Debug::traceSelf(this,
@@ -1449,6 +1500,7 @@ bool LibraryHierarchyController::renameItem(int index, const QString& displayNam
                                   QStringLiteral("index=%1 path=%2").arg(index).arg(m_foldersFilePath));
         return false;
     }
+    journalScope.commit();
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
                               QStringLiteral("renameItem"),
@@ -1512,14 +1564,8 @@ void LibraryHierarchyController::createFolder()
         }
         else
         {
-            const int selectedDepth = m_items.at(m_selectedIndex).depth;
-            folderDepth = selectedDepth + 1;
-
-            insertIndex = m_selectedIndex + 1;
-            while (insertIndex < m_items.size() && m_items.at(insertIndex).depth > selectedDepth)
-            {
-                ++insertIndex;
-            }
+            folderDepth = m_items.at(m_selectedIndex).depth + 1;
+            insertIndex = m_hierarchyTree.subtreeEndFlatIndex(m_selectedIndex);
         }
     }
 
@@ -1551,6 +1597,7 @@ void LibraryHierarchyController::createFolder()
 
     WhatSonFoldersHierarchyStore stagedStore;
     stagedStore.setFolderEntries(folderEntriesFromItems(stagedItems));
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Create folder"));
     if (!m_foldersFilePath.trimmed().isEmpty())
     {
         QString writeError;
@@ -1574,8 +1621,8 @@ void LibraryHierarchyController::createFolder()
                                   QStringLiteral("insertIndex=%1 error=%2").arg(insertIndex).arg(reloadError));
         m_items = std::move(stagedItems);
         m_foldersHierarchyLoaded = true;
-        m_createdFolderSequence = nextFolderSequence(m_items);
     }
+    journalScope.commit();
 
     int mirroredInsertIndex = selectedHierarchyIndexForKey(m_items, insertedSelectionKey);
     if (mirroredInsertIndex < 0 && !insertedSelectionFolderPath.isEmpty())
@@ -1625,18 +1672,12 @@ void LibraryHierarchyController::deleteSelectedFolder()
         return;
     }
 
-    const int baseDepth = m_items.at(startIndex).depth;
-
-    int removeCount = 1;
-    while (startIndex + removeCount < m_items.size()
-        && m_items.at(startIndex + removeCount).depth > baseDepth)
-    {
-        ++removeCount;
-    }
+    const int removeCount = m_hierarchyTree.subtreeEndFlatIndex(startIndex) - startIndex;
 
     QVector<LibraryHierarchyItem> stagedItems = m_items;
     stagedItems.remove(startIndex, removeCount);
     finalizeFolderItems(&stagedItems, false);
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Delete folder"));
     if (!commitFolderHierarchyUpdate(std::move(stagedItems), -1, {}, true))
     {
         WhatSon::Debug::traceSelf(this,
@@ -1645,6 +1686,7 @@ void LibraryHierarchyController::deleteSelectedFolder()
                                   QStringLiteral("startIndex=%1 path=%2").arg(startIndex).arg(m_foldersFilePath));
         return;
     }
+    journalScope.commit();
 
     emit hubFilesystemMutated();
     WhatSon::Debug::traceSelf(this,
@@ -1670,6 +1712,7 @@ bool LibraryHierarchyController::canAcceptFolderDropBefore(int sourceIndex, int
 {
     return resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         targetIndex,
@@ -1687,6 +1730,7 @@ bool LibraryHierarchyController::moveFolderBefore(int sourceIndex, int targetInd
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         targetIndex,
@@ -1706,10 +1750,12 @@ bool LibraryHierarchyController::moveFolderBefore(int sourceIndex, int targetInd
         sourceIndex,
         operation,
         stagedItems);
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Move folder"));
     if (!commitFolderHierarchyUpdate(std::move(stagedItems), operation.normalizedInsertIndex, movedPathMap))
     {
         return false;
     }
+    journalScope.commit();
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
@@ -1725,6 +1771,7 @@ bool LibraryHierarchyController::canAcceptFolderDrop(int sourceIndex, int target
 {
     return resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         targetIndex,
@@ -1745,6 +1792,7 @@ bool LibraryHierarchyController::moveFolder(int sourceIndex, int targetIndex, bo
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         targetIndex,
@@ -1767,10 +1815,12 @@ bool LibraryHierarchyController::moveFolder(int sourceIndex, int targetIndex, bo
         sourceIndex,
         operation,
         stagedItems);
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Move folder"));
     if (!commitFolderHierarchyUpdate(std::move(stagedItems), operation.normalizedInsertIndex, movedPathMap))
     {
         return false;
     }
+    journalScope.commit();
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
@@ -1786,6 +1836,7 @@ bool LibraryHierarchyController::canMoveFolderToRoot(int sourceIndex) const
 {
     return resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         -1,
@@ -1802,6 +1853,7 @@ bool LibraryHierarchyController::moveFolderToRoot(int sourceIndex)
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         -1,
@@ -1817,10 +1869,12 @@ bool LibraryHierarchyController::moveFolderToRoot(int sourceIndex)
         sourceIndex,
         operation,
         stagedItems);
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Move folder to root"));
     if (!commitFolderHierarchyUpdate(std::move(stagedItems), operation.normalizedInsertIndex, movedPathMap))
     {
         return false;
     }
+    journalScope.commit();
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
@@ -1974,7 +2028,12 @@ bool LibraryHierarchyController::applyHierarchyNodes(const QVariantList& hierarc
     {
         selectedIndex = selectedHierarchyIndexForKey(stagedItems, normalizedActiveKey);
     }
-    return commitFolderHierarchyUpdate(std::move(stagedItems), selectedIndex, movedFolderPathMap);
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Reorder folders"));
+    if (!commitFolderHierarchyUpdate(std::move(stagedItems), selectedIndex, movedFolderPathMap))
+    {
+        return false;
+    }
+    return journalScope.commit();
 }
 
 bool LibraryHierarchyController::applyHierarchyMove(
@@ -1994,6 +2053,7 @@ bool LibraryHierarchyController::applyHierarchyMove(
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperationFromLvrsMoveEvent(
         m_items,
+        m_hierarchyTree,
         firstEditableInsertIndex(),
         sourceIndex,
         targetIndex,
@@ -2021,10 +2081,12 @@ bool LibraryHierarchyController::applyHierarchyMove(
     {
         selectedIndex = operation.normalizedInsertIndex;
     }
+    WhatSonHubMutationJournal::Scope journalScope(m_foldersFilePath, QStringLiteral("Move folder"));
     if (!commitFolderHierarchyUpdate(std::move(stagedItems), selectedIndex, movedPathMap))
     {
         return false;
     }
+    journalScope.commit();
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
@@ -2220,15 +2282,7 @@ bool LibraryHierarchyController::activateNoteById(const QString& noteId)
 
     auto visibleNoteIndexForId = [this, &normalizedNoteId]() -> int
     {
-        const QVector<LibraryNoteListItem>& noteItems = m_noteListModel.items();
-        for (int index = 0; index < noteItems.size(); ++index)
-        {
-            if (noteItems.at(index).id.trimmed() == normalizedNoteId)
-            {
-                return index;
-            }
-        }
-        return -1;
+        return m_noteListModel.indexOfNoteId(normalizedNoteId);
     };
 
     int noteIndex = visibleNoteIndexForId();
@@ -2251,7 +2305,7 @@ bool LibraryHierarchyController::activateNoteById(const QString& noteId)
             QStringLiteral("noteId=%1 selectedIndex=%2 noteCount=%3")
                 .arg(normalizedNoteId)
                 .arg(m_selectedIndex)
-                .arg(m_noteListModel.items().size()));
+                .arg(m_noteListModel.itemCount()));
         return false;
     }
 
@@ -2360,40 +2414,16 @@ LibraryHierarchyItem LibraryHierarchyController::parseItem(const QVariant& entry
     return parsed;
 }
 
-int LibraryHierarchyController::nextFolderSequence(const QVector<LibraryHierarchyItem>& items)
-{
-    static const QRegularExpression folderPattern(QStringLiteral("^Folder(\\d+)$"));
-
-    int maxSequence = 0;
-    for (const LibraryHierarchyItem& item : items)
-    {
-        const QRegularExpressionMatch match = folderPattern.match(item.label);
-        if (!match.hasMatch())
-        {
-            continue;
-        }
-
-        bool converted = false;
-        const int value = match.captured(1).toInt(&converted);
-        if (converted)
-        {
-            maxSequence = std::max(maxSequence, value);
-        }
-    }
-
-    return maxSequence + 1;
-}
-
-QVector<LibraryNoteListItem> LibraryHierarchyController::buildNoteListItems(
+std::shared_ptr<const ILibraryNoteListRowSource> LibraryHierarchyController::buildNoteListRows(
     const QVector<LibraryNoteRecord>& notes) const
 {
-    return m_noteListProjection.buildNoteListItems(m_items, notes, m_foldersHierarchyLoaded);
+    return m_noteListProjection.buildNoteListRows(m_items, notes, m_foldersHierarchyLoaded);
 }
 
-QVector<LibraryNoteListItem> LibraryHierarchyController::buildFolderScopedNoteListItems(
+std::shared_ptr<const ILibraryNoteListRowSource> LibraryHierarchyController::buildFolderScopedNoteListRows(
     const FolderSelectionScope& scope) const
 {
-    return m_noteListProjection.buildFolderScopedNoteListItems(
+    return m_noteListProjection.buildFolderScopedNoteListRows(
         m_items,
         m_indexedState.allNotes(),
         scope.selectedFolderUuid);
@@ -2497,9 +2527,17 @@ bool LibraryHierarchyController::upsertIndexedNote(const LibraryNoteRecord& note
     }
 
     const bool changed = m_indexedState.upsertNote(note);
-    invalidateNoteListItemCacheForNoteId(normalizedNoteId);
     if (changed)
     {
+        QVector<int> changedFolderRows;
+        if (m_noteListProjection.upsertFolderNoteCountsForNote(note, &changedFolderRows))
+        {
+            pushItemCounts(changedFolderRows);
+        }
+        else
+        {
+            pushAllItemCounts();
+        }
         emit indexedNoteUpserted(normalizedNoteId);
     }
     return changed;
@@ -2514,7 +2552,18 @@ bool LibraryHierarchyController::removeIndexedNoteById(const QString& noteId)
     }
 
     const bool changed = m_indexedState.removeNoteById(normalizedNoteId);
-    invalidateNoteListItemCacheForNoteId(normalizedNoteId);
+    if (changed)
+    {
+        QVector<int> changedFolderRows;
+        if (m_noteListProjection.removeFolderNoteCountsForNote(normalizedNoteId, &changedFolderRows))
+        {
+            pushItemCounts(changedFolderRows);
+        }
+        else
+        {
+            pushAllItemCounts();
+        }
+    }
     return changed;
 }
 
@@ -2523,11 +2572,6 @@ void LibraryHierarchyController::invalidateNoteListItemCache() const
     m_noteListProjection.invalidate();
 }
 
-void LibraryHierarchyController::invalidateNoteListItemCacheForNoteId(const QString& noteId) const
-{
-    m_noteListProjection.invalidateForNoteId(noteId);
-}
-
 void LibraryHierarchyController::setIndexedStateNotes(QString sourceWshubPath, QVector<LibraryNoteRecord> notes)
 {
     m_indexedState.setIndexedNotes(std::move(sourceWshubPath), std::move(notes));
@@ -2613,7 +2657,6 @@ bool LibraryHierarchyController::commitFolderHierarchyUpdate(
                                   QStringLiteral("error=%1").arg(reloadError));
         m_items = std::move(stagedItems);
         m_foldersHierarchyLoaded = !stagedFolderEntries.isEmpty();
-        m_createdFolderSequence = nextFolderSequence(m_items);
     }
 
     int mirroredSelectedIndex = selectedHierarchyIndexForKey(m_items, stagedSelectionKey);
@@ -2703,7 +2746,6 @@ bool LibraryHierarchyController::reloadFolderHierarchyFromFoldersFile(
 
     m_items = std::move(mirroredItems);
     m_foldersHierarchyLoaded = !foldersStore.folderEntries().isEmpty();
-    m_createdFolderSequence = nextFolderSequence(m_items);
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
@@ -2767,16 +2809,14 @@ void LibraryHierarchyController::refreshNoteListForSelection()
 
     if (const IndexedBucketRange* range = bucketRangeForIndex(m_selectedIndex))
     {
-        const QVector<LibraryNoteListItem> listItems = buildNoteListItems(notesForBucket(range->bucket));
+        const auto listRows = buildNoteListRows(notesForBucket(range->bucket));
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("library.controller"),
                                   QStringLiteral("refreshNoteListModel.bucketRange"),
-                                  QStringLiteral("bucket=%1 count=%2 firstItemId=%3 firstItemDirectoryPath=%4")
+                                  QStringLiteral("bucket=%1 count=%2")
                                       .arg(static_cast<int>(range->bucket))
-                                      .arg(listItems.size())
-                                      .arg(listItems.isEmpty() ? QString() : listItems.constFirst().id)
-                                      .arg(listItems.isEmpty() ? QString() : listItems.constFirst().noteDirectoryPath));
-        m_noteListModel.setItems(listItems);
+                                      .arg(listRows->rowCount()));
+        m_noteListModel.setRowSource(listRows);
         updateNoteItemCount();
         if (shouldAutoActivateMostRecentNote())
             autoActivateMostRecentNote();
@@ -2787,15 +2827,12 @@ void LibraryHierarchyController::refreshNoteListForSelection()
     {
         if (m_selectedIndex < 0 || m_selectedIndex >= m_items.size())
         {
-            const QVector<LibraryNoteListItem> listItems = buildNoteListItems(m_indexedState.allNotes());
+            const auto listRows = buildNoteListRows(m_indexedState.allNotes());
             WhatSon::Debug::traceSelf(this,
                                       QStringLiteral("library.controller"),
                                       QStringLiteral("refreshNoteListModel.allNotes"),
-                                      QStringLiteral("count=%1 firstItemId=%2 firstItemDirectoryPath=%3")
-                                          .arg(listItems.size())
-                                          .arg(listItems.isEmpty() ? QString() : listItems.constFirst().id)
-                                          .arg(listItems.isEmpty() ? QString() : listItems.constFirst().noteDirectoryPath));
-            m_noteListModel.setItems(listItems);
+                                      QStringLiteral("count=%1").arg(listRows->rowCount()));
+            m_noteListModel.setRowSource(listRows);
             updateNoteItemCount();
             if (shouldAutoActivateMostRecentNote())
                 autoActivateMostRecentNote();
@@ -2803,16 +2840,14 @@ void LibraryHierarchyController::refreshNoteListForSelection()
         }
 
         const FolderSelectionScope scope = selectedFolderScope();
-        const QVector<LibraryNoteListItem> listItems = buildFolderScopedNoteListItems(scope);
+        const auto listRows = buildFolderScopedNoteListRows(scope);
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("library.controller"),
                                   QStringLiteral("refreshNoteListModel.folderScope"),
-                                  QStringLiteral("folderUuid=%1 count=%2 firstItemId=%3 firstItemDirectoryPath=%4")
+                                  QStringLiteral("folderUuid=%1 count=%2")
                                       .arg(scope.selectedFolderUuid)
-                                      .arg(listItems.size())
-                                      .arg(listItems.isEmpty() ? QString() : listItems.constFirst().id)
-                                      .arg(listItems.isEmpty() ? QString() : listItems.constFirst().noteDirectoryPath));
-        m_noteListModel.setItems(listItems);
+                                      .arg(listRows->rowCount()));
+        m_noteListModel.setRowSource(listRows);
         updateNoteItemCount();
         if (shouldAutoActivateMostRecentNote())
             autoActivateMostRecentNote();
@@ -2820,16 +2855,14 @@ void LibraryHierarchyController::refreshNoteListForSelection()
     }
 
     const IndexedBucket bucket = selectedBucket();
-    const QVector<LibraryNoteListItem> listItems = buildNoteListItems(notesForBucket(bucket));
+    const auto listRows = buildNoteListRows(notesForBucket(bucket));
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
                               QStringLiteral("refreshNoteListModel.bucket"),
-                              QStringLiteral("bucket=%1 count=%2 firstItemId=%3 firstItemDirectoryPath=%4")
+                              QStringLiteral("bucket=%1 count=%2")
                                   .arg(static_cast<int>(bucket))
-                                  .arg(listItems.size())
-                                  .arg(listItems.isEmpty() ? QString() : listItems.constFirst().id)
-                                  .arg(listItems.isEmpty() ? QString() : listItems.constFirst().noteDirectoryPath));
-    m_noteListModel.setItems(listItems);
+                                  .arg(listRows->rowCount()));
+    m_noteListModel.setRowSource(listRows);
     updateNoteItemCount();
     if (shouldAutoActivateMostRecentNote())
         autoActivateMostRecentNote();
@@ -2846,7 +2879,7 @@ void LibraryHierarchyController::applyInAppLibraryScaffold()
     m_items = prependInAppLibraryScaffold({});
     m_foldersHierarchyLoaded = false;
     rebuildBucketRanges();
-    m_createdFolderSequence = nextFolderSequence(m_items);
+    m_createdFolderSequence = 1;
     syncModel();
     refreshNoteListForSelection();
 }
@@ -2855,6 +2888,8 @@ void LibraryHierarchyController::syncModel()
 {
     invalidateNoteListItemCache();
     applyChevronByDepth(&m_items);
+    m_hierarchyTree.assign(m_items);
+    m_createdFolderSequence = std::max(m_createdFolderSequence, m_hierarchyTree.nextFolderSequence());
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.controller"),
                               QStringLiteral("syncModel"),
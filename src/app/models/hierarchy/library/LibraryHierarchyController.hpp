@@ -1,6 +1,7 @@
 #pragma once
 
 #include "app/models/hierarchy/WhatSonHierarchyModel.hpp"
+#include "app/models/hierarchy/WhatSonHierarchyTree.hpp"
 #include "app/models/hierarchy/library/LibraryHierarchyModel.hpp"
 #include "app/models/hierarchy/library/LibraryNoteListModel.hpp"
 #include "app/models/hierarchy/WhatSonFolderDepthEntry.hpp"
@@ -40,6 +41,8 @@ class LibraryHierarchyController final : public IHierarchyController,
     Q_PROPERTY(int selectedIndex READ selectedIndex WRITE setSelectedIndex NOTIFY selectedIndexChanged)
     Q_PROPERTY(int itemCount READ itemCount NOTIFY itemCountChanged)
     Q_PROPERTY(int noteItemCount READ noteItemCount NOTIFY noteItemCountChanged)
+    Q_PROPERTY(bool recursiveFolderCounts READ recursiveFolderCounts WRITE setRecursiveFolderCounts NOTIFY
+               recursiveFolderCountsChanged)
     Q_PROPERTY(bool loadSucceeded READ loadSucceeded NOTIFY loadStateChanged)
     Q_PROPERTY(QString lastLoadError READ lastLoadError NOTIFY loadStateChanged)
     Q_PROPERTY(bool renameEnabled READ renameEnabled CONSTANT)
@@ -57,6 +60,8 @@ public:
     Q_INVOKABLE void setSelectedIndex(int index) override;
     int itemCount() const noexcept override;
     int noteItemCount() const noexcept;
+    bool recursiveFolderCounts() const noexcept;
+    void setRecursiveFolderCounts(bool enabled);
     bool loadSucceeded() const noexcept override;
     QString lastLoadError() const override;
 
@@ -142,6 +147,7 @@ public
     void indexedNoteUpserted(const QString& noteId);
     void indexedNotesSnapshotChanged();
     void hubFilesystemMutated();
+    void recursiveFolderCountsChanged();
     void controllerHookRequested();
 
 private:
@@ -166,9 +172,8 @@ private:
 
     static int extractDepth(const QVariantMap& entryMap);
     static LibraryHierarchyItem parseItem(const QVariant& entry, int fallbackOrdinal);
-    static int nextFolderSequence(const QVector<LibraryHierarchyItem>& items);
-    QVector<LibraryNoteListItem> buildNoteListItems(const QVector<LibraryNoteRecord>& notes) const;
-    QVector<LibraryNoteListItem> buildFolderScopedNoteListItems(const FolderSelectionScope& scope) const;
+    std::shared_ptr<const ILibraryNoteListRowSource> buildNoteListRows(const QVector<LibraryNoteRecord>& notes) const;
+    std::shared_ptr<const ILibraryNoteListRowSource> buildFolderScopedNoteListRows(const FolderSelectionScope& scope) const;
     const QVector<LibraryNoteRecord>& notesForBucket(IndexedBucket bucket) const;
     const IndexedBucketRange* bucketRangeForIndex(int index) const noexcept;
     IndexedBucket selectedBucket() const;
@@ -179,7 +184,6 @@ private:
     bool upsertIndexedNote(const LibraryNoteRecord& note);
     bool removeIndexedNoteById(const QString& noteId);
     void invalidateNoteListItemCache() const;
-    void invalidateNoteListItemCacheForNoteId(const QString& noteId) const;
     void setIndexedStateNotes(QString sourceWshubPath, QVector<LibraryNoteRecord> notes);
     void applyIndexedStateSnapshot(
         QString wshubPath,
@@ -201,12 +205,16 @@ private:
     void refreshNoteListForSelectionAndNotifyHierarchyModel();
     void applyInAppLibraryScaffold();
     void updateItemCount();
+    int noteCountForIndex(int index) const;
+    void pushItemCounts(const QVector<int>& folderRows);
+    void pushAllItemCounts();
     void updateNoteItemCount();
     void updateLoadState(bool succeeded, QString errorMessage = QString());
     void syncModel();
     QString mostRecentIndexedNoteIdByHeader() const;
 
     QVector<LibraryHierarchyItem> m_items;
+    WhatSon::Hierarchy::HierarchyTree<LibraryHierarchyItem> m_hierarchyTree;
     WhatSonHierarchyModel m_itemModel;
     LibraryNoteListModel m_noteListModel;
     WhatSonLibraryIndexedState m_indexedState;
@@ -218,6 +226,7 @@ private:
     int m_createdFolderSequence = 1;
     int m_itemCount = 0;
     int m_noteItemCount = 0;
+    bool m_recursiveFolderCounts = false;
     bool m_startupAutoActivationPending = true;
     bool m_loadSucceeded = false;
     QString m_lastLoadError;
@@ -2,152 +2,20 @@
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/note/header/WhatSonBookmarkColorPalette.hpp"
+#include "app/models/file/viewer/WhatSonThumbnailCache.hpp"
+#include "app/models/hierarchy/WhatSonNoteListItemSupport.hpp"
 
-#include <QDir>
-#include <QDateTime>
 #include <QFileInfo>
-#include <QRegularExpression>
-#include <QUrl>
+
 #include <algorithm>
-#include <limits>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
 
 namespace
 {
-    constexpr int kMaxNoteListPrimaryTextLines = 5;
-    const QRegularExpression kSearchWhitespacePattern(QStringLiteral("\\s+"));
-
-    struct ValidationIssue final
-    {
-        QString code;
-        QString message;
-        QVariantMap context;
-    };
-
-    QString truncateToMaxLines(const QString& value, int maxLines)
-    {
-        if (maxLines <= 0)
-        {
-            return {};
-        }
-
-        const QStringList lines = value.split(QLatin1Char('\n'));
-        if (lines.size() <= maxLines)
-        {
-            return value;
-        }
-
-        QStringList truncated;
-        truncated.reserve(maxLines);
-        for (int i = 0; i < maxLines; ++i)
-        {
-            truncated.push_back(lines.at(i));
-        }
-        return truncated.join(QLatin1Char('\n'));
-    }
-
-    bool isValidHexColor(const QString& value)
-    {
-        static const QRegularExpression kHexColorPattern(QStringLiteral("^#(?:[0-9A-Fa-f]{6}|[0-9A-Fa-f]{8})$"));
-        return kHexColorPattern.match(value).hasMatch();
-    }
-
-    QString normalizePrimaryText(QString value)
-    {
-        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-        value = truncateToMaxLines(value, kMaxNoteListPrimaryTextLines);
-        return value.trimmed();
-    }
-
-    QString normalizeSearchableText(QString value)
-    {
-        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-        value = value.trimmed().toCaseFolded();
-        value.replace(kSearchWhitespacePattern, QStringLiteral(" "));
-        return value.trimmed();
-    }
-
-    QString normalizeBodyText(QString value)
-    {
-        value.replace(QStringLiteral("\r\n"), QStringLiteral("\n"));
-        value.replace(QLatin1Char('\r'), QLatin1Char('\n'));
-        return value;
-    }
-
-    QString normalizeNoteDirectoryPath(QString value)
-    {
-        value = value.trimmed();
-        if (value.isEmpty())
-        {
-            return {};
-        }
-        return QDir::cleanPath(value);
-    }
-
-    QString normalizeTimestamp(QString value)
-    {
-        return value.trimmed();
-    }
-
-    QDateTime parseNoteTimestamp(const QString& value)
-    {
-        const QString trimmed = value.trimmed();
-        if (trimmed.isEmpty())
-        {
-            return {};
-        }
-
-        static const QStringList kFormats = {
-            QStringLiteral("yyyy-MM-dd-HH-mm-ss"),
-            QStringLiteral("yyyy-MM-dd-hh-mm-ss"),
-            QStringLiteral("yyyy-MM-ddTHH:mm:ss"),
-            QStringLiteral("yyyy-MM-ddTHH:mm:ssZ"),
-            QStringLiteral("yyyy-MM-dd")
-        };
-
-        for (const QString& format : kFormats)
-        {
-            const QDateTime parsed = QDateTime::fromString(trimmed, format);
-            if (parsed.isValid())
-            {
-                return parsed;
-            }
-        }
-
-        const QDateTime isoWithMs = QDateTime::fromString(trimmed, Qt::ISODateWithMs);
-        if (isoWithMs.isValid())
-        {
-            return isoWithMs;
-        }
-
-        const QDateTime iso = QDateTime::fromString(trimmed, Qt::ISODate);
-        if (iso.isValid())
-        {
-            return iso;
-        }
-
-        return {};
-    }
-
-    qint64 effectiveSortTimestamp(const LibraryNoteListItem& item)
-    {
-        const QDateTime lastModified = parseNoteTimestamp(item.lastModifiedAt);
-        if (lastModified.isValid())
-        {
-            return lastModified.toMSecsSinceEpoch();
-        }
-
-        const QDateTime created = parseNoteTimestamp(item.createdAt);
-        if (created.isValid())
-        {
-            return created.toMSecsSinceEpoch();
-        }
-
-        return std::numeric_limits<qint64>::min();
-    }
+    using WhatSon::Hierarchy::NoteListItemSupport::ValidationIssue;
+    namespace NoteListItemSupport = WhatSon::Hierarchy::NoteListItemSupport;
 
     bool sameNoteListItem(const LibraryNoteListItem& lhs, const LibraryNoteListItem& rhs)
     {
@@ -187,155 +55,103 @@ namespace
         return true;
     }
 
-    QString normalizeImageSource(QString value)
+    QStringList searchTerms(const QString& searchText)
     {
-        value = value.trimmed();
-        if (value.isEmpty())
+        const QString normalized = NoteListItemSupport::normalizeSearchableText(searchText);
+        if (normalized.isEmpty())
         {
             return {};
         }
-
-        if (QFileInfo(value).isAbsolute())
-        {
-            return QUrl::fromLocalFile(QDir::cleanPath(value)).toString();
-        }
-
-        const QUrl url(value);
-        if (url.isValid() && !url.scheme().isEmpty())
-        {
-            if (url.isLocalFile())
-            {
-                return QUrl::fromLocalFile(QDir::cleanPath(url.toLocalFile())).toString();
-            }
-            return url.toString();
-        }
-
-        return value;
+        return normalized.split(QLatin1Char(' '), Qt::SkipEmptyParts);
     }
 
-    QString buildFallbackSearchableText(const LibraryNoteListItem& item)
+    bool textMatchesSearch(const QString& searchableText, const QStringList& terms)
     {
-        QStringList parts;
-        if (!item.primaryText.trimmed().isEmpty())
-        {
-            parts.push_back(item.primaryText.trimmed());
-        }
-        if (!item.bodyText.trimmed().isEmpty())
-        {
-            parts.push_back(item.bodyText.trimmed());
-        }
-        for (const QString& folder : item.folders)
-        {
-            const QString trimmed = folder.trimmed();
-            if (!trimmed.isEmpty())
-            {
-                parts.push_back(trimmed);
-            }
-        }
-        for (const QString& tag : item.tags)
+        for (const QString& term : terms)
         {
-            const QString trimmed = tag.trimmed();
-            if (!trimmed.isEmpty())
+            if (!searchableText.contains(term))
             {
-                parts.push_back(trimmed);
+                return false;
             }
         }
-        return parts.join(QLatin1Char('\n'));
+
+        return true;
     }
 
-    QStringList searchTerms(const QString& searchText)
+    bool sameNoteOrder(
+        const ILibraryNoteListRowSource* lhsSource,
+        const QVector<int>& lhsRows,
+        const ILibraryNoteListRowSource* rhsSource,
+        const QVector<int>& rhsRows)
     {
-        const QString normalized = normalizeSearchableText(searchText);
-        if (normalized.isEmpty())
+        if (lhsRows.size() != rhsRows.size())
         {
-            return {};
+            return false;
         }
-        return normalized.split(QLatin1Char(' '), Qt::SkipEmptyParts);
-    }
-
-    bool itemMatchesSearch(const LibraryNoteListItem& item, const QStringList& terms)
-    {
-        if (terms.isEmpty())
+        if (lhsSource == rhsSource)
         {
-            return true;
+            return lhsRows == rhsRows;
         }
 
-        const QString searchableText = item.searchableText.isEmpty()
-                                           ? normalizeSearchableText(buildFallbackSearchableText(item))
-                                           : item.searchableText;
-        for (const QString& term : terms)
+        for (int index = 0; index < lhsRows.size(); ++index)
         {
-            if (!searchableText.contains(term))
+            if (lhsSource->noteId(lhsRows.at(index)) != rhsSource->noteId(rhsRows.at(index)))
             {
                 return false;
             }
         }
-
         return true;
     }
+}
 
-    QStringList sanitizeMetadataList(QStringList values)
+// Row source behind setItems(): the sanitized items themselves, with their sort keys parsed once.
+class LibraryNoteListModel::ItemRows final : public ILibraryNoteListRowSource
+{
+public:
+    explicit ItemRows(QVector<LibraryNoteListItem> items)
+        : m_items(std::move(items))
     {
-        QStringList sanitized;
-        sanitized.reserve(values.size());
-        for (QString value : values)
+        m_sortTimestamps.reserve(m_items.size());
+        for (const LibraryNoteListItem& item : std::as_const(m_items))
         {
-            value = value.trimmed();
-            if (value.isEmpty() || sanitized.contains(value))
-            {
-                continue;
-            }
-            sanitized.push_back(std::move(value));
+            m_sortTimestamps.push_back(sortTimestampFor(item.lastModifiedAt, item.createdAt));
         }
-        return sanitized;
     }
 
-    QString itemIdAt(const QVector<LibraryNoteListItem>& items, int index)
+    const QVector<LibraryNoteListItem>& items() const noexcept
     {
-        if (index < 0 || index >= items.size())
-        {
-            return {};
-        }
-        return items.at(index).id;
+        return m_items;
     }
 
-    QString itemBodyTextAt(const QVector<LibraryNoteListItem>& items, int index)
+    int rowCount() const override
     {
-        if (index < 0 || index >= items.size())
-        {
-            return {};
-        }
-        return items.at(index).bodyText;
+        return m_items.size();
     }
 
-    QString itemNoteDirectoryPathAt(const QVector<LibraryNoteListItem>& items, int index)
+    QString noteId(int row) const override
     {
-        if (index < 0 || index >= items.size())
-        {
-            return {};
-        }
-        return items.at(index).noteDirectoryPath;
+        return m_items.at(row).id;
     }
 
-    int indexOfItemById(const QVector<LibraryNoteListItem>& items, const QString& noteId)
+    qint64 sortTimestamp(int row) const override
     {
-        const QString normalizedNoteId = noteId.trimmed();
-        if (normalizedNoteId.isEmpty())
-        {
-            return -1;
-        }
+        return m_sortTimestamps.at(row);
+    }
 
-        for (int index = 0; index < items.size(); ++index)
-        {
-            if (items.at(index).id.trimmed() == normalizedNoteId)
-            {
-                return index;
-            }
-        }
+    QString searchableText(int row) const override
+    {
+        return m_items.at(row).searchableText;
+    }
 
-        return -1;
+    LibraryNoteListItem materialize(int row) const override
+    {
+        return m_items.at(row);
     }
-}
+
+private:
+    QVector<LibraryNoteListItem> m_items;
+    QVector<qint64> m_sortTimestamps;
+};
 
 LibraryNoteListModel::LibraryNoteListModel(QObject* parent)
     : QAbstractListModel(parent)
@@ -350,17 +166,17 @@ int LibraryNoteListModel::rowCount(const QModelIndex& parent) const
         return 0;
     }
 
-    return m_items.size();
+    return m_rows.size();
 }
 
 QVariant LibraryNoteListModel::data(const QModelIndex& index, int role) const
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_items.size())
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size())
     {
         return {};
     }
 
-    const LibraryNoteListItem& item = m_items.at(index.row());
+    const LibraryNoteListItem item = itemAt(index.row());
     if (index.row() == 0 && (role == IdRole || role == NoteIdRole || role == NoteDirectoryPathRole))
     {
         WhatSon::Debug::traceSelf(this,
@@ -388,8 +204,10 @@ QVariant LibraryNoteListModel::data(const QModelIndex& index, int role) const
         return item.image;
     case ImageSourceRole:
         return item.imageSource;
+    case ThumbnailSourceRole:
+        return WhatSonThumbnailCache::thumbnailUrlForImageSource(item.imageSource);
     case DisplayDateRole:
-        return item.displayDate;
+        return displayDateFor(item);
     case FoldersRole:
         return item.folders;
     case TagsRole:
@@ -413,6 +231,7 @@ QHash<int, QByteArray> LibraryNoteListModel::roleNames() const
         {BodyTextRole, "bodyText"},
         {ImageRole, "image"},
         {ImageSourceRole, "imageSource"},
+        {ThumbnailSourceRole, "thumbnailSource"},
         {DisplayDateRole, "displayDate"},
         {FoldersRole, "folders"},
         {TagsRole, "tags"},
@@ -423,7 +242,7 @@ QHash<int, QByteArray> LibraryNoteListModel::roleNames() const
 
 int LibraryNoteListModel::itemCount() const noexcept
 {
-    return m_items.size();
+    return m_rows.size();
 }
 
 int LibraryNoteListModel::currentIndex() const noexcept
@@ -433,10 +252,16 @@ int LibraryNoteListModel::currentIndex() const noexcept
 
 QString LibraryNoteListModel::currentNoteId() const
 {
-    QString noteId = itemIdAt(m_items, m_currentIndex).trimmed();
-    if (noteId.isEmpty() && m_currentIndex >= 0 && m_currentIndex < m_items.size())
+    if (m_currentIndex < 0 || m_currentIndex >= m_rows.size())
     {
-        const QString noteDirectoryPath = m_items.at(m_currentIndex).noteDirectoryPath.trimmed();
+        return {};
+    }
+
+    const LibraryNoteListItem item = itemAt(m_currentIndex);
+    QString noteId = item.id.trimmed();
+    if (noteId.isEmpty())
+    {
+        const QString noteDirectoryPath = item.noteDirectoryPath.trimmed();
         if (!noteDirectoryPath.isEmpty())
         {
             noteId = QFileInfo(noteDirectoryPath).completeBaseName().trimmed();
@@ -451,25 +276,14 @@ QString LibraryNoteListModel::currentNoteId() const
                                           .arg(noteId));
         }
     }
-    if (noteId.isEmpty() && m_currentIndex >= 0 && m_currentIndex < m_sourceItems.size())
-    {
-        noteId = m_sourceItems.at(m_currentIndex).id.trimmed();
-        WhatSon::Debug::traceSelf(this,
-                                  QStringLiteral("library.notelist.model"),
-                                  QStringLiteral("currentNoteId.sourceItemsFallback"),
-                                  QStringLiteral("currentIndex=%1 sourceItemId=%2")
-                                      .arg(m_currentIndex)
-                                      .arg(noteId));
-    }
-    if (m_currentIndex >= 0 && m_currentIndex < m_items.size() && noteId.trimmed().isEmpty())
+    if (noteId.trimmed().isEmpty())
     {
-        const LibraryNoteListItem& item = m_items.at(m_currentIndex);
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("library.notelist.model"),
                                   QStringLiteral("currentNoteId.emptyAtValidIndex"),
                                   QStringLiteral("currentIndex=%1 itemCount=%2 itemId=%3 noteDirectoryPath=%4 primaryText=%5 bodyText=%6")
                                       .arg(m_currentIndex)
-                                      .arg(m_items.size())
+                                      .arg(m_rows.size())
                                       .arg(item.id)
                                       .arg(item.noteDirectoryPath)
                                       .arg(WhatSon::Debug::summarizeText(item.primaryText, 48))
@@ -480,26 +294,21 @@ QString LibraryNoteListModel::currentNoteId() const
 
 QString LibraryNoteListModel::currentNoteDirectoryPath() const
 {
-    QString noteDirectoryPath = itemNoteDirectoryPathAt(m_items, m_currentIndex).trimmed();
-    if (noteDirectoryPath.isEmpty() && m_currentIndex >= 0 && m_currentIndex < m_sourceItems.size())
+    if (m_currentIndex < 0 || m_currentIndex >= m_rows.size())
     {
-        noteDirectoryPath = m_sourceItems.at(m_currentIndex).noteDirectoryPath.trimmed();
-        WhatSon::Debug::traceSelf(this,
-                                  QStringLiteral("library.notelist.model"),
-                                  QStringLiteral("currentNoteDirectoryPath.sourceItemsFallback"),
-                                  QStringLiteral("currentIndex=%1 sourceItemDirectoryPath=%2")
-                                      .arg(m_currentIndex)
-                                      .arg(noteDirectoryPath));
+        return {};
     }
-    if (m_currentIndex >= 0 && m_currentIndex < m_items.size() && noteDirectoryPath.trimmed().isEmpty())
+
+    const LibraryNoteListItem item = itemAt(m_currentIndex);
+    const QString noteDirectoryPath = item.noteDirectoryPath.trimmed();
+    if (noteDirectoryPath.isEmpty())
     {
-        const LibraryNoteListItem& item = m_items.at(m_currentIndex);
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("library.notelist.model"),
                                   QStringLiteral("currentNoteDirectoryPath.emptyAtValidIndex"),
                                   QStringLiteral("currentIndex=%1 itemCount=%2 itemId=%3 primaryText=%4")
                                       .arg(m_currentIndex)
-                                      .arg(m_items.size())
+                                      .arg(m_rows.size())
                                       .arg(item.id)
                                       .arg(WhatSon::Debug::summarizeText(item.primaryText, 48)));
     }
@@ -508,17 +317,17 @@ QString LibraryNoteListModel::currentNoteDirectoryPath() const
 
 QString LibraryNoteListModel::currentBodyText() const
 {
-    return itemBodyTextAt(m_items, m_currentIndex);
+    return itemAt(m_currentIndex).bodyText;
 }
 
 QVariantMap LibraryNoteListModel::currentNoteEntry() const
 {
-    if (m_currentIndex < 0 || m_currentIndex >= m_items.size())
+    if (m_currentIndex < 0 || m_currentIndex >= m_rows.size())
     {
         return {};
     }
 
-    const LibraryNoteListItem& item = m_items.at(m_currentIndex);
+    const LibraryNoteListItem item = itemAt(m_currentIndex);
     return {
         {QStringLiteral("id"), item.id},
         {QStringLiteral("noteId"), item.id},
@@ -527,7 +336,7 @@ QVariantMap LibraryNoteListModel::currentNoteEntry() const
         {QStringLiteral("bodyText"), item.bodyText},
         {QStringLiteral("createdAt"), item.createdAt},
         {QStringLiteral("lastModifiedAt"), item.lastModifiedAt},
-        {QStringLiteral("displayDate"), item.displayDate},
+        {QStringLiteral("displayDate"), displayDateFor(item)},
         {QStringLiteral("folders"), item.folders},
         {QStringLiteral("tags"), item.tags},
         {QStringLiteral("bookmarked"), item.bookmarked},
@@ -540,13 +349,13 @@ QVariantMap LibraryNoteListModel::currentNoteEntry() const
 void LibraryNoteListModel::setCurrentIndex(int index)
 {
     int nextIndex = index;
-    if (m_items.isEmpty())
+    if (m_rows.isEmpty())
     {
         nextIndex = -1;
     }
     else
     {
-        nextIndex = std::clamp(index, -1, static_cast<int>(m_items.size()) - 1);
+        nextIndex = std::clamp(index, -1, static_cast<int>(m_rows.size()) - 1);
     }
 
     if (m_currentIndex == nextIndex)
@@ -569,9 +378,9 @@ void LibraryNoteListModel::setCurrentIndex(int index)
                                   .arg(previousNoteId)
                                   .arg(previousNoteDirectoryPath)
                                   .arg(WhatSon::Debug::summarizeText(previousBodyText, 48))
-                                  .arg(itemIdAt(m_items, nextIndex))
-                                  .arg(itemNoteDirectoryPathAt(m_items, nextIndex))
-                                  .arg(WhatSon::Debug::summarizeText(itemBodyTextAt(m_items, nextIndex), 48)));
+                                  .arg(noteIdAt(nextIndex))
+                                  .arg(itemAt(nextIndex).noteDirectoryPath)
+                                  .arg(WhatSon::Debug::summarizeText(itemAt(nextIndex).bodyText, 48)));
 
     m_currentIndex = nextIndex;
     emit currentIndexChanged();
@@ -626,11 +435,6 @@ void LibraryNoteListModel::setStrictValidation(bool enabled)
     emit strictValidationChanged();
 }
 
-int LibraryNoteListModel::correctionCount() const noexcept
-{
-    return m_correctionCount;
-}
-
 QString LibraryNoteListModel::lastValidationCode() const
 {
     return m_lastValidationCode;
@@ -641,257 +445,293 @@ QString LibraryNoteListModel::lastValidationMessage() const
     return m_lastValidationMessage;
 }
 
-void LibraryNoteListModel::setItems(QVector<LibraryNoteListItem> items)
+void LibraryNoteListModel::setSystemCalendarStore(ISystemCalendarStore* store)
 {
-    QVector<LibraryNoteListItem> sanitized;
-    sanitized.reserve(items.size());
+    if (m_systemCalendarStore == store)
+    {
+        return;
+    }
 
-    QVector<ValidationIssue> issues;
-    issues.reserve(items.size() * 7);
+    m_systemCalendarStore = store;
+    refreshDisplayDates();
+}
 
-    for (int index = 0; index < items.size(); ++index)
-    {
-        LibraryNoteListItem item = std::move(items[index]);
-        const QString originalPrimaryText = item.primaryText;
-        const QString originalDisplayDate = item.displayDate;
-        const QStringList originalFolders = item.folders;
-        const QStringList originalTags = item.tags;
-        const QString originalColor = item.bookmarkColor;
-        const QString originalImageSource = item.imageSource;
-
-        item.id = item.id.trimmed();
-        item.noteDirectoryPath = normalizeNoteDirectoryPath(std::move(item.noteDirectoryPath));
-        item.primaryText = normalizePrimaryText(std::move(item.primaryText));
-        item.searchableText = normalizeSearchableText(std::move(item.searchableText));
-        item.bodyText = normalizeBodyText(std::move(item.bodyText));
-        item.createdAt = normalizeTimestamp(std::move(item.createdAt));
-        item.lastModifiedAt = normalizeTimestamp(std::move(item.lastModifiedAt));
-        item.imageSource = normalizeImageSource(std::move(item.imageSource));
-        item.displayDate = item.displayDate.trimmed();
-        item.bookmarkColor = item.bookmarkColor.trimmed();
-        item.folders = sanitizeMetadataList(std::move(item.folders));
-        item.tags = sanitizeMetadataList(std::move(item.tags));
-        if (item.searchableText.isEmpty())
-        {
-            item.searchableText = normalizeSearchableText(buildFallbackSearchableText(item));
-        }
+ISystemCalendarStore* LibraryNoteListModel::systemCalendarStore() const noexcept
+{
+    return m_systemCalendarStore;
+}
 
-        if (item.primaryText.isEmpty())
-        {
-            WhatSon::Debug::traceSelf(this,
-                                      QStringLiteral("library.notelist.model"),
-                                      QStringLiteral("setItems.emptyPrimaryTextKept"),
-                                      QStringLiteral("index=%1 originalPrimaryText=%2")
-                                      .arg(index)
-                                      .arg(originalPrimaryText));
-        }
+void LibraryNoteListModel::refreshDisplayDates()
+{
+    const int cachedCount = m_displayDates.size();
+    m_displayDates.clear();
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("library.notelist.model"),
+                              QStringLiteral("refreshDisplayDates"),
+                              QStringLiteral("rows=%1 droppedDates=%2").arg(m_rows.size()).arg(cachedCount));
+    if (m_rows.isEmpty())
+    {
+        return;
+    }
 
-        if (item.folders != originalFolders)
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.folders.sanitized");
-            issue.message = QStringLiteral("Folders list was sanitized.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalCount"), originalFolders.size()},
-                {QStringLiteral("sanitizedCount"), item.folders.size()}
-            };
-            issues.push_back(std::move(issue));
-        }
+    emit dataChanged(index(0), index(static_cast<int>(m_rows.size()) - 1), {DisplayDateRole});
+    if (m_currentIndex >= 0)
+    {
+        emit currentNoteEntryChanged();
+    }
+}
 
-        if (item.tags != originalTags)
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.tags.sanitized");
-            issue.message = QStringLiteral("Tags list was sanitized.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalCount"), originalTags.size()},
-                {QStringLiteral("sanitizedCount"), item.tags.size()}
-            };
-            issues.push_back(std::move(issue));
-        }
+int LibraryNoteListModel::cachedDisplayDateCount() const noexcept
+{
+    return m_displayDates.size();
+}
 
-        if (item.displayDate != originalDisplayDate)
-        {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.displayDate.trimmed");
-            issue.message = QStringLiteral("Display date was trimmed.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalDisplayDate"), originalDisplayDate},
-                {QStringLiteral("correctedDisplayDate"), item.displayDate}
-            };
-            issues.push_back(std::move(issue));
-        }
+LibraryNoteListItem LibraryNoteListModel::normalizedItem(LibraryNoteListItem item)
+{
+    item.noteDirectoryPath = NoteListItemSupport::normalizeNoteDirectoryPath(std::move(item.noteDirectoryPath));
+    NoteListItemSupport::normalizeCommonFields(&item);
+    if (item.searchableText.isEmpty())
+    {
+        item.searchableText = NoteListItemSupport::normalizeSearchableText(
+            NoteListItemSupport::buildFallbackSearchableText(item, false));
+    }
+    return item;
+}
 
-        if (item.image && item.imageSource != originalImageSource.trimmed())
+void LibraryNoteListModel::setItems(QVector<LibraryNoteListItem> items)
+{
+    if (m_strictValidation)
+    {
+        QVector<ValidationIssue> issues;
+        for (int index = 0; index < items.size() && issues.isEmpty(); ++index)
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.imageSource.normalized");
-            issue.message = QStringLiteral("Image source was normalized.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalImageSource"), originalImageSource},
-                {QStringLiteral("normalizedImageSource"), item.imageSource}
-            };
-            issues.push_back(std::move(issue));
+            const LibraryNoteListItem& item = items.at(index);
+            NoteListItemSupport::appendValidationIssues(item, normalizedItem(item), index, &issues);
+            if (item.noteDirectoryPath != NoteListItemSupport::normalizeNoteDirectoryPath(item.noteDirectoryPath))
+            {
+                issues.push_back(ValidationIssue{
+                    QStringLiteral("notelist.item.unnormalized"),
+                    QStringLiteral("Note directory path was not normalized."),
+                    QVariantMap{{QStringLiteral("index"), index}, {QStringLiteral("noteId"), item.id}}
+                });
+            }
         }
-
-        if (!item.image && !item.imageSource.isEmpty())
+        if (!issues.isEmpty())
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.imageSource.cleared");
-            issue.message = QStringLiteral("Image source was cleared because image=false.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalImageSource"), originalImageSource},
-                {QStringLiteral("correctedImageSource"), QString()}
-            };
-            item.imageSource.clear();
-            issues.push_back(std::move(issue));
+            const ValidationIssue& first = issues.constFirst();
+            setValidationState(first.code, first.message);
+            emit validationIssueRaised(first.code, first.message, first.context);
+            throw std::runtime_error(first.message.toStdString());
         }
+    }
 
-        const bool colorValid = isValidHexColor(item.bookmarkColor);
-        if (item.bookmarked && !colorValid)
+    // Items arrive normalised from their producer; a refresh only fills search text the producer left to us. Rows are
+    // read through const access so a caller's shared vector is only detached when one needs it.
+#ifndef QT_NO_DEBUG
+    for (int index = 0; index < items.size(); ++index)
+    {
+        if (NoteListItemSupport::reportShapeViolation(
+                this, QStringLiteral("library.notelist.model"), std::as_const(items).at(index), index))
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.bookmarkColor.invalid");
-            issue.message = QStringLiteral("Bookmark color was invalid. Cleared.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalColor"), originalColor},
-                {QStringLiteral("correctedColor"), QString()}
-            };
-            item.bookmarkColor.clear();
-            issues.push_back(std::move(issue));
+            break;
         }
-        else if (!item.bookmarked && !item.bookmarkColor.isEmpty())
+    }
+#endif
+    for (int index = 0; index < items.size(); ++index)
+    {
+        if (std::as_const(items).at(index).searchableText.isEmpty())
         {
-            ValidationIssue issue;
-            issue.code = QStringLiteral("notelist.bookmarkColor.cleared");
-            issue.message = QStringLiteral("Bookmark color was cleared because bookmarked=false.");
-            issue.context = QVariantMap{
-                {QStringLiteral("index"), index},
-                {QStringLiteral("originalColor"), originalColor},
-                {QStringLiteral("correctedColor"), QString()}
-            };
-            item.bookmarkColor.clear();
-            issues.push_back(std::move(issue));
+            LibraryNoteListItem& item = items[index];
+            item.searchableText = NoteListItemSupport::normalizeSearchableText(
+                NoteListItemSupport::buildFallbackSearchableText(item, false));
         }
+    }
 
-        sanitized.push_back(std::move(item));
+    if ((m_rowSource == nullptr && items.isEmpty())
+        || (m_itemRows != nullptr && sameNoteListItems(m_itemRows->items(), items)))
+    {
+        return;
     }
 
-    std::stable_sort(
-        sanitized.begin(),
-        sanitized.end(),
-        [](const LibraryNoteListItem& lhs, const LibraryNoteListItem& rhs)
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("library.notelist.model"),
+                              QStringLiteral("setItems"),
+                              QStringLiteral("count=%1 firstItemId=%2 firstItemDirectoryPath=%3 firstItemPrimaryText=%4")
+                                  .arg(items.size())
+                                  .arg(items.isEmpty() ? QString() : items.constFirst().id)
+                                  .arg(items.isEmpty() ? QString() : items.constFirst().noteDirectoryPath)
+                                  .arg(items.isEmpty() ? QString() : WhatSon::Debug::summarizeText(items.constFirst().primaryText, 48)));
+    auto itemRows = std::make_shared<const ItemRows>(std::move(items));
+    setRowSource(itemRows);
+    m_itemRows = std::move(itemRows);
+}
+
+void LibraryNoteListModel::setRowSource(std::shared_ptr<const ILibraryNoteListRowSource> source)
+{
+    const int sourceRowCount = source != nullptr ? source->rowCount() : 0;
+    QVector<int> sourceRows(sourceRowCount);
+    std::iota(sourceRows.begin(), sourceRows.end(), 0);
+    if (sourceRowCount > 1)
+    {
+        QVector<qint64> timestamps;
+        timestamps.reserve(sourceRowCount);
+        for (int row = 0; row < sourceRowCount; ++row)
         {
-            const qint64 lhsTimestamp = effectiveSortTimestamp(lhs);
-            const qint64 rhsTimestamp = effectiveSortTimestamp(rhs);
-            if (lhsTimestamp == rhsTimestamp)
+            timestamps.push_back(source->sortTimestamp(row));
+        }
+        std::stable_sort(
+            sourceRows.begin(),
+            sourceRows.end(),
+            [&timestamps](const int lhs, const int rhs)
             {
-                return false;
-            }
-            return lhsTimestamp > rhsTimestamp;
-        });
+                return timestamps.at(lhs) > timestamps.at(rhs);
+            });
+    }
 
-    if (m_strictValidation && !issues.isEmpty())
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("library.notelist.model"),
+                              QStringLiteral("setRowSource"),
+                              QStringLiteral("count=%1").arg(sourceRowCount));
+    m_itemRows.reset();
+    applyRows(std::move(source), std::move(sourceRows));
+}
+
+LibraryNoteListItem LibraryNoteListModel::itemAt(int row) const
+{
+    if (m_rowSource == nullptr || row < 0 || row >= m_rows.size())
     {
-        const ValidationIssue& first = issues.constFirst();
-        setValidationState(first.code, first.message);
-        emit validationIssueRaised(first.code, first.message, first.context);
-        throw std::runtime_error(first.message.toStdString());
+        return {};
     }
 
-    if (sameNoteListItems(m_sourceItems, sanitized))
+    const int sourceRow = m_rows.at(row);
+    if (const LibraryNoteListItem* cached = m_materializedRows.object(sourceRow))
     {
-        return;
+        return *cached;
     }
 
-    WhatSon::Debug::traceSelf(this,
-                              QStringLiteral("library.notelist.model"),
-                              QStringLiteral("setItems"),
-                              QStringLiteral("count=%1 firstItemId=%2 firstItemDirectoryPath=%3 firstItemPrimaryText=%4")
-                                  .arg(sanitized.size())
-                                  .arg(sanitized.isEmpty() ? QString() : sanitized.constFirst().id)
-                                  .arg(sanitized.isEmpty() ? QString() : sanitized.constFirst().noteDirectoryPath)
-                                  .arg(sanitized.isEmpty() ? QString() : WhatSon::Debug::summarizeText(sanitized.constFirst().primaryText, 48)));
-    m_sourceItems = std::move(sanitized);
-    applySearchFilter();
-    if (!issues.isEmpty())
+    LibraryNoteListItem item = m_rowSource->materialize(sourceRow);
+#ifndef QT_NO_DEBUG
+    NoteListItemSupport::reportShapeViolation(this, QStringLiteral("library.notelist.model"), item, row);
+#endif
+    ++m_materializedRowCount;
+    m_materializedRows.insert(sourceRow, new LibraryNoteListItem(item));
+    return item;
+}
+
+int LibraryNoteListModel::indexOfNoteId(const QString& noteId) const
+{
+    const QString normalizedNoteId = noteId.trimmed();
+    if (normalizedNoteId.isEmpty() || m_rowSource == nullptr)
+    {
+        return -1;
+    }
+
+    for (int index = 0; index < m_rows.size(); ++index)
     {
-        m_correctionCount += issues.size();
-        emit correctionCountChanged();
-        const ValidationIssue& last = issues.constLast();
-        setValidationState(last.code, last.message);
-        for (const ValidationIssue& issue : std::as_const(issues))
+        if (m_rowSource->noteId(m_rows.at(index)).trimmed() == normalizedNoteId)
         {
-            emit validationIssueRaised(issue.code, issue.message, issue.context);
-            emit itemCorrected(issue.code, issue.context);
+            return index;
         }
     }
+    return -1;
+}
+
+int LibraryNoteListModel::materializedRowCount() const noexcept
+{
+    return m_materializedRowCount;
+}
+
+QString LibraryNoteListModel::normalizedSearchText(QString text)
+{
+    return NoteListItemSupport::normalizeSearchableText(std::move(text));
 }
 
-const QVector<LibraryNoteListItem>& LibraryNoteListModel::items() const noexcept
+qint64 LibraryNoteListModel::sortTimestampFor(const QString& lastModifiedAt, const QString& createdAt)
 {
-    return m_items;
+    return NoteListItemSupport::sortTimestampFor(lastModifiedAt, createdAt);
 }
 
 void LibraryNoteListModel::applySearchFilter()
+{
+    applyRows(m_rowSource, m_sourceRows);
+}
+
+void LibraryNoteListModel::applyRows(
+    std::shared_ptr<const ILibraryNoteListRowSource> source,
+    QVector<int> sourceRows)
 {
     const QString previousNoteId = currentNoteId();
     const QString previousNoteDirectoryPath = currentNoteDirectoryPath();
     const QString previousBodyText = currentBodyText();
     const QVariantMap previousNoteEntry = currentNoteEntry();
     const int previousIndex = m_currentIndex;
-    const int previousCount = m_items.size();
+    const int previousCount = m_rows.size();
     const QStringList terms = searchTerms(m_searchText);
 
-    QVector<LibraryNoteListItem> filtered;
-    if (terms.isEmpty())
+    QVector<int> rows;
+    if (terms.isEmpty() || source == nullptr)
     {
-        filtered = m_sourceItems;
+        rows = sourceRows;
     }
     else
     {
-        filtered.reserve(m_sourceItems.size());
-        for (const LibraryNoteListItem& item : std::as_const(m_sourceItems))
+        rows.reserve(sourceRows.size());
+        for (const int sourceRow : std::as_const(sourceRows))
         {
-            if (itemMatchesSearch(item, terms))
+            if (textMatchesSearch(source->searchableText(sourceRow), terms))
             {
-                filtered.push_back(item);
+                rows.push_back(sourceRow);
             }
         }
     }
 
-    beginResetModel();
-    m_items = std::move(filtered);
-    endResetModel();
+    // Views keep their delegates when only row contents change; a refresh of the same notes in the same order is
+    // a dataChanged(), not a reset.
+    const bool sourceChanged = source != m_rowSource;
+    const bool orderKept = sameNoteOrder(m_rowSource.get(), m_rows, source.get(), rows);
+    if (!orderKept)
+    {
+        beginResetModel();
+    }
+    m_rowSource = std::move(source);
+    m_sourceRows = std::move(sourceRows);
+    m_rows = std::move(rows);
+    if (sourceChanged)
+    {
+        m_materializedRows.clear();
+        m_materializedRowCount = 0;
+    }
+    if (!orderKept)
+    {
+        endResetModel();
+    }
+    else if (sourceChanged && !m_rows.isEmpty())
+    {
+        emit dataChanged(index(0), index(static_cast<int>(m_rows.size()) - 1));
+    }
 
-    int nextCurrentIndex = indexOfItemById(m_items, previousNoteId);
-    if (nextCurrentIndex < 0 && previousIndex >= 0 && !m_items.isEmpty())
+    int nextCurrentIndex = indexOfNoteId(previousNoteId);
+    if (nextCurrentIndex < 0 && previousIndex >= 0 && !m_rows.isEmpty())
     {
-        nextCurrentIndex = std::clamp(previousIndex, 0, static_cast<int>(m_items.size()) - 1);
+        nextCurrentIndex = std::clamp(previousIndex, 0, static_cast<int>(m_rows.size()) - 1);
     }
-    if (nextCurrentIndex < 0 && !m_items.isEmpty())
+    if (nextCurrentIndex < 0 && !m_rows.isEmpty())
     {
         nextCurrentIndex = 0;
     }
-    const int nextCount = m_items.size();
+    const int nextCount = m_rows.size();
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("library.notelist.model"),
                               QStringLiteral("applySearchFilter"),
-                              QStringLiteral("searchText=%1 previousIndex=%2 previousCount=%3 nextCount=%4 previousNoteId=%5 nextCurrentIndex=%6 nextItemId=%7 nextItemDirectoryPath=%8")
+                              QStringLiteral("searchText=%1 previousIndex=%2 previousCount=%3 nextCount=%4 previousNoteId=%5 nextCurrentIndex=%6 nextItemId=%7 reset=%8")
                                   .arg(m_searchText)
                                   .arg(previousIndex)
                                   .arg(previousCount)
                                   .arg(nextCount)
                                   .arg(previousNoteId)
                                   .arg(nextCurrentIndex)
-                                  .arg(itemIdAt(m_items, nextCurrentIndex))
-                                  .arg(itemNoteDirectoryPathAt(m_items, nextCurrentIndex)));
+                                  .arg(noteIdAt(nextCurrentIndex))
+                                  .arg(!orderKept));
     m_currentIndex = nextCurrentIndex;
 
     if (nextCount != previousCount)
@@ -921,6 +761,24 @@ void LibraryNoteListModel::applySearchFilter()
     emit itemsChanged();
 }
 
+QString LibraryNoteListModel::noteIdAt(int row) const
+{
+    if (m_rowSource == nullptr || row < 0 || row >= m_rows.size())
+    {
+        return {};
+    }
+    return m_rowSource->noteId(m_rows.at(row));
+}
+
+QString LibraryNoteListModel::displayDateFor(const LibraryNoteListItem& item) const
+{
+    if (!item.displayDate.isEmpty())
+    {
+        return item.displayDate;
+    }
+    return m_displayDates.displayDate(m_systemCalendarStore.data(), item.lastModifiedAt, item.createdAt);
+}
+
 void LibraryNoteListModel::setValidationState(QString code, QString message)
 {
     code = code.trimmed();
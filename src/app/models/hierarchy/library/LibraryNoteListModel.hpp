@@ -1,11 +1,17 @@
 #pragma once
 
+#include "app/models/hierarchy/WhatSonNoteListItemSupport.hpp"
+
 #include <QAbstractListModel>
+#include <QCache>
+#include <QPointer>
 #include <QString>
 #include <QStringList>
 #include <QVariantMap>
 #include <QVector>
 
+#include <memory>
+
 struct LibraryNoteListItem
 {
     QString id;
@@ -24,6 +30,23 @@ struct LibraryNoteListItem
     QString bookmarkColor;
 };
 
+// A note list the model references by row. Rows index the source's own snapshot of the shared note index; the model
+// reads ids, sort keys and (while searching) search text for every row, and materialises full display items only for
+// the rows a view asks for.
+class ILibraryNoteListRowSource
+{
+public:
+    virtual ~ILibraryNoteListRowSource() = default;
+
+    virtual int rowCount() const = 0;
+    virtual QString noteId(int row) const = 0;
+    virtual qint64 sortTimestamp(int row) const = 0;
+    // Normalized with LibraryNoteListModel::normalizedSearchText().
+    virtual QString searchableText(int row) const = 0;
+    // Returned as LibraryNoteListModel::normalizedItem() would leave it; the model does not re-sanitise rows.
+    virtual LibraryNoteListItem materialize(int row) const = 0;
+};
+
 class LibraryNoteListModel final : public QAbstractListModel
 {
     Q_OBJECT
@@ -35,7 +58,6 @@ class LibraryNoteListModel final : public QAbstractListModel
     Q_PROPERTY(QVariantMap currentNoteEntry READ currentNoteEntry NOTIFY currentNoteEntryChanged)
     Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
     Q_PROPERTY(bool strictValidation READ strictValidation WRITE setStrictValidation NOTIFY strictValidationChanged)
-    Q_PROPERTY(int correctionCount READ correctionCount NOTIFY correctionCountChanged)
     Q_PROPERTY(QString lastValidationCode READ lastValidationCode NOTIFY validationStateChanged)
     Q_PROPERTY(QString lastValidationMessage READ lastValidationMessage NOTIFY validationStateChanged)
 
@@ -49,6 +71,7 @@ public:
         BodyTextRole,
         ImageRole,
         ImageSourceRole,
+        ThumbnailSourceRole,
         DisplayDateRole,
         FoldersRole,
         TagsRole,
@@ -74,12 +97,31 @@ public:
     void setSearchText(const QString& text);
     bool strictValidation() const noexcept;
     void setStrictValidation(bool enabled);
-    int correctionCount() const noexcept;
     QString lastValidationCode() const;
     QString lastValidationMessage() const;
+    // Rows whose producer left displayDate empty are formatted through this store when a view reads them.
+    void setSystemCalendarStore(ISystemCalendarStore* store);
+    ISystemCalendarStore* systemCalendarStore() const noexcept;
+    // Drops the formatted display dates and re-announces DisplayDateRole for every row; views only re-read the rows
+    // they show. Call when the calendar store's locale changes instead of rebuilding the items.
+    void refreshDisplayDates();
+    int cachedDisplayDateCount() const noexcept;
+
+    static constexpr int kMaterializedRowCacheSize = 256;
+
+    static QString normalizedSearchText(QString text);
+    static qint64 sortTimestampFor(const QString& lastModifiedAt, const QString& createdAt);
+    // Ingest-time normalisation. Producers build items through this once; setItems() and row sources are trusted,
+    // checked exhaustively only under strictValidation and structurally in debug builds.
+    static LibraryNoteListItem normalizedItem(LibraryNoteListItem item);
 
     void setItems(QVector<LibraryNoteListItem> items);
-    const QVector<LibraryNoteListItem>& items() const noexcept;
+    // Replaces the list with compact row references into `source`. Rows are ordered newest first; display items are
+    // materialised per requested row and the most recent kMaterializedRowCacheSize of them are kept.
+    void setRowSource(std::shared_ptr<const ILibraryNoteListRowSource> source);
+    LibraryNoteListItem itemAt(int row) const;
+    int indexOfNoteId(const QString& noteId) const;
+    int materializedRowCount() const noexcept;
 
 public
     slots  :
@@ -105,21 +147,29 @@ public
     void currentNoteEntryChanged();
     void searchTextChanged();
     void strictValidationChanged();
-    void correctionCountChanged();
     void validationStateChanged();
     void validationIssueRaised(const QString& code, const QString& message, const QVariantMap& context);
-    void itemCorrected(const QString& code, const QVariantMap& context);
     void modelHookRequested();
 
 private:
+    class ItemRows;
+
     void applySearchFilter();
+    void applyRows(std::shared_ptr<const ILibraryNoteListRowSource> source, QVector<int> sourceRows);
+    QString noteIdAt(int row) const;
     void setValidationState(QString code, QString message);
-
-    QVector<LibraryNoteListItem> m_sourceItems;
-    QVector<LibraryNoteListItem> m_items;
+    QString displayDateFor(const LibraryNoteListItem& item) const;
+
+    std::shared_ptr<const ILibraryNoteListRowSource> m_rowSource;
+    std::shared_ptr<const ItemRows> m_itemRows;
+    QVector<int> m_sourceRows;
+    QVector<int> m_rows;
+    mutable QCache<int, LibraryNoteListItem> m_materializedRows{kMaterializedRowCacheSize};
+    mutable int m_materializedRowCount = 0;
+    QPointer<ISystemCalendarStore> m_systemCalendarStore;
+    WhatSon::Hierarchy::NoteListItemSupport::DisplayDateCache m_displayDates;
     QString m_searchText;
     bool m_strictValidation = false;
-    int m_correctionCount = 0;
     int m_currentIndex = -1;
     QString m_lastValidationCode;
     QString m_lastValidationMessage;
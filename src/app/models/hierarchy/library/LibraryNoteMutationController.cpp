@@ -1,5 +1,6 @@
 #include "app/models/hierarchy/library/LibraryNoteMutationController.hpp"
 
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
 #include "app/policy/ArchitecturePolicyLock.hpp"
 
 #include <QStringList>
@@ -112,6 +113,7 @@ bool LibraryNoteMutationController::clearNoteFoldersById(const QString& noteId)
 bool LibraryNoteMutationController::clearNoteFoldersByIds(const QVariantList& noteIds)
 {
     const QStringList normalizedNoteIds = normalizedUniqueNoteIds(noteIds);
+    const WhatSonHubMutationJournal::BatchScope journalBatch(QStringLiteral("Clear note folders"));
     bool clearedAny = false;
     for (const QString& noteId : normalizedNoteIds)
     {
@@ -132,6 +134,7 @@ bool LibraryNoteMutationController::deleteNoteById(const QString& noteId)
 bool LibraryNoteMutationController::deleteNotesByIds(const QVariantList& noteIds)
 {
     const QStringList normalizedNoteIds = normalizedUniqueNoteIds(noteIds);
+    const WhatSonHubMutationJournal::BatchScope journalBatch(QStringLiteral("Delete notes"));
     bool deletedAny = false;
     for (const QString& noteId : normalizedNoteIds)
     {
@@ -17,6 +17,7 @@ struct LibraryNoteRecord
     QStringList bookmarkColors;
     QStringList tags;
     int progress = -1;
+    int openCount = 0;
     bool bookmarked = false;
     bool preset = false;
     QString noteDirectoryPath;
@@ -36,6 +37,7 @@ struct LibraryNoteRecord
             && bookmarkColors == other.bookmarkColors
             && tags == other.tags
             && progress == other.progress
+            && openCount == other.openCount
             && bookmarked == other.bookmarked
             && preset == other.preset
             && noteDirectoryPath == other.noteDirectoryPath
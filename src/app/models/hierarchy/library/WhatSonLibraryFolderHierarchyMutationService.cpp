@@ -1,5 +1,6 @@
 #include "app/models/hierarchy/library/WhatSonLibraryFolderHierarchyMutationService.hpp"
 
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
 #include "app/models/hierarchy/folders/WhatSonFoldersHierarchyStore.hpp"
 
 #include <utility>
@@ -18,6 +19,7 @@ bool WhatSonLibraryFolderHierarchyMutationService::commitMutation(
         WhatSonFoldersHierarchyStore stagedStore;
         stagedStore.setFolderEntries(request.stagedFolderEntries);
 
+        WhatSonHubMutationJournal::Scope journalScope(request.foldersFilePath, QStringLiteral("Edit folders"));
         QString writeError;
         if (!stagedStore.writeToFile(request.foldersFilePath, &writeError))
         {
@@ -27,6 +29,7 @@ bool WhatSonLibraryFolderHierarchyMutationService::commitMutation(
             }
             return false;
         }
+        journalScope.commit();
     }
 
     if (outResult != nullptr)
@@ -112,6 +112,11 @@ const QVector<LibraryNoteRecord>& WhatSonLibraryIndexedState::todayNotes() const
     return m_libraryToday.notes();
 }
 
+const LibraryAll& WhatSonLibraryIndexedState::libraryAll() const noexcept
+{
+    return m_libraryAll;
+}
+
 QVector<LibraryNoteRecord> WhatSonLibraryIndexedState::collectBookmarkedNotes(
     const QVector<LibraryNoteRecord>& allNotes)
 {
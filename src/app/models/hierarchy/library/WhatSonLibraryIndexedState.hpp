@@ -39,6 +39,7 @@ public:
     [[nodiscard]] const QVector<LibraryNoteRecord>& allNotes() const noexcept;
     [[nodiscard]] const QVector<LibraryNoteRecord>& draftNotes() const noexcept;
     [[nodiscard]] const QVector<LibraryNoteRecord>& todayNotes() const noexcept;
+    [[nodiscard]] const LibraryAll& libraryAll() const noexcept;
 
     static QVector<LibraryNoteRecord> collectBookmarkedNotes(const QVector<LibraryNoteRecord>& allNotes);
 
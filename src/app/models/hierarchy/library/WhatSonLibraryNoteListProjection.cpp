@@ -1,8 +1,7 @@
 #include "app/models/hierarchy/library/WhatSonLibraryNoteListProjection.hpp"
 
-#include "app/models/calendar/ISystemCalendarStore.hpp"
-#include "app/models/calendar/SystemCalendarStore.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/hub/WhatSonHubSymbolTable.hpp"
 #include "app/models/hierarchy/WhatSonFolderIdentity.hpp"
 #include "app/models/hierarchy/library/LibraryHierarchyControllerSupport.hpp"
 #include "app/models/hierarchy/library/LibraryNotePreviewText.hpp"
@@ -10,6 +9,7 @@
 #include "app/models/file/note/folder/WhatSonNoteFolderSemantics.hpp"
 
 #include <QFileInfo>
+#include <QPair>
 #include <QSet>
 
 #include <algorithm>
@@ -446,52 +446,255 @@ namespace
         return false;
     }
 
-    QString noteListItemCacheKey(const QString& noteId, const QString& noteDirectoryPath)
+    bool isListableNote(const LibraryNoteRecord& note)
     {
-        return noteId.trimmed()
-            + QLatin1Char('\n')
-            + WhatSon::Hierarchy::LibrarySupport::normalizePath(noteDirectoryPath);
+        return !note.noteId.trimmed().isEmpty()
+            || !WhatSon::Hierarchy::LibrarySupport::normalizePath(note.noteDirectoryPath).isEmpty();
+    }
+
+    QString noteIdFromDirectoryPath(const QString& noteDirectoryPath)
+    {
+        if (noteDirectoryPath.isEmpty())
+        {
+            return {};
+        }
+
+        const QFileInfo directoryInfo(noteDirectoryPath);
+        const QString noteId = directoryInfo.completeBaseName().trimmed();
+        return noteId.isEmpty() ? directoryInfo.fileName().trimmed() : noteId;
+    }
+
+    QString noteListItemId(const LibraryNoteRecord& note)
+    {
+        const QString noteId = note.noteId.trimmed();
+        if (!noteId.isEmpty())
+        {
+            return noteId;
+        }
+        return noteIdFromDirectoryPath(WhatSon::Hierarchy::LibrarySupport::normalizePath(note.noteDirectoryPath));
+    }
+
+    QVector<int> listedNoteRows(
+        const QVector<LibraryNoteRecord>& notes,
+        const FolderHierarchyLookup* scopeLookup,
+        const QString& selectedFolderUuid)
+    {
+        QVector<int> rows;
+        rows.reserve(notes.size());
+        for (int row = 0; row < notes.size(); ++row)
+        {
+            const LibraryNoteRecord& note = notes.at(row);
+            if (scopeLookup != nullptr && !noteMatchesFolderScope(note, selectedFolderUuid, *scopeLookup))
+            {
+                continue;
+            }
+            if (!isListableNote(note))
+            {
+                WhatSon::Debug::trace(
+                    QStringLiteral("library.noteListProjection"),
+                    QStringLiteral("listedNoteRows.skipInvalidNote"),
+                    QStringLiteral("row=%1 createdAt=%2 lastModifiedAt=%3")
+                        .arg(row)
+                        .arg(note.createdAt)
+                        .arg(note.lastModifiedAt));
+                continue;
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    // Rows over a snapshot of the note index. The notes vector shares its payload with the indexed state, so a
+    // refresh holds one row index per listed note; folder labels, search text and display fields are derived per
+    // row when the model asks for them.
+    class LibraryNoteListRows final : public ILibraryNoteListRowSource
+    {
+    public:
+        LibraryNoteListRows(
+            QVector<LibraryNoteRecord> notes,
+            QVector<int> noteRows,
+            std::shared_ptr<const FolderHierarchyLookup> lookup)
+            : m_notes(std::move(notes))
+            , m_noteRows(std::move(noteRows))
+            , m_lookup(std::move(lookup))
+        {
+        }
+
+        int rowCount() const override
+        {
+            return m_noteRows.size();
+        }
+
+        QString noteId(int row) const override
+        {
+            return noteListItemId(noteAt(row));
+        }
+
+        qint64 sortTimestamp(int row) const override
+        {
+            const LibraryNoteRecord& note = noteAt(row);
+            return LibraryNoteListModel::sortTimestampFor(note.lastModifiedAt, note.createdAt);
+        }
+
+        QString searchableText(int row) const override
+        {
+            if (m_searchableTexts.isEmpty())
+            {
+                m_searchableTexts.resize(m_noteRows.size());
+            }
+
+            QString& searchableText = m_searchableTexts[row];
+            if (searchableText.isNull())
+            {
+                const LibraryNoteRecord& note = noteAt(row);
+                searchableText = LibraryNoteListModel::normalizedSearchText(
+                    noteSearchableText(note, canonicalNoteFolderLabels(note, m_lookup.get())));
+            }
+            return searchableText;
+        }
+
+        LibraryNoteListItem materialize(int row) const override
+        {
+            const LibraryNoteRecord& note = noteAt(row);
+            const QString noteDirectoryPath =
+                WhatSon::Hierarchy::LibrarySupport::normalizePath(note.noteDirectoryPath);
+            QString noteId = note.noteId.trimmed();
+            if (noteId.isEmpty())
+            {
+                noteId = noteIdFromDirectoryPath(noteDirectoryPath);
+                if (!noteId.isEmpty())
+                {
+                    WhatSon::Debug::trace(
+                        QStringLiteral("library.noteListProjection"),
+                        QStringLiteral("materialize.derivedNoteIdFromDirectoryPath"),
+                        QStringLiteral("noteDirectoryPath=%1 derivedNoteId=%2")
+                            .arg(noteDirectoryPath)
+                            .arg(noteId));
+                }
+            }
+
+            LibraryNoteListItem item;
+            item.id = noteId;
+            item.noteDirectoryPath = noteDirectoryPath;
+            item.primaryText = WhatSon::LibraryPreview::notePrimaryText(note);
+            item.searchableText = searchableText(row);
+            item.createdAt = note.createdAt;
+            item.lastModifiedAt = note.lastModifiedAt;
+            item.image = false;
+            item.folders = canonicalNoteFolderLabels(note, m_lookup.get());
+            item.tags = noteListTags(note);
+            item.bookmarked = note.bookmarked;
+            item.bookmarkColor = bookmarkColorHexFromNote(note);
+            item = LibraryNoteListModel::normalizedItem(std::move(item));
+
+            WhatSon::Debug::trace(
+                QStringLiteral("library.noteListProjection"),
+                QStringLiteral("materialize"),
+                QStringLiteral("row=%1 noteId=%2 noteDirectoryPath=%3 primaryText=%4")
+                    .arg(row)
+                    .arg(item.id)
+                    .arg(item.noteDirectoryPath)
+                    .arg(WhatSon::Debug::summarizeText(item.primaryText, 48)));
+            return item;
+        }
+
+    private:
+        const LibraryNoteRecord& noteAt(int row) const
+        {
+            return m_notes.at(m_noteRows.at(row));
+        }
+
+        QVector<LibraryNoteRecord> m_notes;
+        QVector<int> m_noteRows;
+        std::shared_ptr<const FolderHierarchyLookup> m_lookup;
+        mutable QVector<QString> m_searchableTexts;
+    };
+
+    QVector<int> folderSymbolsWithAncestors(const QVector<int>& folderSymbols, const QVector<int>& parentByFolderSymbol)
+    {
+        QVector<int> result;
+        for (const int folderSymbol : folderSymbols)
+        {
+            int currentFolderSymbol = folderSymbol;
+            while (currentFolderSymbol != WhatSonHubSymbolTable::kNoSymbol && !result.contains(currentFolderSymbol))
+            {
+                result.push_back(currentFolderSymbol);
+                currentFolderSymbol = parentByFolderSymbol.at(currentFolderSymbol);
+            }
+        }
+        return result;
     }
 } // namespace
 
-void WhatSonLibraryNoteListProjection::setSystemCalendarStore(ISystemCalendarStore* store)
+// Folder and note ids are interned once into the hub's shared table; every per-folder vector below is indexed by the
+// folder symbol, so count updates hash and compare integers only. The table also holds symbols of other owners, so
+// folder slots are sparse and rowByFolderSymbol marks the ones this index owns.
+struct WhatSonLibraryNoteListProjection::FolderNoteCountIndex final
 {
-    if (m_systemCalendarStore == store)
+    bool usesFoldersHierarchy = false;
+    FolderHierarchyLookup lookup;
+    std::shared_ptr<WhatSonHubSymbolTable> symbols;
+    int folderCount = 0;
+    QVector<int> rowByFolderSymbol;
+    QVector<int> parentByFolderSymbol;
+    QVector<int> directCountByFolderSymbol;
+    QVector<int> subtreeCountByFolderSymbol;
+    QVector<QVector<int>> folderSymbolsByNoteSymbol;
+
+    bool hasFolder(const int folderSymbol) const noexcept
     {
-        return;
+        return folderSymbol >= 0
+            && folderSymbol < rowByFolderSymbol.size()
+            && rowByFolderSymbol.at(folderSymbol) >= 0;
     }
 
-    m_systemCalendarStore = store;
-    invalidate();
-}
+    void addFolder(const int folderSymbol, const int row, const int parentFolderSymbol)
+    {
+        if (folderSymbol >= rowByFolderSymbol.size())
+        {
+            rowByFolderSymbol.resize(folderSymbol + 1, -1);
+            parentByFolderSymbol.resize(folderSymbol + 1, WhatSonHubSymbolTable::kNoSymbol);
+            directCountByFolderSymbol.resize(folderSymbol + 1, 0);
+            subtreeCountByFolderSymbol.resize(folderSymbol + 1, 0);
+        }
+        rowByFolderSymbol[folderSymbol] = row;
+        parentByFolderSymbol[folderSymbol] = parentFolderSymbol;
+        ++folderCount;
+    }
 
-ISystemCalendarStore* WhatSonLibraryNoteListProjection::systemCalendarStore() const noexcept
-{
-    return m_systemCalendarStore;
-}
+    QVector<int> folderSymbols(const QStringList& folderUuids) const
+    {
+        QVector<int> result;
+        result.reserve(folderUuids.size());
+        for (const QString& folderUuid : folderUuids)
+        {
+            const int folderSymbol = symbols->findNormalized(WhatSonHubSymbolTable::Kind::FolderUuid, folderUuid);
+            if (hasFolder(folderSymbol))
+            {
+                result.push_back(folderSymbol);
+            }
+        }
+        return result;
+    }
+};
+
+WhatSonLibraryNoteListProjection::WhatSonLibraryNoteListProjection() = default;
+
+WhatSonLibraryNoteListProjection::~WhatSonLibraryNoteListProjection() = default;
 
 void WhatSonLibraryNoteListProjection::invalidate() const
 {
-    m_noteListItemCache.clear();
+    m_folderNoteCountIndex.reset();
 }
 
-void WhatSonLibraryNoteListProjection::invalidateForNoteId(const QString& noteId) const
+void WhatSonLibraryNoteListProjection::setSymbolTable(std::shared_ptr<WhatSonHubSymbolTable> symbols) const
 {
-    const QString normalizedNoteId = noteId.trimmed();
-    if (normalizedNoteId.isEmpty())
+    if (symbols == m_symbols)
     {
         return;
     }
-
-    for (auto iterator = m_noteListItemCache.begin(); iterator != m_noteListItemCache.end();)
-    {
-        if (iterator.value().id.trimmed() == normalizedNoteId)
-        {
-            iterator = m_noteListItemCache.erase(iterator);
-            continue;
-        }
-        ++iterator;
-    }
+    m_symbols = std::move(symbols);
+    invalidate();
 }
 
 QHash<QString, int> WhatSonLibraryNoteListProjection::folderNoteCountByFolderUuid(
@@ -533,146 +736,253 @@ QHash<QString, int> WhatSonLibraryNoteListProjection::folderNoteCountByFolderUui
     return countByFolderUuid;
 }
 
-QVector<LibraryNoteListItem> WhatSonLibraryNoteListProjection::buildNoteListItems(
+void WhatSonLibraryNoteListProjection::ensureFolderNoteCounts(
     const QVector<LibraryHierarchyItem>& hierarchyItems,
     const QVector<LibraryNoteRecord>& notes,
     bool foldersHierarchyLoaded) const
 {
-    if (!m_noteListItemCache.isEmpty() && m_noteListItemCacheUsesFoldersHierarchy != foldersHierarchyLoaded)
+    if (m_folderNoteCountIndex && m_folderNoteCountIndex->usesFoldersHierarchy == foldersHierarchyLoaded)
     {
-        m_noteListItemCache.clear();
+        return;
     }
-    m_noteListItemCacheUsesFoldersHierarchy = foldersHierarchyLoaded;
 
-    QVector<LibraryNoteListItem> items;
-    items.reserve(notes.size());
-    const FolderHierarchyLookup lookup = buildFolderHierarchyLookup(hierarchyItems);
-    const FolderHierarchyLookup* activeLookup = foldersHierarchyLoaded ? &lookup : nullptr;
-
-    for (const LibraryNoteRecord& note : notes)
+    auto index = std::make_unique<FolderNoteCountIndex>();
+    index->usesFoldersHierarchy = foldersHierarchyLoaded;
+    index->symbols = m_symbols ? m_symbols : WhatSonHubSymbolTable::forHub(QString());
+    if (foldersHierarchyLoaded)
     {
-        const LibraryNoteListItem item = buildNoteListItem(note, canonicalNoteFolderLabels(note, activeLookup));
-        if (item.id.trimmed().isEmpty() && item.noteDirectoryPath.trimmed().isEmpty())
+        index->lookup = buildFolderHierarchyLookup(hierarchyItems);
+        index->symbols->reserve(WhatSonHubSymbolTable::Kind::FolderUuid, static_cast<int>(hierarchyItems.size()));
+
+        // Parents follow the flattened depth order, so one stack of open ancestors is enough.
+        QVector<QPair<int, int>> openAncestors;
+        for (int row = 0; row < hierarchyItems.size(); ++row)
         {
-            WhatSon::Debug::trace(
-                QStringLiteral("library.noteListProjection"),
-                QStringLiteral("buildNoteListItems.skipInvalidNote"),
-                QStringLiteral("primaryText=%1 createdAt=%2 lastModifiedAt=%3")
-                    .arg(item.primaryText)
-                    .arg(item.createdAt)
-                    .arg(item.lastModifiedAt));
-            continue;
+            const LibraryHierarchyItem& item = hierarchyItems.at(row);
+            const QString folderUuid = normalizeFolderUuid(item.folderUuid);
+            if (isProtectedRootItem(item) || folderUuid.isEmpty())
+            {
+                continue;
+            }
+            const int folderSymbol = index->symbols->internNormalized(
+                WhatSonHubSymbolTable::Kind::FolderUuid,
+                folderUuid);
+            if (index->hasFolder(folderSymbol))
+            {
+                continue;
+            }
+
+            while (!openAncestors.isEmpty() && openAncestors.constLast().first >= item.depth)
+            {
+                openAncestors.removeLast();
+            }
+            index->addFolder(
+                folderSymbol,
+                row,
+                openAncestors.isEmpty() ? WhatSonHubSymbolTable::kNoSymbol : openAncestors.constLast().second);
+            openAncestors.push_back(qMakePair(item.depth, folderSymbol));
+        }
+
+        index->symbols->reserve(WhatSonHubSymbolTable::Kind::NoteId, static_cast<int>(notes.size()));
+        index->folderSymbolsByNoteSymbol.reserve(notes.size());
+        for (const LibraryNoteRecord& note : notes)
+        {
+            QVector<int> folderSymbols = index->folderSymbols(effectiveNoteFolderUuids(note, index->lookup));
+            for (const int folderSymbol : std::as_const(folderSymbols))
+            {
+                ++index->directCountByFolderSymbol[folderSymbol];
+            }
+            for (const int folderSymbol : folderSymbolsWithAncestors(folderSymbols, index->parentByFolderSymbol))
+            {
+                ++index->subtreeCountByFolderSymbol[folderSymbol];
+            }
+
+            const int noteSymbol = index->symbols->intern(WhatSonHubSymbolTable::Kind::NoteId, note.noteId);
+            if (noteSymbol == WhatSonHubSymbolTable::kNoSymbol)
+            {
+                continue;
+            }
+            if (noteSymbol >= index->folderSymbolsByNoteSymbol.size())
+            {
+                index->folderSymbolsByNoteSymbol.resize(noteSymbol + 1);
+            }
+            index->folderSymbolsByNoteSymbol[noteSymbol] = std::move(folderSymbols);
         }
-        items.push_back(item);
     }
 
-    return items;
+    WhatSon::Debug::trace(
+        QStringLiteral("library.noteListProjection"),
+        QStringLiteral("ensureFolderNoteCounts"),
+        QStringLiteral("folders=%1 notes=%2 foldersHierarchyLoaded=%3")
+            .arg(index->folderCount)
+            .arg(notes.size())
+            .arg(foldersHierarchyLoaded ? QStringLiteral("true") : QStringLiteral("false")));
+    m_folderNoteCountIndex = std::move(index);
 }
 
-QVector<LibraryNoteListItem> WhatSonLibraryNoteListProjection::buildFolderScopedNoteListItems(
-    const QVector<LibraryHierarchyItem>& hierarchyItems,
-    const QVector<LibraryNoteRecord>& notes,
-    const QString& selectedFolderUuid) const
+bool WhatSonLibraryNoteListProjection::hasFolderNoteCounts() const noexcept
+{
+    return m_folderNoteCountIndex != nullptr;
+}
+
+int WhatSonLibraryNoteListProjection::folderNoteCount(const QString& folderUuid, bool includeSubfolders) const
 {
-    const bool foldersHierarchyLoaded = true;
-    if (!m_noteListItemCache.isEmpty() && m_noteListItemCacheUsesFoldersHierarchy != foldersHierarchyLoaded)
+    if (!m_folderNoteCountIndex)
     {
-        m_noteListItemCache.clear();
+        return 0;
     }
-    m_noteListItemCacheUsesFoldersHierarchy = foldersHierarchyLoaded;
 
-    const FolderHierarchyLookup lookup = buildFolderHierarchyLookup(hierarchyItems);
-    QVector<LibraryNoteListItem> items;
-    items.reserve(notes.size());
+    const int folderSymbol = m_folderNoteCountIndex->symbols->find(
+        WhatSonHubSymbolTable::Kind::FolderUuid,
+        folderUuid);
+    if (!m_folderNoteCountIndex->hasFolder(folderSymbol))
+    {
+        return 0;
+    }
+    return includeSubfolders
+               ? m_folderNoteCountIndex->subtreeCountByFolderSymbol.at(folderSymbol)
+               : m_folderNoteCountIndex->directCountByFolderSymbol.at(folderSymbol);
+}
 
-    for (const LibraryNoteRecord& note : notes)
+bool WhatSonLibraryNoteListProjection::upsertFolderNoteCountsForNote(
+    const LibraryNoteRecord& note,
+    QVector<int>* outChangedRows)
+{
+    if (!m_folderNoteCountIndex)
     {
-        if (!noteMatchesFolderScope(note, selectedFolderUuid, lookup))
-        {
-            continue;
-        }
+        return false;
+    }
 
-        const LibraryNoteListItem item = buildNoteListItem(note, canonicalNoteFolderLabels(note, &lookup));
-        if (item.id.trimmed().isEmpty() && item.noteDirectoryPath.trimmed().isEmpty())
-        {
-            WhatSon::Debug::trace(
-                QStringLiteral("library.noteListProjection"),
-                QStringLiteral("buildFolderScopedNoteListItems.skipInvalidNote"),
-                QStringLiteral("primaryText=%1 createdAt=%2 lastModifiedAt=%3")
-                    .arg(item.primaryText)
-                    .arg(item.createdAt)
-                    .arg(item.lastModifiedAt));
-            continue;
-        }
-        items.push_back(item);
+    const QStringList nextFolderUuids = m_folderNoteCountIndex->usesFoldersHierarchy
+                                            ? effectiveNoteFolderUuids(note, m_folderNoteCountIndex->lookup)
+                                            : QStringList();
+    return applyFolderNoteCountChange(note.noteId.trimmed(), nextFolderUuids, false, outChangedRows);
+}
+
+bool WhatSonLibraryNoteListProjection::removeFolderNoteCountsForNote(
+    const QString& noteId,
+    QVector<int>* outChangedRows)
+{
+    if (!m_folderNoteCountIndex)
+    {
+        return false;
     }
 
-    return items;
+    return applyFolderNoteCountChange(noteId.trimmed(), {}, true, outChangedRows);
 }
 
-LibraryNoteListItem WhatSonLibraryNoteListProjection::buildNoteListItem(
-    const LibraryNoteRecord& note,
-    const QStringList& folderLabels) const
+bool WhatSonLibraryNoteListProjection::applyFolderNoteCountChange(
+    const QString& noteId,
+    const QStringList& nextFolderUuids,
+    bool removeNote,
+    QVector<int>* outChangedRows)
 {
-    QString noteId = note.noteId.trimmed();
-    const QString noteDirectoryPath =
-        WhatSon::Hierarchy::LibrarySupport::normalizePath(note.noteDirectoryPath);
-    if (noteId.isEmpty() && !noteDirectoryPath.isEmpty())
+    if (outChangedRows != nullptr)
     {
-        noteId = QFileInfo(noteDirectoryPath).completeBaseName().trimmed();
-        if (noteId.isEmpty())
-        {
-            noteId = QFileInfo(noteDirectoryPath).fileName().trimmed();
-        }
-        if (!noteId.isEmpty())
+        outChangedRows->clear();
+    }
+    if (noteId.isEmpty())
+    {
+        return true;
+    }
+
+    FolderNoteCountIndex& index = *m_folderNoteCountIndex;
+    const int noteSymbol = removeNote
+                               ? index.symbols->findNormalized(WhatSonHubSymbolTable::Kind::NoteId, noteId)
+                               : index.symbols->internNormalized(WhatSonHubSymbolTable::Kind::NoteId, noteId);
+    if (noteSymbol == WhatSonHubSymbolTable::kNoSymbol)
+    {
+        return true;
+    }
+    if (noteSymbol >= index.folderSymbolsByNoteSymbol.size())
+    {
+        index.folderSymbolsByNoteSymbol.resize(noteSymbol + 1);
+    }
+
+    const QVector<int> nextFolderSymbols = index.folderSymbols(nextFolderUuids);
+    const QVector<int> previousFolderSymbols = std::exchange(
+        index.folderSymbolsByNoteSymbol[noteSymbol],
+        removeNote ? QVector<int>() : nextFolderSymbols);
+    if (previousFolderSymbols == nextFolderSymbols)
+    {
+        return true;
+    }
+
+    QHash<int, int> directDeltaByFolderSymbol;
+    QHash<int, int> subtreeDeltaByFolderSymbol;
+    for (const int folderSymbol : previousFolderSymbols)
+    {
+        --directDeltaByFolderSymbol[folderSymbol];
+    }
+    for (const int folderSymbol : nextFolderSymbols)
+    {
+        ++directDeltaByFolderSymbol[folderSymbol];
+    }
+    for (const int folderSymbol : folderSymbolsWithAncestors(previousFolderSymbols, index.parentByFolderSymbol))
+    {
+        --subtreeDeltaByFolderSymbol[folderSymbol];
+    }
+    for (const int folderSymbol : folderSymbolsWithAncestors(nextFolderSymbols, index.parentByFolderSymbol))
+    {
+        ++subtreeDeltaByFolderSymbol[folderSymbol];
+    }
+
+    QSet<int> changedRows;
+    const auto applyDeltas = [&index, &changedRows](
+        const QHash<int, int>& deltaByFolderSymbol,
+        QVector<int>* countByFolderSymbol)
+    {
+        for (auto deltaIt = deltaByFolderSymbol.cbegin(); deltaIt != deltaByFolderSymbol.cend(); ++deltaIt)
         {
-            WhatSon::Debug::trace(
-                QStringLiteral("library.noteListProjection"),
-                QStringLiteral("buildNoteListItem.derivedNoteIdFromDirectoryPath"),
-                QStringLiteral("noteDirectoryPath=%1 derivedNoteId=%2")
-                    .arg(noteDirectoryPath)
-                    .arg(noteId));
+            if (deltaIt.value() == 0)
+            {
+                continue;
+            }
+            int& count = (*countByFolderSymbol)[deltaIt.key()];
+            count = std::max(0, count + deltaIt.value());
+            changedRows.insert(index.rowByFolderSymbol.at(deltaIt.key()));
         }
-    }
+    };
+    applyDeltas(directDeltaByFolderSymbol, &index.directCountByFolderSymbol);
+    applyDeltas(subtreeDeltaByFolderSymbol, &index.subtreeCountByFolderSymbol);
 
-    const QString cacheKey = noteListItemCacheKey(noteId, noteDirectoryPath);
-    if (!m_noteListItemCache.isEmpty())
+    if (outChangedRows != nullptr)
     {
-        const auto cachedIt = m_noteListItemCache.constFind(cacheKey);
-        if (cachedIt != m_noteListItemCache.constEnd())
+        outChangedRows->reserve(changedRows.size());
+        for (const int row : std::as_const(changedRows))
         {
-            return cachedIt.value();
+            outChangedRows->push_back(row);
         }
+        std::sort(outChangedRows->begin(), outChangedRows->end());
     }
+    return true;
+}
 
-    LibraryNoteListItem item;
-    item.id = noteId;
-    item.noteDirectoryPath = noteDirectoryPath;
-    item.primaryText = WhatSon::LibraryPreview::notePrimaryText(note);
-    item.searchableText = noteSearchableText(note, folderLabels);
-    item.bodyText.clear();
-    item.createdAt = note.createdAt;
-    item.lastModifiedAt = note.lastModifiedAt;
-    item.image = false;
-    item.imageSource.clear();
-    item.displayDate = m_systemCalendarStore
-                           ? m_systemCalendarStore->formatNoteDate(note.lastModifiedAt, note.createdAt)
-                           : SystemCalendarStore::formatNoteDateForSystem(note.lastModifiedAt, note.createdAt);
-    item.folders = folderLabels;
-    item.tags = noteListTags(note);
-    item.bookmarked = note.bookmarked;
-    item.bookmarkColor = bookmarkColorHexFromNote(note);
-
-    WhatSon::Debug::trace(
-        QStringLiteral("library.noteListProjection"),
-        QStringLiteral("buildNoteListItem"),
-        QStringLiteral("noteId=%1 noteDirectoryPath=%2 primaryText=%3")
-            .arg(item.id)
-            .arg(item.noteDirectoryPath)
-            .arg(WhatSon::Debug::summarizeText(item.primaryText, 48)));
-    if (!cacheKey.isEmpty())
+std::shared_ptr<const ILibraryNoteListRowSource> WhatSonLibraryNoteListProjection::buildNoteListRows(
+    const QVector<LibraryHierarchyItem>& hierarchyItems,
+    const QVector<LibraryNoteRecord>& notes,
+    bool foldersHierarchyLoaded) const
+{
+    std::shared_ptr<const FolderHierarchyLookup> lookup;
+    if (foldersHierarchyLoaded)
     {
-        m_noteListItemCache.insert(cacheKey, item);
+        lookup = std::make_shared<const FolderHierarchyLookup>(buildFolderHierarchyLookup(hierarchyItems));
     }
-    return item;
+    return std::make_shared<const LibraryNoteListRows>(
+        notes,
+        listedNoteRows(notes, nullptr, QString()),
+        std::move(lookup));
+}
+
+std::shared_ptr<const ILibraryNoteListRowSource> WhatSonLibraryNoteListProjection::buildFolderScopedNoteListRows(
+    const QVector<LibraryHierarchyItem>& hierarchyItems,
+    const QVector<LibraryNoteRecord>& notes,
+    const QString& selectedFolderUuid) const
+{
+    auto lookup = std::make_shared<const FolderHierarchyLookup>(buildFolderHierarchyLookup(hierarchyItems));
+    QVector<int> noteRows = listedNoteRows(notes, lookup.get(), selectedFolderUuid);
+    return std::make_shared<const LibraryNoteListRows>(
+        notes,
+        std::move(noteRows),
+        std::move(lookup));
 }
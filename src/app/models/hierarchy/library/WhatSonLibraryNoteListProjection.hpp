@@ -1,46 +1,69 @@
 #pragma once
 
-#include "app/models/calendar/ISystemCalendarStore.hpp"
+#include "app/models/file/hub/WhatSonHubSymbolTable.hpp"
 #include "app/models/hierarchy/library/LibraryHierarchyModel.hpp"
 #include "app/models/hierarchy/library/LibraryNoteListModel.hpp"
 #include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
 
 #include <QHash>
-#include <QPointer>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
+#include <memory>
+
 class WhatSonLibraryNoteListProjection final
 {
 public:
-    void setSystemCalendarStore(ISystemCalendarStore* store);
-    ISystemCalendarStore* systemCalendarStore() const noexcept;
+    WhatSonLibraryNoteListProjection();
+    ~WhatSonLibraryNoteListProjection();
+
+    WhatSonLibraryNoteListProjection(const WhatSonLibraryNoteListProjection&) = delete;
+    WhatSonLibraryNoteListProjection& operator=(const WhatSonLibraryNoteListProjection&) = delete;
 
     void invalidate() const;
-    void invalidateForNoteId(const QString& noteId) const;
+    // Hub table the folder note-count index interns into. Switching tables drops the index; without one the index
+    // interns into a private table.
+    void setSymbolTable(std::shared_ptr<WhatSonHubSymbolTable> symbols) const;
 
     QHash<QString, int> folderNoteCountByFolderUuid(
         const QVector<LibraryHierarchyItem>& hierarchyItems,
         const QVector<LibraryNoteRecord>& notes,
         bool foldersHierarchyLoaded) const;
 
-    QVector<LibraryNoteListItem> buildNoteListItems(
+    // Folder note counts kept per note binding. invalidate() drops the index; ensureFolderNoteCounts rebuilds it
+    // from a full snapshot, and the per-note updates report the hierarchy rows whose counts moved.
+    void ensureFolderNoteCounts(
         const QVector<LibraryHierarchyItem>& hierarchyItems,
         const QVector<LibraryNoteRecord>& notes,
         bool foldersHierarchyLoaded) const;
+    bool hasFolderNoteCounts() const noexcept;
+    int folderNoteCount(const QString& folderUuid, bool includeSubfolders) const;
+    bool upsertFolderNoteCountsForNote(const LibraryNoteRecord& note, QVector<int>* outChangedRows);
+    bool removeFolderNoteCountsForNote(const QString& noteId, QVector<int>* outChangedRows);
 
-    QVector<LibraryNoteListItem> buildFolderScopedNoteListItems(
+    // Row sources for LibraryNoteListModel::setRowSource(). Each holds a shared copy of `notes` and one row index per
+    // listed note; display items are built only for the rows the model materialises and leave displayDate to the
+    // model's locale-aware cache.
+    std::shared_ptr<const ILibraryNoteListRowSource> buildNoteListRows(
+        const QVector<LibraryHierarchyItem>& hierarchyItems,
+        const QVector<LibraryNoteRecord>& notes,
+        bool foldersHierarchyLoaded) const;
+
+    std::shared_ptr<const ILibraryNoteListRowSource> buildFolderScopedNoteListRows(
         const QVector<LibraryHierarchyItem>& hierarchyItems,
         const QVector<LibraryNoteRecord>& notes,
         const QString& selectedFolderUuid) const;
 
 private:
-    LibraryNoteListItem buildNoteListItem(
-        const LibraryNoteRecord& note,
-        const QStringList& folderLabels) const;
+    struct FolderNoteCountIndex;
+
+    bool applyFolderNoteCountChange(
+        const QString& noteId,
+        const QStringList& nextFolderUuids,
+        bool removeNote,
+        QVector<int>* outChangedRows);
 
-    QPointer<ISystemCalendarStore> m_systemCalendarStore;
-    mutable QHash<QString, LibraryNoteListItem> m_noteListItemCache;
-    mutable bool m_noteListItemCacheUsesFoldersHierarchy = false;
+    mutable std::shared_ptr<WhatSonHubSymbolTable> m_symbols;
+    mutable std::unique_ptr<FolderNoteCountIndex> m_folderNoteCountIndex;
 };
@@ -1,6 +1,7 @@
 #include "app/models/hierarchy/preset/PresetHierarchyController.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
 #include "app/models/hierarchy/preset/WhatSonPresetHierarchyParser.hpp"
 #include "app/models/hierarchy/preset/WhatSonPresetHierarchyStore.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyTreeItemSupport.hpp"
@@ -8,6 +9,7 @@
 
 #include <QDir>
 #include <QFileInfo>
+#include <QJsonObject>
 #include <QSet>
 #include <utility>
 
@@ -105,7 +107,14 @@ QVariantList PresetHierarchyController::hierarchyModel() const
 
 QVariantList PresetHierarchyController::depthItems() const
 {
-    return WhatSon::Hierarchy::NamedStringSupport::lvrsDepthItems(m_items, kKeyPrefix);
+    QVariantList serialized = WhatSon::Hierarchy::NamedStringSupport::lvrsDepthItems(m_items, kKeyPrefix);
+    for (int index = 0; index < serialized.size() && index < m_items.size(); ++index)
+    {
+        QVariantMap entry = serialized.at(index).toMap();
+        entry.insert(QStringLiteral("count"), presetNoteCount(index));
+        serialized[index] = entry;
+    }
+    return serialized;
 }
 
 QString PresetHierarchyController::itemLabel(int index) const
@@ -156,10 +165,12 @@ bool PresetHierarchyController::renameItem(int index, const QString& displayName
 
     const QStringList stagedPresetNames = WhatSon::Hierarchy::PresetSupport::extractDomainLabelsFromItems(stagedItems);
     WhatSonPresetHierarchyStore stagedStore = m_store;
+    stagedStore.renamePresetQuery(m_items.at(index).label, stagedItems.at(index).label);
     stagedStore.setPresetNames(stagedPresetNames);
 
     if (!m_presetFilePath.trimmed().isEmpty())
     {
+        WhatSonHubMutationJournal::Scope journalScope(m_presetFilePath, QStringLiteral("Rename preset"));
         QString writeError;
         if (!stagedStore.writeToFile(m_presetFilePath, &writeError))
         {
@@ -170,6 +181,7 @@ bool PresetHierarchyController::renameItem(int index, const QString& displayName
                                           m_presetFilePath, writeError));
             return false;
         }
+        journalScope.commit();
     }
 
     m_items = std::move(stagedItems);
@@ -271,7 +283,11 @@ void PresetHierarchyController::setPresetNames(QStringList presetNames)
         QStringLiteral("Preset"),
         m_presetNames,
         QStringLiteral("Preset"));
-    m_createdFolderSequence = WhatSon::Hierarchy::PresetSupport::nextGeneratedFolderSequence(m_items);
+    m_createdFolderSequence = 1;
+    for (const PresetHierarchyItem& item : std::as_const(m_items))
+    {
+        WhatSon::Hierarchy::PresetSupport::observeGeneratedFolderSequence(&m_createdFolderSequence, item.label);
+    }
     syncModel();
     setSelectedIndex(-1);
     WhatSon::Debug::traceSelf(this,
@@ -286,6 +302,109 @@ QStringList PresetHierarchyController::presetNames() const
     return m_presetNames;
 }
 
+QStringList PresetHierarchyController::presetNoteIds(int index) const
+{
+    if (index < 0 || index >= m_items.size())
+    {
+        return {};
+    }
+
+    return m_membership.memberNoteIds(m_membership.indexOfPreset(m_items.at(index).label));
+}
+
+int PresetHierarchyController::presetNoteCount(int index) const
+{
+    if (index < 0 || index >= m_items.size())
+    {
+        return 0;
+    }
+
+    return m_membership.memberCount(m_membership.indexOfPreset(m_items.at(index).label));
+}
+
+QVariantMap PresetHierarchyController::presetQuery(int index) const
+{
+    if (index < 0 || index >= m_items.size())
+    {
+        return {};
+    }
+
+    return m_store.presetQuery(m_items.at(index).label).toJson().toVariantMap();
+}
+
+bool PresetHierarchyController::setPresetQuery(int index, const QVariantMap& query)
+{
+    if (!canRenameItem(index))
+    {
+        WhatSon::Debug::traceSelf(this,
+                                  QString::fromLatin1(kScope),
+                                  QStringLiteral("setPresetQuery.rejected"),
+                                  QStringLiteral("reason=invalid index index=%1").arg(index));
+        return false;
+    }
+
+    const QString presetName = m_items.at(index).label;
+    WhatSonPresetHierarchyStore stagedStore = m_store;
+    stagedStore.setPresetQuery(presetName, WhatSonPresetQuery::fromJson(QJsonObject::fromVariantMap(query)));
+    if (stagedStore.presetQueries() == m_store.presetQueries())
+    {
+        return true;
+    }
+
+    if (!m_presetFilePath.trimmed().isEmpty())
+    {
+        WhatSonHubMutationJournal::Scope journalScope(m_presetFilePath, QStringLiteral("Edit preset query"));
+        QString writeError;
+        if (!stagedStore.writeToFile(m_presetFilePath, &writeError))
+        {
+            WhatSon::Debug::traceSelf(this,
+                                      QString::fromLatin1(kScope),
+                                      QStringLiteral("setPresetQuery.writeFailed"),
+                                      QStringLiteral("index=%1 path=%2 reason=%3").arg(index).arg(
+                                          m_presetFilePath, writeError));
+            return false;
+        }
+        journalScope.commit();
+    }
+
+    m_store = std::move(stagedStore);
+    syncModel();
+    emit presetMembershipChanged();
+    WhatSon::Debug::traceSelf(this,
+                              QString::fromLatin1(kScope),
+                              QStringLiteral("setPresetQuery.success"),
+                              QStringLiteral("index=%1 name=%2 count=%3").arg(index).arg(presetName).arg(
+                                  presetNoteCount(index)));
+    return true;
+}
+
+void PresetHierarchyController::setIndexedNotesProvider(std::function<QVector<LibraryNoteRecord>()> provider)
+{
+    m_indexedNotesProvider = std::move(provider);
+}
+
+void PresetHierarchyController::applyIndexedNotes(const QVector<LibraryNoteRecord>& notes)
+{
+    m_membership.setNotes(notes);
+    syncModel();
+    emit presetMembershipChanged();
+    WhatSon::Debug::traceSelf(this,
+                              QString::fromLatin1(kScope),
+                              QStringLiteral("applyIndexedNotes"),
+                              QStringLiteral("noteCount=%1 presetCount=%2").arg(m_membership.noteCount()).arg(
+                                  m_membership.presetCount()));
+}
+
+void PresetHierarchyController::upsertIndexedNote(const LibraryNoteRecord& note)
+{
+    applyMembershipChanges(m_membership.upsertNote(note));
+}
+
+void PresetHierarchyController::removeIndexedNote(const QString& noteId)
+{
+    applyMembershipChanges(m_membership.removeNote(noteId));
+}
+
 bool PresetHierarchyController::renameEnabled() const noexcept
 {
     return true;
@@ -326,6 +445,7 @@ bool PresetHierarchyController::loadFromWshub(const QString& wshubPath, QString*
     }
 
     QStringList aggregated;
+    QHash<QString, WhatSonPresetQuery> aggregatedQueries;
     bool fileFound = false;
 
     WhatSonPresetHierarchyParser parser;
@@ -378,6 +498,7 @@ bool PresetHierarchyController::loadFromWshub(const QString& wshubPath, QString*
         {
             aggregated.push_back(value);
         }
+        aggregatedQueries.insert(m_store.presetQueries());
     }
 
     if (m_presetFilePath.isEmpty() && !contentsDirectories.isEmpty())
@@ -385,6 +506,7 @@ bool PresetHierarchyController::loadFromWshub(const QString& wshubPath, QString*
         m_presetFilePath = QDir(contentsDirectories.first()).filePath(QStringLiteral("Preset.wspreset"));
     }
 
+    m_store.setPresetQueries(std::move(aggregatedQueries));
     setPresetNames(aggregated);
     WhatSon::Debug::traceSelf(this,
                               QString::fromLatin1(kScope),
@@ -397,6 +519,7 @@ bool PresetHierarchyController::loadFromWshub(const QString& wshubPath, QString*
 
 void PresetHierarchyController::applyRuntimeSnapshot(
     QStringList presetNames,
+    QHash<QString, WhatSonPresetQuery> presetQueries,
     QString presetFilePath,
     bool loadSucceeded,
     QString errorMessage)
@@ -416,20 +539,25 @@ void PresetHierarchyController::applyRuntimeSnapshot(
 
     const QStringList sanitizedPresetNames = WhatSon::Hierarchy::PresetSupport::sanitizeStringList(std::move(
         presetNames));
-    if (m_presetNames == sanitizedPresetNames)
+    if (m_presetNames == sanitizedPresetNames && m_store.presetQueries() == presetQueries)
     {
         updateLoadState(true);
         return;
     }
 
     m_presetNames = sanitizedPresetNames;
+    m_store.setPresetQueries(std::move(presetQueries));
     m_store.setPresetNames(m_presetNames);
     m_items = WhatSon::Hierarchy::PresetSupport::buildBucketItems(
         QStringLiteral("Preset"),
         m_presetNames,
         QStringLiteral("Preset"));
     WhatSon::Hierarchy::NamedStringSupport::restoreExpandedItemKeys(&m_items, kKeyPrefix, preservedExpandedKeys);
-    m_createdFolderSequence = WhatSon::Hierarchy::PresetSupport::nextGeneratedFolderSequence(m_items);
+    m_createdFolderSequence = 1;
+    for (const PresetHierarchyItem& item : std::as_const(m_items))
+    {
+        WhatSon::Hierarchy::PresetSupport::observeGeneratedFolderSequence(&m_createdFolderSequence, item.label);
+    }
     syncModel();
     setSelectedIndex(WhatSon::Hierarchy::NamedStringSupport::selectedIndexForKey(
         m_items,
@@ -471,6 +599,7 @@ bool PresetHierarchyController::reloadFromPresetFilePath(QString* errorMessage)
     }
 
     QStringList refreshedPresetNames;
+    QHash<QString, WhatSonPresetQuery> refreshedPresetQueries;
     if (QFileInfo(normalizedFilePath).isFile())
     {
         QString rawText;
@@ -497,9 +626,14 @@ bool PresetHierarchyController::reloadFromPresetFilePath(QString* errorMessage)
         }
 
         refreshedPresetNames = refreshedStore.presetNames();
+        refreshedPresetQueries = refreshedStore.presetQueries();
     }
 
-    applyRuntimeSnapshot(std::move(refreshedPresetNames), normalizedFilePath, true);
+    applyRuntimeSnapshot(
+        std::move(refreshedPresetNames),
+        std::move(refreshedPresetQueries),
+        normalizedFilePath,
+        true);
     if (errorMessage != nullptr)
     {
         errorMessage->clear();
@@ -533,11 +667,37 @@ void PresetHierarchyController::updateLoadState(bool succeeded, QString errorMes
 
 void PresetHierarchyController::syncModel()
 {
+    m_membership.setPresets(
+        m_presetNames,
+        m_store.presetQueries(),
+        m_indexedNotesProvider ? m_indexedNotesProvider() : QVector<LibraryNoteRecord>{});
     m_itemModel.setItems(depthItems());
     updateItemCount();
     emit hierarchyModelChanged();
 }
 
+void PresetHierarchyController::applyMembershipChanges(const QList<int>& changedPresetIndexes)
+{
+    if (changedPresetIndexes.isEmpty())
+    {
+        return;
+    }
+
+    // Only the rows whose member set moved get a count update; the rest of the model stays untouched.
+    for (const int presetIndex : changedPresetIndexes)
+    {
+        const QString presetName = m_membership.presetName(presetIndex);
+        for (int index = 0; index < m_items.size(); ++index)
+        {
+            if (m_items.at(index).label == presetName)
+            {
+                m_itemModel.setItemCount(index, m_membership.memberCount(presetIndex));
+            }
+        }
+    }
+    emit presetMembershipChanged();
+}
+
 void PresetHierarchyController::syncDomainStoreFromItems()
 {
     m_presetNames = WhatSon::Hierarchy::PresetSupport::extractDomainLabelsFromItems(m_items);
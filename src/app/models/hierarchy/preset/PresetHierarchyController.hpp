@@ -1,15 +1,20 @@
 #pragma once
 
 #include "app/models/hierarchy/preset/WhatSonPresetHierarchyStore.hpp"
+#include "app/models/hierarchy/preset/WhatSonPresetMembershipIndex.hpp"
 #include "app/models/hierarchy/IHierarchyCapabilities.hpp"
 #include "app/models/hierarchy/IHierarchyController.hpp"
 #include "app/models/hierarchy/preset/PresetHierarchyModel.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyModel.hpp"
 
+#include <QHash>
 #include <QStringList>
 #include <QVariantList>
+#include <QVariantMap>
 #include <QVector>
 
+#include <functional>
+
 class PresetHierarchyController final : public IHierarchyController,
                                        public IHierarchyRenameCapability,
                                        public IHierarchyCrudCapability,
@@ -52,6 +57,19 @@ public:
 
     void setPresetNames(QStringList presetNames);
     QStringList presetNames() const;
+
+    // Smart preset membership over the shared note index. Counts are kept current per note change, so opening a
+    // preset only reads its member set.
+    Q_INVOKABLE QStringList presetNoteIds(int index) const;
+    Q_INVOKABLE int presetNoteCount(int index) const;
+    Q_INVOKABLE QVariantMap presetQuery(int index) const;
+    Q_INVOKABLE bool setPresetQuery(int index, const QVariantMap& query);
+    // Note records are read from the library index on demand; the controller only keeps member ids.
+    void setIndexedNotesProvider(std::function<QVector<LibraryNoteRecord>()> provider);
+    void applyIndexedNotes(const QVector<LibraryNoteRecord>& notes);
+    void upsertIndexedNote(const LibraryNoteRecord& note);
+    void removeIndexedNote(const QString& noteId);
+
     bool renameEnabled() const noexcept override;
     bool createFolderEnabled() const noexcept override;
     bool deleteFolderEnabled() const noexcept override;
@@ -59,6 +77,7 @@ public:
     bool loadFromWshub(const QString& wshubPath, QString* errorMessage = nullptr);
     void applyRuntimeSnapshot(
         QStringList presetNames,
+        QHash<QString, WhatSonPresetQuery> presetQueries,
         QString presetFilePath,
         bool loadSucceeded,
         QString errorMessage = QString());
@@ -80,6 +99,7 @@ public
     void itemCountChanged();
     void loadStateChanged();
     void controllerHookRequested();
+    void presetMembershipChanged();
 
 private:
     bool reloadFromPresetFilePath(QString* errorMessage = nullptr);
@@ -87,10 +107,13 @@ private:
     void updateLoadState(bool succeeded, QString errorMessage = QString());
     void syncModel();
     void syncDomainStoreFromItems();
+    void applyMembershipChanges(const QList<int>& changedPresetIndexes);
 
     QStringList m_presetNames;
     QVector<PresetHierarchyItem> m_items;
     WhatSonPresetHierarchyStore m_store;
+    WhatSonPresetMembershipIndex m_membership;
+    std::function<QVector<LibraryNoteRecord>()> m_indexedNotesProvider;
     WhatSonHierarchyModel m_itemModel;
     int m_selectedIndex = -1;
     int m_createdFolderSequence = 1;
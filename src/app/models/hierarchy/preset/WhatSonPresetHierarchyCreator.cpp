@@ -18,10 +18,21 @@ QString WhatSonPresetHierarchyCreator::targetRelativePath() const
 
 QString WhatSonPresetHierarchyCreator::createText(const WhatSonPresetHierarchyStore& store) const
 {
+    const QHash<QString, WhatSonPresetQuery> queries = store.presetQueries();
     QJsonArray values;
     for (const QString& value : store.presetNames())
     {
-        values.push_back(value);
+        const auto query = queries.constFind(value);
+        if (query == queries.constEnd())
+        {
+            values.push_back(value);
+            continue;
+        }
+
+        QJsonObject entry;
+        entry.insert(QStringLiteral("name"), value);
+        entry.insert(QStringLiteral("query"), query.value().toJson());
+        values.push_back(entry);
     }
 
     QJsonObject root;
@@ -33,8 +44,9 @@ QString WhatSonPresetHierarchyCreator::createText(const WhatSonPresetHierarchySt
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hierarchy.preset.creator"),
                               QStringLiteral("createText"),
-                              QStringLiteral("count=%1 bytes=%2")
+                              QStringLiteral("count=%1 queryCount=%2 bytes=%3")
                               .arg(store.presetNames().size())
+                              .arg(queries.size())
                               .arg(text.toUtf8().size()));
     return text;
 }
@@ -9,6 +9,8 @@
 #include <QJsonParseError>
 #include <QRegularExpression>
 
+#include <utility>
+
 namespace
 {
     QStringList sanitizeLines(const QString& rawText)
@@ -30,7 +32,8 @@ namespace
         return values;
     }
 
-    QStringList parseArrayValues(const QJsonArray& array)
+    // Entries are either plain names or smart presets written as {"name": ..., "query": {...}}.
+    QStringList parseArrayValues(const QJsonArray& array, QHash<QString, WhatSonPresetQuery>* outQueries)
     {
         QStringList values;
         values.reserve(array.size());
@@ -44,6 +47,24 @@ namespace
                 {
                     values.push_back(text);
                 }
+                continue;
+            }
+
+            if (value.isObject())
+            {
+                const QJsonObject entry = value.toObject();
+                const QString name = entry.value(QStringLiteral("name")).toString().trimmed();
+                if (name.isEmpty())
+                {
+                    continue;
+                }
+                values.push_back(name);
+                const WhatSonPresetQuery query = WhatSonPresetQuery::fromJson(
+                    entry.value(QStringLiteral("query")).toObject());
+                if (!query.isEmpty())
+                {
+                    outQueries->insert(name, query);
+                }
             }
         }
 
@@ -89,10 +110,12 @@ bool WhatSonPresetHierarchyParser::parse(
     const QJsonDocument document = QJsonDocument::fromJson(rawText.toUtf8(), &parseError);
     if (parseError.error == QJsonParseError::NoError && !document.isNull())
     {
+        QHash<QString, WhatSonPresetQuery> parsedQueries;
         if (document.isArray())
         {
-            const QStringList parsedValues = parseArrayValues(document.array());
+            const QStringList parsedValues = parseArrayValues(document.array(), &parsedQueries);
             outStore->setPresetNames(parsedValues);
+            outStore->setPresetQueries(std::move(parsedQueries));
             return true;
         }
 
@@ -102,7 +125,8 @@ bool WhatSonPresetHierarchyParser::parse(
             const QJsonValue listValue = object.value(QStringLiteral("presets"));
             if (listValue.isArray())
             {
-                outStore->setPresetNames(parseArrayValues(listValue.toArray()));
+                outStore->setPresetNames(parseArrayValues(listValue.toArray(), &parsedQueries));
+                outStore->setPresetQueries(std::move(parsedQueries));
                 return true;
             }
             if (listValue.isString())
@@ -6,6 +6,7 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <iterator>
 #include <utility>
 
 namespace
@@ -37,6 +38,7 @@ void WhatSonPresetHierarchyStore::clear()
 {
     m_hubPath.clear();
     m_presetNames.clear();
+    m_presetQueries.clear();
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hierarchy.preset.store"),
                               QStringLiteral("clear"));
@@ -65,6 +67,10 @@ void WhatSonPresetHierarchyStore::setPresetNames(QStringList values)
 {
     const int rawCount = values.size();
     m_presetNames = sanitizeValues(std::move(values));
+    for (auto it = m_presetQueries.begin(); it != m_presetQueries.end();)
+    {
+        it = m_presetNames.contains(it.key()) ? std::next(it) : m_presetQueries.erase(it);
+    }
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("hierarchy.preset.store"),
                               QStringLiteral("setPresetNames"),
@@ -74,6 +80,60 @@ void WhatSonPresetHierarchyStore::setPresetNames(QStringList values)
                               .arg(m_presetNames.join(QStringLiteral(", "))));
 }
 
+WhatSonPresetQuery WhatSonPresetHierarchyStore::presetQuery(const QString& presetName) const
+{
+    return m_presetQueries.value(presetName.trimmed());
+}
+
+QHash<QString, WhatSonPresetQuery> WhatSonPresetHierarchyStore::presetQueries() const
+{
+    return m_presetQueries;
+}
+
+void WhatSonPresetHierarchyStore::setPresetQuery(const QString& presetName, const WhatSonPresetQuery& query)
+{
+    const QString normalizedName = presetName.trimmed();
+    if (normalizedName.isEmpty())
+    {
+        return;
+    }
+
+    if (query.isEmpty())
+    {
+        m_presetQueries.remove(normalizedName);
+    }
+    else
+    {
+        m_presetQueries.insert(normalizedName, query);
+    }
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("hierarchy.preset.store"),
+                              QStringLiteral("setPresetQuery"),
+                              QStringLiteral("name=%1 empty=%2").arg(normalizedName).arg(query.isEmpty() ? 1 : 0));
+}
+
+void WhatSonPresetHierarchyStore::setPresetQueries(QHash<QString, WhatSonPresetQuery> queries)
+{
+    m_presetQueries.clear();
+    for (auto it = queries.cbegin(); it != queries.cend(); ++it)
+    {
+        setPresetQuery(it.key(), it.value());
+    }
+}
+
+void WhatSonPresetHierarchyStore::renamePresetQuery(const QString& previousName, const QString& nextName)
+{
+    const QString normalizedPrevious = previousName.trimmed();
+    const QString normalizedNext = nextName.trimmed();
+    if (normalizedPrevious == normalizedNext || !m_presetQueries.contains(normalizedPrevious))
+    {
+        return;
+    }
+
+    const WhatSonPresetQuery query = m_presetQueries.take(normalizedPrevious);
+    setPresetQuery(normalizedNext, query);
+}
+
 bool WhatSonPresetHierarchyStore::writeToFile(const QString& filePath, QString* errorMessage) const
 {
     const QString normalizedPath = filePath.trimmed();
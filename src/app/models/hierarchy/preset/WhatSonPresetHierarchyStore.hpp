@@ -1,5 +1,8 @@
 #pragma once
 
+#include "app/models/hierarchy/preset/WhatSonPresetQuery.hpp"
+
+#include <QHash>
 #include <QString>
 #include <QStringList>
 
@@ -16,9 +19,17 @@ public:
 
     QStringList presetNames() const;
     void setPresetNames(QStringList values);
+
+    // Smart preset queries keyed by preset name. Names without a query stay plain presets.
+    WhatSonPresetQuery presetQuery(const QString& presetName) const;
+    QHash<QString, WhatSonPresetQuery> presetQueries() const;
+    void setPresetQuery(const QString& presetName, const WhatSonPresetQuery& query);
+    void setPresetQueries(QHash<QString, WhatSonPresetQuery> queries);
+    void renamePresetQuery(const QString& previousName, const QString& nextName);
     bool writeToFile(const QString& filePath, QString* errorMessage = nullptr) const;
 
 private:
     QString m_hubPath;
     QStringList m_presetNames;
+    QHash<QString, WhatSonPresetQuery> m_presetQueries;
 };
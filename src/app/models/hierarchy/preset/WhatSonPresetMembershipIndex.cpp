@@ -0,0 +1,198 @@
+#include "app/models/hierarchy/preset/WhatSonPresetMembershipIndex.hpp"
+
+#include <algorithm>
+#include <utility>
+
+void WhatSonPresetMembershipIndex::clear()
+{
+    m_presets.clear();
+    m_noteSequencesById.clear();
+    m_nextNoteSequence = 0;
+}
+
+void WhatSonPresetMembershipIndex::setPresets(
+    const QStringList& names,
+    const QHash<QString, WhatSonPresetQuery>& queries,
+    const QVector<LibraryNoteRecord>& notes)
+{
+    QVector<Preset> previousPresets = std::move(m_presets);
+    m_presets.clear();
+    m_presets.reserve(names.size());
+    for (const QString& name : names)
+    {
+        const WhatSonPresetQuery query = queries.value(name);
+        const auto previous = std::find_if(
+            previousPresets.begin(),
+            previousPresets.end(),
+            [&query](const Preset& preset)
+            {
+                return preset.query == query;
+            });
+        if (previous != previousPresets.end())
+        {
+            Preset reused = std::move(*previous);
+            previousPresets.erase(previous);
+            reused.name = name;
+            m_presets.push_back(std::move(reused));
+            continue;
+        }
+
+        Preset preset{name, query, WhatSonPresetPredicate(query), {}};
+        rebuildMembers(&preset, notes);
+        m_presets.push_back(std::move(preset));
+    }
+}
+
+void WhatSonPresetMembershipIndex::setNotes(const QVector<LibraryNoteRecord>& notes)
+{
+    m_noteSequencesById.clear();
+    m_noteSequencesById.reserve(notes.size());
+    m_nextNoteSequence = 0;
+    for (const LibraryNoteRecord& note : notes)
+    {
+        if (!note.noteId.isEmpty() && !m_noteSequencesById.contains(note.noteId))
+        {
+            m_noteSequencesById.insert(note.noteId, m_nextNoteSequence++);
+        }
+    }
+    for (Preset& preset : m_presets)
+    {
+        rebuildMembers(&preset, notes);
+    }
+}
+
+QList<int> WhatSonPresetMembershipIndex::upsertNote(const LibraryNoteRecord& note)
+{
+    if (note.noteId.isEmpty())
+    {
+        return {};
+    }
+
+    auto sequence = m_noteSequencesById.constFind(note.noteId);
+    if (sequence == m_noteSequencesById.constEnd())
+    {
+        sequence = m_noteSequencesById.insert(note.noteId, m_nextNoteSequence++);
+    }
+
+    QList<int> changedPresetIndexes;
+    for (int presetIndex = 0; presetIndex < m_presets.size(); ++presetIndex)
+    {
+        Preset& preset = m_presets[presetIndex];
+        ++m_predicateEvaluationCount;
+        const bool matches = preset.predicate.matches(note);
+        if (matches == preset.members.contains(sequence.value()))
+        {
+            continue;
+        }
+        if (matches)
+        {
+            preset.members.insert(sequence.value(), note.noteId);
+        }
+        else
+        {
+            preset.members.remove(sequence.value());
+        }
+        changedPresetIndexes.push_back(presetIndex);
+    }
+    return changedPresetIndexes;
+}
+
+QList<int> WhatSonPresetMembershipIndex::removeNote(const QString& noteId)
+{
+    const auto sequence = m_noteSequencesById.constFind(noteId);
+    if (sequence == m_noteSequencesById.constEnd())
+    {
+        return {};
+    }
+
+    // Sequences are never reused, so the remaining members keep their order without renumbering.
+    const quint64 removedSequence = sequence.value();
+    m_noteSequencesById.erase(sequence);
+
+    QList<int> changedPresetIndexes;
+    for (int presetIndex = 0; presetIndex < m_presets.size(); ++presetIndex)
+    {
+        if (m_presets[presetIndex].members.remove(removedSequence) > 0)
+        {
+            changedPresetIndexes.push_back(presetIndex);
+        }
+    }
+    return changedPresetIndexes;
+}
+
+int WhatSonPresetMembershipIndex::presetCount() const noexcept
+{
+    return static_cast<int>(m_presets.size());
+}
+
+int WhatSonPresetMembershipIndex::noteCount() const noexcept
+{
+    return static_cast<int>(m_noteSequencesById.size());
+}
+
+int WhatSonPresetMembershipIndex::indexOfPreset(const QString& name) const
+{
+    for (int index = 0; index < m_presets.size(); ++index)
+    {
+        if (m_presets.at(index).name == name)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+QString WhatSonPresetMembershipIndex::presetName(const int presetIndex) const
+{
+    if (presetIndex < 0 || presetIndex >= m_presets.size())
+    {
+        return {};
+    }
+    return m_presets.at(presetIndex).name;
+}
+
+int WhatSonPresetMembershipIndex::memberCount(const int presetIndex) const
+{
+    if (presetIndex < 0 || presetIndex >= m_presets.size())
+    {
+        return 0;
+    }
+    return static_cast<int>(m_presets.at(presetIndex).members.size());
+}
+
+QStringList WhatSonPresetMembershipIndex::memberNoteIds(const int presetIndex) const
+{
+    if (presetIndex < 0 || presetIndex >= m_presets.size())
+    {
+        return {};
+    }
+    return m_presets.at(presetIndex).members.values();
+}
+
+quint64 WhatSonPresetMembershipIndex::predicateEvaluationCount() const noexcept
+{
+    return m_predicateEvaluationCount;
+}
+
+void WhatSonPresetMembershipIndex::rebuildMembers(Preset* preset, const QVector<LibraryNoteRecord>& notes)
+{
+    preset->members.clear();
+    if (preset->predicate.isEmpty())
+    {
+        return;
+    }
+    for (const LibraryNoteRecord& note : notes)
+    {
+        // Records the index has not seen through setNotes/upsertNote belong to a different snapshot.
+        const auto sequence = m_noteSequencesById.constFind(note.noteId);
+        if (sequence == m_noteSequencesById.constEnd())
+        {
+            continue;
+        }
+        ++m_predicateEvaluationCount;
+        if (preset->predicate.matches(note))
+        {
+            preset->members.insert(sequence.value(), note.noteId);
+        }
+    }
+}
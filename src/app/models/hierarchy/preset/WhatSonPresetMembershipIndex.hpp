@@ -0,0 +1,61 @@
+#pragma once
+
+#include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
+#include "app/models/hierarchy/preset/WhatSonPresetQuery.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Member sets for every smart preset over the shared note index. A full rebuild evaluates each compiled predicate once
+// per note; after that, a single note change only re-evaluates that note, so preset counts stay current without
+// rescanning the hub. Callers get back the preset indexes whose membership actually changed.
+//
+// The index keeps note ids only. Note records stay in the library index and are passed in when a preset has to be
+// evaluated, so the index never holds a second copy of the hub.
+class WhatSonPresetMembershipIndex final
+{
+public:
+    struct Preset
+    {
+        QString name;
+        WhatSonPresetQuery query;
+        WhatSonPresetPredicate predicate;
+        // Keyed by note sequence so members come back in index order.
+        QMap<quint64, QString> members;
+    };
+
+    void clear();
+
+    // Presets keep their order. A preset whose query is unchanged keeps its member set, so renames and edits to other
+    // presets do not rescan the notes. Only new or edited presets are evaluated, against notes.
+    void setPresets(
+        const QStringList& names,
+        const QHash<QString, WhatSonPresetQuery>& queries,
+        const QVector<LibraryNoteRecord>& notes = {});
+    void setNotes(const QVector<LibraryNoteRecord>& notes);
+    QList<int> upsertNote(const LibraryNoteRecord& note);
+    QList<int> removeNote(const QString& noteId);
+
+    int presetCount() const noexcept;
+    int noteCount() const noexcept;
+    int indexOfPreset(const QString& name) const;
+    QString presetName(int presetIndex) const;
+    int memberCount(int presetIndex) const;
+    // Member ids in note index order; notes added later follow the snapshot, and removals keep the order.
+    QStringList memberNoteIds(int presetIndex) const;
+    // Predicate evaluations since construction; rebuilds cost one per note and preset, single-note updates one per
+    // preset.
+    quint64 predicateEvaluationCount() const noexcept;
+
+private:
+    void rebuildMembers(Preset* preset, const QVector<LibraryNoteRecord>& notes);
+
+    QVector<Preset> m_presets;
+    QHash<QString, quint64> m_noteSequencesById;
+    quint64 m_nextNoteSequence = 0;
+    quint64 m_predicateEvaluationCount = 0;
+};
@@ -0,0 +1,266 @@
+#include "app/models/hierarchy/preset/WhatSonPresetQuery.hpp"
+
+#include <QJsonArray>
+
+namespace
+{
+    QStringList sanitizedValues(const QStringList& values)
+    {
+        QStringList sanitized;
+        sanitized.reserve(values.size());
+        for (const QString& value : values)
+        {
+            const QString trimmed = value.trimmed();
+            if (!trimmed.isEmpty() && !sanitized.contains(trimmed))
+            {
+                sanitized.push_back(trimmed);
+            }
+        }
+        return sanitized;
+    }
+
+    QStringList stringValues(const QJsonValue& value)
+    {
+        QStringList values;
+        for (const QJsonValue& entry : value.toArray())
+        {
+            if (entry.isString())
+            {
+                values.push_back(entry.toString());
+            }
+        }
+        return sanitizedValues(values);
+    }
+
+    QJsonArray stringArray(const QStringList& values)
+    {
+        QJsonArray array;
+        for (const QString& value : values)
+        {
+            array.push_back(value);
+        }
+        return array;
+    }
+
+    WhatSonPresetDateRange dateRangeFromJson(const QJsonValue& value)
+    {
+        const QJsonObject object = value.toObject();
+        return WhatSonPresetDateRange{
+            object.value(QStringLiteral("from")).toString().trimmed(),
+            object.value(QStringLiteral("to")).toString().trimmed()
+        };
+    }
+
+    QJsonObject dateRangeToJson(const WhatSonPresetDateRange& range)
+    {
+        QJsonObject object;
+        if (!range.from.isEmpty())
+        {
+            object.insert(QStringLiteral("from"), range.from);
+        }
+        if (!range.to.isEmpty())
+        {
+            object.insert(QStringLiteral("to"), range.to);
+        }
+        return object;
+    }
+
+    bool folderMatches(const QString& noteFolder, const QString& presetFolder)
+    {
+        return noteFolder.startsWith(presetFolder)
+            && (noteFolder.size() == presetFolder.size() || noteFolder.at(presetFolder.size()) == QLatin1Char('/'));
+    }
+} // namespace
+
+bool WhatSonPresetDateRange::isEmpty() const noexcept
+{
+    return from.isEmpty() && to.isEmpty();
+}
+
+bool WhatSonPresetDateRange::contains(const QStringView timestamp) const noexcept
+{
+    if (!from.isEmpty() && timestamp.left(from.size()).compare(from) < 0)
+    {
+        return false;
+    }
+    if (!to.isEmpty() && timestamp.left(to.size()).compare(to) > 0)
+    {
+        return false;
+    }
+    return !timestamp.isEmpty() || isEmpty();
+}
+
+bool WhatSonPresetQuery::isEmpty() const noexcept
+{
+    return folders.isEmpty()
+        && tags.isEmpty()
+        && projects.isEmpty()
+        && bookmarkColors.isEmpty()
+        && progressValues.isEmpty()
+        && created.isEmpty()
+        && modified.isEmpty()
+        && minOpenCount < 0
+        && maxOpenCount < 0;
+}
+
+QJsonObject WhatSonPresetQuery::toJson() const
+{
+    QJsonObject object;
+    if (!folders.isEmpty())
+    {
+        object.insert(QStringLiteral("folders"), stringArray(folders));
+    }
+    if (!tags.isEmpty())
+    {
+        object.insert(QStringLiteral("tags"), stringArray(tags));
+    }
+    if (!projects.isEmpty())
+    {
+        object.insert(QStringLiteral("projects"), stringArray(projects));
+    }
+    if (!bookmarkColors.isEmpty())
+    {
+        object.insert(QStringLiteral("bookmarkColors"), stringArray(bookmarkColors));
+    }
+    if (!progressValues.isEmpty())
+    {
+        QJsonArray values;
+        for (const int value : progressValues)
+        {
+            values.push_back(value);
+        }
+        object.insert(QStringLiteral("progress"), values);
+    }
+    if (!created.isEmpty())
+    {
+        object.insert(QStringLiteral("created"), dateRangeToJson(created));
+    }
+    if (!modified.isEmpty())
+    {
+        object.insert(QStringLiteral("modified"), dateRangeToJson(modified));
+    }
+    if (minOpenCount >= 0 || maxOpenCount >= 0)
+    {
+        QJsonObject openCount;
+        if (minOpenCount >= 0)
+        {
+            openCount.insert(QStringLiteral("min"), minOpenCount);
+        }
+        if (maxOpenCount >= 0)
+        {
+            openCount.insert(QStringLiteral("max"), maxOpenCount);
+        }
+        object.insert(QStringLiteral("openCount"), openCount);
+    }
+    return object;
+}
+
+WhatSonPresetQuery WhatSonPresetQuery::fromJson(const QJsonObject& object)
+{
+    WhatSonPresetQuery query;
+    query.folders = stringValues(object.value(QStringLiteral("folders")));
+    query.tags = stringValues(object.value(QStringLiteral("tags")));
+    query.projects = stringValues(object.value(QStringLiteral("projects")));
+    query.bookmarkColors = stringValues(object.value(QStringLiteral("bookmarkColors")));
+    for (const QJsonValue& value : object.value(QStringLiteral("progress")).toArray())
+    {
+        if (value.isDouble() && !query.progressValues.contains(value.toInt()))
+        {
+            query.progressValues.push_back(value.toInt());
+        }
+    }
+    query.created = dateRangeFromJson(object.value(QStringLiteral("created")));
+    query.modified = dateRangeFromJson(object.value(QStringLiteral("modified")));
+    const QJsonObject openCount = object.value(QStringLiteral("openCount")).toObject();
+    query.minOpenCount = openCount.value(QStringLiteral("min")).toInt(-1);
+    query.maxOpenCount = openCount.value(QStringLiteral("max")).toInt(-1);
+    return query;
+}
+
+WhatSonPresetPredicate::WhatSonPresetPredicate(const WhatSonPresetQuery& query)
+    : m_empty(query.isEmpty())
+      , m_progressValues(query.progressValues.cbegin(), query.progressValues.cend())
+      , m_minOpenCount(query.minOpenCount)
+      , m_maxOpenCount(query.maxOpenCount)
+      , m_created(query.created)
+      , m_modified(query.modified)
+      , m_projects(query.projects.cbegin(), query.projects.cend())
+      , m_bookmarkColors(query.bookmarkColors.cbegin(), query.bookmarkColors.cend())
+      , m_tags(query.tags.cbegin(), query.tags.cend())
+      , m_folders(sanitizedValues(query.folders))
+{
+    for (QString& folder : m_folders)
+    {
+        while (folder.endsWith(QLatin1Char('/')))
+        {
+            folder.chop(1);
+        }
+    }
+    m_folders.removeAll(QString());
+}
+
+bool WhatSonPresetPredicate::isEmpty() const noexcept
+{
+    return m_empty;
+}
+
+bool WhatSonPresetPredicate::matches(const LibraryNoteRecord& note) const
+{
+    if (m_empty)
+    {
+        return false;
+    }
+    if (!m_progressValues.isEmpty() && !m_progressValues.contains(note.progress))
+    {
+        return false;
+    }
+    if ((m_minOpenCount >= 0 && note.openCount < m_minOpenCount)
+        || (m_maxOpenCount >= 0 && note.openCount > m_maxOpenCount))
+    {
+        return false;
+    }
+    if ((!m_created.isEmpty() && !m_created.contains(note.createdAt))
+        || (!m_modified.isEmpty() && !m_modified.contains(note.lastModifiedAt)))
+    {
+        return false;
+    }
+    if (!m_projects.isEmpty() && !m_projects.contains(note.project))
+    {
+        return false;
+    }
+
+    const auto containsAny = [](const QSet<QString>& wanted, const QStringList& values)
+    {
+        for (const QString& value : values)
+        {
+            if (wanted.contains(value))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    if (!m_bookmarkColors.isEmpty() && (!note.bookmarked || !containsAny(m_bookmarkColors, note.bookmarkColors)))
+    {
+        return false;
+    }
+    if (!m_tags.isEmpty() && !containsAny(m_tags, note.tags))
+    {
+        return false;
+    }
+    if (!m_folders.isEmpty())
+    {
+        for (const QString& noteFolder : note.folders)
+        {
+            for (const QString& presetFolder : m_folders)
+            {
+                if (folderMatches(noteFolder, presetFolder))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
+
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+// Inclusive range over note timestamps ("yyyy-MM-dd-hh-mm-ss"). Bounds may be any prefix of that format, so
+// "2026-03" covers the whole month; the comparison is a plain prefix compare and never parses dates.
+struct WhatSonPresetDateRange final
+{
+    QString from;
+    QString to;
+
+    bool isEmpty() const noexcept;
+    bool contains(QStringView timestamp) const noexcept;
+
+    bool operator==(const WhatSonPresetDateRange& other) const = default;
+};
+
+// Stored query behind a smart preset. Every non-empty criterion must match; list criteria match when the note has any
+// of the listed values. Folders also match their subfolders. A query without criteria selects no notes, which keeps
+// plain preset names from older Preset.wspreset files empty instead of turning them into "all notes".
+struct WhatSonPresetQuery final
+{
+    QStringList folders;
+    QStringList tags;
+    QStringList projects;
+    QStringList bookmarkColors;
+    QList<int> progressValues;
+    WhatSonPresetDateRange created;
+    WhatSonPresetDateRange modified;
+    int minOpenCount = -1;
+    int maxOpenCount = -1;
+
+    bool isEmpty() const noexcept;
+    QJsonObject toJson() const;
+    static WhatSonPresetQuery fromJson(const QJsonObject& object);
+
+    bool operator==(const WhatSonPresetQuery& other) const = default;
+};
+
+// A query compiled once into lookup sets and range bounds, then evaluated against index records without allocating.
+// Cheap scalar checks run before the list lookups so most non-members are rejected early.
+class WhatSonPresetPredicate final
+{
+public:
+    WhatSonPresetPredicate() = default;
+    explicit WhatSonPresetPredicate(const WhatSonPresetQuery& query);
+
+    bool isEmpty() const noexcept;
+    bool matches(const LibraryNoteRecord& note) const;
+
+private:
+    bool m_empty = true;
+    QSet<int> m_progressValues;
+    int m_minOpenCount = -1;
+    int m_maxOpenCount = -1;
+    WhatSonPresetDateRange m_created;
+    WhatSonPresetDateRange m_modified;
+    QSet<QString> m_projects;
+    QSet<QString> m_bookmarkColors;
+    QSet<QString> m_tags;
+    QStringList m_folders;
+};
@@ -2,6 +2,7 @@
 
 #include "app/models/calendar/SystemCalendarStore.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyNoteRecordSupport.hpp"
 #include "app/models/hierarchy/library/LibraryAll.hpp"
 #include "app/models/hierarchy/progress/WhatSonProgressHierarchyParser.hpp"
@@ -210,6 +211,14 @@ ProgressHierarchyController::ProgressHierarchyController(QObject* parent)
 {
     WhatSon::Debug::traceSelf(this, QString::fromLatin1(kScope), QStringLiteral("ctor"));
     initializeHierarchyInterfaceSignalBridge();
+    WhatSonMemoryAccounting::shared().track(
+        this,
+        QStringLiteral("progress"),
+        QStringLiteral("allNotes"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            estimate.addNoteRecords(m_allNotes);
+        });
     QObject::connect(
         &m_itemModel,
         &WhatSonHierarchyModel::itemCountChanged,
@@ -391,7 +400,11 @@ void ProgressHierarchyController::setProgressState(int progressValue, QStringLis
     const int maxProgressValue = std::max(0, static_cast<int>(m_items.size()) - 1);
     m_progressValue = std::clamp(progressValue, 0, maxProgressValue);
     syncProgressStore();
-    m_createdFolderSequence = WhatSon::Hierarchy::ProgressSupport::nextGeneratedFolderSequence(m_items);
+    m_createdFolderSequence = 1;
+    for (const ProgressHierarchyItem& item : std::as_const(m_items))
+    {
+        WhatSon::Hierarchy::ProgressSupport::observeGeneratedFolderSequence(&m_createdFolderSequence, item.label);
+    }
     syncModel();
     const int nextSelectedIndex = WhatSon::Hierarchy::TreeItemSupport::clampSelectionIndexToVisibleDefault(
         m_selectedIndex,
@@ -588,6 +601,26 @@ void ProgressHierarchyController::applyRuntimeSnapshot(
     updateLoadState(true);
 }
 
+void ProgressHierarchyController::applyRuntimeSnapshot(
+    int progressValue,
+    QStringList progressStates,
+    QString progressFilePath,
+    QVector<LibraryNoteRecord> indexedNotes,
+    bool loadSucceeded,
+    QString errorMessage)
+{
+    m_progressFilePath = progressFilePath.trimmed();
+    if (!loadSucceeded)
+    {
+        updateLoadState(false, errorMessage);
+        return;
+    }
+
+    setProgressState(progressValue, std::move(progressStates));
+    applyIndexedNotes(std::move(indexedNotes));
+    updateLoadState(true);
+}
+
 void ProgressHierarchyController::requestControllerHook()
 {
     if (m_progressFilePath.trimmed().isEmpty())
@@ -731,7 +764,7 @@ LibraryNoteListItem ProgressHierarchyController::buildNoteListItem(const Library
     item.tags = noteListTags(note);
     item.bookmarked = note.bookmarked;
     item.bookmarkColor = bookmarkColorHexFromNote(note);
-    return item;
+    return LibraryNoteListModel::normalizedItem(std::move(item));
 }
 
 void ProgressHierarchyController::refreshNoteListForSelection()
@@ -766,10 +799,15 @@ bool ProgressHierarchyController::refreshIndexedNotesFromWshub(const QString& ws
         return false;
     }
 
-    m_allNotes = libraryAll.notes();
+    applyIndexedNotes(libraryAll.notes());
+    return true;
+}
+
+void ProgressHierarchyController::applyIndexedNotes(QVector<LibraryNoteRecord> notes)
+{
+    m_allNotes = std::move(notes);
     refreshNoteListForSelection();
     emit hierarchyModelChanged();
-    return true;
 }
 
 bool ProgressHierarchyController::refreshIndexedNotesFromProgressFilePath(QString* errorMessage)
@@ -71,6 +71,14 @@ public:
         QString progressFilePath,
         bool loadSucceeded,
         QString errorMessage = QString());
+    // Same as above, with the notes the runtime loader already indexed for the library instead of a fresh hub walk.
+    void applyRuntimeSnapshot(
+        int progressValue,
+        QStringList progressStates,
+        QString progressFilePath,
+        QVector<LibraryNoteRecord> indexedNotes,
+        bool loadSucceeded,
+        QString errorMessage = QString());
 
 public
     slots  :
@@ -101,6 +109,7 @@ private:
     void refreshNoteListForSelection();
     bool refreshIndexedNotesFromWshub(const QString& wshubPath, QString* errorMessage = nullptr);
     bool refreshIndexedNotesFromProgressFilePath(QString* errorMessage = nullptr);
+    void applyIndexedNotes(QVector<LibraryNoteRecord> notes);
     int selectedProgressFilterValue() const noexcept;
     void rebuildItems();
     void syncProgressStore();
@@ -2,6 +2,8 @@
 
 #include "app/models/calendar/SystemCalendarStore.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyNoteRecordSupport.hpp"
 #include "app/models/hierarchy/library/LibraryAll.hpp"
 #include "app/models/hierarchy/projects/WhatSonProjectsHierarchyParser.hpp"
@@ -312,35 +314,8 @@ namespace
         return WhatSon::Bookmarks::defaultBookmarkColorHex();
     }
 
-    bool projectValueMatchesHierarchyItem(
-        const QString& projectValue,
-        const QVector<ProjectsHierarchyItem>& items,
-        int itemIndex)
-    {
-        if (itemIndex < 0 || itemIndex >= items.size())
-        {
-            return false;
-        }
-
-        const QString normalizedProjectValue = projectValue.trimmed();
-        if (normalizedProjectValue.isEmpty())
-        {
-            return false;
-        }
-
-        const ProjectsHierarchyItem& item = items.at(itemIndex);
-        if (normalizedProjectValue.compare(item.label.trimmed(), Qt::CaseInsensitive) == 0)
-        {
-            return true;
-        }
-
-        return normalizedProjectValue.compare(
-            projectsHierarchyItemKey(items, itemIndex),
-            Qt::CaseInsensitive) == 0;
-    }
-
     int noteCountForProjectItem(
-        const QVector<LibraryNoteRecord>& notes,
+        const LibraryAll& libraryAll,
         const QVector<ProjectsHierarchyItem>& items,
         int itemIndex)
     {
@@ -349,15 +324,16 @@ namespace
             return 0;
         }
 
-        int noteCount = 0;
-        for (const LibraryNoteRecord& note : notes)
+        // A note carries one project value, so the label and key postings only overlap when both name one symbol.
+        constexpr auto kProject = WhatSonHubSymbolTable::Kind::Project;
+        const QString& label = items.at(itemIndex).label;
+        const QString itemKey = projectsHierarchyItemKey(items, itemIndex);
+        const int labelCount = libraryAll.noteCountForFacet(kProject, label);
+        if (libraryAll.symbols().find(kProject, label) == libraryAll.symbols().find(kProject, itemKey))
         {
-            if (projectValueMatchesHierarchyItem(note.project, items, itemIndex))
-            {
-                ++noteCount;
-            }
+            return labelCount;
         }
-        return noteCount;
+        return labelCount + libraryAll.noteCountForFacet(kProject, itemKey);
     }
 
     QString resolveWshubPathFromProjectsFile(const QString& projectsFilePath)
@@ -421,20 +397,11 @@ namespace
         return index >= 0 && index < items.size() && !isProtectedRootItem(items.at(index));
     }
 
-    int subtreeEndIndexExclusive(const QVector<ProjectsHierarchyItem>& items, int startIndex)
-    {
-        if (startIndex < 0 || startIndex >= items.size())
-        {
-            return startIndex;
-        }
+    using ProjectsHierarchyTree = WhatSon::Hierarchy::HierarchyTree<ProjectsHierarchyItem>;
 
-        const int baseDepth = items.at(startIndex).depth;
-        int endIndex = startIndex + 1;
-        while (endIndex < items.size() && items.at(endIndex).depth > baseDepth)
-        {
-            ++endIndex;
-        }
-        return endIndex;
+    int subtreeEndIndexExclusive(const ProjectsHierarchyTree& tree, int startIndex)
+    {
+        return tree.subtreeEndFlatIndex(startIndex);
     }
 
     bool indexInsideSubtree(int index, int subtreeStart, int subtreeEndExclusive)
@@ -444,6 +411,7 @@ namespace
 
     bool resolveFolderMoveOperation(
         const QVector<ProjectsHierarchyItem>& items,
+        const ProjectsHierarchyTree& tree,
         int sourceIndex,
         int targetIndex,
         FolderDropPlacement placement,
@@ -454,7 +422,7 @@ namespace
             return false;
         }
 
-        const int sourceEndIndex = subtreeEndIndexExclusive(items, sourceIndex);
+        const int sourceEndIndex = subtreeEndIndexExclusive(tree, sourceIndex);
         const int sourceCount = sourceEndIndex - sourceIndex;
         if (sourceCount <= 0)
         {
@@ -491,7 +459,7 @@ namespace
             {
                 return false;
             }
-            rawInsertIndex = subtreeEndIndexExclusive(items, targetIndex);
+            rawInsertIndex = subtreeEndIndexExclusive(tree, targetIndex);
             newBaseDepth = items.at(targetIndex).depth;
             break;
         case FolderDropPlacement::Child:
@@ -503,7 +471,7 @@ namespace
             {
                 return false;
             }
-            rawInsertIndex = subtreeEndIndexExclusive(items, targetIndex);
+            rawInsertIndex = subtreeEndIndexExclusive(tree, targetIndex);
             newBaseDepth = items.at(targetIndex).depth + 1;
             break;
         }
@@ -536,30 +504,20 @@ namespace
         int sourceIndex,
         const FolderMoveOperation& operation)
     {
-        const int depthDelta = operation.newBaseDepth - items.at(sourceIndex).depth;
-
-        QVector<ProjectsHierarchyItem> movedItems;
-        movedItems.reserve(operation.sourceCount);
-        for (int index = sourceIndex; index < operation.sourceEndIndex; ++index)
-        {
-            ProjectsHierarchyItem item = items.at(index);
-            item.depth = std::max(0, item.depth + depthDelta);
-            movedItems.push_back(std::move(item));
-        }
-
         QVector<ProjectsHierarchyItem> stagedItems = items;
-        stagedItems.remove(sourceIndex, operation.sourceCount);
-        for (int offset = 0; offset < movedItems.size(); ++offset)
-        {
-            stagedItems.insert(operation.normalizedInsertIndex + offset, std::move(movedItems[offset]));
-        }
-
+        WhatSon::Hierarchy::TreeItemSupport::moveHierarchySubtree(
+            &stagedItems,
+            sourceIndex,
+            operation.sourceCount,
+            operation.normalizedInsertIndex,
+            operation.newBaseDepth);
         finalizeProjectItems(&stagedItems);
         return stagedItems;
     }
 
     bool resolveFolderMoveOperationFromLvrsMoveEvent(
         const QVector<ProjectsHierarchyItem>& items,
+        const ProjectsHierarchyTree& tree,
         int sourceIndex,
         int targetIndex,
         int targetDepth,
@@ -570,29 +528,33 @@ namespace
             return false;
         }
 
-        const int sourceEndIndex = subtreeEndIndexExclusive(items, sourceIndex);
+        const int sourceEndIndex = subtreeEndIndexExclusive(tree, sourceIndex);
         const int sourceCount = sourceEndIndex - sourceIndex;
         if (sourceCount <= 0)
         {
             return false;
         }
 
-        QVector<ProjectsHierarchyItem> remainingItems = items;
-        remainingItems.remove(sourceIndex, sourceCount);
+        // Reads the rows as they would be with the moved subtree taken out, without copying the vector.
+        const auto remainingItemAt = [&items, sourceIndex, sourceCount](int index) -> const ProjectsHierarchyItem&
+        {
+            return items.at(index < sourceIndex ? index : index + sourceCount);
+        };
+        const int remainingCount = static_cast<int>(items.size()) - sourceCount;
 
         const int firstEditableIndex = firstEditableInsertIndex(items);
-        const int maxInsertIndex = std::max(0, static_cast<int>(remainingItems.size()));
+        const int maxInsertIndex = std::max(0, remainingCount);
         int normalizedInsertIndex = std::clamp(targetIndex, 0, maxInsertIndex);
         normalizedInsertIndex = std::max(normalizedInsertIndex, firstEditableIndex);
 
-        int minDepth = normalizedInsertIndex < remainingItems.size()
-            ? std::max(0, remainingItems.at(normalizedInsertIndex).depth)
+        int minDepth = normalizedInsertIndex < remainingCount
+            ? std::max(0, remainingItemAt(normalizedInsertIndex).depth)
             : 0;
         int maxDepth = normalizedInsertIndex > 0
-            ? std::max(0, remainingItems.at(normalizedInsertIndex - 1).depth + 1)
+            ? std::max(0, remainingItemAt(normalizedInsertIndex - 1).depth + 1)
             : 0;
         if (normalizedInsertIndex <= firstEditableIndex
-            || (normalizedInsertIndex > 0 && isProtectedRootItem(remainingItems.at(normalizedInsertIndex - 1))))
+            || (normalizedInsertIndex > 0 && isProtectedRootItem(remainingItemAt(normalizedInsertIndex - 1))))
         {
             minDepth = 0;
             maxDepth = 0;
@@ -625,6 +587,14 @@ ProjectsHierarchyController::ProjectsHierarchyController(QObject* parent)
 {
     WhatSon::Debug::traceSelf(this, QString::fromLatin1(kScope), QStringLiteral("ctor"));
     initializeHierarchyInterfaceSignalBridge();
+    WhatSonMemoryAccounting::shared().track(
+        this,
+        QStringLiteral("projects"),
+        QStringLiteral("allNotes"),
+        [this](WhatSonMemoryEstimate& estimate)
+        {
+            m_libraryAll.accountMemory(estimate);
+        });
     QObject::connect(
         &m_itemModel,
         &WhatSonHierarchyModel::itemCountChanged,
@@ -662,7 +632,7 @@ QString ProjectsHierarchyController::noteDirectoryPathForNoteId(const QString& n
         return {};
     }
 
-    return WhatSon::Hierarchy::NoteRecordSupport::directoryPathForNoteId(m_allNotes, normalizedNoteId);
+    return WhatSon::Hierarchy::NoteRecordSupport::directoryPathForNoteId(m_libraryAll.notes(), normalizedNoteId);
 }
 
 int ProjectsHierarchyController::selectedIndex() const noexcept
@@ -733,7 +703,7 @@ QVariantList ProjectsHierarchyController::depthItems() const
     for (int index = 0; index < serialized.size() && index < m_items.size(); ++index)
     {
         QVariantMap entry = serialized.at(index).toMap();
-        const int noteCount = std::max(0, noteCountForProjectItem(m_allNotes, m_items, index));
+        const int noteCount = std::max(0, noteCountForProjectItem(m_libraryAll, m_items, index));
         entry.insert(QStringLiteral("draggable"), canMoveFolder(index));
         entry.insert(QStringLiteral("itemId"), index);
         entry.insert(QStringLiteral("key"), projectsHierarchyItemKey(m_items, index));
@@ -796,6 +766,7 @@ bool ProjectsHierarchyController::renameItem(int index, const QString& displayNa
 
     if (!m_projectsFilePath.trimmed().isEmpty())
     {
+        WhatSonHubMutationJournal::Scope journalScope(m_projectsFilePath, QStringLiteral("Rename project"));
         QString writeError;
         if (!stagedStore.writeToFile(m_projectsFilePath, &writeError))
         {
@@ -806,6 +777,7 @@ bool ProjectsHierarchyController::renameItem(int index, const QString& displayNa
                                           m_projectsFilePath, writeError));
             return false;
         }
+        journalScope.commit();
     }
 
     m_items = std::move(stagedItems);
@@ -861,7 +833,10 @@ void ProjectsHierarchyController::createFolder()
 
     QVector<ProjectsHierarchyItem> stagedItems = m_items;
     const int insertIndex = WhatSon::Hierarchy::ProjectsSupport::createHierarchyFolder(
-        &stagedItems, m_selectedIndex, &m_createdFolderSequence);
+        &stagedItems,
+        m_selectedIndex,
+        &m_createdFolderSequence,
+        m_hierarchyTree.subtreeEndFlatIndex(m_selectedIndex));
     if (insertIndex < 0)
     {
         WhatSon::Debug::traceSelf(this,
@@ -898,8 +873,10 @@ void ProjectsHierarchyController::deleteSelectedFolder()
     }
 
     QVector<ProjectsHierarchyItem> stagedItems = m_items;
-    const int nextSelectedIndex =
-        WhatSon::Hierarchy::ProjectsSupport::deleteHierarchySubtree(&stagedItems, m_selectedIndex);
+    const int nextSelectedIndex = WhatSon::Hierarchy::ProjectsSupport::deleteHierarchySubtree(
+        &stagedItems,
+        m_selectedIndex,
+        m_hierarchyTree.subtreeEndFlatIndex(m_selectedIndex));
     if (!commitHierarchyUpdate(std::move(stagedItems), nextSelectedIndex))
     {
         return;
@@ -920,6 +897,7 @@ bool ProjectsHierarchyController::canAcceptFolderDropBefore(int sourceIndex, int
 {
     return resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         targetIndex,
         FolderDropPlacement::Before,
@@ -936,6 +914,7 @@ bool ProjectsHierarchyController::moveFolderBefore(int sourceIndex, int targetIn
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         targetIndex,
         FolderDropPlacement::Before,
@@ -957,6 +936,7 @@ bool ProjectsHierarchyController::canAcceptFolderDrop(int sourceIndex, int targe
 {
     return resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         targetIndex,
         asChild ? FolderDropPlacement::Child : FolderDropPlacement::After,
@@ -975,6 +955,7 @@ bool ProjectsHierarchyController::moveFolder(int sourceIndex, int targetIndex, b
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         targetIndex,
         asChild ? FolderDropPlacement::Child : FolderDropPlacement::After,
@@ -999,6 +980,7 @@ bool ProjectsHierarchyController::canMoveFolderToRoot(int sourceIndex) const
 {
     return resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         -1,
         FolderDropPlacement::RootTop,
@@ -1015,6 +997,7 @@ bool ProjectsHierarchyController::moveFolderToRoot(int sourceIndex)
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperation(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         -1,
         FolderDropPlacement::RootTop,
@@ -1080,6 +1063,7 @@ bool ProjectsHierarchyController::applyHierarchyMove(
     FolderMoveOperation operation;
     if (!resolveFolderMoveOperationFromLvrsMoveEvent(
         m_items,
+        m_hierarchyTree,
         sourceIndex,
         targetIndex,
         targetDepth,
@@ -1109,7 +1093,7 @@ void ProjectsHierarchyController::setProjectNames(QStringList projectNames)
         QStringLiteral("Projects"),
         m_projectNames,
         QStringLiteral("Project"));
-    m_createdFolderSequence = WhatSon::Hierarchy::ProjectsSupport::nextGeneratedFolderSequence(m_items);
+    m_createdFolderSequence = 1;
     syncModel();
     setSelectedIndex(-1);
     WhatSon::Debug::traceSelf(this,
@@ -1241,7 +1225,7 @@ bool ProjectsHierarchyController::loadFromWshub(const QString& wshubPath, QStrin
         m_store.setFolderEntries(std::move(aggregatedEntries));
         m_projectNames = m_store.projectNames();
         m_items = itemsFromProjectEntries(m_store.folderEntries());
-        m_createdFolderSequence = WhatSon::Hierarchy::ProjectsSupport::nextGeneratedFolderSequence(m_items);
+        m_createdFolderSequence = 1;
         syncModel();
         setSelectedIndex(-1);
     }
@@ -1288,6 +1272,51 @@ void ProjectsHierarchyController::applyRuntimeSnapshot(
     QString projectsFilePath,
     bool loadSucceeded,
     QString errorMessage)
+{
+    if (!applyProjectEntries(
+        std::move(projectEntries),
+        std::move(projectsFilePath),
+        loadSucceeded,
+        std::move(errorMessage)))
+    {
+        return;
+    }
+
+    QString noteLoadError;
+    if (!refreshIndexedNotesFromProjectsFilePath(&noteLoadError))
+    {
+        updateLoadState(false, noteLoadError);
+        return;
+    }
+
+    updateLoadState(true);
+}
+
+void ProjectsHierarchyController::applyRuntimeSnapshot(
+    QVector<WhatSonFolderDepthEntry> projectEntries,
+    QString projectsFilePath,
+    QVector<LibraryNoteRecord> indexedNotes,
+    bool loadSucceeded,
+    QString errorMessage)
+{
+    if (!applyProjectEntries(
+        std::move(projectEntries),
+        std::move(projectsFilePath),
+        loadSucceeded,
+        std::move(errorMessage)))
+    {
+        return;
+    }
+
+    applyIndexedNotes(resolveWshubPathFromProjectsFile(m_projectsFilePath), std::move(indexedNotes));
+    updateLoadState(true);
+}
+
+bool ProjectsHierarchyController::applyProjectEntries(
+    QVector<WhatSonFolderDepthEntry> projectEntries,
+    QString projectsFilePath,
+    bool loadSucceeded,
+    QString errorMessage)
 {
     const QString preservedSelectionKey =
         (m_selectedIndex >= 0 && m_selectedIndex < m_items.size())
@@ -1298,7 +1327,7 @@ void ProjectsHierarchyController::applyRuntimeSnapshot(
     if (!loadSucceeded)
     {
         updateLoadState(false, std::move(errorMessage));
-        return;
+        return false;
     }
 
     if (!folderDepthEntriesEqual(projectEntriesFromItems(m_items), projectEntries))
@@ -1317,20 +1346,12 @@ void ProjectsHierarchyController::applyRuntimeSnapshot(
             m_store.setFolderEntries(projectEntries);
             m_projectNames = m_store.projectNames();
             m_items = itemsFromProjectEntries(m_store.folderEntries());
-            m_createdFolderSequence = WhatSon::Hierarchy::ProjectsSupport::nextGeneratedFolderSequence(m_items);
+            m_createdFolderSequence = 1;
             syncModel();
             setSelectedIndex(selectedProjectIndexForKey(m_items, preservedSelectionKey));
         }
     }
-
-    QString noteLoadError;
-    if (!refreshIndexedNotesFromProjectsFilePath(&noteLoadError))
-    {
-        updateLoadState(false, noteLoadError);
-        return;
-    }
-
-    updateLoadState(true);
+    return true;
 }
 
 void ProjectsHierarchyController::requestControllerHook()
@@ -1379,6 +1400,8 @@ void ProjectsHierarchyController::updateLoadState(bool succeeded, QString errorM
 
 void ProjectsHierarchyController::syncModel()
 {
+    m_hierarchyTree.assign(m_items);
+    m_createdFolderSequence = std::max(m_createdFolderSequence, m_hierarchyTree.nextFolderSequence());
     m_itemModel.setItems(depthItems());
     updateItemCount();
     emit hierarchyModelChanged();
@@ -1394,6 +1417,7 @@ bool ProjectsHierarchyController::commitHierarchyUpdate(QVector<ProjectsHierarch
 
     if (!m_projectsFilePath.trimmed().isEmpty())
     {
+        WhatSonHubMutationJournal::Scope journalScope(m_projectsFilePath, QStringLiteral("Edit projects"));
         QString writeError;
         if (!stagedStore.writeToFile(m_projectsFilePath, &writeError))
         {
@@ -1403,12 +1427,12 @@ bool ProjectsHierarchyController::commitHierarchyUpdate(QVector<ProjectsHierarch
                                       QStringLiteral("path=%1 reason=%2").arg(m_projectsFilePath, writeError));
             return false;
         }
+        journalScope.commit();
     }
 
     m_items = std::move(stagedItems);
     m_store = std::move(stagedStore);
     m_projectNames = m_store.projectNames();
-    m_createdFolderSequence = WhatSon::Hierarchy::ProjectsSupport::nextGeneratedFolderSequence(m_items);
     syncModel();
     setSelectedIndex(selectedIndex);
     return true;
@@ -1439,15 +1463,17 @@ LibraryNoteListItem ProjectsHierarchyController::buildNoteListItem(const Library
     item.tags = noteListTags(note);
     item.bookmarked = note.bookmarked;
     item.bookmarkColor = bookmarkColorHexFromNote(note);
-    return item;
+    return LibraryNoteListModel::normalizedItem(std::move(item));
 }
 
 void ProjectsHierarchyController::refreshNoteListForSelection(const bool synchronizeProjectHeaders)
 {
     Q_UNUSED(synchronizeProjectHeaders)
 
-    QSet<QString> availableProjectKeys;
-    availableProjectKeys.reserve(m_items.size() * 2);
+    constexpr auto kProject = WhatSonHubSymbolTable::Kind::Project;
+    const WhatSonHubSymbolTable& symbols = m_libraryAll.symbols();
+    QSet<int> availableProjectSymbols;
+    availableProjectSymbols.reserve(m_items.size() * 2);
     for (int index = 0; index < m_items.size(); ++index)
     {
         const ProjectsHierarchyItem& item = m_items.at(index);
@@ -1462,34 +1488,37 @@ void ProjectsHierarchyController::refreshNoteListForSelection(const bool synchro
             continue;
         }
 
-        availableProjectKeys.insert(label.toCaseFolded());
-        availableProjectKeys.insert(projectsHierarchyItemKey(m_items, index).toCaseFolded());
+        availableProjectSymbols.insert(symbols.find(kProject, label));
+        availableProjectSymbols.insert(symbols.find(kProject, projectsHierarchyItemKey(m_items, index)));
     }
+    availableProjectSymbols.remove(WhatSonHubSymbolTable::kNoSymbol);
 
-    QVector<LibraryNoteListItem> items;
-    items.reserve(m_allNotes.size());
-    for (const LibraryNoteRecord& note : std::as_const(m_allNotes))
+    const bool hasSelection = m_selectedIndex >= 0 && m_selectedIndex < m_items.size();
+    QSet<int> selectedProjectSymbols;
+    if (hasSelection)
     {
-        const QString projectLabel = note.project.trimmed();
-        if (projectLabel.isEmpty())
-        {
-            continue;
-        }
+        selectedProjectSymbols.insert(symbols.find(kProject, m_items.at(m_selectedIndex).label));
+        selectedProjectSymbols.insert(symbols.find(kProject, projectsHierarchyItemKey(m_items, m_selectedIndex)));
+        selectedProjectSymbols.remove(WhatSonHubSymbolTable::kNoSymbol);
+    }
 
-        const QString normalizedProjectLabel = projectLabel.toCaseFolded();
-        if (!availableProjectKeys.contains(normalizedProjectLabel))
+    const QVector<LibraryNoteRecord>& notes = m_libraryAll.notes();
+    QVector<LibraryNoteListItem> items;
+    items.reserve(notes.size());
+    for (int row = 0; row < notes.size(); ++row)
+    {
+        const QVector<int>& projectSymbols = m_libraryAll.facetSymbolsForRow(kProject, row);
+        if (projectSymbols.isEmpty() || !availableProjectSymbols.contains(projectSymbols.constFirst()))
         {
             continue;
         }
 
-        if (m_selectedIndex >= 0
-            && m_selectedIndex < m_items.size()
-            && !projectValueMatchesHierarchyItem(projectLabel, m_items, m_selectedIndex))
+        if (hasSelection && !selectedProjectSymbols.contains(projectSymbols.constFirst()))
         {
             continue;
         }
 
-        items.push_back(buildNoteListItem(note));
+        items.push_back(buildNoteListItem(notes.at(row)));
     }
 
     m_noteListModel.setItems(std::move(items));
@@ -1500,16 +1529,21 @@ bool ProjectsHierarchyController::refreshIndexedNotesFromWshub(const QString& ws
     LibraryAll libraryAll;
     if (!libraryAll.indexFromWshub(wshubPath, errorMessage))
     {
-        m_allNotes.clear();
+        m_libraryAll.clear();
         m_noteListModel.setItems({});
         emit hierarchyModelChanged();
         return false;
     }
 
-    m_allNotes = libraryAll.notes();
+    applyIndexedNotes(libraryAll.sourceWshubPath(), libraryAll.notes());
+    return true;
+}
+
+void ProjectsHierarchyController::applyIndexedNotes(QString wshubPath, QVector<LibraryNoteRecord> notes)
+{
+    m_libraryAll.setIndexedNotes(std::move(wshubPath), std::move(notes));
     refreshNoteListForSelection();
     emit hierarchyModelChanged();
-    return true;
 }
 
 bool ProjectsHierarchyController::refreshIndexedNotesFromProjectsFilePath(QString* errorMessage)
@@ -1521,7 +1555,7 @@ bool ProjectsHierarchyController::refreshIndexedNotesFromProjectsFilePath(QStrin
         {
             *errorMessage = QStringLiteral("Failed to resolve .wshub path from ProjectLists.wsproj.");
         }
-        m_allNotes.clear();
+        m_libraryAll.clear();
         m_noteListModel.setItems({});
         emit hierarchyModelChanged();
         return false;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "app/models/hierarchy/library/LibraryAll.hpp"
 #include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
 #include "app/models/hierarchy/projects/WhatSonProjectsHierarchyStore.hpp"
 #include "app/models/hierarchy/IHierarchyCapabilities.hpp"
@@ -7,6 +8,7 @@
 #include "app/models/hierarchy/library/LibraryNoteListModel.hpp"
 #include "app/models/hierarchy/projects/ProjectsHierarchyModel.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyModel.hpp"
+#include "app/models/hierarchy/WhatSonHierarchyTree.hpp"
 
 #include <QStringList>
 #include <QVariantList>
@@ -85,6 +87,13 @@ public:
         QString projectsFilePath,
         bool loadSucceeded,
         QString errorMessage = QString());
+    // Same as above, with the notes the runtime loader already indexed for the library instead of a fresh hub walk.
+    void applyRuntimeSnapshot(
+        QVector<WhatSonFolderDepthEntry> projectEntries,
+        QString projectsFilePath,
+        QVector<LibraryNoteRecord> indexedNotes,
+        bool loadSucceeded,
+        QString errorMessage = QString());
 
 public
     slots  :
@@ -112,16 +121,24 @@ private:
     void refreshNoteListForSelection(bool synchronizeProjectHeaders = true);
     bool refreshIndexedNotesFromWshub(const QString& wshubPath, QString* errorMessage = nullptr);
     bool refreshIndexedNotesFromProjectsFilePath(QString* errorMessage = nullptr);
+    void applyIndexedNotes(QString wshubPath, QVector<LibraryNoteRecord> notes);
+    bool applyProjectEntries(
+        QVector<WhatSonFolderDepthEntry> projectEntries,
+        QString projectsFilePath,
+        bool loadSucceeded,
+        QString errorMessage);
     void syncModel();
     bool commitHierarchyUpdate(QVector<ProjectsHierarchyItem> stagedItems, int selectedIndex);
     void syncDomainStoreFromItems();
 
     QStringList m_projectNames;
     QVector<ProjectsHierarchyItem> m_items;
+    WhatSon::Hierarchy::HierarchyTree<ProjectsHierarchyItem> m_hierarchyTree;
     WhatSonProjectsHierarchyStore m_store;
     WhatSonHierarchyModel m_itemModel;
     LibraryNoteListModel m_noteListModel;
-    QVector<LibraryNoteRecord> m_allNotes;
+    // Project counts and selection filtering read its project facet instead of rescanning the notes.
+    LibraryAll m_libraryAll;
     int m_selectedIndex = -1;
     int m_createdFolderSequence = 1;
     int m_itemCount = 0;
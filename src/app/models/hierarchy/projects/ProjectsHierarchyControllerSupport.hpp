@@ -20,7 +20,7 @@ namespace WhatSon::Hierarchy::ProjectsSupport
     using WhatSon::Hierarchy::TreeItemSupport::applyChevronByDepth;
     using WhatSon::Hierarchy::TreeItemSupport::deleteHierarchySubtree;
     using WhatSon::Hierarchy::TreeItemSupport::isBucketHeaderItem;
-    using WhatSon::Hierarchy::TreeItemSupport::nextGeneratedFolderSequence;
+    using WhatSon::Hierarchy::TreeItemSupport::observeGeneratedFolderSequence;
     using WhatSon::Hierarchy::TreeItemSupport::renameHierarchyItem;
 
     inline QStringList sanitizeStringList(QStringList values)
@@ -175,13 +175,18 @@ namespace WhatSon::Hierarchy::ProjectsSupport
         return items;
     }
 
-    inline int createHierarchyFolder(QVector<ProjectsHierarchyItem>* items, int selectedIndex, int* ioFolderSequence)
+    inline int createHierarchyFolder(
+        QVector<ProjectsHierarchyItem>* items,
+        int selectedIndex,
+        int* ioFolderSequence,
+        int selectedSubtreeEndIndex = -1)
     {
         return WhatSon::Hierarchy::TreeItemSupport::createNestedHierarchyFolder(
             items,
             selectedIndex,
             ioFolderSequence,
-            true);
+            true,
+            selectedSubtreeEndIndex);
     }
 
     inline QStringList extractDomainLabelsFromItems(const QVector<ProjectsHierarchyItem>& items)
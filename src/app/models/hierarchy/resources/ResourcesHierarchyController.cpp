@@ -1,6 +1,7 @@
 #include "app/models/hierarchy/resources/ResourcesHierarchyController.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
 #include "app/models/hierarchy/resources/WhatSonResourcePackageSupport.hpp"
 #include "app/models/hierarchy/resources/WhatSonResourcesHierarchyParser.hpp"
 #include "app/models/hierarchy/resources/WhatSonResourcesHierarchyStore.hpp"
@@ -44,14 +45,9 @@ namespace
         return {};
     }
 
-    QString encodeXmlAttributeValue(QString value)
+    QString encodeXmlAttributeValue(const QString& value)
     {
-        value.replace(QStringLiteral("&"), QStringLiteral("&amp;"));
-        value.replace(QStringLiteral("\""), QStringLiteral("&quot;"));
-        value.replace(QStringLiteral("'"), QStringLiteral("&apos;"));
-        value.replace(QStringLiteral("<"), QStringLiteral("&lt;"));
-        value.replace(QStringLiteral(">"), QStringLiteral("&gt;"));
-        return value;
+        return WhatSon::XmlEntities::encode(value);
     }
 
     QString normalizeSourceUrl(const QString& resolvedAssetPath)
@@ -290,6 +286,7 @@ namespace
             listItem.image = imageResource;
             listItem.imageSource = imageResource ? sourceUrl : QString();
             listItem.displayDate = WhatSon::Resources::normalizeBucket(materialized.metadata.bucket).trimmed();
+            listItem.bucket = listItem.displayDate;
             listItem.folders = {
                 WhatSon::Hierarchy::ResourcesSupport::displayLabelForTypeKey(typeKey)
             };
@@ -0,0 +1,532 @@
+#include "app/models/hierarchy/resources/ResourcesListIndex.hpp"
+
+#include "app/models/hierarchy/resources/ResourcesListModel.hpp"
+
+#include <QFileInfo>
+#include <QMimeDatabase>
+#include <QMimeType>
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+namespace
+{
+    QString bucketForItem(const ResourcesListItem& item)
+    {
+        const QString bucket = item.bucket.trimmed();
+        return bucket.isEmpty() ? item.displayDate.trimmed() : bucket;
+    }
+
+    QString fileNameForItem(const ResourcesListItem& item)
+    {
+        for (const QString& candidate : {item.resolvedPath, item.resourcePath})
+        {
+            const QString fileName = QFileInfo(candidate.trimmed()).fileName().trimmed();
+            if (!fileName.isEmpty())
+            {
+                return fileName;
+            }
+        }
+        return item.displayName.trimmed().isEmpty() ? item.primaryText.trimmed() : item.displayName.trimmed();
+    }
+
+    QVector<int> intersectSorted(const QVector<int>& lhs, const QVector<int>& rhs)
+    {
+        QVector<int> intersection;
+        intersection.reserve(std::min(lhs.size(), rhs.size()));
+        std::set_intersection(
+            lhs.cbegin(),
+            lhs.cend(),
+            rhs.cbegin(),
+            rhs.cend(),
+            std::back_inserter(intersection));
+        return intersection;
+    }
+
+    void sortUnique(QVector<int>& rows)
+    {
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    }
+
+    void insertPosting(QVector<int>& posting, const int slot)
+    {
+        const auto it = std::lower_bound(posting.begin(), posting.end(), slot);
+        if (it == posting.end() || *it != slot)
+        {
+            posting.insert(it, slot);
+        }
+    }
+
+    template <typename Postings>
+    void erasePosting(Postings& postings, const QString& key, const int slot)
+    {
+        const auto postingIt = postings.find(key);
+        if (postingIt == postings.end())
+        {
+            return;
+        }
+
+        QVector<int>& posting = postingIt.value();
+        const auto it = std::lower_bound(posting.begin(), posting.end(), slot);
+        if (it != posting.end() && *it == slot)
+        {
+            posting.erase(it);
+        }
+        if (posting.isEmpty())
+        {
+            postings.erase(postingIt);
+        }
+    }
+
+    QVariantMap countsToVariantMap(const QHash<QString, QVector<int>>& postings)
+    {
+        QVariantMap counts;
+        for (auto it = postings.cbegin(); it != postings.cend(); ++it)
+        {
+            counts.insert(it.key(), static_cast<int>(it.value().size()));
+        }
+        return counts;
+    }
+} // namespace
+
+void ResourcesListIndex::sync(const QVector<ResourcesListItem>& items)
+{
+    std::fill(m_rowBySlot.begin(), m_rowBySlot.end(), -1);
+    m_slotByRow.clear();
+    m_slotByRow.reserve(items.size());
+
+    QSet<QString> seenKeys;
+    seenKeys.reserve(items.size());
+    for (int row = 0; row < items.size(); ++row)
+    {
+        const ResourcesListItem& item = items.at(row);
+        QString key = item.id;
+        if (key.isEmpty() || seenKeys.contains(key))
+        {
+            key = QStringLiteral("%1#row%2").arg(key).arg(row);
+        }
+        seenKeys.insert(key);
+
+        const int slot = upsertSlot(key, item);
+        m_rowBySlot[slot] = row;
+        m_slotByRow.push_back(slot);
+    }
+
+    for (int slot = 0; slot < m_entries.size(); ++slot)
+    {
+        if (m_entries.at(slot).live && m_rowBySlot.at(slot) < 0)
+        {
+            removeSlot(slot);
+        }
+    }
+}
+
+void ResourcesListIndex::upsert(const ResourcesListItem& item)
+{
+    if (item.id.isEmpty())
+    {
+        return;
+    }
+
+    const bool known = m_slotByKey.contains(item.id);
+    const int slot = upsertSlot(item.id, item);
+    if (!known)
+    {
+        m_rowBySlot[slot] = static_cast<int>(m_slotByRow.size());
+        m_slotByRow.push_back(slot);
+    }
+}
+
+bool ResourcesListIndex::remove(const QString& resourceId)
+{
+    const int slot = m_slotByKey.value(resourceId, -1);
+    if (slot < 0)
+    {
+        return false;
+    }
+
+    const int row = m_rowBySlot.at(slot);
+    removeSlot(slot);
+    if (row >= 0)
+    {
+        m_slotByRow.remove(row);
+        for (int nextRow = row; nextRow < m_slotByRow.size(); ++nextRow)
+        {
+            m_rowBySlot[m_slotByRow.at(nextRow)] = nextRow;
+        }
+    }
+    return true;
+}
+
+void ResourcesListIndex::clear()
+{
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_slotByKey.clear();
+    m_slotByRow.clear();
+    m_rowBySlot.clear();
+    m_typePostings.clear();
+    m_bucketPostings.clear();
+    m_formatPostings.clear();
+    m_mimePostings.clear();
+    m_tokenPostings.clear();
+    m_mimeByFormat.clear();
+}
+
+int ResourcesListIndex::rowCount() const noexcept
+{
+    return static_cast<int>(m_slotByRow.size());
+}
+
+QVector<int> ResourcesListIndex::query(const ResourcesListFacetFilter& filter, const QStringList& prefixTerms) const
+{
+    const std::pair<Facet, QString> facetConstraints[] = {
+        {Facet::Type, normalizedFacetKey(filter.type)},
+        {Facet::Bucket, normalizedFacetKey(filter.bucket)},
+        {Facet::Format, normalizedFacetKey(filter.format)},
+        {Facet::Mime, normalizedFacetKey(filter.mime)}
+    };
+
+    QVector<const Posting*> postings;
+    for (const auto& [facet, key] : facetConstraints)
+    {
+        if (key.isEmpty())
+        {
+            continue;
+        }
+        const QHash<QString, Posting>& facetPostings = postingsForFacet(facet);
+        const auto postingIt = facetPostings.constFind(key);
+        if (postingIt == facetPostings.cend())
+        {
+            return {};
+        }
+        postings.push_back(&postingIt.value());
+    }
+    std::sort(
+        postings.begin(),
+        postings.end(),
+        [](const Posting* lhs, const Posting* rhs)
+        {
+            return lhs->size() < rhs->size();
+        });
+
+    bool constrained = false;
+    QVector<int> rows;
+    for (const Posting* posting : std::as_const(postings))
+    {
+        rows = constrained ? intersectSorted(rows, *posting) : *posting;
+        constrained = true;
+        if (rows.isEmpty())
+        {
+            return rows;
+        }
+    }
+
+    for (const QString& term : prefixTerms)
+    {
+        const QString normalizedTerm = term.trimmed().toCaseFolded();
+        if (normalizedTerm.isEmpty())
+        {
+            continue;
+        }
+
+        // Every token that contains the term, which covers the prefix matches as well, so a new prefix hit never
+        // hides an older mid-word one.
+        QVector<int> termRows = slotsForSubstring(normalizedTerm);
+        const QStringList subTokens = tokensForText(normalizedTerm);
+        if (subTokens.size() > 1 || (subTokens.size() == 1 && subTokens.constFirst() != normalizedTerm))
+        {
+            QVector<int> subTokenRows;
+            bool firstSubToken = true;
+            for (const QString& subToken : subTokens)
+            {
+                const QVector<int> prefixRows = slotsForPrefix(subToken);
+                subTokenRows = firstSubToken ? prefixRows : intersectSorted(subTokenRows, prefixRows);
+                firstSubToken = false;
+                if (subTokenRows.isEmpty())
+                {
+                    break;
+                }
+            }
+            termRows += subTokenRows;
+            sortUnique(termRows);
+        }
+
+        rows = constrained ? intersectSorted(rows, termRows) : termRows;
+        constrained = true;
+        if (rows.isEmpty())
+        {
+            return rows;
+        }
+    }
+
+    if (!constrained)
+    {
+        rows.resize(m_slotByRow.size());
+        std::iota(rows.begin(), rows.end(), 0);
+        return rows;
+    }
+
+    // Postings are in slot space; hand back source rows in ascending order.
+    for (int& row : rows)
+    {
+        row = m_rowBySlot.at(row);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+int ResourcesListIndex::facetCount(const Facet facet, const QString& key) const
+{
+    return static_cast<int>(postingsForFacet(facet).value(normalizedFacetKey(key)).size());
+}
+
+QHash<QString, int> ResourcesListIndex::facetCounts(const Facet facet) const
+{
+    const QHash<QString, Posting>& postings = postingsForFacet(facet);
+    QHash<QString, int> counts;
+    counts.reserve(postings.size());
+    for (auto it = postings.cbegin(); it != postings.cend(); ++it)
+    {
+        counts.insert(it.key(), static_cast<int>(it.value().size()));
+    }
+    return counts;
+}
+
+QVariantMap ResourcesListIndex::facetCountsMap() const
+{
+    return {
+        {facetName(Facet::Type), countsToVariantMap(m_typePostings)},
+        {facetName(Facet::Bucket), countsToVariantMap(m_bucketPostings)},
+        {facetName(Facet::Format), countsToVariantMap(m_formatPostings)},
+        {facetName(Facet::Mime), countsToVariantMap(m_mimePostings)}
+    };
+}
+
+QString ResourcesListIndex::mimeAt(const int row) const
+{
+    if (row < 0 || row >= m_slotByRow.size())
+    {
+        return {};
+    }
+    return m_entries.at(m_slotByRow.at(row)).mime;
+}
+
+QString ResourcesListIndex::facetName(const Facet facet)
+{
+    switch (facet)
+    {
+    case Facet::Type:
+        return QStringLiteral("type");
+    case Facet::Bucket:
+        return QStringLiteral("bucket");
+    case Facet::Format:
+        return QStringLiteral("format");
+    case Facet::Mime:
+        return QStringLiteral("mime");
+    }
+    return {};
+}
+
+QString ResourcesListIndex::normalizedFacetKey(const QString& value)
+{
+    return value.trimmed().toCaseFolded();
+}
+
+QString ResourcesListIndex::mimeTypeForResource(const QString& format, const QString& fileName)
+{
+    static const QMimeDatabase mimeDatabase;
+    QString normalizedFormat = normalizedFacetKey(format);
+    if (!normalizedFormat.isEmpty() && !normalizedFormat.startsWith(QLatin1Char('.')))
+    {
+        normalizedFormat.prepend(QLatin1Char('.'));
+    }
+
+    const QString probeName = normalizedFormat.isEmpty() || normalizedFormat == QStringLiteral(".bin")
+                                  ? fileName.trimmed()
+                                  : QStringLiteral("resource%1").arg(normalizedFormat);
+    if (!probeName.isEmpty())
+    {
+        const QMimeType mimeType = mimeDatabase.mimeTypeForFile(probeName, QMimeDatabase::MatchExtension);
+        if (mimeType.isValid() && !mimeType.isDefault())
+        {
+            return mimeType.name();
+        }
+    }
+    return QStringLiteral("application/octet-stream");
+}
+
+QStringList ResourcesListIndex::tokensForText(const QString& text)
+{
+    QStringList tokens;
+    QString current;
+    for (const QChar character : text)
+    {
+        if (character.isLetterOrNumber())
+        {
+            current.append(character.toCaseFolded());
+            continue;
+        }
+        if (!current.isEmpty())
+        {
+            tokens.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty())
+    {
+        tokens.push_back(current);
+    }
+    return tokens;
+}
+
+const QHash<QString, ResourcesListIndex::Posting>& ResourcesListIndex::postingsForFacet(const Facet facet) const
+{
+    switch (facet)
+    {
+    case Facet::Type:
+        return m_typePostings;
+    case Facet::Bucket:
+        return m_bucketPostings;
+    case Facet::Format:
+        return m_formatPostings;
+    case Facet::Mime:
+        return m_mimePostings;
+    }
+    return m_typePostings;
+}
+
+QVector<int> ResourcesListIndex::slotsForPrefix(const QString& prefix) const
+{
+    QVector<int> matches;
+    for (auto it = m_tokenPostings.lowerBound(prefix);
+         it != m_tokenPostings.cend() && it.key().startsWith(prefix);
+         ++it)
+    {
+        matches += it.value();
+    }
+    sortUnique(matches);
+    return matches;
+}
+
+QVector<int> ResourcesListIndex::slotsForSubstring(const QString& term) const
+{
+    QVector<int> matches;
+    for (auto it = m_tokenPostings.cbegin(); it != m_tokenPostings.cend(); ++it)
+    {
+        if (it.key().contains(term))
+        {
+            matches += it.value();
+        }
+    }
+    sortUnique(matches);
+    return matches;
+}
+
+int ResourcesListIndex::upsertSlot(const QString& key, const ResourcesListItem& item)
+{
+    const QString fileName = fileNameForItem(item);
+    Entry entry;
+    entry.key = key;
+    entry.type = normalizedFacetKey(item.type);
+    entry.bucket = normalizedFacetKey(bucketForItem(item));
+    entry.format = normalizedFacetKey(item.format);
+    entry.tokenSource = item.searchableText + QLatin1Char('\n') + fileName.toCaseFolded();
+    entry.live = true;
+
+    int slot = m_slotByKey.value(key, -1);
+    if (slot >= 0)
+    {
+        const Entry& previous = m_entries.at(slot);
+        if (previous.type == entry.type
+            && previous.bucket == entry.bucket
+            && previous.format == entry.format
+            && previous.tokenSource == entry.tokenSource)
+        {
+            return slot;
+        }
+        removePostings(slot);
+    }
+
+    entry.mime = mimeFor(entry.format, fileName);
+    QStringList tokens = tokensForText(item.searchableText);
+    const QString foldedFileName = fileName.toCaseFolded();
+    if (!foldedFileName.isEmpty())
+    {
+        tokens.push_back(foldedFileName);
+        tokens.append(tokensForText(foldedFileName));
+    }
+    tokens.removeDuplicates();
+    entry.tokens = std::move(tokens);
+
+    if (slot < 0)
+    {
+        if (!m_freeSlots.isEmpty())
+        {
+            slot = m_freeSlots.takeLast();
+        }
+        else
+        {
+            slot = static_cast<int>(m_entries.size());
+            m_entries.push_back({});
+            m_rowBySlot.push_back(-1);
+        }
+        m_slotByKey.insert(key, slot);
+    }
+    m_entries[slot] = std::move(entry);
+    addPostings(slot);
+    return slot;
+}
+
+void ResourcesListIndex::removeSlot(const int slot)
+{
+    removePostings(slot);
+    m_slotByKey.remove(m_entries.at(slot).key);
+    m_entries[slot] = {};
+    m_rowBySlot[slot] = -1;
+    m_freeSlots.push_back(slot);
+}
+
+void ResourcesListIndex::addPostings(const int slot)
+{
+    const Entry& entry = m_entries.at(slot);
+    insertPosting(m_typePostings[entry.type], slot);
+    insertPosting(m_bucketPostings[entry.bucket], slot);
+    insertPosting(m_formatPostings[entry.format], slot);
+    insertPosting(m_mimePostings[entry.mime], slot);
+    for (const QString& token : entry.tokens)
+    {
+        insertPosting(m_tokenPostings[token], slot);
+    }
+}
+
+void ResourcesListIndex::removePostings(const int slot)
+{
+    const Entry& entry = m_entries.at(slot);
+    erasePosting(m_typePostings, entry.type, slot);
+    erasePosting(m_bucketPostings, entry.bucket, slot);
+    erasePosting(m_formatPostings, entry.format, slot);
+    erasePosting(m_mimePostings, entry.mime, slot);
+    for (const QString& token : entry.tokens)
+    {
+        erasePosting(m_tokenPostings, token, slot);
+    }
+}
+
+QString ResourcesListIndex::mimeFor(const QString& format, const QString& fileName)
+{
+    // Formats that do not name a type are probed by file name, so they cannot share one cache slot.
+    const QString mimeCacheKey = format.isEmpty() || format == QStringLiteral(".bin") || format == QStringLiteral("bin")
+                                     ? QStringLiteral("file:") + fileName.toCaseFolded()
+                                     : format;
+    auto mimeIt = m_mimeByFormat.constFind(mimeCacheKey);
+    if (mimeIt == m_mimeByFormat.cend())
+    {
+        mimeIt = m_mimeByFormat.insert(mimeCacheKey, mimeTypeForResource(format, fileName));
+    }
+    return mimeIt.value();
+}
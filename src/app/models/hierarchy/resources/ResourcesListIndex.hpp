@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+struct ResourcesListItem;
+
+struct ResourcesListFacetFilter
+{
+    QString type;
+    QString bucket;
+    QString format;
+    QString mime;
+
+    bool isEmpty() const noexcept
+    {
+        return type.isEmpty() && bucket.isEmpty() && format.isEmpty() && mime.isEmpty();
+    }
+};
+
+class ResourcesListIndex final
+{
+public:
+    enum class Facet
+    {
+        Type,
+        Bucket,
+        Format,
+        Mime
+    };
+
+    void sync(const QVector<ResourcesListItem>& items);
+    void upsert(const ResourcesListItem& item);
+    bool remove(const QString& resourceId);
+    void clear();
+
+    int rowCount() const noexcept;
+    QVector<int> query(const ResourcesListFacetFilter& filter, const QStringList& prefixTerms) const;
+
+    int facetCount(Facet facet, const QString& key) const;
+    QHash<QString, int> facetCounts(Facet facet) const;
+    QVariantMap facetCountsMap() const;
+    QString mimeAt(int row) const;
+
+    static QString facetName(Facet facet);
+    static QString normalizedFacetKey(const QString& value);
+    static QString mimeTypeForResource(const QString& format, const QString& fileName);
+    static QStringList tokensForText(const QString& text);
+
+private:
+    struct Entry
+    {
+        QString key;
+        QString type;
+        QString bucket;
+        QString format;
+        QString mime;
+        QString tokenSource;
+        QStringList tokens;
+        bool live = false;
+    };
+
+    // Postings hold ascending entry slots. Slots stay stable across sync(), upsert() and remove(), so a refresh only
+    // touches the postings of ids that were added, changed or dropped; rows are mapped from slots at query time.
+    using Posting = QVector<int>;
+
+    int upsertSlot(const QString& key, const ResourcesListItem& item);
+    void removeSlot(int slot);
+    void addPostings(int slot);
+    void removePostings(int slot);
+    QString mimeFor(const QString& format, const QString& fileName);
+    const QHash<QString, Posting>& postingsForFacet(Facet facet) const;
+    QVector<int> slotsForPrefix(const QString& prefix) const;
+    QVector<int> slotsForSubstring(const QString& term) const;
+
+    QVector<Entry> m_entries;
+    QVector<int> m_freeSlots;
+    QHash<QString, int> m_slotByKey;
+    QVector<int> m_slotByRow;
+    QVector<int> m_rowBySlot;
+    QHash<QString, Posting> m_typePostings;
+    QHash<QString, Posting> m_bucketPostings;
+    QHash<QString, Posting> m_formatPostings;
+    QHash<QString, Posting> m_mimePostings;
+    QMap<QString, Posting> m_tokenPostings;
+    QHash<QString, QString> m_mimeByFormat;
+};
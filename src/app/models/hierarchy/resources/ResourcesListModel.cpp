@@ -1,6 +1,7 @@
 #include "app/models/hierarchy/resources/ResourcesListModel.hpp"
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
+#include "app/models/file/viewer/WhatSonThumbnailCache.hpp"
 
 #include <QDir>
 #include <QFileInfo>
@@ -11,6 +12,7 @@
 namespace
 {
     const QRegularExpression kSearchWhitespacePattern(QStringLiteral("\\s+"));
+    constexpr int kMaximumKeyedDiffRuns = 64;
 
     QString normalizeSearchableText(QString value)
     {
@@ -127,6 +129,7 @@ namespace
             && lhs.searchableText == rhs.searchableText
             && lhs.bodyText == rhs.bodyText
             && lhs.displayDate == rhs.displayDate
+            && lhs.bucket == rhs.bucket
             && lhs.folders == rhs.folders
             && lhs.tags == rhs.tags
             && lhs.image == rhs.image
@@ -213,22 +216,18 @@ namespace
         return normalized.split(QLatin1Char(' '), Qt::SkipEmptyParts);
     }
 
-    bool itemMatchesSearch(const ResourcesListItem& item, const QStringList& terms)
+    bool hasUniqueIds(const QVector<ResourcesListItem>& items, QHash<QString, int>* indexById)
     {
-        if (terms.isEmpty())
-        {
-            return true;
-        }
-
-        const QString searchableText = item.searchableText.isEmpty()
-                                           ? normalizeSearchableText(fallbackSearchableText(item))
-                                           : item.searchableText;
-        for (const QString& term : terms)
+        indexById->clear();
+        indexById->reserve(items.size());
+        for (int index = 0; index < items.size(); ++index)
         {
-            if (!searchableText.contains(term))
+            const QString& id = items.at(index).id;
+            if (id.isEmpty() || indexById->contains(id))
             {
                 return false;
             }
+            indexById->insert(id, index);
         }
         return true;
     }
@@ -275,6 +274,8 @@ QVariant ResourcesListModel::data(const QModelIndex& index, int role) const
         return item.image;
     case ImageSourceRole:
         return item.imageSource;
+    case ThumbnailSourceRole:
+        return WhatSonThumbnailCache::thumbnailUrlForImageSource(item.imageSource);
     case DisplayDateRole:
         return item.displayDate;
     case FoldersRole:
@@ -315,6 +316,7 @@ QHash<int, QByteArray> ResourcesListModel::roleNames() const
         {BodyTextRole, "bodyText"},
         {ImageRole, "image"},
         {ImageSourceRole, "imageSource"},
+        {ThumbnailSourceRole, "thumbnailSource"},
         {DisplayDateRole, "displayDate"},
         {FoldersRole, "folders"},
         {TagsRole, "tags"},
@@ -410,6 +412,82 @@ void ResourcesListModel::setSearchText(const QString& text)
     emit searchTextChanged();
 }
 
+QString ResourcesListModel::typeFilter() const
+{
+    return m_facetFilter.type;
+}
+
+void ResourcesListModel::setTypeFilter(const QString& type)
+{
+    ResourcesListFacetFilter filter = m_facetFilter;
+    filter.type = type.trimmed();
+    applyFacetFilter(std::move(filter));
+}
+
+QString ResourcesListModel::bucketFilter() const
+{
+    return m_facetFilter.bucket;
+}
+
+void ResourcesListModel::setBucketFilter(const QString& bucket)
+{
+    ResourcesListFacetFilter filter = m_facetFilter;
+    filter.bucket = bucket.trimmed();
+    applyFacetFilter(std::move(filter));
+}
+
+QString ResourcesListModel::formatFilter() const
+{
+    return m_facetFilter.format;
+}
+
+void ResourcesListModel::setFormatFilter(const QString& format)
+{
+    ResourcesListFacetFilter filter = m_facetFilter;
+    filter.format = format.trimmed();
+    applyFacetFilter(std::move(filter));
+}
+
+QString ResourcesListModel::mimeFilter() const
+{
+    return m_facetFilter.mime;
+}
+
+void ResourcesListModel::setMimeFilter(const QString& mime)
+{
+    ResourcesListFacetFilter filter = m_facetFilter;
+    filter.mime = mime.trimmed();
+    applyFacetFilter(std::move(filter));
+}
+
+QVariantMap ResourcesListModel::facetCounts() const
+{
+    return m_index.facetCountsMap();
+}
+
+int ResourcesListModel::facetCount(const QString& facet, const QString& key) const
+{
+    const QString normalizedFacet = facet.trimmed().toCaseFolded();
+    for (const ResourcesListIndex::Facet candidate : {
+             ResourcesListIndex::Facet::Type,
+             ResourcesListIndex::Facet::Bucket,
+             ResourcesListIndex::Facet::Format,
+             ResourcesListIndex::Facet::Mime
+         })
+    {
+        if (ResourcesListIndex::facetName(candidate) == normalizedFacet)
+        {
+            return m_index.facetCount(candidate, key);
+        }
+    }
+    return 0;
+}
+
+void ResourcesListModel::clearFacetFilters()
+{
+    applyFacetFilter({});
+}
+
 void ResourcesListModel::setItems(QVector<ResourcesListItem> items)
 {
     QVector<ResourcesListItem> sanitized;
@@ -422,6 +500,7 @@ void ResourcesListModel::setItems(QVector<ResourcesListItem> items)
         item.primaryText = item.primaryText.trimmed();
         item.bodyText = item.bodyText;
         item.displayDate = item.displayDate.trimmed();
+        item.bucket = item.bucket.trimmed();
         item.folders = sanitizeMetadataList(std::move(item.folders));
         item.tags = sanitizeMetadataList(std::move(item.tags));
         item.imageSource = item.image ? normalizeImageSource(item.imageSource) : QString();
@@ -448,6 +527,8 @@ void ResourcesListModel::setItems(QVector<ResourcesListItem> items)
     }
 
     m_sourceItems = std::move(sanitized);
+    m_index.sync(m_sourceItems);
+    emit facetCountsChanged();
     applySearchFilter();
 }
 
@@ -465,26 +546,15 @@ void ResourcesListModel::applySearchFilter()
     const int previousCount = m_items.size();
     const QStringList terms = searchTerms(m_searchText);
 
+    const QVector<int> rows = m_index.query(m_facetFilter, terms);
     QVector<ResourcesListItem> filtered;
-    if (terms.isEmpty())
+    filtered.reserve(rows.size());
+    for (const int row : rows)
     {
-        filtered = m_sourceItems;
-    }
-    else
-    {
-        filtered.reserve(m_sourceItems.size());
-        for (const ResourcesListItem& item : std::as_const(m_sourceItems))
-        {
-            if (itemMatchesSearch(item, terms))
-            {
-                filtered.push_back(item);
-            }
-        }
+        filtered.push_back(m_sourceItems.at(row));
     }
 
-    beginResetModel();
-    m_items = std::move(filtered);
-    endResetModel();
+    replaceItemsByKey(std::move(filtered));
 
     int nextCurrentIndex = indexOfItemById(m_items, previousNoteId);
     if (nextCurrentIndex < 0 && previousIndex >= 0 && !m_items.isEmpty())
@@ -516,3 +586,134 @@ void ResourcesListModel::applySearchFilter()
     }
     emit itemsChanged();
 }
+
+void ResourcesListModel::applyFacetFilter(ResourcesListFacetFilter filter)
+{
+    if (filter.type == m_facetFilter.type
+        && filter.bucket == m_facetFilter.bucket
+        && filter.format == m_facetFilter.format
+        && filter.mime == m_facetFilter.mime)
+    {
+        return;
+    }
+
+    m_facetFilter = std::move(filter);
+    applySearchFilter();
+    emit facetFilterChanged();
+}
+
+void ResourcesListModel::replaceItemsByKey(QVector<ResourcesListItem> nextItems)
+{
+    QHash<QString, int> previousIndexById;
+    QHash<QString, int> nextIndexById;
+    bool keyedDiffAvailable = hasUniqueIds(m_items, &previousIndexById)
+        && hasUniqueIds(nextItems, &nextIndexById);
+
+    int lastRetainedIndex = -1;
+    for (int index = 0; keyedDiffAvailable && index < m_items.size(); ++index)
+    {
+        const int nextIndex = nextIndexById.value(m_items.at(index).id, -1);
+        if (nextIndex < 0)
+        {
+            continue;
+        }
+        if (nextIndex <= lastRetainedIndex)
+        {
+            keyedDiffAvailable = false;
+        }
+        lastRetainedIndex = nextIndex;
+    }
+
+    int structuralRunCount = 0;
+    for (int index = 0; keyedDiffAvailable && index < m_items.size(); ++index)
+    {
+        const bool removed = !nextIndexById.contains(m_items.at(index).id);
+        if (removed && (index == 0 || nextIndexById.contains(m_items.at(index - 1).id)))
+        {
+            ++structuralRunCount;
+        }
+    }
+    for (int index = 0; keyedDiffAvailable && index < nextItems.size(); ++index)
+    {
+        const bool inserted = !previousIndexById.contains(nextItems.at(index).id);
+        if (inserted && (index == 0 || previousIndexById.contains(nextItems.at(index - 1).id)))
+        {
+            ++structuralRunCount;
+        }
+    }
+    if (structuralRunCount > kMaximumKeyedDiffRuns)
+    {
+        keyedDiffAvailable = false;
+    }
+
+    if (!keyedDiffAvailable)
+    {
+        beginResetModel();
+        m_items = std::move(nextItems);
+        endResetModel();
+        return;
+    }
+
+    for (int index = static_cast<int>(m_items.size()) - 1; index >= 0;)
+    {
+        if (nextIndexById.contains(m_items.at(index).id))
+        {
+            --index;
+            continue;
+        }
+
+        int first = index;
+        while (first > 0 && !nextIndexById.contains(m_items.at(first - 1).id))
+        {
+            --first;
+        }
+        beginRemoveRows(QModelIndex(), first, index);
+        m_items.remove(first, index - first + 1);
+        endRemoveRows();
+        index = first - 1;
+    }
+
+    for (int index = 0; index < nextItems.size();)
+    {
+        if (previousIndexById.contains(nextItems.at(index).id))
+        {
+            ++index;
+            continue;
+        }
+
+        int last = index;
+        while (last + 1 < nextItems.size() && !previousIndexById.contains(nextItems.at(last + 1).id))
+        {
+            ++last;
+        }
+        beginInsertRows(QModelIndex(), index, last);
+        m_items.insert(index, last - index + 1, ResourcesListItem());
+        for (int insertIndex = index; insertIndex <= last; ++insertIndex)
+        {
+            m_items[insertIndex] = nextItems.at(insertIndex);
+        }
+        endInsertRows();
+        index = last + 1;
+    }
+
+    for (int index = 0; index < nextItems.size();)
+    {
+        if (sameResourceListItem(m_items.at(index), nextItems.at(index)))
+        {
+            ++index;
+            continue;
+        }
+
+        int last = index;
+        while (last + 1 < nextItems.size() && !sameResourceListItem(m_items.at(last + 1), nextItems.at(last + 1)))
+        {
+            ++last;
+        }
+        for (int changedIndex = index; changedIndex <= last; ++changedIndex)
+        {
+            m_items[changedIndex] = nextItems.at(changedIndex);
+        }
+        emit dataChanged(this->index(index), this->index(last));
+        index = last + 1;
+    }
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "app/models/hierarchy/resources/ResourcesListIndex.hpp"
+
 #include <QAbstractListModel>
 #include <QString>
 #include <QStringList>
@@ -13,6 +15,7 @@ struct ResourcesListItem
     QString searchableText;
     QString bodyText;
     QString displayDate;
+    QString bucket;
     QStringList folders;
     QStringList tags;
     bool image = false;
@@ -39,6 +42,11 @@ class ResourcesListModel final : public QAbstractListModel
     Q_PROPERTY(QString currentBodyText READ currentBodyText NOTIFY currentBodyTextChanged)
     Q_PROPERTY(QVariantMap currentResourceEntry READ currentResourceEntry NOTIFY currentResourceEntryChanged)
     Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
+    Q_PROPERTY(QString typeFilter READ typeFilter WRITE setTypeFilter NOTIFY facetFilterChanged)
+    Q_PROPERTY(QString bucketFilter READ bucketFilter WRITE setBucketFilter NOTIFY facetFilterChanged)
+    Q_PROPERTY(QString formatFilter READ formatFilter WRITE setFormatFilter NOTIFY facetFilterChanged)
+    Q_PROPERTY(QString mimeFilter READ mimeFilter WRITE setMimeFilter NOTIFY facetFilterChanged)
+    Q_PROPERTY(QVariantMap facetCounts READ facetCounts NOTIFY facetCountsChanged)
 
 public:
     enum Role
@@ -49,6 +57,7 @@ public:
         BodyTextRole,
         ImageRole,
         ImageSourceRole,
+        ThumbnailSourceRole,
         DisplayDateRole,
         FoldersRole,
         TagsRole,
@@ -81,6 +90,17 @@ public:
     Q_INVOKABLE void setCurrentIndex(int index);
     QString searchText() const;
     void setSearchText(const QString& text);
+    QString typeFilter() const;
+    void setTypeFilter(const QString& type);
+    QString bucketFilter() const;
+    void setBucketFilter(const QString& bucket);
+    QString formatFilter() const;
+    void setFormatFilter(const QString& format);
+    QString mimeFilter() const;
+    void setMimeFilter(const QString& mime);
+    QVariantMap facetCounts() const;
+    Q_INVOKABLE int facetCount(const QString& facet, const QString& key) const;
+    Q_INVOKABLE void clearFacetFilters();
 
     void setItems(QVector<ResourcesListItem> items);
     const QVector<ResourcesListItem>& items() const noexcept;
@@ -107,13 +127,19 @@ public
     void currentBodyTextChanged();
     void currentResourceEntryChanged();
     void searchTextChanged();
+    void facetFilterChanged();
+    void facetCountsChanged();
     void modelHookRequested();
 
 private:
     void applySearchFilter();
+    void applyFacetFilter(ResourcesListFacetFilter filter);
+    void replaceItemsByKey(QVector<ResourcesListItem> nextItems);
 
     QVector<ResourcesListItem> m_sourceItems;
     QVector<ResourcesListItem> m_items;
+    ResourcesListIndex m_index;
+    ResourcesListFacetFilter m_facetFilter;
     QString m_searchText;
     int m_currentIndex = -1;
 };
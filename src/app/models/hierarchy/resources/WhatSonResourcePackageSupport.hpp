@@ -2,6 +2,7 @@
 
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
 
 #include <QDir>
 #include <QDirIterator>
@@ -32,14 +33,9 @@ namespace WhatSon::Resources
         QString format;
     };
 
-    inline QString decodeXmlEntities(QString text)
+    inline QString decodeXmlEntities(const QString& text)
     {
-        text.replace(QStringLiteral("&lt;"), QStringLiteral("<"));
-        text.replace(QStringLiteral("&gt;"), QStringLiteral(">"));
-        text.replace(QStringLiteral("&quot;"), QStringLiteral("\""));
-        text.replace(QStringLiteral("&apos;"), QStringLiteral("'"));
-        text.replace(QStringLiteral("&amp;"), QStringLiteral("&"));
-        return text;
+        return WhatSon::XmlEntities::decode(text);
     }
 
     inline QString packageDirectorySuffix()
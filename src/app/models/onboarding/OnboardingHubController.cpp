@@ -1,4 +1,5 @@
 #include "app/models/onboarding/OnboardingHubController.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 #include "app/models/file/hub/WhatSonHubMountValidator.hpp"
 #include "app/platform/Apple/AppleSecurityScopedResourceAccess.hpp"
@@ -813,6 +814,10 @@ bool OnboardingHubController::loadResolvedHubPath(const QString& resolvedHubPath
     }
     const QString mountableHubPath = mountValidation.hubPath;
 
+    // Switching hubs unmounts the previous one; a packed hub's staged edits go back into its archive off the GUI
+    // thread. Mounting and write-back share one lock, so they never rewrite the same archive at once.
+    WhatSonHubArchiveConverter::writeBackMountedArchivesInBackground();
+
     setCurrentHubPath(mountableHubPath);
     setSessionState(QString::fromLatin1(kSessionStateLoadingHub));
     setBusy(true);
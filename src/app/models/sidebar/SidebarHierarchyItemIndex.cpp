@@ -0,0 +1,531 @@
+#include "app/models/sidebar/SidebarHierarchyItemIndex.hpp"
+
+#include "app/policy/ArchitecturePolicyLock.hpp"
+
+#include <QJSValue>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    QVariantMap itemMap(const QVariant& item)
+    {
+        if (item.canConvert<QJSValue>())
+        {
+            const QJSValue jsValue = item.value<QJSValue>();
+            if (jsValue.isObject())
+            {
+                return jsValue.toVariant().toMap();
+            }
+        }
+        return item.toMap();
+    }
+
+    QString trimmedString(const QVariant& value)
+    {
+        if (!value.isValid() || value.isNull())
+        {
+            return {};
+        }
+        return value.toString().trimmed();
+    }
+
+    int integerProperty(const QQuickItem* item, const char* propertyName)
+    {
+        const QVariant value = item->property(propertyName);
+        if (!value.isValid() || value.isNull())
+        {
+            return -1;
+        }
+
+        bool ok = false;
+        const double numericValue = value.toDouble(&ok);
+        if (!ok || !std::isfinite(numericValue))
+        {
+            return -1;
+        }
+        return static_cast<int>(std::floor(numericValue));
+    }
+} // namespace
+
+SidebarHierarchyItemIndex::SidebarHierarchyItemIndex(QObject* parent)
+    : QObject(parent)
+{
+}
+
+SidebarHierarchyItemIndex::~SidebarHierarchyItemIndex()
+{
+    disconnectHierarchyController();
+    disconnectRows();
+}
+
+QObject* SidebarHierarchyItemIndex::hierarchyController() const noexcept
+{
+    return m_hierarchyController;
+}
+
+void SidebarHierarchyItemIndex::setHierarchyController(QObject* controller)
+{
+    if (controller != nullptr
+        && !WhatSon::Policy::verifyDependencyAllowed(
+            WhatSon::Policy::Layer::View,
+            WhatSon::Policy::Layer::Controller,
+            QStringLiteral("SidebarHierarchyItemIndex::setHierarchyController")))
+    {
+        return;
+    }
+
+    IHierarchyController* interfaceController = qobject_cast<IHierarchyController*>(controller);
+    if (m_hierarchyController == interfaceController)
+    {
+        return;
+    }
+
+    disconnectHierarchyController();
+    m_hierarchyController = interfaceController;
+
+    if (m_hierarchyController != nullptr)
+    {
+        m_hierarchyControllerDestroyedConnection = connect(
+            m_hierarchyController,
+            &QObject::destroyed,
+            this,
+            &SidebarHierarchyItemIndex::handleHierarchyControllerDestroyed);
+        m_hierarchyNodesChangedConnection = connect(
+            m_hierarchyController,
+            &IHierarchyController::hierarchyNodesChanged,
+            this,
+            &SidebarHierarchyItemIndex::handleHierarchyNodesChanged);
+    }
+
+    emit hierarchyControllerChanged();
+    handleHierarchyNodesChanged();
+}
+
+int SidebarHierarchyItemIndex::itemCount() const
+{
+    ensureIndexed();
+    return static_cast<int>(m_keys.size());
+}
+
+int SidebarHierarchyItemIndex::indexForKey(const QString& itemKey) const
+{
+    const QString normalizedKey = itemKey.trimmed();
+    if (normalizedKey.isEmpty())
+    {
+        return -1;
+    }
+
+    ensureIndexed();
+    return m_firstIndexByKey.value(normalizedKey, -1);
+}
+
+QString SidebarHierarchyItemIndex::keyAt(const int index) const
+{
+    ensureIndexed();
+    if (index < 0 || index >= m_keys.size())
+    {
+        return {};
+    }
+    return m_keys.at(index);
+}
+
+int SidebarHierarchyItemIndex::insertedIndex(const QVariant& beforeModel, const QVariant& afterModel) const
+{
+    const QStringList beforeKeys = keysForModel(beforeModel);
+    const QStringList afterKeys = keysForModel(afterModel);
+
+    QHash<QString, int> beforeKeyCounts;
+    beforeKeyCounts.reserve(beforeKeys.size());
+    for (const QString& beforeKey : beforeKeys)
+    {
+        if (!beforeKey.isEmpty())
+        {
+            ++beforeKeyCounts[beforeKey];
+        }
+    }
+
+    QHash<QString, int> seenAfterKeyCounts;
+    seenAfterKeyCounts.reserve(afterKeys.size());
+    for (int index = 0; index < afterKeys.size(); ++index)
+    {
+        const QString& afterKey = afterKeys.at(index);
+        if (afterKey.isEmpty())
+        {
+            continue;
+        }
+
+        int& seenCount = seenAfterKeyCounts[afterKey];
+        if (seenCount >= beforeKeyCounts.value(afterKey, 0))
+        {
+            return index;
+        }
+        ++seenCount;
+    }
+    return -1;
+}
+
+QVariantList SidebarHierarchyItemIndex::collectItems(QQuickItem* hierarchyTree) const
+{
+    QVariantList items;
+    if (hierarchyTree == nullptr)
+    {
+        return items;
+    }
+
+    ensureRowsIndexed(hierarchyTree);
+    items.reserve(m_rowsByY.size());
+    for (QQuickItem* row : std::as_const(m_rowsByY))
+    {
+        items.push_back(QVariant::fromValue<QObject*>(row));
+    }
+    return items;
+}
+
+QQuickItem* SidebarHierarchyItemIndex::itemAtPosition(QQuickItem* hierarchyTree, const qreal x, const qreal y) const
+{
+    if (hierarchyTree == nullptr)
+    {
+        return nullptr;
+    }
+
+    ensureRowsIndexed(hierarchyTree);
+    if (m_rowsByY.isEmpty() || m_rowContainer == nullptr)
+    {
+        return nullptr;
+    }
+
+    const QPointF point(x, y);
+    const qreal contentY = hierarchyTree->mapToItem(m_rowContainer, point).y();
+
+    // Uniform rows resolve directly from (contentY - firstRowY) / rowHeight; variable heights fall back to a binary
+    // search over the y-sorted rows.
+    const QQuickItem* firstRow = m_rowsByY.constFirst();
+    const qreal rowHeight = firstRow->height();
+    if (rowHeight > 0)
+    {
+        const qreal rowOffset = std::floor((contentY - firstRow->y()) / rowHeight);
+        if (rowOffset >= 0 && rowOffset < m_rowsByY.size())
+        {
+            QQuickItem* candidate = m_rowsByY.at(static_cast<int>(rowOffset));
+            if (itemContainsPoint(candidate, hierarchyTree, point))
+            {
+                return candidate;
+            }
+        }
+    }
+
+    auto it = std::upper_bound(
+        m_rowsByY.cbegin(),
+        m_rowsByY.cend(),
+        contentY,
+        [](const qreal value, const QQuickItem* row)
+        {
+            return value < row->y();
+        });
+    if (it == m_rowsByY.cbegin())
+    {
+        return nullptr;
+    }
+    --it;
+    return itemContainsPoint(*it, hierarchyTree, point) ? *it : nullptr;
+}
+
+QQuickItem* SidebarHierarchyItemIndex::itemForModelIndex(QQuickItem* hierarchyTree, const int index) const
+{
+    if (hierarchyTree == nullptr || index < 0)
+    {
+        return nullptr;
+    }
+
+    ensureRowsIndexed(hierarchyTree);
+    QQuickItem* candidate = m_rowsByModelIndex.value(index, nullptr);
+    return visualItemMatchesModelIndex(candidate, index) ? candidate : nullptr;
+}
+
+QString SidebarHierarchyItemIndex::itemKey(const QVariant& item)
+{
+    const QVariantMap map = itemMap(item);
+    const QString key = trimmedString(map.value(QStringLiteral("itemKey")));
+    if (!key.isEmpty())
+    {
+        return key;
+    }
+    return trimmedString(map.value(QStringLiteral("key")));
+}
+
+QString SidebarHierarchyItemIndex::visualItemKey(const QQuickItem* item)
+{
+    if (item == nullptr)
+    {
+        return {};
+    }
+
+    const QString resolvedKey = trimmedString(item->property("resolvedItemKey"));
+    if (!resolvedKey.isEmpty())
+    {
+        return resolvedKey;
+    }
+    return trimmedString(item->property("itemKey"));
+}
+
+void SidebarHierarchyItemIndex::handleHierarchyControllerDestroyed()
+{
+    disconnectHierarchyController();
+    m_hierarchyController = nullptr;
+    emit hierarchyControllerChanged();
+    handleHierarchyNodesChanged();
+}
+
+void SidebarHierarchyItemIndex::handleHierarchyNodesChanged()
+{
+    m_indexDirty = true;
+    m_rowsDirty = true;
+    emit indexChanged();
+}
+
+QStringList SidebarHierarchyItemIndex::keysForModel(const QVariant& modelValue)
+{
+    QStringList keys;
+    if (modelValue.canConvert<QJSValue>())
+    {
+        const QJSValue jsValue = modelValue.value<QJSValue>();
+        if (jsValue.isArray())
+        {
+            const quint32 length = jsValue.property(QStringLiteral("length")).toUInt();
+            keys.reserve(static_cast<qsizetype>(length));
+            for (quint32 index = 0; index < length; ++index)
+            {
+                keys.push_back(itemKey(jsValue.property(index).toVariant()));
+            }
+            return keys;
+        }
+    }
+
+    const QVariantList items = modelValue.toList();
+    keys.reserve(items.size());
+    for (const QVariant& item : items)
+    {
+        keys.push_back(itemKey(item));
+    }
+    return keys;
+}
+
+QList<QQuickItem*> SidebarHierarchyItemIndex::visualChildren(const QQuickItem* item)
+{
+    QList<QQuickItem*> children;
+    if (item == nullptr)
+    {
+        return children;
+    }
+
+    children = item->childItems();
+    QQuickItem* contentItem = qvariant_cast<QQuickItem*>(item->property("contentItem"));
+    if (contentItem != nullptr)
+    {
+        for (QQuickItem* child : contentItem->childItems())
+        {
+            if (!children.contains(child))
+            {
+                children.push_back(child);
+            }
+        }
+    }
+    return children;
+}
+
+bool SidebarHierarchyItemIndex::isVisibleHierarchyItem(const QQuickItem* item)
+{
+    return item != nullptr && item->isVisible() && item->property("__isHierarchyItem").toBool();
+}
+
+bool SidebarHierarchyItemIndex::itemContainsPoint(
+    QQuickItem* item,
+    QQuickItem* hierarchyTree,
+    const QPointF& point)
+{
+    if (item->width() <= 0 || item->height() <= 0)
+    {
+        return false;
+    }
+
+    const QVariant rowVisible = item->property("rowVisible");
+    if (rowVisible.isValid() && !rowVisible.toBool())
+    {
+        return false;
+    }
+
+    const QPointF origin = item->mapToItem(hierarchyTree, QPointF(0, 0));
+    return point.x() >= origin.x() && point.x() <= origin.x() + item->width()
+        && point.y() >= origin.y() && point.y() <= origin.y() + item->height();
+}
+
+QQuickItem* SidebarHierarchyItemIndex::findRowContainer(QQuickItem* hierarchyTree)
+{
+    QList<QQuickItem*> pending = visualChildren(hierarchyTree);
+    while (!pending.isEmpty())
+    {
+        QQuickItem* child = pending.takeFirst();
+        if (child == nullptr)
+        {
+            continue;
+        }
+        if (child->property("__isHierarchyItem").toBool())
+        {
+            return child->parentItem();
+        }
+        pending.append(visualChildren(child));
+    }
+    return nullptr;
+}
+
+void SidebarHierarchyItemIndex::disconnectHierarchyController()
+{
+    if (m_hierarchyControllerDestroyedConnection)
+    {
+        disconnect(m_hierarchyControllerDestroyedConnection);
+        m_hierarchyControllerDestroyedConnection = {};
+    }
+    if (m_hierarchyNodesChangedConnection)
+    {
+        disconnect(m_hierarchyNodesChangedConnection);
+        m_hierarchyNodesChangedConnection = {};
+    }
+}
+
+void SidebarHierarchyItemIndex::ensureIndexed() const
+{
+    if (!m_indexDirty)
+    {
+        return;
+    }
+
+    m_indexDirty = false;
+    m_keys = m_hierarchyController != nullptr
+        ? keysForModel(m_hierarchyController->hierarchyNodes())
+        : QStringList();
+    m_firstIndexByKey.clear();
+    m_firstIndexByKey.reserve(m_keys.size());
+    for (int index = 0; index < m_keys.size(); ++index)
+    {
+        const QString& key = m_keys.at(index);
+        if (!key.isEmpty() && !m_firstIndexByKey.contains(key))
+        {
+            m_firstIndexByKey.insert(key, index);
+        }
+    }
+}
+
+void SidebarHierarchyItemIndex::ensureRowsIndexed(QQuickItem* hierarchyTree) const
+{
+    if (m_rowTree != hierarchyTree)
+    {
+        resetRowIndex();
+        m_rowTree = hierarchyTree;
+    }
+    if (m_rowContainer == nullptr)
+    {
+        resetRowIndex();
+        m_rowContainer = findRowContainer(hierarchyTree);
+        if (m_rowContainer == nullptr)
+        {
+            return;
+        }
+    }
+    if (!m_rowsDirty)
+    {
+        return;
+    }
+
+    disconnectRows();
+    m_rowsDirty = false;
+    m_rowsByY.clear();
+    m_rowsByModelIndex.clear();
+
+    const auto markRowsDirty = [this]()
+    {
+        m_rowsDirty = true;
+    };
+    m_rowConnections.push_back(connect(m_rowContainer, &QQuickItem::childrenChanged, this, markRowsDirty));
+    m_rowConnections.push_back(connect(m_rowContainer, &QObject::destroyed, this, markRowsDirty));
+
+    for (QQuickItem* row : m_rowContainer->childItems())
+    {
+        if (row == nullptr || !row->property("__isHierarchyItem").toBool())
+        {
+            continue;
+        }
+
+        m_rowConnections.push_back(connect(row, &QQuickItem::visibleChanged, this, markRowsDirty));
+        m_rowConnections.push_back(connect(row, &QQuickItem::yChanged, this, markRowsDirty));
+        m_rowConnections.push_back(connect(row, &QObject::destroyed, this, markRowsDirty));
+        if (!row->isVisible())
+        {
+            continue;
+        }
+
+        m_rowsByY.push_back(row);
+        const QVariant rawItemId = row->property("itemId");
+        const int itemIndex = rawItemId.isValid() && !rawItemId.isNull()
+            ? integerProperty(row, "itemId")
+            : integerProperty(row, "resolvedItemId");
+        const int flatIndex = integerProperty(row, "flatIndex");
+        if (itemIndex >= 0 && !m_rowsByModelIndex.contains(itemIndex))
+        {
+            m_rowsByModelIndex.insert(itemIndex, row);
+        }
+        if (flatIndex >= 0 && !m_rowsByModelIndex.contains(flatIndex))
+        {
+            m_rowsByModelIndex.insert(flatIndex, row);
+        }
+    }
+
+    std::stable_sort(
+        m_rowsByY.begin(),
+        m_rowsByY.end(),
+        [](const QQuickItem* left, const QQuickItem* right)
+        {
+            return left->y() < right->y();
+        });
+}
+
+void SidebarHierarchyItemIndex::resetRowIndex() const
+{
+    disconnectRows();
+    m_rowContainer = nullptr;
+    m_rowsByY.clear();
+    m_rowsByModelIndex.clear();
+    m_rowsDirty = true;
+}
+
+void SidebarHierarchyItemIndex::disconnectRows() const
+{
+    for (const QMetaObject::Connection& connection : std::as_const(m_rowConnections))
+    {
+        disconnect(connection);
+    }
+    m_rowConnections.clear();
+}
+
+bool SidebarHierarchyItemIndex::visualItemMatchesModelIndex(const QQuickItem* item, const int index) const
+{
+    if (!isVisibleHierarchyItem(item))
+    {
+        return false;
+    }
+
+    const QVariant rawItemId = item->property("itemId");
+    const int itemIndex = rawItemId.isValid() && !rawItemId.isNull()
+        ? integerProperty(item, "itemId")
+        : integerProperty(item, "resolvedItemId");
+    const int flatIndex = integerProperty(item, "flatIndex");
+    if (itemIndex != index && flatIndex != index)
+    {
+        return false;
+    }
+
+    const QString expectedKey = keyAt(index);
+    return expectedKey.isEmpty() || visualItemKey(item) == expectedKey;
+}
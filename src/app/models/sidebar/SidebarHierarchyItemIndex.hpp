@@ -0,0 +1,83 @@
+#pragma once
+
+#include "app/models/hierarchy/IHierarchyController.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+#include <QQuickItem>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantList>
+#include <QVector>
+
+class SidebarHierarchyItemIndex : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(
+        QObject
+        * hierarchyController READ hierarchyController WRITE setHierarchyController NOTIFY hierarchyControllerChanged)
+    Q_PROPERTY(int itemCount READ itemCount NOTIFY indexChanged)
+
+public:
+    explicit SidebarHierarchyItemIndex(QObject* parent = nullptr);
+    ~SidebarHierarchyItemIndex() override;
+
+    QObject* hierarchyController() const noexcept;
+    void setHierarchyController(QObject* controller);
+
+    int itemCount() const;
+
+    Q_INVOKABLE int indexForKey(const QString& itemKey) const;
+    Q_INVOKABLE QString keyAt(int index) const;
+    Q_INVOKABLE int insertedIndex(const QVariant& beforeModel, const QVariant& afterModel) const;
+
+    Q_INVOKABLE QVariantList collectItems(QQuickItem* hierarchyTree) const;
+    Q_INVOKABLE QQuickItem* itemAtPosition(QQuickItem* hierarchyTree, qreal x, qreal y) const;
+    Q_INVOKABLE QQuickItem* itemForModelIndex(QQuickItem* hierarchyTree, int index) const;
+
+    static QString itemKey(const QVariant& item);
+    static QString visualItemKey(const QQuickItem* item);
+
+signals:
+    void hierarchyControllerChanged();
+    void indexChanged();
+
+private slots:
+    void handleHierarchyControllerDestroyed();
+    void handleHierarchyNodesChanged();
+
+private:
+    static QStringList keysForModel(const QVariant& modelValue);
+    static QList<QQuickItem*> visualChildren(const QQuickItem* item);
+    static bool isVisibleHierarchyItem(const QQuickItem* item);
+    static bool itemContainsPoint(QQuickItem* item, QQuickItem* hierarchyTree, const QPointF& point);
+    static QQuickItem* findRowContainer(QQuickItem* hierarchyTree);
+
+    void disconnectHierarchyController();
+    void ensureIndexed() const;
+    void ensureRowsIndexed(QQuickItem* hierarchyTree) const;
+    void resetRowIndex() const;
+    void disconnectRows() const;
+    bool visualItemMatchesModelIndex(const QQuickItem* item, int index) const;
+
+    QPointer<IHierarchyController> m_hierarchyController;
+    QMetaObject::Connection m_hierarchyControllerDestroyedConnection;
+    QMetaObject::Connection m_hierarchyNodesChangedConnection;
+    mutable QStringList m_keys;
+    mutable QHash<QString, int> m_firstIndexByKey;
+    mutable bool m_indexDirty = true;
+
+    // Rows are the instantiated delegates under one LVRS content item. They are re-read only when that container
+    // gains or loses children, or a row moves or hides, so drag moves never walk the QQuickItem tree.
+    mutable QPointer<QQuickItem> m_rowTree;
+    mutable QPointer<QQuickItem> m_rowContainer;
+    mutable QList<QMetaObject::Connection> m_rowConnections;
+    mutable QVector<QQuickItem*> m_rowsByY;
+    mutable QHash<int, QQuickItem*> m_rowsByModelIndex;
+    mutable bool m_rowsDirty = true;
+};
@@ -79,6 +79,11 @@ Item {
         activeHierarchyIndex: hierarchyView.currentHierarchy
         hierarchyInteractionBridge: hierarchyInteractionBridge
     }
+    SidebarHierarchyItemIndex {
+        id: sidebarHierarchyItemIndex
+
+        hierarchyController: hierarchyView.resolvedHierarchyController
+    }
     SidebarHierarchyView {
         id: sidebarView
 
@@ -89,6 +94,7 @@ Item {
         hierarchyDragDropBridge: hierarchyDragDropBridge
         hierarchyInteractionBridge: hierarchyInteractionBridge
         hierarchyInteractionController: sidebarHierarchyInteractionController
+        hierarchyItemIndex: sidebarHierarchyItemIndex
         hierarchyEditable: hierarchyDragDropBridge.reorderContractAvailable
         hierarchyController: hierarchyView.resolvedHierarchyController
         hierarchyUsesSnapshotRenderModel: hierarchyView.currentHierarchy === hierarchyEnum.resources
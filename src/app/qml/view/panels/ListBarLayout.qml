@@ -846,6 +846,7 @@ Rectangle {
             opacity: listBarLayout.grabbedNoteOpacity
             primaryText: noteDragPreviewState.delegateItem && noteDragPreviewState.delegateItem.primaryText !== undefined && noteDragPreviewState.delegateItem.primaryText !== null ? String(noteDragPreviewState.delegateItem.primaryText) : ""
             tags: noteDragPreviewState.delegateItem ? listBarLayout.normalizeEntries(noteDragPreviewState.delegateItem.tags) : []
+            thumbnailSource: noteDragPreviewState.delegateItem && noteDragPreviewState.delegateItem.thumbnailSource !== undefined && noteDragPreviewState.delegateItem.thumbnailSource !== null ? noteDragPreviewState.delegateItem.thumbnailSource : ""
             visible: !listBarLayout.resourceListMode
         }
         ResourceListItem {
@@ -855,6 +856,7 @@ Rectangle {
             anchors.fill: parent
             opacity: listBarLayout.grabbedNoteOpacity
             previewSource: noteDragPreviewState.delegateItem && noteDragPreviewState.delegateItem.imageSource !== undefined && noteDragPreviewState.delegateItem.imageSource !== null ? noteDragPreviewState.delegateItem.imageSource : ""
+            thumbnailSource: noteDragPreviewState.delegateItem && noteDragPreviewState.delegateItem.thumbnailSource !== undefined && noteDragPreviewState.delegateItem.thumbnailSource !== null ? noteDragPreviewState.delegateItem.thumbnailSource : ""
             titleText: noteDragPreviewState.delegateItem && noteDragPreviewState.delegateItem.primaryText !== undefined && noteDragPreviewState.delegateItem.primaryText !== null ? String(noteDragPreviewState.delegateItem.primaryText) : ""
             visible: listBarLayout.resourceListMode
         }
@@ -952,6 +954,7 @@ Rectangle {
                         property double pointerSelectionModifiersCapturedAtMs: 0
                         required property string primaryText
                         required property var tags
+                        required property var thumbnailSource
 
                         Drag.active: noteItemDelegate.pointerDragActive
                         Drag.dragType: Drag.Internal
@@ -985,6 +988,7 @@ Rectangle {
                             pressed: listBarLayout.pressedNoteIndex === noteItemDelegate.index || noteItemDelegate.pointerDragActive
                             primaryText: noteItemDelegate.primaryText === undefined || noteItemDelegate.primaryText === null ? "" : String(noteItemDelegate.primaryText)
                             tags: listBarLayout.normalizeEntries(noteItemDelegate.tags)
+                            thumbnailSource: noteItemDelegate.thumbnailSource === undefined || noteItemDelegate.thumbnailSource === null ? "" : noteItemDelegate.thumbnailSource
                             visible: !listBarLayout.resourceListMode
                         }
                         ResourceListItem {
@@ -995,6 +999,7 @@ Rectangle {
                             opacity: noteItemDelegate.pointerDragActive ? listBarLayout.grabbedNoteOpacity : 1
                             pressed: listBarLayout.pressedNoteIndex === noteItemDelegate.index || noteItemDelegate.pointerDragActive
                             previewSource: noteItemDelegate.imageSource === undefined || noteItemDelegate.imageSource === null ? "" : noteItemDelegate.imageSource
+                            thumbnailSource: noteItemDelegate.thumbnailSource === undefined || noteItemDelegate.thumbnailSource === null ? "" : noteItemDelegate.thumbnailSource
                             titleText: noteItemDelegate.primaryText === undefined || noteItemDelegate.primaryText === null ? "" : String(noteItemDelegate.primaryText)
                             visible: listBarLayout.resourceListMode
                         }
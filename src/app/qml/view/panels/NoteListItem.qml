@@ -53,6 +53,7 @@ Item {
     readonly property color tagLabelColor: LV.Theme.captionColor
     property var tags: []
     readonly property int secondaryTextLineHeight: LV.Theme.textBodyLineHeight
+    property url thumbnailSource: ""
     readonly property int verticalPadding: LV.Theme.gap8
     readonly property var visibleFolders: metadataPreview(noteListItem.folders, true)
     readonly property var visibleTags: metadataPreview(noteListItem.tags, false)
@@ -140,7 +141,7 @@ Item {
                         anchors.fill: parent
                         asynchronous: true
                         fillMode: Image.PreserveAspectCrop
-                        source: noteListItem.imageSource
+                        source: noteListItem.thumbnailSource.toString().length > 0 ? noteListItem.thumbnailSource : noteListItem.imageSource
                         sourceSize.height: noteListItem.imagePreviewSize
                         sourceSize.width: noteListItem.imagePreviewSize
                         visible: noteListItem.imageSource.toString().length > 0
@@ -18,6 +18,7 @@ Item {
     readonly property int rowSpacing: LV.Theme.gap10
     readonly property int thumbnailSize: LV.Theme.gap24 + LV.Theme.gap24
     readonly property color thumbnailPlaceholderColor: LV.Theme.strokeSoft
+    property url thumbnailSource: ""
     property string titleText: ""
     readonly property color titleColor: LV.Theme.captionColor
     readonly property int titleLineHeight: LV.Theme.textBodyLineHeight
@@ -58,7 +59,7 @@ Item {
                     anchors.fill: parent
                     asynchronous: true
                     fillMode: Image.PreserveAspectCrop
-                    source: resourceListItem.previewSource
+                    source: resourceListItem.thumbnailSource.toString().length > 0 ? resourceListItem.thumbnailSource : resourceListItem.previewSource
                     sourceSize.height: resourceListItem.thumbnailSize
                     sourceSize.width: resourceListItem.thumbnailSize
                     visible: resourceListItem.previewSource.toString().length > 0
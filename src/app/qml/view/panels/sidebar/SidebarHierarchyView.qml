@@ -115,6 +115,7 @@ Rectangle {
     property var hierarchyDragDropBridge: null
     property bool hierarchyEditable: false
     property var hierarchyInteractionController: null
+    property var hierarchyItemIndex: null
     property var hierarchyInteractionBridge: null
     property bool hierarchyUsesSnapshotRenderModel: false
     readonly property var hierarchySharedItemModel: sidebarHierarchyView.hierarchyController ? sidebarHierarchyView.hierarchyController.hierarchyItemModel : []
@@ -233,6 +234,15 @@ Rectangle {
     property alias hierarchySelectionAnchorIndex: hierarchySelectionController.selectionAnchorIndex
     property int hierarchySelectionVisualRevision: 0
     property var hierarchyController: null
+    // Set when the domain behind this hierarchy failed to load while the rest of the hub mounted; the runtime keeps
+    // retrying it in the background and the notice clears once it loads.
+    readonly property string hierarchyDegradedError: {
+        const controller = sidebarHierarchyView.hierarchyController;
+        if (!controller || controller.hierarchyLoadSucceeded !== false)
+            return "";
+        return String(controller.hierarchyLastLoadError || "").trim();
+    }
+    readonly property bool hierarchyLoadDegraded: sidebarHierarchyView.hierarchyDegradedError.length > 0
     property string hierarchyChevronPointerPressKey: ""
     property var hierarchyChevronPointerPressItem: null
     property int hierarchyChevronPointerPressIndex: -1
@@ -652,14 +662,9 @@ Rectangle {
     }
     function hierarchyModelIndexForKey(itemKey) {
         const normalizedKey = itemKey === undefined || itemKey === null ? "" : String(itemKey).trim();
-        if (!normalizedKey.length)
+        if (!normalizedKey.length || !sidebarHierarchyView.hierarchyItemIndex)
             return -1;
-        const nodes = sidebarHierarchyView.standardHierarchyModel;
-        for (let index = 0; index < nodes.length; ++index) {
-            if (sidebarHierarchyView.hierarchyModelItemKey(nodes[index]) === normalizedKey)
-                return index;
-        }
-        return -1;
+        return sidebarHierarchyView.hierarchyItemIndex.indexForKey(normalizedKey);
     }
     function hierarchyItemKeyForVisualItem(item) {
         if (!item)
@@ -687,25 +692,11 @@ Rectangle {
         return sidebarHierarchyView.hierarchyItemKeyForVisualItem(item) === expectedKey;
     }
     function insertedHierarchyModelItemIndex(beforeModel, afterModel, fallbackIndex) {
+        const keyedIndex = sidebarHierarchyView.hierarchyItemIndex ? sidebarHierarchyView.hierarchyItemIndex.insertedIndex(beforeModel, afterModel) : -1;
+        if (keyedIndex >= 0)
+            return keyedIndex;
         const beforeItems = renameController.normalizeHierarchyModel(beforeModel);
         const afterItems = renameController.normalizeHierarchyModel(afterModel);
-        const beforeKeyCounts = {};
-        for (let index = 0; index < beforeItems.length; ++index) {
-            const beforeKey = sidebarHierarchyView.hierarchyModelItemKey(beforeItems[index]);
-            if (!beforeKey.length)
-                continue;
-            beforeKeyCounts[beforeKey] = (beforeKeyCounts[beforeKey] || 0) + 1;
-        }
-        const seenAfterKeyCounts = {};
-        for (let index = 0; index < afterItems.length; ++index) {
-            const afterKey = sidebarHierarchyView.hierarchyModelItemKey(afterItems[index]);
-            if (!afterKey.length)
-                continue;
-            const seenCount = seenAfterKeyCounts[afterKey] || 0;
-            if (seenCount >= (beforeKeyCounts[afterKey] || 0))
-                return index;
-            seenAfterKeyCounts[afterKey] = seenCount + 1;
-        }
         const fallback = sidebarHierarchyView.normalizedInteger(fallbackIndex, -1);
         if (fallback >= 0 && fallback < afterItems.length && sidebarHierarchyView.canRenameIndex(fallback))
             return fallback;
@@ -1636,10 +1627,12 @@ Rectangle {
         id: noteDropController
 
         required property var hierarchyDragDropBridge
+        required property var hierarchyItemIndex
         required property var hierarchyTree
         required property var hostView
 
         hierarchyDragDropBridge: sidebarHierarchyView.hierarchyDragDropBridge
+        hierarchyItemIndex: sidebarHierarchyView.hierarchyItemIndex
         hierarchyTree: sidebarHierarchyView.hierarchyTreeItem
         hostView: sidebarHierarchyView
 
@@ -1656,22 +1649,9 @@ Rectangle {
             hostView.noteDropHoverIndex = -1;
         }
         function collectHierarchyItems() {
-            const items = [];
-            function visitHierarchyDescendants(item) {
-                if (!item)
-                    return;
-                const children = noteDropController.hierarchyVisualChildren(item);
-                for (let i = 0; i < children.length; ++i) {
-                    const child = children[i];
-                    if (!child || child.visible === false)
-                        continue;
-                    if (child.__isHierarchyItem === true)
-                        items.push(child);
-                    visitHierarchyDescendants(child);
-                }
-            }
-            visitHierarchyDescendants(hierarchyTree);
-            return items;
+            if (!hierarchyItemIndex)
+                return [];
+            return hierarchyItemIndex.collectItems(hierarchyTree);
         }
         function commitNoteDropAtPosition(x, y, noteIds, referenceItem) {
             const normalizedNoteIds = noteDropController.normalizeNoteIds(noteIds);
@@ -1690,25 +1670,9 @@ Rectangle {
             return true;
         }
         function hierarchyItemAtPosition(x, y) {
-            const targetX = Number(x) || 0;
-            const targetY = Number(y) || 0;
-            function visitHierarchyDescendants(item) {
-                if (!item)
-                    return null;
-                const children = noteDropController.hierarchyVisualChildren(item);
-                for (let i = children.length - 1; i >= 0; --i) {
-                    const child = children[i];
-                    if (!child || child.visible === false)
-                        continue;
-                    const matchedDescendant = visitHierarchyDescendants(child);
-                    if (matchedDescendant)
-                        return matchedDescendant;
-                    if (child.__isHierarchyItem === true && noteDropController.hierarchyItemContainsPoint(child, targetX, targetY))
-                        return child;
-                }
+            if (!hierarchyItemIndex)
                 return null;
-            }
-            return visitHierarchyDescendants(hierarchyTree);
+            return hierarchyItemIndex.itemAtPosition(hierarchyTree, Number(x) || 0, Number(y) || 0);
         }
         function hierarchyItemContainsPoint(item, x, y) {
             if (!item || item.mapToItem === undefined)
@@ -1729,43 +1693,9 @@ Rectangle {
             if (!isFinite(numericIndex))
                 return null;
             const resolvedIndex = Math.max(-1, Math.floor(numericIndex));
-            if (resolvedIndex < 0)
-                return null;
-            function visitHierarchyDescendants(item) {
-                if (!item)
-                    return null;
-                const children = noteDropController.hierarchyVisualChildren(item);
-                for (let i = children.length - 1; i >= 0; --i) {
-                    const child = children[i];
-                    if (!child || child.visible === false)
-                        continue;
-                    const matchedDescendant = visitHierarchyDescendants(child);
-                    if (matchedDescendant)
-                        return matchedDescendant;
-                    if (child.__isHierarchyItem !== true)
-                        continue;
-                    if (hostView.hierarchyItemMatchesModelIndex(child, resolvedIndex))
-                        return child;
-                }
+            if (resolvedIndex < 0 || !hierarchyItemIndex)
                 return null;
-            }
-            return visitHierarchyDescendants(hierarchyTree);
-        }
-        function hierarchyVisualChildren(item) {
-            const resolvedChildren = [];
-            function appendChildren(children) {
-                if (!children)
-                    return;
-                for (let index = 0; index < children.length; ++index) {
-                    const child = children[index];
-                    if (!child || resolvedChildren.indexOf(child) >= 0)
-                        continue;
-                    resolvedChildren.push(child);
-                }
-            }
-            appendChildren(item && item.children !== undefined ? item.children : null);
-            appendChildren(item && item.contentItem && item.contentItem.children !== undefined ? item.contentItem.children : null);
-            return resolvedChildren;
+            return hierarchyItemIndex.itemForModelIndex(hierarchyTree, resolvedIndex);
         }
         function normalizeNoteIds(noteIds) {
             if (noteIds === undefined || noteIds === null)
@@ -1998,7 +1928,7 @@ Rectangle {
     LV.Hierarchy {
         id: hierarchyTree
 
-        anchors.bottomMargin: sidebarHierarchyView.verticalInset + (sidebarHierarchyView.footerVisible ? hierarchyFooter.implicitHeight : 0)
+        anchors.bottomMargin: sidebarHierarchyView.verticalInset + (sidebarHierarchyView.footerVisible ? hierarchyFooter.implicitHeight : 0) + (sidebarHierarchyView.hierarchyLoadDegraded ? hierarchyDegradedNotice.implicitHeight : 0)
         anchors.fill: parent
         anchors.leftMargin: sidebarHierarchyView.horizontalInset
         anchors.rightMargin: sidebarHierarchyView.horizontalInset
@@ -2339,6 +2269,24 @@ Rectangle {
             sidebarHierarchyView.handleHierarchyFooterButtonClicked(index, config);
         }
     }
+    LV.Label {
+        id: hierarchyDegradedNotice
+
+        anchors.bottom: sidebarHierarchyView.footerVisible ? hierarchyFooter.top : parent.bottom
+        anchors.bottomMargin: sidebarHierarchyView.footerVisible ? LV.Theme.gapNone : sidebarHierarchyView.verticalInset
+        anchors.left: parent.left
+        anchors.leftMargin: sidebarHierarchyView.horizontalInset
+        anchors.right: parent.right
+        anchors.rightMargin: sidebarHierarchyView.horizontalInset
+        color: LV.Theme.captionColor
+        elide: Text.ElideRight
+        maximumLineCount: 2
+        style: caption
+        text: "Could not load this section; retrying in the background. " + sidebarHierarchyView.hierarchyDegradedError
+        visible: sidebarHierarchyView.hierarchyLoadDegraded
+        wrapMode: Text.WordWrap
+        z: 2
+    }
     DropArea {
         id: noteDropSurface
 
@@ -17,6 +17,9 @@ Platform.MenuBar {
     property bool duplicateImportAlertOpen: false
     property var inAppClipboard: null
     property string importFailureText: ""
+    property bool importInFlight: false
+    readonly property bool importBusy: root.inAppClipboard !== null && root.inAppClipboard !== undefined && Boolean(root.inAppClipboard.busy)
+    readonly property int importProgressPercent: root.importBusy ? Math.round((Number(root.inAppClipboard.importProgress) || 0) * 100) : 0
 
     window: root.hostWindow
 
@@ -73,10 +76,14 @@ Platform.MenuBar {
         if (!root.inAppClipboard
                 || root.inAppClipboard.importUrlsWithConflictPolicy === undefined)
             return false;
-        const succeeded = root.inAppClipboard.importUrlsWithConflictPolicy(selectedFiles, conflictPolicy);
-        if (!succeeded)
+        // The import runs on a worker: true only means it started. Failures arrive through operationFailed.
+        root.importInFlight = true;
+        const started = root.inAppClipboard.importUrlsWithConflictPolicy(selectedFiles, conflictPolicy);
+        if (!started && root.importInFlight) {
+            root.importInFlight = false;
             root.openImportFailureDialog();
-        return succeeded;
+        }
+        return started;
     }
     function handleSelectedImportUrls(selectedFiles) {
         if (!root.inAppClipboard)
@@ -99,6 +106,20 @@ Platform.MenuBar {
         root.clearPendingDuplicateImport();
     }
 
+    Connections {
+        function onImportCompleted(importedCount) {
+            root.importInFlight = false;
+        }
+        function onOperationFailed(message) {
+            if (!root.importInFlight)
+                return;
+            root.importInFlight = false;
+            root.openImportFailureDialog();
+        }
+
+        target: root.inAppClipboard
+        ignoreUnknownSignals: true
+    }
     MessageDialog {
         id: importFailureDialog
 
@@ -126,10 +147,10 @@ Platform.MenuBar {
 
         Platform.MenuItem {
             enabled: root.inAppClipboard
-                     && !root.inAppClipboard.busy
+                     && !root.importBusy
                      && root.inAppClipboard.currentHubPath !== undefined
                      && String(root.inAppClipboard.currentHubPath).trim().length > 0
-            text: qsTr("Import File...")
+            text: root.importBusy ? qsTr("Importing... %1%").arg(root.importProgressPercent) : qsTr("Import File...")
 
             onTriggered: importResourcesDialog.open()
         }
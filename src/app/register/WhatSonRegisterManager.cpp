@@ -1,5 +1,7 @@
 #include "app/register/WhatSonRegisterManager.hpp"
 
+#include "app/store/settings/WhatSonSettingsStore.hpp"
+
 #if defined(WHATSON_IS_TRIAL_BUILD)
 #include "extension/trial/WhatSonTrialClientIdentityStore.hpp"
 #endif
@@ -8,7 +10,6 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
-#include <QSettings>
 
 #include <utility>
 
@@ -79,7 +80,7 @@ namespace
 
     bool loadSignedAuthenticationState(const QString& settingsKey)
     {
-        QSettings settings;
+        WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
         const QVariant rawValue = settings.value(settingsKey);
         if (!rawValue.isValid())
         {
@@ -92,7 +93,6 @@ namespace
             if (settings.contains(settingsKey))
             {
                 settings.remove(settingsKey);
-                settings.sync();
             }
             return false;
         }
@@ -102,7 +102,6 @@ namespace
         if (parseError.error != QJsonParseError::NoError || !document.isObject())
         {
             settings.remove(settingsKey);
-            settings.sync();
             return false;
         }
 
@@ -113,7 +112,6 @@ namespace
             || !root.value(QStringLiteral("authenticated")).toBool(false))
         {
             settings.remove(settingsKey);
-            settings.sync();
             return false;
         }
 
@@ -128,7 +126,6 @@ namespace
         if (persistedSignature != expectedSignature)
         {
             settings.remove(settingsKey);
-            settings.sync();
             return false;
         }
 
@@ -137,14 +134,13 @@ namespace
 
     void clearPersistedAuthenticationState(const QString& settingsKey)
     {
-        QSettings settings;
+        WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
         if (!settings.contains(settingsKey))
         {
             return;
         }
 
         settings.remove(settingsKey);
-        settings.sync();
     }
 } // namespace
 #endif
@@ -176,8 +172,7 @@ void WhatSonRegisterManager::reload()
 #if defined(WHATSON_IS_TRIAL_BUILD)
     setAuthenticatedState(loadSignedAuthenticationState(m_authenticatedSettingsKey), true);
 #else
-    QSettings settings;
-    setAuthenticatedState(settings.value(m_authenticatedSettingsKey, false).toBool(), true);
+    setAuthenticatedState(WhatSonSettingsStore::shared().boolValue(m_authenticatedSettingsKey), true);
 #endif
 }
 
@@ -201,14 +196,12 @@ void WhatSonRegisterManager::setAuthenticated(const bool authenticated)
         return;
     }
 
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     settings.setValue(m_authenticatedSettingsKey, signedRecord);
-    settings.sync();
     setAuthenticatedState(true, true);
 #else
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     settings.setValue(m_authenticatedSettingsKey, authenticated);
-    settings.sync();
     setAuthenticatedState(authenticated, true);
 #endif
 }
@@ -25,6 +25,10 @@ namespace
             plan,
             QStringLiteral("libraryNoteMutationController"),
             objects.libraryNoteMutationController);
+        appendContextObjectBinding(
+            plan,
+            QStringLiteral("hubMutationJournalController"),
+            objects.hubMutationJournalController);
         appendContextObjectBinding(plan, QStringLiteral("projectsHierarchyController"), objects.projectsHierarchyController);
         appendContextObjectBinding(plan, QStringLiteral("bookmarksHierarchyController"), objects.bookmarksHierarchyController);
         appendContextObjectBinding(plan, QStringLiteral("tagsHierarchyController"), objects.tagsHierarchyController);
@@ -50,6 +54,7 @@ namespace
         appendContextObjectBinding(plan, QStringLiteral("weekCalendarController"), objects.weekCalendarController);
         appendContextObjectBinding(plan, QStringLiteral("yearCalendarController"), objects.yearCalendarController);
         appendContextObjectBinding(plan, QStringLiteral("panelControllerRegistry"), objects.panelControllerRegistry);
+        appendContextObjectBinding(plan, QStringLiteral("memoryAccounting"), objects.memoryAccounting);
 
         return lvrs::applyQmlContextBindPlan(engine, plan);
     }
@@ -11,6 +11,7 @@ namespace WhatSon::Runtime::Bootstrap
     {
         QObject* libraryHierarchyController = nullptr;
         QObject* libraryNoteMutationController = nullptr;
+        QObject* hubMutationJournalController = nullptr;
         QObject* projectsHierarchyController = nullptr;
         QObject* bookmarksHierarchyController = nullptr;
         QObject* tagsHierarchyController = nullptr;
@@ -33,6 +34,7 @@ namespace WhatSon::Runtime::Bootstrap
         QObject* weekCalendarController = nullptr;
         QObject* yearCalendarController = nullptr;
         QObject* panelControllerRegistry = nullptr;
+        QObject* memoryAccounting = nullptr;
     };
 
     lvrs::QmlContextBindResult bindWorkspaceContextObjects(
@@ -5,6 +5,7 @@
 #include "app/models/panel/HierarchyInteractionBridge.hpp"
 #include "app/models/panel/NoteListModelContractBridge.hpp"
 #include "app/models/sidebar/SidebarHierarchyInteractionController.hpp"
+#include "app/models/sidebar/SidebarHierarchyItemIndex.hpp"
 
 namespace WhatSon::Runtime::Bootstrap
 {
@@ -34,7 +35,9 @@ namespace
             whatsonInternalCreatableType<HierarchyInteractionBridge>(
                 QStringLiteral("HierarchyInteractionBridge")),
             whatsonInternalCreatableType<SidebarHierarchyInteractionController>(
-                QStringLiteral("SidebarHierarchyInteractionController"))
+                QStringLiteral("SidebarHierarchyInteractionController")),
+            whatsonInternalCreatableType<SidebarHierarchyItemIndex>(
+                QStringLiteral("SidebarHierarchyItemIndex"))
         };
     }
 
@@ -3,6 +3,7 @@
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
 #include "app/models/file/hub/WhatSonHubRuntimeStore.hpp"
+#include "app/models/file/validator/WhatSonDomainLoadFailureLog.hpp"
 #include "app/models/hierarchy/bookmarks/BookmarksHierarchyController.hpp"
 #include "app/models/hierarchy/event/EventHierarchyController.hpp"
 #include "app/models/hierarchy/library/LibraryHierarchyController.hpp"
@@ -13,13 +14,23 @@
 #include "app/models/hierarchy/tags/TagsHierarchyController.hpp"
 
 #include <QDebug>
-#include <QStringList>
+#include <QMap>
 
-WhatSonStartupRuntimeCoordinator::WhatSonStartupRuntimeCoordinator() = default;
+#include <algorithm>
+
+WhatSonStartupRuntimeCoordinator::WhatSonStartupRuntimeCoordinator()
+{
+    m_degradedRetryTimer.setSingleShot(true);
+    QObject::connect(&m_degradedRetryTimer, &QTimer::timeout, [this]()
+    {
+        retryDegradedDomains();
+    });
+}
 
 WhatSonStartupRuntimeCoordinator::WhatSonStartupRuntimeCoordinator(const RuntimeTargets& targets)
-    : m_targets(targets)
+    : WhatSonStartupRuntimeCoordinator()
 {
+    m_targets = targets;
 }
 
 void WhatSonStartupRuntimeCoordinator::setTargets(const RuntimeTargets& targets)
@@ -41,6 +52,7 @@ void WhatSonStartupRuntimeCoordinator::applyHubRuntimeState(
         return;
     }
 
+    m_targets.hubRuntimeStore->markUsed(normalizedHubPath);
     m_targets.libraryController->setHubStore(m_targets.hubRuntimeStore->hub(normalizedHubPath));
 
     if (m_targets.tagsController != nullptr)
@@ -73,6 +85,21 @@ bool WhatSonStartupRuntimeCoordinator::loadHubIntoRuntimeWithRequestedDomains(
         return false;
     }
 
+    // Any load that includes the hub runtime store is a mount and starts a fresh retry budget, even for the hub that
+    // is already mounted. Degraded-domain retries leave the store out, so they keep counting attempts.
+    if (normalizedHubPath != m_degradedHubPath)
+    {
+        m_degradedRetryTimer.stop();
+        m_degradedHubPath = normalizedHubPath;
+        m_degradedDomains.clear();
+        m_degradedRetryAttempt = 0;
+    }
+    else if (requestedDomains.hubRuntimeStore)
+    {
+        m_degradedRetryTimer.stop();
+        m_degradedRetryAttempt = 0;
+    }
+
     WhatSon::Debug::trace(
         QStringLiteral("startup.runtime"),
         QStringLiteral("loadFromWshub.begin"),
@@ -124,7 +151,6 @@ bool WhatSonStartupRuntimeCoordinator::loadHubIntoRuntimeWithRequestedDomains(
             continue;
         }
 
-        failedDomains.push_back(result.domain);
         const QString domainErrorMessage = result.error.trimmed().isEmpty()
                                                ? QStringLiteral("unknown load error")
                                                : result.error.trimmed();
@@ -133,9 +159,14 @@ bool WhatSonStartupRuntimeCoordinator::loadHubIntoRuntimeWithRequestedDomains(
                    .arg(result.domain, domainErrorMessage);
         WhatSon::Debug::trace(
             QStringLiteral("startup.runtime"),
-            QStringLiteral("load.failed"),
+            result.degraded ? QStringLiteral("load.degraded") : QStringLiteral("load.failed"),
             QStringLiteral("domain=%1 reason=%2").arg(result.domain, domainErrorMessage));
+        if (!result.degraded)
+        {
+            failedDomains.push_back(result.domain);
+        }
     }
+    updateDegradedDomains(normalizedHubPath, loadResults);
 
     if (!loadSucceeded)
     {
@@ -177,6 +208,124 @@ bool WhatSonStartupRuntimeCoordinator::loadHubIntoRuntimeWithRequestedDomains(
     return true;
 }
 
+void WhatSonStartupRuntimeCoordinator::updateDegradedDomains(
+    const QString& normalizedHubPath,
+    const QVector<IWhatSonRuntimeParallelLoader::DomainLoadResult>& loadResults)
+{
+    // A retry that fails for every requested domain is reported as a failed load without degraded results, so the
+    // domains already known to be degraded stay degraded on any failure.
+    QMap<QString, QString> failedDomainErrors;
+    QStringList recoveredDomains;
+    for (const IWhatSonRuntimeParallelLoader::DomainLoadResult& result : loadResults)
+    {
+        if (result.succeeded)
+        {
+            recoveredDomains.push_back(result.domain);
+            m_degradedDomains.removeAll(result.domain);
+        }
+        else if (result.degraded || m_degradedDomains.contains(result.domain))
+        {
+            failedDomainErrors.insert(result.domain, result.error.trimmed());
+            if (!m_degradedDomains.contains(result.domain))
+            {
+                m_degradedDomains.push_back(result.domain);
+            }
+        }
+    }
+
+    QString logError;
+    if (!WhatSonDomainLoadFailureLog::update(normalizedHubPath, failedDomainErrors, recoveredDomains, &logError))
+    {
+        WhatSon::Debug::trace(
+            QStringLiteral("startup.runtime"),
+            QStringLiteral("domainFailureLog.failed"),
+            QStringLiteral("path=%1 reason=%2").arg(normalizedHubPath, logError));
+    }
+
+    scheduleDegradedRetry();
+}
+
+int WhatSonStartupRuntimeCoordinator::degradedRetryDelayMs(const int attempt) noexcept
+{
+    const int boundedAttempt = std::clamp(attempt, 0, 16);
+    return static_cast<int>(std::min<qint64>(
+        static_cast<qint64>(kDegradedRetryInitialDelayMs) << boundedAttempt,
+        kDegradedRetryMaxDelayMs));
+}
+
+void WhatSonStartupRuntimeCoordinator::scheduleDegradedRetry()
+{
+    if (m_degradedDomains.isEmpty())
+    {
+        m_degradedRetryTimer.stop();
+        m_degradedRetryAttempt = 0;
+        return;
+    }
+    if (m_degradedRetryTimer.isActive())
+    {
+        return;
+    }
+    if (m_degradedRetryAttempt >= kDegradedRetryMaxAttempts)
+    {
+        WhatSon::Debug::trace(
+            QStringLiteral("startup.runtime"),
+            QStringLiteral("degradedRetry.exhausted"),
+            QStringLiteral("path=%1 domains=%2 attempts=%3")
+                .arg(m_degradedHubPath, m_degradedDomains.join(QLatin1Char(',')))
+                .arg(m_degradedRetryAttempt));
+        return;
+    }
+
+    const int delayMs = degradedRetryDelayMs(m_degradedRetryAttempt);
+    m_degradedRetryTimer.start(delayMs);
+    WhatSon::Debug::trace(
+        QStringLiteral("startup.runtime"),
+        QStringLiteral("degradedRetry.scheduled"),
+        QStringLiteral("path=%1 domains=%2 attempt=%3 delayMs=%4")
+            .arg(m_degradedHubPath, m_degradedDomains.join(QLatin1Char(',')))
+            .arg(m_degradedRetryAttempt + 1)
+            .arg(delayMs));
+}
+
+QStringList WhatSonStartupRuntimeCoordinator::degradedDomains() const
+{
+    return m_degradedDomains;
+}
+
+bool WhatSonStartupRuntimeCoordinator::retryDegradedDomains(QString* errorMessage)
+{
+    m_degradedRetryTimer.stop();
+    if (m_degradedDomains.isEmpty() || m_degradedHubPath.isEmpty())
+    {
+        if (errorMessage != nullptr)
+        {
+            errorMessage->clear();
+        }
+        return true;
+    }
+
+    // Only the degraded domains are reloaded; healthy domains keep the state applied by the original mount.
+    IWhatSonRuntimeParallelLoader::RequestedDomains requestedDomains;
+    requestedDomains.library = m_degradedDomains.contains(QStringLiteral("library"));
+    requestedDomains.projects = m_degradedDomains.contains(QStringLiteral("projects"));
+    requestedDomains.bookmarks = m_degradedDomains.contains(QStringLiteral("bookmarks"));
+    requestedDomains.tags = m_degradedDomains.contains(QStringLiteral("tags"));
+    requestedDomains.resources = m_degradedDomains.contains(QStringLiteral("resources"));
+    requestedDomains.progress = m_degradedDomains.contains(QStringLiteral("progress"));
+    requestedDomains.event = m_degradedDomains.contains(QStringLiteral("event"));
+    requestedDomains.preset = m_degradedDomains.contains(QStringLiteral("preset"));
+    requestedDomains.hubRuntimeStore = false;
+
+    ++m_degradedRetryAttempt;
+    WhatSon::Debug::trace(
+        QStringLiteral("startup.runtime"),
+        QStringLiteral("degradedRetry.begin"),
+        QStringLiteral("path=%1 domains=%2 attempt=%3")
+            .arg(m_degradedHubPath, m_degradedDomains.join(QLatin1Char(',')))
+            .arg(m_degradedRetryAttempt));
+    return loadHubIntoRuntimeWithRequestedDomains(m_degradedHubPath, requestedDomains, errorMessage);
+}
+
 bool WhatSonStartupRuntimeCoordinator::loadHubIntoRuntime(const QString& hubPath, QString* errorMessage)
 {
     return loadHubIntoRuntimeWithRequestedDomains(
@@ -185,6 +334,64 @@ bool WhatSonStartupRuntimeCoordinator::loadHubIntoRuntime(const QString& hubPath
         errorMessage);
 }
 
+bool WhatSonStartupRuntimeCoordinator::loadHubsIntoRuntime(const QStringList& hubPaths, QString* errorMessage)
+{
+    QStringList normalizedHubPaths;
+    for (const QString& hubPath : hubPaths)
+    {
+        const QString normalizedHubPath = hubPath.trimmed().isEmpty()
+                                              ? QString()
+                                              : WhatSon::HubPath::normalizeAbsolutePath(hubPath);
+        if (!normalizedHubPath.isEmpty() && !normalizedHubPaths.contains(normalizedHubPath))
+        {
+            normalizedHubPaths.push_back(normalizedHubPath);
+        }
+    }
+    if (m_targets.hubRuntimeStore != nullptr && m_targets.hubRuntimeStore->maxMountedHubCount() > 0)
+    {
+        normalizedHubPaths = normalizedHubPaths.mid(0, m_targets.hubRuntimeStore->maxMountedHubCount());
+    }
+
+    // A single hub keeps the parallel loader path, where its runtime slot builds alongside the domain snapshots.
+    if (normalizedHubPaths.size() <= 1 || m_targets.hubRuntimeStore == nullptr || m_parallelLoader == nullptr)
+    {
+        return loadHubIntoRuntime(normalizedHubPaths.value(0), errorMessage);
+    }
+
+    const QString activeHubPath = normalizedHubPaths.constFirst();
+    QStringList failedHubPaths;
+    QString mountError;
+    m_targets.hubRuntimeStore->loadManyFromWshubs(normalizedHubPaths, &failedHubPaths, &mountError);
+    WhatSon::Debug::trace(
+        QStringLiteral("startup.runtime"),
+        QStringLiteral("loadHubs.slotsMounted"),
+        QStringLiteral("active=%1 requested=%2 failed=%3")
+            .arg(activeHubPath)
+            .arg(normalizedHubPaths.size())
+            .arg(failedHubPaths.size()));
+    if (!failedHubPaths.isEmpty())
+    {
+        qWarning().noquote()
+            << QStringLiteral("Failed to mount resident WhatSon Hubs: %1").arg(mountError);
+    }
+    if (failedHubPaths.contains(WhatSon::HubPath::normalizePath(activeHubPath)))
+    {
+        // Reload through the regular path so the active hub reports its own per-domain failures.
+        return loadHubIntoRuntime(activeHubPath, errorMessage);
+    }
+
+    // The active hub's slot was built with the others, so only its domain controllers load here. This is still a
+    // mount, so it restarts the degraded-domain retry budget like loadHubIntoRuntime() does.
+    if (activeHubPath == m_degradedHubPath)
+    {
+        m_degradedRetryTimer.stop();
+        m_degradedRetryAttempt = 0;
+    }
+    IWhatSonRuntimeParallelLoader::RequestedDomains requestedDomains;
+    requestedDomains.hubRuntimeStore = false;
+    return loadHubIntoRuntimeWithRequestedDomains(activeHubPath, requestedDomains, errorMessage);
+}
+
 bool WhatSonStartupRuntimeCoordinator::reloadResourcesDomainIntoRuntime(const QString& hubPath, QString* errorMessage)
 {
     IWhatSonRuntimeParallelLoader::RequestedDomains requestedDomains;
@@ -3,6 +3,8 @@
 #include "app/runtime/threading/IWhatSonRuntimeParallelLoader.hpp"
 
 #include <QString>
+#include <QStringList>
+#include <QTimer>
 
 class LibraryHierarchyController;
 class ProjectsHierarchyController;
@@ -25,8 +27,21 @@ public:
     void setTargets(const RuntimeTargets& targets);
     void setParallelLoader(const IWhatSonRuntimeParallelLoader* loader);
     bool loadHubIntoRuntime(const QString& hubPath, QString* errorMessage = nullptr);
+    // Mounts every hub's runtime slot concurrently and binds the first one to the controllers. Hubs past the store's
+    // mounted-hub cap are ignored, and only a failure of the first hub fails the call.
+    bool loadHubsIntoRuntime(const QStringList& hubPaths, QString* errorMessage = nullptr);
     bool reloadResourcesDomainIntoRuntime(const QString& hubPath, QString* errorMessage = nullptr);
 
+    // Domains that failed while the rest of the hub mounted are retried in the background with exponential backoff
+    // until they load or the attempt budget runs out. Every mount restarts the budget.
+    static constexpr int kDegradedRetryInitialDelayMs = 2000;
+    static constexpr int kDegradedRetryMaxDelayMs = 60000;
+    static constexpr int kDegradedRetryMaxAttempts = 6;
+    static int degradedRetryDelayMs(int attempt) noexcept;
+
+    QStringList degradedDomains() const;
+    bool retryDegradedDomains(QString* errorMessage = nullptr);
+
 private:
     void applyHubRuntimeState(
         const QString& normalizedHubPath,
@@ -35,7 +50,15 @@ private:
         const QString& hubPath,
         const IWhatSonRuntimeParallelLoader::RequestedDomains& requestedDomains,
         QString* errorMessage);
+    void updateDegradedDomains(
+        const QString& normalizedHubPath,
+        const QVector<IWhatSonRuntimeParallelLoader::DomainLoadResult>& loadResults);
+    void scheduleDegradedRetry();
 
     RuntimeTargets m_targets;
     const IWhatSonRuntimeParallelLoader* m_parallelLoader = nullptr;
+    QString m_degradedHubPath;
+    QStringList m_degradedDomains;
+    int m_degradedRetryAttempt = 0;
+    QTimer m_degradedRetryTimer;
 };
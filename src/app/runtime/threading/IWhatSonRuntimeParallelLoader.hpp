@@ -34,6 +34,8 @@ public:
         QString domain;
         bool succeeded = false;
         QString error;
+        // Failed, but the rest of the hub was mounted; the domain's controller holds the error and can be reloaded.
+        bool degraded = false;
     };
 
     struct Targets
@@ -100,6 +100,8 @@ WhatSonRuntimeDomainSnapshots::SharedContext WhatSonRuntimeDomainSnapshots::buil
         return context;
     }
 
+    // Every domain loader of this pass reads the same resolved layout instead of probing the hub again.
+    context.layout = WhatSonHubLayout::cached(context.normalizedHubPath);
     context.succeeded = true;
     return context;
 }
@@ -496,14 +498,14 @@ WhatSonRuntimeDomainSnapshots::StringListSnapshot WhatSonRuntimeDomainSnapshots:
     return snapshot;
 }
 
-WhatSonRuntimeDomainSnapshots::StringListSnapshot WhatSonRuntimeDomainSnapshots::loadPreset(const QString& wshubPath)
+WhatSonRuntimeDomainSnapshots::PresetSnapshot WhatSonRuntimeDomainSnapshots::loadPreset(const QString& wshubPath)
 {
     return loadPreset(buildSharedContext(wshubPath));
 }
 
-WhatSonRuntimeDomainSnapshots::StringListSnapshot WhatSonRuntimeDomainSnapshots::loadPreset(const SharedContext& context)
+WhatSonRuntimeDomainSnapshots::PresetSnapshot WhatSonRuntimeDomainSnapshots::loadPreset(const SharedContext& context)
 {
-    StringListSnapshot snapshot;
+    PresetSnapshot snapshot;
     if (!context.succeeded)
     {
         snapshot.succeeded = false;
@@ -548,6 +550,7 @@ WhatSonRuntimeDomainSnapshots::StringListSnapshot WhatSonRuntimeDomainSnapshots:
         {
             snapshot.values.push_back(value);
         }
+        snapshot.queries.insert(store.presetQueries());
     }
 
     if (snapshot.sourceFilePath.isEmpty())
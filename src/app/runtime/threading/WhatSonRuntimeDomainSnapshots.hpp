@@ -1,14 +1,19 @@
 #pragma once
 
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
 #include "app/models/file/hub/WhatSonHubRuntimeStore.hpp"
 #include "app/models/hierarchy/WhatSonFolderDepthEntry.hpp"
 #include "app/models/hierarchy/library/LibraryNoteRecord.hpp"
+#include "app/models/hierarchy/preset/WhatSonPresetQuery.hpp"
 #include "app/models/hierarchy/tags/WhatSonTagDepthEntry.hpp"
 
+#include <QHash>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 
+#include <memory>
+
 class WhatSonRuntimeDomainSnapshots final
 {
 public:
@@ -18,6 +23,7 @@ public:
         QString error;
         QString normalizedHubPath;
         QStringList contentsDirectories;
+        std::shared_ptr<const WhatSonHubLayout> layout;
     };
 
     struct LibrarySnapshot
@@ -57,6 +63,16 @@ public:
         QStringList values;
     };
 
+    struct PresetSnapshot
+    {
+        bool succeeded = false;
+        QString error;
+        QString sourceFilePath;
+        bool fileFound = false;
+        QStringList values;
+        QHash<QString, WhatSonPresetQuery> queries;
+    };
+
     struct ProgressSnapshot
     {
         bool succeeded = false;
@@ -97,8 +113,8 @@ public:
     static ProgressSnapshot loadProgress(const SharedContext& context);
     static StringListSnapshot loadEvent(const QString& wshubPath);
     static StringListSnapshot loadEvent(const SharedContext& context);
-    static StringListSnapshot loadPreset(const QString& wshubPath);
-    static StringListSnapshot loadPreset(const SharedContext& context);
+    static PresetSnapshot loadPreset(const QString& wshubPath);
+    static PresetSnapshot loadPreset(const SharedContext& context);
     static TagsSnapshot loadTags(const QString& wshubPath);
     static TagsSnapshot loadTags(const SharedContext& context);
     static HubRuntimeSnapshot loadHubRuntime(const QString& wshubPath);
@@ -1,8 +1,7 @@
 #include "app/runtime/threading/WhatSonRuntimeParallelLoader.hpp"
 
-#include "backend/runtime/bootstrapparallel.h"
-
 #include "app/runtime/threading/WhatSonRuntimeDomainSnapshots.hpp"
+#include "app/runtime/threading/WhatSonRuntimeTaskGraph.hpp"
 #include "app/models/file/WhatSonDebugTrace.hpp"
 #include "app/models/file/hub/WhatSonHubRuntimeStore.hpp"
 #include "app/models/hierarchy/bookmarks/BookmarksHierarchyController.hpp"
@@ -15,22 +14,14 @@
 #include "app/models/hierarchy/tags/TagsHierarchyController.hpp"
 
 #include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
 #include <utility>
 
 namespace
 {
-    constexpr int kDomainTaskPriorityStep = 10;
-
-    WhatSonRuntimeParallelLoader::DomainLoadResult domainLoadResultFromBootstrapResult(
-        const QString& domain,
-        const lvrs::BootstrapParallelTaskResult& taskResult)
-    {
-        WhatSonRuntimeParallelLoader::DomainLoadResult result;
-        result.domain = domain;
-        result.succeeded = taskResult.loadOk;
-        result.error = taskResult.errorMessage.trimmed();
-        return result;
-    }
+    // Graph node that resolves the hub layout and contents directories every domain load reads.
+    const QString kHubLayoutNode = QStringLiteral("hub.layout");
 } // namespace
 
 bool WhatSonRuntimeParallelLoader::loadFromWshub(
@@ -69,6 +60,7 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
         return false;
     }
 
+    WhatSonRuntimeDomainSnapshots::SharedContext sharedContext;
     WhatSonRuntimeDomainSnapshots::LibrarySnapshot librarySnapshot;
     WhatSonRuntimeDomainSnapshots::ProjectsSnapshot projectsSnapshot;
     WhatSonRuntimeDomainSnapshots::BookmarksSnapshot bookmarksSnapshot;
@@ -76,27 +68,34 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
     WhatSonRuntimeDomainSnapshots::StringListSnapshot resourcesSnapshot;
     WhatSonRuntimeDomainSnapshots::ProgressSnapshot progressSnapshot;
     WhatSonRuntimeDomainSnapshots::StringListSnapshot eventSnapshot;
-    WhatSonRuntimeDomainSnapshots::StringListSnapshot presetSnapshot;
+    WhatSonRuntimeDomainSnapshots::PresetSnapshot presetSnapshot;
     WhatSonRuntimeDomainSnapshots::HubRuntimeSnapshot hubRuntimeSnapshot;
 
     bool hasLibraryTask = false;
     bool hasProjectsTask = false;
     bool hasBookmarksTask = false;
-    bool deriveBookmarksFromLibrary = false;
     bool hasTagsTask = false;
     bool hasResourcesTask = false;
     bool hasProgressTask = false;
     bool hasEventTask = false;
     bool hasPresetTask = false;
 
-    const WhatSonRuntimeDomainSnapshots::SharedContext sharedContext =
-        WhatSonRuntimeDomainSnapshots::buildSharedContext(normalizedPath);
-
-    QList<lvrs::BootstrapParallelTask> bootstrapTasks;
-    bootstrapTasks.reserve(9);
-    QVector<int> bootstrapTaskResultIndexes;
-    bootstrapTaskResultIndexes.reserve(9);
-    int derivedBookmarksResultIndex = -1;
+    // Domain loads form a small dependency graph: every domain reads the hub layout, and bookmarks are derived from
+    // the library snapshot as soon as it is ready instead of after the slowest unrelated domain has finished.
+    WhatSonRuntimeTaskGraph taskGraph;
+    QHash<QString, int> resultIndexesByDomain;
+    taskGraph.addNode(
+        kHubLayoutNode,
+        {},
+        [&sharedContext, &normalizedPath](QString* error) -> bool
+        {
+            sharedContext = WhatSonRuntimeDomainSnapshots::buildSharedContext(normalizedPath);
+            if (!sharedContext.succeeded && error != nullptr)
+            {
+                *error = sharedContext.error;
+            }
+            return sharedContext.succeeded;
+        });
 
     auto addImmediateFailure = [&results](const QString& domain, const QString& error)
     {
@@ -109,58 +108,51 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
 
     auto addSnapshotTask = [
         &results,
-        &bootstrapTasks,
-        &bootstrapTaskResultIndexes,
-        &sharedContext,
+        &resultIndexesByDomain,
+        &taskGraph,
         &normalizedPath](
         const QString& domain,
+        const QStringList& inputs,
         auto* snapshot,
         auto loader)
     {
         results.push_back(DomainLoadResult{});
         results.back().domain = domain;
-        const int resultIndex = results.size() - 1;
-
-        lvrs::BootstrapParallelTask task;
-        task.name = domain;
-        task.priority = bootstrapTasks.size() * kDomainTaskPriorityStep;
-        task.fatal = true;
-        task.metadata.insert(QStringLiteral("path"), normalizedPath);
-        task.metadata.insert(QStringLiteral("domain"), domain);
-        task.load = [
-            snapshot,
-            loader,
-            sharedContext,
-            domain,
-            normalizedPath](const lvrs::BootstrapParallelTaskContext&, QVariant*, QString* error) -> bool
-        {
-            WhatSon::Debug::trace(
-                QStringLiteral("runtime.parallel"),
-                QStringLiteral("task.begin"),
-                QStringLiteral("domain=%1 path=%2").arg(domain, normalizedPath));
+        resultIndexesByDomain.insert(domain, results.size() - 1);
 
-            *snapshot = loader(sharedContext);
-            if (!snapshot->succeeded && error != nullptr)
+        taskGraph.addNode(
+            domain,
+            inputs,
+            [snapshot, loader, domain, normalizedPath](QString* error) -> bool
             {
-                *error = snapshot->error;
-            }
+                WhatSon::Debug::trace(
+                    QStringLiteral("runtime.parallel"),
+                    QStringLiteral("task.begin"),
+                    QStringLiteral("domain=%1 path=%2").arg(domain, normalizedPath));
 
-            WhatSon::Debug::trace(
-                QStringLiteral("runtime.parallel"),
-                QStringLiteral("load.completed"),
-                QStringLiteral("domain=%1 succeeded=%2 error=%3")
-                .arg(domain)
-                .arg(snapshot->succeeded ? QStringLiteral("1") : QStringLiteral("0"))
-                .arg(snapshot->error.trimmed()));
-            return snapshot->succeeded;
-        };
+                *snapshot = loader();
+                if (!snapshot->succeeded && error != nullptr)
+                {
+                    *error = snapshot->error;
+                }
+
+                WhatSon::Debug::trace(
+                    QStringLiteral("runtime.parallel"),
+                    QStringLiteral("load.completed"),
+                    QStringLiteral("domain=%1 succeeded=%2 error=%3")
+                    .arg(domain)
+                    .arg(snapshot->succeeded ? QStringLiteral("1") : QStringLiteral("0"))
+                    .arg(snapshot->error.trimmed()));
+                return snapshot->succeeded;
+            });
 
         WhatSon::Debug::trace(
             QStringLiteral("runtime.parallel"),
             QStringLiteral("task.queued"),
-            QStringLiteral("domain=%1 path=%2").arg(domain, normalizedPath));
-        bootstrapTaskResultIndexes.push_back(resultIndex);
-        bootstrapTasks.append(std::move(task));
+            QStringLiteral("domain=%1 inputs=%2 path=%3").arg(
+                domain,
+                inputs.join(QLatin1Char(',')),
+                normalizedPath));
     };
 
     if (requestedDomains.library)
@@ -174,10 +166,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasLibraryTask = true;
             addSnapshotTask(
                 QStringLiteral("library"),
+                {kHubLayoutNode},
                 &librarySnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadLibrary(context);
+                    return WhatSonRuntimeDomainSnapshots::loadLibrary(sharedContext);
                 });
         }
     }
@@ -193,10 +186,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasProjectsTask = true;
             addSnapshotTask(
                 QStringLiteral("projects"),
+                {kHubLayoutNode},
                 &projectsSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadProjects(context);
+                    return WhatSonRuntimeDomainSnapshots::loadProjects(sharedContext);
                 });
         }
     }
@@ -207,27 +201,29 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
         {
             addImmediateFailure(QStringLiteral("bookmarks"), QStringLiteral("Target controller is null."));
         }
+        else if (hasLibraryTask)
+        {
+            hasBookmarksTask = true;
+            addSnapshotTask(
+                QStringLiteral("bookmarks"),
+                {QStringLiteral("library")},
+                &bookmarksSnapshot,
+                [&librarySnapshot]()
+                {
+                    return WhatSonRuntimeDomainSnapshots::buildBookmarks(librarySnapshot.allNotes);
+                });
+        }
         else
         {
             hasBookmarksTask = true;
-            if (hasLibraryTask)
-            {
-                deriveBookmarksFromLibrary = true;
-                DomainLoadResult result;
-                result.domain = QStringLiteral("bookmarks");
-                results.push_back(result);
-                derivedBookmarksResultIndex = results.size() - 1;
-            }
-            else
-            {
-                addSnapshotTask(
-                    QStringLiteral("bookmarks"),
-                    &bookmarksSnapshot,
-                    [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
-                    {
-                        return WhatSonRuntimeDomainSnapshots::loadBookmarks(context);
-                    });
-            }
+            addSnapshotTask(
+                QStringLiteral("bookmarks"),
+                {kHubLayoutNode},
+                &bookmarksSnapshot,
+                [&sharedContext]()
+                {
+                    return WhatSonRuntimeDomainSnapshots::loadBookmarks(sharedContext);
+                });
         }
     }
 
@@ -242,10 +238,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasTagsTask = true;
             addSnapshotTask(
                 QStringLiteral("tags"),
+                {kHubLayoutNode},
                 &tagsSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadTags(context);
+                    return WhatSonRuntimeDomainSnapshots::loadTags(sharedContext);
                 });
         }
     }
@@ -261,10 +258,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasResourcesTask = true;
             addSnapshotTask(
                 QStringLiteral("resources"),
+                {kHubLayoutNode},
                 &resourcesSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadResources(context);
+                    return WhatSonRuntimeDomainSnapshots::loadResources(sharedContext);
                 });
         }
     }
@@ -280,10 +278,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasProgressTask = true;
             addSnapshotTask(
                 QStringLiteral("progress"),
+                {kHubLayoutNode},
                 &progressSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadProgress(context);
+                    return WhatSonRuntimeDomainSnapshots::loadProgress(sharedContext);
                 });
         }
     }
@@ -299,10 +298,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasEventTask = true;
             addSnapshotTask(
                 QStringLiteral("event"),
+                {kHubLayoutNode},
                 &eventSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadEvent(context);
+                    return WhatSonRuntimeDomainSnapshots::loadEvent(sharedContext);
                 });
         }
     }
@@ -318,10 +318,11 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             hasPresetTask = true;
             addSnapshotTask(
                 QStringLiteral("preset"),
+                {kHubLayoutNode},
                 &presetSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadPreset(context);
+                    return WhatSonRuntimeDomainSnapshots::loadPreset(sharedContext);
                 });
         }
     }
@@ -336,69 +337,67 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
         {
             addSnapshotTask(
                 QStringLiteral("hub.runtime"),
+                {kHubLayoutNode},
                 &hubRuntimeSnapshot,
-                [](const WhatSonRuntimeDomainSnapshots::SharedContext& context)
+                [&sharedContext]()
                 {
-                    return WhatSonRuntimeDomainSnapshots::loadHubRuntime(context);
+                    return WhatSonRuntimeDomainSnapshots::loadHubRuntime(sharedContext);
                 });
         }
     }
 
-    lvrs::BootstrapParallelRunOptions bootstrapOptions;
-    bootstrapOptions.skipApplyOnLoadFailure = true;
-    bootstrapOptions.logDiagnostics = true;
-
-    const lvrs::BootstrapParallelRunResult bootstrapResult =
-        lvrs::runBootstrapParallelTasks(bootstrapTasks, bootstrapOptions);
-    for (const lvrs::BootstrapParallelTaskResult& taskResult : bootstrapResult.taskResults)
+    const WhatSonRuntimeTaskGraph::RunResult graphResult = taskGraph.run();
+    for (const WhatSonRuntimeTaskGraph::NodeResult& nodeResult : graphResult.nodes)
     {
-        if (taskResult.index < 0 || taskResult.index >= bootstrapTaskResultIndexes.size())
-        {
-            continue;
-        }
-
-        const int resultIndex = bootstrapTaskResultIndexes.at(taskResult.index);
-        if (resultIndex < 0 || resultIndex >= results.size())
+        const auto resultIndex = resultIndexesByDomain.constFind(nodeResult.name);
+        if (resultIndex == resultIndexesByDomain.constEnd())
         {
             continue;
         }
 
-        results[resultIndex] = domainLoadResultFromBootstrapResult(
-            results.at(resultIndex).domain,
-            taskResult);
+        DomainLoadResult& result = results[resultIndex.value()];
+        result.succeeded = nodeResult.succeeded;
+        result.error = nodeResult.error;
+    }
+    if (!graphResult.error.isEmpty())
+    {
+        addImmediateFailure(QStringLiteral("runtime"), graphResult.error);
     }
 
-    if (deriveBookmarksFromLibrary)
+    // A failed domain load does not fail the mount. Domains whose graph node failed are applied as degraded, so
+    // their controllers report the error while the healthy domains stay usable and the caller can retry them. The
+    // mount itself still fails when the graph is malformed, the hub runtime state is missing, a requested domain had
+    // no target, or nothing loaded at all.
+    bool mountable = graphResult.error.isEmpty();
+    int succeededCount = 0;
+    int failedCount = 0;
+    QStringList degradedDomains;
+    for (DomainLoadResult& result : results)
     {
-        if (librarySnapshot.succeeded)
+        if (result.succeeded)
         {
-            bookmarksSnapshot = WhatSonRuntimeDomainSnapshots::buildBookmarks(librarySnapshot.allNotes);
+            ++succeededCount;
+            continue;
         }
-        else
+
+        ++failedCount;
+        result.degraded = resultIndexesByDomain.contains(result.domain)
+            && result.domain != QStringLiteral("hub.runtime");
+        if (result.degraded)
         {
-            bookmarksSnapshot.succeeded = false;
-            bookmarksSnapshot.error = librarySnapshot.error.trimmed().isEmpty()
-                                          ? QStringLiteral("Library snapshot failed while deriving bookmarks.")
-                                          : librarySnapshot.error;
-            bookmarksSnapshot.bookmarkedNotes.clear();
+            degradedDomains.push_back(result.domain);
         }
-
-        if (derivedBookmarksResultIndex >= 0 && derivedBookmarksResultIndex < results.size())
+        else
         {
-            DomainLoadResult& bookmarksResult = results[derivedBookmarksResultIndex];
-            bookmarksResult.succeeded = bookmarksSnapshot.succeeded;
-            bookmarksResult.error = bookmarksSnapshot.error;
+            mountable = false;
         }
     }
-
-    bool allSucceeded = true;
-    int failedCount = 0;
-    for (const DomainLoadResult& result : results)
+    mountable = mountable && succeededCount > 0;
+    if (!mountable)
     {
-        if (!result.succeeded)
+        for (DomainLoadResult& result : results)
         {
-            allSucceeded = false;
-            ++failedCount;
+            result.degraded = false;
         }
     }
 
@@ -407,24 +406,44 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
         *outResults = results;
     }
 
-    if (!allSucceeded)
+    if (!mountable)
     {
         WhatSon::Debug::traceSelf(this,
                                   QStringLiteral("runtime.parallel"),
                                   QStringLiteral("loadFromWshub.failed"),
-                                  QStringLiteral("path=%1 totalDomains=%2 failedDomains=%3 elapsedMs=%4 applySkipped=1")
+                                  QStringLiteral("path=%1 totalDomains=%2 failedDomains=%3 elapsedMs=%4 %5 applySkipped=1")
                                       .arg(normalizedPath)
                                       .arg(results.size())
                                       .arg(failedCount)
-                                      .arg(totalElapsedTimer.elapsed()));
+                                      .arg(totalElapsedTimer.elapsed())
+                                      .arg(WhatSonRuntimeTaskGraph::formatCriticalPath(graphResult)));
         return false;
     }
 
+    // Skipped nodes never ran their loader, so their snapshot carries no error; the graph reports the upstream one.
+    auto domainError = [&results](const QString& domain) -> QString
+    {
+        for (const DomainLoadResult& result : results)
+        {
+            if (result.domain == domain)
+            {
+                return result.error;
+            }
+        }
+        return {};
+    };
+
     if (requestedDomains.hubRuntimeStore && targets.hubRuntimeStore != nullptr)
     {
-        *targets.hubRuntimeStore = hubRuntimeSnapshot.store;
+        targets.hubRuntimeStore->mountFrom(hubRuntimeSnapshot.store);
     }
 
+    // Projects and Progress list the same notes as the library; hand them the library's index instead of letting
+    // each controller walk the hub again while applying.
+    // A degraded library has no index to share, so they fall back to reading the hub themselves.
+    const bool libraryIndexed = hasLibraryTask && librarySnapshot.succeeded;
+    const QVector<LibraryNoteRecord> indexedNotes = librarySnapshot.allNotes;
+
     if (hasLibraryTask)
     {
         targets.libraryController->applyRuntimeSnapshot(
@@ -435,16 +454,25 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             std::move(librarySnapshot.folderEntries),
             std::move(librarySnapshot.foldersFilePath),
             librarySnapshot.succeeded,
-            std::move(librarySnapshot.error));
+            domainError(QStringLiteral("library")));
     }
 
-    if (hasProjectsTask)
+    if (hasProjectsTask && libraryIndexed)
+    {
+        targets.projectsController->applyRuntimeSnapshot(
+            std::move(projectsSnapshot.projectEntries),
+            std::move(projectsSnapshot.projectsFilePath),
+            indexedNotes,
+            projectsSnapshot.succeeded,
+            domainError(QStringLiteral("projects")));
+    }
+    else if (hasProjectsTask)
     {
         targets.projectsController->applyRuntimeSnapshot(
             std::move(projectsSnapshot.projectEntries),
             std::move(projectsSnapshot.projectsFilePath),
             projectsSnapshot.succeeded,
-            std::move(projectsSnapshot.error));
+            domainError(QStringLiteral("projects")));
     }
 
     if (hasBookmarksTask)
@@ -452,7 +480,7 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
         targets.bookmarksController->applyRuntimeSnapshot(
             std::move(bookmarksSnapshot.bookmarkedNotes),
             bookmarksSnapshot.succeeded,
-            std::move(bookmarksSnapshot.error));
+            domainError(QStringLiteral("bookmarks")));
     }
 
     if (hasTagsTask)
@@ -461,7 +489,7 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             std::move(tagsSnapshot.entries),
             std::move(tagsSnapshot.tagsFilePath),
             tagsSnapshot.succeeded,
-            std::move(tagsSnapshot.error));
+            domainError(QStringLiteral("tags")));
     }
 
     if (hasResourcesTask)
@@ -470,17 +498,27 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             std::move(resourcesSnapshot.values),
             std::move(resourcesSnapshot.sourceFilePath),
             resourcesSnapshot.succeeded,
-            std::move(resourcesSnapshot.error));
+            domainError(QStringLiteral("resources")));
     }
 
-    if (hasProgressTask)
+    if (hasProgressTask && libraryIndexed)
+    {
+        targets.progressController->applyRuntimeSnapshot(
+            progressSnapshot.progressValue,
+            std::move(progressSnapshot.progressStates),
+            std::move(progressSnapshot.sourceFilePath),
+            indexedNotes,
+            progressSnapshot.succeeded,
+            domainError(QStringLiteral("progress")));
+    }
+    else if (hasProgressTask)
     {
         targets.progressController->applyRuntimeSnapshot(
             progressSnapshot.progressValue,
             std::move(progressSnapshot.progressStates),
             std::move(progressSnapshot.sourceFilePath),
             progressSnapshot.succeeded,
-            std::move(progressSnapshot.error));
+            domainError(QStringLiteral("progress")));
     }
 
     if (hasEventTask)
@@ -489,25 +527,28 @@ bool WhatSonRuntimeParallelLoader::loadFromWshub(
             std::move(eventSnapshot.values),
             std::move(eventSnapshot.sourceFilePath),
             eventSnapshot.succeeded,
-            std::move(eventSnapshot.error));
+            domainError(QStringLiteral("event")));
     }
 
     if (hasPresetTask)
     {
         targets.presetController->applyRuntimeSnapshot(
             std::move(presetSnapshot.values),
+            std::move(presetSnapshot.queries),
             std::move(presetSnapshot.sourceFilePath),
             presetSnapshot.succeeded,
-            std::move(presetSnapshot.error));
+            domainError(QStringLiteral("preset")));
     }
 
     WhatSon::Debug::traceSelf(this,
                               QStringLiteral("runtime.parallel"),
                               QStringLiteral("loadFromWshub.success"),
-                              QStringLiteral("path=%1 totalDomains=%2 failedDomains=%3 elapsedMs=%4")
+                              QStringLiteral("path=%1 totalDomains=%2 failedDomains=%3 degradedDomains=%4 elapsedMs=%5 %6")
                               .arg(normalizedPath)
                               .arg(results.size())
                               .arg(failedCount)
-                              .arg(totalElapsedTimer.elapsed()));
+                              .arg(degradedDomains.join(QLatin1Char(',')))
+                              .arg(totalElapsedTimer.elapsed())
+                              .arg(WhatSonRuntimeTaskGraph::formatCriticalPath(graphResult)));
     return true;
 }
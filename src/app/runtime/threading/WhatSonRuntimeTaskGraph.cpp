@@ -0,0 +1,289 @@
+#include "app/runtime/threading/WhatSonRuntimeTaskGraph.hpp"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <utility>
+
+struct WhatSonRuntimeTaskGraph::Execution
+{
+    QMutex mutex;
+    QThreadPool pool;
+    QElapsedTimer timer;
+    QVector<QVector<int>> dependents;
+    QVector<int> pendingInputCounts;
+    QVector<int> failedInputIndexes;
+    RunResult* result = nullptr;
+};
+
+bool WhatSonRuntimeTaskGraph::addNode(QString name, QStringList inputs, Run run, QString* errorMessage)
+{
+    name = name.trimmed();
+    if (name.isEmpty() || contains(name))
+    {
+        if (errorMessage != nullptr)
+        {
+            *errorMessage = name.isEmpty()
+                                ? QStringLiteral("Task graph node name must not be empty.")
+                                : QStringLiteral("Task graph node is already defined: %1").arg(name);
+        }
+        return false;
+    }
+
+    for (QString& input : inputs)
+    {
+        input = input.trimmed();
+    }
+    inputs.removeAll(QString());
+    inputs.removeDuplicates();
+    m_nodes.push_back(Node{std::move(name), std::move(inputs), std::move(run)});
+    return true;
+}
+
+bool WhatSonRuntimeTaskGraph::contains(const QString& name) const
+{
+    return std::any_of(
+        m_nodes.cbegin(),
+        m_nodes.cend(),
+        [&name](const Node& node)
+        {
+            return node.name == name;
+        });
+}
+
+int WhatSonRuntimeTaskGraph::nodeCount() const noexcept
+{
+    return static_cast<int>(m_nodes.size());
+}
+
+void WhatSonRuntimeTaskGraph::setMaxWorkerCount(const int count) noexcept
+{
+    m_maxWorkerCount = count;
+}
+
+WhatSonRuntimeTaskGraph::RunResult WhatSonRuntimeTaskGraph::run() const
+{
+    RunResult result;
+    const int nodeCount = static_cast<int>(m_nodes.size());
+    result.nodes.reserve(nodeCount);
+
+    QHash<QString, int> indexesByName;
+    indexesByName.reserve(nodeCount);
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        indexesByName.insert(m_nodes.at(index).name, index);
+        NodeResult nodeResult;
+        nodeResult.name = m_nodes.at(index).name;
+        nodeResult.inputs = m_nodes.at(index).inputs;
+        result.nodes.push_back(std::move(nodeResult));
+    }
+
+    Execution execution;
+    execution.result = &result;
+    execution.dependents.resize(nodeCount);
+    execution.pendingInputCounts.fill(0, nodeCount);
+    execution.failedInputIndexes.fill(-1, nodeCount);
+    QVector<QVector<int>> inputIndexes(nodeCount);
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        for (const QString& input : m_nodes.at(index).inputs)
+        {
+            const auto inputIndex = indexesByName.constFind(input);
+            if (inputIndex == indexesByName.constEnd())
+            {
+                result.error = QStringLiteral("Task graph node %1 reads undefined input %2.").arg(
+                    m_nodes.at(index).name,
+                    input);
+                return result;
+            }
+            inputIndexes[index].push_back(inputIndex.value());
+            execution.dependents[inputIndex.value()].push_back(index);
+            ++execution.pendingInputCounts[index];
+        }
+    }
+
+    // Kahn's order doubles as the cycle check and as the walk order for the critical path.
+    QVector<int> topologicalOrder;
+    topologicalOrder.reserve(nodeCount);
+    {
+        QVector<int> remainingInputCounts = execution.pendingInputCounts;
+        for (int index = 0; index < nodeCount; ++index)
+        {
+            if (remainingInputCounts.at(index) == 0)
+            {
+                topologicalOrder.push_back(index);
+            }
+        }
+        for (qsizetype cursor = 0; cursor < topologicalOrder.size(); ++cursor)
+        {
+            for (const int dependent : std::as_const(execution.dependents.at(topologicalOrder.at(cursor))))
+            {
+                if (--remainingInputCounts[dependent] == 0)
+                {
+                    topologicalOrder.push_back(dependent);
+                }
+            }
+        }
+        if (topologicalOrder.size() != nodeCount)
+        {
+            QStringList cycleNodes;
+            for (int index = 0; index < nodeCount; ++index)
+            {
+                if (remainingInputCounts.at(index) > 0)
+                {
+                    cycleNodes.push_back(m_nodes.at(index).name);
+                }
+            }
+            result.error = QStringLiteral("Task graph has a dependency cycle through: %1").arg(
+                cycleNodes.join(QStringLiteral(", ")));
+            return result;
+        }
+    }
+
+    const int workerCount = m_maxWorkerCount > 0 ? m_maxWorkerCount : QThread::idealThreadCount();
+    execution.pool.setMaxThreadCount(std::max(1, workerCount));
+    // Roots are collected up front: once the first one runs, workers update the pending counts concurrently.
+    QVector<int> rootIndexes;
+    for (int index = 0; index < nodeCount; ++index)
+    {
+        if (execution.pendingInputCounts.at(index) == 0)
+        {
+            rootIndexes.push_back(index);
+        }
+    }
+    execution.timer.start();
+    for (const int rootIndex : std::as_const(rootIndexes))
+    {
+        startNode(&execution, rootIndex);
+    }
+    // Dependents are queued by the worker that finishes their last input, before that worker returns, so the pool
+    // never drains while work is still pending.
+    execution.pool.waitForDone();
+    result.elapsedUs = execution.timer.nsecsElapsed() / 1000;
+
+    QVector<qint64> pathUs(nodeCount, 0);
+    QVector<int> pathPredecessors(nodeCount, -1);
+    int pathEnd = -1;
+    for (const int index : std::as_const(topologicalOrder))
+    {
+        const NodeResult& node = result.nodes.at(index);
+        qint64 longestInputUs = 0;
+        for (const int inputIndex : std::as_const(inputIndexes.at(index)))
+        {
+            if (pathPredecessors.at(index) < 0 || pathUs.at(inputIndex) > longestInputUs)
+            {
+                longestInputUs = pathUs.at(inputIndex);
+                pathPredecessors[index] = inputIndex;
+            }
+        }
+        const qint64 durationUs = node.ran ? std::max<qint64>(0, node.finishedAtUs - node.startedAtUs) : 0;
+        pathUs[index] = longestInputUs + durationUs;
+        if (pathEnd < 0 || pathUs.at(index) > pathUs.at(pathEnd))
+        {
+            pathEnd = index;
+        }
+    }
+    if (pathEnd >= 0)
+    {
+        result.criticalPathUs = pathUs.at(pathEnd);
+        for (int index = pathEnd; index >= 0; index = pathPredecessors.at(index))
+        {
+            result.criticalPath.prepend(result.nodes.at(index).name);
+        }
+    }
+
+    result.succeeded = std::all_of(
+        result.nodes.cbegin(),
+        result.nodes.cend(),
+        [](const NodeResult& node)
+        {
+            return node.succeeded;
+        });
+    return result;
+}
+
+QString WhatSonRuntimeTaskGraph::formatCriticalPath(const RunResult& result)
+{
+    return QStringLiteral("criticalPathMs=%1 criticalPath=%2 elapsedMs=%3")
+        .arg(static_cast<double>(result.criticalPathUs) / 1000.0, 0, 'f', 1)
+        .arg(result.criticalPath.join(QLatin1Char('>')))
+        .arg(static_cast<double>(result.elapsedUs) / 1000.0, 0, 'f', 1);
+}
+
+void WhatSonRuntimeTaskGraph::startNode(Execution* execution, const int index) const
+{
+    execution->pool.start([this, execution, index]()
+    {
+        {
+            QMutexLocker locker(&execution->mutex);
+            execution->result->nodes[index].startedAtUs = execution->timer.nsecsElapsed() / 1000;
+        }
+
+        QString error;
+        const Run& run = m_nodes.at(index).run;
+        const bool succeeded = run ? run(&error) : true;
+        finishNode(execution, index, true, succeeded, std::move(error));
+    });
+}
+
+void WhatSonRuntimeTaskGraph::finishNode(
+    Execution* execution,
+    const int index,
+    const bool ran,
+    const bool succeeded,
+    QString error) const
+{
+    QVector<int> readyIndexes;
+    QVector<QPair<int, QString>> blockedNodes;
+    {
+        QMutexLocker locker(&execution->mutex);
+        NodeResult& node = execution->result->nodes[index];
+        node.ran = ran;
+        node.succeeded = succeeded;
+        node.error = succeeded ? QString() : error.trimmed();
+        if (!succeeded && node.error.isEmpty())
+        {
+            node.error = QStringLiteral("Task %1 failed.").arg(node.name);
+        }
+        if (ran)
+        {
+            node.finishedAtUs = execution->timer.nsecsElapsed() / 1000;
+        }
+
+        for (const int dependent : std::as_const(execution->dependents.at(index)))
+        {
+            if (!succeeded && execution->failedInputIndexes.at(dependent) < 0)
+            {
+                execution->failedInputIndexes[dependent] = index;
+            }
+            if (--execution->pendingInputCounts[dependent] > 0)
+            {
+                continue;
+            }
+
+            const int failedInputIndex = execution->failedInputIndexes.at(dependent);
+            if (failedInputIndex < 0)
+            {
+                readyIndexes.push_back(dependent);
+            }
+            else
+            {
+                blockedNodes.push_back({dependent, execution->result->nodes.at(failedInputIndex).error});
+            }
+        }
+    }
+
+    for (const int readyIndex : std::as_const(readyIndexes))
+    {
+        startNode(execution, readyIndex);
+    }
+    for (QPair<int, QString>& blockedNode : blockedNodes)
+    {
+        finishNode(execution, blockedNode.first, false, false, std::move(blockedNode.second));
+    }
+}
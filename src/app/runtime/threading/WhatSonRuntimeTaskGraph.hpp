@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+// Dependency-ordered executor for runtime domain loads. Each node names the nodes whose outputs it reads and is
+// started on the worker pool as soon as every input has succeeded, so derived domains overlap with unrelated loads
+// instead of waiting for the slowest one. Nodes hand results to each other through state captured by their run
+// functions; the graph only guarantees that a node's inputs have finished before it starts. A node whose input failed
+// is not run and reports the upstream error.
+class WhatSonRuntimeTaskGraph final
+{
+public:
+    using Run = std::function<bool(QString* errorMessage)>;
+
+    struct NodeResult
+    {
+        QString name;
+        QStringList inputs;
+        bool ran = false;
+        bool succeeded = false;
+        QString error;
+        qint64 startedAtUs = -1;
+        qint64 finishedAtUs = -1;
+    };
+
+    struct RunResult
+    {
+        bool succeeded = false;
+        QString error;
+        QVector<NodeResult> nodes;
+        qint64 elapsedUs = 0;
+        // Longest chain of nodes by measured run time, following input edges. With enough workers this bounds the
+        // mount time; nodes off the chain only add to it through worker contention.
+        qint64 criticalPathUs = 0;
+        QStringList criticalPath;
+    };
+
+    bool addNode(QString name, QStringList inputs, Run run, QString* errorMessage = nullptr);
+    bool contains(const QString& name) const;
+    int nodeCount() const noexcept;
+
+    // Zero or less uses QThread::idealThreadCount().
+    void setMaxWorkerCount(int count) noexcept;
+
+    RunResult run() const;
+
+    static QString formatCriticalPath(const RunResult& result);
+
+private:
+    struct Node
+    {
+        QString name;
+        QStringList inputs;
+        Run run;
+    };
+
+    struct Execution;
+
+    void startNode(Execution* execution, int index) const;
+    void finishNode(Execution* execution, int index, bool ran, bool succeeded, QString error) const;
+
+    QVector<Node> m_nodes;
+    int m_maxWorkerCount = 0;
+};
@@ -9,6 +9,7 @@ namespace
 {
     constexpr auto kSelectedHubPathSettingsKey = "workspace/selectedHubPath";
     constexpr auto kSelectedHubBookmarkSettingsKey = "workspace/selectedHubBookmark";
+    constexpr auto kResidentHubPathsSettingsKey = "workspace/residentHubPaths";
 }
 
 QString SelectedHubStore::selectedHubPath()
@@ -93,6 +94,45 @@ void SelectedHubStore::setSelectedHubSelection(const QString& hubPath, const QBy
     settings.sync();
 }
 
+QStringList SelectedHubStore::residentHubPaths() const
+{
+    QSettings settings;
+    QStringList hubPaths;
+    for (const QString& rawStoredPath : settings.value(residentHubPathsSettingsKey()).toStringList())
+    {
+        const QString normalizedStoredPath = normalizeHubPath(rawStoredPath);
+        if (isStoredHubPathValid(normalizedStoredPath) && !hubPaths.contains(normalizedStoredPath))
+        {
+            hubPaths.push_back(normalizedStoredPath);
+        }
+    }
+    return hubPaths;
+}
+
+void SelectedHubStore::setResidentHubPaths(const QStringList& hubPaths)
+{
+    QStringList storedPaths;
+    for (const QString& hubPath : hubPaths)
+    {
+        const QString normalizedHubPath = normalizeHubPath(hubPath);
+        if (isStoredHubPathValid(normalizedHubPath) && !storedPaths.contains(normalizedHubPath))
+        {
+            storedPaths.push_back(normalizedHubPath);
+        }
+    }
+
+    QSettings settings;
+    if (storedPaths.isEmpty())
+    {
+        settings.remove(residentHubPathsSettingsKey());
+    }
+    else
+    {
+        settings.setValue(residentHubPathsSettingsKey(), storedPaths);
+    }
+    settings.sync();
+}
+
 bool SelectedHubStore::isStoredHubPathValid(const QString& hubPath) const
 {
     const QString normalizedHubPath = WhatSon::HubPath::normalizePath(hubPath);
@@ -121,3 +161,8 @@ QString SelectedHubStore::selectedHubBookmarkSettingsKey() const
 {
     return QString::fromLatin1(kSelectedHubBookmarkSettingsKey);
 }
+
+QString SelectedHubStore::residentHubPathsSettingsKey() const
+{
+    return QString::fromLatin1(kResidentHubPathsSettingsKey);
+}
@@ -2,6 +2,8 @@
 
 #include "app/store/hub/ISelectedHubStore.hpp"
 
+#include <QStringList>
+
 class SelectedHubStore final : public ISelectedHubStore
 {
 public:
@@ -14,9 +16,14 @@ public:
     void setSelectedHubPath(const QString& hubPath) override;
     void setSelectedHubSelection(const QString& hubPath, const QByteArray& accessBookmark) override;
 
+    // Hubs that were resident in the runtime store when the previous session quit.
+    [[nodiscard]] QStringList residentHubPaths() const;
+    void setResidentHubPaths(const QStringList& hubPaths);
+
 private:
     [[nodiscard]] bool isStoredHubPathValid(const QString& hubPath) const;
     [[nodiscard]] QString normalizeHubPath(const QString& hubPath) const;
     [[nodiscard]] QString selectedHubSettingsKey() const;
     [[nodiscard]] QString selectedHubBookmarkSettingsKey() const;
+    [[nodiscard]] QString residentHubPathsSettingsKey() const;
 };
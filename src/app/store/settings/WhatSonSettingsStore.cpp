@@ -0,0 +1,407 @@
+#include "app/store/settings/WhatSonSettingsStore.hpp"
+
+#include "app/models/file/WhatSonDebugTrace.hpp"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <atomic>
+#include <utility>
+
+namespace
+{
+    constexpr int kFlushDelayMs = 250;
+    constexpr quint8 kJournalSetRecord = 0x53;
+    constexpr quint8 kJournalRemoveRecord = 0x52;
+    constexpr auto kJournalStreamVersion = QDataStream::Qt_6_5;
+
+    QByteArray encodeJournalRecord(const QString& key, const bool present, const QVariant& value)
+    {
+        QByteArray record;
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream.setVersion(kJournalStreamVersion);
+        stream << (present ? kJournalSetRecord : kJournalRemoveRecord) << key;
+        if (present)
+        {
+            stream << value;
+        }
+        return record;
+    }
+} // namespace
+
+WhatSonSettingsStore::WhatSonSettingsStore(QObject* parent)
+    : QObject(parent)
+{
+    const QSettings defaultSettings;
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &WhatSonSettingsStore::startBackgroundFlush);
+    m_flushPool.setMaxThreadCount(1);
+
+    QMutexLocker locker(&m_mutex);
+    bindLocked(defaultSettings.fileName(), defaultSettings.format());
+}
+
+WhatSonSettingsStore::WhatSonSettingsStore(QString settingsFilePath, QSettings::Format format, QObject* parent)
+    : QObject(parent)
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &WhatSonSettingsStore::startBackgroundFlush);
+    m_flushPool.setMaxThreadCount(1);
+
+    QMutexLocker locker(&m_mutex);
+    bindLocked(std::move(settingsFilePath), format);
+}
+
+WhatSonSettingsStore::~WhatSonSettingsStore()
+{
+    m_flushTimer.stop();
+    flush();
+}
+
+WhatSonSettingsStore& WhatSonSettingsStore::shared()
+{
+    // Intentionally leaked so late writers during shutdown still find it; aboutToQuit flushes and the journal covers
+    // anything written after that.
+    static WhatSonSettingsStore* const store = new WhatSonSettingsStore;
+
+    // The first caller may run before QCoreApplication exists, so the quit flush is hooked up by the first call that
+    // sees an application.
+    static std::atomic_bool quitFlushConnected{false};
+    if (!quitFlushConnected.load(std::memory_order_acquire))
+    {
+        QCoreApplication* const application = QCoreApplication::instance();
+        bool expected = false;
+        if (application != nullptr && quitFlushConnected.compare_exchange_strong(expected, true))
+        {
+            QObject::connect(
+                application,
+                &QCoreApplication::aboutToQuit,
+                store,
+                []()
+                {
+                    store->flush();
+                },
+                Qt::DirectConnection);
+        }
+    }
+    return *store;
+}
+
+QString WhatSonSettingsStore::journalFilePathFor(const QString& settingsFilePath)
+{
+    const QFileInfo settingsFileInfo(settingsFilePath);
+    if (settingsFileInfo.isAbsolute() && !settingsFilePath.startsWith(QStringLiteral("\\HKEY")))
+    {
+        return settingsFileInfo.absoluteFilePath() + QStringLiteral(".journal");
+    }
+
+    // Registry-backed settings have no directory of their own.
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation))
+        .filePath(QStringLiteral("settings.journal"));
+}
+
+QString WhatSonSettingsStore::settingsFilePath() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_settingsFilePath;
+}
+
+QString WhatSonSettingsStore::journalFilePath() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_journal.fileName();
+}
+
+bool WhatSonSettingsStore::contains(const QString& key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return entryLocked(key).present;
+}
+
+QVariant WhatSonSettingsStore::value(const QString& key, const QVariant& defaultValue) const
+{
+    QMutexLocker locker(&m_mutex);
+    const Entry& entry = entryLocked(key);
+    return entry.present ? entry.value : defaultValue;
+}
+
+QString WhatSonSettingsStore::stringValue(const QString& key) const
+{
+    return value(key).toString();
+}
+
+bool WhatSonSettingsStore::boolValue(const QString& key, const bool defaultValue) const
+{
+    return value(key, defaultValue).toBool();
+}
+
+void WhatSonSettingsStore::setValue(const QString& key, const QVariant& value)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        const Entry& current = entryLocked(key);
+        if (current.present && current.value == value)
+        {
+            return;
+        }
+        writeLocked(key, Entry{true, value});
+    }
+    scheduleFlush();
+}
+
+void WhatSonSettingsStore::remove(const QString& key)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!entryLocked(key).present)
+        {
+            return;
+        }
+        writeLocked(key, Entry{});
+    }
+    scheduleFlush();
+}
+
+bool WhatSonSettingsStore::hasPendingWrites() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_flushedSequence != m_journalSequence;
+}
+
+int WhatSonSettingsStore::replayedJournalRecordCount() const noexcept
+{
+    return m_replayedJournalRecordCount;
+}
+
+bool WhatSonSettingsStore::flush()
+{
+    startBackgroundFlush();
+    m_flushPool.waitForDone();
+
+    QMutexLocker locker(&m_mutex);
+    return m_lastFlushSucceeded && m_flushedSequence == m_journalSequence;
+}
+
+void WhatSonSettingsStore::scheduleFlush()
+{
+    if (QThread::currentThread() != thread())
+    {
+        QMetaObject::invokeMethod(this, &WhatSonSettingsStore::scheduleFlush, Qt::QueuedConnection);
+        return;
+    }
+
+    if (!m_flushTimer.isActive())
+    {
+        m_flushTimer.start();
+    }
+}
+
+void WhatSonSettingsStore::reload()
+{
+    flush();
+
+    const QSettings defaultSettings;
+    QMutexLocker locker(&m_mutex);
+    bindLocked(defaultSettings.fileName(), defaultSettings.format());
+}
+
+void WhatSonSettingsStore::bindLocked(QString settingsFilePath, const QSettings::Format format)
+{
+    m_journal.close();
+    m_cache.clear();
+    m_pending.clear();
+    m_journalSequence = 0;
+    m_flushedSequence = 0;
+    m_lastFlushSucceeded = true;
+
+    m_settingsFilePath = std::move(settingsFilePath);
+    m_format = format;
+    m_settings = std::make_unique<QSettings>(m_settingsFilePath, m_format);
+    m_journal.setFileName(journalFilePathFor(m_settingsFilePath));
+    replayJournalLocked();
+}
+
+const WhatSonSettingsStore::Entry& WhatSonSettingsStore::entryLocked(const QString& key) const
+{
+    auto cached = m_cache.constFind(key);
+    if (cached != m_cache.constEnd())
+    {
+        return cached.value();
+    }
+
+    Entry entry;
+    entry.present = m_settings->contains(key);
+    if (entry.present)
+    {
+        entry.value = m_settings->value(key);
+    }
+    return m_cache.insert(key, std::move(entry)).value();
+}
+
+void WhatSonSettingsStore::writeLocked(const QString& key, Entry entry)
+{
+    if (!appendJournalRecordLocked(key, entry))
+    {
+        WhatSon::Debug::traceSelf(this,
+                                  QStringLiteral("settings.store"),
+                                  QStringLiteral("journal.appendFailed"),
+                                  QStringLiteral("path=%1 key=%2 error=%3")
+                                  .arg(m_journal.fileName(), key, m_journal.errorString()));
+    }
+
+    ++m_journalSequence;
+    m_pending.insert(key, entry);
+    m_cache.insert(key, std::move(entry));
+}
+
+bool WhatSonSettingsStore::appendJournalRecordLocked(const QString& key, const Entry& entry)
+{
+    if (!m_journal.isOpen())
+    {
+        QDir().mkpath(QFileInfo(m_journal.fileName()).absolutePath());
+        if (!m_journal.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            return false;
+        }
+    }
+
+    const QByteArray record = encodeJournalRecord(key, entry.present, entry.value);
+    return m_journal.write(record) == record.size() && m_journal.flush();
+}
+
+void WhatSonSettingsStore::replayJournalLocked()
+{
+    m_replayedJournalRecordCount = 0;
+
+    QFile journal(m_journal.fileName());
+    if (!journal.exists() || !journal.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&journal);
+    stream.setVersion(kJournalStreamVersion);
+    while (!stream.atEnd())
+    {
+        quint8 recordType = 0;
+        QString key;
+        QVariant value;
+        stream.startTransaction();
+        stream >> recordType >> key;
+        if (recordType == kJournalSetRecord)
+        {
+            stream >> value;
+        }
+        else if (recordType != kJournalRemoveRecord)
+        {
+            stream.abortTransaction();
+            break;
+        }
+        if (!stream.commitTransaction())
+        {
+            // A torn tail record from a crash mid-append; everything before it is intact.
+            break;
+        }
+
+        if (recordType == kJournalSetRecord)
+        {
+            m_settings->setValue(key, value);
+        }
+        else
+        {
+            m_settings->remove(key);
+        }
+        ++m_replayedJournalRecordCount;
+    }
+    journal.close();
+
+    m_settings->sync();
+    if (m_settings->status() == QSettings::NoError)
+    {
+        truncateJournalLocked();
+    }
+
+    WhatSon::Debug::traceSelf(this,
+                              QStringLiteral("settings.store"),
+                              QStringLiteral("journal.replay"),
+                              QStringLiteral("path=%1 records=%2 status=%3")
+                              .arg(m_journal.fileName())
+                              .arg(m_replayedJournalRecordCount)
+                              .arg(static_cast<int>(m_settings->status())));
+}
+
+void WhatSonSettingsStore::truncateJournalLocked()
+{
+    m_journal.close();
+    QFile::remove(m_journal.fileName());
+}
+
+void WhatSonSettingsStore::startBackgroundFlush()
+{
+    QHash<QString, Entry> pending;
+    QString settingsFilePath;
+    QSettings::Format format = QSettings::NativeFormat;
+    quint64 sequence = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_pending.isEmpty())
+        {
+            return;
+        }
+        pending = std::exchange(m_pending, {});
+        settingsFilePath = m_settingsFilePath;
+        format = m_format;
+        sequence = m_journalSequence;
+    }
+
+    // One worker thread keeps flushes ordered; a later flush never lands before an earlier one.
+    m_flushPool.start(
+        [this, pending = std::move(pending), settingsFilePath, format, sequence]()
+        {
+            QSettings settings(settingsFilePath, format);
+            for (auto it = pending.cbegin(); it != pending.cend(); ++it)
+            {
+                if (it.value().present)
+                {
+                    settings.setValue(it.key(), it.value().value);
+                }
+                else
+                {
+                    settings.remove(it.key());
+                }
+            }
+            settings.sync();
+            const bool synced = settings.status() == QSettings::NoError;
+
+            QMutexLocker locker(&m_mutex);
+            m_lastFlushSucceeded = synced;
+            if (!synced)
+            {
+                // Requeue what a newer write has not superseded; the journal still holds every record. The retry runs
+                // on the next debounce, since no later write may come along to schedule it.
+                for (auto it = pending.cbegin(); it != pending.cend(); ++it)
+                {
+                    if (!m_pending.contains(it.key()))
+                    {
+                        m_pending.insert(it.key(), it.value());
+                    }
+                }
+                locker.unlock();
+                scheduleFlush();
+                return;
+            }
+
+            m_flushedSequence = sequence;
+            if (m_flushedSequence == m_journalSequence)
+            {
+                truncateJournalLocked();
+            }
+        });
+}
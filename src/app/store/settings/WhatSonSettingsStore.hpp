@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSettings>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
+
+#include <memory>
+
+// Process-wide typed view over the application QSettings file. Values are loaded once per key and then served from
+// memory; writes update the cache, append one record to a crash-safe journal next to the settings file and are
+// flushed to disk by a debounced background sync. A journal left behind by a crash is replayed on the next bind.
+// Keys are leaf keys: remove() does not drop child groups from the cache.
+class WhatSonSettingsStore final : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WhatSonSettingsStore(QObject* parent = nullptr);
+    WhatSonSettingsStore(QString settingsFilePath, QSettings::Format format, QObject* parent = nullptr);
+    ~WhatSonSettingsStore() override;
+
+    static WhatSonSettingsStore& shared();
+    static QString journalFilePathFor(const QString& settingsFilePath);
+
+    QString settingsFilePath() const;
+    QString journalFilePath() const;
+
+    bool contains(const QString& key) const;
+    QVariant value(const QString& key, const QVariant& defaultValue = {}) const;
+    QString stringValue(const QString& key) const;
+    bool boolValue(const QString& key, bool defaultValue = false) const;
+
+    void setValue(const QString& key, const QVariant& value);
+    void remove(const QString& key);
+
+    bool hasPendingWrites() const;
+    int replayedJournalRecordCount() const noexcept;
+
+    // Blocks until every write issued so far is synced to the settings file and the journal is truncated.
+    bool flush();
+    void scheduleFlush();
+
+    // Flushes, drops the cache and rebinds to the current default QSettings location.
+    void reload();
+
+private:
+    struct Entry final
+    {
+        bool present = false;
+        QVariant value;
+    };
+
+    void bindLocked(QString settingsFilePath, QSettings::Format format);
+    const Entry& entryLocked(const QString& key) const;
+    void writeLocked(const QString& key, Entry entry);
+    bool appendJournalRecordLocked(const QString& key, const Entry& entry);
+    void replayJournalLocked();
+    void truncateJournalLocked();
+    void startBackgroundFlush();
+
+    mutable QMutex m_mutex;
+    QString m_settingsFilePath;
+    QSettings::Format m_format = QSettings::NativeFormat;
+    std::unique_ptr<QSettings> m_settings;
+    mutable QHash<QString, Entry> m_cache;
+    QHash<QString, Entry> m_pending;
+    QFile m_journal;
+    quint64 m_journalSequence = 0;
+    quint64 m_flushedSequence = 0;
+    int m_replayedJournalRecordCount = 0;
+    bool m_lastFlushSucceeded = true;
+    QTimer m_flushTimer;
+    QThreadPool m_flushPool;
+};
@@ -1,8 +1,175 @@
+#include "app/models/file/query/WhatSonHubQueryFilter.hpp"
+#include "app/models/file/query/WhatSonHubQueryIndex.hpp"
+#include "app/models/file/query/WhatSonMultiHubQuery.hpp"
+#include "app/models/file/validator/WhatSonHubIntegrityChecker.hpp"
+
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QTextStream>
 
+namespace
+{
+    QString compactJsonLine(QVariantMap payload, const QString& type)
+    {
+        payload.insert(QStringLiteral("type"), type);
+        return QString::fromUtf8(QJsonDocument(QJsonObject::fromVariantMap(payload)).toJson(QJsonDocument::Compact));
+    }
+
+    void countValues(QVariantMap* counts, const QStringList& values)
+    {
+        for (const QString& value : values)
+        {
+            if (!value.trimmed().isEmpty())
+            {
+                counts->insert(value, counts->value(value).toInt() + 1);
+            }
+        }
+    }
+
+    int runHubQuery(
+        QTextStream& out,
+        const QStringList& hubPaths,
+        const QString& target,
+        const QString& filterExpression,
+        const int jobs,
+        const bool useCache)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        const bool resourceTarget = target == QStringLiteral("resources");
+        if (!resourceTarget && target != QStringLiteral("notes") && target != QStringLiteral("stats"))
+        {
+            QTextStream(stderr) << "status=error message=Unknown query target: " << target << '\n';
+            return 2;
+        }
+
+        WhatSonHubQueryFilter filter(
+            resourceTarget ? WhatSonHubQueryFilter::Target::Resources : WhatSonHubQueryFilter::Target::Notes);
+        QString errorMessage;
+        if (!filter.parse(filterExpression, &errorMessage))
+        {
+            QTextStream(stderr) << "status=error message=" << errorMessage << '\n';
+            return 2;
+        }
+
+        WhatSonMultiHubQuery query;
+        query.setMaxWorkerCount(jobs);
+        if (useCache)
+        {
+            query.setCacheDirectoryPath(WhatSonHubQueryIndex::defaultCacheDirectoryPath());
+        }
+        if (!query.mountHubs(hubPaths, nullptr, &errorMessage))
+        {
+            QTextStream(stderr) << "status=error message=" << errorMessage << '\n';
+            return 2;
+        }
+
+        // Rows name their hub only when several hubs are queried, so single-hub output keeps its original shape.
+        const QStringList mountedHubPaths = query.hubPaths();
+        const bool tagRowsWithHub = mountedHubPaths.size() > 1;
+        auto rowPayload = [tagRowsWithHub](QVariantMap payload, const QString& hubPath)
+        {
+            if (tagRowsWithHub)
+            {
+                payload.insert(QStringLiteral("hubPath"), hubPath);
+            }
+            return payload;
+        };
+
+        int matchedCount = 0;
+        QVariantMap summary;
+        if (resourceTarget)
+        {
+            for (const WhatSonMultiHubQuery::ResourceMatch& match : query.resources(filter))
+            {
+                out << compactJsonLine(rowPayload(match.resource->toVariantMap(), match.hubPath), QStringLiteral("resource"))
+                    << '\n';
+                ++matchedCount;
+            }
+        }
+        else
+        {
+            const bool statsOnly = target == QStringLiteral("stats");
+            int bookmarkedCount = 0;
+            QVariantMap tagCounts;
+            QVariantMap folderCounts;
+            QVariantMap projectCounts;
+            QVariantMap progressCounts;
+            for (const WhatSonMultiHubQuery::NoteMatch& match : query.notes(filter))
+            {
+                ++matchedCount;
+                if (!statsOnly)
+                {
+                    out << compactJsonLine(rowPayload(match.note->toVariantMap(), match.hubPath), QStringLiteral("note"))
+                        << '\n';
+                    continue;
+                }
+                const LibraryNoteRecord& record = match.note->record;
+                bookmarkedCount += record.bookmarked ? 1 : 0;
+                countValues(&tagCounts, record.tags);
+                countValues(&folderCounts, record.folders);
+                countValues(&projectCounts, {record.project});
+                countValues(&progressCounts, {QString::number(record.progress)});
+            }
+            if (statsOnly)
+            {
+                int noteCount = 0;
+                int resourceCount = 0;
+                int unusedResourceCount = 0;
+                for (const QString& hubPath : mountedHubPaths)
+                {
+                    const WhatSonHubQueryIndex* index = query.index(hubPath);
+                    noteCount += static_cast<int>(index->notes().size());
+                    resourceCount += static_cast<int>(index->resources().size());
+                    for (const WhatSonHubQueryResource& resource : index->resources())
+                    {
+                        unusedResourceCount += resource.referenced ? 0 : 1;
+                    }
+                }
+                summary.insert(QStringLiteral("noteCount"), noteCount);
+                summary.insert(QStringLiteral("resourceCount"), resourceCount);
+                summary.insert(QStringLiteral("unusedResourceCount"), unusedResourceCount);
+                summary.insert(QStringLiteral("bookmarkedCount"), bookmarkedCount);
+                summary.insert(QStringLiteral("tags"), tagCounts);
+                summary.insert(QStringLiteral("folders"), folderCounts);
+                summary.insert(QStringLiteral("projects"), projectCounts);
+                summary.insert(QStringLiteral("progress"), progressCounts);
+            }
+        }
+
+        int reusedEntryCount = 0;
+        int parsedEntryCount = 0;
+        QStringList indexedHubPaths;
+        for (const QString& hubPath : mountedHubPaths)
+        {
+            const WhatSonHubQueryIndex* index = query.index(hubPath);
+            reusedEntryCount += index->reusedEntryCount();
+            parsedEntryCount += index->parsedEntryCount();
+            indexedHubPaths.push_back(index->hubPath());
+        }
+        if (tagRowsWithHub)
+        {
+            summary.insert(QStringLiteral("hubPaths"), indexedHubPaths);
+        }
+        else
+        {
+            summary.insert(QStringLiteral("hubPath"), indexedHubPaths.value(0));
+        }
+        summary.insert(QStringLiteral("target"), target);
+        summary.insert(QStringLiteral("matchedCount"), matchedCount);
+        summary.insert(QStringLiteral("reusedEntryCount"), reusedEntryCount);
+        summary.insert(QStringLiteral("parsedEntryCount"), parsedEntryCount);
+        summary.insert(QStringLiteral("elapsedMs"), timer.elapsed());
+        out << compactJsonLine(summary, QStringLiteral("summary")) << '\n';
+        return 0;
+    }
+} // namespace
+
 int main(int argc, char* argv[])
 {
     QCoreApplication app(argc, argv);
@@ -19,6 +186,48 @@ int main(int argc, char* argv[])
         QStringLiteral("Run one-shot healthcheck and exit."));
     parser.addOption(healthcheckOption);
 
+    QCommandLineOption checkHubOption(
+        QStringList() << QStringLiteral("check-hub"),
+        QStringLiteral("Run a full integrity check of a .wshub directory or packed archive and exit."),
+        QStringLiteral("path"));
+    parser.addOption(checkHubOption);
+
+    QCommandLineOption repairOption(
+        QStringList() << QStringLiteral("repair"),
+        QStringLiteral("Apply safe repairs while running --check-hub."));
+    parser.addOption(repairOption);
+
+    QCommandLineOption jobsOption(
+        QStringList() << QStringLiteral("jobs"),
+        QStringLiteral("Maximum number of integrity worker threads (default: ideal thread count)."),
+        QStringLiteral("count"),
+        QStringLiteral("0"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption queryHubOption(
+        QStringList() << QStringLiteral("query-hub"),
+        QStringLiteral("Query a .wshub directory or packed archive read-only and stream JSON lines. Repeat to query several hubs."),
+        QStringLiteral("path"));
+    parser.addOption(queryHubOption);
+
+    QCommandLineOption targetOption(
+        QStringList() << QStringLiteral("target"),
+        QStringLiteral("Query target for --query-hub: notes, resources or stats (default: notes)."),
+        QStringLiteral("target"),
+        QStringLiteral("notes"));
+    parser.addOption(targetOption);
+
+    QCommandLineOption filterOption(
+        QStringList() << QStringLiteral("filter"),
+        QStringLiteral("Filter expression for --query-hub, e.g. \"tag:draft progress>=2 -bookmarked:true\"."),
+        QStringLiteral("expression"));
+    parser.addOption(filterOption);
+
+    QCommandLineOption noCacheOption(
+        QStringList() << QStringLiteral("no-cache"),
+        QStringLiteral("Do not read or write the --query-hub index cache."));
+    parser.addOption(noCacheOption);
+
     parser.process(app);
 
     QTextStream out(stdout);
@@ -29,6 +238,39 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    if (parser.isSet(checkHubOption))
+    {
+        WhatSonHubIntegrityChecker checker;
+        checker.setMaxWorkerCount(parser.value(jobsOption).toInt());
+        checker.setRepairEnabled(parser.isSet(repairOption));
+
+        WhatSonHubIntegrityReport report;
+        QString errorMessage;
+        if (!checker.check(parser.value(checkHubOption), &report, &errorMessage))
+        {
+            QTextStream(stderr) << "status=error message=" << errorMessage << '\n';
+            return 2;
+        }
+
+        for (const WhatSonHubIntegrityFinding& finding : std::as_const(report.findings))
+        {
+            out << compactJsonLine(finding.toVariantMap(), QStringLiteral("finding")) << '\n';
+        }
+        out << compactJsonLine(report.summaryVariantMap(), QStringLiteral("summary")) << '\n';
+        return report.isClean() ? 0 : 1;
+    }
+
+    if (parser.isSet(queryHubOption))
+    {
+        return runHubQuery(
+            out,
+            parser.values(queryHubOption),
+            parser.value(targetOption).trimmed().toCaseFolded(),
+            parser.value(filterOption),
+            parser.value(jobsOption).toInt(),
+            !parser.isSet(noCacheOption));
+    }
+
     out << "WhatSon daemon skeleton initialized.\n";
     out << "No background jobs are registered yet.\n";
     return 0;
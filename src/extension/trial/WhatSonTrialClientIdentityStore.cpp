@@ -1,8 +1,9 @@
 #include "extension/trial/WhatSonTrialClientIdentityStore.hpp"
 
+#include "app/store/settings/WhatSonSettingsStore.hpp"
+
 #include <QCryptographicHash>
 #include <QRandomGenerator>
-#include <QSettings>
 #include <QSysInfo>
 #include <QUuid>
 
@@ -63,7 +64,7 @@ namespace
             return {};
         }
 
-        QSettings settings;
+        WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
         const QString rawSettingsValue = settings.value(settingsKey).toString();
         const QString normalizedSettingsValue = normalizeValue(rawSettingsValue);
         bool migratedLegacyValue = false;
@@ -74,7 +75,6 @@ namespace
             if (writeResult.succeeded())
             {
                 settings.remove(settingsKey);
-                settings.sync();
                 migratedLegacyValue = true;
                 return normalizedSettingsValue;
             }
@@ -84,7 +84,6 @@ namespace
             && (!rawSettingsValue.trimmed().isEmpty() || settings.contains(settingsKey)))
         {
             settings.remove(settingsKey);
-            settings.sync();
         }
 
         return {};
@@ -95,11 +94,10 @@ namespace
         const QString& normalizedValue,
         const WhatSonTrialSecureStore& secureStore)
     {
-        QSettings settings;
+        WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
         if (!settingsKey.trimmed().isEmpty() && settings.contains(settingsKey))
         {
             settings.remove(settingsKey);
-            settings.sync();
         }
 
         if (normalizedValue.isEmpty())
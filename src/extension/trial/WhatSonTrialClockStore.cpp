@@ -1,6 +1,7 @@
 #include "extension/trial/WhatSonTrialClockStore.hpp"
 
-#include <QSettings>
+#include "app/store/settings/WhatSonSettingsStore.hpp"
+
 #include <QVariant>
 
 #include <utility>
@@ -45,7 +46,7 @@ namespace
         return normalizeUtcTimestamp(parsedTimestamp);
     }
 
-    QDateTime loadTimestamp(QSettings& settings, const QString& key)
+    QDateTime loadTimestamp(WhatSonSettingsStore& settings, const QString& key)
     {
         const QVariant rawStoredValue = settings.value(key);
         const QDateTime normalizedTimestamp = normalizeStoredTimestamp(rawStoredValue);
@@ -54,7 +55,6 @@ namespace
             if (rawStoredValue.isValid())
             {
                 settings.remove(key);
-                settings.sync();
             }
             return {};
         }
@@ -63,13 +63,12 @@ namespace
         if (rawStoredValue.toString() != normalizedTimestampText)
         {
             settings.setValue(key, normalizedTimestampText);
-            settings.sync();
         }
 
         return normalizedTimestamp;
     }
 
-    void storeTimestamp(QSettings& settings, const QString& key, const QDateTime& timestamp)
+    void storeTimestamp(WhatSonSettingsStore& settings, const QString& key, const QDateTime& timestamp)
     {
         const QDateTime normalizedTimestamp = normalizeUtcTimestamp(timestamp);
         if (!normalizedTimestamp.isValid())
@@ -130,19 +129,19 @@ QString WhatSonTrialClockStore::lastSeenTimestampSettingsKey() const
 
 QDateTime WhatSonTrialClockStore::loadLastExitTimestampUtc() const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     return loadTimestamp(settings, m_lastExitTimestampSettingsKey);
 }
 
 QDateTime WhatSonTrialClockStore::loadLastSeenTimestampUtc() const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     return loadTimestamp(settings, m_lastSeenTimestampSettingsKey);
 }
 
 WhatSonTrialClockCheck WhatSonTrialClockStore::inspect(const QDateTime& nowUtc) const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     const QDateTime normalizedNow = normalizeUtcTimestamp(
         nowUtc.isValid() ? nowUtc : QDateTime::currentDateTimeUtc());
     const QDateTime lastExitTimestampUtc = loadTimestamp(settings, m_lastExitTimestampSettingsKey);
@@ -155,7 +154,7 @@ WhatSonTrialClockCheck WhatSonTrialClockStore::stampExitTimestamp(const QDateTim
     const QDateTime normalizedExitTimestampUtc = normalizeUtcTimestamp(
         exitTimestampUtc.isValid() ? exitTimestampUtc : QDateTime::currentDateTimeUtc());
 
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     const QDateTime storedLastSeenTimestampUtc = loadTimestamp(settings, m_lastSeenTimestampSettingsKey);
     const QDateTime nextLastSeenTimestampUtc =
         (!storedLastSeenTimestampUtc.isValid() || normalizedExitTimestampUtc > storedLastSeenTimestampUtc)
@@ -164,15 +163,13 @@ WhatSonTrialClockCheck WhatSonTrialClockStore::stampExitTimestamp(const QDateTim
 
     storeTimestamp(settings, m_lastExitTimestampSettingsKey, normalizedExitTimestampUtc);
     storeTimestamp(settings, m_lastSeenTimestampSettingsKey, nextLastSeenTimestampUtc);
-    settings.sync();
 
     return buildClockCheck(normalizedExitTimestampUtc, normalizedExitTimestampUtc, nextLastSeenTimestampUtc);
 }
 
 void WhatSonTrialClockStore::clear() const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     settings.remove(m_lastExitTimestampSettingsKey);
     settings.remove(m_lastSeenTimestampSettingsKey);
-    settings.sync();
 }
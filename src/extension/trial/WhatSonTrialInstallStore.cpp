@@ -1,10 +1,11 @@
 #include "extension/trial/WhatSonTrialInstallStore.hpp"
 
+#include "app/store/settings/WhatSonSettingsStore.hpp"
+
 #include <QCryptographicHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
-#include <QSettings>
 #include <QVariant>
 
 #include <utility>
@@ -210,7 +211,7 @@ QString WhatSonTrialInstallStore::installDateSettingsKey() const
 
 QDate WhatSonTrialInstallStore::loadInstallDate() const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     const QString rawSettingsValue = settings.value(m_installDateSettingsKey).toString().trimmed();
     const QString signingSecret = m_clientIdentityStore.loadRegisterIntegritySecret();
     const bool hasSignedInstallDateRecord =
@@ -231,7 +232,6 @@ QDate WhatSonTrialInstallStore::loadInstallDate() const
         settings.setValue(
             m_installDateSettingsKey,
             createSignedInstallDateRecord(m_installDateSettingsKey, legacySettingsDate, signingSecret));
-        settings.sync();
         (void)m_secureStore.removeEntry(m_installDateSettingsKey);
         return legacySettingsDate;
     }
@@ -243,7 +243,6 @@ QDate WhatSonTrialInstallStore::loadInstallDate() const
         settings.setValue(
             m_installDateSettingsKey,
             createSignedInstallDateRecord(m_installDateSettingsKey, legacySecureDate, signingSecret));
-        settings.sync();
         (void)m_secureStore.removeEntry(m_installDateSettingsKey);
         return legacySecureDate;
     }
@@ -251,7 +250,6 @@ QDate WhatSonTrialInstallStore::loadInstallDate() const
     if (!hasSignedInstallDateRecord && (!rawSettingsValue.isEmpty() || settings.contains(m_installDateSettingsKey)))
     {
         settings.remove(m_installDateSettingsKey);
-        settings.sync();
     }
 
     return {};
@@ -272,11 +270,10 @@ QDate WhatSonTrialInstallStore::ensureInstallDate(const QDate& today) const
 
 void WhatSonTrialInstallStore::storeInstallDate(const QDate& installDate) const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     if (!installDate.isValid())
     {
         settings.remove(m_installDateSettingsKey);
-        settings.sync();
         (void)m_secureStore.removeEntry(m_installDateSettingsKey);
         return;
     }
@@ -289,19 +286,16 @@ void WhatSonTrialInstallStore::storeInstallDate(const QDate& installDate) const
     if (signedRecord.isEmpty())
     {
         settings.remove(m_installDateSettingsKey);
-        settings.sync();
         return;
     }
 
     settings.setValue(m_installDateSettingsKey, signedRecord);
-    settings.sync();
     (void)m_secureStore.removeEntry(m_installDateSettingsKey);
 }
 
 void WhatSonTrialInstallStore::clear() const
 {
-    QSettings settings;
+    WhatSonSettingsStore& settings = WhatSonSettingsStore::shared();
     settings.remove(m_installDateSettingsKey);
-    settings.sync();
     (void)m_secureStore.removeEntry(m_installDateSettingsKey);
 }
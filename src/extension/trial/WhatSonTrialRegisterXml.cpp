@@ -1,5 +1,7 @@
 #include "extension/trial/WhatSonTrialRegisterXml.hpp"
 
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
+
 #include <QCryptographicHash>
 #include <QDir>
 #include <QFile>
@@ -56,14 +58,9 @@ namespace
                 createCanonicalRegisterPayload(identity).toUtf8()));
     }
 
-    QString escapeXmlText(QString value)
+    QString escapeXmlText(const QString& value)
     {
-        value.replace(QStringLiteral("&"), QStringLiteral("&amp;"));
-        value.replace(QStringLiteral("<"), QStringLiteral("&lt;"));
-        value.replace(QStringLiteral(">"), QStringLiteral("&gt;"));
-        value.replace(QStringLiteral("\""), QStringLiteral("&quot;"));
-        value.replace(QStringLiteral("'"), QStringLiteral("&apos;"));
-        return value;
+        return WhatSon::XmlEntities::encode(value);
     }
 
     QString createRegisterXmlText(const WhatSonTrialClientIdentity& identity, const QString& signature)
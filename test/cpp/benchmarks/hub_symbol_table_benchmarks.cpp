@@ -0,0 +1,208 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include "app/models/file/hub/WhatSonHubSymbolTable.hpp"
+#include "app/models/hierarchy/library/LibraryAll.hpp"
+
+#include <QSet>
+#include <QStringList>
+#include <QtTest>
+
+namespace
+{
+    constexpr int kIdentifierCount = 100000;
+    constexpr int kProjectCount = 200;
+
+    const QStringList& benchmarkIdentifiers()
+    {
+        static const QStringList identifiers = []
+        {
+            QStringList built;
+            built.reserve(kIdentifierCount);
+            for (int index = 0; index < kIdentifierCount; ++index)
+            {
+                built.push_back(QStringLiteral("3f9c2d7e-%1-4b8a-9d21-5a0e6c1f%1").arg(index, 8, 10, QLatin1Char('0')));
+            }
+            return built;
+        }();
+        return identifiers;
+    }
+
+    QString benchmarkProjectName(int index)
+    {
+        return QStringLiteral("Project %1").arg(index, 3, 10, QLatin1Char('0'));
+    }
+
+    const QVector<LibraryNoteRecord>& benchmarkProjectNotes()
+    {
+        static const QVector<LibraryNoteRecord> notes = []
+        {
+            QVector<LibraryNoteRecord> built;
+            built.reserve(kIdentifierCount);
+            for (int index = 0; index < kIdentifierCount; ++index)
+            {
+                LibraryNoteRecord note;
+                note.noteId = benchmarkIdentifiers().at(index);
+                note.project = benchmarkProjectName(index % kProjectCount);
+                note.tags = {QStringLiteral("tag-%1").arg(index % 50)};
+                built.push_back(std::move(note));
+            }
+            return built;
+        }();
+        return notes;
+    }
+
+    qint64 stringReferenceBytes(const QString& text)
+    {
+        // A deep copy: the QString handle plus its own UTF-16 payload, terminator and shared-data header.
+        return static_cast<qint64>(sizeof(QString)) + (text.size() + 1) * static_cast<qint64>(sizeof(QChar)) + 16;
+    }
+} // namespace
+
+void WhatSonCppBenchmarks::hubSymbolTable_intern()
+{
+    const QStringList& identifiers = benchmarkIdentifiers();
+    QBENCHMARK
+    {
+        WhatSonHubSymbolTable symbols;
+        symbols.reserve(WhatSonHubSymbolTable::Kind::NoteId, kIdentifierCount);
+        for (const QString& identifier : identifiers)
+        {
+            symbols.internNormalized(WhatSonHubSymbolTable::Kind::NoteId, identifier);
+        }
+    }
+}
+
+void WhatSonCppBenchmarks::hubSymbolTable_lookup_data()
+{
+    QTest::addColumn<bool>("bySymbol");
+    QTest::newRow("string set") << false;
+    QTest::newRow("symbol vector") << true;
+}
+
+void WhatSonCppBenchmarks::hubSymbolTable_lookup()
+{
+    QFETCH(bool, bySymbol);
+    const QStringList& identifiers = benchmarkIdentifiers();
+
+    // Membership over already-resolved references: the string set hashes and compares each id, the symbol vector
+    // indexes by the interned id.
+    WhatSonHubSymbolTable symbols;
+    QVector<int> symbolIds;
+    symbolIds.reserve(kIdentifierCount);
+    for (const QString& identifier : identifiers)
+    {
+        symbolIds.push_back(symbols.internNormalized(WhatSonHubSymbolTable::Kind::NoteId, identifier));
+    }
+    const QSet<QString> stringSet(identifiers.cbegin(), identifiers.cend());
+    const QVector<bool> symbolSet(kIdentifierCount, true);
+
+    int hits = 0;
+    if (bySymbol)
+    {
+        QBENCHMARK
+        {
+            for (const int symbol : std::as_const(symbolIds))
+            {
+                hits += symbolSet.at(symbol) ? 1 : 0;
+            }
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            for (const QString& identifier : identifiers)
+            {
+                hits += stringSet.contains(identifier) ? 1 : 0;
+            }
+        }
+    }
+    QVERIFY(hits >= kIdentifierCount);
+}
+
+void WhatSonCppBenchmarks::hubSymbolTable_memory_data()
+{
+    QTest::addColumn<QString>("layout");
+    QTest::newRow("symbol table") << QStringLiteral("table");
+    QTest::newRow("string references") << QStringLiteral("strings");
+    QTest::newRow("symbol references") << QStringLiteral("symbols");
+}
+
+void WhatSonCppBenchmarks::hubSymbolTable_memory()
+{
+    QFETCH(QString, layout);
+    const QStringList& identifiers = benchmarkIdentifiers();
+
+    // Reported as bytes for 100k ids: the table itself, then the cost of one more reference to every id held as a
+    // deep-copied string versus an interned symbol.
+    qint64 bytes = 0;
+    if (layout == QStringLiteral("table"))
+    {
+        WhatSonHubSymbolTable symbols;
+        symbols.reserve(WhatSonHubSymbolTable::Kind::NoteId, kIdentifierCount);
+        for (const QString& identifier : identifiers)
+        {
+            symbols.internNormalized(WhatSonHubSymbolTable::Kind::NoteId, identifier);
+        }
+        bytes = symbols.memoryFootprintBytes();
+    }
+    else if (layout == QStringLiteral("strings"))
+    {
+        for (const QString& identifier : identifiers)
+        {
+            bytes += stringReferenceBytes(identifier);
+        }
+    }
+    else
+    {
+        bytes = static_cast<qint64>(identifiers.size()) * static_cast<qint64>(sizeof(int));
+    }
+    QTest::setBenchmarkResult(static_cast<qreal>(bytes), QTest::BytesAllocated);
+}
+
+void WhatSonCppBenchmarks::hubSymbolTable_projectCounts_data()
+{
+    QTest::addColumn<bool>("byFacet");
+    QTest::newRow("string scan") << false;
+    QTest::newRow("project facet") << true;
+}
+
+void WhatSonCppBenchmarks::hubSymbolTable_projectCounts()
+{
+    QFETCH(bool, byFacet);
+    const QVector<LibraryNoteRecord>& notes = benchmarkProjectNotes();
+
+    // One count per project row, as the projects sidebar renders them: a case-insensitive scan of every note per row
+    // versus the posting size of the interned project.
+    LibraryAll libraryAll;
+    libraryAll.setIndexedNotes(QString(), notes);
+    int total = 0;
+    if (byFacet)
+    {
+        QBENCHMARK
+        {
+            total = 0;
+            for (int project = 0; project < kProjectCount; ++project)
+            {
+                total += libraryAll.noteCountForFacet(WhatSonHubSymbolTable::Kind::Project,
+                                                      benchmarkProjectName(project));
+            }
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            total = 0;
+            for (int project = 0; project < kProjectCount; ++project)
+            {
+                const QString projectName = benchmarkProjectName(project);
+                for (const LibraryNoteRecord& note : notes)
+                {
+                    total += note.project.trimmed().compare(projectName, Qt::CaseInsensitive) == 0 ? 1 : 0;
+                }
+            }
+        }
+    }
+    QCOMPARE(total, kIdentifierCount);
+}
@@ -0,0 +1,118 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include "app/models/hierarchy/library/WhatSonLibraryNoteListProjection.hpp"
+
+#include <QtTest>
+
+namespace
+{
+    constexpr int kTopLevelFolderCount = 2000;
+    constexpr int kChildrenPerFolder = 9;
+    constexpr int kNoteCount = 100000;
+    constexpr int kIncrementalMoveCount = 1000;
+
+    QString folderCountBenchmarkUuid(const int folderIndex)
+    {
+        return QStringLiteral("F%1").arg(folderIndex, 63, 10, QLatin1Char('0'));
+    }
+
+    LibraryNoteRecord folderCountBenchmarkNote(const int noteIndex, const int folderIndex)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("note-%1").arg(noteIndex);
+        note.folderUuids.push_back(folderCountBenchmarkUuid(folderIndex));
+        return note;
+    }
+
+    struct FolderCountHub final
+    {
+        QVector<LibraryHierarchyItem> items;
+        QVector<int> folderIndexByRow;
+        QVector<LibraryNoteRecord> notes;
+    };
+
+    // 2,000 top-level folders with nine children each (20,000 folders) and 100,000 notes spread across them.
+    const FolderCountHub& folderCountHub()
+    {
+        static const FolderCountHub hub = []
+        {
+            FolderCountHub built;
+            built.items.reserve(kTopLevelFolderCount * (kChildrenPerFolder + 1));
+            for (int topIndex = 0; topIndex < kTopLevelFolderCount; ++topIndex)
+            {
+                const int parentFolderIndex = topIndex * (kChildrenPerFolder + 1);
+                LibraryHierarchyItem parent;
+                parent.label = QStringLiteral("top-%1").arg(topIndex);
+                parent.folderPath = parent.label;
+                parent.folderUuid = folderCountBenchmarkUuid(parentFolderIndex);
+                built.items.push_back(parent);
+                built.folderIndexByRow.push_back(parentFolderIndex);
+                for (int childIndex = 1; childIndex <= kChildrenPerFolder; ++childIndex)
+                {
+                    LibraryHierarchyItem child;
+                    child.depth = 1;
+                    child.label = QStringLiteral("child-%1").arg(childIndex);
+                    child.folderPath = parent.folderPath + QLatin1Char('/') + child.label;
+                    child.folderUuid = folderCountBenchmarkUuid(parentFolderIndex + childIndex);
+                    built.items.push_back(child);
+                    built.folderIndexByRow.push_back(parentFolderIndex + childIndex);
+                }
+            }
+
+            built.notes.reserve(kNoteCount);
+            for (int noteIndex = 0; noteIndex < kNoteCount; ++noteIndex)
+            {
+                built.notes.push_back(folderCountBenchmarkNote(
+                    noteIndex,
+                    built.folderIndexByRow.at(noteIndex % built.items.size())));
+            }
+            return built;
+        }();
+        return hub;
+    }
+} // namespace
+
+void WhatSonCppBenchmarks::libraryFolderNoteCounts_fullRecount()
+{
+    const FolderCountHub& hub = folderCountHub();
+    WhatSonLibraryNoteListProjection projection;
+    QHash<QString, int> counts;
+    QBENCHMARK
+    {
+        counts = projection.folderNoteCountByFolderUuid(hub.items, hub.notes, true);
+    }
+    QCOMPARE(counts.value(folderCountBenchmarkUuid(0)), 50);
+}
+
+void WhatSonCppBenchmarks::libraryFolderNoteCounts_indexBuild()
+{
+    const FolderCountHub& hub = folderCountHub();
+    QBENCHMARK
+    {
+        WhatSonLibraryNoteListProjection projection;
+        projection.ensureFolderNoteCounts(hub.items, hub.notes, true);
+        QVERIFY(projection.hasFolderNoteCounts());
+    }
+}
+
+void WhatSonCppBenchmarks::libraryFolderNoteCounts_incrementalMoves()
+{
+    const FolderCountHub& hub = folderCountHub();
+    WhatSonLibraryNoteListProjection projection;
+    projection.ensureFolderNoteCounts(hub.items, hub.notes, true);
+
+    // Each round moves 1,000 notes into one child folder and back, so every iteration does the same work.
+    QVector<int> changedRows;
+    QBENCHMARK
+    {
+        for (int moveIndex = 0; moveIndex < kIncrementalMoveCount; ++moveIndex)
+        {
+            projection.upsertFolderNoteCountsForNote(folderCountBenchmarkNote(moveIndex * 20, 12), &changedRows);
+        }
+        for (int moveIndex = 0; moveIndex < kIncrementalMoveCount; ++moveIndex)
+        {
+            projection.upsertFolderNoteCountsForNote(hub.notes.at(moveIndex * 20), &changedRows);
+        }
+    }
+    QCOMPARE(projection.folderNoteCount(folderCountBenchmarkUuid(0), true), 50);
+}
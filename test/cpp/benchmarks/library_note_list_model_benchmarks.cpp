@@ -0,0 +1,76 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include "app/models/hierarchy/library/LibraryNoteListModel.hpp"
+#include "app/models/hierarchy/library/WhatSonLibraryNoteListProjection.hpp"
+
+#include <QtTest>
+
+namespace
+{
+    constexpr int kNoteCount = 100000;
+    constexpr int kViewportRows = 40;
+
+    LibraryNoteRecord makeLazyListNote(const int index)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        note.noteDirectoryPath =
+            QStringLiteral("/hubs/Lazy.wshub/.wscontents/Library.wslibrary/%1.wsnote").arg(note.noteId);
+        note.createdAt = QStringLiteral("2026-01-01-00-00-00");
+        note.lastModifiedAt = QStringLiteral("2026-%1-%2-%3-%4-00")
+                                  .arg(index / 40320 + 1, 2, 10, QLatin1Char('0'))
+                                  .arg(index / 1440 % 28 + 1, 2, 10, QLatin1Char('0'))
+                                  .arg(index / 60 % 24, 2, 10, QLatin1Char('0'))
+                                  .arg(index % 60, 2, 10, QLatin1Char('0'));
+        note.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50)};
+        return note;
+    }
+} // namespace
+
+void WhatSonCppBenchmarks::libraryNoteListModel_refresh_data()
+{
+    QTest::addColumn<bool>("eager");
+    QTest::newRow("lazy row source") << false;
+    QTest::newRow("eager items") << true;
+}
+
+void WhatSonCppBenchmarks::libraryNoteListModel_refresh()
+{
+    QFETCH(bool, eager);
+    QVector<LibraryNoteRecord> notes;
+    notes.reserve(kNoteCount);
+    for (int index = 0; index < kNoteCount; ++index)
+    {
+        notes.push_back(makeLazyListNote(index));
+    }
+
+    // One refresh of a 100k-note list followed by a 40-row viewport read. The eager row builds every display item up
+    // front, as the projection did before rows were materialised on demand.
+    WhatSonLibraryNoteListProjection projection;
+    int shownRows = 0;
+    QBENCHMARK
+    {
+        LibraryNoteListModel model;
+        const std::shared_ptr<const ILibraryNoteListRowSource> rows = projection.buildNoteListRows({}, notes, false);
+        if (eager)
+        {
+            QVector<LibraryNoteListItem> items;
+            items.reserve(kNoteCount);
+            for (int row = 0; row < kNoteCount; ++row)
+            {
+                items.push_back(rows->materialize(row));
+            }
+            model.setItems(std::move(items));
+        }
+        else
+        {
+            model.setRowSource(rows);
+        }
+        for (int row = 0; row < kViewportRows; ++row)
+        {
+            model.data(model.index(row, 0), LibraryNoteListModel::DisplayDateRole);
+        }
+        shownRows = model.itemCount();
+    }
+    QCOMPARE(shownRows, kNoteCount);
+}
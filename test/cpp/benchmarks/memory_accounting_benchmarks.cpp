@@ -0,0 +1,75 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+#include "app/models/hierarchy/library/LibraryAll.hpp"
+
+#include <QtTest>
+
+namespace
+{
+    constexpr int kSyntheticNoteCount = 100000;
+
+    LibraryNoteRecord syntheticNote(const int index)
+    {
+        const QString stem = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        const QString noteDirectoryPath =
+            QStringLiteral("/hubs/Synthetic.wshub/.wscontents/Library.wslibrary/%1.wsnote").arg(stem);
+
+        LibraryNoteRecord note;
+        note.noteId = stem;
+        note.storageKind = QStringLiteral("note");
+        note.createdAt = QStringLiteral("2026-01-%1-09-30-00").arg(index % 28 + 1, 2, 10, QLatin1Char('0'));
+        note.lastModifiedAt = QStringLiteral("2026-02-%1-18-45-00").arg(index % 28 + 1, 2, 10, QLatin1Char('0'));
+        note.author = QStringLiteral("author-%1").arg(index % 7);
+        note.modifiedBy = note.author;
+        note.project = QStringLiteral("project-%1").arg(index % 40);
+        note.folders = QStringList{QStringLiteral("Research/Papers-%1").arg(index % 100)};
+        note.folderUuids = QStringList{
+            QStringLiteral("0f3c2d7e-4b8a-9d21-5a0e-%1").arg(index % 100, 12, 10, QLatin1Char('0'))};
+        note.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50), QStringLiteral("tag-%1").arg(index % 13)};
+        note.progress = index % 4;
+        note.bookmarked = index % 10 == 0;
+        if (note.bookmarked)
+        {
+            note.bookmarkColors = QStringList{QStringLiteral("red")};
+        }
+        note.noteDirectoryPath = noteDirectoryPath;
+        note.noteHeaderPath = noteDirectoryPath + QStringLiteral("/") + stem + QStringLiteral(".wsnhead");
+        return note;
+    }
+} // namespace
+
+void WhatSonCppBenchmarks::memoryAccounting_bytesPerNote_data()
+{
+    QTest::addColumn<bool>("derivedCopy");
+    QTest::newRow("library all") << false;
+    QTest::newRow("derived copy") << true;
+}
+
+void WhatSonCppBenchmarks::memoryAccounting_bytesPerNote()
+{
+    QFETCH(bool, derivedCopy);
+    QVector<LibraryNoteRecord> notes;
+    notes.reserve(kSyntheticNoteCount);
+    for (int index = 0; index < kSyntheticNoteCount; ++index)
+    {
+        notes.push_back(syntheticNote(index));
+    }
+
+    LibraryAll libraryAll;
+    libraryAll.setIndexedNotes(QStringLiteral("/hubs/Synthetic.wshub"), notes);
+    notes.clear();
+    const QVector<LibraryNoteRecord> projectNotes(libraryAll.notes().cbegin(), libraryAll.notes().cend());
+
+    // Reported as estimated bytes per note: the canonical index with its symbols and facets, then a controller copy
+    // of the records whose string payloads are already owned by the index.
+    WhatSonMemoryEstimate estimate;
+    libraryAll.accountMemory(estimate);
+    if (derivedCopy)
+    {
+        estimate.beginStructure();
+        estimate.addNoteRecords(projectNotes);
+    }
+    QCOMPARE(estimate.itemCount(), static_cast<qint64>(kSyntheticNoteCount));
+    QTest::setBenchmarkResult(static_cast<qreal>(estimate.bytes()) / kSyntheticNoteCount, QTest::BytesAllocated);
+}
@@ -0,0 +1,193 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include "app/models/hierarchy/bookmarks/BookmarksNoteListModel.hpp"
+
+#include <QtTest>
+
+namespace
+{
+    constexpr int kSyntheticItemCount = 100000;
+
+    BookmarksNoteListItem bookmarkItem(const int index)
+    {
+        BookmarksNoteListItem item;
+        item.id = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        item.primaryText = QStringLiteral("Bookmarked note %1\r\nsecond line").arg(index);
+        item.bodyText = QStringLiteral("body %1").arg(index);
+        item.createdAt = QStringLiteral("2026-%1-01-09-00-00").arg(index % 12 + 1, 2, 10, QLatin1Char('0'));
+        item.lastModifiedAt = QStringLiteral("2026-%1-%2-10-00-00")
+                                  .arg(index % 12 + 1, 2, 10, QLatin1Char('0'))
+                                  .arg(index % 28 + 1, 2, 10, QLatin1Char('0'));
+        item.displayDate = QStringLiteral("2026-01-01");
+        item.folders = QStringList{QStringLiteral(" Research "), QStringLiteral("Research")};
+        item.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50)};
+        item.bookmarked = true;
+        item.bookmarkColor = index % 2 == 0 ? QStringLiteral("#FF0000") : QStringLiteral("#0000FF");
+        return item;
+    }
+
+    const QVector<BookmarksNoteListItem>& rawBookmarkItems()
+    {
+        static const QVector<BookmarksNoteListItem> items = []
+        {
+            QVector<BookmarksNoteListItem> built;
+            built.reserve(kSyntheticItemCount);
+            for (int index = 0; index < kSyntheticItemCount; ++index)
+            {
+                built.push_back(bookmarkItem(index));
+            }
+            return built;
+        }();
+        return items;
+    }
+
+    QVector<BookmarksNoteListItem> normalizedItems(const QVector<BookmarksNoteListItem>& rawItems)
+    {
+        QVector<BookmarksNoteListItem> items;
+        items.reserve(rawItems.size());
+        for (const BookmarksNoteListItem& item : rawItems)
+        {
+            items.push_back(BookmarksNoteListModel::normalizedItem(item));
+        }
+        return items;
+    }
+
+    // Tags each date with its locale, like the regression suite's fake, so a switch changes every formatted date.
+    class LocaleSwitchCalendarStore final : public ISystemCalendarStore
+    {
+    public:
+        QString localeTag = QStringLiteral("en");
+
+        QString localeName() const override { return localeTag; }
+        QString bcp47Name() const override { return localeTag; }
+        QString languageName() const override { return localeTag; }
+        QString territoryName() const override { return {}; }
+        QString timeZoneId() const override { return QStringLiteral("UTC"); }
+        QStringList uiLanguages() const override { return {localeTag}; }
+        QString shortDateFormat() const override { return QStringLiteral("yyyy-MM-dd"); }
+        QString longDateFormat() const override { return QStringLiteral("yyyy-MM-dd"); }
+        QString shortDatePlaceholderText() const override { return shortDateFormat(); }
+        QString shortDateExample() const override { return {}; }
+        int firstDayOfWeek() const noexcept override { return 1; }
+        QVariantMap snapshot() const override { return {}; }
+        QString formatShortDate(const QString& value) const override { return formatNoteDate(value); }
+
+        QString formatNoteDate(const QString& primaryValue, const QString& fallbackValue = QString()) const override
+        {
+            const QString value = primaryValue.isEmpty() ? fallbackValue : primaryValue;
+            return QStringLiteral("%1:%2").arg(localeTag, value.left(10));
+        }
+
+        void refreshFromSystem() override {}
+        void requestStoreHook(const QString&) override {}
+
+        void switchLocale(const QString& tag)
+        {
+            localeTag = tag;
+            emit systemInfoChanged();
+        }
+    };
+} // namespace
+
+void WhatSonCppBenchmarks::noteListRefresh_ingest()
+{
+    // The one-time cost paid when records enter the shared index.
+    const QVector<BookmarksNoteListItem>& rawItems = rawBookmarkItems();
+    qsizetype itemCount = 0;
+    QBENCHMARK
+    {
+        itemCount = normalizedItems(rawItems).size();
+    }
+    QCOMPARE(itemCount, static_cast<qsizetype>(kSyntheticItemCount));
+}
+
+void WhatSonCppBenchmarks::noteListRefresh_setItems_data()
+{
+    QTest::addColumn<bool>("normaliseOnRefresh");
+    QTest::newRow("trusted items") << false;
+    QTest::newRow("normalised per refresh") << true;
+}
+
+void WhatSonCppBenchmarks::noteListRefresh_setItems()
+{
+    QFETCH(bool, normaliseOnRefresh);
+    const QVector<BookmarksNoteListItem> allItems = normalizedItems(rawBookmarkItems());
+    QVector<BookmarksNoteListItem> redItems;
+    redItems.reserve(kSyntheticItemCount / 2);
+    for (const BookmarksNoteListItem& item : allItems)
+    {
+        if (item.bookmarkColor == QStringLiteral("#FF0000"))
+        {
+            redItems.push_back(item);
+        }
+    }
+
+    // One selection change is one refresh: alternate between two selections so no round is skipped as unchanged. The
+    // second row re-normalises on every refresh, as setItems() did before items were trusted from ingest.
+    BookmarksNoteListModel model;
+    bool showRed = false;
+    QBENCHMARK
+    {
+        showRed = !showRed;
+        const QVector<BookmarksNoteListItem>& selection = showRed ? redItems : allItems;
+        model.setItems(normaliseOnRefresh ? normalizedItems(selection) : selection);
+    }
+    QVERIFY(model.itemCount() > 0);
+}
+
+void WhatSonCppBenchmarks::noteListRefresh_localeSwitch_data()
+{
+    QTest::addColumn<bool>("rebuildList");
+    QTest::newRow("display-date invalidation") << false;
+    QTest::newRow("list rebuild") << true;
+}
+
+void WhatSonCppBenchmarks::noteListRefresh_localeSwitch()
+{
+    QFETCH(bool, rebuildList);
+    QVector<BookmarksNoteListItem> items;
+    items.reserve(kSyntheticItemCount);
+    for (BookmarksNoteListItem item : rawBookmarkItems())
+    {
+        item.displayDate.clear();
+        items.push_back(BookmarksNoteListModel::normalizedItem(std::move(item)));
+    }
+
+    LocaleSwitchCalendarStore store;
+    BookmarksNoteListModel model;
+    model.setSystemCalendarStore(&store);
+    model.setItems(items);
+    if (!rebuildList)
+    {
+        QObject::connect(&store, &ISystemCalendarStore::systemInfoChanged, &model,
+                         &BookmarksNoteListModel::refreshDisplayDates);
+    }
+
+    // Each switch is followed by a 40-row viewport read. The second row rebuilds every item with a freshly formatted
+    // date on every switch, as the controllers did before only the display-date role was invalidated.
+    bool korean = false;
+    QBENCHMARK
+    {
+        korean = !korean;
+        store.switchLocale(korean ? QStringLiteral("ko") : QStringLiteral("en"));
+        if (rebuildList)
+        {
+            QVector<BookmarksNoteListItem> rebuiltItems = items;
+            for (BookmarksNoteListItem& item : rebuiltItems)
+            {
+                item.displayDate = store.formatNoteDate(item.lastModifiedAt, item.createdAt);
+            }
+            model.setItems(std::move(rebuiltItems));
+        }
+        for (int row = 0; row < 40; ++row)
+        {
+            model.data(model.index(row, 0), BookmarksNoteListModel::DisplayDateRole);
+        }
+    }
+    QCOMPARE(model.itemCount(), kSyntheticItemCount);
+    if (!rebuildList)
+    {
+        QVERIFY(model.data(model.index(0, 0), BookmarksNoteListModel::DisplayDateRole).toString()
+                    .startsWith(store.localeTag + QLatin1Char(':')));
+    }
+}
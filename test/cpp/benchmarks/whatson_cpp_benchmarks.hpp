@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QObject>
+
+// Throughput and memory benchmarks for the synthetic large-hub workloads. They run through QBENCHMARK in their own
+// executable, which ctest never registers, so machine speed cannot fail the regression gate.
+class WhatSonCppBenchmarks final : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void libraryFolderNoteCounts_fullRecount();
+    void libraryFolderNoteCounts_indexBuild();
+    void libraryFolderNoteCounts_incrementalMoves();
+    void hubSymbolTable_intern();
+    void hubSymbolTable_lookup_data();
+    void hubSymbolTable_lookup();
+    void hubSymbolTable_memory_data();
+    void hubSymbolTable_memory();
+    void hubSymbolTable_projectCounts_data();
+    void hubSymbolTable_projectCounts();
+    void xmlEntityCodec_decode_data();
+    void xmlEntityCodec_decode();
+    void xmlEntityCodec_encode_data();
+    void xmlEntityCodec_encode();
+    void noteListRefresh_ingest();
+    void noteListRefresh_setItems_data();
+    void noteListRefresh_setItems();
+    void noteListRefresh_localeSwitch_data();
+    void noteListRefresh_localeSwitch();
+    void libraryNoteListModel_refresh_data();
+    void libraryNoteListModel_refresh();
+    void memoryAccounting_bytesPerNote_data();
+    void memoryAccounting_bytesPerNote();
+};
@@ -0,0 +1,16 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include <QGuiApplication>
+#include <QtTest>
+
+int main(int argc, char** argv)
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("offscreen"));
+    }
+
+    QGuiApplication application(argc, argv);
+    WhatSonCppBenchmarks benchmarks;
+    return QTest::qExec(&benchmarks, argc, argv);
+}
@@ -0,0 +1,115 @@
+#include "test/cpp/benchmarks/whatson_cpp_benchmarks.hpp"
+
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
+
+#include <QtTest>
+
+namespace
+{
+    // The replace chains the single-pass codec replaced, kept here as the baseline rows.
+    QString legacyChainDecode(QString text)
+    {
+        text.replace(QStringLiteral("&lt;"), QStringLiteral("<"));
+        text.replace(QStringLiteral("&gt;"), QStringLiteral(">"));
+        text.replace(QStringLiteral("&quot;"), QStringLiteral("\""));
+        text.replace(QStringLiteral("&apos;"), QStringLiteral("'"));
+        text.replace(QStringLiteral("&#39;"), QStringLiteral("'"));
+        text.replace(QStringLiteral("&nbsp;"), QStringLiteral(" "));
+        text.replace(QStringLiteral("&amp;"), QStringLiteral("&"));
+        return text;
+    }
+
+    QString legacyChainEncode(QString value)
+    {
+        value.replace(QStringLiteral("&"), QStringLiteral("&amp;"));
+        value.replace(QStringLiteral("<"), QStringLiteral("&lt;"));
+        value.replace(QStringLiteral(">"), QStringLiteral("&gt;"));
+        value.replace(QStringLiteral("\""), QStringLiteral("&quot;"));
+        value.replace(QStringLiteral("'"), QStringLiteral("&apos;"));
+        return value;
+    }
+
+    // About 1.3 MiB of UTF-8: mixed entities, ASCII and Hangul, like a large note header or body.
+    const QString& encodedDocument()
+    {
+        static const QString text = []
+        {
+            QString built;
+            for (int index = 0; index < 20000; ++index)
+            {
+                built += QStringLiteral("Research &amp; Development &lt;%1&gt; &quot;notes&quot; 한글 ").arg(index);
+            }
+            return built;
+        }();
+        return text;
+    }
+} // namespace
+
+void WhatSonCppBenchmarks::xmlEntityCodec_decode_data()
+{
+    QTest::addColumn<QString>("path");
+    QTest::newRow("replace chain") << QStringLiteral("chain");
+    QTest::newRow("single pass") << QStringLiteral("string");
+    QTest::newRow("single pass utf8") << QStringLiteral("utf8");
+}
+
+void WhatSonCppBenchmarks::xmlEntityCodec_decode()
+{
+    QFETCH(QString, path);
+    const QString& text = encodedDocument();
+    const QByteArray utf8 = text.toUtf8();
+
+    qsizetype decodedSize = 0;
+    if (path == QStringLiteral("chain"))
+    {
+        QBENCHMARK
+        {
+            decodedSize = legacyChainDecode(text).size();
+        }
+    }
+    else if (path == QStringLiteral("string"))
+    {
+        QBENCHMARK
+        {
+            decodedSize = WhatSon::XmlEntities::decode(text).size();
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            decodedSize = WhatSon::XmlEntities::decode(utf8).size();
+        }
+    }
+    QVERIFY(decodedSize > 0);
+}
+
+void WhatSonCppBenchmarks::xmlEntityCodec_encode_data()
+{
+    QTest::addColumn<bool>("singlePass");
+    QTest::newRow("replace chain") << false;
+    QTest::newRow("single pass") << true;
+}
+
+void WhatSonCppBenchmarks::xmlEntityCodec_encode()
+{
+    QFETCH(bool, singlePass);
+    const QString decoded = WhatSon::XmlEntities::decode(encodedDocument());
+
+    qsizetype encodedSize = 0;
+    if (singlePass)
+    {
+        QBENCHMARK
+        {
+            encodedSize = WhatSon::XmlEntities::encode(decoded).size();
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            encodedSize = legacyChainEncode(decoded).size();
+        }
+    }
+    QVERIFY(encodedSize > decoded.size());
+}
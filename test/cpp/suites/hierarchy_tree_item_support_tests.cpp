@@ -8,3 +8,144 @@ void WhatSonCppRegressionTests::hierarchyTreeItemSupport_clampsNegativeSelection
     QCOMPARE(WhatSon::Hierarchy::TreeItemSupport::clampSelectionIndexToVisibleDefault(3, 4), 3);
     QCOMPARE(WhatSon::Hierarchy::TreeItemSupport::clampSelectionIndexToVisibleDefault(99, 4), 3);
 }
+
+namespace
+{
+    struct TreeFixtureItem final
+    {
+        int depth = 0;
+        bool accent = false;
+        bool expanded = false;
+        bool showChevron = false;
+        QString label;
+    };
+
+    QVector<TreeFixtureItem> treeFixtureItems(const QList<QPair<QString, int>>& rows)
+    {
+        QVector<TreeFixtureItem> items;
+        for (const auto& row : rows)
+        {
+            TreeFixtureItem item;
+            item.label = row.first;
+            item.depth = row.second;
+            items.push_back(item);
+        }
+        WhatSon::Hierarchy::TreeItemSupport::applyChevronByDepth(&items);
+        return items;
+    }
+
+    QString treeFixtureLayout(const QVector<TreeFixtureItem>& items)
+    {
+        QStringList rows;
+        for (const TreeFixtureItem& item : items)
+        {
+            rows.push_back(QStringLiteral("%1:%2%3")
+                               .arg(item.label)
+                               .arg(item.depth)
+                               .arg(item.showChevron ? QStringLiteral(">") : QString()));
+        }
+        return rows.join(QLatin1Char(' '));
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::hierarchyTreeItemSupport_movesSubtreesAndKeepsChevronsLocal()
+{
+    using namespace WhatSon::Hierarchy::TreeItemSupport;
+
+    QVector<TreeFixtureItem> items = treeFixtureItems({
+        {QStringLiteral("a"), 0},
+        {QStringLiteral("a1"), 1},
+        {QStringLiteral("a2"), 1},
+        {QStringLiteral("b"), 0},
+        {QStringLiteral("Folder7"), 0},
+    });
+    QCOMPARE(subtreeEndIndex(items, 0), 3);
+    QCOMPARE(generatedFolderSequenceValue(QStringLiteral("Folder12")), 12);
+    QCOMPARE(generatedFolderSequenceValue(QStringLiteral("Folder")), 0);
+    QCOMPARE(generatedFolderSequenceValue(QStringLiteral("Folder1x")), 0);
+    int nextSequence = 1;
+    for (const TreeFixtureItem& item : std::as_const(items))
+    {
+        observeGeneratedFolderSequence(&nextSequence, item.label);
+    }
+    QCOMPARE(nextSequence, 8);
+    observeGeneratedFolderSequence(&nextSequence, QStringLiteral("Folder3"));
+    QCOMPARE(nextSequence, 8);
+
+    QVERIFY(moveHierarchySubtree(&items, 0, 3, 1, 1));
+    QCOMPARE(treeFixtureLayout(items), QStringLiteral("b:0> a:1> a1:2 a2:2 Folder7:0"));
+
+    QVERIFY(moveHierarchySubtree(&items, 1, 3, 2, 0));
+    QCOMPARE(treeFixtureLayout(items), QStringLiteral("b:0 Folder7:0 a:0> a1:1 a2:1"));
+    QVERIFY(!moveHierarchySubtree(&items, 3, 3, 0, 0));
+
+    int folderSequence = 0;
+    QCOMPARE(createNestedHierarchyFolder(&items, 0, &folderSequence), 1);
+    QCOMPARE(folderSequence, 1);
+    QCOMPARE(treeFixtureLayout(items), QStringLiteral("b:0> Untitled:1 Folder7:0 a:0> a1:1 a2:1"));
+    QCOMPARE(deleteHierarchySubtree(&items, 1), 1);
+    QCOMPARE(treeFixtureLayout(items), QStringLiteral("b:0 Folder7:0 a:0> a1:1 a2:1"));
+    QCOMPARE(deleteHierarchySubtree(&items, 2, 5), 1);
+    QCOMPARE(treeFixtureLayout(items), QStringLiteral("b:0 Folder7:0"));
+}
+
+void WhatSonCppRegressionTests::hierarchyTree_mapsFlatIndicesAndEditsSubtrees()
+{
+    using Tree = WhatSon::Hierarchy::HierarchyTree<TreeFixtureItem>;
+
+    Tree tree(treeFixtureItems({
+        {QStringLiteral("a"), 0},
+        {QStringLiteral("a1"), 1},
+        {QStringLiteral("a1x"), 2},
+        {QStringLiteral("a2"), 1},
+        {QStringLiteral("b"), 0},
+        {QStringLiteral("Folder3"), 0},
+    }));
+    QCOMPARE(tree.size(), 6);
+    QCOMPARE(tree.nextFolderSequence(), 4);
+    for (int flatIndex = 0; flatIndex < tree.size(); ++flatIndex)
+    {
+        QCOMPARE(tree.flatIndexOf(tree.nodeAt(flatIndex)), flatIndex);
+    }
+    QCOMPARE(tree.item(tree.nodeAt(2)).label, QStringLiteral("a1x"));
+    QCOMPARE(tree.subtreeEndFlatIndex(0), 4);
+    QCOMPARE(tree.subtreeSize(tree.nodeAt(0)), 4);
+    QCOMPARE(tree.nodeAt(6), Tree::kNoNode);
+
+    const QVector<TreeFixtureItem> skippedDepthItems = treeFixtureItems({
+        {QStringLiteral("p"), 0},
+        {QStringLiteral("p2"), 2},
+        {QStringLiteral("p2b"), 2},
+        {QStringLiteral("p1"), 1},
+        {QStringLiteral("q"), 0},
+    });
+    const Tree skippedDepthTree(skippedDepthItems);
+    for (int flatIndex = 0; flatIndex < skippedDepthItems.size(); ++flatIndex)
+    {
+        QCOMPARE(skippedDepthTree.subtreeEndFlatIndex(flatIndex),
+                 WhatSon::Hierarchy::TreeItemSupport::subtreeEndIndex(skippedDepthItems, flatIndex));
+    }
+
+    const int a1 = tree.nodeAt(1);
+    const int b = tree.nodeAt(4);
+    QVERIFY(!tree.moveSubtree(tree.nodeAt(0), a1, 0));
+    QVERIFY(tree.moveSubtree(a1, b, 0));
+    QCOMPARE(treeFixtureLayout(tree.flatten()), QStringLiteral("a:0> a2:1 b:0> a1:1> a1x:2 Folder3:0"));
+    QCOMPARE(tree.flatIndexOf(a1), 3);
+    QCOMPARE(tree.depthOf(tree.nodeAt(4)), 2);
+    QCOMPARE(tree.subtreeSize(b), 3);
+
+    TreeFixtureItem created;
+    created.label = QStringLiteral("Folder9");
+    const int createdNode = tree.insertChild(Tree::kNoNode, 0, created);
+    QCOMPARE(tree.flatIndexOf(createdNode), 0);
+    QCOMPARE(tree.nextFolderSequence(), 10);
+    QVERIFY(tree.setExpanded(b, true));
+    QVERIFY(!tree.setExpanded(createdNode, true));
+
+    QVERIFY(tree.removeSubtree(b));
+    QCOMPARE(tree.size(), 4);
+    QCOMPARE(treeFixtureLayout(tree.flatten()), QStringLiteral("Folder9:0 a:0> a2:1 Folder3:0"));
+    QCOMPARE(tree.nextFolderSequence(), 10);
+    QCOMPARE(tree.item(tree.nodeAt(3)).label, QStringLiteral("Folder3"));
+}
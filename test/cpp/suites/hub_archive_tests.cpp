@@ -0,0 +1,293 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/sync/WhatSonHubSyncObservationBuilder.hpp"
+
+#include <QBuffer>
+
+#include <functional>
+#include <utility>
+
+namespace
+{
+    // Runs a callback once the first chunk has been consumed, i.e. while the archive is in the middle of a stream.
+    class InterruptingBuffer final : public QBuffer
+    {
+    public:
+        InterruptingBuffer(const QByteArray& bytes, std::function<void()> onResume)
+            : m_onResume(std::move(onResume))
+        {
+            setData(bytes);
+        }
+
+    protected:
+        qint64 readData(char* data, const qint64 maxSize) override
+        {
+            if (pos() > 0 && m_onResume)
+            {
+                std::exchange(m_onResume, {})();
+            }
+            return QBuffer::readData(data, maxSize);
+        }
+
+    private:
+        std::function<void()> m_onResume;
+    };
+
+    bool writeArchiveFixtureFile(const QString& filePath, const QByteArray& bytes)
+    {
+        QFile file(filePath);
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath())
+            || !file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        return file.write(bytes) == bytes.size();
+    }
+
+    QByteArray readArchiveFixtureFile(const QString& filePath)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return {};
+        }
+        return file.readAll();
+    }
+
+    QStringList relativeEntries(const QString& rootPath)
+    {
+        QStringList entries;
+        const QDir rootDirectory(rootPath);
+        QDirIterator iterator(
+            rootPath,
+            QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,
+            QDirIterator::Subdirectories);
+        while (iterator.hasNext())
+        {
+            iterator.next();
+            entries.push_back(rootDirectory.relativeFilePath(iterator.filePath()));
+        }
+        entries.sort();
+        return entries;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::hubArchive_appendsSegmentsAndCompactsDeadEntries()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed.wshub"));
+
+    QString errorMessage;
+    QVERIFY2(WhatSonHubArchive::create(archivePath, &errorMessage), qPrintable(errorMessage));
+    QVERIFY(WhatSonHubArchive::isPackedArchive(archivePath));
+    QVERIFY(!WhatSonHubArchive::create(archivePath, &errorMessage));
+    QVERIFY(!WhatSonHubArchive::isPackedArchive(workspaceDir.path()));
+
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        QCOMPARE(archive.entryCount(), 0);
+        QVERIFY(archive.writeDirectory(QStringLiteral(".wscontents"), 1000, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral(".wscontents/Tags.wstags"), QByteArray("tags-v1"), 2000, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral("./notes\\a.wsnote"), QByteArray("note-a"), 3000, &errorMessage));
+        QVERIFY(!archive.writeFile(QStringLiteral("../escape"), QByteArray("x"), 0, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral(".wscontents/Tags.wstags"), QByteArray("tags-v2"), 4000, &errorMessage));
+        QVERIFY(archive.removeEntry(QStringLiteral("notes/a.wsnote"), &errorMessage));
+        QVERIFY(!archive.removeEntry(QStringLiteral("notes/a.wsnote"), &errorMessage));
+        QVERIFY(archive.deadSegmentBytes() > 0);
+    }
+
+    const qint64 sizeBeforeCompaction = QFileInfo(archivePath).size();
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(!archive.recoveredFromSegments());
+        QCOMPARE(archive.entryPaths(), QStringList({QStringLiteral(".wscontents"), QStringLiteral(".wscontents/Tags.wstags")}));
+        QCOMPARE(archive.fileView(QStringLiteral(".wscontents/Tags.wstags")).toByteArray(), QByteArray("tags-v2"));
+        QCOMPARE(archive.readFile(QStringLiteral("/.wscontents/Tags.wstags")), QByteArray("tags-v2"));
+        QCOMPARE(archive.entry(QStringLiteral(".wscontents/Tags.wstags"))->modifiedMsecsSinceEpoch, 4000);
+        QVERIFY(archive.entry(QStringLiteral(".wscontents"))->directory);
+        QVERIFY(archive.fileView(QStringLiteral(".wscontents")).isEmpty());
+        QVERIFY(archive.readFile(QStringLiteral("notes/a.wsnote"), &errorMessage).isEmpty());
+        QVERIFY(errorMessage.contains(QStringLiteral("notes/a.wsnote")));
+        QVERIFY(archive.deadSegmentBytes() > 0);
+    }
+
+    QVERIFY2(WhatSonHubArchive::compact(archivePath, &errorMessage), qPrintable(errorMessage));
+    QVERIFY(QFileInfo(archivePath).size() < sizeBeforeCompaction);
+
+    WhatSonHubArchive compacted;
+    QVERIFY2(compacted.open(archivePath, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(compacted.deadSegmentBytes(), 0);
+    QCOMPARE(compacted.entryCount(), 2);
+    QCOMPARE(compacted.readFile(QStringLiteral(".wscontents/Tags.wstags")), QByteArray("tags-v2"));
+    QVERIFY(!compacted.needsCompaction());
+}
+
+void WhatSonCppRegressionTests::hubArchive_recoversIndexFromSegmentsAfterTornTrailer()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Torn.wshub"));
+
+    QString errorMessage;
+    QVERIFY2(WhatSonHubArchive::create(archivePath, &errorMessage), qPrintable(errorMessage));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral("keep.txt"), QByteArray("keep"), 10, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral("drop/inner.txt"), QByteArray("drop"), 20, &errorMessage));
+        QVERIFY(archive.removeEntry(QStringLiteral("drop/inner.txt"), &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral("keep.txt"), QByteArray("keep-v2"), 30, &errorMessage));
+    }
+
+    QFile archiveFile(archivePath);
+    QVERIFY(archiveFile.open(QIODevice::ReadWrite));
+    QVERIFY(archiveFile.resize(archiveFile.size() - 7));
+    archiveFile.close();
+
+    {
+        WhatSonHubArchive recovered;
+        QVERIFY2(recovered.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(recovered.recoveredFromSegments());
+        QCOMPARE(recovered.entryPaths(), QStringList({QStringLiteral("keep.txt")}));
+        QCOMPARE(recovered.readFile(QStringLiteral("keep.txt")), QByteArray("keep-v2"));
+        QVERIFY(recovered.writeFile(QStringLiteral("after.txt"), QByteArray("after"), 40, &errorMessage));
+    }
+
+    WhatSonHubArchive reopened;
+    QVERIFY2(reopened.open(archivePath, &errorMessage), qPrintable(errorMessage));
+    QVERIFY(!reopened.recoveredFromSegments());
+    QCOMPARE(reopened.entryPaths(), QStringList({QStringLiteral("after.txt"), QStringLiteral("keep.txt")}));
+
+    // A crash in the middle of a streamed write leaves a pending header; recovery keeps the previous version.
+    const QString crashedArchivePath = workspaceDir.filePath(QStringLiteral("Crashed.wshub"));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        InterruptingBuffer stream(
+            QByteArray(3 * 1024 * 1024, 'x'),
+            [&archivePath, &crashedArchivePath]()
+            {
+                QFile::copy(archivePath, crashedArchivePath);
+            });
+        QVERIFY(stream.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+        QVERIFY2(archive.writeFileFromDevice(QStringLiteral("keep.txt"), &stream, 50, &errorMessage),
+                 qPrintable(errorMessage));
+    }
+    QVERIFY(QFileInfo::exists(crashedArchivePath));
+    {
+        WhatSonHubArchive crashed;
+        QVERIFY2(crashed.open(crashedArchivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(crashed.recoveredFromSegments());
+        QCOMPARE(crashed.readFile(QStringLiteral("keep.txt")), QByteArray("keep-v2"));
+    }
+
+    // A segment whose bytes no longer match its sha1 is not trusted either.
+    const QString corruptArchivePath = workspaceDir.filePath(QStringLiteral("Corrupt.wshub"));
+    QVERIFY2(WhatSonHubArchive::create(corruptArchivePath, &errorMessage), qPrintable(errorMessage));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(corruptArchivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral("keep.txt"), QByteArray("keep"), 10, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral("keep.txt"), QByteArray("keep-v2"), 20, &errorMessage));
+    }
+    QByteArray corruptBytes = readArchiveFixtureFile(corruptArchivePath);
+    const qsizetype corruptDataOffset = corruptBytes.lastIndexOf(QByteArray("keep-v2"));
+    QVERIFY(corruptDataOffset > 0);
+    corruptBytes[corruptDataOffset] = 'K';
+    corruptBytes.chop(7);
+    QVERIFY(writeArchiveFixtureFile(corruptArchivePath, corruptBytes));
+    {
+        WhatSonHubArchive corrupt;
+        QVERIFY2(corrupt.open(corruptArchivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(corrupt.recoveredFromSegments());
+        QCOMPARE(corrupt.readFile(QStringLiteral("keep.txt")), QByteArray("keep"));
+    }
+
+    QVERIFY(writeArchiveFixtureFile(workspaceDir.filePath(QStringLiteral("Plain.wshub")), QByteArray("not an archive")));
+    WhatSonHubArchive invalid;
+    QVERIFY(!invalid.open(workspaceDir.filePath(QStringLiteral("Plain.wshub")), &errorMessage));
+    QVERIFY(errorMessage.contains(QStringLiteral("Not a packed WhatSon Hub archive")));
+}
+
+void WhatSonCppRegressionTests::hubArchiveConverter_roundTripsHubDirectoryLosslessly()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString errorMessage;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("RoundTrip.wshub"),
+        &errorMessage);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(errorMessage));
+
+    QByteArray binaryPayload(300000, '\0');
+    for (int index = 0; index < binaryPayload.size(); ++index)
+    {
+        binaryPayload[index] = static_cast<char>(index % 251);
+    }
+    const QString notePath = QDir(hubPath).filePath(
+        QStringLiteral(".wscontents/Library.wslibrary/Alpha.wsnote/Alpha.wsnbody"));
+    QVERIFY(writeArchiveFixtureFile(notePath, QByteArray("<body>Alpha 한국어</body>")));
+    QVERIFY(writeArchiveFixtureFile(
+        QDir(hubPath).filePath(QStringLiteral(".wsresources/Images/blob.wsresource/blob.bin")),
+        binaryPayload));
+    QVERIFY(QDir().mkpath(QDir(hubPath).filePath(QStringLiteral(".wsresources/Empty"))));
+
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed/RoundTrip.wshub"));
+    const WhatSonHubArchiveConverter converter;
+    QVERIFY2(converter.packDirectory(hubPath, archivePath, false, &errorMessage), qPrintable(errorMessage));
+    QVERIFY(WhatSonHubArchive::isPackedArchive(archivePath));
+    QVERIFY(!QFileInfo::exists(archivePath + QStringLiteral(".partial")));
+    QVERIFY(!converter.packDirectory(hubPath, archivePath, false, &errorMessage));
+
+    const QString unpackedPath = workspaceDir.filePath(QStringLiteral("Unpacked/RoundTrip.wshub"));
+    QVERIFY2(converter.unpackArchive(archivePath, unpackedPath, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(relativeEntries(unpackedPath), relativeEntries(hubPath));
+    for (const QString& relativePath : relativeEntries(hubPath))
+    {
+        const QFileInfo sourceInfo(QDir(hubPath).filePath(relativePath));
+        const QFileInfo unpackedInfo(QDir(unpackedPath).filePath(relativePath));
+        QCOMPARE(unpackedInfo.isDir(), sourceInfo.isDir());
+        if (sourceInfo.isFile())
+        {
+            QCOMPARE(readArchiveFixtureFile(unpackedInfo.absoluteFilePath()),
+                     readArchiveFixtureFile(sourceInfo.absoluteFilePath()));
+            QCOMPARE(unpackedInfo.lastModified().toMSecsSinceEpoch(), sourceInfo.lastModified().toMSecsSinceEpoch());
+        }
+    }
+    QVERIFY(!converter.unpackArchive(archivePath, unpackedPath, &errorMessage));
+
+    const QString repackedPath = workspaceDir.filePath(QStringLiteral("Repacked.wshub"));
+    QVERIFY2(converter.packDirectory(unpackedPath, repackedPath, false, &errorMessage), qPrintable(errorMessage));
+    WhatSonHubArchive original;
+    WhatSonHubArchive repacked;
+    QVERIFY(original.open(archivePath, &errorMessage));
+    QVERIFY(repacked.open(repackedPath, &errorMessage));
+    QCOMPARE(repacked.entryPaths(), original.entryPaths());
+    QCOMPARE(
+        repacked.entry(QStringLiteral(".wsresources/Images/blob.wsresource/blob.bin"))->sha1,
+        original.entry(QStringLiteral(".wsresources/Images/blob.wsresource/blob.bin"))->sha1);
+    original.close();
+    repacked.close();
+
+    const WhatSonHubSyncObservationBuilder observationBuilder;
+    const WhatSonHubSyncObservation baseline = observationBuilder.inspectHub(archivePath);
+    QVERIFY(!baseline.signature.isEmpty());
+    QCOMPARE(baseline.directoryWatchPaths, QStringList({QFileInfo(archivePath).absolutePath()}));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY(archive.open(archivePath, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral(".whatson/lease.json"), QByteArray("{}"), 1, &errorMessage));
+    }
+    QCOMPARE(observationBuilder.inspectHub(archivePath).signature, baseline.signature);
+    {
+        WhatSonHubArchive archive;
+        QVERIFY(archive.open(archivePath, &errorMessage));
+        QVERIFY(archive.writeFile(QStringLiteral(".wscontents/Tags.wstags"), QByteArray("changed"), 2, &errorMessage));
+    }
+    QVERIFY(observationBuilder.inspectHub(archivePath).signature != baseline.signature);
+}
@@ -0,0 +1,287 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/hub/WhatSonHubCreator.hpp"
+#include "app/models/file/hub/WhatSonHubStat.hpp"
+#include "app/models/file/validator/WhatSonDomainLoadFailureLog.hpp"
+#include "app/models/file/validator/WhatSonHubIntegrityChecker.hpp"
+#include "app/models/hierarchy/WhatSonFolderIdentity.hpp"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace
+{
+    bool writeIntegrityFixtureFile(const QString& filePath, const QString& text)
+    {
+        QFile file(filePath);
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath())
+            || !file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        {
+            return false;
+        }
+        return file.write(text.toUtf8()) >= 0;
+    }
+
+    bool writeIntegrityNoteHeader(
+        const QString& noteDirectoryPath,
+        const QString& noteId,
+        const QString& folderLabel,
+        const QString& folderUuid)
+    {
+        WhatSonNoteHeaderStore headerStore;
+        headerStore.setNoteId(noteId);
+        headerStore.setCreatedAt(QStringLiteral("2026-04-18-00-00-00"));
+        headerStore.setLastModifiedAt(QStringLiteral("2026-04-18-00-00-00"));
+        headerStore.setFolderBindings({folderLabel}, {folderUuid});
+
+        const WhatSonNoteHeaderCreator headerCreator(noteDirectoryPath, QString());
+        return writeIntegrityFixtureFile(
+            QDir(noteDirectoryPath).filePath(noteId + QStringLiteral(".wsnhead")),
+            headerCreator.createHeaderText(headerStore));
+    }
+
+    QStringList findingKinds(const WhatSonHubIntegrityReport& report, const bool unresolvedOnly = false)
+    {
+        QStringList kinds;
+        for (const WhatSonHubIntegrityFinding& finding : report.findings)
+        {
+            if (!unresolvedOnly || !finding.repaired)
+            {
+                kinds.push_back(WhatSonHubIntegrityFinding::kindName(finding.kind));
+            }
+        }
+        kinds.sort();
+        return kinds;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::hubIntegrityChecker_reportsFindingsAndAppliesSafeRepairs()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString errorMessage;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Integrity.wshub"),
+        &errorMessage);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(errorMessage));
+
+    const QDir hubDirectory(hubPath);
+    const QString knownUuid(WhatSon::FolderIdentity::kUuidLength, QLatin1Char('A'));
+    const QString unknownUuid(WhatSon::FolderIdentity::kUuidLength, QLatin1Char('B'));
+    const QString libraryPath = hubDirectory.filePath(QStringLiteral(".wscontents/Library.wslibrary"));
+
+    QVERIFY(writeIntegrityFixtureFile(
+        hubDirectory.filePath(QStringLiteral(".wscontents/Folders.wsfolders")),
+        QStringLiteral(R"({"folders":[{"id":"Research","label":"Research","uuid":"%1"}]})").arg(knownUuid)));
+    QVERIFY(writeIntegrityNoteHeader(
+        QDir(libraryPath).filePath(QStringLiteral("note-ok")),
+        QStringLiteral("note-ok"),
+        QStringLiteral("Research"),
+        knownUuid));
+    QVERIFY(writeIntegrityFixtureFile(
+        QDir(libraryPath).filePath(QStringLiteral("note-ok/note-ok.wsnbody")),
+        QStringLiteral("<body><resource type=\"image\" format=\".png\" path=\".wsresources/present.wsresource\">"
+                       "<resource path='.wsresources/missing.wsresource'></body>")));
+    QVERIFY(QDir().mkpath(hubDirectory.filePath(QStringLiteral(".wsresources/present.wsresource"))));
+    QVERIFY(writeIntegrityNoteHeader(
+        QDir(libraryPath).filePath(QStringLiteral("note-dangling")),
+        QStringLiteral("note-dangling"),
+        QStringLiteral("Archive"),
+        unknownUuid));
+    QVERIFY(writeIntegrityFixtureFile(
+        QDir(libraryPath).filePath(QStringLiteral("note-broken/note-broken.wsnhead")),
+        QStringLiteral("   \n")));
+    QVERIFY(writeIntegrityFixtureFile(
+        hubDirectory.filePath(QStringLiteral("Integrity.wsstat")),
+        QStringLiteral(R"({"noteCount":7,"resourceCount":1})")));
+    QVERIFY(QFile::remove(hubDirectory.filePath(QStringLiteral(".wscontents/Tags.wstags"))));
+
+    WhatSonHubIntegrityChecker checker;
+    checker.setMaxWorkerCount(4);
+    WhatSonHubIntegrityReport report;
+    QVERIFY2(checker.check(hubPath, &report, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(report.noteCount, 3);
+    QCOMPARE(report.resourceCount, 1);
+    QCOMPARE(findingKinds(report), QStringList({
+        QStringLiteral("danglingFolderUuid"),
+        QStringLiteral("headerParseFailed"),
+        QStringLiteral("missingRequiredEntry"),
+        QStringLiteral("statCountMismatch"),
+        QStringLiteral("unresolvedResource")
+    }));
+    QCOMPARE(report.repairedCount(), 0);
+    QVERIFY(!report.isClean());
+    QVERIFY(!QFileInfo::exists(hubDirectory.filePath(QStringLiteral(".wscontents/Tags.wstags"))));
+
+    for (const WhatSonHubIntegrityFinding& finding : report.findings)
+    {
+        if (finding.kind == WhatSonHubIntegrityFinding::Kind::UnresolvedResource)
+        {
+            QCOMPARE(finding.subject, QStringLiteral(".wsresources/missing.wsresource"));
+            QCOMPARE(finding.path, QStringLiteral(".wscontents/Library.wslibrary/note-ok/note-ok.wsnbody"));
+        }
+        if (finding.kind == WhatSonHubIntegrityFinding::Kind::DanglingFolderUuid)
+        {
+            QCOMPARE(finding.subject, unknownUuid);
+        }
+        QCOMPARE(finding.toVariantMap().value(QStringLiteral("kind")).toString(),
+                 WhatSonHubIntegrityFinding::kindName(finding.kind));
+    }
+
+    checker.setRepairEnabled(true);
+    QVERIFY2(checker.check(hubPath, &report, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(report.repairedCount(), 2);
+    QCOMPARE(findingKinds(report, true), QStringList({
+        QStringLiteral("danglingFolderUuid"),
+        QStringLiteral("headerParseFailed"),
+        QStringLiteral("unresolvedResource")
+    }));
+    const WhatSonHubCreator hubCreator{QString()};
+    QFile tagsFile(hubDirectory.filePath(QStringLiteral(".wscontents/Tags.wstags")));
+    QVERIFY(tagsFile.open(QIODevice::ReadOnly));
+    QCOMPARE(QString::fromUtf8(tagsFile.readAll()), hubCreator.defaultEntryText(QStringLiteral("Tags.wstags")));
+
+    QFile statFile(hubDirectory.filePath(QStringLiteral("Integrity.wsstat")));
+    QVERIFY(statFile.open(QIODevice::ReadOnly));
+    const QJsonObject statRoot = QJsonDocument::fromJson(statFile.readAll()).object();
+    QCOMPARE(statRoot.value(QStringLiteral("noteCount")).toInt(), 3);
+    QCOMPARE(statRoot.value(QStringLiteral("resourceCount")).toInt(), 1);
+
+    checker.setRepairEnabled(false);
+    QVERIFY2(checker.check(hubPath, &report, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(static_cast<int>(report.findings.size()), 3);
+    QCOMPARE(report.summaryVariantMap().value(QStringLiteral("unresolvedCount")).toInt(), 3);
+
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed/Integrity.wshub"));
+    QVERIFY2(WhatSonHubArchiveConverter().packDirectory(hubPath, archivePath, false, &errorMessage),
+             qPrintable(errorMessage));
+    WhatSonHubIntegrityReport packedReport;
+    QVERIFY2(checker.check(archivePath, &packedReport, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(packedReport.hubPath, WhatSon::HubPath::normalizeAbsolutePath(archivePath));
+    QCOMPARE(findingKinds(packedReport), findingKinds(report));
+
+    // Packed repairs are appended to the archive in place; no mount staging copy is created or written back.
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(archive.removeEntry(QStringLiteral(".wscontents/Tags.wstags"), &errorMessage));
+        QVERIFY2(archive.flush(&errorMessage), qPrintable(errorMessage));
+    }
+    checker.setRepairEnabled(true);
+    QVERIFY2(checker.check(archivePath, &packedReport, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(packedReport.repairedCount(), 1);
+    checker.setRepairEnabled(false);
+    QVERIFY(!QFileInfo::exists(WhatSonHubArchiveConverter::mountStagingPath(archivePath)));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &errorMessage), qPrintable(errorMessage));
+        QCOMPARE(
+            QString::fromUtf8(archive.readFile(QStringLiteral(".wscontents/Tags.wstags"), &errorMessage)),
+            hubCreator.defaultEntryText(QStringLiteral("Tags.wstags")));
+    }
+
+    // Missing domain and stat files come back with the scaffold templates rather than as zero-byte files.
+    const QStringList recreatedEntries = {
+        QStringLiteral(".wscontents/Bookmarks.wsbookmarks"),
+        QStringLiteral(".wscontents/Progress.wsprogress"),
+        QStringLiteral(".wscontents/ProjectLists.wsproj"),
+        QStringLiteral(".wscontents/Library.wslibrary/index.wsnindex")
+    };
+    for (const QString& relativePath : recreatedEntries)
+    {
+        QVERIFY(QFile::remove(hubDirectory.filePath(relativePath)));
+    }
+    QVERIFY(QFile::remove(hubDirectory.filePath(QStringLiteral("Integrity.wsstat"))));
+    checker.setRepairEnabled(true);
+    QVERIFY2(checker.check(hubPath, &report, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(report.repairedCount(), static_cast<int>(recreatedEntries.size()) + 1);
+    for (const QString& relativePath : recreatedEntries)
+    {
+        QFile entryFile(hubDirectory.filePath(relativePath));
+        QVERIFY(entryFile.open(QIODevice::ReadOnly));
+        const QByteArray entryBytes = entryFile.readAll();
+        QCOMPARE(QString::fromUtf8(entryBytes), hubCreator.defaultEntryText(QFileInfo(relativePath).fileName()));
+        QVERIFY(QJsonDocument::fromJson(entryBytes).isObject());
+    }
+    QFile recreatedStatFile(hubDirectory.filePath(QStringLiteral("IntegrityStat.wsstat")));
+    QVERIFY(recreatedStatFile.open(QIODevice::ReadOnly));
+    const QJsonObject recreatedStatRoot = QJsonDocument::fromJson(recreatedStatFile.readAll()).object();
+    QCOMPARE(recreatedStatRoot.value(QStringLiteral("schema")).toString(), QStringLiteral("whatson.hub.stat"));
+    QCOMPARE(recreatedStatRoot.value(WhatSonHubStat::noteCountKeys().first()).toInt(), 3);
+    QCOMPARE(recreatedStatRoot.value(WhatSonHubStat::resourceCountKeys().first()).toInt(), 1);
+    QVERIFY(recreatedStatRoot.contains(WhatSonHubStat::characterCountKeys().first()));
+    checker.setRepairEnabled(false);
+
+    QVERIFY(!checker.check(workspaceDir.filePath(QStringLiteral("Missing.wshub")), &report, &errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+}
+
+void WhatSonCppRegressionTests::hubIntegrityChecker_reportsDegradedDomainLoads()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString errorMessage;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Degraded.wshub"),
+        &errorMessage);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(errorMessage));
+    const QString logPath = WhatSonDomainLoadFailureLog::filePath(hubPath);
+
+    // A healthy mount leaves no log behind.
+    QVERIFY2(WhatSonDomainLoadFailureLog::update(hubPath, {}, {QStringLiteral("library")}, &errorMessage),
+             qPrintable(errorMessage));
+    QVERIFY(!QFileInfo::exists(logPath));
+
+    const QMap<QString, QString> failures{
+        {QStringLiteral("library"), QStringLiteral("index.wsnindex is unreadable")},
+        {QStringLiteral("bookmarks"), QStringLiteral("index.wsnindex is unreadable")}
+    };
+    QVERIFY2(WhatSonDomainLoadFailureLog::update(hubPath, failures, {QStringLiteral("tags")}, &errorMessage),
+             qPrintable(errorMessage));
+    QVERIFY2(WhatSonDomainLoadFailureLog::update(
+                 hubPath,
+                 {{QStringLiteral("library"), QStringLiteral("index.wsnindex is still unreadable")}},
+                 {QStringLiteral("bookmarks")},
+                 &errorMessage),
+             qPrintable(errorMessage));
+
+    QVector<WhatSonDomainLoadFailureLog::Entry> entries;
+    QVERIFY2(WhatSonDomainLoadFailureLog::read(hubPath, &entries, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(entries.size(), 1);
+    QCOMPARE(entries.constFirst().domain, QStringLiteral("library"));
+    QCOMPARE(entries.constFirst().attempts, 2);
+    QCOMPARE(entries.constFirst().error, QStringLiteral("index.wsnindex is still unreadable"));
+    QVERIFY(entries.constFirst().firstFailedAtUtc.isValid());
+    QVERIFY(entries.constFirst().firstFailedAtUtc <= entries.constFirst().lastFailedAtUtc);
+
+    WhatSonHubIntegrityChecker checker;
+    WhatSonHubIntegrityReport report;
+    QVERIFY2(checker.check(hubPath, &report, &errorMessage), qPrintable(errorMessage));
+    const auto degradedFinding = std::find_if(
+        report.findings.cbegin(),
+        report.findings.cend(),
+        [](const WhatSonHubIntegrityFinding& finding)
+        {
+            return finding.kind == WhatSonHubIntegrityFinding::Kind::DomainLoadFailed;
+        });
+    QVERIFY(degradedFinding != report.findings.cend());
+    QCOMPARE(WhatSonHubIntegrityFinding::kindName(degradedFinding->kind), QStringLiteral("domainLoadFailed"));
+    QCOMPARE(degradedFinding->subject, QStringLiteral("library"));
+    QCOMPARE(degradedFinding->path, WhatSonDomainLoadFailureLog::relativeFilePath());
+    QVERIFY(degradedFinding->severity == WhatSonHubIntegrityFinding::Severity::Warning);
+    QVERIFY(degradedFinding->message.contains(QStringLiteral("still unreadable")));
+
+    // Once the domain loads again the log is removed and the finding goes with it.
+    QVERIFY2(WhatSonDomainLoadFailureLog::update(hubPath, {}, {QStringLiteral("library")}, &errorMessage),
+             qPrintable(errorMessage));
+    QVERIFY(!QFileInfo::exists(logPath));
+    WhatSonHubIntegrityReport recoveredReport;
+    QVERIFY2(checker.check(hubPath, &recoveredReport, &errorMessage), qPrintable(errorMessage));
+    QVERIFY(!findingKinds(recoveredReport).contains(QStringLiteral("domainLoadFailed")));
+}
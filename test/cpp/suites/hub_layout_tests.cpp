@@ -0,0 +1,63 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/hub/WhatSonHubLayout.hpp"
+#include "app/models/hierarchy/WhatSonHierarchyIoSupport.hpp"
+
+void WhatSonCppRegressionTests::hubLayout_resolvesOncePerMountAndSharesItWithConsumers()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString fixtureError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Layout.wshub"),
+        &fixtureError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(fixtureError));
+    const QString normalizedHubPath = WhatSon::HubPath::normalizeAbsolutePath(hubPath);
+
+    const WhatSonHubLayout layout = WhatSonHubLayout::resolve(hubPath);
+    QVERIFY(layout.hubIsDirectory);
+    QCOMPARE(layout.hubPath, normalizedHubPath);
+    QCOMPARE(layout.contentsPath, QDir(normalizedHubPath).filePath(QStringLiteral(".wscontents")));
+    QCOMPARE(layout.contentsDirectories, QStringList{layout.contentsPath});
+    QCOMPARE(layout.libraryPath, QDir(layout.contentsPath).filePath(QStringLiteral("Library.wslibrary")));
+    QCOMPARE(layout.libraryRoots, QStringList{layout.libraryPath});
+    QCOMPARE(layout.resourcesPath, QDir(normalizedHubPath).filePath(QStringLiteral(".wsresources")));
+    QVERIFY(!layout.statPaths.isEmpty());
+    for (int index = 0; index < WhatSonHubLayout::kEntryCount; ++index)
+    {
+        QVERIFY2(layout.entryMatches(static_cast<WhatSonHubLayout::Entry>(index)),
+                 qPrintable(layout.entryPath(static_cast<WhatSonHubLayout::Entry>(index))));
+    }
+
+    // Hub stat, hub listing, contents listing and the library index probe; the library itself is never listed.
+    QCOMPARE(layout.filesystemProbeCount, 4);
+
+    const WhatSonHubMountValidation validation = WhatSonHubMountValidator().resolveMountedHub(hubPath);
+    QVERIFY2(validation.mounted, qPrintable(validation.failureMessage));
+    QVERIFY(validation.layout != nullptr);
+    QCOMPARE(WhatSonHubLayout::cached(hubPath), validation.layout);
+    QVERIFY(validation.layout->isCurrent());
+
+    QStringList contentsDirectories;
+    QVERIFY(WhatSon::Hierarchy::IoSupport::resolveContentsDirectories(hubPath, &contentsDirectories));
+    QCOMPARE(contentsDirectories, validation.layout->contentsDirectories);
+    QCOMPARE(WhatSonHubLayout::cached(hubPath), validation.layout);
+
+    WhatSonHubLayout::invalidate(validation.layout->libraryPath);
+    const std::shared_ptr<const WhatSonHubLayout> reresolved = WhatSonHubLayout::cached(hubPath);
+    QVERIFY(reresolved != validation.layout);
+    QCOMPARE(reresolved->contentsDirectories, validation.layout->contentsDirectories);
+
+    QVERIFY(QFile::remove(QDir(hubPath).filePath(QStringLiteral(".wscontents/Tags.wstags"))));
+    const std::shared_ptr<const WhatSonHubLayout> refreshed = WhatSonHubLayout::refresh(hubPath);
+    QCOMPARE(refreshed->entryKind(WhatSonHubLayout::Entry::Tags), WhatSonHubLayout::EntryKind::Missing);
+    QVERIFY(!WhatSonHubMountValidator().resolveMountedHub(hubPath).mounted);
+
+    WhatSonHubLayout::invalidate(workspaceDir.path());
+    QVERIFY(QDir(hubPath).removeRecursively());
+    const std::shared_ptr<const WhatSonHubLayout> removed = WhatSonHubLayout::cached(hubPath);
+    QVERIFY(!removed->hubExists);
+    QVERIFY(!WhatSon::Hierarchy::IoSupport::resolveContentsDirectories(hubPath, &contentsDirectories));
+}
@@ -41,3 +41,165 @@ void WhatSonCppRegressionTests::hubMountValidator_rejectsIncompleteHubPackage()
     QVERIFY(validation.failureMessage.contains(QStringLiteral("Required hub entry is missing")));
     QVERIFY(validation.failureMessage.contains(QStringLiteral("Tags.wstags")));
 }
+
+void WhatSonCppRegressionTests::hubMountValidator_mountsPackedHubArchiveThroughStagingDirectory()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString fixtureError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Source.wshub"),
+        &fixtureError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(fixtureError));
+
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed/Workspace.wshub"));
+    const WhatSonHubArchiveConverter converter;
+    QVERIFY2(converter.packDirectory(hubPath, archivePath, false, &fixtureError), qPrintable(fixtureError));
+
+    const WhatSonHubMountValidator hubMountValidator;
+    const WhatSonHubMountValidation validation = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY2(validation.mounted, qPrintable(validation.failureMessage));
+    QCOMPARE(validation.packedArchivePath, WhatSon::HubPath::normalizeAbsolutePath(archivePath));
+    QCOMPARE(validation.hubPath, WhatSonHubArchiveConverter::mountStagingPath(archivePath));
+    QVERIFY(QFileInfo(QDir(validation.hubPath).filePath(QStringLiteral(".wscontents/Tags.wstags"))).isFile());
+
+    const WhatSonHubMountValidation remount = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY2(remount.mounted, qPrintable(remount.failureMessage));
+    QCOMPARE(remount.hubPath, validation.hubPath);
+
+    {
+        WhatSonHubArchive archive;
+        QVERIFY(archive.open(archivePath, &fixtureError));
+        QVERIFY(archive.removeEntry(QStringLiteral(".wscontents/Tags.wstags"), &fixtureError));
+    }
+    const WhatSonHubMountValidation broken = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY(!broken.mounted);
+    QVERIFY(broken.failureMessage.contains(QStringLiteral("Tags.wstags")));
+    QDir(QFileInfo(validation.hubPath).absolutePath()).removeRecursively();
+}
+
+void WhatSonCppRegressionTests::hubMountValidator_writesPackedHubEditsBackToArchive()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString fixtureError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Source.wshub"),
+        &fixtureError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(fixtureError));
+
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed/Edited.wshub"));
+    const WhatSonHubArchiveConverter converter;
+    QVERIFY2(converter.packDirectory(hubPath, archivePath, false, &fixtureError), qPrintable(fixtureError));
+
+    const WhatSonHubMountValidator hubMountValidator;
+    const WhatSonHubMountValidation validation = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY2(validation.mounted, qPrintable(validation.failureMessage));
+    QVERIFY(!WhatSonHubArchiveConverter::stagingHasUnsavedChanges(archivePath));
+
+    const QByteArray editedTags = QByteArrayLiteral("<?xml version=\"1.0\"?>\n<tags edited=\"true\"/>\n");
+    const QString stagedTagsPath = QDir(validation.hubPath).filePath(QStringLiteral(".wscontents/Tags.wstags"));
+    {
+        QFile tagsFile(stagedTagsPath);
+        QVERIFY(tagsFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(tagsFile.write(editedTags), editedTags.size());
+    }
+    {
+        QFile extraFile(QDir(validation.hubPath).filePath(QStringLiteral(".wscontents/extra.txt")));
+        QVERIFY(extraFile.open(QIODevice::WriteOnly));
+        QVERIFY(extraFile.write("extra") == 5);
+    }
+    QVERIFY(WhatSonHubArchiveConverter::stagingHasUnsavedChanges(archivePath));
+
+    // Remounting an unchanged archive keeps the staged edits.
+    const WhatSonHubMountValidation remount = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY2(remount.mounted, qPrintable(remount.failureMessage));
+    QFile remountedTags(stagedTagsPath);
+    QVERIFY(remountedTags.open(QIODevice::ReadOnly));
+    QCOMPARE(remountedTags.readAll(), editedTags);
+    remountedTags.close();
+
+    QVERIFY2(converter.writeBackStaging(archivePath, &fixtureError), qPrintable(fixtureError));
+    QVERIFY(!WhatSonHubArchiveConverter::stagingHasUnsavedChanges(archivePath));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY(archive.open(archivePath, &fixtureError));
+        QCOMPARE(archive.readFile(QStringLiteral(".wscontents/Tags.wstags")), editedTags);
+        QCOMPARE(archive.readFile(QStringLiteral(".wscontents/extra.txt")), QByteArrayLiteral("extra"));
+    }
+
+    // An archive replaced on disk must not be unpacked over edits that were never written back.
+    QVERIFY(QFile::remove(QDir(validation.hubPath).filePath(QStringLiteral(".wscontents/extra.txt"))));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY(archive.open(archivePath, &fixtureError));
+        QVERIFY(archive.writeFile(QStringLiteral("outside.txt"), QByteArrayLiteral("outside"), 0, &fixtureError));
+    }
+    const WhatSonHubMountValidation conflicting = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY(!conflicting.mounted);
+    QVERIFY(conflicting.failureMessage.contains(QStringLiteral("unsaved edits")));
+    QVERIFY(!converter.writeBackStaging(archivePath, &fixtureError));
+    QVERIFY(QFileInfo(stagedTagsPath).isFile());
+    QVERIFY(WhatSonHubArchiveConverter::stagingHasUnsavedChanges(archivePath));
+    QDir(QFileInfo(validation.hubPath).absolutePath()).removeRecursively();
+}
+
+void WhatSonCppRegressionTests::hubMountValidator_compactsPackedHubInBackgroundWithoutDirtyingMount()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString fixtureError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Source.wshub"),
+        &fixtureError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(fixtureError));
+
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed/Compacted.wshub"));
+    const WhatSonHubArchiveConverter converter;
+    QVERIFY2(converter.packDirectory(hubPath, archivePath, false, &fixtureError), qPrintable(fixtureError));
+
+    const WhatSonHubMountValidator hubMountValidator;
+    const WhatSonHubMountValidation validation = hubMountValidator.resolveMountedHub(archivePath);
+    QVERIFY2(validation.mounted, qPrintable(validation.failureMessage));
+
+    // Three generations of a 2 MiB attachment leave two superseded copies, enough for needsCompaction().
+    const QString stagedBlobPath = QDir(validation.hubPath).filePath(QStringLiteral(".wscontents/blob.bin"));
+    QByteArray blob;
+    for (int generation = 0; generation < 3; ++generation)
+    {
+        blob = QByteArray(2 * 1024 * 1024 + generation, static_cast<char>('a' + generation));
+        QFile blobFile(stagedBlobPath);
+        QVERIFY(blobFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(blobFile.write(blob), blob.size());
+        blobFile.close();
+        QVERIFY2(converter.writeBackStaging(archivePath, &fixtureError), qPrintable(fixtureError));
+    }
+    WhatSonHubArchiveConverter::waitForBackgroundMaintenance();
+
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &fixtureError), qPrintable(fixtureError));
+        QCOMPARE(archive.deadSegmentBytes(), qint64(0));
+        QCOMPARE(archive.readFile(QStringLiteral(".wscontents/blob.bin")), blob);
+    }
+    QVERIFY(!WhatSonHubArchiveConverter::stagingHasUnsavedChanges(archivePath));
+
+    // The compacted archive still matches the mount stamp, so later edits write back instead of conflicting.
+    QFile blobFile(stagedBlobPath);
+    QVERIFY(blobFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(blobFile.write("small"), qint64(5));
+    blobFile.close();
+    QVERIFY2(converter.writeBackStaging(archivePath, &fixtureError, false), qPrintable(fixtureError));
+    {
+        WhatSonHubArchive archive;
+        QVERIFY2(archive.open(archivePath, &fixtureError), qPrintable(fixtureError));
+        QCOMPARE(archive.readFile(QStringLiteral(".wscontents/blob.bin")), QByteArrayLiteral("small"));
+    }
+    QDir(QFileInfo(validation.hubPath).absolutePath()).removeRecursively();
+}
@@ -0,0 +1,140 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/hub/WhatSonHubSnapshotStore.hpp"
+#include "app/models/file/journal/WhatSonHubMutationJournal.hpp"
+
+namespace
+{
+    bool writeJournalFixtureFile(const QString& filePath, const QByteArray& bytes)
+    {
+        QFile file(filePath);
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath())
+            || !file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        return file.write(bytes) == bytes.size();
+    }
+
+    QByteArray readJournalFixtureFile(const QString& filePath)
+    {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return {};
+        }
+        return file.readAll();
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::hubMutationJournal_undoesBatchesAsOneStepAcrossRestart()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString errorMessage;
+    const QString hubPath = createMinimalHubFixture(workspaceDir.path(), QStringLiteral("Journal.wshub"), &errorMessage);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(errorMessage));
+
+    const QDir hubDirectory(hubPath);
+    const QString foldersPath = hubDirectory.filePath(QStringLiteral(".wscontents/Folders.wsfolders"));
+    const QString libraryPath = hubDirectory.filePath(QStringLiteral(".wscontents/Library.wslibrary"));
+    QVERIFY(writeJournalFixtureFile(foldersPath, "folders-v1"));
+    for (int index = 0; index < 20; ++index)
+    {
+        QVERIFY(writeJournalFixtureFile(
+            QDir(libraryPath).filePath(QStringLiteral("note-%1/note-%1.wsnhead").arg(index)),
+            QByteArray("head-v1-") + QByteArray::number(index)));
+    }
+
+    {
+        WhatSonHubMutationJournal::Scope scope(foldersPath, QStringLiteral("Rename folder"));
+        QVERIFY(scope.isActive());
+        QVERIFY(writeJournalFixtureFile(foldersPath, "folders-v2"));
+        QVERIFY2(scope.commit(&errorMessage), qPrintable(errorMessage));
+    }
+    {
+        WhatSonHubMutationJournal::Scope unchangedScope(foldersPath, QStringLiteral("No-op"));
+        QVERIFY(unchangedScope.commit());
+    }
+
+    {
+        const WhatSonHubMutationJournal::BatchScope batch(QStringLiteral("Delete notes"));
+        for (int index = 0; index < 20; ++index)
+        {
+            const QString noteDirectoryPath = QDir(libraryPath).filePath(QStringLiteral("note-%1").arg(index));
+            WhatSonHubMutationJournal::Scope scope(noteDirectoryPath, QStringLiteral("Delete note"));
+            QVERIFY(QDir(noteDirectoryPath).removeRecursively());
+            QVERIFY(scope.commit());
+        }
+        WhatSonHubMutationJournal::Scope createScope(libraryPath, QStringLiteral("Create note"));
+        QVERIFY(writeJournalFixtureFile(QDir(libraryPath).filePath(QStringLiteral("fresh/fresh.wsnhead")), "fresh"));
+        QVERIFY(createScope.commit());
+    }
+
+    // The batch took one whole-hub snapshot before its first delete; single scopes take none.
+    const QVector<WhatSonHubSnapshotInfo> batchSnapshots = WhatSonHubSnapshotStore(hubPath).listSnapshots();
+    QCOMPARE(batchSnapshots.size(), 1);
+    QCOMPARE(batchSnapshots.constFirst().label, QStringLiteral("Before Delete notes"));
+    WhatSonHubSnapshotDiff batchDiff;
+    QVERIFY2(WhatSonHubSnapshotStore(hubPath).diffSnapshotAgainstHub(
+                 batchSnapshots.constFirst().id,
+                 &batchDiff,
+                 &errorMessage),
+             qPrintable(errorMessage));
+    QCOMPARE(batchDiff.removed.size(), 20);
+    QCOMPARE(batchDiff.added.size(), 1);
+
+    const auto journal = WhatSonHubMutationJournal::forHub(hubPath);
+    QVERIFY(journal != nullptr);
+    QCOMPARE(journal->steps().size(), 2);
+    QCOMPARE(journal->undoLabel(), QStringLiteral("Delete notes"));
+    QCOMPARE(journal->steps().constLast().entries.size(), 21);
+
+    QStringList touchedPaths;
+    QVERIFY2(journal->undo(&touchedPaths, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(touchedPaths.size(), 21);
+    QCOMPARE(
+        readJournalFixtureFile(QDir(libraryPath).filePath(QStringLiteral("note-7/note-7.wsnhead"))),
+        QByteArray("head-v1-7"));
+    QVERIFY(!QFileInfo::exists(QDir(libraryPath).filePath(QStringLiteral("fresh"))));
+    QVERIFY(QFileInfo(libraryPath).isDir());
+    QCOMPARE(journal->redoLabel(), QStringLiteral("Delete notes"));
+
+    WhatSonHubMutationJournal reloadedJournal(hubPath);
+    QCOMPARE(reloadedJournal.steps().size(), 2);
+    QCOMPARE(reloadedJournal.cursor(), 1);
+    QVERIFY2(reloadedJournal.undo(nullptr, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(readJournalFixtureFile(foldersPath), QByteArray("folders-v1"));
+    QVERIFY2(reloadedJournal.redo(nullptr, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(readJournalFixtureFile(foldersPath), QByteArray("folders-v2"));
+
+    QVERIFY(writeJournalFixtureFile(foldersPath, "edited-elsewhere"));
+    QVERIFY(!reloadedJournal.undo(nullptr, &errorMessage));
+    QVERIFY(errorMessage.contains(QStringLiteral("Folders.wsfolders")));
+    QCOMPARE(readJournalFixtureFile(foldersPath), QByteArray("edited-elsewhere"));
+
+    WhatSonHubMutationJournal::Scope outsideScope(workspaceDir.filePath(QStringLiteral("loose.txt")), QStringLiteral("Loose"));
+    QVERIFY(!outsideScope.isActive());
+}
+
+void WhatSonCppRegressionTests::hubMutationJournal_wrapsEveryHierarchyStoreWrite()
+{
+    const QStringList controllerPaths{
+        QStringLiteral("src/app/models/hierarchy/event/EventHierarchyController.cpp"),
+        QStringLiteral("src/app/models/hierarchy/preset/PresetHierarchyController.cpp"),
+        QStringLiteral("src/app/models/hierarchy/projects/ProjectsHierarchyController.cpp"),
+        QStringLiteral("src/app/models/hierarchy/library/WhatSonLibraryFolderHierarchyMutationService.cpp"),
+    };
+
+    for (const QString& path : controllerPaths)
+    {
+        const QString source = readUtf8SourceFile(path);
+        QVERIFY2(!source.isEmpty(), qPrintable(path));
+        const int writeCount = source.count(QStringLiteral("stagedStore.writeToFile("));
+        QVERIFY2(writeCount > 0, qPrintable(path));
+        QVERIFY2(source.count(QStringLiteral("WhatSonHubMutationJournal::Scope journalScope(")) == writeCount,
+                 qPrintable(path));
+        QVERIFY2(source.count(QStringLiteral("journalScope.commit();")) == writeCount, qPrintable(path));
+    }
+}
@@ -0,0 +1,153 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/query/WhatSonHubQueryFilter.hpp"
+#include "app/models/file/query/WhatSonHubQueryIndex.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
+
+namespace
+{
+    bool writeQueryFixtureFile(const QString& filePath, const QString& text)
+    {
+        QFile file(filePath);
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath())
+            || !file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        {
+            return false;
+        }
+        return file.write(text.toUtf8()) >= 0;
+    }
+
+    bool writeQueryNote(
+        const QString& libraryPath,
+        const QString& noteId,
+        const QStringList& tags,
+        const QString& project,
+        const int progress,
+        const bool bookmarked,
+        const QString& bodyText = QString())
+    {
+        WhatSonNoteHeaderStore headerStore;
+        headerStore.setNoteId(noteId);
+        headerStore.setCreatedAt(QStringLiteral("2026-04-18-00-00-00"));
+        headerStore.setLastModifiedAt(QStringLiteral("2026-04-18-00-00-00"));
+        headerStore.setTags(tags);
+        headerStore.setProject(project);
+        headerStore.setProgress(progress);
+        headerStore.setOpenCount(progress * 2);
+        headerStore.setBookmarked(bookmarked);
+
+        const QString noteDirectoryPath = QDir(libraryPath).filePath(noteId);
+        const WhatSonNoteHeaderCreator headerCreator(noteDirectoryPath, QString());
+        return writeQueryFixtureFile(
+                   QDir(noteDirectoryPath).filePath(noteId + QStringLiteral(".wsnhead")),
+                   headerCreator.createHeaderText(headerStore))
+            && writeQueryFixtureFile(
+                   QDir(noteDirectoryPath).filePath(noteId + QStringLiteral(".wsnbody")),
+                   bodyText.isEmpty() ? QStringLiteral("<body></body>") : bodyText);
+    }
+
+    QStringList matchingNoteIds(const WhatSonHubQueryIndex& index, const QString& expression)
+    {
+        WhatSonHubQueryFilter filter;
+        if (!filter.parse(expression))
+        {
+            return {QStringLiteral("<parse error>")};
+        }
+        QStringList noteIds;
+        for (const WhatSonHubQueryNote& note : index.notes())
+        {
+            if (filter.matches(note))
+            {
+                noteIds.push_back(note.record.noteId);
+            }
+        }
+        noteIds.sort();
+        return noteIds;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::hubQuery_filtersNotesAndResourcesFromCachedIndex()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString errorMessage;
+    const QString hubPath = createMinimalHubFixture(workspaceDir.path(), QStringLiteral("Query.wshub"), &errorMessage);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(errorMessage));
+
+    const QDir hubDirectory(hubPath);
+    const QString libraryPath = hubDirectory.filePath(QStringLiteral(".wscontents/Library.wslibrary"));
+    QVERIFY(writeQueryNote(
+        libraryPath,
+        QStringLiteral("note-a"),
+        {QStringLiteral("draft"), QStringLiteral("idea")},
+        QStringLiteral("Alpha"),
+        1,
+        true,
+        QStringLiteral("<body><resource path=\".wsresources/used.wsresource\"></body>")));
+    QVERIFY(writeQueryNote(libraryPath, QStringLiteral("note-b"), {QStringLiteral("draft")}, QStringLiteral("Beta"), 3, false));
+    QVERIFY(writeQueryNote(libraryPath, QStringLiteral("note-c"), {}, QStringLiteral("Alpha"), 5, false));
+    QVERIFY(QDir().mkpath(hubDirectory.filePath(QStringLiteral(".wsresources/used.wsresource"))));
+    QVERIFY(QDir().mkpath(hubDirectory.filePath(QStringLiteral(".wsresources/orphan.wsresource"))));
+
+    WhatSonHubQueryIndex index;
+    index.setMaxWorkerCount(2);
+    index.setCacheDirectoryPath(workspaceDir.filePath(QStringLiteral("cache")));
+    QVERIFY2(index.load(hubPath, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(index.notes().size(), 3);
+    QCOMPARE(index.resources().size(), 2);
+    QCOMPARE(index.reusedEntryCount(), 0);
+
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("tag:draft")), QStringList({QStringLiteral("note-a"), QStringLiteral("note-b")}));
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("project:alpha progress>=2")), QStringList({QStringLiteral("note-c")}));
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("-bookmarked:yes tag:draft,idea")), QStringList({QStringLiteral("note-b")}));
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("progress:1")), QStringList({QStringLiteral("note-a")}));
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("opencount>=6")), QStringList({QStringLiteral("note-b"), QStringLiteral("note-c")}));
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("id:note-* project!=Beta")), QStringList({QStringLiteral("note-a"), QStringLiteral("note-c")}));
+    QCOMPARE(matchingNoteIds(index, QStringLiteral("resource:.wsresources/used.wsresource")), QStringList({QStringLiteral("note-a")}));
+
+    WhatSonHubQueryFilter resourceFilter(WhatSonHubQueryFilter::Target::Resources);
+    QVERIFY2(resourceFilter.parse(QStringLiteral("unused:true"), &errorMessage), qPrintable(errorMessage));
+    QStringList unusedResources;
+    for (const WhatSonHubQueryResource& resource : index.resources())
+    {
+        if (resourceFilter.matches(resource))
+        {
+            unusedResources.push_back(resource.resourcePath);
+        }
+    }
+    QCOMPARE(unusedResources, QStringList({QStringLiteral(".wsresources/orphan.wsresource")}));
+
+    WhatSonHubQueryFilter invalidFilter;
+    QVERIFY(!invalidFilter.parse(QStringLiteral("colour:red"), &errorMessage));
+    QVERIFY(errorMessage.contains(QStringLiteral("colour")));
+    QVERIFY(!invalidFilter.parse(QStringLiteral("tag"), &errorMessage));
+
+    WhatSonHubQueryIndex warmIndex;
+    warmIndex.setCacheDirectoryPath(workspaceDir.filePath(QStringLiteral("cache")));
+    QVERIFY2(warmIndex.load(hubPath, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(warmIndex.parsedEntryCount(), 0);
+    QCOMPARE(warmIndex.reusedEntryCount(), 5);
+    QCOMPARE(matchingNoteIds(warmIndex, QStringLiteral("tag:draft")), matchingNoteIds(index, QStringLiteral("tag:draft")));
+
+    QVERIFY(writeQueryNote(libraryPath, QStringLiteral("note-b"), {QStringLiteral("final")}, QStringLiteral("Beta"), 4, false, QStringLiteral("<body>changed</body>")));
+    QVERIFY2(warmIndex.load(hubPath, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(warmIndex.parsedEntryCount(), 1);
+    QCOMPARE(matchingNoteIds(warmIndex, QStringLiteral("tag:final")), QStringList({QStringLiteral("note-b")}));
+
+    // Packed hubs are indexed straight from the archive instead of through the mount staging directory.
+    const QString archivePath = workspaceDir.filePath(QStringLiteral("Packed/Query.wshub"));
+    QVERIFY2(WhatSonHubArchiveConverter().packDirectory(hubPath, archivePath, false, &errorMessage), qPrintable(errorMessage));
+    WhatSonHubQueryIndex packedIndex;
+    packedIndex.setMaxWorkerCount(2);
+    QVERIFY2(packedIndex.load(archivePath, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(packedIndex.notes().size(), 3);
+    QCOMPARE(packedIndex.resources().size(), 2);
+    QCOMPARE(packedIndex.parsedEntryCount(), 5);
+    QCOMPARE(matchingNoteIds(packedIndex, QStringLiteral("tag:final")), QStringList({QStringLiteral("note-b")}));
+    QCOMPARE(
+        matchingNoteIds(packedIndex, QStringLiteral("resource:.wsresources/used.wsresource")),
+        QStringList({QStringLiteral("note-a")}));
+    QVERIFY(!readUtf8SourceFile(QStringLiteral("src/app/models/file/query/WhatSonHubQueryIndex.cpp"))
+                 .contains(QStringLiteral("materializeForMount")));
+}
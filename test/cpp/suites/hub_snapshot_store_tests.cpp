@@ -0,0 +1,131 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/hub/WhatSonHubSnapshotStore.hpp"
+
+namespace
+{
+    bool writeSnapshotFixtureFile(const QString& filePath, const QByteArray& bytes)
+    {
+        QFile file(filePath);
+        if (!QDir().mkpath(QFileInfo(filePath).absolutePath())
+            || !file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        return file.write(bytes) == bytes.size();
+    }
+
+    QByteArray readSnapshotFixtureFile(const QString& filePath)
+    {
+        QFile file(filePath);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    int snapshotObjectCount(const QString& hubPath)
+    {
+        int count = 0;
+        QDirIterator iterator(
+            QDir(hubPath).filePath(WhatSonHubSnapshotStore::storageRelativePath() + QStringLiteral("/objects")),
+            QDir::Files,
+            QDirIterator::Subdirectories);
+        while (iterator.hasNext())
+        {
+            iterator.next();
+            ++count;
+        }
+        return count;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::hubSnapshotStore_sharesUnchangedObjectsAndRestoresPointInTime()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+    const QString hubPath = QDir(workspaceDir.path()).filePath(QStringLiteral("Snapshot.wshub"));
+    const QDir hubDirectory(hubPath);
+    const QString notePath = hubDirectory.filePath(QStringLiteral(".wscontents/Library.wslibrary/note/note.wsnbody"));
+    const QString foldersPath = hubDirectory.filePath(QStringLiteral(".wscontents/Folders.wsfolders"));
+    QVERIFY(writeSnapshotFixtureFile(notePath, QByteArrayLiteral("<body>first</body>")));
+    QVERIFY(writeSnapshotFixtureFile(foldersPath, QByteArrayLiteral(R"({"folders":[]})")));
+    QVERIFY(writeSnapshotFixtureFile(
+        hubDirectory.filePath(QStringLiteral(".whatson/hub.json")),
+        QByteArrayLiteral("{}")));
+
+    WhatSonHubSnapshotStore store(hubPath);
+    store.setRetentionCount(3);
+    QString errorMessage;
+    WhatSonHubSnapshotInfo first;
+    QVERIFY2(store.createSnapshot(QStringLiteral("first"), &first, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(first.fileCount, 2);
+    QCOMPARE(snapshotObjectCount(hubPath), 2);
+
+    QVERIFY(writeSnapshotFixtureFile(notePath, QByteArrayLiteral("<body>second draft</body>")));
+    const QString extraPath = hubDirectory.filePath(QStringLiteral(".wscontents/Extra.wsresources"));
+    QVERIFY(writeSnapshotFixtureFile(extraPath, QByteArrayLiteral("extra")));
+
+    WhatSonHubSnapshotDiff liveDiff;
+    QVERIFY2(store.diffSnapshotAgainstHub(first.id, &liveDiff, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(liveDiff.added, QStringList({QStringLiteral(".wscontents/Extra.wsresources")}));
+    QCOMPARE(liveDiff.modified, QStringList({QStringLiteral(".wscontents/Library.wslibrary/note/note.wsnbody")}));
+    QVERIFY(liveDiff.removed.isEmpty());
+
+    WhatSonHubSnapshotInfo second;
+    QVERIFY2(store.createSnapshot(QStringLiteral("second"), &second, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(second.fileCount, 3);
+    QCOMPARE(snapshotObjectCount(hubPath), 4);
+    QVERIFY(second.storedBytes < second.totalBytes);
+
+    WhatSonHubSnapshotDiff snapshotDiff;
+    QVERIFY(store.diffSnapshots(first.id, second.id, &snapshotDiff, &errorMessage));
+    QCOMPARE(snapshotDiff.added.size(), 1);
+    QCOMPARE(snapshotDiff.modified.size(), 1);
+
+    // Same-millisecond ids get zero-padded suffixes, so "-002" lists before "-010" and both after the bare id.
+    const QString manifestsPath = QDir(hubPath).filePath(
+        WhatSonHubSnapshotStore::storageRelativePath() + QStringLiteral("/manifests"));
+    const QStringList collisionIds{first.id + QStringLiteral("-010"), first.id + QStringLiteral("-002")};
+    for (const QString& collisionId : collisionIds)
+    {
+        QVERIFY(QFile::copy(
+            QDir(manifestsPath).filePath(first.id + QStringLiteral(".json")),
+            QDir(manifestsPath).filePath(collisionId + QStringLiteral(".json"))));
+    }
+    QStringList listedIds;
+    for (const WhatSonHubSnapshotInfo& snapshot : store.listSnapshots())
+    {
+        listedIds.push_back(snapshot.id);
+    }
+    QCOMPARE(listedIds, QStringList({first.id, collisionIds.at(1), collisionIds.at(0), second.id}));
+    for (const QString& collisionId : collisionIds)
+    {
+        QVERIFY(store.removeSnapshot(collisionId, &errorMessage));
+    }
+
+    // Restore stages into .whatson/snapshots and swaps by rename; a staging directory left by an interrupted run is
+    // cleared, and nothing is left behind on success.
+    const QString leftoverStagingPath = QDir(hubPath).filePath(
+        WhatSonHubSnapshotStore::storageRelativePath() + QStringLiteral("/restore-interrupted/displaced/stale"));
+    QVERIFY(writeSnapshotFixtureFile(leftoverStagingPath, QByteArrayLiteral("stale")));
+    QVERIFY2(store.restoreSnapshot(first.id, &errorMessage), qPrintable(errorMessage));
+    QVERIFY(QDir(QDir(hubPath).filePath(WhatSonHubSnapshotStore::storageRelativePath()))
+                .entryList(QStringList{QStringLiteral("restore-*")}, QDir::Dirs | QDir::NoDotAndDotDot)
+                .isEmpty());
+    QCOMPARE(readSnapshotFixtureFile(notePath), QByteArrayLiteral("<body>first</body>"));
+    QVERIFY(!QFileInfo::exists(extraPath));
+    QVERIFY(QFileInfo::exists(hubDirectory.filePath(QStringLiteral(".whatson/hub.json"))));
+
+    const QVector<WhatSonHubSnapshotInfo> snapshots = store.listSnapshots();
+    QCOMPARE(snapshots.size(), 3);
+    QCOMPARE(snapshots.constFirst().id, first.id);
+    QVERIFY(snapshots.constLast().label.contains(first.id));
+
+    WhatSonHubSnapshotDiff afterRestore;
+    QVERIFY(store.diffSnapshotAgainstHub(first.id, &afterRestore, &errorMessage));
+    QVERIFY(afterRestore.isEmpty());
+
+    store.setRetentionCount(1);
+    QCOMPARE(store.pruneSnapshots(&errorMessage), 2);
+    QCOMPARE(store.listSnapshots().size(), 1);
+    QCOMPARE(snapshotObjectCount(hubPath), 3);
+    QVERIFY(!store.restoreSnapshot(first.id, &errorMessage));
+}
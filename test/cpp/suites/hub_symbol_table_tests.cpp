@@ -0,0 +1,168 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/hub/WhatSonHubSymbolTable.hpp"
+#include "app/models/hierarchy/WhatSonFolderIdentity.hpp"
+#include "app/models/hierarchy/library/LibraryAll.hpp"
+
+void WhatSonCppRegressionTests::hubSymbolTable_internsIdentifiersIntoDenseSymbols()
+{
+    using Kind = WhatSonHubSymbolTable::Kind;
+
+    WhatSonHubSymbolTable symbols;
+    QCOMPARE(symbols.intern(Kind::NoteId, QStringLiteral(" note-a ")), 0);
+    QCOMPARE(symbols.intern(Kind::NoteId, QStringLiteral("note-a")), 0);
+    QCOMPARE(symbols.intern(Kind::NoteId, QStringLiteral("note-b")), 1);
+    QCOMPARE(symbols.text(Kind::NoteId, 1), QStringLiteral("note-b"));
+    QCOMPARE(symbols.find(Kind::NoteId, QStringLiteral("note-a")), 0);
+    QCOMPARE(symbols.find(Kind::NoteId, QStringLiteral("NOTE-A")), WhatSonHubSymbolTable::kNoSymbol);
+    const QString folderUuid = WhatSonHubSymbolTable::normalize(
+        Kind::FolderUuid,
+        QString(WhatSon::FolderIdentity::kUuidLength, QLatin1Char('A')));
+    QVERIFY(!folderUuid.isEmpty());
+    QCOMPARE(symbols.intern(Kind::FolderUuid, folderUuid), 0);
+    QCOMPARE(symbols.find(Kind::FolderUuid, folderUuid), 0);
+    QCOMPARE(symbols.intern(Kind::FolderUuid, QStringLiteral("   ")), WhatSonHubSymbolTable::kNoSymbol);
+    QCOMPARE(symbols.text(Kind::FolderUuid, 3), QString());
+    QCOMPARE(symbols.count(Kind::NoteId), 2);
+    QCOMPARE(symbols.count(Kind::FolderUuid), 1);
+    symbols.clear();
+    QCOMPARE(symbols.count(Kind::NoteId), 0);
+    QCOMPARE(symbols.find(Kind::NoteId, QStringLiteral("note-a")), WhatSonHubSymbolTable::kNoSymbol);
+
+    LibraryAll libraryAll;
+    QVector<LibraryNoteRecord> notes;
+    for (int index = 0; index < 4; ++index)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("note-%1").arg(index);
+        notes.push_back(note);
+    }
+    libraryAll.setIndexedNotes(QStringLiteral("/tmp/Symbols.wshub"), notes);
+    QVERIFY(libraryAll.removeNoteById(QStringLiteral(" note-1 ")));
+    QVERIFY(!libraryAll.removeNoteById(QStringLiteral("note-1")));
+    LibraryNoteRecord resolved;
+    QVERIFY(libraryAll.noteById(QStringLiteral("note-3"), &resolved));
+    QCOMPARE(resolved.noteId, QStringLiteral("note-3"));
+    LibraryNoteRecord renamed;
+    renamed.noteId = QStringLiteral("note-2");
+    renamed.project = QStringLiteral("updated");
+    QVERIFY(libraryAll.upsertNote(renamed));
+    QCOMPARE(libraryAll.notes().size(), 3);
+    QCOMPARE(libraryAll.notes().at(1).project, QStringLiteral("updated"));
+    renamed.noteId = QStringLiteral("note-1");
+    QVERIFY(libraryAll.upsertNote(renamed));
+    QCOMPARE(libraryAll.notes().constLast().noteId, QStringLiteral("note-1"));
+    QVERIFY(libraryAll.noteById(QStringLiteral("note-1"), &resolved));
+
+    constexpr int kIdentifierCount = 100000;
+    QStringList identifiers;
+    identifiers.reserve(kIdentifierCount);
+    for (int index = 0; index < kIdentifierCount; ++index)
+    {
+        identifiers.push_back(QStringLiteral("3f9c2d7e-%1-4b8a-9d21-5a0e6c1f%1").arg(index, 8, 10, QLatin1Char('0')));
+    }
+
+    WhatSonHubSymbolTable bulkSymbols;
+    bulkSymbols.reserve(Kind::NoteId, kIdentifierCount);
+    QVector<int> symbolIds;
+    symbolIds.reserve(kIdentifierCount);
+    for (const QString& identifier : std::as_const(identifiers))
+    {
+        symbolIds.push_back(bulkSymbols.internNormalized(Kind::NoteId, identifier));
+    }
+    QCOMPARE(bulkSymbols.count(Kind::NoteId), kIdentifierCount);
+    QCOMPARE(symbolIds.constLast(), kIdentifierCount - 1);
+
+    // Re-interning resolves to the existing ids instead of growing the table.
+    int mismatchedSymbols = 0;
+    for (int index = 0; index < kIdentifierCount; ++index)
+    {
+        const int symbol = bulkSymbols.internNormalized(Kind::NoteId, identifiers.at(index));
+        mismatchedSymbols += symbol == symbolIds.at(index) ? 0 : 1;
+    }
+    QCOMPARE(mismatchedSymbols, 0);
+    QCOMPARE(bulkSymbols.count(Kind::NoteId), kIdentifierCount);
+
+    // The table keeps the interned payload rather than a copy, and its footprint accounts for every payload once.
+    QVERIFY(bulkSymbols.text(Kind::NoteId, symbolIds.at(4242)).constData() == identifiers.at(4242).constData());
+    qint64 payloadBytes = 0;
+    for (const QString& identifier : std::as_const(identifiers))
+    {
+        payloadBytes += identifier.size() * static_cast<qint64>(sizeof(QChar));
+    }
+    QVERIFY(bulkSymbols.memoryFootprintBytes() >= payloadBytes);
+}
+
+void WhatSonCppRegressionTests::hubSymbolTable_sharesFacetSymbolsPerHub()
+{
+    using Kind = WhatSonHubSymbolTable::Kind;
+
+    QCOMPARE(WhatSonHubSymbolTable::normalize(Kind::Tag, QStringLiteral(" Draft ")), QStringLiteral("Draft"));
+    QCOMPARE(WhatSonHubSymbolTable::normalize(Kind::Project, QStringLiteral(" Roadmap ")),
+             QStringLiteral("roadmap"));
+    QCOMPARE(WhatSonHubSymbolTable::normalize(Kind::FolderPath, QStringLiteral("Research/Papers/")),
+             QStringLiteral("research/papers"));
+
+    const QString hubPath = QStringLiteral("/tmp/SharedSymbols.wshub");
+    const std::shared_ptr<WhatSonHubSymbolTable> hubSymbols = WhatSonHubSymbolTable::forHub(hubPath);
+    QVERIFY(hubSymbols != nullptr);
+    QCOMPARE(WhatSonHubSymbolTable::forHub(hubPath).get(), hubSymbols.get());
+    QVERIFY(WhatSonHubSymbolTable::forHub(QString()).get() != WhatSonHubSymbolTable::forHub(QString()).get());
+    QVERIFY(WhatSonHubSymbolTable::forHub(QStringLiteral("/tmp/OtherSymbols.wshub")).get() != hubSymbols.get());
+
+    QVector<LibraryNoteRecord> notes;
+    for (int index = 0; index < 4; ++index)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("facet-note-%1").arg(index);
+        note.project = index % 2 == 0 ? QStringLiteral("Roadmap") : QStringLiteral("Archive");
+        note.tags = {QStringLiteral("shared"), QStringLiteral("tag-%1").arg(index)};
+        note.folders = {QStringLiteral("Research/Papers")};
+        notes.push_back(note);
+    }
+
+    LibraryAll libraryAll;
+    libraryAll.setIndexedNotes(hubPath, notes);
+    LibraryAll projectsLibrary;
+    projectsLibrary.setIndexedNotes(hubPath, notes);
+    QCOMPARE(libraryAll.sharedSymbols().get(), hubSymbols.get());
+    QCOMPARE(projectsLibrary.sharedSymbols().get(), hubSymbols.get());
+    QCOMPARE(hubSymbols->count(Kind::NoteId), 4);
+    QCOMPARE(hubSymbols->count(Kind::Tag), 5);
+    QCOMPARE(hubSymbols->count(Kind::Project), 2);
+    QCOMPARE(hubSymbols->count(Kind::FolderPath), 1);
+
+    QCOMPARE(libraryAll.noteRowsForFacet(Kind::Project, QStringLiteral(" roadmap ")), QVector<int>({0, 2}));
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::Tag, QStringLiteral("shared")), 4);
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::Tag, QStringLiteral("Shared")), 0);
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::FolderPath, QStringLiteral("research/papers")), 4);
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::NoteId, QStringLiteral("facet-note-0")), 0);
+    QCOMPARE(libraryAll.facetSymbolsForRow(Kind::Project, 1),
+             QVector<int>({hubSymbols->find(Kind::Project, QStringLiteral("Archive"))}));
+    QVERIFY(libraryAll.facetSymbolsForRow(Kind::Project, 9).isEmpty());
+
+    // Upserts and removals move only the postings of the values a note gained or lost.
+    LibraryNoteRecord moved = notes.at(1);
+    moved.project = QStringLiteral("ROADMAP");
+    moved.tags = {QStringLiteral("tag-1")};
+    QVERIFY(libraryAll.upsertNote(moved));
+    QCOMPARE(libraryAll.noteRowsForFacet(Kind::Project, QStringLiteral("Roadmap")), QVector<int>({0, 1, 2}));
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::Project, QStringLiteral("Archive")), 1);
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::Tag, QStringLiteral("shared")), 3);
+
+    QVERIFY(libraryAll.removeNoteById(QStringLiteral("facet-note-0")));
+    QCOMPARE(libraryAll.noteRowsForFacet(Kind::Project, QStringLiteral("Roadmap")), QVector<int>({0, 1}));
+    QCOMPARE(libraryAll.noteRowsForFacet(Kind::Tag, QStringLiteral("tag-3")), QVector<int>({2}));
+    QCOMPARE(libraryAll.noteCountForFacet(Kind::FolderPath, QStringLiteral("Research/Papers")), 3);
+
+    LibraryNoteRecord added;
+    added.noteId = QStringLiteral("facet-note-4");
+    added.project = QStringLiteral("Launch");
+    QVERIFY(libraryAll.upsertNote(added));
+    QCOMPARE(libraryAll.noteRowsForFacet(Kind::Project, QStringLiteral("launch")), QVector<int>({3}));
+
+    // The other owner of the hub sees the new value's symbol but keeps its own postings.
+    QVERIFY(hubSymbols->find(Kind::Project, QStringLiteral("Launch")) != WhatSonHubSymbolTable::kNoSymbol);
+    QCOMPARE(projectsLibrary.noteCountForFacet(Kind::Project, QStringLiteral("Launch")), 0);
+    QCOMPARE(projectsLibrary.noteCountForFacet(Kind::Project, QStringLiteral("Roadmap")), 2);
+}
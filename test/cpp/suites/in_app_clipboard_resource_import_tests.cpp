@@ -1,10 +1,12 @@
 #include "test/cpp/whatson_cpp_regression_tests.hpp"
 
 #include "app/models/clipboard/InAppClipboardManager.h"
+#include "app/models/clipboard/ResourceImportStream.h"
 #include "app/models/hierarchy/resources/WhatSonResourcePackageSupport.hpp"
 
 #include <QBuffer>
 #include <QClipboard>
+#include <QCryptographicHash>
 #include <QMimeData>
 
 #include <algorithm>
@@ -66,6 +68,16 @@ namespace
         return result;
     }
 
+    bool waitForInAppClipboardImport(const InAppClipboardManager& clipboard)
+    {
+        return QTest::qWaitFor(
+            [&clipboard]()
+            {
+                return !clipboard.busy();
+            },
+            10000);
+    }
+
     WhatSon::Resources::ResourcePackageMetadata singleImportedResourceMetadataForHub(const QString& hubPath)
     {
         const QVector<WhatSon::Resources::ResourcePackageMetadata> metadata = importedResourceMetadataForHub(hubPath);
@@ -116,6 +128,8 @@ void WhatSonCppRegressionTests::inAppClipboard_importsUrlsAsResourcePackagesWith
     QVERIFY2(
         clipboard.importUrls(QVariantList{QUrl::fromLocalFile(capturedImagePath)}),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
 
     const QString resourceId = QStringLiteral("clipboard-resource");
     const QString resourcePath = QStringLiteral(".wsresources/clipboard-resource.wsresource");
@@ -176,6 +190,8 @@ void WhatSonCppRegressionTests::inAppClipboard_importsClipboardImageThroughManag
     QVERIFY2(
         clipboard.importClipboardResource(InAppClipboardManager::ConflictPolicyAbort),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
 
     const WhatSon::Resources::ResourcePackageMetadata importedResource = singleImportedResourceMetadataForHub(hubPath);
     QCOMPARE(importedResource.type, QStringLiteral("image"));
@@ -214,6 +230,8 @@ void WhatSonCppRegressionTests::inAppClipboard_importsClipboardImagesWithRandomA
     QVERIFY2(
         clipboard.importClipboardResource(InAppClipboardManager::ConflictPolicyAbort),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
     const QVector<WhatSon::Resources::ResourcePackageMetadata> firstMetadata =
         importedResourceMetadataForHub(hubPath);
     QCOMPARE(firstMetadata.size(), 1);
@@ -224,6 +242,8 @@ void WhatSonCppRegressionTests::inAppClipboard_importsClipboardImagesWithRandomA
     QVERIFY2(
         clipboard.importClipboardResource(InAppClipboardManager::ConflictPolicyAbort),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
     const QVector<WhatSon::Resources::ResourcePackageMetadata> allMetadata =
         importedResourceMetadataForHub(hubPath);
     QCOMPARE(allMetadata.size(), 2);
@@ -284,6 +304,8 @@ void WhatSonCppRegressionTests::inAppClipboard_randomizesClipboardResourceNameBe
     QVERIFY2(
         clipboard.importUrls(QVariantList{QUrl::fromLocalFile(existingClipboardNamedPath)}),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
     const QString existingResourcePath = QStringLiteral(".wsresources/clipboard-resource.wsresource");
     QVERIFY(resourcesFileTextForHub(hubPath).contains(existingResourcePath));
 
@@ -294,6 +316,8 @@ void WhatSonCppRegressionTests::inAppClipboard_randomizesClipboardResourceNameBe
     QVERIFY2(
         clipboard.importClipboardResource(InAppClipboardManager::ConflictPolicyAbort),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
 
     const QVector<WhatSon::Resources::ResourcePackageMetadata> metadata = importedResourceMetadataForHub(hubPath);
     QCOMPARE(metadata.size(), 2);
@@ -346,6 +370,8 @@ void WhatSonCppRegressionTests::inAppClipboard_importsNonImageClipboardPayloadTh
     QVERIFY2(
         clipboard.importClipboardResource(InAppClipboardManager::ConflictPolicyAbort),
         qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
 
     const WhatSon::Resources::ResourcePackageMetadata importedResource = singleImportedResourceMetadataForHub(hubPath);
     QCOMPARE(importedResource.type, QStringLiteral("document"));
@@ -386,3 +412,144 @@ void WhatSonCppRegressionTests::inAppClipboard_refreshReplacesStaleSnapshotWithS
     QCOMPARE(clipboard.resourceFormat(), QStringLiteral(".png"));
     QVERIFY(clipboard.resourceEntry().value(QStringLiteral("hasImage")).toBool());
 }
+
+void WhatSonCppRegressionTests::inAppClipboard_streamsLargeImportsWithProgressAndVerifiedHash()
+{
+    QTemporaryDir workspaceDirectory;
+    QVERIFY(workspaceDirectory.isValid());
+
+    QString createError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDirectory.path(),
+        QStringLiteral("StreamHub.wshub"),
+        &createError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(createError));
+
+    // Three and a half chunks, so the copy crosses several chunk boundaries and ends on a partial one.
+    QByteArray sourceBytes;
+    sourceBytes.reserve(static_cast<qsizetype>(WhatSon::Clipboard::kStreamChunkBytes * 7 / 2));
+    while (sourceBytes.size() < WhatSon::Clipboard::kStreamChunkBytes * 7 / 2)
+    {
+        sourceBytes.append(static_cast<char>(sourceBytes.size() * 31 % 251));
+    }
+    const QString sourceFilePath = QDir(workspaceDirectory.path()).filePath(QStringLiteral("field-recording.bin"));
+    {
+        QFile sourceFile(sourceFilePath);
+        QVERIFY(sourceFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(sourceFile.write(sourceBytes), static_cast<qint64>(sourceBytes.size()));
+    }
+    const QString expectedSha256 =
+        QString::fromLatin1(QCryptographicHash::hash(sourceBytes, QCryptographicHash::Sha256).toHex());
+
+    QByteArray streamedSha256;
+    {
+        const QString copiedFilePath = QDir(workspaceDirectory.path()).filePath(QStringLiteral("copied.bin"));
+        QVector<qint64> progressSteps;
+        WhatSon::Clipboard::StreamedFile streamed;
+        QString streamError;
+        QVERIFY2(
+            WhatSon::Clipboard::streamFileToFile(
+                sourceFilePath,
+                copiedFilePath,
+                [&progressSteps, &sourceBytes](const qint64 bytesDone, const qint64 bytesTotal)
+                {
+                    QCOMPARE(bytesTotal, static_cast<qint64>(sourceBytes.size()));
+                    progressSteps.push_back(bytesDone);
+                },
+                &streamed,
+                &streamError),
+            qPrintable(streamError));
+        QCOMPARE(progressSteps.size(), 4);
+        QVERIFY(std::is_sorted(progressSteps.cbegin(), progressSteps.cend()));
+        QCOMPARE(progressSteps.constLast(), static_cast<qint64>(sourceBytes.size()));
+        QCOMPARE(streamed.byteCount, static_cast<qint64>(sourceBytes.size()));
+        streamedSha256 = streamed.sha256Hex;
+        QCOMPARE(QString::fromLatin1(streamedSha256), expectedSha256);
+        QCOMPARE(WhatSon::Clipboard::fileSha256Hex(copiedFilePath), streamedSha256);
+    }
+
+    InAppClipboardManager clipboard;
+    clipboard.setCurrentHubPath(hubPath);
+    QSignalSpy fileProgressSpy(&clipboard, &InAppClipboardManager::importFileProgress);
+    QVERIFY2(
+        clipboard.importUrls(QVariantList{QUrl::fromLocalFile(sourceFilePath)}),
+        qPrintable(clipboard.lastError()));
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
+
+    QCOMPARE(fileProgressSpy.count(), 4);
+    qint64 previousBytesDone = 0;
+    for (const QList<QVariant>& arguments : std::as_const(fileProgressSpy))
+    {
+        QCOMPARE(arguments.at(0).toInt(), 0);
+        QCOMPARE(arguments.at(1).toInt(), 1);
+        QCOMPARE(arguments.at(2).toString(), QStringLiteral("field-recording.bin"));
+        QVERIFY(arguments.at(3).toLongLong() > previousBytesDone);
+        previousBytesDone = arguments.at(3).toLongLong();
+    }
+    QCOMPARE(previousBytesDone, static_cast<qint64>(sourceBytes.size()));
+    QCOMPARE(clipboard.importProgress(), 1.0);
+
+    const WhatSon::Resources::ResourcePackageMetadata metadata = singleImportedResourceMetadataForHub(hubPath);
+    QVERIFY(!metadata.resourcePath.isEmpty());
+    const QString importedAssetPath =
+        QDir(QDir(hubPath).filePath(metadata.resourcePath)).filePath(metadata.assetPath);
+    QCOMPARE(QFileInfo(importedAssetPath).size(), static_cast<qint64>(sourceBytes.size()));
+    QCOMPARE(WhatSon::Clipboard::fileSha256Hex(importedAssetPath), streamedSha256);
+
+    const QStringList leftoverStagingDirectories = QDir(resourcesDirectoryPathForHub(hubPath)).entryList(
+        QStringList{QStringLiteral(".import-staging-*")},
+        QDir::Dirs | QDir::Hidden | QDir::NoDotAndDotDot);
+    QVERIFY2(leftoverStagingDirectories.isEmpty(), qPrintable(leftoverStagingDirectories.join(QStringLiteral(", "))));
+}
+
+void WhatSonCppRegressionTests::inAppClipboard_importsOnWorkerAndSweepsStaleStagingAtMount()
+{
+    QTemporaryDir workspaceDirectory;
+    QVERIFY(workspaceDirectory.isValid());
+
+    QString createError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDirectory.path(),
+        QStringLiteral("AsyncImportHub.wshub"),
+        &createError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(createError));
+
+    const QString staleStagingPath =
+        QDir(resourcesDirectoryPathForHub(hubPath)).filePath(QStringLiteral(".import-staging-interrupted"));
+    QVERIFY(QDir().mkpath(staleStagingPath));
+    {
+        QFile partialAsset(QDir(staleStagingPath).filePath(QStringLiteral("partial.bin")));
+        QVERIFY(partialAsset.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QVERIFY(partialAsset.write(QByteArrayLiteral("partial")) > 0);
+    }
+
+    const QString sourceFilePath = QDir(workspaceDirectory.path()).filePath(QStringLiteral("meeting-notes.txt"));
+    {
+        QFile sourceFile(sourceFilePath);
+        QVERIFY(sourceFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QVERIFY(sourceFile.write(QByteArrayLiteral("agenda")) > 0);
+    }
+
+    InAppClipboardManager clipboard;
+    QSignalSpy busySpy(&clipboard, &InAppClipboardManager::busyChanged);
+    QSignalSpy importCompletedSpy(&clipboard, &InAppClipboardManager::importCompleted);
+    clipboard.setCurrentHubPath(hubPath);
+
+    QVERIFY2(
+        clipboard.importUrls(QVariantList{QUrl::fromLocalFile(sourceFilePath)}),
+        qPrintable(clipboard.lastError()));
+    QVERIFY(clipboard.busy());
+    QCOMPARE(importCompletedSpy.count(), 0);
+    QVERIFY(!clipboard.importUrls(QVariantList{QUrl::fromLocalFile(sourceFilePath)}));
+    QCOMPARE(clipboard.lastError(), QStringLiteral("Resource import is already running."));
+
+    QVERIFY(waitForInAppClipboardImport(clipboard));
+    QVERIFY2(clipboard.lastError().isEmpty(), qPrintable(clipboard.lastError()));
+    QCOMPARE(importCompletedSpy.count(), 1);
+    QCOMPARE(busySpy.count(), 2);
+    QCOMPARE(clipboard.lastImportedEntries().size(), 1);
+    QVERIFY(!QFileInfo::exists(staleStagingPath));
+    QVERIFY(resourcesFileTextForHub(hubPath).contains(
+        clipboard.lastImportedEntries().constFirst().toMap().value(QStringLiteral("resourcePath")).toString()));
+}
@@ -682,7 +682,7 @@ void WhatSonCppRegressionTests::sourceTree_keepsHierarchyBackendDecomposed()
     QVERIFY(libraryControllerHeader.contains(QStringLiteral("WhatSonLibraryNoteListProjection")));
     QVERIFY(!libraryControllerHeader.contains(QStringLiteral("m_noteListItemCache")));
     QVERIFY(!libraryControllerSource.contains(QStringLiteral("LibraryHierarchyController::buildNoteListItem(")));
-    QVERIFY(projectionSource.contains(QStringLiteral("WhatSonLibraryNoteListProjection::buildNoteListItem")));
+    QVERIFY(projectionSource.contains(QStringLiteral("WhatSonLibraryNoteListProjection::buildNoteListRows")));
     QVERIFY(libraryControllerSource.contains(QStringLiteral("WhatSonHierarchyNoteRecordSupport.hpp")));
     QVERIFY(!libraryControllerSource.contains(QStringLiteral("NoteRecordSupport::applyPersistedBodyState")));
     QVERIFY(!libraryControllerHeader.contains(QStringLiteral("saveBodyTextForNote")));
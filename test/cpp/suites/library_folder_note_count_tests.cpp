@@ -0,0 +1,108 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/hierarchy/library/WhatSonLibraryNoteListProjection.hpp"
+
+namespace
+{
+    QString folderCountFixtureUuid(const int folderIndex)
+    {
+        return QStringLiteral("F%1").arg(folderIndex, 63, 10, QLatin1Char('0'));
+    }
+
+    LibraryNoteRecord folderCountFixtureNote(const int noteIndex, const int folderIndex)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("note-%1").arg(noteIndex);
+        note.folderUuids.push_back(folderCountFixtureUuid(folderIndex));
+        return note;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::libraryNoteListProjection_maintainsFolderCountsIncrementally()
+{
+    constexpr int kTopLevelFolderCount = 2000;
+    constexpr int kChildrenPerFolder = 9;
+    constexpr int kNoteCount = 100000;
+
+    // 2,000 top-level folders with nine children each: 20,000 folders, rows in flattened depth order.
+    QVector<LibraryHierarchyItem> items;
+    QVector<int> folderIndexByRow;
+    items.reserve(kTopLevelFolderCount * (kChildrenPerFolder + 1));
+    for (int topIndex = 0; topIndex < kTopLevelFolderCount; ++topIndex)
+    {
+        const int parentFolderIndex = topIndex * (kChildrenPerFolder + 1);
+        LibraryHierarchyItem parent;
+        parent.label = QStringLiteral("top-%1").arg(topIndex);
+        parent.folderPath = parent.label;
+        parent.folderUuid = folderCountFixtureUuid(parentFolderIndex);
+        items.push_back(parent);
+        folderIndexByRow.push_back(parentFolderIndex);
+        for (int childIndex = 1; childIndex <= kChildrenPerFolder; ++childIndex)
+        {
+            LibraryHierarchyItem child;
+            child.depth = 1;
+            child.label = QStringLiteral("child-%1").arg(childIndex);
+            child.folderPath = parent.folderPath + QLatin1Char('/') + child.label;
+            child.folderUuid = folderCountFixtureUuid(parentFolderIndex + childIndex);
+            items.push_back(child);
+            folderIndexByRow.push_back(parentFolderIndex + childIndex);
+        }
+    }
+    QCOMPARE(items.size(), 20000);
+
+    QVector<LibraryNoteRecord> notes;
+    notes.reserve(kNoteCount);
+    for (int noteIndex = 0; noteIndex < kNoteCount; ++noteIndex)
+    {
+        notes.push_back(folderCountFixtureNote(noteIndex, folderIndexByRow.at(noteIndex % items.size())));
+    }
+
+    WhatSonLibraryNoteListProjection projection;
+    QVERIFY(!projection.hasFolderNoteCounts());
+
+    const QHash<QString, int> fullRecount = projection.folderNoteCountByFolderUuid(items, notes, true);
+    projection.ensureFolderNoteCounts(items, notes, true);
+    QVERIFY(projection.hasFolderNoteCounts());
+
+    const QString parentUuid = folderCountFixtureUuid(0);
+    const QString firstChildUuid = folderCountFixtureUuid(1);
+    const QString otherChildUuid = folderCountFixtureUuid(12);
+    QCOMPARE(projection.folderNoteCount(parentUuid, false), fullRecount.value(parentUuid));
+    QCOMPARE(projection.folderNoteCount(parentUuid, false), 5);
+    QCOMPARE(projection.folderNoteCount(parentUuid, true), 50);
+    QCOMPARE(projection.folderNoteCount(firstChildUuid, true), 5);
+
+    QVector<int> changedRows;
+    constexpr int kIncrementalUpdateCount = 1000;
+    for (int updateIndex = 0; updateIndex < kIncrementalUpdateCount; ++updateIndex)
+    {
+        QVERIFY(projection.upsertFolderNoteCountsForNote(folderCountFixtureNote(updateIndex * 20, 12), &changedRows));
+        // A move touches at most the old and new leaf rows and their parents, never the whole tree.
+        QVERIFY(changedRows.size() <= 4);
+    }
+
+    // Re-targeting an already moved note touches both leaf rows and both of their parents.
+    QVERIFY(projection.upsertFolderNoteCountsForNote(folderCountFixtureNote(20, 1), &changedRows));
+    QCOMPARE(changedRows, QVector<int>({0, 1, 10, 12}));
+
+    for (int updateIndex = 0; updateIndex < kIncrementalUpdateCount; ++updateIndex)
+    {
+        notes[updateIndex * 20] = folderCountFixtureNote(updateIndex * 20, updateIndex == 1 ? 1 : 12);
+    }
+    const QHash<QString, int> expectedCounts = projection.folderNoteCountByFolderUuid(items, notes, true);
+    for (auto countIt = expectedCounts.cbegin(); countIt != expectedCounts.cend(); ++countIt)
+    {
+        QCOMPARE(projection.folderNoteCount(countIt.key(), false), countIt.value());
+    }
+    QCOMPARE(projection.folderNoteCount(otherChildUuid, false), 5 + kIncrementalUpdateCount - 1);
+    QCOMPARE(projection.folderNoteCount(folderCountFixtureUuid(10), true), 50 + kIncrementalUpdateCount - 1);
+
+    QVERIFY(projection.removeFolderNoteCountsForNote(QStringLiteral("note-20"), &changedRows));
+    QCOMPARE(changedRows, QVector<int>({0, 1}));
+    QVERIFY(projection.removeFolderNoteCountsForNote(QStringLiteral("missing-note"), &changedRows));
+    QVERIFY(changedRows.isEmpty());
+
+    projection.invalidate();
+    QVERIFY(!projection.hasFolderNoteCounts());
+    QVERIFY(!projection.upsertFolderNoteCountsForNote(folderCountFixtureNote(0, 1), &changedRows));
+}
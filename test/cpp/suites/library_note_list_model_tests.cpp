@@ -1,6 +1,7 @@
 #include "test/cpp/whatson_cpp_regression_tests.hpp"
 
 #include "app/models/hierarchy/library/LibraryNotePreviewText.hpp"
+#include "app/models/hierarchy/library/WhatSonLibraryNoteListProjection.hpp"
 
 namespace
 {
@@ -19,6 +20,22 @@ namespace
         item.lastModifiedAt = QStringLiteral("2026-04-23-09-00-00");
         return item;
     }
+
+    // Later indices are modified later, so the newest-first list starts at the last note.
+    LibraryNoteRecord makeLazyListNote(const int index)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        note.noteDirectoryPath = QStringLiteral("/hubs/Lazy.wshub/.wscontents/Library.wslibrary/%1.wsnote").arg(note.noteId);
+        note.createdAt = QStringLiteral("2026-01-01-00-00-00");
+        note.lastModifiedAt = QStringLiteral("2026-%1-%2-%3-%4-00")
+                                  .arg(index / 40320 + 1, 2, 10, QLatin1Char('0'))
+                                  .arg(index / 1440 % 28 + 1, 2, 10, QLatin1Char('0'))
+                                  .arg(index / 60 % 24, 2, 10, QLatin1Char('0'))
+                                  .arg(index % 60, 2, 10, QLatin1Char('0'));
+        note.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50)};
+        return note;
+    }
 }
 
 void WhatSonCppRegressionTests::libraryNoteListModel_emitsCurrentNoteEntryChangedWhenInitialSelectionMaterializes()
@@ -125,3 +142,67 @@ void WhatSonCppRegressionTests::libraryNoteListModel_hidesRawInlineTagsFromPrevi
     QCOMPARE(model.data(rowIndex, LibraryNoteListModel::BodyTextRole).toString(), QString());
     QVERIFY(!model.data(rowIndex, LibraryNoteListModel::PrimaryTextRole).toString().contains(QStringLiteral("<")));
 }
+
+void WhatSonCppRegressionTests::libraryNoteListModel_materializesOnlyRequestedRowsFromRowSource()
+{
+    ensureCoreApplication();
+
+    constexpr int kNoteCount = 100000;
+    constexpr int kViewportRows = 40;
+    QVector<LibraryNoteRecord> notes;
+    notes.reserve(kNoteCount);
+    for (int index = 0; index < kNoteCount; ++index)
+    {
+        notes.push_back(makeLazyListNote(index));
+    }
+
+    WhatSonLibraryNoteListProjection projection;
+    LibraryNoteListModel model;
+    model.setRowSource(projection.buildNoteListRows({}, notes, false));
+    for (int row = 0; row < kViewportRows; ++row)
+    {
+        QVERIFY(!model.data(model.index(row, 0), LibraryNoteListModel::DisplayDateRole).toString().isEmpty());
+    }
+
+    QCOMPARE(model.itemCount(), kNoteCount);
+    QCOMPARE(model.currentNoteId(), QStringLiteral("note-099999"));
+    QCOMPARE(model.data(model.index(kViewportRows - 1, 0), LibraryNoteListModel::NoteIdRole).toString(),
+             QStringLiteral("note-%1").arg(kNoteCount - kViewportRows, 6, 10, QLatin1Char('0')));
+    QCOMPARE(model.materializedRowCount(), kViewportRows);
+
+    // Lookups by id read the row references only.
+    QCOMPARE(model.indexOfNoteId(QStringLiteral("note-000000")), kNoteCount - 1);
+    QCOMPARE(model.materializedRowCount(), kViewportRows);
+
+    // The formatted-row cache is a bounded LRU: scrolling past it evicts the oldest rows only.
+    for (int row = 0; row < LibraryNoteListModel::kMaterializedRowCacheSize + kViewportRows; ++row)
+    {
+        model.data(model.index(row, 0), LibraryNoteListModel::PrimaryTextRole);
+    }
+    const int materializedAfterScroll = model.materializedRowCount();
+    QCOMPARE(materializedAfterScroll, LibraryNoteListModel::kMaterializedRowCacheSize + kViewportRows);
+    model.data(model.index(LibraryNoteListModel::kMaterializedRowCacheSize + kViewportRows - 1, 0),
+               LibraryNoteListModel::PrimaryTextRole);
+    QCOMPARE(model.materializedRowCount(), materializedAfterScroll);
+    model.data(model.index(1, 0), LibraryNoteListModel::PrimaryTextRole);
+    QCOMPARE(model.materializedRowCount(), materializedAfterScroll + 1);
+
+    // Refreshing the same notes keeps the rows and their delegates: the contents change, the layout does not.
+    QSignalSpy modelResetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    model.setRowSource(projection.buildNoteListRows({}, notes, false));
+    QCOMPARE(modelResetSpy.count(), 0);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(model.materializedRowCount(), 1);
+    QCOMPARE(model.currentNoteId(), QStringLiteral("note-099999"));
+
+    model.setSearchText(QStringLiteral("TAG-7"));
+    QCOMPARE(model.itemCount(), kNoteCount / 50);
+    QCOMPARE(modelResetSpy.count(), 1);
+    QCOMPARE(model.currentNoteId(), QStringLiteral("note-099957"));
+    QVERIFY(model.materializedRowCount() <= 2);
+
+    model.setItems({});
+    QCOMPARE(model.itemCount(), 0);
+    QCOMPARE(model.currentIndex(), -1);
+}
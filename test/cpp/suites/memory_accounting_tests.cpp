@@ -0,0 +1,181 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/WhatSonMemoryAccounting.hpp"
+#include "app/models/hierarchy/WhatSonHierarchyModel.hpp"
+#include "app/models/hierarchy/library/LibraryAll.hpp"
+
+#include <memory>
+
+namespace
+{
+    // Budgets for the synthetic hub below. A regression that copies note payloads instead of sharing them, or grows
+    // LibraryNoteRecord, fails here before it reaches a real hub.
+    constexpr int kSyntheticNoteCount = 100000;
+    constexpr qint64 kLibraryBudgetBytesPerNote = 2048;
+    constexpr qint64 kDerivedCopyBudgetBytesPerNote = static_cast<qint64>(sizeof(LibraryNoteRecord)) + 8;
+
+    LibraryNoteRecord syntheticNote(const int index)
+    {
+        const QString stem = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        const QString noteDirectoryPath =
+            QStringLiteral("/hubs/Synthetic.wshub/.wscontents/Library.wslibrary/%1.wsnote").arg(stem);
+
+        LibraryNoteRecord note;
+        note.noteId = stem;
+        note.storageKind = QStringLiteral("note");
+        note.createdAt = QStringLiteral("2026-01-%1-09-30-00").arg(index % 28 + 1, 2, 10, QLatin1Char('0'));
+        note.lastModifiedAt = QStringLiteral("2026-02-%1-18-45-00").arg(index % 28 + 1, 2, 10, QLatin1Char('0'));
+        note.author = QStringLiteral("author-%1").arg(index % 7);
+        note.modifiedBy = note.author;
+        note.project = QStringLiteral("project-%1").arg(index % 40);
+        note.folders = QStringList{QStringLiteral("Research/Papers-%1").arg(index % 100)};
+        note.folderUuids = QStringList{QStringLiteral("0f3c2d7e-4b8a-9d21-5a0e-%1").arg(index % 100, 12, 10, QLatin1Char('0'))};
+        note.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50), QStringLiteral("tag-%1").arg(index % 13)};
+        note.progress = index % 4;
+        note.bookmarked = index % 10 == 0;
+        if (note.bookmarked)
+        {
+            note.bookmarkColors = QStringList{QStringLiteral("red")};
+        }
+        note.noteDirectoryPath = noteDirectoryPath;
+        note.noteHeaderPath = noteDirectoryPath + QStringLiteral("/") + stem + QStringLiteral(".wsnhead");
+        return note;
+    }
+
+    const WhatSonMemoryAccounting::Sample* findSample(
+        const QVector<WhatSonMemoryAccounting::Sample>& samples,
+        const QString& domain,
+        const QString& structure)
+    {
+        for (const WhatSonMemoryAccounting::Sample& sample : samples)
+        {
+            if (sample.domain == domain && sample.structure == structure)
+            {
+                return &sample;
+            }
+        }
+        return nullptr;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::memoryAccounting_keepsSyntheticHubWithinBudgets()
+{
+    QCOMPARE(WhatSonMemoryEstimate::stringPayloadBytes(QStringLiteral("literal")), 0);
+    const QString heapText = QString::fromLatin1("0123456789");
+    QVERIFY(WhatSonMemoryEstimate::stringPayloadBytes(heapText) >= 2 * (heapText.size() + 1));
+
+    {
+        // Handles copied from one another share a payload; it is counted once and then reported as shared.
+        WhatSonMemoryEstimate estimate;
+        const QStringList first{heapText, QString::fromLatin1("abcdef")};
+        const QStringList second = first;
+        estimate.addStringList(first);
+        const qint64 firstBytes = estimate.bytes();
+        estimate.beginStructure();
+        estimate.addStringList(second);
+        QCOMPARE(estimate.bytes(), static_cast<qint64>(sizeof(QStringList)));
+        QCOMPARE(estimate.sharedBytes() + estimate.bytes(), firstBytes);
+    }
+
+    QVector<LibraryNoteRecord> notes;
+    notes.reserve(kSyntheticNoteCount);
+    for (int index = 0; index < kSyntheticNoteCount; ++index)
+    {
+        notes.push_back(syntheticNote(index));
+    }
+
+    LibraryAll libraryAll;
+    libraryAll.setIndexedNotes(QStringLiteral("/hubs/Synthetic.wshub"), notes);
+    notes.clear();
+
+    // Derived buckets and controller copies hold their own vectors of records that share every string payload.
+    QVector<LibraryNoteRecord> bookmarkedNotes;
+    QVector<LibraryNoteRecord> projectNotes;
+    projectNotes.reserve(libraryAll.notes().size());
+    for (const LibraryNoteRecord& note : libraryAll.notes())
+    {
+        projectNotes.push_back(note);
+        if (note.bookmarked)
+        {
+            bookmarkedNotes.push_back(note);
+        }
+    }
+    bookmarkedNotes.squeeze();
+
+    WhatSonMemoryAccounting accounting;
+    auto libraryOwner = std::make_unique<QObject>();
+    auto controllerOwner = std::make_unique<QObject>();
+    accounting.track(libraryOwner.get(), QStringLiteral("library"), QStringLiteral("all"),
+                     [&libraryAll](WhatSonMemoryEstimate& estimate)
+                     {
+                         libraryAll.accountMemory(estimate);
+                     });
+    accounting.track(controllerOwner.get(), QStringLiteral("projects"), QStringLiteral("allNotes"),
+                     [&projectNotes](WhatSonMemoryEstimate& estimate)
+                     {
+                         estimate.addNoteRecords(projectNotes);
+                     });
+    accounting.track(controllerOwner.get(), QStringLiteral("bookmarks"), QStringLiteral("bookmarkedNotes"),
+                     [&bookmarkedNotes](WhatSonMemoryEstimate& estimate)
+                     {
+                         estimate.addNoteRecords(bookmarkedNotes);
+                     });
+    QCOMPARE(accounting.trackedCount(), 3);
+
+    const QVector<WhatSonMemoryAccounting::Sample> samples = accounting.sample();
+    QCOMPARE(samples.size(), 3);
+    const WhatSonMemoryAccounting::Sample* librarySample =
+        findSample(samples, QStringLiteral("library"), QStringLiteral("all"));
+    const WhatSonMemoryAccounting::Sample* projectsSample =
+        findSample(samples, QStringLiteral("projects"), QStringLiteral("allNotes"));
+    const WhatSonMemoryAccounting::Sample* bookmarksSample =
+        findSample(samples, QStringLiteral("bookmarks"), QStringLiteral("bookmarkedNotes"));
+    QVERIFY(librarySample != nullptr);
+    QVERIFY(projectsSample != nullptr);
+    QVERIFY(bookmarksSample != nullptr);
+    QCOMPARE(librarySample->itemCount, static_cast<qint64>(kSyntheticNoteCount));
+    QCOMPARE(projectsSample->itemCount, static_cast<qint64>(kSyntheticNoteCount));
+    QCOMPARE(bookmarksSample->itemCount, static_cast<qint64>(kSyntheticNoteCount / 10));
+
+    QVERIFY(librarySample->bytes > kSyntheticNoteCount * static_cast<qint64>(sizeof(LibraryNoteRecord)));
+    QVERIFY2(librarySample->bytes <= kSyntheticNoteCount * kLibraryBudgetBytesPerNote,
+             qPrintable(QStringLiteral("library bytes=%1").arg(librarySample->bytes)));
+    QVERIFY2(projectsSample->bytes <= kSyntheticNoteCount * kDerivedCopyBudgetBytesPerNote,
+             qPrintable(QStringLiteral("projects bytes=%1").arg(projectsSample->bytes)));
+    QVERIFY(projectsSample->sharedBytes > projectsSample->bytes);
+    QVERIFY(bookmarksSample->bytes <= (kSyntheticNoteCount / 10) * kDerivedCopyBudgetBytesPerNote);
+
+    accounting.setDomainBudget(QStringLiteral("library"), kSyntheticNoteCount * kLibraryBudgetBytesPerNote);
+    accounting.setDomainBudget(QStringLiteral("projects"), kSyntheticNoteCount * kDerivedCopyBudgetBytesPerNote);
+    QVERIFY(accounting.budgetViolations(samples).isEmpty());
+    accounting.setDomainBudget(QStringLiteral("bookmarks"), 1024);
+    const QStringList violations = accounting.budgetViolations(samples);
+    QCOMPARE(violations.size(), 1);
+    QVERIFY(violations.constFirst().startsWith(QStringLiteral("domain=bookmarks ")));
+
+    const QVariantList report = accounting.report();
+    QCOMPARE(report.size(), 3);
+    QCOMPARE(report.constFirst().toMap().value(QStringLiteral("domain")).toString(), QStringLiteral("library"));
+    QCOMPARE(report.constFirst().toMap().value(QStringLiteral("bytes")).toLongLong(), librarySample->bytes);
+    QCOMPARE(accounting.totalBytes(), librarySample->bytes + projectsSample->bytes + bookmarksSample->bytes);
+
+    controllerOwner.reset();
+    QCOMPARE(accounting.trackedCount(), 1);
+    libraryOwner.reset();
+    QCOMPARE(accounting.trackedCount(), 0);
+
+    // Hierarchy models track their rows in the shared registry for as long as they live.
+    WhatSonMemoryAccounting& sharedAccounting = WhatSonMemoryAccounting::shared();
+    const int sharedCountBefore = sharedAccounting.trackedCount();
+    {
+        WhatSonHierarchyModel model;
+        QCOMPARE(sharedAccounting.trackedCount(), sharedCountBefore + 1);
+        model.setItems(QVariantList{
+            QVariantMap{{QStringLiteral("label"), QStringLiteral("Research")}, {QStringLiteral("depth"), 0}},
+            QVariantMap{{QStringLiteral("label"), QStringLiteral("Papers")}, {QStringLiteral("depth"), 1}}
+        });
+        const QVector<WhatSonMemoryAccounting::Sample> sharedSamples = sharedAccounting.sample();
+        QVERIFY(WhatSonMemoryAccounting::domainBytes(sharedSamples, QStringLiteral("hierarchy")) > 0);
+    }
+    QCOMPARE(sharedAccounting.trackedCount(), sharedCountBefore);
+}
@@ -0,0 +1,155 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/hub/WhatSonHubRuntimeStore.hpp"
+#include "app/models/file/query/WhatSonHubQueryFilter.hpp"
+#include "app/models/file/query/WhatSonMultiHubQuery.hpp"
+
+namespace
+{
+    bool writeMultiHubNote(const QString& hubPath, const QString& noteId, const QStringList& tags)
+    {
+        WhatSonNoteHeaderStore headerStore;
+        headerStore.setNoteId(noteId);
+        headerStore.setCreatedAt(QStringLiteral("2026-04-18-00-00-00"));
+        headerStore.setLastModifiedAt(QStringLiteral("2026-04-18-00-00-00"));
+        headerStore.setTags(tags);
+
+        const QString noteDirectoryPath = QDir(hubPath).filePath(
+            QStringLiteral(".wscontents/Library.wslibrary/%1").arg(noteId));
+        const WhatSonNoteHeaderCreator headerCreator(noteDirectoryPath, QString());
+        if (!QDir().mkpath(noteDirectoryPath))
+        {
+            return false;
+        }
+
+        QFile headerFile(QDir(noteDirectoryPath).filePath(noteId + QStringLiteral(".wsnhead")));
+        QFile bodyFile(QDir(noteDirectoryPath).filePath(noteId + QStringLiteral(".wsnbody")));
+        return headerFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)
+            && headerFile.write(headerCreator.createHeaderText(headerStore).toUtf8()) >= 0
+            && bodyFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)
+            && bodyFile.write("<body></body>") >= 0;
+    }
+
+    QStringList matchedNoteKeys(const WhatSonMultiHubQuery& query, const QString& expression)
+    {
+        WhatSonHubQueryFilter filter;
+        if (!filter.parse(expression))
+        {
+            return {QStringLiteral("<parse error>")};
+        }
+        QStringList keys;
+        for (const WhatSonMultiHubQuery::NoteMatch& match : query.notes(filter))
+        {
+            keys.push_back(QStringLiteral("%1/%2").arg(QFileInfo(match.hubPath).completeBaseName(), match.note->record.noteId));
+        }
+        keys.sort();
+        return keys;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::multiHubQuery_searchesMountedHubsAndUnmountsIndependently()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString errorMessage;
+    const QString alphaHubPath = createMinimalHubFixture(workspaceDir.path(), QStringLiteral("Alpha.wshub"), &errorMessage);
+    QVERIFY2(!alphaHubPath.isEmpty(), qPrintable(errorMessage));
+    const QString betaHubPath = createMinimalHubFixture(workspaceDir.path(), QStringLiteral("Beta.wshub"), &errorMessage);
+    QVERIFY2(!betaHubPath.isEmpty(), qPrintable(errorMessage));
+
+    QVERIFY(writeMultiHubNote(alphaHubPath, QStringLiteral("alpha-1"), {QStringLiteral("shared")}));
+    QVERIFY(writeMultiHubNote(alphaHubPath, QStringLiteral("alpha-2"), {QStringLiteral("local")}));
+    QVERIFY(writeMultiHubNote(betaHubPath, QStringLiteral("beta-1"), {QStringLiteral("shared")}));
+
+    WhatSonMultiHubQuery query;
+    query.setMaxWorkerCount(2);
+    query.setCacheDirectoryPath(workspaceDir.filePath(QStringLiteral("cache")));
+
+    QStringList failedPaths;
+    const QString missingHubPath = workspaceDir.filePath(QStringLiteral("Missing.wshub"));
+    QVERIFY(!query.mountHubs({alphaHubPath, betaHubPath, alphaHubPath, missingHubPath}, &failedPaths, &errorMessage));
+    QCOMPARE(failedPaths.size(), 1);
+    QVERIFY(errorMessage.contains(QStringLiteral("Missing.wshub")));
+    QCOMPARE(query.hubPaths().size(), 2);
+    QVERIFY(query.index(alphaHubPath) != nullptr);
+    QCOMPARE(query.index(alphaHubPath)->notes().size(), 2);
+
+    QCOMPARE(
+        matchedNoteKeys(query, QStringLiteral("tag:shared")),
+        QStringList({QStringLiteral("Alpha/alpha-1"), QStringLiteral("Beta/beta-1")}));
+
+    query.unmountHub(alphaHubPath);
+    QCOMPARE(query.hubPaths().size(), 1);
+    QVERIFY(query.index(alphaHubPath) == nullptr);
+    QCOMPARE(matchedNoteKeys(query, QStringLiteral("tag:shared")), QStringList({QStringLiteral("Beta/beta-1")}));
+}
+
+void WhatSonCppRegressionTests::hubRuntimeStore_commitsPerHubSlotsWithoutStagingCopies()
+{
+    const QString storeSource = readUtf8SourceFile(
+        QStringLiteral("src/app/models/file/hub/WhatSonHubRuntimeStore.cpp"));
+
+    QVERIFY(storeSource.contains(QStringLiteral("std::shared_ptr<const HubSlot> slot = buildSlot(wshubPath, errorMessage);")));
+    QVERIFY(storeSource.contains(QStringLiteral("m_slots.insert(normalized, std::move(slot));")));
+    QVERIFY(!storeSource.contains(QStringLiteral("stagedHubStore = m_hubStore")));
+    QVERIFY(!storeSource.contains(QStringLiteral("stagedPlacementStore = m_placementStore")));
+    QVERIFY(!storeSource.contains(QStringLiteral("stagedTagsStateStore = m_tagsStateStore")));
+
+    const QString loaderSource = readUtf8SourceFile(
+        QStringLiteral("src/app/runtime/threading/WhatSonRuntimeParallelLoader.cpp"));
+    QVERIFY(loaderSource.contains(QStringLiteral("targets.hubRuntimeStore->mountFrom(hubRuntimeSnapshot.store);")));
+
+    const QString mainSource = readUtf8SourceFile(QStringLiteral("src/app/main.cpp"));
+    QVERIFY(mainSource.contains(QStringLiteral("hubRuntimeStore.setMaxMountedHubCount(kMaxMountedHubCount);")));
+}
+
+void WhatSonCppRegressionTests::hubRuntimeStore_evictsIdleHubsToSummaries()
+{
+    const QString storeSource = readUtf8SourceFile(
+        QStringLiteral("src/app/models/file/hub/WhatSonHubRuntimeStore.cpp"));
+
+    QVERIFY(storeSource.contains(QStringLiteral("const std::shared_ptr<const HubSlot> evictedSlot = m_slots.take(evictedPath);")));
+    QVERIFY(storeSource.contains(QStringLiteral("m_evictedSummaries.insert(evictedPath, HubSummary{evictedPath, evictedSlot->hub.stat()});")));
+    QVERIFY(storeSource.contains(QStringLiteral("return summary(wshubPath).stat;")));
+    QVERIFY(storeSource.contains(QStringLiteral("m_evictedSummaries.remove(normalized);")));
+
+    const QString coordinatorSource = readUtf8SourceFile(
+        QStringLiteral("src/app/runtime/startup/WhatSonStartupRuntimeCoordinator.cpp"));
+    QVERIFY(coordinatorSource.contains(QStringLiteral("m_targets.hubRuntimeStore->markUsed(normalizedHubPath);")));
+
+    const QString daemonSource = readUtf8SourceFile(QStringLiteral("src/daemon/main.cpp"));
+    QVERIFY(daemonSource.contains(QStringLiteral("query.mountHubs(hubPaths, nullptr, &errorMessage)")));
+    QVERIFY(daemonSource.contains(QStringLiteral("parser.values(queryHubOption)")));
+}
+
+void WhatSonCppRegressionTests::hubRuntimeStore_mountsResidentHubsConcurrentlyAtStartup()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    WhatSonHubRuntimeStore store;
+    store.setMaxWorkerCount(2);
+    QStringList failedPaths;
+    QString errorMessage;
+    const QString missingHubPath = workspaceDir.filePath(QStringLiteral("Missing.wshub"));
+    QVERIFY(!store.loadManyFromWshubs({missingHubPath, QString(), missingHubPath}, &failedPaths, &errorMessage));
+    QCOMPARE(failedPaths.size(), 1);
+    QVERIFY(errorMessage.contains(QStringLiteral("Missing.wshub")));
+    QCOMPARE(store.mountedHubCount(), 0);
+
+    const QString storeSource = readUtf8SourceFile(
+        QStringLiteral("src/app/models/file/hub/WhatSonHubRuntimeStore.cpp"));
+    QVERIFY(storeSource.contains(QStringLiteral("pendingMount.slot = buildSlot(pendingMount.normalizedPath, &pendingMount.error);")));
+    QVERIFY(storeSource.contains(QStringLiteral("workerPool.waitForDone();")));
+
+    const QString coordinatorSource = readUtf8SourceFile(
+        QStringLiteral("src/app/runtime/startup/WhatSonStartupRuntimeCoordinator.cpp"));
+    QVERIFY(coordinatorSource.contains(
+        QStringLiteral("m_targets.hubRuntimeStore->loadManyFromWshubs(normalizedHubPaths, &failedHubPaths, &mountError);")));
+    QVERIFY(coordinatorSource.contains(QStringLiteral("requestedDomains.hubRuntimeStore = false;")));
+
+    const QString mainSource = readUtf8SourceFile(QStringLiteral("src/app/main.cpp"));
+    QVERIFY(mainSource.contains(QStringLiteral("startupRuntimeCoordinator.loadHubsIntoRuntime(")));
+    QVERIFY(mainSource.contains(QStringLiteral("selectedHubStore.setResidentHubPaths(hubRuntimeStore.hubPaths());")));
+}
@@ -0,0 +1,245 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/note/header/WhatSonNoteHeaderPatcher.hpp"
+
+#include <QRandomGenerator>
+#include <QRegularExpression>
+
+namespace
+{
+    QString fuzzHeaderValue(QRandomGenerator& random)
+    {
+        static const QStringList fragments{
+            QStringLiteral("plain"),
+            QStringLiteral("R&D"),
+            QStringLiteral("a<b>c"),
+            QStringLiteral("\"quoted\""),
+            QStringLiteral("it's"),
+            QStringLiteral("한글"),
+            QStringLiteral("naïve"),
+            QStringLiteral("🙂"),
+            QStringLiteral("2026-04-18")
+        };
+        QString value = fragments.at(random.bounded(fragments.size()));
+        const int extraFragments = random.bounded(3);
+        for (int index = 0; index < extraFragments; ++index)
+        {
+            value += QLatin1Char('-') + fragments.at(random.bounded(fragments.size()));
+        }
+        return value;
+    }
+
+    QStringList fuzzHeaderValues(QRandomGenerator& random, const int maximumCount)
+    {
+        QStringList values;
+        const int count = random.bounded(maximumCount + 1);
+        for (int index = 0; index < count; ++index)
+        {
+            values.push_back(fuzzHeaderValue(random) + QString::number(index));
+        }
+        return values;
+    }
+
+    void mutateFuzzHeader(QRandomGenerator& random, WhatSonNoteHeaderStore* store)
+    {
+        switch (random.bounded(12))
+        {
+        case 0:
+            store->setBookmarked(!store->isBookmarked());
+            break;
+        case 1:
+            store->incrementOpenCount();
+            break;
+        case 2:
+            store->setLastOpenedAt(fuzzHeaderValue(random));
+            break;
+        case 3:
+            store->setTags(fuzzHeaderValues(random, 6));
+            break;
+        case 4:
+            store->setProject(fuzzHeaderValue(random));
+            break;
+        case 5:
+        {
+            const QStringList folders = fuzzHeaderValues(random, 4);
+            QStringList folderUuids;
+            for (int index = 0; index < folders.size(); ++index)
+            {
+                folderUuids.push_back(random.bounded(2) == 0 ? QString() : QStringLiteral("folder-%1").arg(index));
+            }
+            store->setFolderBindings(folders, folderUuids);
+            break;
+        }
+        case 6:
+            store->setProgress(random.bounded(-1, 4));
+            break;
+        case 7:
+            store->setWordCount(random.bounded(100000));
+            break;
+        case 8:
+            store->incrementModifiedCount();
+            store->setLastModifiedAt(fuzzHeaderValue(random));
+            break;
+        case 9:
+            store->setAuthor(fuzzHeaderValue(random));
+            break;
+        case 10:
+            store->setPreset(!store->isPreset());
+            break;
+        default:
+            store->setNoteId(QStringLiteral("note-%1").arg(random.bounded(1000)));
+            break;
+        }
+    }
+
+    // Layouts the parser accepts but the creator never writes. Each must disable splicing.
+    QList<QByteArray> nonCanonicalHeaderVariants(const QByteArray& canonicalBytes)
+    {
+        QList<QByteArray> variants;
+        variants.push_back(QByteArray(canonicalBytes).replace("</author>\n", "</author>  \n"));
+        variants.push_back(QByteArray(canonicalBytes).replace("<project>", "<project >"));
+        variants.push_back(QByteArray(canonicalBytes).replace("<folders>\n", "<folders>\n\n"));
+
+        QString reordered = QString::fromUtf8(canonicalBytes);
+        reordered.replace(
+            QRegularExpression(QStringLiteral(R"(<bookmarks state="([^"]*)" colors="([^"]*)" />)")),
+            QStringLiteral(R"(<bookmarks colors="\2" state="\1" />)"));
+        variants.push_back(reordered.toUtf8());
+
+        QByteArray collapsedTags = canonicalBytes;
+        const qsizetype tagsBegin = collapsedTags.indexOf("    <tags>\n");
+        const qsizetype tagsEnd = collapsedTags.indexOf("    </tags>\n");
+        if (tagsBegin >= 0 && tagsEnd > tagsBegin)
+        {
+            QByteArray tagsSection = collapsedTags.mid(tagsBegin, tagsEnd - tagsBegin);
+            tagsSection.replace("\n      <tag>", "<tag>");
+            tagsSection.chop(1);
+            collapsedTags.replace(tagsBegin, tagsEnd - tagsBegin + 1, tagsSection);
+        }
+        variants.push_back(collapsedTags);
+
+        variants.removeAll(canonicalBytes);
+        return variants;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::noteHeaderPatcher_splicesChangedSectionsByteIdenticallyToFullRewrite()
+{
+    const WhatSonNoteHeaderCreator creator{QString(), QString()};
+    QRandomGenerator random(0x5745534e);
+    int parsedVariantCount = 0;
+
+    for (int iteration = 0; iteration < 300; ++iteration)
+    {
+        WhatSonNoteHeaderStore seed;
+        seed.setNoteId(QStringLiteral("note-%1").arg(iteration));
+        seed.setCreatedAt(fuzzHeaderValue(random));
+        seed.setAuthor(fuzzHeaderValue(random));
+        seed.setTags(fuzzHeaderValues(random, 8));
+        seed.setProject(fuzzHeaderValue(random));
+        seed.setOpenCount(random.bounded(50));
+        seed.setBookmarkColors(
+            random.bounded(2) == 0 ? QStringList() : QStringList({QStringLiteral("red"), QStringLiteral("blue")}));
+        for (int mutation = random.bounded(4); mutation > 0; --mutation)
+        {
+            mutateFuzzHeader(random, &seed);
+        }
+
+        // One parse round canonicalizes the seed; the canonical text must then be stable under parse + rewrite.
+        WhatSonNoteHeaderPatcher canonicalizer;
+        QVERIFY(canonicalizer.loadBytes(creator.createHeaderText(seed).toUtf8()));
+        const QByteArray canonicalBytes = creator.createHeaderText(canonicalizer.loadedStore()).toUtf8();
+
+        WhatSonNoteHeaderPatcher patcher;
+        QString errorMessage;
+        QVERIFY2(patcher.loadBytes(canonicalBytes, &errorMessage), qPrintable(errorMessage));
+        QVERIFY(patcher.hasSectionRanges());
+        QCOMPARE(patcher.patchedBytes(), canonicalBytes);
+
+        for (const QByteArray& variantBytes : nonCanonicalHeaderVariants(canonicalBytes))
+        {
+            WhatSonNoteHeaderPatcher variantPatcher;
+            if (!variantPatcher.loadBytes(variantBytes))
+            {
+                continue;
+            }
+            ++parsedVariantCount;
+            QVERIFY(!variantPatcher.hasSectionRanges());
+            mutateFuzzHeader(random, &variantPatcher.store());
+            QCOMPARE(variantPatcher.patchedBytes(), creator.createHeaderText(variantPatcher.store()).toUtf8());
+        }
+
+        const int mutationCount = 1 + random.bounded(3);
+        for (int mutation = 0; mutation < mutationCount; ++mutation)
+        {
+            mutateFuzzHeader(random, &patcher.store());
+        }
+
+        QVector<WhatSonNoteHeaderPatcher::Section> patchedSections;
+        const QByteArray patchedBytes = patcher.patchedBytes(&patchedSections);
+        QCOMPARE(patchedBytes, creator.createHeaderText(patcher.store()).toUtf8());
+        QVERIFY(patchedSections.size() <= mutationCount * 2);
+    }
+    QVERIFY(parsedVariantCount >= 300);
+
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+    const QString headerPath = workspaceDir.filePath(QStringLiteral("note.wsnhead"));
+
+    WhatSonNoteHeaderStore store;
+    store.setNoteId(QStringLiteral("patch-note"));
+    store.setTags({QStringLiteral("alpha"), QStringLiteral("beta")});
+    {
+        QFile headerFile(headerPath);
+        QVERIFY(headerFile.open(QIODevice::WriteOnly));
+        headerFile.write(creator.createHeaderText(store).toUtf8());
+    }
+
+    WhatSonNoteHeaderPatcher patcher;
+    QString errorMessage;
+    QVERIFY2(patcher.load(headerPath, &errorMessage), qPrintable(errorMessage));
+    patcher.store().setBookmarked(true);
+    patcher.store().incrementOpenCount();
+    QVector<WhatSonNoteHeaderPatcher::Section> patchedSections;
+    patcher.patchedBytes(&patchedSections);
+    QCOMPARE(
+        patchedSections,
+        QVector<WhatSonNoteHeaderPatcher::Section>({
+            WhatSonNoteHeaderPatcher::Section::Bookmarks,
+            WhatSonNoteHeaderPatcher::Section::OpenCount
+        }));
+    QVERIFY2(patcher.save(&errorMessage), qPrintable(errorMessage));
+    QVERIFY(!patcher.isModified());
+
+    QFile savedFile(headerPath);
+    QVERIFY(savedFile.open(QIODevice::ReadOnly));
+    QCOMPARE(savedFile.readAll(), creator.createHeaderText(patcher.store()).toUtf8());
+    savedFile.close();
+
+    // A CRLF header is not in the canonical layout, so saving falls back to a full LF rewrite.
+    QByteArray crlfBytes = creator.createHeaderText(store).toUtf8();
+    crlfBytes.replace("\n", "\r\n");
+    QVERIFY(patcher.loadBytes(crlfBytes));
+    QVERIFY(!patcher.hasSectionRanges());
+    patcher.store().setProject(QStringLiteral("Fallback"));
+    QCOMPARE(patcher.patchedBytes(), creator.createHeaderText(patcher.store()).toUtf8());
+
+    // An unmodified header is left alone whatever its layout; the first real edit rewrites it canonically.
+    {
+        QFile headerFile(headerPath);
+        QVERIFY(headerFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        headerFile.write(crlfBytes);
+    }
+    WhatSonNoteHeaderPatcher crlfPatcher;
+    QVERIFY2(crlfPatcher.load(headerPath, &errorMessage), qPrintable(errorMessage));
+    QVERIFY2(crlfPatcher.save(&errorMessage), qPrintable(errorMessage));
+    QVERIFY(savedFile.open(QIODevice::ReadOnly));
+    QCOMPARE(savedFile.readAll(), crlfBytes);
+    savedFile.close();
+    crlfPatcher.store().incrementOpenCount();
+    QVERIFY2(crlfPatcher.save(&errorMessage), qPrintable(errorMessage));
+    QVERIFY(crlfPatcher.hasSectionRanges());
+    QVERIFY(savedFile.open(QIODevice::ReadOnly));
+    QCOMPARE(savedFile.readAll(), creator.createHeaderText(crlfPatcher.store()).toUtf8());
+    savedFile.close();
+}
@@ -0,0 +1,274 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/hierarchy/bookmarks/BookmarksNoteListModel.hpp"
+#include "app/models/hierarchy/library/LibraryAll.hpp"
+#include "app/models/hierarchy/library/LibraryNoteListModel.hpp"
+#include "app/models/hierarchy/library/WhatSonLibraryNoteListProjection.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // Refreshing a bookmark selection re-hands the model items that were normalised at ingest.
+    constexpr int kSyntheticItemCount = 100000;
+    constexpr int kRefreshRounds = 4;
+
+    BookmarksNoteListItem bookmarkItem(const int index)
+    {
+        BookmarksNoteListItem item;
+        item.id = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        item.primaryText = QStringLiteral("Bookmarked note %1\r\nsecond line").arg(index);
+        item.bodyText = QStringLiteral("body %1").arg(index);
+        item.createdAt = QStringLiteral("2026-%1-01-09-00-00").arg(index % 12 + 1, 2, 10, QLatin1Char('0'));
+        item.lastModifiedAt = QStringLiteral("2026-%1-%2-10-00-00")
+                                  .arg(index % 12 + 1, 2, 10, QLatin1Char('0'))
+                                  .arg(index % 28 + 1, 2, 10, QLatin1Char('0'));
+        item.displayDate = QStringLiteral("2026-01-01");
+        item.folders = QStringList{QStringLiteral(" Research "), QStringLiteral("Research")};
+        item.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50)};
+        item.bookmarked = true;
+        item.bookmarkColor = index % 2 == 0 ? QStringLiteral("#FF0000") : QStringLiteral("#0000FF");
+        return item;
+    }
+
+    bool setItemsThrows(BookmarksNoteListModel* model, QVector<BookmarksNoteListItem> items)
+    {
+        try
+        {
+            model->setItems(std::move(items));
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    // Counts formatting calls and tags each date with its locale so a switch is visible in the output.
+    class CountingCalendarStore final : public ISystemCalendarStore
+    {
+    public:
+        QString localeTag = QStringLiteral("en");
+        mutable int formatCount = 0;
+
+        QString localeName() const override { return localeTag; }
+        QString bcp47Name() const override { return localeTag; }
+        QString languageName() const override { return localeTag; }
+        QString territoryName() const override { return {}; }
+        QString timeZoneId() const override { return QStringLiteral("UTC"); }
+        QStringList uiLanguages() const override { return {localeTag}; }
+        QString shortDateFormat() const override { return QStringLiteral("yyyy-MM-dd"); }
+        QString longDateFormat() const override { return QStringLiteral("yyyy-MM-dd"); }
+        QString shortDatePlaceholderText() const override { return shortDateFormat(); }
+        QString shortDateExample() const override { return {}; }
+        int firstDayOfWeek() const noexcept override { return 1; }
+        QVariantMap snapshot() const override { return {}; }
+        QString formatShortDate(const QString& value) const override { return formatNoteDate(value); }
+
+        QString formatNoteDate(const QString& primaryValue, const QString& fallbackValue = QString()) const override
+        {
+            ++formatCount;
+            const QString value = primaryValue.isEmpty() ? fallbackValue : primaryValue;
+            return QStringLiteral("%1:%2").arg(localeTag, value.left(10));
+        }
+
+        void refreshFromSystem() override {}
+        void requestStoreHook(const QString&) override {}
+
+        void switchLocale(const QString& tag)
+        {
+            localeTag = tag;
+            emit systemInfoChanged();
+        }
+    };
+} // namespace
+
+void WhatSonCppRegressionTests::noteListModels_trustItemsNormalisedAtIngest()
+{
+    ensureCoreApplication();
+
+    const BookmarksNoteListItem rawItem = bookmarkItem(3);
+    const BookmarksNoteListItem normalizedItem = BookmarksNoteListModel::normalizedItem(rawItem);
+    QCOMPARE(normalizedItem.primaryText, QStringLiteral("Bookmarked note 3\nsecond line"));
+    QCOMPARE(normalizedItem.folders, QStringList{QStringLiteral("Research")});
+    QVERIFY(normalizedItem.bodyText.isEmpty());
+    QVERIFY(normalizedItem.searchableText.contains(QStringLiteral("note-000003")));
+
+    // Strict validation is the exhaustive path: it rejects what a producer forgot to normalise.
+    BookmarksNoteListModel strictModel;
+    strictModel.setStrictValidation(true);
+    QSignalSpy issueSpy(&strictModel, &BookmarksNoteListModel::validationIssueRaised);
+    QVERIFY(setItemsThrows(&strictModel, {rawItem}));
+    QCOMPARE(issueSpy.count(), 1);
+    QCOMPARE(issueSpy.constFirst().constFirst().toString(), QStringLiteral("notelist.folders.sanitized"));
+    QVERIFY(!setItemsThrows(&strictModel, {normalizedItem}));
+    QCOMPARE(strictModel.itemCount(), 1);
+
+    LibraryNoteListItem libraryItem;
+    libraryItem.id = QStringLiteral(" library-note ");
+    libraryItem.noteDirectoryPath = QStringLiteral("/tmp/notes/../notes/library-note.wsnote ");
+    libraryItem.primaryText = QStringLiteral("Library note");
+    libraryItem.tags = QStringList{QStringLiteral("launch"), QString()};
+    const LibraryNoteListItem normalizedLibraryItem = LibraryNoteListModel::normalizedItem(libraryItem);
+    QCOMPARE(normalizedLibraryItem.id, QStringLiteral("library-note"));
+    QCOMPARE(normalizedLibraryItem.noteDirectoryPath, QStringLiteral("/tmp/notes/library-note.wsnote"));
+    QCOMPARE(normalizedLibraryItem.tags, QStringList{QStringLiteral("launch")});
+    LibraryNoteListModel strictLibraryModel;
+    strictLibraryModel.setStrictValidation(true);
+    bool libraryThrew = false;
+    try
+    {
+        strictLibraryModel.setItems({libraryItem});
+    }
+    catch (const std::runtime_error&)
+    {
+        libraryThrew = true;
+    }
+    QVERIFY(libraryThrew);
+    strictLibraryModel.setItems({normalizedLibraryItem});
+    QCOMPARE(strictLibraryModel.currentNoteId(), QStringLiteral("library-note"));
+
+    // Records are corrected when they enter the shared note index; clean snapshots keep sharing their payload.
+    LibraryNoteRecord paddedRecord;
+    paddedRecord.noteId = QStringLiteral(" padded ");
+    paddedRecord.lastModifiedAt = QStringLiteral("2026-05-01-09-00-00 ");
+    paddedRecord.tags = QStringList{QStringLiteral(" alpha"), QStringLiteral("alpha"), QString()};
+    LibraryAll paddedIndex;
+    paddedIndex.setIndexedNotes(QStringLiteral("/tmp/hub.wshub"), {paddedRecord});
+    QCOMPARE(paddedIndex.notes().constFirst().noteId, QStringLiteral("padded"));
+    QCOMPARE(paddedIndex.notes().constFirst().lastModifiedAt, QStringLiteral("2026-05-01-09-00-00"));
+    QCOMPARE(paddedIndex.notes().constFirst().tags, QStringList{QStringLiteral("alpha")});
+    LibraryNoteRecord cleanRecord = paddedIndex.notes().constFirst();
+    const QVector<LibraryNoteRecord> cleanSnapshot{cleanRecord};
+    LibraryAll cleanIndex;
+    cleanIndex.setIndexedNotes(QStringLiteral("/tmp/hub.wshub"), cleanSnapshot);
+    QVERIFY(cleanIndex.notes().constData() == cleanSnapshot.constData());
+    cleanRecord.tags.push_back(QStringLiteral(" beta "));
+    QVERIFY(cleanIndex.upsertNote(cleanRecord));
+    QCOMPARE(cleanIndex.notes().constFirst().tags, QStringList({QStringLiteral("alpha"), QStringLiteral("beta")}));
+    QVERIFY(!cleanIndex.upsertNote(cleanRecord));
+
+    QVector<BookmarksNoteListItem> allItems;
+    allItems.reserve(kSyntheticItemCount);
+    for (int index = 0; index < kSyntheticItemCount; ++index)
+    {
+        allItems.push_back(BookmarksNoteListModel::normalizedItem(bookmarkItem(index)));
+    }
+
+    QVector<BookmarksNoteListItem> redItems;
+    redItems.reserve(kSyntheticItemCount / 2);
+    for (const BookmarksNoteListItem& item : std::as_const(allItems))
+    {
+        if (item.bookmarkColor == QStringLiteral("#FF0000"))
+        {
+            redItems.push_back(item);
+        }
+    }
+
+    // Alternating selections so no round is skipped as unchanged.
+    BookmarksNoteListModel model;
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    for (int round = 0; round < kRefreshRounds; ++round)
+    {
+        model.setItems(round % 2 == 0 ? allItems : redItems);
+    }
+    QCOMPARE(resetSpy.count(), kRefreshRounds);
+    QCOMPARE(model.itemCount(), redItems.size());
+
+    // A refresh hands rows through without re-normalising them, so their payloads stay shared with the ingest copy.
+    const BookmarksNoteListItem& shownItem = model.items().constFirst();
+    const auto ingestedItem = std::find_if(
+        redItems.cbegin(),
+        redItems.cend(),
+        [&shownItem](const BookmarksNoteListItem& item)
+        {
+            return item.id == shownItem.id;
+        });
+    QVERIFY(ingestedItem != redItems.cend());
+    QVERIFY(shownItem.primaryText.constData() == ingestedItem->primaryText.constData());
+    QVERIFY(shownItem.bodyText.constData() == ingestedItem->bodyText.constData());
+    QVERIFY(shownItem.folders.constData() == ingestedItem->folders.constData());
+}
+
+void WhatSonCppRegressionTests::noteListModels_refreshDisplayDatesOnLocaleChange()
+{
+    ensureCoreApplication();
+
+    CountingCalendarStore store;
+    QVector<BookmarksNoteListItem> items;
+    items.reserve(kSyntheticItemCount);
+    for (int index = 0; index < kSyntheticItemCount; ++index)
+    {
+        BookmarksNoteListItem item = bookmarkItem(index);
+        item.displayDate.clear();
+        items.push_back(BookmarksNoteListModel::normalizedItem(std::move(item)));
+    }
+
+    BookmarksNoteListModel model;
+    model.setSystemCalendarStore(&store);
+    model.setItems(items);
+    QCOMPARE(store.formatCount, 0);
+
+    // Only rows a view reads are formatted; rows sharing a timestamp share the formatted string.
+    const QModelIndex firstRow = model.index(0, 0);
+    const QString firstDate = model.data(firstRow, BookmarksNoteListModel::DisplayDateRole).toString();
+    QVERIFY(firstDate.startsWith(QStringLiteral("en:2026-")));
+    QCOMPARE(model.data(firstRow, BookmarksNoteListModel::DisplayDateRole).toString(), firstDate);
+    QCOMPARE(store.formatCount, 1);
+    for (int row = 0; row < 40; ++row)
+    {
+        model.data(model.index(row, 0), BookmarksNoteListModel::DisplayDateRole);
+    }
+    QVERIFY(store.formatCount <= 40);
+    QCOMPARE(model.cachedDisplayDateCount(), store.formatCount);
+
+    // A locale switch drops the cached dates and re-announces one role; the rows themselves are untouched.
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
+    QObject::connect(&store, &ISystemCalendarStore::systemInfoChanged, &model,
+                     &BookmarksNoteListModel::refreshDisplayDates);
+    const int formatCountBeforeSwitch = store.formatCount;
+    store.switchLocale(QStringLiteral("ko"));
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.constFirst().at(1).toModelIndex().row(), model.itemCount() - 1);
+    QCOMPARE(dataChangedSpy.constFirst().at(2).value<QList<int>>(),
+             QList<int>{BookmarksNoteListModel::DisplayDateRole});
+    QCOMPARE(store.formatCount, formatCountBeforeSwitch);
+    QCOMPARE(model.cachedDisplayDateCount(), 0);
+    QVERIFY(model.data(firstRow, BookmarksNoteListModel::DisplayDateRole).toString().startsWith(QStringLiteral("ko:")));
+
+    // Producer-formatted dates are kept as given.
+    BookmarksNoteListItem preformatted = items.constFirst();
+    preformatted.displayDate = QStringLiteral("yesterday");
+    model.setItems({preformatted});
+    QCOMPARE(model.data(model.index(0, 0), BookmarksNoteListModel::DisplayDateRole).toString(),
+             QStringLiteral("yesterday"));
+
+    // Library rows materialised from the projection carry raw timestamps and format through the same cache.
+    QVector<LibraryNoteRecord> notes;
+    for (int index = 0; index < 3; ++index)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("library-%1").arg(index);
+        note.createdAt = QStringLiteral("2026-02-0%1-09-00-00").arg(index + 1);
+        note.lastModifiedAt = note.createdAt;
+        notes.push_back(note);
+    }
+    WhatSonLibraryNoteListProjection projection;
+    LibraryNoteListModel libraryModel;
+    libraryModel.setSystemCalendarStore(&store);
+    libraryModel.setRowSource(projection.buildNoteListRows({}, notes, false));
+    libraryModel.setCurrentIndex(0);
+    QCOMPARE(libraryModel.itemAt(0).displayDate, QString());
+    QCOMPARE(libraryModel.data(libraryModel.index(0, 0), LibraryNoteListModel::DisplayDateRole).toString(),
+             QStringLiteral("ko:2026-02-03"));
+    QSignalSpy entrySpy(&libraryModel, &LibraryNoteListModel::currentNoteEntryChanged);
+    QObject::connect(&store, &ISystemCalendarStore::systemInfoChanged, &libraryModel,
+                     &LibraryNoteListModel::refreshDisplayDates);
+    store.switchLocale(QStringLiteral("de"));
+    QCOMPARE(entrySpy.count(), 1);
+    QCOMPARE(libraryModel.currentNoteEntry().value(QStringLiteral("displayDate")).toString(),
+             QStringLiteral("de:2026-02-03"));
+}
@@ -0,0 +1,151 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/hierarchy/preset/WhatSonPresetHierarchyCreator.hpp"
+#include "app/models/hierarchy/preset/WhatSonPresetHierarchyParser.hpp"
+#include "app/models/hierarchy/preset/WhatSonPresetHierarchyStore.hpp"
+#include "app/models/hierarchy/preset/WhatSonPresetMembershipIndex.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    // Opening a preset must not rescan the hub; the full build is the only pass over every note.
+    constexpr int kSyntheticNoteCount = 100000;
+
+    LibraryNoteRecord presetNote(const int index)
+    {
+        LibraryNoteRecord note;
+        note.noteId = QStringLiteral("note-%1").arg(index, 6, 10, QLatin1Char('0'));
+        note.createdAt = QStringLiteral("2026-%1-01-09-00-00").arg(index % 12 + 1, 2, 10, QLatin1Char('0'));
+        note.lastModifiedAt = note.createdAt;
+        note.project = QStringLiteral("project-%1").arg(index % 40);
+        note.folders = QStringList{QStringLiteral("Research/Papers-%1").arg(index % 100)};
+        note.tags = QStringList{QStringLiteral("tag-%1").arg(index % 50)};
+        note.progress = index % 4;
+        note.openCount = index % 20;
+        note.bookmarked = index % 10 == 0;
+        if (note.bookmarked)
+        {
+            note.bookmarkColors = QStringList{QStringLiteral("red")};
+        }
+        return note;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::presetQuery_compilesPredicatesAndMaintainsMembershipIncrementally()
+{
+    WhatSonPresetQuery query;
+    query.folders = QStringList{QStringLiteral("Research")};
+    query.progressValues = QList<int>{1, 3};
+    query.created = WhatSonPresetDateRange{QStringLiteral("2026-03"), QStringLiteral("2026-06")};
+    query.minOpenCount = 5;
+    QCOMPARE(WhatSonPresetQuery::fromJson(query.toJson()), query);
+    QVERIFY(WhatSonPresetQuery{}.isEmpty());
+    QVERIFY(!WhatSonPresetPredicate(WhatSonPresetQuery{}).matches(presetNote(1)));
+
+    LibraryNoteRecord note = presetNote(3);
+    note.createdAt = QStringLiteral("2026-06-30-23-59-59");
+    note.openCount = 5;
+    const WhatSonPresetPredicate predicate(query);
+    QVERIFY(predicate.matches(note));
+    note.folders = QStringList{QStringLiteral("ResearchArchive")};
+    QVERIFY(!predicate.matches(note));
+    note.folders = QStringList{QStringLiteral("Research")};
+    QVERIFY(predicate.matches(note));
+    note.createdAt = QStringLiteral("2026-07-01-00-00-00");
+    QVERIFY(!predicate.matches(note));
+
+    // Smart presets round-trip through Preset.wspreset next to plain names written by older builds.
+    WhatSonPresetHierarchyStore store;
+    store.setPresetNames(QStringList{QStringLiteral("Plain"), QStringLiteral("Reading")});
+    store.setPresetQuery(QStringLiteral("Reading"), query);
+    WhatSonPresetHierarchyStore parsedStore;
+    QString errorMessage;
+    QVERIFY2(WhatSonPresetHierarchyParser().parse(
+                 WhatSonPresetHierarchyCreator().createText(store), &parsedStore, &errorMessage),
+             qPrintable(errorMessage));
+    QCOMPARE(parsedStore.presetNames(), store.presetNames());
+    QCOMPARE(parsedStore.presetQuery(QStringLiteral("Reading")), query);
+    QVERIFY(parsedStore.presetQuery(QStringLiteral("Plain")).isEmpty());
+    parsedStore.renamePresetQuery(QStringLiteral("Reading"), QStringLiteral("Reading list"));
+    parsedStore.setPresetNames(QStringList{QStringLiteral("Plain"), QStringLiteral("Reading list")});
+    QCOMPARE(parsedStore.presetQuery(QStringLiteral("Reading list")), query);
+
+    QVector<LibraryNoteRecord> notes;
+    notes.reserve(kSyntheticNoteCount);
+    int expectedRedCount = 0;
+    for (int index = 0; index < kSyntheticNoteCount; ++index)
+    {
+        notes.push_back(presetNote(index));
+        expectedRedCount += notes.constLast().bookmarked ? 1 : 0;
+    }
+
+    WhatSonPresetQuery redQuery;
+    redQuery.bookmarkColors = QStringList{QStringLiteral("red")};
+    WhatSonPresetQuery projectQuery;
+    projectQuery.projects = QStringList{QStringLiteral("project-7")};
+    projectQuery.maxOpenCount = 9;
+
+    WhatSonPresetMembershipIndex membership;
+    membership.setPresets(
+        QStringList{QStringLiteral("Plain"), QStringLiteral("Red"), QStringLiteral("Project 7")},
+        {{QStringLiteral("Red"), redQuery}, {QStringLiteral("Project 7"), projectQuery}});
+    QCOMPARE(membership.predicateEvaluationCount(), quint64{0});
+    membership.setNotes(notes);
+    // The plain preset has no predicate, so the rebuild is one pass per smart preset.
+    QCOMPARE(membership.predicateEvaluationCount(), quint64{2} * kSyntheticNoteCount);
+
+    QCOMPARE(membership.noteCount(), kSyntheticNoteCount);
+    QCOMPARE(membership.memberCount(0), 0);
+    QCOMPARE(membership.memberCount(1), expectedRedCount);
+    const int projectCount = membership.memberCount(2);
+    QVERIFY(projectCount > 0);
+    const QStringList projectMembers = membership.memberNoteIds(2);
+    QCOMPARE(projectMembers.size(), projectCount);
+    QCOMPARE(projectMembers.constFirst(), QStringLiteral("note-000007"));
+    QVERIFY(std::is_sorted(projectMembers.cbegin(), projectMembers.cend()));
+
+    // A single note change only moves the presets it enters or leaves, and evaluates that note once per preset.
+    const quint64 evaluationsBeforeUpdates = membership.predicateEvaluationCount();
+    LibraryNoteRecord changed = notes.at(7);
+    changed.bookmarked = true;
+    changed.bookmarkColors = QStringList{QStringLiteral("red")};
+    QCOMPARE(membership.upsertNote(changed), QList<int>({1}));
+    QCOMPARE(membership.memberCount(1), expectedRedCount + 1);
+    QCOMPARE(membership.predicateEvaluationCount(), evaluationsBeforeUpdates + 3);
+    QVERIFY(membership.upsertNote(changed).isEmpty());
+
+    changed.openCount = 15;
+    QCOMPARE(membership.upsertNote(changed), QList<int>({2}));
+    QCOMPARE(membership.memberCount(2), projectCount - 1);
+
+    QCOMPARE(membership.removeNote(changed.noteId), QList<int>({1}));
+    QCOMPARE(membership.memberCount(1), expectedRedCount);
+    QCOMPARE(membership.noteCount(), kSyntheticNoteCount - 1);
+    QVERIFY(membership.removeNote(changed.noteId).isEmpty());
+
+    LibraryNoteRecord added = presetNote(kSyntheticNoteCount);
+    added.project = QStringLiteral("project-7");
+    added.openCount = 1;
+    QVERIFY(membership.upsertNote(added).contains(2));
+    QCOMPARE(membership.memberCount(2), projectCount);
+    QCOMPARE(membership.memberNoteIds(2).constLast(), added.noteId);
+
+    // Removing a member keeps the remaining ids in index order.
+    QCOMPARE(membership.removeNote(QStringLiteral("note-000047")), QList<int>({2}));
+    const QStringList remainingProjectMembers = membership.memberNoteIds(2);
+    QCOMPARE(remainingProjectMembers.size(), projectCount - 1);
+    QCOMPARE(remainingProjectMembers.constFirst(), QStringLiteral("note-000087"));
+    QVERIFY(std::is_sorted(remainingProjectMembers.cbegin(), remainingProjectMembers.cend()));
+    QCOMPARE(membership.predicateEvaluationCount(), evaluationsBeforeUpdates + 4 * 3);
+
+    // Renaming a preset keeps its member set instead of re-evaluating the hub.
+    const quint64 evaluationsBeforeRename = membership.predicateEvaluationCount();
+    membership.setPresets(
+        QStringList{QStringLiteral("Plain"), QStringLiteral("Red"), QStringLiteral("Project Seven")},
+        {{QStringLiteral("Red"), redQuery}, {QStringLiteral("Project Seven"), projectQuery}},
+        notes);
+    QCOMPARE(membership.indexOfPreset(QStringLiteral("Project Seven")), 2);
+    QCOMPARE(membership.memberCount(2), projectCount - 1);
+    QCOMPARE(membership.predicateEvaluationCount(), evaluationsBeforeRename);
+}
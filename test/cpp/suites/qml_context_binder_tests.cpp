@@ -27,6 +27,8 @@ void WhatSonCppRegressionTests::qmlContextBinder_usesLvrsBindPlanForWorkspaceCon
     QVERIFY(!binderSource.contains(QStringLiteral("editorFontFamilyProvider")));
     QVERIFY(binderSource.contains(
         QStringLiteral("appendContextObjectBinding(plan, QStringLiteral(\"panelControllerRegistry\")")));
+    QVERIFY(binderSource.contains(
+        QStringLiteral("appendContextObjectBinding(plan, QStringLiteral(\"memoryAccounting\")")));
     QVERIFY(binderHeader.contains(QStringLiteral("QObject* noteActiveState = nullptr;")));
     QVERIFY(binderSource.contains(
         QStringLiteral("appendContextObjectBinding(plan, QStringLiteral(\"noteActiveState\")")));
@@ -43,6 +45,8 @@ void WhatSonCppRegressionTests::qmlContextBinder_usesLvrsBindPlanForWorkspaceCon
     QVERIFY(mainCppSource.contains(QStringLiteral("noteActiveState.setHierarchyContextSource(&sidebarHierarchyController);")));
     QVERIFY(mainCppSource.contains(QStringLiteral("workspaceContextObjects.noteActiveState = &noteActiveState;")));
     QVERIFY(mainCppSource.contains(QStringLiteral("workspaceContextObjects.inAppClipboard = &inAppClipboard;")));
+    QVERIFY(mainCppSource.contains(
+        QStringLiteral("workspaceContextObjects.memoryAccounting = &WhatSonMemoryAccounting::shared();")));
     QVERIFY(!mainCppSource.contains(QStringLiteral("EditorFontFamilyProvider")));
     QVERIFY(!mainCppSource.contains(QStringLiteral("NoteEditorDocumentSession")));
     QVERIFY(!mainCppSource.contains(QStringLiteral("ClipboardEditorPaste")));
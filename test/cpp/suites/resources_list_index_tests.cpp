@@ -0,0 +1,188 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+namespace
+{
+    ResourcesListItem resourceListItem(
+        const QString& fileName,
+        const QString& type,
+        const QString& format,
+        const QString& bucket)
+    {
+        ResourcesListItem item;
+        item.id = QStringLiteral("/hub/.wsresources/%1.wsresource").arg(fileName);
+        item.primaryText = fileName;
+        item.displayName = fileName;
+        item.type = type;
+        item.format = format;
+        item.bucket = bucket;
+        item.displayDate = bucket;
+        item.resourcePath = QStringLiteral("%1/%2").arg(bucket, fileName);
+        item.searchableText = QStringLiteral("%1 %2 %3 %4").arg(fileName, bucket, type, format);
+        return item;
+    }
+
+    QVector<ResourcesListItem> resourceFixtureItems()
+    {
+        return {
+            resourceListItem(QStringLiteral("Sunset Beach.png"), QStringLiteral("image"), QStringLiteral(".png"), QStringLiteral("Image")),
+            resourceListItem(QStringLiteral("sunrise.jpg"), QStringLiteral("image"), QStringLiteral(".jpg"), QStringLiteral("Image")),
+            resourceListItem(QStringLiteral("Quarterly Report.pdf"), QStringLiteral("document"), QStringLiteral(".pdf"), QStringLiteral("Document")),
+            resourceListItem(QStringLiteral("sunny-day.mp4"), QStringLiteral("video"), QStringLiteral(".mp4"), QStringLiteral("Video")),
+            resourceListItem(QStringLiteral("archive.wsunknown"), QStringLiteral("other"), QStringLiteral(".bin"), QStringLiteral("Other"))
+        };
+    }
+
+    QStringList primaryTexts(const ResourcesListModel& model)
+    {
+        QStringList texts;
+        for (const ResourcesListItem& item : model.items())
+        {
+            texts.push_back(item.primaryText);
+        }
+        return texts;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::resourcesListIndex_intersectsFacetPostingsAndFileNamePrefixes()
+{
+    QVector<ResourcesListItem> items = resourceFixtureItems();
+    for (ResourcesListItem& item : items)
+    {
+        item.searchableText = item.searchableText.toCaseFolded();
+    }
+
+    ResourcesListIndex index;
+    index.sync(items);
+    QCOMPARE(index.rowCount(), 5);
+
+    QCOMPARE(index.query({}, {}), QVector<int>({0, 1, 2, 3, 4}));
+    QCOMPARE(index.query({QStringLiteral("Image"), {}, {}, {}}, {}), QVector<int>({0, 1}));
+    QCOMPARE(index.query({QStringLiteral("image"), {}, QStringLiteral(".jpg"), {}}, {}), QVector<int>({1}));
+    QCOMPARE(index.query({{}, {}, {}, QStringLiteral("image/png")}, {}), QVector<int>({0}));
+    QCOMPARE(index.query({{}, {}, {}, QStringLiteral("application/pdf")}, {}), QVector<int>({2}));
+    QVERIFY(index.query({QStringLiteral("audio"), {}, {}, {}}, {}).isEmpty());
+
+    QCOMPARE(index.query({}, {QStringLiteral("sun")}), QVector<int>({0, 1, 3}));
+    QCOMPARE(index.query({QStringLiteral("image"), {}, {}, {}}, {QStringLiteral("sun")}), QVector<int>({0, 1}));
+    QCOMPARE(index.query({}, {QStringLiteral("sun"), QStringLiteral("bea")}), QVector<int>({0}));
+    QCOMPARE(index.query({}, {QStringLiteral("sunny-d")}), QVector<int>({3}));
+    QCOMPARE(index.query({}, {QStringLiteral("quarterly report.p")}), QVector<int>({2}));
+    QCOMPARE(index.query({}, {QStringLiteral("port")}), QVector<int>({2}));
+    QCOMPARE(index.query({}, {QStringLiteral("unset")}), QVector<int>({0}));
+    QVERIFY(index.query({}, {QStringLiteral("zebra")}).isEmpty());
+
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Type, QStringLiteral("image")), 2);
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Bucket, QStringLiteral("Document")), 1);
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Format, QStringLiteral(".bin")), 1);
+    QCOMPARE(index.mimeAt(4), QStringLiteral("application/octet-stream"));
+    const QVariantMap facetCounts = index.facetCountsMap();
+    QCOMPARE(facetCounts.value(QStringLiteral("type")).toMap().value(QStringLiteral("video")).toInt(), 1);
+    QCOMPARE(facetCounts.value(QStringLiteral("mime")).toMap().value(QStringLiteral("video/mp4")).toInt(), 1);
+
+    items.removeAt(1);
+    index.sync(items);
+    QCOMPARE(index.rowCount(), 4);
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Type, QStringLiteral("image")), 1);
+    QCOMPARE(index.query({}, {QStringLiteral("sun")}), QVector<int>({0, 2}));
+
+    ResourcesListItem moon = resourceListItem(
+        QStringLiteral("moon.png"),
+        QStringLiteral("image"),
+        QStringLiteral(".png"),
+        QStringLiteral("Image"));
+    moon.searchableText = moon.searchableText.toCaseFolded();
+    index.upsert(moon);
+    QCOMPARE(index.rowCount(), 5);
+    QCOMPARE(index.query({QStringLiteral("image"), {}, {}, {}}, {}), QVector<int>({0, 4}));
+    QCOMPARE(index.mimeAt(4), QStringLiteral("image/png"));
+
+    moon.type = QStringLiteral("document");
+    index.upsert(moon);
+    QCOMPARE(index.rowCount(), 5);
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Type, QStringLiteral("image")), 1);
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Type, QStringLiteral("document")), 2);
+
+    QVERIFY(index.remove(items.at(0).id));
+    QVERIFY(!index.remove(items.at(0).id));
+    QCOMPARE(index.rowCount(), 4);
+    QCOMPARE(index.facetCount(ResourcesListIndex::Facet::Type, QStringLiteral("image")), 0);
+    QVERIFY(!index.facetCountsMap().value(QStringLiteral("type")).toMap().contains(QStringLiteral("image")));
+    QCOMPARE(index.query({}, {QStringLiteral("moo")}), QVector<int>({3}));
+    QCOMPARE(index.query({}, {QStringLiteral("sun")}), QVector<int>({1}));
+
+    index.clear();
+    QCOMPARE(index.rowCount(), 0);
+    QVERIFY(index.query({}, {}).isEmpty());
+
+    // A prefix hit on one file must not hide mid-word hits on others.
+    ResourcesListItem portrait = resourceListItem(
+        QStringLiteral("portrait.png"),
+        QStringLiteral("image"),
+        QStringLiteral(".png"),
+        QStringLiteral("Image"));
+    portrait.searchableText = portrait.searchableText.toCaseFolded();
+    index.sync({items.at(1), portrait});
+    QCOMPARE(index.query({}, {QStringLiteral("port")}), QVector<int>({0, 1}));
+    QCOMPARE(index.query({}, {QStringLiteral("portr")}), QVector<int>({1}));
+
+    // `.bin` resources resolve their mime from the file name, one cache entry per file.
+    ResourcesListItem binaryScan = resourceListItem(
+        QStringLiteral("scan.png"),
+        QStringLiteral("other"),
+        QStringLiteral(".bin"),
+        QStringLiteral("Other"));
+    index.sync({items.at(3), binaryScan});
+    QCOMPARE(index.mimeAt(0), QStringLiteral("application/octet-stream"));
+    QCOMPARE(index.mimeAt(1), QStringLiteral("image/png"));
+}
+
+void WhatSonCppRegressionTests::resourcesListModel_appliesFacetFiltersThroughKeyedRowDiffs()
+{
+    ResourcesListModel model;
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy facetFilterSpy(&model, &ResourcesListModel::facetFilterChanged);
+
+    model.setItems(resourceFixtureItems());
+    QCOMPARE(model.itemCount(), 5);
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(model.facetCount(QStringLiteral("type"), QStringLiteral("image")), 2);
+    QCOMPARE(model.facetCount(QStringLiteral("bucket"), QStringLiteral("video")), 1);
+    QCOMPARE(model.facetCount(QStringLiteral("unknown"), QStringLiteral("image")), 0);
+    QCOMPARE(
+        model.facetCounts().value(QStringLiteral("format")).toMap().value(QStringLiteral(".pdf")).toInt(),
+        1);
+
+    model.setCurrentIndex(1);
+    QCOMPARE(model.currentNoteId(), resourceFixtureItems().at(1).id);
+
+    model.setTypeFilter(QStringLiteral("image"));
+    QCOMPARE(facetFilterSpy.count(), 1);
+    QCOMPARE(primaryTexts(model), QStringList({QStringLiteral("Sunset Beach.png"), QStringLiteral("sunrise.jpg")}));
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(model.currentNoteId(), resourceFixtureItems().at(1).id);
+    QCOMPARE(model.currentIndex(), 1);
+
+    model.setTypeFilter(QStringLiteral("image"));
+    QCOMPARE(facetFilterSpy.count(), 1);
+
+    model.setSearchText(QStringLiteral("SUNSET"));
+    QCOMPARE(primaryTexts(model), QStringList({QStringLiteral("Sunset Beach.png")}));
+    QCOMPARE(model.currentIndex(), 0);
+
+    model.clearFacetFilters();
+    model.setMimeFilter(QStringLiteral("video/mp4"));
+    QVERIFY(primaryTexts(model).isEmpty());
+
+    model.setSearchText(QString());
+    QCOMPARE(primaryTexts(model), QStringList({QStringLiteral("sunny-day.mp4")}));
+
+    model.clearFacetFilters();
+    QCOMPARE(model.itemCount(), 5);
+    QCOMPARE(primaryTexts(model).constFirst(), QStringLiteral("Sunset Beach.png"));
+    QCOMPARE(resetSpy.count(), 0);
+    QVERIFY(insertedSpy.count() >= 2);
+}
@@ -1,28 +1,143 @@
 #include "test/cpp/whatson_cpp_regression_tests.hpp"
 
-void WhatSonCppRegressionTests::runtimeParallelLoader_usesLvrsBootstrapParallelForDomainLoads()
+#include "app/runtime/threading/WhatSonRuntimeTaskGraph.hpp"
+
+#include <QHash>
+#include <QSemaphore>
+
+#include <algorithm>
+
+void WhatSonCppRegressionTests::runtimeParallelLoader_schedulesDomainLoadsThroughTaskGraph()
 {
     const QString loaderSource = readUtf8SourceFile(
         QStringLiteral("src/app/runtime/threading/WhatSonRuntimeParallelLoader.cpp"));
 
-    QVERIFY(loaderSource.contains(QStringLiteral("#include \"backend/runtime/bootstrapparallel.h\"")));
-    QVERIFY(loaderSource.contains(QStringLiteral("QList<lvrs::BootstrapParallelTask> bootstrapTasks;")));
-    QVERIFY(loaderSource.contains(QStringLiteral("lvrs::BootstrapParallelTask task;")));
-    QVERIFY(loaderSource.contains(QStringLiteral("task.load = [")));
-    QVERIFY(loaderSource.contains(QStringLiteral("lvrs::BootstrapParallelRunOptions bootstrapOptions;")));
-    QVERIFY(loaderSource.contains(QStringLiteral("lvrs::runBootstrapParallelTasks(bootstrapTasks, bootstrapOptions)")));
+    QVERIFY(loaderSource.contains(QStringLiteral("#include \"app/runtime/threading/WhatSonRuntimeTaskGraph.hpp\"")));
+    QVERIFY(loaderSource.contains(QStringLiteral("WhatSonRuntimeTaskGraph taskGraph;")));
+    QVERIFY(loaderSource.contains(QStringLiteral("taskGraph.run()")));
     QVERIFY(loaderSource.contains(QStringLiteral("WhatSonRuntimeDomainSnapshots::buildSharedContext(normalizedPath)")));
     QVERIFY(loaderSource.contains(QStringLiteral("WhatSonRuntimeDomainSnapshots::buildBookmarks(librarySnapshot.allNotes)")));
-    QVERIFY(loaderSource.contains(QStringLiteral("if (!allSucceeded)")));
+    QVERIFY(loaderSource.contains(QStringLiteral("{QStringLiteral(\"library\")}")));
+    QVERIFY(loaderSource.contains(QStringLiteral("WhatSonRuntimeTaskGraph::formatCriticalPath(graphResult)")));
+    QVERIFY(loaderSource.contains(QStringLiteral("if (!mountable)")));
     QVERIFY(loaderSource.contains(QStringLiteral("applySkipped=1")));
+    QVERIFY(loaderSource.contains(QStringLiteral("result.degraded = resultIndexesByDomain.contains(result.domain)")));
+    QVERIFY(loaderSource.contains(QStringLiteral("mountable = mountable && succeededCount > 0;")));
+    QVERIFY(loaderSource.contains(QStringLiteral("const bool libraryIndexed = hasLibraryTask && librarySnapshot.succeeded;")));
+    QVERIFY(!loaderSource.contains(QStringLiteral("if (!allSucceeded)")));
 
     QVERIFY(!loaderSource.contains(QStringLiteral("spawnFunctionLoadThread")));
     QVERIFY(!loaderSource.contains(QStringLiteral("QEventLoop waitLoop")));
     QVERIFY(!loaderSource.contains(QStringLiteral("QThread*")));
     QVERIFY(!loaderSource.contains(QStringLiteral("thread->start()")));
 
-    const qsizetype applyGateIndex = loaderSource.indexOf(QStringLiteral("if (!allSucceeded)"));
+    const qsizetype applyGateIndex = loaderSource.indexOf(QStringLiteral("if (!mountable)"));
     const qsizetype libraryApplyIndex = loaderSource.indexOf(QStringLiteral("targets.libraryController->applyRuntimeSnapshot"));
     QVERIFY(applyGateIndex >= 0);
     QVERIFY(libraryApplyIndex > applyGateIndex);
 }
+
+void WhatSonCppRegressionTests::runtimeTaskGraph_startsDependentsAsSoonAsInputsFinish()
+{
+    // A derived node must not wait for an unrelated root: "tags" only finishes once "bookmarks" has run, so a graph that
+    // held dependents back until every root finished would never release it. The timeout only bounds that failure.
+    QSemaphore bookmarksRan;
+    bool tagsSawBookmarks = false;
+    int libraryOutput = 0;
+    int bookmarksOutput = 0;
+
+    WhatSonRuntimeTaskGraph graph;
+    graph.setMaxWorkerCount(4);
+    QVERIFY(graph.addNode(QStringLiteral("layout"), {}, [](QString*)
+    {
+        return true;
+    }));
+    QVERIFY(graph.addNode(QStringLiteral("tags"), {QStringLiteral("layout")}, [&bookmarksRan, &tagsSawBookmarks](QString*)
+    {
+        tagsSawBookmarks = bookmarksRan.tryAcquire(1, 10000);
+        return true;
+    }));
+    QVERIFY(graph.addNode(QStringLiteral("library"), {QStringLiteral("layout")}, [&libraryOutput](QString*)
+    {
+        libraryOutput = 42;
+        return true;
+    }));
+    QVERIFY(graph.addNode(
+        QStringLiteral("bookmarks"),
+        {QStringLiteral("library")},
+        [&libraryOutput, &bookmarksOutput, &bookmarksRan](QString*)
+        {
+            bookmarksOutput = libraryOutput + 1;
+            bookmarksRan.release();
+            return true;
+        }));
+    QVERIFY(!graph.addNode(QStringLiteral("tags"), {}, {}));
+
+    const WhatSonRuntimeTaskGraph::RunResult result = graph.run();
+    QVERIFY2(result.succeeded, qPrintable(result.error));
+    QCOMPARE(result.nodes.size(), 4);
+    QCOMPARE(bookmarksOutput, 43);
+    QVERIFY(tagsSawBookmarks);
+    QVERIFY(result.nodes.at(3).startedAtUs <= result.nodes.at(1).finishedAtUs);
+
+    // The critical path is the input chain with the largest summed node duration, checked against the recorded
+    // timings rather than against sleeps.
+    QHash<QString, qint64> durationUsByName;
+    for (const WhatSonRuntimeTaskGraph::NodeResult& node : result.nodes)
+    {
+        durationUsByName.insert(node.name, node.finishedAtUs - node.startedAtUs);
+    }
+    const qint64 tagsPathUs = durationUsByName.value(QStringLiteral("layout")) + durationUsByName.value(QStringLiteral("tags"));
+    const qint64 bookmarksPathUs = durationUsByName.value(QStringLiteral("layout"))
+        + durationUsByName.value(QStringLiteral("library"))
+        + durationUsByName.value(QStringLiteral("bookmarks"));
+    QCOMPARE(result.criticalPathUs, std::max(tagsPathUs, bookmarksPathUs));
+    qint64 reportedPathUs = 0;
+    for (const QString& name : result.criticalPath)
+    {
+        reportedPathUs += durationUsByName.value(name);
+    }
+    QCOMPARE(reportedPathUs, result.criticalPathUs);
+    QCOMPARE(result.criticalPath.constFirst(), QStringLiteral("layout"));
+    QVERIFY(result.criticalPathUs <= result.elapsedUs);
+    QVERIFY(WhatSonRuntimeTaskGraph::formatCriticalPath(result).contains(
+        QStringLiteral("criticalPath=") + result.criticalPath.join(QLatin1Char('>'))));
+
+    // A failed input skips its dependents with the upstream error; independent nodes still run.
+    bool unrelatedRan = false;
+    bool dependentRan = false;
+    WhatSonRuntimeTaskGraph failingGraph;
+    failingGraph.addNode(QStringLiteral("library"), {}, [](QString* error)
+    {
+        *error = QStringLiteral("index failed");
+        return false;
+    });
+    failingGraph.addNode(QStringLiteral("bookmarks"), {QStringLiteral("library")}, [&dependentRan](QString*)
+    {
+        dependentRan = true;
+        return true;
+    });
+    failingGraph.addNode(QStringLiteral("resources"), {}, [&unrelatedRan](QString*)
+    {
+        unrelatedRan = true;
+        return true;
+    });
+    const WhatSonRuntimeTaskGraph::RunResult failingResult = failingGraph.run();
+    QVERIFY(!failingResult.succeeded);
+    QVERIFY(!dependentRan);
+    QVERIFY(unrelatedRan);
+    QCOMPARE(failingResult.nodes.at(1).ran, false);
+    QCOMPARE(failingResult.nodes.at(1).error, QStringLiteral("index failed"));
+    QVERIFY(failingResult.nodes.at(2).succeeded);
+
+    WhatSonRuntimeTaskGraph cyclicGraph;
+    cyclicGraph.addNode(QStringLiteral("a"), {QStringLiteral("b")}, {});
+    cyclicGraph.addNode(QStringLiteral("b"), {QStringLiteral("a")}, {});
+    const WhatSonRuntimeTaskGraph::RunResult cyclicResult = cyclicGraph.run();
+    QVERIFY(!cyclicResult.succeeded);
+    QVERIFY(cyclicResult.error.contains(QStringLiteral("cycle")));
+
+    WhatSonRuntimeTaskGraph undefinedInputGraph;
+    undefinedInputGraph.addNode(QStringLiteral("bookmarks"), {QStringLiteral("library")}, {});
+    QVERIFY(!undefinedInputGraph.run().succeeded);
+}
@@ -0,0 +1,119 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/store/settings/WhatSonSettingsStore.hpp"
+
+#include <QDataStream>
+
+namespace
+{
+    QByteArray settingsJournalRecord(const quint8 recordType, const QString& key, const QVariant& value = {})
+    {
+        QByteArray record;
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_6_5);
+        stream << recordType << key;
+        if (value.isValid())
+        {
+            stream << value;
+        }
+        return record;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::settingsStore_servesCachedReadsAndReplaysJournal()
+{
+    QTemporaryDir settingsDir;
+    QVERIFY(settingsDir.isValid());
+    const ScopedQSettingsSandbox settingsSandbox(settingsDir.path());
+
+    const QString settingsFilePath = QDir(settingsDir.path()).filePath(QStringLiteral("store.ini"));
+    const QString journalFilePath = WhatSonSettingsStore::journalFilePathFor(settingsFilePath);
+    {
+        QSettings seed(settingsFilePath, QSettings::IniFormat);
+        seed.setValue(QStringLiteral("register/authenticated"), true);
+        seed.sync();
+    }
+
+    {
+        WhatSonSettingsStore store(settingsFilePath, QSettings::IniFormat);
+        QCOMPARE(store.replayedJournalRecordCount(), 0);
+        QVERIFY(store.boolValue(QStringLiteral("register/authenticated")));
+        QVERIFY(!store.contains(QStringLiteral("extension/trial/installDate")));
+
+        // Reads come from the cache, not from a file edited behind the store's back.
+        {
+            QSettings external(settingsFilePath, QSettings::IniFormat);
+            external.setValue(QStringLiteral("register/authenticated"), false);
+            external.sync();
+        }
+        QVERIFY(store.boolValue(QStringLiteral("register/authenticated")));
+
+        store.setValue(QStringLiteral("extension/trial/installDate"), QStringLiteral("2026-01-02"));
+        store.remove(QStringLiteral("register/authenticated"));
+        QCOMPARE(store.stringValue(QStringLiteral("extension/trial/installDate")), QStringLiteral("2026-01-02"));
+        QVERIFY(!store.contains(QStringLiteral("register/authenticated")));
+        QVERIFY(store.hasPendingWrites());
+        QVERIFY(QFileInfo(journalFilePath).size() > 0);
+
+        QVERIFY(store.flush());
+        QVERIFY(!store.hasPendingWrites());
+        QVERIFY(!QFileInfo::exists(journalFilePath));
+
+        const QSettings persisted(settingsFilePath, QSettings::IniFormat);
+        QCOMPARE(persisted.value(QStringLiteral("extension/trial/installDate")).toString(), QStringLiteral("2026-01-02"));
+        QVERIFY(!persisted.contains(QStringLiteral("register/authenticated")));
+
+        store.setValue(QStringLiteral("extension/trial/installDate"), QStringLiteral("2026-01-02"));
+        QVERIFY(!store.hasPendingWrites());
+    }
+
+    // A crash between journal append and sync leaves records behind; a torn tail record is ignored.
+    QByteArray journalBytes = settingsJournalRecord(0x53, QStringLiteral("extension/trial/lastSeenTimestampUtc"),
+                                                    QStringLiteral("2026-03-04T05:06:07.000Z"));
+    journalBytes += settingsJournalRecord(0x52, QStringLiteral("extension/trial/installDate"));
+    const QByteArray tornRecord = settingsJournalRecord(0x53, QStringLiteral("register/authenticated"), true);
+    journalBytes += tornRecord.left(tornRecord.size() - 2);
+    {
+        QFile journal(journalFilePath);
+        QVERIFY(journal.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(journal.write(journalBytes), journalBytes.size());
+    }
+
+    {
+        WhatSonSettingsStore store(settingsFilePath, QSettings::IniFormat);
+        QCOMPARE(store.replayedJournalRecordCount(), 2);
+        QVERIFY(!QFileInfo::exists(journalFilePath));
+        QCOMPARE(store.stringValue(QStringLiteral("extension/trial/lastSeenTimestampUtc")),
+                 QStringLiteral("2026-03-04T05:06:07.000Z"));
+        QVERIFY(!store.contains(QStringLiteral("extension/trial/installDate")));
+        QVERIFY(!store.contains(QStringLiteral("register/authenticated")));
+    }
+
+    const QSettings replayed(settingsFilePath, QSettings::IniFormat);
+    QVERIFY(replayed.contains(QStringLiteral("extension/trial/lastSeenTimestampUtc")));
+    QVERIFY(!replayed.contains(QStringLiteral("extension/trial/installDate")));
+
+    // A failed sync requeues its entries and retries on its own, without waiting for another write.
+    const QString blockedSettingsFilePath = QDir(settingsDir.path()).filePath(QStringLiteral("blocked.ini"));
+    QVERIFY(QDir().mkpath(blockedSettingsFilePath));
+    {
+        WhatSonSettingsStore store(blockedSettingsFilePath, QSettings::IniFormat);
+        store.setValue(QStringLiteral("workspace/retry"), 3);
+        QVERIFY(!store.flush());
+        QVERIFY(store.hasPendingWrites());
+
+        QVERIFY(QDir(blockedSettingsFilePath).removeRecursively());
+        QTRY_VERIFY_WITH_TIMEOUT(!store.hasPendingWrites(), 5000);
+        QVERIFY(!QFileInfo::exists(WhatSonSettingsStore::journalFilePathFor(blockedSettingsFilePath)));
+    }
+    QCOMPARE(QSettings(blockedSettingsFilePath, QSettings::IniFormat).value(QStringLiteral("workspace/retry")).toInt(), 3);
+
+    WhatSonSettingsStore& sharedStore = WhatSonSettingsStore::shared();
+    sharedStore.reload();
+    QCOMPARE(sharedStore.settingsFilePath(), QSettings().fileName());
+    sharedStore.setValue(QStringLiteral("workspace/probe"), 7);
+    QVERIFY(sharedStore.flush());
+    QCOMPARE(QSettings().value(QStringLiteral("workspace/probe")).toInt(), 7);
+    sharedStore.remove(QStringLiteral("workspace/probe"));
+    QVERIFY(sharedStore.flush());
+}
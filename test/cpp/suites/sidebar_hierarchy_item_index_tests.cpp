@@ -0,0 +1,122 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+namespace
+{
+    QVariantMap hierarchyNode(const QString& itemKey, const QString& label)
+    {
+        return QVariantMap{
+            {QStringLiteral("itemKey"), itemKey},
+            {QStringLiteral("label"), label}
+        };
+    }
+
+    QQuickItem* createHierarchyRow(QQuickItem* parent, const int index, const QString& itemKey, const qreal y)
+    {
+        auto* row = new QQuickItem(parent);
+        row->setProperty("__isHierarchyItem", true);
+        row->setProperty("itemId", index);
+        row->setProperty("resolvedItemKey", itemKey);
+        row->setY(y);
+        row->setWidth(200);
+        row->setHeight(20);
+        return row;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::sidebarHierarchyItemIndex_resolvesKeysAndInsertedRowsNatively()
+{
+    FakeHierarchyController controller(QStringLiteral("library"));
+    controller.setNodes({
+        hierarchyNode(QStringLiteral("folder:a"), QStringLiteral("A")),
+        QVariantMap{{QStringLiteral("key"), QStringLiteral("folder:b")}},
+        hierarchyNode(QStringLiteral("folder:c"), QStringLiteral("C")),
+        hierarchyNode(QStringLiteral("folder:a"), QStringLiteral("A copy"))
+    });
+
+    SidebarHierarchyItemIndex itemIndex;
+    QSignalSpy indexChangedSpy(&itemIndex, &SidebarHierarchyItemIndex::indexChanged);
+    itemIndex.setHierarchyController(&controller);
+
+    QCOMPARE(itemIndex.itemCount(), 4);
+    QCOMPARE(itemIndex.indexForKey(QStringLiteral("folder:a")), 0);
+    QCOMPARE(itemIndex.indexForKey(QStringLiteral(" folder:b ")), 1);
+    QCOMPARE(itemIndex.indexForKey(QStringLiteral("folder:missing")), -1);
+    QCOMPARE(itemIndex.indexForKey(QString()), -1);
+    QCOMPARE(itemIndex.keyAt(2), QStringLiteral("folder:c"));
+    QCOMPARE(itemIndex.keyAt(9), QString());
+
+    const QVariantList beforeNodes = controller.hierarchyNodes();
+    QVariantList afterNodes = beforeNodes;
+    afterNodes.insert(2, hierarchyNode(QStringLiteral("folder:a"), QStringLiteral("A again")));
+    controller.setNodes(afterNodes);
+
+    QVERIFY(indexChangedSpy.count() >= 2);
+    QCOMPARE(itemIndex.itemCount(), 5);
+    QCOMPARE(itemIndex.indexForKey(QStringLiteral("folder:c")), 3);
+    QCOMPARE(itemIndex.insertedIndex(beforeNodes, afterNodes), 4);
+    QCOMPARE(itemIndex.insertedIndex(beforeNodes, beforeNodes), -1);
+
+    QVariantList prependedNodes = beforeNodes;
+    prependedNodes.prepend(hierarchyNode(QStringLiteral("folder:new"), QStringLiteral("New")));
+    QCOMPARE(itemIndex.insertedIndex(beforeNodes, prependedNodes), 0);
+
+    itemIndex.setHierarchyController(nullptr);
+    QCOMPARE(itemIndex.itemCount(), 0);
+    QCOMPARE(itemIndex.indexForKey(QStringLiteral("folder:a")), -1);
+}
+
+void WhatSonCppRegressionTests::sidebarHierarchyItemIndex_hitTestsVisibleRowsWithoutQmlTreeWalk()
+{
+    FakeHierarchyController controller(QStringLiteral("library"));
+    controller.setNodes({
+        hierarchyNode(QStringLiteral("folder:a"), QStringLiteral("A")),
+        hierarchyNode(QStringLiteral("folder:b"), QStringLiteral("B")),
+        hierarchyNode(QStringLiteral("folder:c"), QStringLiteral("C"))
+    });
+
+    SidebarHierarchyItemIndex itemIndex;
+    itemIndex.setHierarchyController(&controller);
+
+    QQuickItem hierarchyTree;
+    hierarchyTree.setWidth(200);
+    hierarchyTree.setHeight(200);
+    auto* contentColumn = new QQuickItem(&hierarchyTree);
+    contentColumn->setY(10);
+    QQuickItem* firstRow = createHierarchyRow(contentColumn, 0, QStringLiteral("folder:a"), 0);
+    QQuickItem* secondRow = createHierarchyRow(contentColumn, 1, QStringLiteral("folder:b"), 20);
+    QQuickItem* hiddenRow = createHierarchyRow(contentColumn, 2, QStringLiteral("folder:c"), 40);
+    hiddenRow->setVisible(false);
+    auto* decoration = new QQuickItem(contentColumn);
+    decoration->setWidth(200);
+    decoration->setHeight(200);
+
+    const QVariantList collectedItems = itemIndex.collectItems(&hierarchyTree);
+    QCOMPARE(collectedItems.size(), 2);
+    QVERIFY(qvariant_cast<QObject*>(collectedItems.at(0)) == firstRow);
+    QVERIFY(qvariant_cast<QObject*>(collectedItems.at(1)) == secondRow);
+
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 15) == firstRow);
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 35) == secondRow);
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 55) == nullptr);
+    QVERIFY(itemIndex.itemAtPosition(nullptr, 50, 15) == nullptr);
+
+    contentColumn->setY(-10);
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 15) == secondRow);
+    contentColumn->setY(10);
+
+    QQuickItem* createdRow = createHierarchyRow(contentColumn, 2, QStringLiteral("folder:c"), 40);
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 55) == createdRow);
+    QVERIFY(itemIndex.itemForModelIndex(&hierarchyTree, 2) == createdRow);
+    QCOMPARE(itemIndex.collectItems(&hierarchyTree).size(), 3);
+    delete createdRow;
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 55) == nullptr);
+    QCOMPARE(itemIndex.collectItems(&hierarchyTree).size(), 2);
+
+    secondRow->setProperty("rowVisible", false);
+    QVERIFY(itemIndex.itemAtPosition(&hierarchyTree, 50, 35) == nullptr);
+
+    QVERIFY(itemIndex.itemForModelIndex(&hierarchyTree, 0) == firstRow);
+    QVERIFY(itemIndex.itemForModelIndex(&hierarchyTree, 2) == nullptr);
+    secondRow->setProperty("resolvedItemKey", QStringLiteral("folder:stale"));
+    QVERIFY(itemIndex.itemForModelIndex(&hierarchyTree, 1) == nullptr);
+}
@@ -0,0 +1,247 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/sync/WhatSonHubSyncController.hpp"
+
+namespace
+{
+    WhatSonFolderDepthEntry folderEntry(const QString& id, const QString& label, const int depth, const QChar uuidFill)
+    {
+        WhatSonFolderDepthEntry entry;
+        entry.id = id;
+        entry.label = label;
+        entry.depth = depth;
+        entry.uuid = QString(WhatSon::FolderIdentity::kUuidLength, uuidFill);
+        return entry;
+    }
+
+    WhatSonNoteHeaderStore baseHeaderForMerge()
+    {
+        WhatSonNoteHeaderStore store;
+        store.setNoteId(QStringLiteral("note-merge"));
+        store.setCreatedAt(QStringLiteral("2026-05-01-09-00-00"));
+        store.setLastModifiedAt(QStringLiteral("2026-05-01-09-00-00"));
+        store.setAuthor(QStringLiteral("alice"));
+        store.setProject(QStringLiteral("Alpha"));
+        store.setTags({QStringLiteral("draft"), QStringLiteral("shared")});
+        store.setOpenCount(4);
+        return store;
+    }
+
+    QString foldersText(const QVector<WhatSonFolderDepthEntry>& entries)
+    {
+        WhatSonFoldersHierarchyStore store;
+        store.setFolderEntries(entries);
+        return WhatSonFoldersHierarchyCreator().createText(store);
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::threeWayMergeResolver_mergesHeaderFieldsAndFolderNodes()
+{
+    const WhatSonThreeWayMergeResolver resolver;
+
+    const WhatSonNoteHeaderStore base = baseHeaderForMerge();
+    WhatSonNoteHeaderStore local = base;
+    local.setLastModifiedAt(QStringLiteral("2026-05-01-10-00-00"));
+    local.setProject(QStringLiteral("Beta"));
+    local.setTags({QStringLiteral("draft"), QStringLiteral("local-only")});
+    local.setOpenCount(6);
+    WhatSonNoteHeaderStore remote = base;
+    remote.setLastModifiedAt(QStringLiteral("2026-05-01-11-00-00"));
+    remote.setAuthor(QStringLiteral("bob"));
+    remote.setTags({QStringLiteral("draft"), QStringLiteral("shared"), QStringLiteral("remote-only")});
+    remote.setOpenCount(5);
+
+    QVector<WhatSonMergeConflict> conflicts;
+    const WhatSonNoteHeaderStore merged = resolver.mergeNoteHeaders(base, local, remote, &conflicts);
+    QVERIFY(conflicts.isEmpty());
+    QCOMPARE(merged.project(), QStringLiteral("Beta"));
+    QCOMPARE(merged.author(), QStringLiteral("bob"));
+    QCOMPARE(merged.lastModifiedAt(), QStringLiteral("2026-05-01-11-00-00"));
+    QCOMPARE(
+        merged.tags(),
+        QStringList({QStringLiteral("draft"), QStringLiteral("local-only"), QStringLiteral("remote-only")}));
+    QCOMPARE(merged.totalTags(), 3);
+    QCOMPARE(merged.openCount(), 7);
+
+    remote.setProject(QStringLiteral("Gamma"));
+    conflicts.clear();
+    const WhatSonNoteHeaderStore conflicted = resolver.mergeNoteHeaders(base, local, remote, &conflicts);
+    QCOMPARE(conflicts.size(), 1);
+    QCOMPARE(conflicts.constFirst().field, QStringLiteral("project"));
+    QCOMPARE(conflicts.constFirst().localValue, QStringLiteral("Beta"));
+    QCOMPARE(conflicts.constFirst().remoteValue, QStringLiteral("Gamma"));
+    QCOMPARE(conflicted.project(), QStringLiteral("Gamma"));
+
+    const WhatSonFolderDepthEntry research = folderEntry(QStringLiteral("Research"), QStringLiteral("Research"), 0, QLatin1Char('a'));
+    const WhatSonFolderDepthEntry drafts = folderEntry(QStringLiteral("Research/Drafts"), QStringLiteral("Drafts"), 1, QLatin1Char('b'));
+    const WhatSonFolderDepthEntry archive = folderEntry(QStringLiteral("Archive"), QStringLiteral("Archive"), 0, QLatin1Char('c'));
+    const QVector<WhatSonFolderDepthEntry> baseFolders{research, drafts, archive};
+
+    WhatSonFolderDepthEntry renamedDrafts = drafts;
+    renamedDrafts.label = QStringLiteral("Working");
+    const WhatSonFolderDepthEntry localOnly = folderEntry(QStringLiteral("Inbox"), QStringLiteral("Inbox"), 0, QLatin1Char('d'));
+    const QVector<WhatSonFolderDepthEntry> localFolders{research, renamedDrafts, archive, localOnly};
+
+    const WhatSonFolderDepthEntry remoteOnly = folderEntry(QStringLiteral("Research/Sources"), QStringLiteral("Sources"), 1, QLatin1Char('e'));
+    const QVector<WhatSonFolderDepthEntry> remoteFolders{research, remoteOnly, drafts};
+
+    conflicts.clear();
+    const QVector<WhatSonFolderDepthEntry> mergedFolders =
+        resolver.mergeFolderEntries(baseFolders, localFolders, remoteFolders, &conflicts);
+    QVERIFY(conflicts.isEmpty());
+    QCOMPARE(mergedFolders.size(), 4);
+    QCOMPARE(mergedFolders.at(0).uuid, research.uuid);
+    QCOMPARE(mergedFolders.at(1).uuid, remoteOnly.uuid);
+    QCOMPARE(mergedFolders.at(2).label, QStringLiteral("Working"));
+    QCOMPARE(mergedFolders.at(3).uuid, localOnly.uuid);
+
+    WhatSonFolderDepthEntry modifiedArchive = archive;
+    modifiedArchive.label = QStringLiteral("Cold Storage");
+    conflicts.clear();
+    const QVector<WhatSonFolderDepthEntry> keptFolders = resolver.mergeFolderEntries(
+        baseFolders,
+        {research, drafts, modifiedArchive},
+        {research, drafts},
+        &conflicts);
+    QCOMPARE(conflicts.size(), 1);
+    QCOMPARE(conflicts.constFirst().field, QStringLiteral("node"));
+    QCOMPARE(keptFolders.size(), 3);
+    QCOMPARE(keptFolders.at(2).label, QStringLiteral("Cold Storage"));
+
+    const WhatSonFolderDepthEntry localChild = folderEntry(QStringLiteral("Research/Notes"), QStringLiteral("Notes"), 1, QLatin1Char('f'));
+    const WhatSonFolderDepthEntry localGrandchild =
+        folderEntry(QStringLiteral("Research/Notes/Old"), QStringLiteral("Old"), 2, QLatin1Char('g'));
+    const WhatSonFolderDepthEntry remoteSibling = folderEntry(QStringLiteral("Journal"), QStringLiteral("Journal"), 0, QLatin1Char('h'));
+    const QVector<WhatSonFolderDepthEntry> subtreeFolders = resolver.mergeFolderEntries(
+        {research},
+        {research, localChild, localGrandchild},
+        {research, remoteSibling},
+        nullptr);
+    QCOMPARE(subtreeFolders.size(), 4);
+    QCOMPARE(subtreeFolders.at(0).uuid, research.uuid);
+    QCOMPARE(subtreeFolders.at(1).uuid, localChild.uuid);
+    QCOMPARE(subtreeFolders.at(2).uuid, localGrandchild.uuid);
+    QCOMPARE(subtreeFolders.at(3).uuid, remoteSibling.uuid);
+
+    QVERIFY(WhatSonThreeWayMergeResolver::supportsStructuredMerge(QStringLiteral("Folders.wsfolders")));
+    QVERIFY(WhatSonThreeWayMergeResolver::supportsStructuredMerge(QStringLiteral("note/note.wsnhead")));
+    QVERIFY(!WhatSonThreeWayMergeResolver::supportsStructuredMerge(QStringLiteral("note/note.wsnbody")));
+}
+
+void WhatSonCppRegressionTests::threeWayMergeResolver_mergesHubFilesAgainstStoredAncestor()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString hubPath = QDir(tempDir.path()).filePath(QStringLiteral("Merge.wshub"));
+    QVERIFY(QDir().mkpath(hubPath));
+
+    const WhatSonMergeAncestorStore ancestorStore(hubPath);
+    QVERIFY(ancestorStore.ancestorPath(QStringLiteral("../escape.wsfolders")).isEmpty());
+
+    const QString relativePath = QStringLiteral(".wscontents/Folders.wsfolders");
+    const WhatSonFolderDepthEntry research = folderEntry(QStringLiteral("Research"), QStringLiteral("Research"), 0, QLatin1Char('a'));
+    const WhatSonFolderDepthEntry inbox = folderEntry(QStringLiteral("Inbox"), QStringLiteral("Inbox"), 0, QLatin1Char('b'));
+    const WhatSonFolderDepthEntry archive = folderEntry(QStringLiteral("Archive"), QStringLiteral("Archive"), 0, QLatin1Char('c'));
+
+    QString errorMessage;
+    QVERIFY2(ancestorStore.writeAncestor(relativePath, foldersText({research}), &errorMessage), qPrintable(errorMessage));
+    QVERIFY(ancestorStore.hasAncestor(relativePath));
+
+    const WhatSonThreeWayMergeResolver resolver;
+    QString mergedText;
+    QVector<WhatSonMergeConflict> conflicts;
+    QVERIFY2(
+        resolver.mergeHubFile(
+            hubPath,
+            relativePath,
+            foldersText({research, inbox}),
+            foldersText({research, archive}),
+            &mergedText,
+            &conflicts,
+            &errorMessage),
+        qPrintable(errorMessage));
+    QVERIFY(conflicts.isEmpty());
+
+    WhatSonFoldersHierarchyStore mergedStore;
+    QVERIFY2(WhatSonFoldersHierarchyParser().parse(mergedText, &mergedStore, &errorMessage), qPrintable(errorMessage));
+    QCOMPARE(mergedStore.folderEntries().size(), 3);
+
+    QString storedAncestor;
+    QVERIFY(ancestorStore.readAncestor(relativePath, &storedAncestor, &errorMessage));
+    QCOMPARE(storedAncestor, mergedText);
+
+    QVERIFY(!resolver.mergeFileText(
+        QStringLiteral("note/note.wsnbody"),
+        QStringLiteral("base"),
+        QStringLiteral("local"),
+        QStringLiteral("remote"),
+        &mergedText,
+        nullptr,
+        &errorMessage));
+}
+
+void WhatSonCppRegressionTests::hubSyncController_mergesRemoteFolderEditsWithLocalEdits()
+{
+    ensureCoreApplication();
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString hubPath = QDir(tempDir.path()).filePath(QStringLiteral("Synced.wshub"));
+    const QString relativePath = QStringLiteral(".wscontents/Folders.wsfolders");
+    const QString foldersPath = QDir(hubPath).filePath(relativePath);
+    QVERIFY(QDir().mkpath(QFileInfo(foldersPath).absolutePath()));
+
+    const auto writeFolders = [&foldersPath](const QVector<WhatSonFolderDepthEntry>& entries)
+    {
+        QFile file(foldersPath);
+        return file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)
+            && file.write(foldersText(entries).toUtf8()) >= 0;
+    };
+
+    const WhatSonFolderDepthEntry research = folderEntry(QStringLiteral("Research"), QStringLiteral("Research"), 0, QLatin1Char('a'));
+    const WhatSonFolderDepthEntry inbox = folderEntry(QStringLiteral("Inbox"), QStringLiteral("Inbox"), 0, QLatin1Char('b'));
+    const WhatSonFolderDepthEntry archive = folderEntry(QStringLiteral("Cold Archive"), QStringLiteral("Cold Archive"), 0, QLatin1Char('c'));
+    QVERIFY(writeFolders({research}));
+
+    int reloadCount = 0;
+    {
+        WhatSonHubSyncController controller;
+        controller.setReloadCallback([&reloadCount](const QString&, QString*)
+        {
+            ++reloadCount;
+            return true;
+        });
+        controller.setCurrentHubPath(hubPath);
+
+        const WhatSonMergeAncestorStore ancestorStore(hubPath);
+        QVERIFY(ancestorStore.hasAncestor(relativePath));
+
+        // Local edit: acknowledged, so it is captured as the local side and never reloaded.
+        QVERIFY(writeFolders({research, inbox}));
+        controller.acknowledgeLocalMutation();
+        QVERIFY(QMetaObject::invokeMethod(&controller, "onScheduledSyncCheck"));
+        QCOMPARE(reloadCount, 0);
+
+        // Remote edit based on the same ancestor lands on top of it.
+        QVERIFY(writeFolders({research, archive}));
+        QVERIFY(QMetaObject::invokeMethod(&controller, "onScheduledSyncCheck"));
+        QCOMPARE(reloadCount, 1);
+
+        QFile mergedFile(foldersPath);
+        QVERIFY(mergedFile.open(QIODevice::ReadOnly | QIODevice::Text));
+        const QString mergedText = QString::fromUtf8(mergedFile.readAll());
+        WhatSonFoldersHierarchyStore mergedStore;
+        QString errorMessage;
+        QVERIFY2(WhatSonFoldersHierarchyParser().parse(mergedText, &mergedStore, &errorMessage), qPrintable(errorMessage));
+        QCOMPARE(mergedStore.folderEntries().size(), 3);
+
+        QString storedAncestor;
+        QVERIFY(ancestorStore.readAncestor(relativePath, &storedAncestor, &errorMessage));
+        QCOMPARE(storedAncestor, mergedText);
+
+        // The merged write-back is part of the new baseline, not another remote change.
+        QVERIFY(QMetaObject::invokeMethod(&controller, "onScheduledSyncCheck"));
+        QCOMPARE(reloadCount, 1);
+    }
+    QThreadPool::globalInstance()->waitForDone();
+}
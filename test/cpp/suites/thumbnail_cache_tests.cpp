@@ -0,0 +1,201 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include <QCryptographicHash>
+
+namespace
+{
+    bool writeSolidImage(const QString& filePath, const QSize& size, const QColor& color)
+    {
+        QImage image(size, QImage::Format_ARGB32);
+        image.fill(color);
+        return QDir().mkpath(QFileInfo(filePath).absolutePath()) && image.save(filePath, "png");
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::thumbnailCache_bucketsRequestedEdgesAndRoundTripsProviderUrls()
+{
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(0), WhatSonThumbnailCache::kDefaultBucketEdge);
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(-1), WhatSonThumbnailCache::kDefaultBucketEdge);
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(48), 64);
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(64), 64);
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(65), 128);
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(300), 512);
+    QCOMPARE(WhatSonThumbnailCache::bucketEdgeForRequestedEdge(4096), 512);
+
+    const QString sourcePath = QStringLiteral("/tmp/Workspace.wshub/.wsresources/Photo Album/cover image.png");
+    const QString thumbnailUrl = WhatSonThumbnailCache::thumbnailUrlForImageSource(
+        QUrl::fromLocalFile(sourcePath).toString());
+    QVERIFY(thumbnailUrl.startsWith(QStringLiteral("image://whatson-thumbnail/")));
+    QVERIFY(!thumbnailUrl.contains(QLatin1Char(' ')));
+
+    const QString thumbnailId = thumbnailUrl.mid(QStringLiteral("image://whatson-thumbnail/").size());
+    QCOMPARE(WhatSonThumbnailCache::sourcePathFromThumbnailId(thumbnailId), sourcePath);
+
+    QCOMPARE(
+        WhatSonThumbnailCache::thumbnailUrlForImageSource(QStringLiteral("https://example.com/cover.png")),
+        QStringLiteral("https://example.com/cover.png"));
+    QCOMPARE(WhatSonThumbnailCache::thumbnailUrlForImageSource(QString()), QString());
+    QCOMPARE(WhatSonThumbnailCache::sourcePathFromThumbnailId(QStringLiteral("%%%")), QString());
+}
+
+void WhatSonCppRegressionTests::thumbnailCache_writesContentHashedDiskCacheUnderHubBookkeeping()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString fixtureError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("Thumbnails.wshub"),
+        &fixtureError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(fixtureError));
+
+    const QString sourcePath = QDir(hubPath).filePath(
+        QStringLiteral(".wsresources/Images/cover.wsresource/cover.png"));
+    QVERIFY(writeSolidImage(sourcePath, QSize(400, 200), QColor(Qt::red)));
+    QCOMPARE(
+        WhatSonThumbnailCache::hubRootPathForSource(sourcePath),
+        WhatSon::HubPath::normalizeAbsolutePath(hubPath));
+    QCOMPARE(WhatSonThumbnailCache::hubRootPathForSource(workspaceDir.filePath(QStringLiteral("loose.png"))), QString());
+
+    WhatSonThumbnailCache cache;
+    QString errorMessage;
+    const QImage thumbnail = cache.thumbnail(sourcePath, 48, &errorMessage);
+    QVERIFY2(!thumbnail.isNull(), qPrintable(errorMessage));
+    QCOMPARE(thumbnail.width(), 64);
+    QCOMPARE(thumbnail.height(), 32);
+    QCOMPARE(cache.memoryEntryCount(), 1);
+
+    const QString thumbnailRoot = QDir(hubPath).filePath(QStringLiteral(".whatson/thumbnails/64"));
+    QDirIterator iterator(thumbnailRoot, {QStringLiteral("*.png")}, QDir::Files, QDirIterator::Subdirectories);
+    QVERIFY(iterator.hasNext());
+    const QString diskThumbnailPath = iterator.next();
+    QCOMPARE(QFileInfo(diskThumbnailPath).completeBaseName().size(), 40);
+
+    WhatSonThumbnailCache coldCache;
+    const QImage diskThumbnail = coldCache.thumbnail(sourcePath, 48, &errorMessage);
+    QVERIFY2(!diskThumbnail.isNull(), qPrintable(errorMessage));
+    QCOMPARE(diskThumbnail.size(), thumbnail.size());
+
+    const QString duplicatePath = QDir(hubPath).filePath(
+        QStringLiteral(".wsresources/Images/copy.wsresource/copy.png"));
+    QVERIFY(QDir().mkpath(QFileInfo(duplicatePath).absolutePath()));
+    QVERIFY(QFile::copy(sourcePath, duplicatePath));
+    QVERIFY(!coldCache.thumbnail(duplicatePath, 48, &errorMessage).isNull());
+
+    int diskThumbnailCount = 0;
+    QDirIterator countIterator(thumbnailRoot, {QStringLiteral("*.png")}, QDir::Files, QDirIterator::Subdirectories);
+    while (countIterator.hasNext())
+    {
+        countIterator.next();
+        ++diskThumbnailCount;
+    }
+    QCOMPARE(diskThumbnailCount, 1);
+
+    QVERIFY(cache.thumbnail(QDir(hubPath).filePath(QStringLiteral("missing.png")), 48, &errorMessage).isNull());
+    QVERIFY(errorMessage.contains(QStringLiteral("missing.png")));
+}
+
+void WhatSonCppRegressionTests::thumbnailCache_evictsMemoryEntriesBeyondBudget()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    const qint64 singleThumbnailBytes = 64LL * 64LL * 4LL;
+    WhatSonThumbnailCache cache(singleThumbnailBytes * 2);
+
+    for (int index = 0; index < 4; ++index)
+    {
+        const QString sourcePath = workspaceDir.filePath(QStringLiteral("image-%1.png").arg(index));
+        QVERIFY(writeSolidImage(sourcePath, QSize(64, 64), QColor::fromHsv(index * 60, 255, 255)));
+
+        QString errorMessage;
+        QVERIFY2(!cache.thumbnail(sourcePath, 64, &errorMessage).isNull(), qPrintable(errorMessage));
+        QVERIFY(cache.memoryUsageBytes() <= cache.memoryBudgetBytes());
+    }
+
+    QCOMPARE(cache.memoryEntryCount(), 2);
+    QVERIFY(!QFileInfo::exists(workspaceDir.filePath(QStringLiteral(".whatson"))));
+
+    cache.clearMemory();
+    QCOMPARE(cache.memoryEntryCount(), 0);
+    QCOMPARE(cache.memoryUsageBytes(), 0);
+}
+
+void WhatSonCppRegressionTests::thumbnailCache_boundsDiskCacheAndLongEdge()
+{
+    QTemporaryDir workspaceDir;
+    QVERIFY(workspaceDir.isValid());
+
+    QString fixtureError;
+    const QString hubPath = createMinimalHubFixture(
+        workspaceDir.path(),
+        QStringLiteral("DiskBudget.wshub"),
+        &fixtureError);
+    QVERIFY2(!hubPath.isEmpty(), qPrintable(fixtureError));
+
+    // Tall sources are fitted inside the bucket, never expanded past it on the long edge.
+    const QString tallPath = QDir(hubPath).filePath(QStringLiteral(".wsresources/Images/tall.wsresource/tall.png"));
+    QVERIFY(writeSolidImage(tallPath, QSize(100, 2000), QColor(Qt::blue)));
+    WhatSonThumbnailCache cache;
+    QString errorMessage;
+    const QImage tallThumbnail = cache.thumbnail(tallPath, 64, &errorMessage);
+    QVERIFY2(!tallThumbnail.isNull(), qPrintable(errorMessage));
+    QCOMPARE(tallThumbnail.height(), 64);
+    QVERIFY(tallThumbnail.width() <= 64);
+
+    // A disk hit from a cold cache reads the entry without rewriting it or touching its mtime.
+    QFile tallFile(tallPath);
+    QVERIFY(tallFile.open(QIODevice::ReadOnly));
+    const QString contentHash = QString::fromLatin1(
+        QCryptographicHash::hash(tallFile.readAll(), QCryptographicHash::Sha1).toHex());
+    const QString tallThumbnailPath = WhatSonThumbnailCache::diskCachePath(
+        WhatSonThumbnailCache::hubRootPathForSource(tallPath),
+        contentHash,
+        64);
+    QVERIFY(QFileInfo::exists(tallThumbnailPath));
+    const QDateTime writtenAt = QFileInfo(tallThumbnailPath).lastModified();
+    WhatSonThumbnailCache coldCache;
+    const QImage diskThumbnail = coldCache.thumbnail(tallPath, 64, &errorMessage);
+    QVERIFY2(!diskThumbnail.isNull(), qPrintable(errorMessage));
+    QCOMPARE(diskThumbnail.size(), tallThumbnail.size());
+    QCOMPARE(QFileInfo(tallThumbnailPath).lastModified(), writtenAt);
+
+    // Pruning orders by the later of mtime and the in-memory last use, so a recent hit outlives newer writes.
+    const QString otherSourcePath = QDir(hubPath).filePath(
+        QStringLiteral(".wsresources/Images/other.wsresource/other.png"));
+    QVERIFY(writeSolidImage(otherSourcePath, QSize(100, 2000), QColor(Qt::red)));
+    QVERIFY2(!cache.thumbnail(otherSourcePath, 64, &errorMessage).isNull(), qPrintable(errorMessage));
+    const qint64 pairBytes = WhatSonThumbnailCache::diskCacheUsageBytes(hubPath);
+    const qint64 tallThumbnailBytes = QFileInfo(tallThumbnailPath).size();
+    QVERIFY(pairBytes > tallThumbnailBytes);
+    const QHash<QString, qint64> lastUseMsByPath{
+        {QFileInfo(tallThumbnailPath).absoluteFilePath(), QDateTime::currentMSecsSinceEpoch() + 60000}};
+    QCOMPARE(WhatSonThumbnailCache::pruneDiskCache(hubPath, tallThumbnailBytes, lastUseMsByPath), tallThumbnailBytes);
+    QVERIFY(QFileInfo::exists(tallThumbnailPath));
+
+    // The disk tier stays under its budget; the least recently written entries go first.
+    const qint64 thumbnailBytes = QFileInfo(tallThumbnailPath).size();
+    QVERIFY(thumbnailBytes > 0);
+    WhatSonThumbnailCache boundedCache(WhatSonThumbnailCache::kDefaultMemoryBudgetBytes, thumbnailBytes * 4);
+    QStringList sourcePaths;
+    for (int index = 0; index < 8; ++index)
+    {
+        const QString sourcePath = QDir(hubPath).filePath(
+            QStringLiteral(".wsresources/Images/image-%1.wsresource/image.png").arg(index));
+        QVERIFY(writeSolidImage(sourcePath, QSize(100, 2000), QColor::fromHsv(index * 40, 255, 255)));
+        QVERIFY2(!boundedCache.thumbnail(sourcePath, 64, &errorMessage).isNull(), qPrintable(errorMessage));
+        QVERIFY(WhatSonThumbnailCache::diskCacheUsageBytes(hubPath) <= boundedCache.diskBudgetBytes());
+        sourcePaths.push_back(sourcePath);
+    }
+
+    QFile newestFile(sourcePaths.constLast());
+    QVERIFY(newestFile.open(QIODevice::ReadOnly));
+    QVERIFY(QFileInfo::exists(WhatSonThumbnailCache::diskCachePath(
+        WhatSonThumbnailCache::hubRootPathForSource(sourcePaths.constLast()),
+        QString::fromLatin1(QCryptographicHash::hash(newestFile.readAll(), QCryptographicHash::Sha1).toHex()),
+        64)));
+
+    QCOMPARE(WhatSonThumbnailCache::pruneDiskCache(hubPath, 0), 0);
+    QCOMPARE(WhatSonThumbnailCache::diskCacheUsageBytes(hubPath), 0);
+}
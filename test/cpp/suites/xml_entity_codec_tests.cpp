@@ -0,0 +1,110 @@
+#include "test/cpp/whatson_cpp_regression_tests.hpp"
+
+#include "app/models/file/note/support/WhatSonXmlEntityCodec.hpp"
+
+#include <QRandomGenerator>
+
+namespace
+{
+    QString legacyChainDecode(QString text)
+    {
+        text.replace(QStringLiteral("&lt;"), QStringLiteral("<"));
+        text.replace(QStringLiteral("&gt;"), QStringLiteral(">"));
+        text.replace(QStringLiteral("&quot;"), QStringLiteral("\""));
+        text.replace(QStringLiteral("&apos;"), QStringLiteral("'"));
+        text.replace(QStringLiteral("&#39;"), QStringLiteral("'"));
+        text.replace(QStringLiteral("&nbsp;"), QStringLiteral(" "));
+        text.replace(QStringLiteral("&amp;"), QStringLiteral("&"));
+        return text;
+    }
+
+    QString legacyChainEncode(QString value)
+    {
+        value.replace(QStringLiteral("&"), QStringLiteral("&amp;"));
+        value.replace(QStringLiteral("<"), QStringLiteral("&lt;"));
+        value.replace(QStringLiteral(">"), QStringLiteral("&gt;"));
+        value.replace(QStringLiteral("\""), QStringLiteral("&quot;"));
+        value.replace(QStringLiteral("'"), QStringLiteral("&apos;"));
+        return value;
+    }
+
+    QString fuzzEntityText(QRandomGenerator& random, const int length)
+    {
+        static const QStringList pieces{
+            QStringLiteral("a"),
+            QStringLiteral(" "),
+            QStringLiteral("&"),
+            QStringLiteral("<"),
+            QStringLiteral(">"),
+            QStringLiteral("\""),
+            QStringLiteral("'"),
+            QStringLiteral(";"),
+            QStringLiteral("#"),
+            QStringLiteral("x"),
+            QStringLiteral("7"),
+            QStringLiteral("amp"),
+            QStringLiteral("&lt;"),
+            QStringLiteral("&#"),
+            QStringLiteral("&#x"),
+            QStringLiteral("한"),
+            QStringLiteral("é"),
+            QStringLiteral("🙂")
+        };
+        QString text;
+        for (int index = 0; index < length; ++index)
+        {
+            text += pieces.at(random.bounded(pieces.size()));
+        }
+        return text;
+    }
+} // namespace
+
+void WhatSonCppRegressionTests::xmlEntityCodec_decodesAndEncodesInOnePass()
+{
+    using namespace WhatSon::XmlEntities;
+
+    QCOMPARE(decode(QStringLiteral("a &lt;b&gt; &amp;amp; &quot;q&quot; &apos;s&#39;")),
+             QStringLiteral("a <b> &amp; \"q\" 's'"));
+    QCOMPARE(decode(QStringLiteral("&#65;&#x42;&#X43;&#x1F642;&#xD55C;&nbsp;")),
+             QStringLiteral("ABC🙂한 "));
+    QCOMPARE(decode(QStringLiteral("&unknown; & &; &#; &#x; &#0; &#xD800; &#x110000; &#12a; &amp")),
+             QStringLiteral("&unknown; & &; &#; &#x; &#0; &#xD800; &#x110000; &#12a; &amp"));
+    QCOMPARE(decode(QByteArray("&#x1F642;&amp;\xed\x95\x9c")), QByteArray("\xf0\x9f\x99\x82&\xed\x95\x9c"));
+    QCOMPARE(encode(QStringLiteral("<a href=\"x\">Tom & Jerry's</a>")),
+             QStringLiteral("&lt;a href=&quot;x&quot;&gt;Tom &amp; Jerry&apos;s&lt;/a&gt;"));
+    QCOMPARE(encode(QByteArray("R&D \xed\x95\x9c")), QByteArray("R&amp;D \xed\x95\x9c"));
+
+    // Nothing to do means no copy: the result shares the input's storage.
+    const QString plainText = QStringLiteral("plain text without references 한글");
+    QCOMPARE(decode(plainText).constData(), plainText.constData());
+    QCOMPARE(encode(plainText).constData(), plainText.constData());
+    const QByteArray plainBytes = plainText.toUtf8();
+    QCOMPARE(decode(plainBytes).constData(), plainBytes.constData());
+    QCOMPARE(encode(plainBytes).constData(), plainBytes.constData());
+
+    QRandomGenerator random(0x786d6c);
+    for (int iteration = 0; iteration < 5000; ++iteration)
+    {
+        const QString text = fuzzEntityText(random, random.bounded(1, 24));
+        const QString encoded = encode(text);
+        QCOMPARE(encoded, legacyChainEncode(text));
+        QCOMPARE(decode(encoded), text);
+        QCOMPARE(encode(text.toUtf8()), encoded.toUtf8());
+        QCOMPARE(decode(text.toUtf8()), decode(text).toUtf8());
+        if (!text.contains(QStringLiteral("&#")))
+        {
+            QCOMPARE(decode(text), legacyChainDecode(text));
+        }
+    }
+
+    // A large mixed document must decode and encode exactly like the replace chains it replaced.
+    QString bulkText;
+    for (int index = 0; index < 20000; ++index)
+    {
+        bulkText += QStringLiteral("Research &amp; Development &lt;%1&gt; &quot;notes&quot; 한글 ").arg(index);
+    }
+    const QString singlePassDecoded = decode(bulkText);
+    QCOMPARE(singlePassDecoded, legacyChainDecode(bulkText));
+    QCOMPARE(decode(bulkText.toUtf8()), singlePassDecoded.toUtf8());
+    QCOMPARE(encode(singlePassDecoded), legacyChainEncode(singlePassDecoded));
+}
@@ -1,11 +1,18 @@
 #pragma once
 
+#include "app/models/file/hub/WhatSonHubArchive.hpp"
+#include "app/models/file/hub/WhatSonHubArchiveConverter.hpp"
 #include "app/models/file/hub/WhatSonHubMountValidator.hpp"
 #include "app/models/file/hub/WhatSonHubPathUtils.hpp"
+#include "app/models/file/conflict/WhatSonMergeAncestorStore.hpp"
+#include "app/models/file/conflict/WhatSonThreeWayMergeResolver.hpp"
 #include "app/models/file/conflict/WhatSonTimestampConflictResolver.hpp"
+#include "app/models/file/viewer/WhatSonThumbnailCache.hpp"
 #include "app/models/clipboard/FiletypeCapture.h"
 #include "app/models/clipboard/InAppClipboardManager.h"
 #include "app/models/clipboard/InAppClipboardStore.h"
+#include "app/models/hierarchy/WhatSonFolderIdentity.hpp"
+#include "app/models/hierarchy/folders/WhatSonFoldersHierarchyCreator.hpp"
 #include "app/models/hierarchy/folders/WhatSonFoldersHierarchyParser.hpp"
 #include "app/models/hierarchy/folders/WhatSonFoldersHierarchyStore.hpp"
 #include "app/models/hierarchy/resources/WhatSonResourcePackageSupport.hpp"
@@ -28,6 +35,7 @@
 #include "app/models/hierarchy/IHierarchyController.hpp"
 #include "app/models/hierarchy/IHierarchyCapabilities.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyModel.hpp"
+#include "app/models/hierarchy/WhatSonHierarchyTree.hpp"
 #include "app/models/hierarchy/WhatSonHierarchyTreeItemSupport.hpp"
 #include "app/models/hierarchy/library/LibraryHierarchyController.hpp"
 #include "app/models/hierarchy/library/LibraryNoteListModel.hpp"
@@ -50,6 +58,7 @@
 #include "app/models/sidebar/IActiveHierarchyContextSource.hpp"
 #include "app/models/sidebar/SidebarHierarchyController.hpp"
 #include "app/models/sidebar/SidebarHierarchyInteractionController.hpp"
+#include "app/models/sidebar/SidebarHierarchyItemIndex.hpp"
 
 #include <QAbstractListModel>
 #include <QCoreApplication>
@@ -1064,8 +1073,33 @@ private slots:
     void hierarchyDragDropBridge_assignsDraggedNoteListItemsToFolderCapability();
     void hierarchyDragDropBridge_appliesReorderFromQmlArrayModel();
     void hierarchyTreeItemSupport_clampsNegativeSelectionToFirstVisibleRow();
+    void hierarchyTreeItemSupport_movesSubtreesAndKeepsChevronsLocal();
+    void hierarchyTree_mapsFlatIndicesAndEditsSubtrees();
     void hubMountValidator_acceptsCompleteHubPackage();
     void hubMountValidator_rejectsIncompleteHubPackage();
+    void hubMountValidator_mountsPackedHubArchiveThroughStagingDirectory();
+    void hubMountValidator_writesPackedHubEditsBackToArchive();
+    void hubMountValidator_compactsPackedHubInBackgroundWithoutDirtyingMount();
+    void hubLayout_resolvesOncePerMountAndSharesItWithConsumers();
+    void hubArchive_appendsSegmentsAndCompactsDeadEntries();
+    void hubArchive_recoversIndexFromSegmentsAfterTornTrailer();
+    void hubArchiveConverter_roundTripsHubDirectoryLosslessly();
+    void hubIntegrityChecker_reportsFindingsAndAppliesSafeRepairs();
+    void hubIntegrityChecker_reportsDegradedDomainLoads();
+    void hubSnapshotStore_sharesUnchangedObjectsAndRestoresPointInTime();
+    void hubQuery_filtersNotesAndResourcesFromCachedIndex();
+    void multiHubQuery_searchesMountedHubsAndUnmountsIndependently();
+    void hubRuntimeStore_commitsPerHubSlotsWithoutStagingCopies();
+    void hubRuntimeStore_evictsIdleHubsToSummaries();
+    void hubRuntimeStore_mountsResidentHubsConcurrentlyAtStartup();
+    void hubMutationJournal_undoesBatchesAsOneStepAcrossRestart();
+    void hubMutationJournal_wrapsEveryHierarchyStoreWrite();
+    void hubSymbolTable_internsIdentifiersIntoDenseSymbols();
+    void hubSymbolTable_sharesFacetSymbolsPerHub();
+    void memoryAccounting_keepsSyntheticHubWithinBudgets();
+    void presetQuery_compilesPredicatesAndMaintainsMembershipIncrementally();
+    void noteListModels_trustItemsNormalisedAtIngest();
+    void noteListModels_refreshDisplayDatesOnLocaleChange();
     void sourceTree_usesRepositoryAbsoluteProjectIncludes();
     void sourceTree_forbidsDeprecatedPresentationLayerVocabulary();
     void sourceTree_forbidsNoteEditingAndBodyPersistenceObjects();
@@ -1078,18 +1112,25 @@ private slots:
     void libraryHierarchyController_appliesLvrsMoveEventAsSingleFolderReparent();
     void libraryHierarchyController_mirrorsFoldersFileAfterHierarchyCommit();
     void libraryHierarchyController_clearsSelectionAfterDeletingFocusedFolder();
+    void libraryNoteListProjection_maintainsFolderCountsIncrementally();
     void libraryNoteListModel_emitsCurrentNoteEntryChangedWhenInitialSelectionMaterializes();
     void libraryNoteListModel_emitsCurrentNoteEntryChangedWhenSelectedRowReplacesCurrentSelection();
     void libraryNoteListModel_hidesRawInlineTagsFromPreviewText();
+    void libraryNoteListModel_materializesOnlyRequestedRowsFromRowSource();
     void navigationModeController_cyclesActiveSections();
     void noteActiveStateTracker_tracksCurrentNoteAcrossActiveHierarchyChanges();
     void noteActiveStateTracker_clearsReadableEmptyAndNonNoteBackedSelections();
     void noteActiveStateTracker_publishesAtomicNoteSnapshotBeforeChangeSignals();
     void noteFileStatSupport_incrementsOpenCountAndPersistsLastOpenedAt();
     void noteHeaderParser_usesIiXmlDocumentTreeForWsnHead();
+    void noteHeaderPatcher_splicesChangedSectionsByteIdenticallyToFullRewrite();
+    void xmlEntityCodec_decodesAndEncodesInOnePass();
     void noteListModelContractBridge_resolvesHierarchyBoundNoteListImmediately();
     void noteListModelContractBridge_prefersExplicitRowsAcrossHierarchySwitches();
     void timestampConflictResolver_reportsStrictlyNewerTimestamp();
+    void threeWayMergeResolver_mergesHeaderFieldsAndFolderNodes();
+    void threeWayMergeResolver_mergesHubFilesAgainstStoredAncestor();
+    void hubSyncController_mergesRemoteFolderEditsWithLocalEdits();
     void hubSyncController_splitsFilesystemResponsibilitiesIntoDedicatedObjects();
     void hubSyncObservationBuilder_ignoresPrivateWhatSonBookkeeping();
     void hubSyncWiring_excludesNoteEditorSessionVersionDiffMutations();
@@ -1119,6 +1160,8 @@ private slots:
     void resourcesHierarchyController_publishesDepthItemsToSharedModel();
     void resourcesHierarchyController_updatesChevronExpansionThroughSharedModelRow();
     void resourcesHierarchyController_commitsChevronExpansionThroughSharedBridge();
+    void resourcesListIndex_intersectsFacetPostingsAndFileNamePrefixes();
+    void resourcesListModel_appliesFacetFiltersThroughKeyedRowDiffs();
     void inAppClipboard_wiresAnnotationBitmapGenerationIntoPackageCreation();
     void inAppClipboard_importsUrlsAsResourcePackagesWithoutEditorWrappers();
     void inAppClipboard_importsClipboardImageThroughManager();
@@ -1126,8 +1169,12 @@ private slots:
     void inAppClipboard_randomizesClipboardResourceNameBeforeConflictPreflight();
     void inAppClipboard_importsNonImageClipboardPayloadThroughManager();
     void inAppClipboard_refreshReplacesStaleSnapshotWithSystemClipboardImage();
-    void runtimeParallelLoader_usesLvrsBootstrapParallelForDomainLoads();
+    void inAppClipboard_streamsLargeImportsWithProgressAndVerifiedHash();
+    void inAppClipboard_importsOnWorkerAndSweepsStaleStagingAtMount();
+    void runtimeParallelLoader_schedulesDomainLoadsThroughTaskGraph();
+    void runtimeTaskGraph_startsDependentsAsSoonAsInputsFinish();
     void selectedHubStore_persistsNormalizedSelectionsWithinSandboxedSettings();
+    void settingsStore_servesCachedReadsAndReplaysJournal();
     void sidebarHierarchyController_forcesCppOwnershipAcrossHierarchySwitchBindings();
     void sidebarHierarchyController_preservesFallbackAcrossStoreAttachDetach();
     void hierarchyItemModel_usesSharedLvrsModelContract();
@@ -1148,6 +1195,8 @@ private slots:
     void sidebarHierarchyView_chevronHitTestUsesLvrsChevronSlotContentItem();
     void sidebarHierarchyView_doesNotOverlayLvrsChevronClicks();
     void sidebarHierarchyView_chevronTapFallbackScopesCommitToPressedItem();
+    void sidebarHierarchyItemIndex_resolvesKeysAndInsertedRowsNatively();
+    void sidebarHierarchyItemIndex_hitTestsVisibleRowsWithoutQmlTreeWalk();
     void sidebarHierarchyView_routesFooterActionsDirectlyFromQml();
     void sidebarSelectionStore_normalizesIndicesAndSuppressesDuplicateSignals();
     void startupHubResolver_returnsEmptyWithoutPersistedSelection();
@@ -1157,6 +1206,10 @@ private slots:
     void unusedNoteSensors_filterNoteIdsByLastOpenedWindow();
     void unusedResourcesSensor_reportsHubPackagesMissingFromAllNoteEmbeddings();
     void unusedResourcesSensor_reportsPackagesWithoutReadingNoteBodies();
+    void thumbnailCache_bucketsRequestedEdgesAndRoundTripsProviderUrls();
+    void thumbnailCache_writesContentHashedDiskCacheUnderHubBookkeeping();
+    void thumbnailCache_evictsMemoryEntriesBeyondBudget();
+    void thumbnailCache_boundsDiskCacheAndLongEdge();
 
 private:
     static QString createMinimalHubFixture(